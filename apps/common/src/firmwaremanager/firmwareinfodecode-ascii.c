@@ -118,7 +118,7 @@ tFirmwareRet firmwareinfodecode_decodeInfo(tFirmwareStoreHandle pStore_p,
     tFirmwareRet            ret = kFwReturnOk;
     size_t                  dataSize;
     void*                   pData;
-    char*                   pFileString;
+    char*                   pFileString = NULL;
     char*                   pLine;
     tFirmwareInfoList       pList = NULL;
     tFirmwareInfoEntry**    ppInsertIter = &pList;
@@ -142,7 +142,16 @@ tFirmwareRet firmwareinfodecode_decodeInfo(tFirmwareStoreHandle pStore_p,
         goto EXIT;
     }
 
-    pFileString = pData;
+    // The stored data is shared and read-only, so tokenize a terminated copy
+    pFileString = (char*)malloc(dataSize + 1u);
+    if (pFileString == NULL)
+    {
+        ret = kFwReturnNoResource;
+        goto EXIT;
+    }
+
+    memcpy(pFileString, pData, dataSize);
+    pFileString[dataSize] = '\0';
 
     pLine = strtok(pFileString, FIRMWAREINFO_ASCII_LINE_SEPERATOR);
 
@@ -187,6 +196,7 @@ tFirmwareRet firmwareinfodecode_decodeInfo(tFirmwareStoreHandle pStore_p,
     *ppInfoList_p = pList;
 
 EXIT:
+    free(pFileString);
     (void)firmwarestore_flushData(pStore_p);
 
     if (ret != kFwReturnOk)
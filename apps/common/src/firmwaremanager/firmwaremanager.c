@@ -150,13 +150,16 @@ static void cleanupSdo(tSdoComConHdl* pSdoConnection_p);
 This function initializes the firmware manager.
 
 \param fwInfoFileName_p [in]    Firmware info file created by openCONFIGURATOR
+\param maxParallelTransmissions_p [in] Maximum number of firmware transmissions
+                                       in flight, 0 selects the default.
 
 \return This functions returns a value of \ref tFirmwareRet.
 
 \ingroup module_app_firmwaremanager
 */
 //------------------------------------------------------------------------------
-tFirmwareRet firmwaremanager_init(const char* fwInfoFileName_p)
+tFirmwareRet firmwaremanager_init(const char* fwInfoFileName_p,
+                                  UINT maxParallelTransmissions_p)
 {
     tFirmwareRet            ret = kFwReturnOk;
     tFirmwareStoreConfig    storeConfig;
@@ -204,6 +207,7 @@ tFirmwareRet firmwaremanager_init(const char* fwInfoFileName_p)
     updateConfig.pfnNodeUpdateComplete = nodeUpdateCompleteCb;
     updateConfig.pfnModuleUpdateComplete = moduleUpdateCompleteCb;
     updateConfig.pfnError = errorDuringUpdate;
+    updateConfig.maxParallelTransmissions = maxParallelTransmissions_p;
 
     ret = firmwareupdate_init(&updateConfig);
     if (ret != kFwReturnOk)
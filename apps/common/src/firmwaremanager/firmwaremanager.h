@@ -87,7 +87,8 @@ extern "C"
 {
 #endif
 
-tFirmwareRet firmwaremanager_init(const char* fwInfoFileName_p);
+tFirmwareRet firmwaremanager_init(const char* fwInfoFileName_p,
+                                  UINT maxParallelTransmissions_p);
 void         firmwaremanager_exit(void);
 
 tOplkError   firmwaremanager_thread(void);
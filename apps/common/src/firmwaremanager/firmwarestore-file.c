@@ -44,6 +44,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdio.h>
 
+#if !defined(_WIN32)
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -75,29 +81,74 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // local types
 //------------------------------------------------------------------------------
 
+/**
+\brief Firmware image cache key
+
+The key identifies the content of a file. On POSIX systems the file is
+identified by its device and inode, so that different paths to the same file
+share one image. A modified file gets a new key and is therefore loaded again.
+*/
+typedef struct
+{
+#if defined(_WIN32)
+    char    aFilename[FWSTORE_FILEPATH_LENGTH];     ///< File name
+#else
+    dev_t   device;                                 ///< Device containing the file
+    ino_t   inode;                                  ///< Inode of the file
+    time_t  modificationTime;                       ///< Time of the last modification
+#endif
+    size_t  fileSize;                               ///< File size
+} tFirmwareStoreImageKey;
+
+/**
+\brief Firmware image cache entry
+
+An entry holds the data of one file for all store instances which loaded it.
+The data is either mapped read-only into memory or read into a heap buffer, if
+mapping is not available.
+*/
+typedef struct tFirmwareStoreImage
+{
+    tFirmwareStoreImageKey      key;                ///< Cache key of the image
+    void*                       pData;              ///< Image data pointer
+    size_t                      dataSize;           ///< Image data size
+    BOOL                        fMapped;            ///< Image data is mapped
+    UINT                        refCount;           ///< Number of store instances using the image
+    struct tFirmwareStoreImage* pNext;              ///< Next entry of the image cache
+} tFirmwareStoreImage;
+
 /**
 \brief Firmware store instance
 */
 typedef struct tFirmwareStoreInstance
 {
-    char    aFilename[FWSTORE_FILEPATH_LENGTH];     ///< File name
-    char    aPathToFile[FWSTORE_FILEPATH_LENGTH];   ///< Path to file
-    FILE*   pStorageFd;                             ///< File descriptor
-    void*   pData;                                  ///< File data pointer
-    size_t  dataSize;                               ///< File data size
+    char                    aFilename[FWSTORE_FILEPATH_LENGTH];     ///< File name
+    char                    aPathToFile[FWSTORE_FILEPATH_LENGTH];   ///< Path to file
+    tFirmwareStoreImage*    pImage;                                 ///< Loaded image
+    UINT                    loadCount;                              ///< Number of loads which are not flushed
 } tFirmwareStoreInstance;
 
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
 
+static tFirmwareStoreImage* pImageCache_l = NULL;
+
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
 
+static tFirmwareRet acquireImage(const char* pFilename_p,
+                                 tFirmwareStoreImage** ppImage_p);
+static void releaseImage(tFirmwareStoreImage* pImage_p);
+static tFirmwareRet getImageKey(FILE* pFile_p, const char* pFilename_p,
+                                tFirmwareStoreImageKey* pKey_p);
+static BOOL isSameImage(const tFirmwareStoreImageKey* pKey_p,
+                        const tFirmwareStoreImageKey* pOtherKey_p);
+static tFirmwareRet mapData(FILE* pFile_p, size_t fileSize_p,
+                            tFirmwareStoreImage* pImage_p);
 static tFirmwareRet allocAndReadData(FILE* pFile_p,
                                      void** ppBuffer_p, size_t* pDataSize_p);
-static tFirmwareRet flushData(tFirmwareStoreHandle pHandle_p);
 static void getPathToFile(const char* pFilename_p, char* aPath_p);
 
 //============================================================================//
@@ -129,6 +180,7 @@ tFirmwareRet firmwarestore_create(const tFirmwareStoreConfig* pConfig_p,
     if ((pConfig_p == NULL) || (ppHandle_p == NULL))
     {
         ret = kFwReturnInvalidParameter;
+        goto EXIT;
     }
 
     instance = (tFirmwareStoreInstance*)malloc(sizeof(tFirmwareStoreInstance));
@@ -153,7 +205,8 @@ EXIT:
 /**
 \brief  Destroy a firmware store instance
 
-This function destroys an instance of the firmware store module.
+This function destroys an instance of the firmware store module. A still loaded
+image is released.
 
 \param pHandle_p [in] Handle of the firmware store module which shall be
                       destroyed.
@@ -170,15 +223,17 @@ tFirmwareRet firmwarestore_destroy (tFirmwareStoreHandle pHandle_p)
     if (pHandle_p == NULL)
     {
         ret = kFwReturnInvalidInstance;
+        goto EXIT;
     }
 
-    ret = flushData(pHandle_p);
-
-    if (ret == kFwReturnOk)
+    if (pHandle_p->pImage != NULL)
     {
-        free (pHandle_p);
+        releaseImage(pHandle_p->pImage);
     }
 
+    free(pHandle_p);
+
+EXIT:
     return ret;
 }
 
@@ -186,10 +241,11 @@ tFirmwareRet firmwarestore_destroy (tFirmwareStoreHandle pHandle_p)
 /**
 \brief  Load data represented by the firmware store instance
 
-This function acquires necessary resources and frees the data. All
-acquired resources can be flushed manually by calling
-\ref firmwarestore_flushData, unflushed resources will be freed within
-\ref firmwarestore_destroy.
+This function acquires necessary resources and loads the data. The data of a
+file is held in an image cache which is shared by all instances, so a file
+which is loaded by several instances or several times is only read once.
+Every call has to be balanced by a call of \ref firmwarestore_flushData,
+unflushed resources will be freed within \ref firmwarestore_destroy.
 
 \param pHandle_p [in] Handle of the firmware store module
 
@@ -208,14 +264,16 @@ tFirmwareRet firmwarestore_loadData(tFirmwareStoreHandle pHandle_p)
         goto EXIT;
     }
 
-    pHandle_p->pStorageFd = fopen(pHandle_p->aFilename, FWSTORE_READ_MODE);
-    if (pHandle_p->pStorageFd == NULL)
+    if (pHandle_p->pImage == NULL)
     {
-        ret = kFwReturnFileOperationFailed;
-        goto EXIT;
+        ret = acquireImage(pHandle_p->aFilename, &pHandle_p->pImage);
+        if (ret != kFwReturnOk)
+        {
+            goto EXIT;
+        }
     }
 
-    ret = allocAndReadData(pHandle_p->pStorageFd, &pHandle_p->pData, &pHandle_p->dataSize);
+    pHandle_p->loadCount++;
 
 EXIT:
     return ret;
@@ -225,7 +283,9 @@ EXIT:
 /**
 \brief  Flush data represented by the firmware store instance
 
-This function frees necessary resources and frees the data.
+This function frees necessary resources and frees the data. The image is
+released when all loads of the instance are flushed and is freed when no other
+instance uses it.
 
 \param pHandle_p [in] Handle of the firmware store module
 
@@ -238,15 +298,24 @@ tFirmwareRet firmwarestore_flushData(tFirmwareStoreHandle pHandle_p)
 {
     tFirmwareRet ret = kFwReturnOk;
 
-    if (pHandle_p != NULL)
+    if (pHandle_p == NULL)
+    {
+        ret = kFwReturnInvalidInstance;
+        goto EXIT;
+    }
+
+    if (pHandle_p->loadCount > 0u)
     {
-        ret = flushData(pHandle_p);
+        pHandle_p->loadCount--;
     }
-    else
+
+    if ((pHandle_p->loadCount == 0u) && (pHandle_p->pImage != NULL))
     {
-        ret = kFwReturnInvalidInstance;
+        releaseImage(pHandle_p->pImage);
+        pHandle_p->pImage = NULL;
     }
 
+EXIT:
     return ret;
 }
 
@@ -255,7 +324,7 @@ tFirmwareRet firmwarestore_flushData(tFirmwareStoreHandle pHandle_p)
 \brief  Access the data provided by the firmware store instance
 
 This function provides access to the data represented by the firmware store
-module.
+module. The data is read-only, because it is shared with other instances.
 
 \param pHandle_p [in] Handle of the firmware store module
 \param ppData_p [out] Pointer which will be filled with the data buffer
@@ -283,15 +352,15 @@ tFirmwareRet firmwarestore_getData(tFirmwareStoreHandle pHandle_p,
         goto EXIT;
     }
 
-    if (pHandle_p->pData == NULL)
+    if (pHandle_p->pImage == NULL)
     {
-        ret = allocAndReadData(pHandle_p->pStorageFd, &pHandle_p->pData, &pHandle_p->dataSize);
+        ret = firmwarestore_loadData(pHandle_p);
     }
 
     if (ret == kFwReturnOk)
     {
-        *ppData_p = pHandle_p->pData;
-        *pDataSize_p = pHandle_p->dataSize;
+        *ppData_p = pHandle_p->pImage->pData;
+        *pDataSize_p = pHandle_p->pImage->dataSize;
     }
 
 EXIT:
@@ -342,6 +411,262 @@ EXIT:
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief  Acquire an image from the image cache
+
+The function looks up the image of the given file in the image cache and
+increments its reference counter. If the file is not cached yet, its data is
+loaded and a new cache entry is added.
+
+\param pFilename_p [in] File name
+\param ppImage_p [out]  Pointer filled with the acquired image
+
+\return This functions returns a value of \ref tFirmwareRet.
+*/
+//------------------------------------------------------------------------------
+static tFirmwareRet acquireImage(const char* pFilename_p,
+                                 tFirmwareStoreImage** ppImage_p)
+{
+    tFirmwareRet            ret = kFwReturnOk;
+    FILE*                   pFile;
+    tFirmwareStoreImageKey  key;
+    tFirmwareStoreImage*    pImage = NULL;
+
+    pFile = fopen(pFilename_p, FWSTORE_READ_MODE);
+    if (pFile == NULL)
+    {
+        ret = kFwReturnFileOperationFailed;
+        goto EXIT;
+    }
+
+    ret = getImageKey(pFile, pFilename_p, &key);
+    if (ret != kFwReturnOk)
+    {
+        goto EXIT;
+    }
+
+    for (pImage = pImageCache_l; pImage != NULL; pImage = pImage->pNext)
+    {
+        if (isSameImage(&pImage->key, &key))
+        {
+            pImage->refCount++;
+            *ppImage_p = pImage;
+            goto EXIT;
+        }
+    }
+
+    pImage = (tFirmwareStoreImage*)malloc(sizeof(tFirmwareStoreImage));
+    if (pImage == NULL)
+    {
+        ret = kFwReturnNoResource;
+        goto EXIT;
+    }
+
+    memset(pImage, 0, sizeof(tFirmwareStoreImage));
+    pImage->key = key;
+
+    ret = mapData(pFile, key.fileSize, pImage);
+    if (ret != kFwReturnOk)
+    {
+        free(pImage);
+        goto EXIT;
+    }
+
+    pImage->refCount = 1u;
+    pImage->pNext = pImageCache_l;
+    pImageCache_l = pImage;
+
+    *ppImage_p = pImage;
+
+EXIT:
+    if (pFile != NULL)
+    {
+        fclose(pFile);
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release an image of the image cache
+
+The function decrements the reference counter of the image. The image is
+removed from the cache and its data is freed if it is not used anymore.
+
+\param pImage_p [in]    Image to be released
+*/
+//------------------------------------------------------------------------------
+static void releaseImage(tFirmwareStoreImage* pImage_p)
+{
+    tFirmwareStoreImage** ppIter;
+
+    pImage_p->refCount--;
+    if (pImage_p->refCount > 0u)
+    {
+        return;
+    }
+
+    for (ppIter = &pImageCache_l; *ppIter != NULL; ppIter = &(*ppIter)->pNext)
+    {
+        if (*ppIter == pImage_p)
+        {
+            *ppIter = pImage_p->pNext;
+            break;
+        }
+    }
+
+#if !defined(_WIN32)
+    if (pImage_p->fMapped)
+    {
+        munmap(pImage_p->pData, pImage_p->dataSize);
+    }
+    else
+#endif
+    {
+        free(pImage_p->pData);
+    }
+
+    free(pImage_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the image cache key of a file
+
+\param pFile_p [in]     File handle
+\param pFilename_p [in] File name
+\param pKey_p [out]     Pointer filled with the image cache key
+
+\return This functions returns a value of \ref tFirmwareRet.
+*/
+//------------------------------------------------------------------------------
+static tFirmwareRet getImageKey(FILE* pFile_p, const char* pFilename_p,
+                                tFirmwareStoreImageKey* pKey_p)
+{
+    tFirmwareRet    ret = kFwReturnOk;
+#if defined(_WIN32)
+    long            tellResult;
+#else
+    struct stat     fileStat;
+#endif
+
+    memset(pKey_p, 0, sizeof(tFirmwareStoreImageKey));
+
+#if defined(_WIN32)
+    strncpy(pKey_p->aFilename, pFilename_p, FWSTORE_FILEPATH_LENGTH - 1u);
+
+    if (fseek(pFile_p, 0, SEEK_END) < 0)
+    {
+        ret = kFwReturnFileOperationFailed;
+        goto EXIT;
+    }
+
+    tellResult = ftell(pFile_p);
+    if (tellResult < 0)
+    {
+        ret = kFwReturnFileOperationFailed;
+        goto EXIT;
+    }
+
+    pKey_p->fileSize = (size_t)tellResult;
+    rewind(pFile_p);
+#else
+    UNUSED_PARAMETER(pFilename_p);
+
+    if (fstat(fileno(pFile_p), &fileStat) < 0)
+    {
+        ret = kFwReturnFileOperationFailed;
+        goto EXIT;
+    }
+
+    pKey_p->device = fileStat.st_dev;
+    pKey_p->inode = fileStat.st_ino;
+    pKey_p->modificationTime = fileStat.st_mtime;
+    pKey_p->fileSize = (size_t)fileStat.st_size;
+#endif
+
+EXIT:
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare two image cache keys
+
+\param pKey_p [in]      Image cache key
+\param pOtherKey_p [in] Image cache key to compare with
+
+\return This functions returns TRUE if both keys identify the same image.
+*/
+//------------------------------------------------------------------------------
+static BOOL isSameImage(const tFirmwareStoreImageKey* pKey_p,
+                        const tFirmwareStoreImageKey* pOtherKey_p)
+{
+#if defined(_WIN32)
+    return ((strncmp(pKey_p->aFilename, pOtherKey_p->aFilename, FWSTORE_FILEPATH_LENGTH) == 0) &&
+            (pKey_p->fileSize == pOtherKey_p->fileSize));
+#else
+    return ((pKey_p->device == pOtherKey_p->device) &&
+            (pKey_p->inode == pOtherKey_p->inode) &&
+            (pKey_p->modificationTime == pOtherKey_p->modificationTime) &&
+            (pKey_p->fileSize == pOtherKey_p->fileSize));
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Map the data of a file into memory
+
+The function maps the file read-only into memory. If the file can't be mapped
+its data is read into an allocated buffer.
+
+\param pFile_p [in]     File handle
+\param fileSize_p [in]  File size
+\param pImage_p [out]   Image filled with the data pointer and size
+
+\return This functions returns a value of \ref tFirmwareRet.
+*/
+//------------------------------------------------------------------------------
+static tFirmwareRet mapData(FILE* pFile_p, size_t fileSize_p,
+                            tFirmwareStoreImage* pImage_p)
+{
+    tFirmwareRet    ret = kFwReturnOk;
+#if !defined(_WIN32)
+    void*           pData;
+
+    if (fileSize_p > 0u)
+    {
+        pData = mmap(NULL, fileSize_p, PROT_READ, MAP_PRIVATE, fileno(pFile_p), 0);
+        if (pData != MAP_FAILED)
+        {
+#if defined(MADV_SEQUENTIAL)
+            // The image is sent from the start to the end
+            (void)madvise(pData, fileSize_p, MADV_SEQUENTIAL);
+#endif
+            pImage_p->pData = pData;
+            pImage_p->dataSize = fileSize_p;
+            pImage_p->fMapped = TRUE;
+        }
+    }
+#else
+    UNUSED_PARAMETER(fileSize_p);
+#endif
+
+    if (!pImage_p->fMapped)
+    {
+        ret = allocAndReadData(pFile_p, &pImage_p->pData, &pImage_p->dataSize);
+        if (ret != kFwReturnOk)
+        {
+            free(pImage_p->pData);
+            pImage_p->pData = NULL;
+        }
+    }
+
+    return ret;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Allocate buffer and read data from file
@@ -404,40 +729,6 @@ EXIT:
     return ret;
 }
 
-//------------------------------------------------------------------------------
-/**
-\brief  Flush firmware store data
-
-\param pHandle_p [in] Store handle
-
-\return This functions returns a value of \ref tFirmwareRet.
-*/
-//------------------------------------------------------------------------------
-static tFirmwareRet flushData(tFirmwareStoreHandle pHandle_p)
-{
-    tFirmwareRet    ret = kFwReturnOk;
-    int             result;
-
-    if (pHandle_p->pStorageFd != NULL)
-    {
-        result = fclose(pHandle_p->pStorageFd);
-
-        if (result == 0)
-        {
-            pHandle_p->pStorageFd = NULL;
-        }
-        else
-        {
-            ret = kFwReturnFileOperationFailed;
-        }
-    }
-
-    free(pHandle_p->pData);
-    pHandle_p->pData = NULL;
-
-    return ret;
-}
-
 //------------------------------------------------------------------------------
 /**
 \brief  Get path to file
@@ -78,7 +78,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define FIRMWARE_UPDATE_INVALID_SDO     ((tSdoComConHdl)-1) ///< Invalid SDO handle
 
 #if !defined(FIRMWARE_UPDATE_MAX_PARALLEL_TRANSMISSIONS)
-#define FIRMWARE_UPDATE_MAX_PARALLEL_TRANSMISSIONS 5        ///< Number of parallel transmissions of firmware images
+#define FIRMWARE_UPDATE_MAX_PARALLEL_TRANSMISSIONS 5        ///< Default number of parallel transmissions of firmware images
 #endif
 
 //------------------------------------------------------------------------------
@@ -105,8 +105,9 @@ typedef struct
     BOOL                            fInitialized;   ///< Instance initialized flag
     tFirmwareUpdateConfig           config;         ///< Instance configuration
     tFirmwareUpdateTransmissionInfo aTransmissions[FIRMWARE_UPDATE_MAX_NODE_ID]; ///< Node transmission array
-    size_t                          numberOfStartedTransmissions;   ///< Number of started transmissions
-    size_t                          numberOfFinishedTransmissions;  ///< Number of finished/aborted transmissions
+    size_t                          maxParallelTransmissions;       ///< Maximum number of active transmissions
+    size_t                          numberOfActiveTransmissions;    ///< Number of active transmissions
+    size_t                          nextPendingIndex;               ///< Start index of the search for pending transmissions
 } tFirmwareUpdateInstance;
 
 //------------------------------------------------------------------------------
@@ -133,6 +134,7 @@ static void cleanupInstance(void);
 static BOOL isTransmissionAllowed(tFirmwareUpdateTransmissionInfo* pInfo_p);
 
 static tFirmwareUpdateTransmissionInfo* getNextPendingTransmission(void);
+static void startPendingTransmissions(void);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -166,6 +168,12 @@ tFirmwareRet firmwareupdate_init(const tFirmwareUpdateConfig* pConfig_p)
 
     memcpy(&instance_l.config, pConfig_p, sizeof(tFirmwareUpdateConfig));
 
+    instance_l.maxParallelTransmissions = pConfig_p->maxParallelTransmissions;
+    if (instance_l.maxParallelTransmissions == 0u)
+    {
+        instance_l.maxParallelTransmissions = FIRMWARE_UPDATE_MAX_PARALLEL_TRANSMISSIONS;
+    }
+
     instance_l.fInitialized = TRUE;
 
 EXIT:
@@ -306,6 +314,9 @@ tFirmwareRet firmwareupdate_processSdoEvent(const tSdoComFinished* pSdoComFinish
 
     ret = startTransmission(pInfo);
 
+    // Refill the slots which became free by the finished transmission
+    startPendingTransmissions();
+
 EXIT:
     if (ret != kFwReturnOk)
     {
@@ -506,7 +517,7 @@ static tFirmwareRet transmitFirmware(tFirmwareUpdateTransmissionInfo* pInfo_p)
         goto EXIT;
     }
 
-    instance_l.numberOfStartedTransmissions++;
+    instance_l.numberOfActiveTransmissions++;
     pInfo_p->fTranmissionActive = TRUE;
 
 EXIT:
@@ -558,8 +569,13 @@ static tFirmwareRet startTransmission(tFirmwareUpdateTransmissionInfo* pInfo_p)
 //------------------------------------------------------------------------------
 static void transmissionFailed(tFirmwareUpdateTransmissionInfo* pInfo_p)
 {
+    // A transmission which failed to start does not occupy a slot
+    if (pInfo_p->fTranmissionActive)
+    {
+        instance_l.numberOfActiveTransmissions--;
+    }
+
     pInfo_p->fTranmissionActive = FALSE;
-    instance_l.numberOfFinishedTransmissions++;
 
     if (pInfo_p->pUpdateList->fIsNode)
     {
@@ -585,7 +601,6 @@ static void transmissionFailed(tFirmwareUpdateTransmissionInfo* pInfo_p)
 static tFirmwareRet transmissionSucceeded(tFirmwareUpdateTransmissionInfo* pInfo_p)
 {
     tFirmwareRet                        ret = kFwReturnOk;
-    tFirmwareUpdateTransmissionInfo*    pNextInfo;
 
     FWM_TRACE("Update finished for node: %u index: 0x%x subindex: 0x%x\n",
               pInfo_p->pUpdateList->nodeId, pInfo_p->pUpdateList->index,
@@ -611,19 +626,7 @@ static tFirmwareRet transmissionSucceeded(tFirmwareUpdateTransmissionInfo* pInfo
         }
     }
 
-    instance_l.numberOfFinishedTransmissions++;
-
-    if (pInfo_p->pUpdateList->pNext == NULL)
-    {
-        pNextInfo = getNextPendingTransmission();
-
-        if (pNextInfo != NULL)
-        {
-            FWM_TRACE("Start next pending transmission for node 0x%X\n",
-                      pNextInfo->pUpdateList->nodeId);
-            startTransmission(pNextInfo);
-        }
-    }
+    instance_l.numberOfActiveTransmissions--;
 
     cleanupTransmission(pInfo_p);
 
@@ -674,25 +677,69 @@ static void cleanupInstance(void)
     }
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get the next pending transmission
+
+The search continues after the node of the previously returned transmission,
+so that the pending nodes are started in a round-robin manner.
+
+\return This functions returns a pointer to the transmission information or
+        NULL if no transmission is pending.
+*/
+//------------------------------------------------------------------------------
 static tFirmwareUpdateTransmissionInfo* getNextPendingTransmission(void)
 {
     tFirmwareUpdateTransmissionInfo*    pInfo = NULL;
+    size_t                              count;
     size_t                              i;
 
-    for (i = 0U; i < FIRMWARE_UPDATE_MAX_NODE_ID; i++)
-    {
+    i = instance_l.nextPendingIndex;
 
+    for (count = 0U; count < FIRMWARE_UPDATE_MAX_NODE_ID; count++)
+    {
         if (!instance_l.aTransmissions[i].fTranmissionActive &&
                 (instance_l.aTransmissions[i].pUpdateList != NULL))
         {
             pInfo = &instance_l.aTransmissions[i];
+            instance_l.nextPendingIndex = (i + 1U) % FIRMWARE_UPDATE_MAX_NODE_ID;
             break;
         }
+
+        i = (i + 1U) % FIRMWARE_UPDATE_MAX_NODE_ID;
     }
 
     return pInfo;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Start pending transmissions
+
+This function starts pending transmissions of other nodes until the maximum
+number of parallel transmissions is reached.
+*/
+//------------------------------------------------------------------------------
+static void startPendingTransmissions(void)
+{
+    tFirmwareUpdateTransmissionInfo*    pNextInfo;
+
+    while (isTransmissionAllowed(NULL))
+    {
+        pNextInfo = getNextPendingTransmission();
+        if (pNextInfo == NULL)
+        {
+            break;
+        }
+
+        FWM_TRACE("Start next pending transmission for node 0x%X\n",
+                  pNextInfo->pUpdateList->nodeId);
+
+        // A failed start drops the node's entries, so the loop terminates
+        (void)startTransmission(pNextInfo);
+    }
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Check if the start of the given transmission is allowed
@@ -703,12 +750,9 @@ static tFirmwareUpdateTransmissionInfo* getNextPendingTransmission(void)
 //------------------------------------------------------------------------------
 static BOOL isTransmissionAllowed(tFirmwareUpdateTransmissionInfo* pInfo_p)
 {
-    size_t numberOfActiveTransmissions = instance_l.numberOfStartedTransmissions -
-                                         instance_l.numberOfFinishedTransmissions;
-
     UNUSED_PARAMETER(pInfo_p);
 
-    return (numberOfActiveTransmissions < FIRMWARE_UPDATE_MAX_PARALLEL_TRANSMISSIONS);
+    return (instance_l.numberOfActiveTransmissions < instance_l.maxParallelTransmissions);
 
 }
 
@@ -85,6 +85,8 @@ typedef struct
     tFirmwareUpdateNodeCb pfnNodeUpdateComplete;    ///< Node update complete callback
     tFirmwareUpdateNodeCb pfnModuleUpdateComplete;  ///< Modules of a node update complete callback
     tFirmwareUpdateNodeCb pfnError;                 ///< Node update error callback
+    UINT                  maxParallelTransmissions; ///< Maximum number of firmware transmissions in flight
+                                                    ///< (0 selects the default of the module)
 } tFirmwareUpdateConfig;
 
 /**
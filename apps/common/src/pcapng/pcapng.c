@@ -0,0 +1,398 @@
+/**
+********************************************************************************
+\file   pcapng.c
+
+\brief  pcapng writer for the frame capture ring
+
+This module writes the records of the frame capture ring of the openPOWERLINK
+DLL into a pcapng file which can be opened with Wireshark. Every frame is
+written as enhanced packet block with nanosecond timestamps. The POWERLINK
+cycle of the frame, its direction and the number of records which were dropped
+by the stack before it are written into the comment of the block.
+
+The file is written in host byte order which is indicated by the byte order
+magic of the section header block.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "pcapng.h"
+#include <stdio.h>
+#include <string.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define PCAPNG_BLOCK_TYPE_SHB           0x0A0D0D0A      ///< Section header block
+#define PCAPNG_BLOCK_TYPE_IDB           0x00000001      ///< Interface description block
+#define PCAPNG_BLOCK_TYPE_EPB           0x00000006      ///< Enhanced packet block
+#define PCAPNG_BYTE_ORDER_MAGIC         0x1A2B3C4D      ///< Byte order magic of the section header block
+#define PCAPNG_LINKTYPE_ETHERNET        1               ///< Link type of the interface
+
+#define PCAPNG_OPT_ENDOFOPT             0               ///< End of options
+#define PCAPNG_OPT_COMMENT              1               ///< Comment option
+#define PCAPNG_OPT_IF_TSRESOL           9               ///< Timestamp resolution option of the IDB
+#define PCAPNG_OPT_EPB_FLAGS            2               ///< Flags option of the EPB
+
+#define PCAPNG_EPB_FLAG_INBOUND         0x00000001      ///< EPB flags: inbound frame
+#define PCAPNG_EPB_FLAG_OUTBOUND        0x00000002      ///< EPB flags: outbound frame
+
+#define PCAPNG_MAX_COMMENT_LENGTH       64              ///< Maximum length of the EPB comment
+#define PCAPNG_MAX_CAPTURE_SIZE         1518            ///< Maximum size of a captured frame
+#define PCAPNG_PAD32(size)              (((size) + 3) & ~3)
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+* Instance of the pcapng writer module
+*/
+typedef struct
+{
+    FILE*                   pFile;              ///< Output file
+    UINT32                  recordCount;        ///< Number of written records
+    UINT32                  dropCount;          ///< Number of records dropped by the stack
+} tPcapngInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tPcapngInstance      pcapngInstance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static int writeHeader(void);
+static int writeData(const void* pData_p, size_t size_p);
+static int writeOption(UINT16 code_p, const void* pValue_p, UINT16 length_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Open pcapng file
+
+The function creates the pcapng file and writes the section header and the
+interface description block.
+
+\param[in]      pFileName_p         Name of the pcapng file.
+
+\return The function returns 0 if the file was created or -1 on error.
+*/
+//------------------------------------------------------------------------------
+int pcapng_open(const char* pFileName_p)
+{
+    memset(&pcapngInstance_l, 0, sizeof(pcapngInstance_l));
+
+    pcapngInstance_l.pFile = fopen(pFileName_p, "wb");
+    if (pcapngInstance_l.pFile == NULL)
+    {
+        fprintf(stderr, "%s() Unable to create %s!\n", __func__, pFileName_p);
+        return -1;
+    }
+
+    if (writeHeader() != 0)
+    {
+        pcapng_close();
+        return -1;
+    }
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Close pcapng file
+
+The function closes the pcapng file.
+*/
+//------------------------------------------------------------------------------
+void pcapng_close(void)
+{
+    if (pcapngInstance_l.pFile == NULL)
+        return;
+
+    fclose(pcapngInstance_l.pFile);
+    pcapngInstance_l.pFile = NULL;
+
+    printf("Frame capture: %u records written, %u records dropped\n",
+           pcapngInstance_l.recordCount,
+           pcapngInstance_l.dropCount);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write a capture record
+
+The function writes a record of the frame capture ring as enhanced packet block
+into the pcapng file.
+
+\param[in]      pRecord_p           Header of the capture record.
+\param[in]      pData_p             Captured frame bytes.
+
+\return The function returns 0 if the record was written or -1 on error.
+*/
+//------------------------------------------------------------------------------
+int pcapng_writeRecord(const tOplkApiCaptureRecord* pRecord_p,
+                       const void* pData_p)
+{
+    char    aComment[PCAPNG_MAX_COMMENT_LENGTH];
+    UINT32  aBlock[7];
+    UINT32  flags;
+    UINT16  commentLength;
+    UINT32  blockLength;
+
+    if (pcapngInstance_l.pFile == NULL)
+        return -1;
+
+    if (pRecord_p->dropCount != 0)
+    {
+        snprintf(aComment, sizeof(aComment), "cycle %u %s, %u records dropped before",
+                 pRecord_p->cycleCount,
+                 (pRecord_p->direction == kOplkApiCaptureTx) ? "tx" : "rx",
+                 pRecord_p->dropCount);
+    }
+    else
+    {
+        snprintf(aComment, sizeof(aComment), "cycle %u %s",
+                 pRecord_p->cycleCount,
+                 (pRecord_p->direction == kOplkApiCaptureTx) ? "tx" : "rx");
+    }
+    commentLength = (UINT16)strlen(aComment);
+
+    flags = (pRecord_p->direction == kOplkApiCaptureTx) ? PCAPNG_EPB_FLAG_OUTBOUND :
+                                                          PCAPNG_EPB_FLAG_INBOUND;
+
+    blockLength = sizeof(aBlock) +
+                  PCAPNG_PAD32(pRecord_p->captureSize) +
+                  4 + PCAPNG_PAD32(commentLength) +         // comment option
+                  4 + sizeof(flags) +                       // flags option
+                  4 +                                       // end of options
+                  sizeof(blockLength);
+
+    aBlock[0] = PCAPNG_BLOCK_TYPE_EPB;
+    aBlock[1] = blockLength;
+    aBlock[2] = 0;                                          // interface ID
+    aBlock[3] = (UINT32)(pRecord_p->timestamp >> 32);
+    aBlock[4] = (UINT32)pRecord_p->timestamp;
+    aBlock[5] = pRecord_p->captureSize;
+    aBlock[6] = pRecord_p->frameSize;
+
+    if ((writeData(aBlock, sizeof(aBlock)) != 0) ||
+        (writeData(pData_p, pRecord_p->captureSize) != 0) ||
+        (writeOption(PCAPNG_OPT_COMMENT, aComment, commentLength) != 0) ||
+        (writeOption(PCAPNG_OPT_EPB_FLAGS, &flags, sizeof(flags)) != 0) ||
+        (writeOption(PCAPNG_OPT_ENDOFOPT, NULL, 0) != 0) ||
+        (writeData(&blockLength, sizeof(blockLength)) != 0))
+        return -1;
+
+    pcapngInstance_l.recordCount++;
+    pcapngInstance_l.dropCount += pRecord_p->dropCount;
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stream the frame capture ring into the pcapng file
+
+The function reads all records which are currently stored in the frame capture
+ring of the stack and writes them into the pcapng file. It should be called
+periodically. If it is called too rarely, the stack drops the records which do
+not fit into the ring.
+
+\return The function returns the number of written records or -1 on error.
+*/
+//------------------------------------------------------------------------------
+int pcapng_streamCaptureRing(void)
+{
+    UINT64                          aBuffer[(sizeof(tOplkApiCaptureRecord) + PCAPNG_MAX_CAPTURE_SIZE + 7) / 8];
+    const tOplkApiCaptureRecord*    pRecord = (const tOplkApiCaptureRecord*)aBuffer;
+    tOplkError                      ret;
+    size_t                          recordSize;
+    int                             count = 0;
+
+    for (;;)
+    {
+        ret = oplk_serviceReadCaptureRecord(aBuffer, sizeof(aBuffer), &recordSize);
+        if (ret != kErrorOk)
+            return -1;
+
+        if (recordSize == 0)
+            break;
+
+        if ((recordSize < sizeof(*pRecord)) ||
+            (recordSize < (sizeof(*pRecord) + pRecord->captureSize)))
+            return -1;
+
+        if (pcapng_writeRecord(pRecord, pRecord + 1) != 0)
+            return -1;
+
+        count++;
+    }
+
+    if (count > 0)
+        fflush(pcapngInstance_l.pFile);
+
+    return count;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write file header
+
+The function writes the section header block and the interface description
+block. The interface uses nanosecond timestamps.
+
+\return The function returns 0 on success or -1 on error.
+*/
+//------------------------------------------------------------------------------
+static int writeHeader(void)
+{
+    UINT32  aShb[7];
+    UINT32  aIdb[4];
+    UINT16  aVersion[2] = {1, 0};                           // major, minor
+    UINT16  aLinkType[2] = {PCAPNG_LINKTYPE_ETHERNET, 0};   // link type, reserved
+    UINT8   tsResolution = 9;                               // 10^-9 s
+    UINT32  blockLength;
+
+    aShb[0] = PCAPNG_BLOCK_TYPE_SHB;
+    aShb[1] = sizeof(aShb);
+    aShb[2] = PCAPNG_BYTE_ORDER_MAGIC;
+    memcpy(&aShb[3], aVersion, sizeof(aVersion));
+    aShb[4] = 0xFFFFFFFF;                                   // section length not specified
+    aShb[5] = 0xFFFFFFFF;
+    aShb[6] = sizeof(aShb);
+
+    blockLength = sizeof(aIdb) +
+                  4 + PCAPNG_PAD32(sizeof(tsResolution)) +  // if_tsresol option
+                  4 +                                       // end of options
+                  sizeof(blockLength);
+
+    aIdb[0] = PCAPNG_BLOCK_TYPE_IDB;
+    aIdb[1] = blockLength;
+    memcpy(&aIdb[2], aLinkType, sizeof(aLinkType));
+    aIdb[3] = 0;                                            // no snap length limit
+
+    if ((writeData(aShb, sizeof(aShb)) != 0) ||
+        (writeData(aIdb, sizeof(aIdb)) != 0) ||
+        (writeOption(PCAPNG_OPT_IF_TSRESOL, &tsResolution, sizeof(tsResolution)) != 0) ||
+        (writeOption(PCAPNG_OPT_ENDOFOPT, NULL, 0) != 0) ||
+        (writeData(&blockLength, sizeof(blockLength)) != 0))
+        return -1;
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write data
+
+The function writes the data and pads it to a multiple of 32 bit.
+
+\param[in]      pData_p             Data to write.
+\param[in]      size_p              Size of the data.
+
+\return The function returns 0 on success or -1 on error.
+*/
+//------------------------------------------------------------------------------
+static int writeData(const void* pData_p, size_t size_p)
+{
+    static const UINT8  aPadding[3] = {0, 0, 0};
+    size_t              paddingSize = PCAPNG_PAD32(size_p) - size_p;
+
+    if ((size_p > 0) && (fwrite(pData_p, 1, size_p, pcapngInstance_l.pFile) != size_p))
+        return -1;
+
+    if ((paddingSize > 0) &&
+        (fwrite(aPadding, 1, paddingSize, pcapngInstance_l.pFile) != paddingSize))
+        return -1;
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write option
+
+The function writes a block option.
+
+\param[in]      code_p              Option code.
+\param[in]      pValue_p            Option value.
+\param[in]      length_p            Length of the option value.
+
+\return The function returns 0 on success or -1 on error.
+*/
+//------------------------------------------------------------------------------
+static int writeOption(UINT16 code_p, const void* pValue_p, UINT16 length_p)
+{
+    UINT16  aHeader[2];
+
+    aHeader[0] = code_p;
+    aHeader[1] = length_p;
+
+    if (writeData(aHeader, sizeof(aHeader)) != 0)
+        return -1;
+
+    return writeData(pValue_p, length_p);
+}
+
+/// \}
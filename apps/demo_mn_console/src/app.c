@@ -52,6 +52,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <eventlog/eventlog.h>
 
 #include "xap.h"
+#if defined(CONFIG_USE_PI_BINDING)
+#include "xapbind.h"
+#endif
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -263,7 +266,9 @@ The function initializes the process image of the application.
 static tOplkError initProcessImage(void)
 {
     tOplkError  ret = kErrorOk;
+#if !defined(CONFIG_USE_PI_BINDING)
     UINT        errorIndex = 0;
+#endif
 
     printf("Initializing process image...\n");
     printf("Size of process image: Input = %lu Output = %lu\n",
@@ -275,6 +280,22 @@ static tOplkError initProcessImage(void)
                           (ULONG)sizeof(PI_IN),
                           (ULONG)sizeof(PI_OUT));
 
+#if defined(CONFIG_USE_PI_BINDING)
+    // allocate and link the process image with the binding generated at build time
+    ret = oplk_bindProcessImage(&xapBinding);
+    if (ret != kErrorOk)
+    {
+        eventlog_printMessage(kEventlogLevelFatal,
+                              kEventlogCategoryControl,
+                              "Binding process image failed: %s (0x%04x)\n",
+                              debugstr_getRetValStr(ret),
+                              ret);
+        return ret;
+    }
+
+    pProcessImageIn_l = (PI_IN*)oplk_getProcessImageIn();
+    pProcessImageOut_l = (const PI_OUT*)oplk_getProcessImageOut();
+#else
     ret = oplk_allocProcessImage(sizeof(PI_IN), sizeof(PI_OUT));
     if (ret != kErrorOk)
         return ret;
@@ -291,6 +312,7 @@ static tOplkError initProcessImage(void)
                               errorIndex);
         ret = kErrorApiPINotAllocated;
     }
+#endif
 
     return ret;
 }
@@ -61,6 +61,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <eventlog/eventlog.h>
 #include <firmwaremanager/firmwaremanager.h>
 #include <netselect/netselect.h>
+#include <pcapng/pcapng.h>
 
 #include <stdio.h>
 #include <limits.h>
@@ -102,7 +103,9 @@ typedef struct
 {
     char            cdcFile[256];
     char            fwInfoFile[256];
+    UINT            fwParallelTransmissions;
     char*           pLogFile;
+    char*           pCaptureFile;
     tEventlogFormat logFormat;
     UINT32          logLevel;
     UINT32          logCategory;
@@ -119,6 +122,7 @@ typedef struct
 //------------------------------------------------------------------------------
 static const UINT8  aMacAddr_l[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 static BOOL         fGsOff_l;
+static BOOL         fCapture_l;
 
 //------------------------------------------------------------------------------
 // local function prototypes
@@ -167,7 +171,7 @@ int main(int argc, char* argv[])
         return 0;
     }
 
-    fwRet = firmwaremanager_init(opts.fwInfoFile);
+    fwRet = firmwaremanager_init(opts.fwInfoFile, opts.fwParallelTransmissions);
     if (fwRet != kFwReturnOk)
     {
         fprintf(stderr, "Error initializing firmware manager!");
@@ -213,9 +217,18 @@ int main(int argc, char* argv[])
     if (ret != kErrorOk)
         goto Exit;
 
+    if (opts.pCaptureFile != NULL)
+    {
+        if (pcapng_open(opts.pCaptureFile) != 0)
+            goto Exit;
+
+        fCapture_l = TRUE;
+    }
+
     loopMain();
 
 Exit:
+    pcapng_close();
     shutdownApp();
     shutdownPowerlink();
     firmwaremanager_exit();
@@ -473,6 +486,12 @@ static void loopMain(void)
                                   "Kernel stack has gone! Exiting...");
         }
 
+        if (fCapture_l && (pcapng_streamCaptureRing() < 0))
+        {
+            fCapture_l = FALSE;
+            fprintf(stderr, "Frame capture failed! Capturing stopped.\n");
+        }
+
 #if (defined(CONFIG_USE_SYNCTHREAD) || \
      defined(CONFIG_KERNELSTACK_DIRECTLINK))
         system_msleep(100);
@@ -563,14 +582,16 @@ static int getOptions(int argc_p,
     /* setup default parameters */
     strncpy(pOpts_p->cdcFile, "mnobd.cdc", 256);
     strncpy(pOpts_p->fwInfoFile, "fw.info", 256);
+    pOpts_p->fwParallelTransmissions = 0;
     strncpy(pOpts_p->devName, "\0", 128);
     pOpts_p->pLogFile = NULL;
+    pOpts_p->pCaptureFile = NULL;
     pOpts_p->logFormat = kEventlogFormatReadable;
     pOpts_p->logCategory = 0xffffffff;
     pOpts_p->logLevel = 0xffffffff;
 
     /* get command line parameters */
-    while ((opt = getopt(argc_p, argv_p, "c:f:l:pv:t:d:")) != -1)
+    while ((opt = getopt(argc_p, argv_p, "c:f:n:l:pv:t:d:w:")) != -1)
     {
         switch (opt)
         {
@@ -582,6 +603,10 @@ static int getOptions(int argc_p,
                 strncpy(pOpts_p->fwInfoFile, optarg, 256);
                 break;
 
+            case 'n':
+                pOpts_p->fwParallelTransmissions = (UINT)strtoul(optarg, NULL, 10);
+                break;
+
             case 'd':
                 strncpy(pOpts_p->devName, optarg, 128);
                 break;
@@ -598,13 +623,19 @@ static int getOptions(int argc_p,
                 pOpts_p->logCategory = strtoul(optarg, NULL, 16);
                 break;
 
+            case 'w':
+                pOpts_p->pCaptureFile = optarg;
+                break;
+
             default: /* '?' */
-                printf("Usage: %s [-c CDC-FILE] [-f FWINFO-FILE] [-d DEV_NAME] [-v LOGLEVEL] [-t LOGCATEGORY] [-p]\n", argv_p[0]);
+                printf("Usage: %s [-c CDC-FILE] [-f FWINFO-FILE] [-n FW_PARALLEL] [-d DEV_NAME] [-v LOGLEVEL] [-t LOGCATEGORY] [-p] [-w CAPTURE-FILE]\n", argv_p[0]);
                 printf(" -d DEV_NAME: Ethernet device name to use e.g. eth1\n");
                 printf("              If option is skipped the program prompts for the interface.\n");
+                printf(" -n FW_PARALLEL: Number of firmware updates transmitted in parallel\n");
                 printf(" -p: Use parsable log format\n");
                 printf(" -v LOGLEVEL: A bit mask with log levels to be printed in the event logger\n");
                 printf(" -t LOGCATEGORY: A bit mask with log categories to be printed in the event logger\n");
+                printf(" -w CAPTURE-FILE: Write the frame capture ring of the stack into a pcapng file\n");
                 return -1;
         }
     }
@@ -0,0 +1,746 @@
+/**
+********************************************************************************
+\file   trace-ring.c
+
+\brief  Trace function using per-thread binary trace rings
+
+The trace function of this file does not format the trace message on the
+calling thread. It stores the address of the format string, a timestamp and
+the raw arguments in a lock-free ring which is owned by the calling thread.
+A background drain thread formats the records of all rings in timestamp order
+and writes them to stderr.
+
+The format string is used as the format ID of a record, therefore only string
+literals must be used as format strings. String arguments are copied into the
+record and truncated if they exceed the string space of a record. If the ring
+of a thread is full, the record is dropped and counted; the drain thread
+reports the number of lost records.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <trace/trace.h>
+
+#ifndef NDEBUG
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#ifndef TRACE_RING_RECORD_COUNT
+#define TRACE_RING_RECORD_COUNT         512         // Number of records per thread (power of 2)
+#endif
+
+#ifndef TRACE_RING_DRAIN_INTERVAL_MS
+#define TRACE_RING_DRAIN_INTERVAL_MS    10          // Period of the drain thread
+#endif
+
+#define TRACE_RING_MAX_ARGS             8           // Maximum number of arguments per record
+#define TRACE_RING_STRING_SIZE          64          // Space for string arguments per record
+#define TRACE_RING_SPEC_SIZE            32          // Maximum length of a conversion specification
+#define TRACE_RING_STRING_NONE          UINT64_MAX  // Marker for a string argument which was not stored
+
+#if ((TRACE_RING_RECORD_COUNT & (TRACE_RING_RECORD_COUNT - 1)) != 0)
+#error "TRACE_RING_RECORD_COUNT must be a power of 2"
+#endif
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Argument types
+
+The enumeration lists the types of the arguments which are stored in a record.
+*/
+typedef enum
+{
+    kTraceArgNone = 0,          ///< Literal text or unsupported conversion
+    kTraceArgInt,               ///< int and smaller
+    kTraceArgLong,              ///< long
+    kTraceArgLongLong,          ///< long long
+    kTraceArgSize,              ///< size_t and ptrdiff_t
+    kTraceArgIntMax,            ///< intmax_t
+    kTraceArgDouble,            ///< double
+    kTraceArgLongDouble,        ///< long double (stored as double)
+    kTraceArgPointer,           ///< void*
+    kTraceArgString,            ///< char*
+} tTraceArgType;
+
+/**
+\brief Conversion specification
+
+The structure describes one conversion specification of a format string.
+*/
+typedef struct
+{
+    const char*     pStart;                     ///< Start of the specification ('%')
+    size_t          length;                     ///< Length of the specification
+    int             starCount;                  ///< Number of '*' width and precision arguments
+    tTraceArgType   argType;                    ///< Type of the converted argument
+} tTraceSpec;
+
+/**
+\brief Trace record
+
+The structure contains one trace call with its raw arguments.
+*/
+typedef struct
+{
+    uint64_t        timestamp;                          ///< Monotonic time of the call [ns]
+    const char*     pFmt;                               ///< Format string (format ID)
+    uint32_t        argCount;                           ///< Number of stored arguments
+    uint32_t        stringSize;                         ///< Used space of the string buffer
+    uint64_t        aArg[TRACE_RING_MAX_ARGS];          ///< Raw arguments
+    char            aString[TRACE_RING_STRING_SIZE];    ///< Copies of the string arguments
+} tTraceRecord;
+
+/**
+\brief Trace ring
+
+The structure describes the single-producer/single-consumer ring of a thread.
+The owning thread only writes writeIndex, the drain thread only writes
+readIndex. A ring whose thread has exited is marked as free and reused by the
+next new thread.
+*/
+typedef struct sTraceRing
+{
+    uint32_t            writeIndex;                         ///< Index of the next record to write
+    uint32_t            readIndex;                          ///< Index of the next record to read
+    uint32_t            lostCount;                          ///< Number of dropped records
+    uint32_t            reportedLostCount;                  ///< Number of dropped records already reported
+    uint32_t            fFree;                              ///< Ring is not owned by a thread
+    struct sTraceRing*  pNext;                              ///< Next ring in the ring list
+    tTraceRecord        aRecord[TRACE_RING_RECORD_COUNT];   ///< Records
+} tTraceRing;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tTraceRing*          pRingList_l = NULL;
+static __thread tTraceRing* pThreadRing_l = NULL;
+static pthread_once_t       initOnce_l = PTHREAD_ONCE_INIT;
+static pthread_key_t        ringKey_l;
+static pthread_mutex_t      drainMutex_l = PTHREAD_MUTEX_INITIALIZER;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tTraceRing*  getThreadRing(void);
+static void         initTraceRing(void);
+static void         releaseRing(void* pRing_p);
+static void*        drainThread(void* pArg_p);
+static void         drainRings(void);
+static void         exitTraceRing(void);
+static const char*  parseSpec(const char* pFmt_p, tTraceSpec* pSpec_p);
+static void         storeArgs(tTraceRecord* pRecord_p, const char* pFmt_p, va_list argList_p);
+static void         printRecord(const tTraceRecord* pRecord_p);
+static void         printArg(const tTraceRecord* pRecord_p, const tTraceSpec* pSpec_p,
+                             uint32_t* pArgIndex_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Record debug trace message
+
+The function stores a debug trace message in the trace ring of the calling
+thread. The message is formatted later by the drain thread.
+
+\param[in]      fmt                 Format string
+\param[in]      ...                 Arguments to print
+*/
+//------------------------------------------------------------------------------
+void trace(const char* fmt, ...)
+{
+    tTraceRing*     pRing;
+    tTraceRecord*   pRecord;
+    uint32_t        writeIndex;
+    uint32_t        readIndex;
+    struct timespec now;
+    va_list         argptr;
+
+    pRing = getThreadRing();
+    if (pRing == NULL)
+        return;
+
+    writeIndex = pRing->writeIndex;
+    readIndex = __atomic_load_n(&pRing->readIndex, __ATOMIC_ACQUIRE);
+    if ((writeIndex - readIndex) >= TRACE_RING_RECORD_COUNT)
+    {
+        __atomic_fetch_add(&pRing->lostCount, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    pRecord = &pRing->aRecord[writeIndex & (TRACE_RING_RECORD_COUNT - 1)];
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    pRecord->timestamp = ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+    pRecord->pFmt = fmt;
+
+    va_start(argptr, fmt);
+    storeArgs(pRecord, fmt, argptr);
+    va_end(argptr);
+
+    // Publish the record to the drain thread
+    __atomic_store_n(&pRing->writeIndex, writeIndex + 1, __ATOMIC_RELEASE);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the trace ring of the calling thread
+
+The function returns the trace ring of the calling thread. On the first call of
+a thread, a free ring is claimed or a new ring is added to the ring list.
+
+\return The function returns a pointer to the ring or NULL if no ring could be
+        allocated.
+*/
+//------------------------------------------------------------------------------
+static tTraceRing* getThreadRing(void)
+{
+    tTraceRing* pRing;
+    uint32_t    fFree;
+
+    if (pThreadRing_l != NULL)
+        return pThreadRing_l;
+
+    pthread_once(&initOnce_l, initTraceRing);
+
+    // Reuse the ring of an exited thread
+    for (pRing = __atomic_load_n(&pRingList_l, __ATOMIC_ACQUIRE); pRing != NULL; pRing = pRing->pNext)
+    {
+        fFree = 1;
+        if (__atomic_compare_exchange_n(&pRing->fFree, &fFree, 0, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            break;
+    }
+
+    if (pRing == NULL)
+    {
+        pRing = (tTraceRing*)calloc(1, sizeof(tTraceRing));
+        if (pRing == NULL)
+            return NULL;
+
+        pRing->pNext = __atomic_load_n(&pRingList_l, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&pRingList_l, &pRing->pNext, pRing, 0,
+                                            __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+            ;
+    }
+
+    pThreadRing_l = pRing;
+    pthread_setspecific(ringKey_l, pRing);
+
+    return pRing;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the trace rings
+
+The function creates the thread key which releases the ring of an exiting
+thread and starts the drain thread.
+*/
+//------------------------------------------------------------------------------
+static void initTraceRing(void)
+{
+    pthread_t   thread;
+
+    pthread_key_create(&ringKey_l, releaseRing);
+
+    if (pthread_create(&thread, NULL, drainThread, NULL) == 0)
+    {
+#if (defined(__GLIBC__) && __GLIBC__ >= 2 && __GLIBC_MINOR__ >= 12)
+        pthread_setname_np(thread, "oplk-trace");
+#endif
+        pthread_detach(thread);
+    }
+
+    atexit(exitTraceRing);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release the trace ring of an exiting thread
+
+The records of the ring are still drained. The ring is reused by the next new
+thread.
+
+\param[in]      pRing_p             Pointer to the ring of the exiting thread.
+*/
+//------------------------------------------------------------------------------
+static void releaseRing(void* pRing_p)
+{
+    tTraceRing* pRing = (tTraceRing*)pRing_p;
+
+    __atomic_store_n(&pRing->fFree, 1, __ATOMIC_RELEASE);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Drain thread
+
+The thread periodically formats the records of all rings.
+
+\param[in]      pArg_p              Thread argument (unused).
+
+\return The function returns NULL.
+*/
+//------------------------------------------------------------------------------
+static void* drainThread(void* pArg_p)
+{
+    struct timespec interval;
+
+    (void)pArg_p;
+
+    interval.tv_sec = TRACE_RING_DRAIN_INTERVAL_MS / 1000;
+    interval.tv_nsec = (TRACE_RING_DRAIN_INTERVAL_MS % 1000) * 1000000L;
+
+    for (;;)
+    {
+        drainRings();
+        nanosleep(&interval, NULL);
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Drain all trace rings
+
+The function formats the pending records of all rings in the order of their
+timestamps and reports lost records.
+*/
+//------------------------------------------------------------------------------
+static void drainRings(void)
+{
+    tTraceRing*         pRing;
+    tTraceRing*         pOldest;
+    const tTraceRecord* pRecord;
+    const tTraceRecord* pOldestRecord;
+    uint32_t            lostCount;
+
+    pthread_mutex_lock(&drainMutex_l);
+
+    for (pRing = __atomic_load_n(&pRingList_l, __ATOMIC_ACQUIRE); pRing != NULL; pRing = pRing->pNext)
+    {
+        lostCount = __atomic_load_n(&pRing->lostCount, __ATOMIC_RELAXED);
+        if (lostCount != pRing->reportedLostCount)
+        {
+            fprintf(stderr, "trace: %u records lost\n", lostCount - pRing->reportedLostCount);
+            pRing->reportedLostCount = lostCount;
+        }
+    }
+
+    for (;;)
+    {
+        pOldest = NULL;
+        pOldestRecord = NULL;
+
+        for (pRing = __atomic_load_n(&pRingList_l, __ATOMIC_ACQUIRE); pRing != NULL; pRing = pRing->pNext)
+        {
+            if (pRing->readIndex == __atomic_load_n(&pRing->writeIndex, __ATOMIC_ACQUIRE))
+                continue;
+
+            pRecord = &pRing->aRecord[pRing->readIndex & (TRACE_RING_RECORD_COUNT - 1)];
+            if ((pOldestRecord == NULL) || (pRecord->timestamp < pOldestRecord->timestamp))
+            {
+                pOldest = pRing;
+                pOldestRecord = pRecord;
+            }
+        }
+
+        if (pOldest == NULL)
+            break;
+
+        printRecord(pOldestRecord);
+
+        // Give the record back to the producer
+        __atomic_store_n(&pOldest->readIndex, pOldest->readIndex + 1, __ATOMIC_RELEASE);
+    }
+
+    fflush(stderr);
+    pthread_mutex_unlock(&drainMutex_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Drain the trace rings at process exit
+*/
+//------------------------------------------------------------------------------
+static void exitTraceRing(void)
+{
+    drainRings();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Parse a conversion specification
+
+The function parses the conversion specification at the start of the given
+format string position.
+
+\param[in]      pFmt_p              Pointer to the '%' of the specification.
+\param[out]     pSpec_p             Pointer to store the specification.
+
+\return The function returns the format string position after the
+        specification.
+*/
+//------------------------------------------------------------------------------
+static const char* parseSpec(const char* pFmt_p, tTraceSpec* pSpec_p)
+{
+    const char* pPos = pFmt_p + 1;
+    int         longCount = 0;
+    char        lengthModifier = '\0';
+
+    pSpec_p->pStart = pFmt_p;
+    pSpec_p->starCount = 0;
+    pSpec_p->argType = kTraceArgNone;
+
+    // flags, field width and precision
+    while ((*pPos != '\0') && (strchr("-+ #0123456789.*'", *pPos) != NULL))
+    {
+        if (*pPos == '*')
+            pSpec_p->starCount++;
+        pPos++;
+    }
+
+    // length modifier
+    while ((*pPos != '\0') && (strchr("hlLqjzt", *pPos) != NULL))
+    {
+        if ((*pPos == 'l') || (*pPos == 'q'))
+            longCount++;
+        else
+            lengthModifier = *pPos;
+        pPos++;
+    }
+
+    switch (*pPos)
+    {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'c':
+            if ((lengthModifier == 'z') || (lengthModifier == 't'))
+                pSpec_p->argType = kTraceArgSize;
+            else if (lengthModifier == 'j')
+                pSpec_p->argType = kTraceArgIntMax;
+            else if (longCount >= 2)
+                pSpec_p->argType = kTraceArgLongLong;
+            else if (longCount == 1)
+                pSpec_p->argType = kTraceArgLong;
+            else
+                pSpec_p->argType = kTraceArgInt;
+            break;
+
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            if (lengthModifier == 'L')
+                pSpec_p->argType = kTraceArgLongDouble;
+            else
+                pSpec_p->argType = kTraceArgDouble;
+            break;
+
+        case 'p':
+            pSpec_p->argType = kTraceArgPointer;
+            break;
+
+        case 's':
+            pSpec_p->argType = kTraceArgString;
+            break;
+
+        default:
+            // '%%' and unsupported conversions are printed literally
+            break;
+    }
+
+    if (*pPos != '\0')
+        pPos++;
+
+    pSpec_p->length = (size_t)(pPos - pFmt_p);
+
+    return pPos;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store the arguments of a trace call
+
+The function stores the arguments of a trace call in a record. The types of the
+arguments are determined from the format string.
+
+\param[out]     pRecord_p           Pointer to the record.
+\param[in]      pFmt_p              Format string.
+\param[in]      argList_p           Argument list.
+*/
+//------------------------------------------------------------------------------
+static void storeArgs(tTraceRecord* pRecord_p, const char* pFmt_p, va_list argList_p)
+{
+    const char* pPos = pFmt_p;
+    tTraceSpec  spec;
+    uint32_t    argCount = 0;
+    uint32_t    stringSize = 0;
+    const char* pString;
+    size_t      length;
+    double      doubleVal;
+    int         i;
+
+    while ((pPos = strchr(pPos, '%')) != NULL)
+    {
+        pPos = parseSpec(pPos, &spec);
+        if (spec.argType == kTraceArgNone)
+            continue;
+
+        if ((argCount + (uint32_t)spec.starCount + 1) > TRACE_RING_MAX_ARGS)
+            break;
+
+        for (i = 0; i < spec.starCount; i++)
+            pRecord_p->aArg[argCount++] = (uint64_t)(int64_t)va_arg(argList_p, int);
+
+        switch (spec.argType)
+        {
+            case kTraceArgInt:
+                pRecord_p->aArg[argCount] = (uint64_t)(int64_t)va_arg(argList_p, int);
+                break;
+
+            case kTraceArgLong:
+                pRecord_p->aArg[argCount] = (uint64_t)(int64_t)va_arg(argList_p, long);
+                break;
+
+            case kTraceArgLongLong:
+                pRecord_p->aArg[argCount] = (uint64_t)va_arg(argList_p, long long);
+                break;
+
+            case kTraceArgSize:
+                pRecord_p->aArg[argCount] = (uint64_t)va_arg(argList_p, size_t);
+                break;
+
+            case kTraceArgIntMax:
+                pRecord_p->aArg[argCount] = (uint64_t)va_arg(argList_p, intmax_t);
+                break;
+
+            case kTraceArgDouble:
+            case kTraceArgLongDouble:
+                if (spec.argType == kTraceArgLongDouble)
+                    doubleVal = (double)va_arg(argList_p, long double);
+                else
+                    doubleVal = va_arg(argList_p, double);
+                memcpy(&pRecord_p->aArg[argCount], &doubleVal, sizeof(doubleVal));
+                break;
+
+            case kTraceArgPointer:
+                pRecord_p->aArg[argCount] = (uint64_t)(uintptr_t)va_arg(argList_p, void*);
+                break;
+
+            case kTraceArgString:
+                pString = va_arg(argList_p, const char*);
+                if ((pString == NULL) || (stringSize >= TRACE_RING_STRING_SIZE))
+                {
+                    pRecord_p->aArg[argCount] = TRACE_RING_STRING_NONE;
+                    break;
+                }
+
+                length = strlen(pString);
+                if (length >= (TRACE_RING_STRING_SIZE - stringSize))
+                    length = TRACE_RING_STRING_SIZE - stringSize - 1;
+
+                memcpy(&pRecord_p->aString[stringSize], pString, length);
+                pRecord_p->aString[stringSize + length] = '\0';
+                pRecord_p->aArg[argCount] = stringSize;
+                stringSize += (uint32_t)length + 1;
+                break;
+
+            default:
+                break;
+        }
+        argCount++;
+    }
+
+    pRecord_p->argCount = argCount;
+    pRecord_p->stringSize = stringSize;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print a trace record
+
+The function formats a trace record and writes it to stderr. The literal text
+of the format string is copied, each conversion specification is printed with
+its stored argument. Conversions without a stored argument are printed
+literally.
+
+\param[in]      pRecord_p           Pointer to the record.
+*/
+//------------------------------------------------------------------------------
+static void printRecord(const tTraceRecord* pRecord_p)
+{
+    const char* pPos = pRecord_p->pFmt;
+    const char* pSpecPos;
+    tTraceSpec  spec;
+    uint32_t    argIndex = 0;
+
+    while ((pSpecPos = strchr(pPos, '%')) != NULL)
+    {
+        fwrite(pPos, 1, (size_t)(pSpecPos - pPos), stderr);
+        pPos = parseSpec(pSpecPos, &spec);
+
+        if ((spec.argType == kTraceArgNone) ||
+            ((argIndex + (uint32_t)spec.starCount) >= pRecord_p->argCount))
+        {
+            if ((spec.length == 2) && (spec.pStart[1] == '%'))
+                fputc('%', stderr);
+            else
+                fwrite(spec.pStart, 1, spec.length, stderr);
+            continue;
+        }
+
+        printArg(pRecord_p, &spec, &argIndex);
+    }
+
+    fputs(pPos, stderr);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print one argument of a trace record
+
+\param[in]      pRecord_p           Pointer to the record.
+\param[in]      pSpec_p             Conversion specification of the argument.
+\param[in,out]  pArgIndex_p         Index of the next stored argument.
+*/
+//------------------------------------------------------------------------------
+static void printArg(const tTraceRecord* pRecord_p, const tTraceSpec* pSpec_p,
+                     uint32_t* pArgIndex_p)
+{
+    char        aSpec[TRACE_RING_SPEC_SIZE];
+    size_t      specLength = 0;
+    size_t      i;
+    uint64_t    arg;
+    double      doubleVal;
+    int         written;
+
+    // Build the specification with the '*' arguments inserted and without
+    // the length modifier of long double, which is stored as double
+    for (i = 0; (i < pSpec_p->length) && (specLength < (sizeof(aSpec) - 1)); i++)
+    {
+        if (pSpec_p->pStart[i] == '*')
+        {
+            written = snprintf(&aSpec[specLength], sizeof(aSpec) - specLength, "%d",
+                               (int)(int64_t)pRecord_p->aArg[(*pArgIndex_p)++]);
+            if (written > 0)
+                specLength += (size_t)written;
+            if (specLength >= sizeof(aSpec))
+                specLength = sizeof(aSpec) - 1;
+        }
+        else if ((pSpec_p->pStart[i] != 'L') || (pSpec_p->argType != kTraceArgLongDouble))
+        {
+            aSpec[specLength++] = pSpec_p->pStart[i];
+        }
+    }
+    aSpec[specLength] = '\0';
+
+    arg = pRecord_p->aArg[(*pArgIndex_p)++];
+
+    switch (pSpec_p->argType)
+    {
+        case kTraceArgInt:
+            fprintf(stderr, aSpec, (int)(int64_t)arg);
+            break;
+
+        case kTraceArgLong:
+            fprintf(stderr, aSpec, (long)(int64_t)arg);
+            break;
+
+        case kTraceArgLongLong:
+            fprintf(stderr, aSpec, (long long)arg);
+            break;
+
+        case kTraceArgSize:
+            fprintf(stderr, aSpec, (size_t)arg);
+            break;
+
+        case kTraceArgIntMax:
+            fprintf(stderr, aSpec, (intmax_t)arg);
+            break;
+
+        case kTraceArgDouble:
+        case kTraceArgLongDouble:
+            memcpy(&doubleVal, &arg, sizeof(doubleVal));
+            fprintf(stderr, aSpec, doubleVal);
+            break;
+
+        case kTraceArgPointer:
+            fprintf(stderr, aSpec, (void*)(uintptr_t)arg);
+            break;
+
+        case kTraceArgString:
+            if (arg == TRACE_RING_STRING_NONE)
+                fprintf(stderr, aSpec, "(null)");
+            else
+                fprintf(stderr, aSpec, &pRecord_p->aString[arg]);
+            break;
+
+        default:
+            break;
+    }
+}
+
+/// \}
+
+#endif
@@ -525,8 +525,8 @@ static int  powerlinkIoctl(struct inode* pInode_p,
             ret = eventkcal_postEventFromUser(arg_p);
             break;
 
-        case PLK_CMD_GET_EVENT:
-            ret = eventkcal_getEventForUser(arg_p);
+        case PLK_CMD_WAIT_EVENT:
+            ret = eventkcal_waitEventForUser(arg_p);
             break;
 
         case PLK_CMD_DLLCAL_ASYNCSEND:
@@ -542,7 +542,7 @@ static int  powerlinkIoctl(struct inode* pInode_p,
             break;
 
         case PLK_CMD_TIMESYNC_SYNC:
-            oplRet = timesynckcal_waitSyncEvent();
+            oplRet = timesynckcal_waitSyncCount((UINT32)arg_p);
             if (oplRet == kErrorRetry)
                 ret = -ERESTARTSYS;
             else
@@ -577,10 +577,8 @@ The function implements openPOWERLINK kernel module mmap function.
 static int powerlinkMmap(struct file* pFile_p,
                          struct vm_area_struct* pVmArea_p)
 {
-    void*                        pPdoMem;
-#if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
-    tTimesyncSharedMemory*       pSocTimeMem;
-#endif
+    void*       pMem = NULL;
+    size_t      memSize = 0;
     tOplkError  ret = kErrorOk;
 
     UNUSED_PARAMETER(pFile_p);
@@ -593,52 +591,58 @@ static int powerlinkMmap(struct file* pFile_p,
 
     pVmArea_p->vm_flags |= VM_RESERVED;
     pVmArea_p->vm_ops = &powerlinkVmOps_l;
-#if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
-    if (pVmArea_p->vm_pgoff == 0)
+
+    switch (pVmArea_p->vm_pgoff)
     {
-#endif
-        ret = pdokcal_getPdoMemRegion(&pPdoMem, NULL);
-
-        if ((ret != kErrorOk) || (pPdoMem == NULL))
-        {
-            DEBUG_LVL_ERROR_TRACE("%s() no PDO memory allocated!\n", __func__);
-            return -ENOMEM;
-        }
-
-        if (remap_pfn_range(pVmArea_p,
-                            pVmArea_p->vm_start,
-                            (__pa(pPdoMem) >> PAGE_SHIFT),
-                            pVmArea_p->vm_end - pVmArea_p->vm_start,
-                            pVmArea_p->vm_page_prot))
-        {
-            DEBUG_LVL_ERROR_TRACE("%s() remap_pfn_range failed for PDO memory\n",
-                                  __func__);
-            return -EAGAIN;
-        }
+        case PLK_MMAP_PGOFF_PDO:
+            ret = pdokcal_getPdoMemRegion(&pMem, NULL);
+            break;
+
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
+        case PLK_MMAP_PGOFF_SOC_TIME:
+            pMem = timesynckcal_getSharedMemory();
+            break;
+#endif
+
+        case PLK_MMAP_PGOFF_SYNC:
+            ret = timesynckcal_getSyncMem(&pMem, &memSize);
+            break;
+
+        case PLK_MMAP_PGOFF_EVENT:
+            ret = eventkcal_getEventMem(&pMem, &memSize);
+            break;
+
+        default:
+            ret = kErrorInvalidOperation;
+            break;
     }
-    else
+
+    if ((ret != kErrorOk) || (pMem == NULL))
     {
-        pSocTimeMem = timesynckcal_getSharedMemory();
-        if (pSocTimeMem == NULL)
-        {
-            DEBUG_LVL_ERROR_TRACE("%s() no timesync memory allocated!\n", __func__);
-            return -ENOMEM;
-        }
-
-        if (remap_pfn_range(pVmArea_p,
-                            pVmArea_p->vm_start,
-                            (__pa(pSocTimeMem) >> PAGE_SHIFT),
-                            pVmArea_p->vm_end - pVmArea_p->vm_start,
-                            pVmArea_p->vm_page_prot))
-        {
-            DEBUG_LVL_ERROR_TRACE("%s() remap_pfn_range failed for timesync memory\n",
-                                  __func__);
-            return -EAGAIN;
-        }
+        DEBUG_LVL_ERROR_TRACE("%s() no memory allocated for page offset %lu!\n",
+                              __func__,
+                              pVmArea_p->vm_pgoff);
+        return -ENOMEM;
+    }
 
+    if ((memSize != 0) &&
+        ((pVmArea_p->vm_end - pVmArea_p->vm_start) > PAGE_ALIGN(memSize)))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() mapping exceeds the shared memory size!\n", __func__);
+        return -EINVAL;
+    }
+
+    if (remap_pfn_range(pVmArea_p,
+                        pVmArea_p->vm_start,
+                        (__pa(pMem) >> PAGE_SHIFT),
+                        pVmArea_p->vm_end - pVmArea_p->vm_start,
+                        pVmArea_p->vm_page_prot))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() remap_pfn_range failed for page offset %lu\n",
+                              __func__,
+                              pVmArea_p->vm_pgoff);
+        return -EAGAIN;
     }
-#endif
 
     powerlinkVmaOpen(pVmArea_p);
 
@@ -119,6 +119,7 @@ typedef struct
     tTimesyncSharedMemory*  pTimesyncShm;                       ///< Pointer to timesync shared memory
 #endif
     BOOL                    fDriverActive;                      ///< Flag to identify status of driver interface.
+    tCtrlFileChunkRingAccess fileChunkRing;                     ///< File chunk ring access
 #if defined(CONFIG_INCLUDE_VETH)
     BOOL                    fVEthActive;                        ///< Flag to indicate whether the VEth interface is intialized.
     tDrvIntfCbVeth          pfnCbVeth;                          ///< Callback function to the VEth interface.
@@ -145,6 +146,13 @@ static void         exitStackInterface(void);
 static void         exitEventInterface(void);
 static void         exitDllQueueInterface(void);
 static void         exitErrHandleInterface(void);
+static tOplkError   commitFileChunk(tCtrlCmd* pCtrlCmd_p);
+static tOplkError   readCtrlBuf(void* pDest_p,
+                                size_t offset_p,
+                                size_t length_p);
+static tOplkError   writeCtrlBuf(size_t offset_p,
+                                 const void* pSrc_p,
+                                 size_t length_p);
 static tOplkError   insertAsyncDataBlock(tCircBufInstance* pDllCircBuffInst_p,
                                          const void* pData_p,
                                          size_t dataSize_p);
@@ -171,6 +179,10 @@ tOplkError drvintf_init(void)
     DEBUG_LVL_DRVINTF_TRACE("Initialize driver interface...");
 
     OPLK_MEMSET(&drvIntfInstance_l, 0, sizeof(tDrvIntfInstance));
+    ctrlcal_initFileChunkRing(&drvIntfInstance_l.fileChunkRing,
+                              readCtrlBuf,
+                              writeCtrlBuf,
+                              target_msleep);
 
     // Initialize the dualprocshm library
     ret = initDualProcShmDriver();
@@ -233,6 +245,10 @@ tOplkError drvintf_executeCmd(tCtrlCmd* pCtrlCmd_p)
     UINT16          cmd = pCtrlCmd_p->cmd;
     INT             timeout;
 
+    // File chunks are passed by the file chunk ring without a command
+    if (cmd == kCtrlWriteFileChunk)
+        return commitFileChunk(pCtrlCmd_p);
+
     // Clean up stack
     if ((cmd == kCtrlCleanupStack) ||
         (cmd == kCtrlShutdown))
@@ -1038,7 +1054,10 @@ void drvintf_unmapKernelMem(void** ppUserMem_p)
 /**
 \brief  Write file chunk
 
-This function writes the given file chunk to the file transfer buffer.
+This function writes the given file chunk to the next free slot of the file
+chunk ring. It only waits if all slots are occupied by chunks which are not yet
+acknowledged by the PCP. The chunk is passed to the PCP by executing the
+control command kCtrlWriteFileChunk.
 
 \param[in]      pDesc_p             Pointer to the file chunk descriptor.
 \param[in]      pBuf_p              Pointer to file chunk.
@@ -1051,42 +1070,14 @@ This function writes the given file chunk to the file transfer buffer.
 tOplkError drvintf_writeFileBuffer(const tOplkApiFileChunkDesc* pDesc_p,
                                    const void* pBuf_p)
 {
-    tDualprocReturn dualRet;
-
     if ((pDesc_p == NULL) ||
         (pBuf_p == NULL) ||
         (!drvIntfInstance_l.fDriverActive))
         return kErrorNoResource;
 
-    if (pDesc_p->length > CONFIG_CTRL_FILE_CHUNK_SIZE)
-    {
-        DEBUG_LVL_ERROR_TRACE("File chunk size exceeds limit!\n");
-        return kErrorNoResource;
-    }
-
-    // Write descriptor
-    dualRet = dualprocshm_writeDataCommon(drvIntfInstance_l.dualProcDrvInst,
-                                          offsetof(tCtrlBuf, fileChunkDesc),
-                                          sizeof(tOplkApiFileChunkDesc),
-                                          pDesc_p);
-    if (dualRet != kDualprocSuccessful)
-    {
-        DEBUG_LVL_ERROR_TRACE("Cannot store file chunk descriptor (0x%X)\n", dualRet);
-        return kErrorGeneralError;
-    }
-
-    // Write file chunk data into buffer
-    dualRet = dualprocshm_writeDataCommon(drvIntfInstance_l.dualProcDrvInst,
-                                          offsetof(tCtrlBuf, aFileChunkBuffer),
-                                          pDesc_p->length,
-                                          pBuf_p);
-    if (dualRet != kDualprocSuccessful)
-    {
-        DEBUG_LVL_ERROR_TRACE("Cannot store file chunk data (0x%X)\n", dualRet);
-        return kErrorGeneralError;
-    }
-
-    return kErrorOk;
+    return ctrlcal_writeFileChunk(&drvIntfInstance_l.fileChunkRing,
+                                  pDesc_p,
+                                  pBuf_p);
 }
 
 //------------------------------------------------------------------------------
@@ -1103,7 +1094,7 @@ CAL implementation.
 //------------------------------------------------------------------------------
 ULONG drvintf_getFileBufferSize(void)
 {
-    return CONFIG_CTRL_FILE_CHUNK_SIZE;
+    return CTRL_FILE_CHUNK_SLOT_SIZE;
 }
 
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
@@ -1636,4 +1627,86 @@ Exit:
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Commit a file chunk
+
+The function passes the file chunk stored in the next free slot of the file
+chunk ring to the PCP by incrementing the write counter of the ring. For the
+last chunk of a file the function waits until all chunks are acknowledged. The
+return value of the first failed chunk of the file is returned in the control
+command structure.
+
+\param[in,out]  pCtrlCmd_p          Pointer to control command structure.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError commitFileChunk(tCtrlCmd* pCtrlCmd_p)
+{
+    tOplkError  ret;
+
+    ret = ctrlcal_commitFileChunk(&drvIntfInstance_l.fileChunkRing, &pCtrlCmd_p->retVal);
+    if (ret != kErrorOk)
+        return ret;
+
+    pCtrlCmd_p->cmd = kCtrlNone;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read data from the control buffer
+
+The function reads data from the control buffer in the common memory. It is
+used by the file chunk ring.
+
+\param[out]     pDest_p             Pointer to store the read data.
+\param[in]      offset_p            Offset in the control buffer.
+\param[in]      length_p            Length of the data to be read.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError readCtrlBuf(void* pDest_p,
+                              size_t offset_p,
+                              size_t length_p)
+{
+    if (dualprocshm_readDataCommon(drvIntfInstance_l.dualProcDrvInst,
+                                   (UINT32)offset_p,
+                                   length_p,
+                                   pDest_p) != kDualprocSuccessful)
+        return kErrorNoResource;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write data to the control buffer
+
+The function writes data to the control buffer in the common memory. It is
+used by the file chunk ring.
+
+\param[in]      offset_p            Offset in the control buffer.
+\param[in]      pSrc_p              Pointer to the data to be written.
+\param[in]      length_p            Length of the data to be written.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError writeCtrlBuf(size_t offset_p,
+                               const void* pSrc_p,
+                               size_t length_p)
+{
+    if (dualprocshm_writeDataCommon(drvIntfInstance_l.dualProcDrvInst,
+                                    (UINT32)offset_p,
+                                    length_p,
+                                    pSrc_p) != kDualprocSuccessful)
+        return kErrorNoResource;
+
+    return kErrorOk;
+}
+
 /// \}
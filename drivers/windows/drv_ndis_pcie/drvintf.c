@@ -122,6 +122,7 @@ typedef struct
     tMemInfo                kernel2UserMem;                         ///< Kernel to user mapped memory.
     UINT64                  remoteProcBase;                         ///< Base address for the shared memory of the second processor.
     BOOL                    fDriverActive;                          ///< Flag to identify status of driver interface.
+    tCtrlFileChunkRingAccess fileChunkRing;                         ///< File chunk ring access
 } tDriverInstance;
 
 //------------------------------------------------------------------------------
@@ -140,6 +141,13 @@ static void       exitDualProcShm(void);
 static void       exitEvent(void);
 static void       exitDllQueues(void);
 static void       exitErrHndl(void);
+static tOplkError commitFileChunk(tCtrlCmd* pCtrlCmd_p);
+static tOplkError readCtrlBuf(void* pDest_p,
+                              size_t offset_p,
+                              size_t length_p);
+static tOplkError writeCtrlBuf(size_t offset_p,
+                               const void* pSrc_p,
+                               size_t length_p);
 static tOplkError insertDataBlock(tCircBufInstance* pDllCircBuffInst_p,
                                   const void* pData_p,
                                   size_t dataSize_p);
@@ -176,6 +184,10 @@ tOplkError drv_init(void)
     DEBUG_LVL_ALWAYS_TRACE("Initialize driver interface...");
 
     OPLK_MEMSET(&drvInstance_l, 0, sizeof(tDriverInstance));
+    ctrlcal_initFileChunkRing(&drvInstance_l.fileChunkRing,
+                              readCtrlBuf,
+                              writeCtrlBuf,
+                              target_msleep);
 
     // Initialize the dualprocshm library
     ret = initDualProcShm();
@@ -251,6 +263,10 @@ tOplkError drv_executeCmd(tCtrlCmd* pCtrlCmd_p)
 
     cmd = pCtrlCmd_p->cmd;
 
+    // File chunks are passed by the file chunk ring without a command
+    if (cmd == kCtrlWriteFileChunk)
+        return commitFileChunk(pCtrlCmd_p);
+
     // Clean up stack
     if ((cmd == kCtrlCleanupStack) ||
         (cmd == kCtrlShutdown))
@@ -876,7 +892,10 @@ void drv_unmapKernelMem(void* pUserMem_p)
 /**
 \brief  Write file chunk
 
-This function writes the given file chunk to the file transfer buffer
+This function writes the given file chunk to the next free slot of the file
+chunk ring. It only waits if all slots are occupied by chunks which are not yet
+acknowledged by the PCP. The chunk is passed to the PCP by executing the
+control command kCtrlWriteFileChunk.
 
 \param[in]      pIoctlFileChunk_p   Ioctl file chunk buffer
 
@@ -887,43 +906,15 @@ This function writes the given file chunk to the file transfer buffer
 //------------------------------------------------------------------------------
 tOplkError drv_writeFileBuffer(const tIoctlFileChunk* pIoctlFileChunk_p)
 {
-    tDualprocReturn dualRet;
-
     if (pIoctlFileChunk_p == NULL)
         return kErrorNoResource;
 
     if (!drvInstance_l.fDriverActive)
         return kErrorNoResource;
 
-    if (pIoctlFileChunk_p->desc.length > CONFIG_CTRL_FILE_CHUNK_SIZE)
-    {
-        DEBUG_LVL_ERROR_TRACE("File chunk size exceeds limit!\n");
-        return kErrorNoResource;
-    }
-
-    // Write descriptor
-    dualRet = dualprocshm_writeDataCommon(drvInstance_l.pDualProcDrvInst,
-                                          FIELD_OFFSET(tCtrlBuf, fileChunkDesc),
-                                          sizeof(tOplkApiFileChunkDesc),
-                                          &pIoctlFileChunk_p->desc);
-    if (dualRet != kDualprocSuccessful)
-    {
-        DEBUG_LVL_ERROR_TRACE("Cannot store file chunk descriptor (0x%X)\n", dualRet);
-        return kErrorGeneralError;
-    }
-
-    // Write file chunk data into buffer
-    dualRet = dualprocshm_writeDataCommon(drvInstance_l.pDualProcDrvInst,
-                                          FIELD_OFFSET(tCtrlBuf, aFileChunkBuffer),
-                                          pIoctlFileChunk_p->desc.length,
-                                          &pIoctlFileChunk_p->pData);
-    if (dualRet != kDualprocSuccessful)
-    {
-        DEBUG_LVL_ERROR_TRACE("Cannot store file chunk data (0x%X)\n", dualRet);
-        return kErrorGeneralError;
-    }
-
-    return kErrorOk;
+    return ctrlcal_writeFileChunk(&drvInstance_l.fileChunkRing,
+                                  &pIoctlFileChunk_p->desc,
+                                  &pIoctlFileChunk_p->pData);
 }
 
 //------------------------------------------------------------------------------
@@ -940,7 +931,7 @@ CAL implementation.
 //------------------------------------------------------------------------------
 size_t drv_getFileBufferSize(void)
 {
-    return CONFIG_CTRL_FILE_CHUNK_SIZE;
+    return CTRL_FILE_CHUNK_SLOT_SIZE;
 }
 
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
@@ -1583,4 +1574,86 @@ static tOplkError receiveNonPlkFrame(void* pEvent_p)
 }
 #endif
 
+//------------------------------------------------------------------------------
+/**
+\brief  Commit a file chunk
+
+The function passes the file chunk stored in the next free slot of the file
+chunk ring to the PCP by incrementing the write counter of the ring. For the
+last chunk of a file the function waits until all chunks are acknowledged. The
+return value of the first failed chunk of the file is returned in the control
+command structure.
+
+\param[in,out]  pCtrlCmd_p          Pointer to control command structure.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError commitFileChunk(tCtrlCmd* pCtrlCmd_p)
+{
+    tOplkError  ret;
+
+    ret = ctrlcal_commitFileChunk(&drvInstance_l.fileChunkRing, &pCtrlCmd_p->retVal);
+    if (ret != kErrorOk)
+        return ret;
+
+    pCtrlCmd_p->cmd = kCtrlNone;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read data from the control buffer
+
+The function reads data from the control buffer in the common memory. It is
+used by the file chunk ring.
+
+\param[out]     pDest_p             Pointer to store the read data.
+\param[in]      offset_p            Offset in the control buffer.
+\param[in]      length_p            Length of the data to be read.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError readCtrlBuf(void* pDest_p,
+                              size_t offset_p,
+                              size_t length_p)
+{
+    if (dualprocshm_readDataCommon(drvInstance_l.pDualProcDrvInst,
+                                   (UINT32)offset_p,
+                                   length_p,
+                                   pDest_p) != kDualprocSuccessful)
+        return kErrorNoResource;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write data to the control buffer
+
+The function writes data to the control buffer in the common memory. It is
+used by the file chunk ring.
+
+\param[in]      offset_p            Offset in the control buffer.
+\param[in]      pSrc_p              Pointer to the data to be written.
+\param[in]      length_p            Length of the data to be written.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError writeCtrlBuf(size_t offset_p,
+                               const void* pSrc_p,
+                               size_t length_p)
+{
+    if (dualprocshm_writeDataCommon(drvInstance_l.pDualProcDrvInst,
+                                    (UINT32)offset_p,
+                                    length_p,
+                                    pSrc_p) != kDualprocSuccessful)
+        return kErrorNoResource;
+
+    return kErrorOk;
+}
+
 /// \}
@@ -62,10 +62,17 @@ OPTION (CFG_COMPILE_SHARED_LIBRARY              "Build openPOWERLINK library as
 # Options for library features
 
 OPTION (CFG_USE_PCAP_EDRV                       "Compile openPOWERLINK library with pcap edrv" OFF)
+OPTION (CFG_USE_SPIN_HRESTIMER                  "Compile openPOWERLINK library with the sleep-and-spin high-resolution timer" OFF)
+OPTION (CFG_USE_TRACE_RING                      "Compile openPOWERLINK library with the asynchronous binary trace ring" OFF)
 OPTION (CFG_INCLUDE_MN_REDUNDANCY               "Compile MN redundancy functions into MN libraries" OFF)
 CMAKE_DEPENDENT_OPTION (CFG_STORE_RESTORE       "Support storing of OD in non-volatile memory (file system)" ON
                                                 "CFG_COMPILE_LIB_CN OR CFG_COMPILE_LIB_CNAPP_USERINTF OR CFG_COMPILE_LIB_CNAPP_KERNELINTF" OFF)
 
+IF(CFG_USE_TRACE_RING)
+    LIST(REMOVE_ITEM COMMON_LINUXUSER_SOURCES ${CONTRIB_SOURCE_DIR}/trace/trace-printf.c)
+    LIST(APPEND COMMON_LINUXUSER_SOURCES ${COMMON_LINUXUSER_TRACE_RING_SOURCES})
+ENDIF()
+
 ################################################################################
 # Add library subdirectories
 
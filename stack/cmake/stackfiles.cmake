@@ -47,6 +47,10 @@ SET(COMMON_LINUXUSER_SOURCES
     ${CONTRIB_SOURCE_DIR}/trace/trace-printf.c
     )
 
+SET(COMMON_LINUXUSER_TRACE_RING_SOURCES
+    ${CONTRIB_SOURCE_DIR}/trace/trace-ring.c
+    )
+
 SET(COMMON_LINUXKERNEL_SOURCES
     ${CONTRIB_SOURCE_DIR}/trace/trace-printk.c
     )
@@ -85,13 +89,16 @@ SET(USER_SOURCES
     ${USER_SOURCE_DIR}/api/service.c
     ${USER_SOURCE_DIR}/obd/obdu.c
     ${USER_SOURCE_DIR}/obd/obdal.c
+    ${USER_SOURCE_DIR}/obd/obdview.c
     ${USER_SOURCE_DIR}/dll/dllucal.c
     ${USER_SOURCE_DIR}/event/eventu.c
     ${USER_SOURCE_DIR}/nmt/nmtu.c
     ${USER_SOURCE_DIR}/nmt/nmtcnu.c
     ${USER_SOURCE_DIR}/nmt/nmtmnu.c
+    ${USER_SOURCE_DIR}/nmt/nmtmnuplan.c
     ${USER_SOURCE_DIR}/nmt/identu.c
     ${USER_SOURCE_DIR}/nmt/statusu.c
+    ${USER_SOURCE_DIR}/nmt/respstoreu.c
     ${USER_SOURCE_DIR}/nmt/syncu.c
     ${USER_SOURCE_DIR}/pdo/pdou.c
     ${USER_SOURCE_DIR}/pdo/pdoucal.c
@@ -103,12 +110,15 @@ SET(USER_SOURCES
     ${USER_SOURCE_DIR}/sdo/sdocom-std.c
     ${USER_SOURCE_DIR}/sdo/sdocomsrv.c
     ${USER_SOURCE_DIR}/sdo/sdocomclt.c
+    ${USER_SOURCE_DIR}/sdo/sdobatch.c
     ${USER_SOURCE_DIR}/sdo/sdoseq.c
     ${USER_SOURCE_DIR}/sdo/sdoasnd.c
     ${USER_SOURCE_DIR}/sdo/sdoudp.c
     ${USER_SOURCE_DIR}/timesync/timesyncu.c
     ${USER_SOURCE_DIR}/errhnd/errhndu.c
     ${USER_SOURCE_DIR}/ctrl/ctrlu.c
+    ${COMMON_SOURCE_DIR}/bufalloc/bufalloc.c
+    ${COMMON_SOURCE_DIR}/framepool/framepool.c
     )
 
 ################################################################################
@@ -152,6 +162,7 @@ SET(CTRL_UCAL_LINUXDPSHM_SOURCES
 SET(CTRL_UCAL_POSIXMEM_SOURCES
     ${USER_SOURCE_DIR}/ctrl/ctrlucal-mem.c
     ${COMMON_SOURCE_DIR}/ctrl/ctrlcal-posixshm.c
+    ${COMMON_SOURCE_DIR}/ctrl/ctrlcal-filechunk.c
     )
 
 SET(CTRL_UCAL_DIRECT_SOURCES
@@ -335,6 +346,7 @@ SET(KERNEL_SOURCES
 SET(CTRL_KCAL_POSIXMEM_SOURCES
     ${KERNEL_SOURCE_DIR}/ctrl/ctrlkcal-mem.c
     ${COMMON_SOURCE_DIR}/ctrl/ctrlcal-posixshm.c
+    ${COMMON_SOURCE_DIR}/ctrl/ctrlcal-filechunk.c
     )
 
 SET(CTRL_KCAL_DIRECT_SOURCES
@@ -351,6 +363,7 @@ SET(CTRL_KCAL_HOSTIF_SOURCES
 
 SET(CTRL_KCAL_DUALPROCSHM_SOURCES
     ${KERNEL_SOURCE_DIR}/ctrl/ctrlkcal-noosdual.c
+    ${COMMON_SOURCE_DIR}/ctrl/ctrlcal-filechunk.c
     )
 
 ################################################################################
@@ -459,21 +472,35 @@ SET(PDO_KCAL_DUALPROCSHM_SOURCES
     ${KERNEL_SOURCE_DIR}/timesync/timesynckcal-noosdual.c
     )
 
+SET(PDO_KCAL_RXWORKER_LINUXUSER_SOURCES
+    ${KERNEL_SOURCE_DIR}/pdo/pdokrxworker-linux.c
+    )
+
 ################################################################################
 # Kernel Ethernet
 
+SET(HRESTIMER_POSIX_SOURCES
+    ${KERNEL_SOURCE_DIR}/timer/hrestimer-posix.c
+    )
+
+SET(HRESTIMER_POSIX_SPIN_SOURCES
+    ${KERNEL_SOURCE_DIR}/timer/hrestimer-posix_spin.c
+    )
+
 SET(HARDWARE_DRIVER_LINUXUSER_SOURCES
     ${KERNEL_SOURCE_DIR}/veth/veth-linuxuser.c
-    ${KERNEL_SOURCE_DIR}/timer/hrestimer-posix.c
     ${EDRV_SOURCE_DIR}/edrvcyclic.c
     ${EDRV_SOURCE_DIR}/edrv-pcap_linux.c
+    ${EDRV_SOURCE_DIR}/edrvbusypoll-linux.c
+    ${EDRV_SOURCE_DIR}/edrvsockfilter-linux.c
     )
 
 SET(HARDWARE_DRIVER_LINUXUSERRAWSOCKET_SOURCES
     ${KERNEL_SOURCE_DIR}/veth/veth-linuxuser.c
-    ${KERNEL_SOURCE_DIR}/timer/hrestimer-posix.c
     ${EDRV_SOURCE_DIR}/edrvcyclic.c
     ${EDRV_SOURCE_DIR}/edrv-rawsock_linux.c
+    ${EDRV_SOURCE_DIR}/edrvbusypoll-linux.c
+    ${EDRV_SOURCE_DIR}/edrvsockfilter-linux.c
     )
 
 SET(HARDWARE_DRIVER_WINDOWS_SOURCES
@@ -632,6 +659,7 @@ IF (CFG_COMPILE_LIB_MNAPP_ZYNQINTF OR CFG_COMPILE_LIB_CNAPP_ZYNQINTF OR
     SET(TARGET_LINUX_SOURCES
         ${ARCH_SOURCE_DIR}/linux/target-linux.c
         ${ARCH_SOURCE_DIR}/linux/target-mutex.c
+        ${ARCH_SOURCE_DIR}/linux/target-thread.c
         ${ARCH_SOURCE_DIR}/linux/netif-linux.c
         ${ARCH_SOURCE_DIR}/linux/lock-linuxdualproc.c
         )
@@ -639,6 +667,7 @@ ELSE ()
     SET(TARGET_LINUX_SOURCES
         ${ARCH_SOURCE_DIR}/linux/target-linux.c
         ${ARCH_SOURCE_DIR}/linux/target-mutex.c
+        ${ARCH_SOURCE_DIR}/linux/target-thread.c
         ${ARCH_SOURCE_DIR}/linux/netif-linux.c
         )
 ENDIF ()
@@ -769,12 +798,16 @@ SET(USER_HEADERS
     ${STACK_INCLUDE_DIR}/user/ledu.h
     ${STACK_INCLUDE_DIR}/user/nmtcnu.h
     ${STACK_INCLUDE_DIR}/user/nmtmnu.h
+    ${STACK_INCLUDE_DIR}/user/nmtmnuplan.h
     ${STACK_INCLUDE_DIR}/user/nmtu.h
     ${STACK_INCLUDE_DIR}/user/obdconf.h
     ${STACK_INCLUDE_DIR}/user/obdu.h
+    ${STACK_INCLUDE_DIR}/user/obdview.h
     ${STACK_INCLUDE_DIR}/user/pdou.h
     ${STACK_INCLUDE_DIR}/user/pdoucal.h
+    ${STACK_INCLUDE_DIR}/user/respstoreu.h
     ${STACK_INCLUDE_DIR}/user/sdocom.h
+    ${STACK_INCLUDE_DIR}/user/sdobatch.h
     ${STACK_INCLUDE_DIR}/user/sdotest.h
     ${STACK_INCLUDE_DIR}/user/sdoseq.h
     ${STACK_INCLUDE_DIR}/user/sdoal.h
@@ -805,9 +838,12 @@ SET(KERNEL_HEADERS
     ${STACK_INCLUDE_DIR}/kernel/pdok.h
     ${STACK_INCLUDE_DIR}/kernel/pdokcal.h
     ${STACK_INCLUDE_DIR}/kernel/pdoklut.h
+    ${STACK_INCLUDE_DIR}/kernel/pdokrxworker.h
     ${STACK_INCLUDE_DIR}/kernel/veth.h
     ${STACK_INCLUDE_DIR}/kernel/edrv.h
     ${STACK_INCLUDE_DIR}/kernel/edrvcyclic.h
+    ${STACK_INCLUDE_DIR}/kernel/edrvbusypoll.h
+    ${STACK_INCLUDE_DIR}/kernel/edrvsockfilter.h
     ${STACK_INCLUDE_DIR}/kernel/timesynck.h
     ${STACK_INCLUDE_DIR}/kernel/timesynckcal.h
     )
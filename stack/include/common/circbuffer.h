@@ -46,8 +46,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define NR_OF_CIRC_BUFFERS              20
 #define CIRCBUF_BLOCK_ALIGNMENT         4
 
-#undef  DEBUG_CIRCBUF_SIZE_CHECK                // Add debug code for retrieving maximum used buffer size
-
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
@@ -88,11 +86,31 @@ typedef struct
     UINT32              readOffset;         ///< The read offset
     UINT32              freeSize;           ///< Available space in buffer
     UINT32              dataCount;          ///< The entry count
-#ifdef DEBUG_CIRCBUF_SIZE_CHECK
-    UINT32              maxSize;            ///< Maximum used space in circular buffer
-#endif
+    UINT32              maxUsedSize;        ///< Maximum used space in circular buffer
+    UINT32              maxDataCount;       ///< Maximum entry count
+    UINT32              fullCount;          ///< Number of writes rejected because the buffer was full
+    UINT32              discardCount;       ///< Number of entries discarded to make space for new ones
 } tCircBufHeader;
 
+/**
+*  \brief Circular buffer statistics
+*
+*  The struct contains the occupancy statistics of a circular buffer. The
+*  statistics are kept in the shared header, therefore they cover the accesses
+*  of all threads and processes using the buffer. They are not cleared by
+*  circbuf_reset().
+*/
+typedef struct
+{
+    UINT32              bufferSize;         ///< Total size of circular buffer
+    UINT32              usedSize;           ///< Currently used space in circular buffer
+    UINT32              maxUsedSize;        ///< Maximum used space in circular buffer
+    UINT32              dataCount;          ///< Current entry count
+    UINT32              maxDataCount;       ///< Maximum entry count
+    UINT32              fullCount;          ///< Number of writes rejected because the buffer was full
+    UINT32              discardCount;       ///< Number of entries discarded to make space for new ones
+} tCircBufStatistics;
+
 /**
 *  \brief Circular buffer instance
 *
@@ -129,13 +147,12 @@ tCircBufError circbuf_writeMultipleData(tCircBufInstance* pInstance_p, const voi
 tCircBufError circbuf_readData(tCircBufInstance* pInstance_p, void* pData_p,
                                size_t size_p, size_t* pDataBlockSize_p)
                                SECTION_CIRCBUF_READ_DATA;
+tCircBufError circbuf_discardData(tCircBufInstance* pInstance_p);
 UINT32        circbuf_getDataCount(const tCircBufInstance* pInstance_p);
+void          circbuf_getStatistics(const tCircBufInstance* pInstance_p,
+                                    tCircBufStatistics* pStatistics_p);
 tCircBufError circBuf_setSignaling(tCircBufInstance* pInstance_p, VOIDFUNCPTR pfnSigCb_p);
 
-#ifdef DEBUG_CIRCBUF_SIZE_CHECK
-UINT32        circbuf_getMaxSize(const tCircBufInstance* pInstance_p);
-#endif
-
 #ifdef __cplusplus
 }
 #endif
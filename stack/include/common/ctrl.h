@@ -41,6 +41,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // includes
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
+#include <common/dllcal.h>
 
 //------------------------------------------------------------------------------
 // const defines
@@ -111,8 +112,9 @@ between user and kernel stack.
 */
 typedef struct
 {
-    UINT8           aMacAddress[6];     ///< MAC address of the network interface
-    char            aNetIfName[128];    ///< Device name of the network interface
+    UINT8               aMacAddress[6];     ///< MAC address of the network interface
+    char                aNetIfName[128];    ///< Device name of the network interface
+    tDllCalQueueSizes   dllCalQueueSizes;   ///< Sizes of the DLL CAL asynchronous Tx queues
 } tCtrlInitParam;
 
 //------------------------------------------------------------------------------
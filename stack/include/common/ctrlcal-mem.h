@@ -48,6 +48,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #define CTRL_MAGIC          0xA5A5
 
+#define CTRL_FILE_CHUNK_RING_COUNT      CONFIG_CTRL_FILE_CHUNK_RING_COUNT
+#define CTRL_FILE_CHUNK_SLOT_SIZE       ((CONFIG_CTRL_FILE_CHUNK_SIZE / CTRL_FILE_CHUNK_RING_COUNT) & ~3U)
+#define CTRL_FILE_CHUNK_TIMEOUT_CNT     1000    // Loop count for the file chunk ring timeout in units of 1 ms
+
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
@@ -63,6 +67,46 @@ typedef struct sCtrlCmd
     UINT16                  retVal;         ///< The return value of the command
 } tCtrlCmd;
 
+/**
+\brief Structure for a file chunk slot
+
+The structure defines one slot of the file chunk ring.
+*/
+typedef struct
+{
+    tOplkApiFileChunkDesc   desc;           ///< File chunk descriptor
+    UINT8                   aBuffer[CTRL_FILE_CHUNK_SLOT_SIZE];
+                                            ///< File chunk data
+} tCtrlFileChunkSlot;
+
+/**
+\brief Structure for the file chunk ring
+
+The file chunk ring transfers file chunks from the user to the kernel layer
+without waiting for the completion of every single chunk. The user layer
+stores a chunk in the slot \p writeCount modulo CTRL_FILE_CHUNK_RING_COUNT and
+increments \p writeCount afterwards. The kernel layer processes the chunks in
+the same order and acknowledges every chunk by incrementing \p ackCount. The
+return value of the first failed chunk of a file is kept in \p retVal.
+
+\p writeCount is only written by the user layer, \p ackCount and \p retVal
+are only written by the kernel layer. The user layer resets \p retVal before
+the first chunk of a file is stored while all chunks are acknowledged. A slot
+is completely written before \p writeCount is incremented, and \p retVal is
+written before \p ackCount is incremented. Both layers access the ring only
+through the functions of ctrlcal-filechunk.c, which order these accesses with
+memory barriers.
+*/
+typedef struct
+{
+    UINT16                  writeCount;     ///< Number of chunks stored by the user layer
+    UINT16                  ackCount;       ///< Number of chunks acknowledged by the kernel layer
+    UINT16                  retVal;         ///< Return value of the first failed chunk
+    UINT16                  reserved;       ///< Reserved for alignment
+    tCtrlFileChunkSlot      aSlot[CTRL_FILE_CHUNK_RING_COUNT];
+                                            ///< File chunk slots
+} tCtrlFileChunkRing;
+
 /**
 \brief Structure for control buffer
 
@@ -76,11 +120,59 @@ typedef struct
     UINT16                  heartbeat;      ///< Heartbeat counter
     tCtrlCmd                ctrlCmd;        ///< The control command structure
     tCtrlInitParam          initParam;      ///< The initialization parameter structure
-    tOplkApiFileChunkDesc   fileChunkDesc;  ///< File chunk descriptor
-    UINT8                   aFileChunkBuffer[CONFIG_CTRL_FILE_CHUNK_SIZE];
-                                            ///< File chunk transfer buffer
+    tCtrlFileChunkRing      fileChunkRing;  ///< File chunk transfer ring
 } tCtrlBuf;
 
+/**
+\brief Function type for reading from the control buffer
+
+\param[out]     pDest_p             Pointer to store the read data.
+\param[in]      offset_p            Offset in the control buffer.
+\param[in]      length_p            Length of the data to be read.
+
+\return The function returns a tOplkError error code.
+*/
+typedef tOplkError (*tCtrlCalReadDataCb)(void* pDest_p,
+                                         size_t offset_p,
+                                         size_t length_p);
+
+/**
+\brief Function type for writing to the control buffer
+
+\param[in]      offset_p            Offset in the control buffer.
+\param[in]      pSrc_p              Pointer to the data to be written.
+\param[in]      length_p            Length of the data to be written.
+
+\return The function returns a tOplkError error code.
+*/
+typedef tOplkError (*tCtrlCalWriteDataCb)(size_t offset_p,
+                                          const void* pSrc_p,
+                                          size_t length_p);
+
+/**
+\brief Function type for sleeping while waiting for the file chunk ring
+
+\param[in]      milliSeconds_p      Number of milliseconds to sleep.
+*/
+typedef void (*tCtrlCalSleepCb)(UINT32 milliSeconds_p);
+
+/**
+\brief File chunk ring access
+
+The structure contains the functions used to access the file chunk ring in the
+control buffer and the state of the file chunk which is stored by the user
+layer but not yet committed. It is initialized with
+ctrlcal_initFileChunkRing().
+*/
+typedef struct
+{
+    tCtrlCalReadDataCb      pfnReadData;    ///< Function for reading from the control buffer
+    tCtrlCalWriteDataCb     pfnWriteData;   ///< Function for writing to the control buffer
+    tCtrlCalSleepCb         pfnSleep;       ///< Function for sleeping while waiting for acknowledgements
+    BOOL                    fChunkStored;   ///< A file chunk is stored in the next free slot
+    BOOL                    fLastChunk;     ///< The stored file chunk is the last chunk of the file
+} tCtrlFileChunkRingAccess;
+
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
@@ -89,6 +181,23 @@ extern "C"
 {
 #endif
 
+void       ctrlcal_initFileChunkRing(tCtrlFileChunkRingAccess* pAccess_p,
+                                     tCtrlCalReadDataCb pfnReadData_p,
+                                     tCtrlCalWriteDataCb pfnWriteData_p,
+                                     tCtrlCalSleepCb pfnSleep_p);
+tOplkError ctrlcal_resetFileChunkRing(const tCtrlFileChunkRingAccess* pAccess_p);
+tOplkError ctrlcal_writeFileChunk(tCtrlFileChunkRingAccess* pAccess_p,
+                                  const tOplkApiFileChunkDesc* pDesc_p,
+                                  const void* pBuffer_p);
+tOplkError ctrlcal_commitFileChunk(tCtrlFileChunkRingAccess* pAccess_p,
+                                   UINT16* pRetVal_p);
+tOplkError ctrlcal_readFileChunk(const tCtrlFileChunkRingAccess* pAccess_p,
+                                 tOplkApiFileChunkDesc* pDesc_p,
+                                 size_t bufferSize_p,
+                                 void* pBuffer_p);
+BOOL       ctrlcal_isFileChunkPending(const tCtrlFileChunkRingAccess* pAccess_p);
+void       ctrlcal_ackFileChunk(const tCtrlFileChunkRingAccess* pAccess_p,
+                                UINT16 retVal_p);
 
 #ifdef __cplusplus
 }
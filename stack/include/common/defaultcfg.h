@@ -85,10 +85,18 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_DLLCAL_BUFFER_SIZE_TX_VETH               32768               // Default size for virtual Ethernet Tx queue
 #endif
 
+#ifndef CONFIG_DLLCAL_TX_OVERFLOW_POLICY
+#define CONFIG_DLLCAL_TX_OVERFLOW_POLICY                DLLCAL_TX_OVERFLOW_REJECT   // Handling of full asynchronous Tx queues
+#endif
+
 #ifndef CONFIG_CTRL_FILE_CHUNK_SIZE
 #define CONFIG_CTRL_FILE_CHUNK_SIZE                     1024
 #endif
 
+#ifndef CONFIG_CTRL_FILE_CHUNK_RING_COUNT
+#define CONFIG_CTRL_FILE_CHUNK_RING_COUNT               2                   // number of slots sharing the file chunk transfer buffer
+#endif
+
 #ifndef CONFIG_DLL_PRES_CHAINING_CN
 #define CONFIG_DLL_PRES_CHAINING_CN                     FALSE
 #endif
@@ -101,6 +109,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC       FALSE
 #endif
 
+#ifndef CONFIG_DLL_PRES_LATE_DATA
+#define CONFIG_DLL_PRES_LATE_DATA                       FALSE               // rebuild the prepared PRes on CN when the application publishes new TPDO data (must be set in user and kernel layer)
+#endif
+
+#ifndef CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES
+#define CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES            0                   // number of PReq/PRes cycles per response time report on CN (0 = disabled)
+#endif
+
 #if defined(CONFIG_INCLUDE_NMT_MN)
 
 // MN should support generic Asnd frames, thus the maximum ID
@@ -169,6 +185,34 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif /* defined(CONFIG_INCLUDE_NMT_MN) */
 #endif /* CONFIG_DLL_PRES_FILTER_COUNT */
 
+#ifndef CONFIG_DLL_FRAME_CAPTURE
+#define CONFIG_DLL_FRAME_CAPTURE                        FALSE               // capture received and cyclically sent frames into the capture ring
+#endif
+
+#ifndef CONFIG_DLL_FRAME_CAPTURE_SNAPLEN
+#define CONFIG_DLL_FRAME_CAPTURE_SNAPLEN                64                  // number of captured bytes per frame (including the Ethernet header)
+#endif
+
+#ifndef CONFIG_SDO_BATCH_MAX_REQUESTS
+#if defined(CONFIG_INCLUDE_NMT_MN)
+#define CONFIG_SDO_BATCH_MAX_REQUESTS                   256                 // maximum number of submitted and not yet polled SDO batch requests
+#else /* defined(CONFIG_INCLUDE_NMT_MN) */
+#define CONFIG_SDO_BATCH_MAX_REQUESTS                   16                  // maximum number of submitted and not yet polled SDO batch requests
+#endif /* defined(CONFIG_INCLUDE_NMT_MN) */
+#endif /* CONFIG_SDO_BATCH_MAX_REQUESTS */
+
+#ifndef CONFIG_SDO_BATCH_MAX_CHANNELS
+#if defined(CONFIG_INCLUDE_NMT_MN)
+#define CONFIG_SDO_BATCH_MAX_CHANNELS                   8                   // maximum number of SDO connections used in parallel by the SDO batch
+#else /* defined(CONFIG_INCLUDE_NMT_MN) */
+#define CONFIG_SDO_BATCH_MAX_CHANNELS                   1                   // maximum number of SDO connections used in parallel by the SDO batch
+#endif /* defined(CONFIG_INCLUDE_NMT_MN) */
+#endif /* CONFIG_SDO_BATCH_MAX_CHANNELS */
+
+#ifndef CONFIG_SDO_BATCH_MAX_MULTI_ACCESS
+#define CONFIG_SDO_BATCH_MAX_MULTI_ACCESS               16                  // maximum number of objects aggregated into one Read/Write Multiple transfer
+#endif
+
 #ifndef NMT_MAX_NODE_ID
 #if (defined(CONFIG_INCLUDE_NMT_MN) || (CONFIG_DLL_PRES_FILTER_COUNT != 0))
 #define NMT_MAX_NODE_ID                                 254                 // maximum node-ID with MN or cross-traffic support
@@ -222,6 +266,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_OBD_USE_STRING_DOMAIN_IN_RAM             TRUE
 #endif
 
+#ifndef CONFIG_OBD_VIEW_COUNT
+#define CONFIG_OBD_VIEW_COUNT                           4
+#endif
+
 #ifndef CONFIG_OBD_INCLUDE_A000_TO_DEVICE_PART
 #define CONFIG_OBD_INCLUDE_A000_TO_DEVICE_PART          FALSE
 #endif
@@ -259,6 +307,76 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_EDRV_AUTO_RESPONSE_DELAY                 FALSE
 #endif
 
+// Build the busy-poll receive mode of the Linux user space Edrvs. The DLL then
+// reports the cycle timing to the Edrv.
+#ifndef CONFIG_EDRV_BUSY_POLL
+#define CONFIG_EDRV_BUSY_POLL                           FALSE
+#endif
+
+// Time before the expected SoC a busy-polling Linux user space Edrv starts to
+// poll the socket again
+#ifndef CONFIG_EDRV_BUSY_POLL_GUARD_US
+#define CONFIG_EDRV_BUSY_POLL_GUARD_US                  100
+#endif
+
+// Time without received frames after which a busy-polling Linux user space
+// Edrv stops to poll and waits in the kernel
+#ifndef CONFIG_EDRV_BUSY_POLL_IDLE_TIMEOUT_US
+#define CONFIG_EDRV_BUSY_POLL_IDLE_TIMEOUT_US           500
+#endif
+
+// Publish the PDO images once per cycle instead of per channel (see tPdoImageInfo)
+#ifndef CONFIG_PDO_CYCLE_COHERENT
+#define CONFIG_PDO_CYCLE_COHERENT                       FALSE
+#endif
+
+// Provide the accuracy of the high-resolution timer to the API (only supported
+// by the sleep-and-spin timer of the single process Linux libraries)
+#ifndef CONFIG_HRESTIMER_USE_DIAGNOSTICS
+#define CONFIG_HRESTIMER_USE_DIAGNOSTICS                FALSE
+#endif
+
+// Number of worker threads which copy received RPDOs into the PDO memory on
+// Linux user space (0 = RPDOs are processed by the kernel event thread)
+#ifndef CONFIG_PDOK_RX_WORKER_COUNT
+#define CONFIG_PDOK_RX_WORKER_COUNT                     0
+#endif
+
+// Number of received frames which can be queued for each RPDO worker thread
+#ifndef CONFIG_PDOK_RX_WORKER_QUEUE_SIZE
+#define CONFIG_PDOK_RX_WORKER_QUEUE_SIZE                64
+#endif
+
+// Time before the expected sync event the user layer starts to spin on the
+// sync shared memory instead of blocking in the kernel (0 = disabled)
+#ifndef CONFIG_TIMESYNCU_SYNC_SPIN_TIME_US
+#define CONFIG_TIMESYNCU_SYNC_SPIN_TIME_US              0
+#endif
+
+// Application load [%] of the sync period above which the adaptive
+// synchronization increases the sync period
+#ifndef CONFIG_TIMESYNCU_ADAPTIVE_HIGH_LOAD
+#define CONFIG_TIMESYNCU_ADAPTIVE_HIGH_LOAD             80
+#endif
+
+// Application load [%] of the sync period below which the adaptive
+// synchronization decreases the sync period
+#ifndef CONFIG_TIMESYNCU_ADAPTIVE_LOW_LOAD
+#define CONFIG_TIMESYNCU_ADAPTIVE_LOW_LOAD              40
+#endif
+
+// Number of sync events with low load before the sync period is decreased
+#ifndef CONFIG_TIMESYNCU_ADAPTIVE_HOLD_SYNCS
+#define CONFIG_TIMESYNCU_ADAPTIVE_HOLD_SYNCS            100
+#endif
+
+// Number of cycles after which changed MN CN Loss of PRes threshold counters
+// are written from the local copy of the kernel error handler to the error
+// handler objects (1 = every cycle)
+#ifndef CONFIG_ERRHNDK_THRESHOLD_CNT_MIRROR_CYCLES
+#define CONFIG_ERRHNDK_THRESHOLD_CNT_MIRROR_CYCLES      8
+#endif
+
 #ifndef CONFIG_PDO_SETUP_WAIT_TIME
 #define CONFIG_PDO_SETUP_WAIT_TIME                      500
 #endif
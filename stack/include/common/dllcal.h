@@ -61,6 +61,25 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CONFIG_DLLCAL_BUFFER_SIZE_TX_VETH   8192
 #endif
 
+#ifndef CONFIG_DLLCAL_BUFFER_SIZE_CAPTURE
+#define CONFIG_DLLCAL_BUFFER_SIZE_CAPTURE   65536
+#endif
+
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+// The capture memory is split into one single-producer ring per direction
+#define DLLCAL_CAPTURE_RING_COUNT           2
+#define DLLCAL_CAPTURE_RING_SLOTS           ((CONFIG_DLLCAL_BUFFER_SIZE_CAPTURE / DLLCAL_CAPTURE_RING_COUNT) / \
+                                             sizeof(tDllCalCaptureRecord))
+
+// The capture rings are written and read without a lock, the indices are
+// therefore published with a full memory barrier.
+#if defined(__GNUC__)
+#define DLLCAL_CAPTURE_BARRIER()            __sync_synchronize()
+#else
+#define DLLCAL_CAPTURE_BARRIER()            OPLK_MEMBAR()
+#endif
+#endif
+
 /* setup interface getting function for DLLCAL queue */
 #if (CONFIG_DLLCAL_QUEUE == DIRECT_QUEUE)
 #define GET_DLLKCAL_INTERFACE dllcaldirect_getInterface
@@ -91,6 +110,36 @@ typedef struct
     UINT8                   soaFlag1;
 } tDllCalIssueRequest;
 
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+/**
+\brief Frame capture record
+
+This structure is a slot of a frame capture ring. Only the header and the
+captured bytes of the frame are valid.
+*/
+typedef struct
+{
+    tOplkApiCaptureRecord   header;                                     ///< Record header
+    UINT8                   aData[CONFIG_DLL_FRAME_CAPTURE_SNAPLEN];    ///< Captured frame bytes
+} tDllCalCaptureRecord;
+
+/**
+\brief Frame capture ring
+
+This structure is a single-producer single-consumer ring of capture records.
+The write index is only changed by the kernel DLL context which captures the
+frames of the ring's direction, the read index is only changed by the user DLL
+CAL module. One slot is always kept free to distinguish a full from an empty
+ring.
+*/
+typedef struct
+{
+    volatile UINT32         writeIndex;                             ///< Index of the next slot to be written
+    volatile UINT32         readIndex;                              ///< Index of the next slot to be read
+    tDllCalCaptureRecord    aSlot[DLLCAL_CAPTURE_RING_SLOTS];       ///< Record slots
+} tDllCalCaptureRing;
+#endif
+
 /**
 \brief enumerator for queue
 
@@ -121,14 +170,45 @@ SHB)
 */
 typedef void* tDllCalQueueInstance;
 
+/**
+\brief DLL CAL Tx queue sizes
+
+The structure contains the sizes of the asynchronous Tx queues in bytes. A size
+of 0 selects the configured default size of the queue.
+*/
+typedef struct
+{
+    UINT32                  txNmtSize;          ///< Size of the NMT priority Tx queue
+    UINT32                  txGenSize;          ///< Size of the generic priority Tx queue
+    UINT32                  txSyncSize;         ///< Size of the SyncRequest Tx queue
+    UINT32                  txVethSize;         ///< Size of the virtual Ethernet Tx queue
+} tDllCalQueueSizes;
+
+/**
+\brief DLL CAL queue statistics
+
+The structure contains the occupancy statistics of a DLL CAL queue.
+*/
+typedef struct
+{
+    UINT32                  queueSize;          ///< Size of the queue in bytes
+    UINT32                  usedSize;           ///< Currently used size of the queue in bytes
+    UINT32                  maxUsedSize;        ///< Maximum used size of the queue in bytes
+    UINT32                  frameCount;         ///< Number of frames currently in the queue
+    UINT32                  maxFrameCount;      ///< Maximum number of frames in the queue
+    UINT32                  rejectCount;        ///< Number of frames rejected because the queue was full
+    UINT32                  discardCount;       ///< Number of old frames discarded to make space for new ones
+} tDllCalQueueStatistics;
+
 typedef struct
 {
-    tOplkError (*pfnAddInstance)(tDllCalQueueInstance* ppDllCalQueue_p, tDllCalQueue DllCalQueue_p);
+    tOplkError (*pfnAddInstance)(tDllCalQueueInstance* ppDllCalQueue_p, tDllCalQueue DllCalQueue_p, size_t queueSize_p);
     tOplkError (*pfnDelInstance)(tDllCalQueueInstance pDllCalQueue_p);
     tOplkError (*pfnInsertDataBlock)(tDllCalQueueInstance pDllCalQueue_p, const void* pData_p, size_t dataSize_p);
     tOplkError (*pfnGetDataBlock)(tDllCalQueueInstance pDllCalQueue_p, void* pData_p, size_t* pDataSize_p);
     tOplkError (*pfnGetDataBlockCount)(tDllCalQueueInstance pDllCalQueue_p, UINT* pDataBlockCount_p);
     tOplkError (*pfnResetDataBlockQueue)(tDllCalQueueInstance pDllCalQueue_p);
+    tOplkError (*pfnGetStatistics)(tDllCalQueueInstance pDllCalQueue_p, tDllCalQueueStatistics* pStatistics_p);
 } tDllCalFuncIntf;
 
 //------------------------------------------------------------------------------
@@ -50,6 +50,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define PLK_DEV_FILE      "/dev/plk"
 #define PLK_IOC_MAGIC     '='
 
+//------------------------------------------------------------------------------
+//  Page offsets for <mmap>
+//------------------------------------------------------------------------------
+#define PLK_MMAP_PGOFF_PDO                      0       ///< PDO memory
+#define PLK_MMAP_PGOFF_SOC_TIME                 1       ///< SoC time shared memory
+#define PLK_MMAP_PGOFF_SYNC                     2       ///< Sync shared memory (tSyncShm)
+#define PLK_MMAP_PGOFF_EVENT                    3       ///< Event shared memory (tEventShm)
+
+#define PLK_EVENT_SHM_RING_SIZE                 32768   ///< Size of the kernel-to-user event ring (power of 2)
+#define PLK_EVENT_SHM_ALIGN                     8       ///< Alignment of the event ring entries
+
 //------------------------------------------------------------------------------
 //  Commands for <ioctl>
 //------------------------------------------------------------------------------
@@ -59,7 +70,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define PLK_CMD_CTRL_GET_STATUS                 _IOR (PLK_IOC_MAGIC, 3, UINT16)
 #define PLK_CMD_CTRL_GET_HEARTBEAT              _IOR (PLK_IOC_MAGIC, 4, UINT16)
 #define PLK_CMD_POST_EVENT                      _IOW (PLK_IOC_MAGIC, 5, tEvent)
-#define PLK_CMD_GET_EVENT                       _IOR (PLK_IOC_MAGIC, 6, tEvent)
+#define PLK_CMD_WAIT_EVENT                      _IO  (PLK_IOC_MAGIC, 6)
 #define PLK_CMD_DLLCAL_ASYNCSEND                _IO  (PLK_IOC_MAGIC, 7)
 #define PLK_CMD_ERRHND_WRITE                    _IOW (PLK_IOC_MAGIC, 8, tErrHndIoctl)
 #define PLK_CMD_ERRHND_READ                     _IOR (PLK_IOC_MAGIC, 9, tErrHndIoctl)
@@ -68,6 +79,49 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
+/**
+\brief Sync shared memory
+
+The structure is written by the kernel module on every sync event and mapped
+read-only into the user layer. The user layer detects a sync event by a change
+of the sync counter and only blocks in the PLK_CMD_TIMESYNC_SYNC ioctl if no
+sync event is pending.
+*/
+typedef struct
+{
+    volatile UINT32         syncCount;      ///< Number of sync events, the ioctl argument of PLK_CMD_TIMESYNC_SYNC
+    volatile UINT32         syncPeriod;     ///< Time between the last two sync events [ns]
+    volatile UINT64         syncTime;       ///< Monotonic time of the last sync event [ns]
+} tSyncShm;
+
+/**
+\brief Event shared memory entry
+
+Each event in the ring of tEventShm starts with this header. It is followed by
+the tEvent structure and the event argument. An entry with an eventSize of 0
+is a padding entry which fills the ring up to its end.
+*/
+typedef struct
+{
+    UINT32                  entrySize;      ///< Size of the entry including the header, aligned to PLK_EVENT_SHM_ALIGN
+    UINT32                  eventSize;      ///< Size of the event including the event argument
+} tEventShmEntry;
+
+/**
+\brief Event shared memory
+
+The structure contains the ring which transfers kernel-to-user and
+user-internal events from the kernel module to the user layer. The ring is
+written by the kernel module and read by the user layer without a system call.
+The user layer only blocks in the PLK_CMD_WAIT_EVENT ioctl if the ring is
+empty. The offsets are free running and wrap at PLK_EVENT_SHM_RING_SIZE.
+*/
+typedef struct
+{
+    volatile UINT32         writeOffset;    ///< Write offset, only changed by the kernel module
+    volatile UINT32         readOffset;     ///< Read offset, only changed by the user layer, the ioctl argument of PLK_CMD_WAIT_EVENT
+    UINT8                   aRing[PLK_EVENT_SHM_RING_SIZE];     ///< Event ring
+} tEventShm;
 
 //------------------------------------------------------------------------------
 // function prototypes
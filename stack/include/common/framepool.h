@@ -0,0 +1,103 @@
+/**
+********************************************************************************
+\file   common/framepool.h
+
+\brief  Definitions for frame pool library
+
+This file contains the definitions for the frame pool library.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_common_framepool_H_
+#define _INC_common_framepool_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/bufalloc.h>
+#include <oplk/frame.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+/**
+\brief Frame pool statistics
+
+The structure contains the occupancy statistics of a frame pool.
+*/
+typedef struct
+{
+    UINT        frameCount;                 ///< Number of frames in the pool
+    UINT        usedCount;                  ///< Number of frames currently in use
+    UINT        maxUsedCount;               ///< Maximum number of frames in use at the same time
+    UINT32      allocCount;                 ///< Number of successful frame allocations
+    UINT32      allocFailCount;             ///< Number of frame allocations failed due to an empty pool
+} tFramePoolStatistics;
+
+/**
+\brief Structure describing a frame pool
+
+The structure describes a pool of equally sized frames which are allocated in
+one contiguous memory block. The free frames are managed by a buffer allocation
+instance.
+*/
+typedef struct
+{
+    tBufAlloc*              pBufAlloc;      ///< Buffer allocation instance holding the free frames
+    UINT8*                  pMemBase;       ///< Start of the frame memory
+    size_t                  frameSize;      ///< Size of one frame in the memory block
+    tFramePoolStatistics    statistics;     ///< Occupancy statistics
+} tFramePool;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+tFramePool* framepool_create(UINT frameCount_p, size_t frameSize_p);
+void        framepool_destroy(tFramePool* pFramePool_p);
+tPlkFrame*  framepool_getFrame(tFramePool* pFramePool_p);
+tOplkError  framepool_releaseFrame(tFramePool* pFramePool_p, tPlkFrame* pFrame_p);
+BOOL        framepool_isPoolFrame(const tFramePool* pFramePool_p, const tPlkFrame* pFrame_p);
+void        framepool_getStatistics(const tFramePool* pFramePool_p,
+                                    tFramePoolStatistics* pStatistics_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_common_framepool_H_ */
@@ -96,7 +96,8 @@ typedef struct
 {
     UINT8               channelId;              ///< ID of the PDO channel
     UINT8               fTx;                    ///< Flag determines the direction. TRUE = TPDO, FALSE = RPDO
-    UINT8               aPadding[2];            ///< Padding for 32 bit alignment
+    UINT8               configCount;            ///< Configuration counter of the channel, reported in tPdoBufferInfo when applied
+    UINT8               padding;                ///< Padding for 32 bit alignment
     tPdoChannel         pdoChannel;             ///< The PDO channel itself
 } tPdoChannelConf;
 
@@ -127,8 +128,29 @@ typedef struct
     OPLK_ATOMIC_T       writeBuf;               ///< Current buffer to produce data to
     OPLK_ATOMIC_T       cleanBuf;               ///< Current clean (i.e. unused) buffer
     UINT8               newData;                ///< Flag indicating whether new data has been produced
+    UINT8               configCount;            ///< Configuration counter of the channel configuration applied by the kernel layer
 } tPdoBufferInfo;
 
+/**
+\brief PDO image information
+
+This structure specifies the triple buffer state of a complete RPDO or TPDO
+image. It is used if the PDO memory is operated in the cycle-coherent mode
+(see \ref CONFIG_PDO_CYCLE_COHERENT). In this mode the producer writes all
+channels into its write buffer and publishes the whole image with a single
+buffer swap per cycle instead of swapping every channel separately.
+*/
+typedef struct
+{
+    UINT32              sectionOffset;          ///< Offset of the image section in the buffers
+    UINT32              sectionSize;            ///< Size of the image section
+    UINT32              channelCount;           ///< Number of channels in the image section
+    OPLK_ATOMIC_T       readBuf;                ///< Current buffer to consume the image from
+    OPLK_ATOMIC_T       writeBuf;               ///< Current buffer to produce the image to
+    OPLK_ATOMIC_T       cleanBuf;               ///< Current clean (i.e. last published) buffer
+    UINT8               newData;                ///< Flag indicating whether a new image has been published
+} tPdoImageInfo;
+
 /**
 \brief PDO memory region
 
@@ -139,6 +161,9 @@ typedef struct
 {
     UINT16              valid;                                      ///< Defines whether the memory region is valid
     UINT32              pdoMemSize;                                 ///< Size of the overall PDO memory
+    UINT32              fCycleCoherent;                             ///< Defines whether the images are published per cycle (tPdoImageInfo) instead of per channel
+    tPdoImageInfo       rxImageInfo;                                ///< RPDO image of the cycle-coherent mode
+    tPdoImageInfo       txImageInfo;                                ///< TPDO image of the cycle-coherent mode
     tPdoBufferInfo      rxChannelInfo[D_PDO_RPDOChannels_U16];      ///< Array of RPDO channels
     tPdoBufferInfo      txChannelInfo[D_PDO_TPDOChannels_U16];      ///< Array of TPDO channels
     OPLK_LOCK_T         lock;                                       ///< Locking variable
@@ -155,4 +180,15 @@ typedef struct
     UINT32      txPdoMemSize;                   ///< Size of the TPDO memory
 } tPdoMemSize;
 
+/**
+\brief RPDO worker parameter
+
+This structure assigns the RPDOs received from a node to an RPDO worker thread.
+*/
+typedef struct
+{
+    UINT16      nodeId;                         ///< Node ID of the RPDO source (0 = PReq)
+    UINT16      worker;                         ///< Index of the RPDO worker
+} tPdoRxWorkerParam;
+
 #endif /* _INC_common_pdo_H_ */
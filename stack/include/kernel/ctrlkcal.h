@@ -73,6 +73,8 @@ tOplkError        ctrlkcal_readFileChunk(tOplkApiFileChunkDesc* pDesc_p,
                                          size_t bufferSize_p,
                                          void* pBuffer_p);
 size_t            ctrlkcal_getMaxFileChunkSize(void);
+BOOL              ctrlkcal_isFileChunkPending(void);
+void              ctrlkcal_ackFileChunk(UINT16 retVal_p);
 
 #ifdef __cplusplus
 }
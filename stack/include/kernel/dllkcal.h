@@ -75,7 +75,7 @@ extern "C"
 {
 #endif
 
-tOplkError dllkcal_init(void);
+tOplkError dllkcal_init(const tDllCalQueueSizes* pQueueSizes_p);
 tOplkError dllkcal_exit(void);
 tOplkError dllkcal_getAsyncTxCount(tDllAsyncReqPriority* pPriority_p,
                                    UINT* pCount_p);
@@ -110,6 +110,12 @@ tOplkError dllkcal_ackAsyncRequest(UINT nodeId_p,
                                    SECTION_DLLKCAL_GETPENREQ;
 #endif /* defined(CONFIG_INCLUDE_NMT_MN) */
 
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+void       dllkcal_captureFrame(const tPlkFrame* pFrame_p,
+                                size_t frameSize_p,
+                                tOplkApiCaptureDirection direction_p);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
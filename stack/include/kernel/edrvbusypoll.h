@@ -0,0 +1,116 @@
+/**
+********************************************************************************
+\file   kernel/edrvbusypoll.h
+
+\brief  Definitions for the Linux Edrv busy-poll module
+
+This file contains the definitions for the busy-poll module of the Linux user
+space Ethernet drivers.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_kernel_edrvbusypoll_H_
+#define _INC_kernel_edrvbusypoll_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+
+#include <time.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+/**
+\brief Edrv receive statistics
+
+The structure contains the receive latency statistics of a Linux user space
+Ethernet driver. The latency is measured from the kernel receive time stamp of
+a frame until the frame is passed to the Rx handler.
+*/
+typedef struct
+{
+    UINT32      frameCount;                 ///< Number of frames with a valid receive time stamp
+    UINT32      polledFrameCount;           ///< Number of frames received while busy-polling
+    UINT32      spinTimeoutCount;           ///< Number of busy-poll phases ended by the idle timeout
+    UINT32      latencyMin;                 ///< Minimum receive latency [ns]
+    UINT32      latencyMax;                 ///< Maximum receive latency [ns]
+    UINT64      latencySum;                 ///< Sum of all receive latencies [ns]
+} tEdrvBusyPollStatistics;
+
+/**
+\brief Edrv busy-poll instance
+
+The structure describes the busy-poll state of a receive thread. The receive
+thread busy-polls from the SoC until the SoA and shortly before the next
+expected SoC. In between it waits for frames in the kernel. The cycle timing is
+reported by the DLL (see edrvbusypoll_setCycleTime(), edrvbusypoll_signalSoc()
+and edrvbusypoll_signalSoa()), because an MN does not receive its own SoC and
+SoA frames.
+*/
+typedef struct
+{
+    BOOL                    fEnabled;       ///< Busy-polling is enabled
+    BOOL                    fSpinning;      ///< The last receive call was non-blocking
+    UINT32                  idleSocCount;   ///< SoC count of the last busy-poll phase ended by the idle timeout
+    UINT64                  lastFrameTime;  ///< Monotonic time of the last frame [ns]
+    tEdrvBusyPollStatistics statistics;     ///< Receive statistics
+} tEdrvBusyPoll;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void   edrvbusypoll_init(tEdrvBusyPoll* pBusyPoll_p, BOOL fEnable_p);
+void   edrvbusypoll_waitForFrame(tEdrvBusyPoll* pBusyPoll_p, int fd_p);
+void   edrvbusypoll_processFrame(tEdrvBusyPoll* pBusyPoll_p,
+                                 const struct timespec* pRxTimeStamp_p);
+void   edrvbusypoll_setCycleTime(UINT32 cycleTimeUs_p);
+void   edrvbusypoll_signalSoc(void);
+void   edrvbusypoll_signalSoa(void);
+void   edrvbusypoll_printStatistics(const tEdrvBusyPoll* pBusyPoll_p, const char* pName_p);
+#if (CONFIG_EDRV_USE_DIAGNOSTICS != FALSE)
+int    edrvbusypoll_getDiagnostics(const tEdrvBusyPoll* pBusyPoll_p,
+                                   char* pBuffer_p,
+                                   size_t size_p);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_kernel_edrvbusypoll_H_ */
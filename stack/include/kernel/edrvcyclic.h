@@ -64,6 +64,9 @@ typedef tOplkError (*tEdrvCyclicCbSync)(void);
 /// Callback function pointer for Edrv cyclic error
 typedef tOplkError (*tEdrvCyclicCbError)(tOplkError errorCode_p, const tEdrvTxBuffer* pTxBuffer_p);
 
+/// Callback function pointer for Edrv cyclic Tx
+typedef void (*tEdrvCyclicCbTx)(const tEdrvTxBuffer* pTxBuffer_p);
+
 
 #if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
 /**
@@ -112,6 +115,7 @@ tOplkError edrvcyclic_startCycle(BOOL fContinuousMode_p);
 tOplkError edrvcyclic_stopCycle(BOOL fKeepCycle_p);
 tOplkError edrvcyclic_regSyncHandler(tEdrvCyclicCbSync pfnEdrvCyclicCbSync_p);
 tOplkError edrvcyclic_regErrorHandler(tEdrvCyclicCbError pfnEdrvCyclicCbError_p);
+tOplkError edrvcyclic_regTxHandler(tEdrvCyclicCbTx pfnEdrvCyclicCbTx_p);
 
 #if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
 tOplkError edrvcyclic_getDiagnostics(const tEdrvCyclicDiagnostics** ppDiagnostics_p);
@@ -0,0 +1,88 @@
+/**
+********************************************************************************
+\file   kernel/edrvsockfilter.h
+
+\brief  Definitions for the Linux Edrv socket filter module
+
+This file contains the definitions for the socket filter module of the Linux
+user space Ethernet drivers.
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_kernel_edrvsockfilter_H_
+#define _INC_kernel_edrvsockfilter_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <kernel/edrv.h>
+
+#include <linux/filter.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define EDRV_SOCKFILTER_MAX_INSTRUCTIONS    1024    ///< Maximum length of the socket filter program
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+/**
+\brief Edrv socket filter instance
+
+The structure describes the classic BPF program which is attached to the
+receive socket of a Linux user space Ethernet driver.
+*/
+typedef struct
+{
+    int                 fd;                                                 ///< Receive socket, -1 = not initialized
+    UINT                instructionCount;                                   ///< Length of the attached program, 0 = no program attached
+    struct sock_filter  aInstruction[EDRV_SOCKFILTER_MAX_INSTRUCTIONS];     ///< Attached program
+} tEdrvSockFilter;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void       edrvsockfilter_init(tEdrvSockFilter* pSockFilter_p, int fd_p);
+void       edrvsockfilter_exit(tEdrvSockFilter* pSockFilter_p);
+tOplkError edrvsockfilter_update(tEdrvSockFilter* pSockFilter_p,
+                                 const tEdrvFilter* pFilter_p,
+                                 UINT count_p,
+                                 const UINT8* pMacAddr_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_kernel_edrvsockfilter_H_ */
@@ -51,6 +51,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // typedef
 //------------------------------------------------------------------------------
+/// Callback function type for processing an event
+typedef tOplkError (*tEventkProcessCb)(const tEvent* pEvent_p);
 
 //------------------------------------------------------------------------------
 // function prototypes
@@ -68,6 +70,11 @@ tOplkError eventk_postError(tEventSource eventSource_p,
                             tOplkError oplkError_p,
                             UINT argSize_p,
                             const void* pArg_p);
+tOplkError eventk_registerEventHandler(tEventSink eventSink_p,
+                                       tEventType eventType_p,
+                                       tEventkProcessCb pfnProcess_p,
+                                       BOOL fFastLane_p);
+BOOL       eventk_isFastLaneEvent(const tEvent* pEvent_p);
 
 #ifdef __cplusplus
 }
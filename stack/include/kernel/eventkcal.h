@@ -71,7 +71,8 @@ void       eventkcal_process(void);
 #if ((TARGET_SYSTEM == _LINUX_) && defined(__KERNEL__))
 /* functions used in eventkcal-linuxkernel.c */
 int        eventkcal_postEventFromUser(ULONG arg);
-int        eventkcal_getEventForUser(ULONG arg);
+int        eventkcal_waitEventForUser(ULONG arg);
+tOplkError eventkcal_getEventMem(void** ppEventMem_p, size_t* pEventMemSize_p);
 #elif ((TARGET_SYSTEM == _WIN32_) && defined(_KERNEL_MODE))
 // TODO: Check if they can be revised to merge with Linux APIs
 void       eventkcal_postEventFromUser(const void* pEvent_p);
@@ -65,6 +65,25 @@ typedef tOplkError (*tTimerkCallback)(const tTimerEventArg* pEventArg_p);
 /// Callback function pointer for hres timer callback function
 typedef void (*tHresCallback)(tTimerHdl* pTimerHdl_p);
 
+/**
+\brief Structure for high-resolution timer diagnostics
+
+This structure is used to provide the achieved timer accuracy. The latency is
+the time between the programmed expiry time and the call of the timer callback
+function, all times are given in [ns].
+*/
+typedef struct
+{
+    ULONGLONG   expireCount;                ///< Number of expired timers
+    UINT32      latencyMin;                 ///< Minimum callback latency
+    UINT32      latencyMax;                 ///< Maximum callback latency
+    ULONGLONG   latencySum;                 ///< Sum of all callback latencies
+    UINT32      wakeupMargin;               ///< Current wakeup margin before the expiry time
+    UINT32      overshootMax;               ///< Maximum observed overshoot of the sleep
+    UINT32      lateWakeupCount;            ///< Number of wakeups after the expiry time
+    UINT32      missedPeriodCount;          ///< Number of skipped periods of continuous timers
+} tHresTimerDiagnostics;
+
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
@@ -88,6 +107,10 @@ tOplkError hrestimer_deleteTimer(tTimerHdl* pTimerHdl_p);
 void       hrestimer_controlExtSyncIrq(BOOL fEnable_p);
 void       hrestimer_setExtSyncIrqTime(tTimestamp time_p);
 
+#if (CONFIG_HRESTIMER_USE_DIAGNOSTICS != FALSE)
+tOplkError hrestimer_getDiagnostics(tHresTimerDiagnostics* pDiagnostics_p);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
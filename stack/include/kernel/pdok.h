@@ -68,6 +68,10 @@ tOplkError pdok_deAllocChannelMem(void);
 tOplkError pdok_allocChannelMem(const tPdoAllocationParam* pAllocationParam_p);
 tOplkError pdok_configureChannel(const tPdoChannelConf* pChannelConf_p);
 tOplkError pdok_setupPdoBuffers(size_t rxPdoMemSize_p, size_t txPdoMemSize_p);
+tOplkError pdok_processSync(void);
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+tOplkError pdok_exchangePdoImage(void);
+#endif
 
 #ifdef __cplusplus
 }
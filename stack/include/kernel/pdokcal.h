@@ -83,6 +83,12 @@ tOplkError pdokcal_readTxPdo(UINT8 channelId_p,
                              void* pPayload_p,
                              UINT16 pdoSize_p)
                              SECTION_PDOKCAL_READ_TPDO;
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+tOplkError pdokcal_exchangePdoImage(void);
+#endif
+void       pdokcal_setChannelConfigCount(BOOL fTx_p,
+                                         UINT8 channelId_p,
+                                         UINT8 configCount_p);
 
 #ifdef __cplusplus
 }
@@ -78,6 +78,9 @@ void       pdoklut_clear(tPdoklutEntry* pLut_p, size_t numEntries_p);
 tOplkError pdoklut_addChannel(tPdoklutEntry* pLut_p,
                               const tPdoChannel* pPdoChannel_p,
                               UINT8 channelId_p);
+tOplkError pdoklut_removeChannel(tPdoklutEntry* pLut_p,
+                                 UINT8 nodeId_p,
+                                 UINT8 channelId_p);
 UINT8      pdoklut_getChannel(const tPdoklutEntry* pLut_p,
                               UINT8 index_p,
                               UINT8 nodeId_p)
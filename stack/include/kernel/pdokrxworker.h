@@ -0,0 +1,87 @@
+/**
+********************************************************************************
+\file   kernel/pdokrxworker.h
+
+\brief  Include file for kernel RPDO worker module
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_kernel_pdokrxworker_H_
+#define _INC_kernel_pdokrxworker_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <oplk/dll.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define PDOKRXWORKER_THREAD_PRIORITY    55      ///< Default SCHED_FIFO priority of the RPDO workers, same as the kernel event thread which processes RPDOs otherwise
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+/**
+\brief RPDO worker statistics
+
+The structure contains the statistics of the frames dispatched to an RPDO
+worker since the initialization of the module.
+*/
+typedef struct
+{
+    UINT32      queuedCount;        ///< Number of frames queued for the worker
+    UINT32      fullDropCount;      ///< Number of frames dropped because the ring of the worker was full
+    UINT32      pauseDropCount;     ///< Number of frames dropped because the workers were paused
+    UINT32      maxUsedCount;       ///< Maximum number of frames in the ring (high-water mark)
+} tPdokRxWorkerStatistics;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+tOplkError pdokrxworker_init(void);
+void       pdokrxworker_exit(void);
+tOplkError pdokrxworker_dispatch(const tFrameInfo* pFrameInfo_p);
+void       pdokrxworker_waitIdle(void);
+void       pdokrxworker_pause(void);
+void       pdokrxworker_resume(void);
+tOplkError pdokrxworker_setNodeWorker(UINT nodeId_p, UINT worker_p);
+tOplkError pdokrxworker_getStatistics(UINT worker_p, tPdokRxWorkerStatistics* pStatistics_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_kernel_pdokrxworker_H_ */
@@ -67,6 +67,12 @@ tOplkError timesynckcal_sendSyncEvent(void);
 tOplkError timesynckcal_waitSyncEvent(void);
 #endif
 
+#if ((TARGET_SYSTEM == _LINUX_) && defined(__KERNEL__))
+/* functions used in timesynckcal-linuxkernel.c */
+tOplkError timesynckcal_waitSyncCount(UINT32 syncCount_p);
+tOplkError timesynckcal_getSyncMem(void** ppSyncMem_p, size_t* pSyncMemSize_p);
+#endif
+
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
 tTimesyncSharedMemory* timesynckcal_getSharedMemory(void);
 #endif /* defined(CONFIG_INCLUDE_SOC_TIME_FORWARD) */
@@ -323,4 +323,24 @@ typedef struct
     UINT8           frameBuf[MAX_PRES_FORWARD_BUFLEN];  ///< The received PRes frame.
 } tDllEventReceivedPres;
 
+/**
+\brief PRes response time event
+
+The structure describes the PRes response time statistics of a CN. The
+response time is measured from the processing of a received PReq to the
+hand-over of the PRes frame to the Ethernet driver. The DLL posts the
+statistics to the application every CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES
+responses.
+*/
+typedef struct
+{
+    UINT32          sampleCount;                        ///< Number of responses in the report interval
+    UINT32          minResponseTime;                    ///< Minimum response time in the report interval [ns]
+    UINT32          maxResponseTime;                    ///< Maximum response time in the report interval [ns]
+    UINT32          meanResponseTime;                   ///< Mean response time in the report interval [ns]
+    UINT32          peakResponseTime;                   ///< Maximum response time since the initialization of the DLL [ns]
+    UINT32          lateDataCount;                      ///< Number of PRes frames rebuilt with late TPDO data
+    UINT32          lateMissCount;                      ///< Number of late TPDO updates which missed the PRes of their cycle
+} tDllEventPresResponseTime;
+
 #endif  /* _INC_oplk_dll_H_ */
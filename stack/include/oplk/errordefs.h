@@ -261,6 +261,9 @@ typedef enum
     kErrorObdStoreDataLimitExceeded = 0x00D2,       ///< Data count is less than the expected size
     kErrorObdStoreDataObsolete      = 0x00D3,       ///< Data stored in the archive is obsolete
 
+    // area for timesync module 0x00E0 - 0x00EF
+    kErrorTimesyncOverrun           = 0x00E0,       ///< Application sync processing exceeded the synchronization period
+
     kErrorApiTaskDeferred           = 0x0140,       ///< openPOWERLINK performs task in background and informs the application (or vice-versa), when it is finished
     kErrorApiInvalidParam           = 0x0142,       ///< Passed invalid parameters to a function (e.g. invalid node id)
     kErrorApiNoObdInitRam           = 0x0143,       ///< No function pointer for ObdInitRam supplied
@@ -277,6 +280,7 @@ typedef enum
     kErrorApiPINonBlockingNotSupp   = 0x014D,       ///< Process image: non-blocking copy jobs are not supported on this target
     kErrorApiNotInitialized         = 0x014E,       ///< API called but stack is not initialized/running
     kErrorApiNotSupported           = 0x014F,       ///< API call requires unsupported feature
+    kErrorApiPIBindingInvalid       = 0x0150,       ///< Process image: the binding does not match its signature or the process image
 
     // area until 0x07FF is reserved
     // area for user application from 0x0800 to 0x7FFF
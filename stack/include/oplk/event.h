@@ -100,9 +100,12 @@ typedef enum
     kEventTypeAsndNotRx             = 0x28,     ///< Didn't receive ASnd frame for DLL user module (arg is pointer to tDllAsndNotRx)
     kEventTypeAsndRxInfo            = 0x29,     ///< Received ASnd frame for DLL user module (arg is pointer to tFrameInfo)
     kEventTypeReceivedAmni          = 0x2A,     ///< Received AMNI frame (arg is pointer to unsigned int containing the source node-ID)
+    kEventTypeTimesynckSetSyncCycle = 0x2B,     ///< Set the number of cycles per sync event (arg is pointer to UINT32)
     kEventTypeReceivedPres          = 0x30,     ///< Received a PRes frame, which shall be forwarded to application (arg is pointer to tEventReceivedPres)
     kEventTypeRequPresForward       = 0x31,     ///< Request forwarding of a PRes frame to API layer (e.g. for conformance test)
     kEventTypeSdoAsySend            = 0x32,     ///< SDO sequence layer event (for SDO command layer testing module)
+    kEventTypePresResponseTime      = 0x33,     ///< PRes response time statistics of the CN (arg is pointer to tDllEventPresResponseTime)
+    kEventTypePdokRxWorker          = 0x34,     ///< assign the RPDOs of a node to an RPDO worker (arg is pointer to tPdoRxWorkerParam)
 } eEventType;
 
 /**
@@ -182,6 +185,7 @@ typedef enum
     kEventSourceErru                = 0x1F,     ///< Events from User Error handler module
     kEventSourceSdoTest             = 0x20,     ///< Events from SDO testing module
     kEventSourceTimesynck           = 0x21,     ///< events from Timesynck module
+    kEventSourceTimesyncu           = 0x22,     ///< events from Timesyncu module
 
     kEventSourceInvalid             = 0xFF      ///< Identifies an invalid event source
 } eEventSource;
@@ -44,6 +44,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #include <oplk/oplkinc.h>
 #include <oplk/frame.h>
+#include <oplk/dll.h>
 #include <oplk/sdo.h>
 #include <oplk/obd.h>
 #include <oplk/obdal.h>
@@ -103,6 +104,71 @@ Data type for the enumerator \ref eOplkApiSdoStack.
 */
 typedef UINT32 tOplkApiSdoStack;
 
+/**
+\brief Stack threads
+
+The following enum lists the threads which are created by the openPOWERLINK
+stack on Linux user space platforms. It is used as index into the thread
+placement table of the initialization parameters.
+*/
+typedef enum
+{
+    kOplkApiThreadEdrv          = 0x00,  ///< Ethernet driver receive thread (oplk-edrvpcap, oplk-edrvrawsock)
+    kOplkApiThreadHresTimer     = 0x01,  ///< High-resolution timer thread (oplk-hrtimer)
+    kOplkApiThreadEventk        = 0x02,  ///< Kernel event thread (oplk-eventk)
+    kOplkApiThreadEventu        = 0x03,  ///< User event threads (oplk-eventu, oplk-eventufetch, oplk-eventuprocess)
+    kOplkApiThreadTimeru        = 0x04,  ///< User timer thread (oplk-timeru)
+    kOplkApiThreadSdoUdp        = 0x05,  ///< SDO over UDP receive thread (oplk-sdoudp)
+    kOplkApiThreadVeth          = 0x06,  ///< Virtual Ethernet receive thread (oplk-veth)
+    kOplkApiThreadPdoRx         = 0x07,  ///< RPDO worker threads (oplk-pdorx0, oplk-pdorx1, ...)
+    kOplkApiThreadCount         = 0x08   ///< Number of stack threads
+} eOplkApiThread;
+
+/**
+\brief Stack thread data type
+
+Data type for the enumerator \ref eOplkApiThread.
+*/
+typedef UINT32 tOplkApiThread;
+
+/**
+\brief DLL asynchronous Tx queues
+
+The following enum lists the asynchronous Tx queues of the data link layer. It
+is used as index into the queue size table of the initialization parameters and
+to select the queue for \ref oplk_getDllQueueStatistics().
+*/
+typedef enum
+{
+    kOplkApiDllQueueTxNmt       = 0x00,  ///< NMT priority Tx queue
+    kOplkApiDllQueueTxGen       = 0x01,  ///< Generic priority Tx queue
+    kOplkApiDllQueueTxSync      = 0x02,  ///< SyncRequest Tx queue (MN only)
+    kOplkApiDllQueueTxVeth      = 0x03,  ///< Virtual Ethernet Tx queue
+    kOplkApiDllQueueCount       = 0x04   ///< Number of DLL Tx queues
+} eOplkApiDllQueue;
+
+/**
+\brief DLL queue data type
+
+Data type for the enumerator \ref eOplkApiDllQueue.
+*/
+typedef UINT32 tOplkApiDllQueue;
+
+/**
+\brief Thread placement
+
+The following structure specifies the scheduling priority and the CPU affinity
+of a stack thread. A zero initialized structure keeps the default placement of
+the thread.
+*/
+typedef struct
+{
+    UINT8               priority;                   ///< SCHED_FIFO priority of the thread (1..99), 0 = stack default
+    UINT8               fBusyPoll;                  ///< Busy-poll for received frames instead of blocking (only \ref kOplkApiThreadEdrv)
+    UINT8               padding1[6];                ///< Padding to 64 bit boundary
+    UINT64              cpuMask;                    ///< Bit mask of the CPUs the thread may run on (bit 0 = CPU 0), 0 = all CPUs
+} tOplkApiThreadPlacement;
+
 /**
 \brief Node event
 
@@ -353,6 +419,13 @@ typedef enum
     event function call, or \ref kErrorReject has to be returned, whereas the
     processing must finish with a call to \ref oplk_finishUserObdAccess. */
     kOplkApiEventUserObdAccess       = 0x85,
+
+    /** PRes response time event. This event informs the application about
+    the PReq to PRes response time of the local CN. The event argument
+    contains the statistics of the last report interval
+    (\ref tDllEventPresResponseTime). It is only generated if the stack is
+    compiled with CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES != 0. */
+    kOplkApiEventPresResponseTime   = 0x86,
 } eOplkApiEventType;
 
 /**
@@ -389,6 +462,7 @@ typedef union
     tOplkApiEventReceivedSdoCom receivedSdoCom;     ///< Received SDO command layer (\ref kOplkApiEventReceivedSdoCom)
     tOplkApiEventReceivedSdoSeq receivedSdoSeq;     ///< Received SDO sequence layer (\ref kOplkApiEventReceivedSdoSeq)
     tOplkApiEventUserObdAccess  userObdAccess;      ///< Access to user specific object (\ref kOplkApiEventUserObdAccess)
+    tDllEventPresResponseTime   presResponseTime;   ///< PRes response time statistics (\ref kOplkApiEventPresResponseTime)
 } tOplkApiEventArg;
 
 /**
@@ -478,7 +552,18 @@ typedef struct
                                                     /**< This parameter configures the period of synchronization events triggered by the openPOWERLINK stack.
                                                          Note that the resulting synchronization period can only be a multiple of the configured cycle length.
                                                          If this value is set to 0, no minimum synchronization period is specified. */
+    UINT32              maxSyncTime;                ///< Maximum synchronization period for the adaptive synchronization [us]
+                                                    /**< If this value is larger than minSyncTime, the stack measures the processing time of the application
+                                                         between oplk_waitSyncEvent() and oplk_exchangeProcessImageIn() and adapts the synchronization period
+                                                         within minSyncTime and maxSyncTime to the measured load (see \ref oplk_getSyncStatistics()).
+                                                         If this value is set to 0, the synchronization period is fixed. */
+    tOplkApiThreadPlacement aThreadPlacement[kOplkApiThreadCount];  ///< Placement of the stack threads, indexed by \ref eOplkApiThread
+                                                    /**< It is only evaluated on Linux user space platforms. Threads which run in a separate
+                                                         driver process or in the Linux kernel keep their default placement. */
     tObdInitParam       obdInitParam;               ///< Initialization parameters for the object dictionary
+    UINT32              aDllQueueSize[kOplkApiDllQueueCount];   ///< Size of the DLL asynchronous Tx queues in bytes, indexed by \ref eOplkApiDllQueue
+                                                    /**< A size of 0 selects the default size of the stack configuration. The sizes are
+                                                         only evaluated by stacks which use circular buffers for the DLL queues. */
 } tOplkApiInitParam;
 
 /**
@@ -492,6 +577,40 @@ typedef struct
     size_t         imageSize;                       ///< Size of the process image
 } tOplkApiProcessImage;
 
+/**
+\brief  Process image link
+
+This structure describes a run of process variables which are linked to
+consecutive sub-indices of an object. The variables are stored one after the
+other in the process image.
+*/
+typedef struct
+{
+    UINT16         objIndex;                        ///< Object index of the linked variables
+    UINT8          firstSubindex;                   ///< Sub-index of the first linked variable
+    UINT8          fOutputPI;                       ///< Determines the process image: TRUE = output image, FALSE = input image
+    UINT16         entrySize;                       ///< Size of one process variable in bytes
+    UINT16         varEntries;                      ///< Number of linked process variables
+    UINT32         offsetPI;                        ///< Offset of the first process variable in the process image
+} tOplkApiProcessImageLink;
+
+/**
+\brief  Process image binding
+
+This structure describes the complete binding of the process images to the
+object dictionary. It is generated at build time from the openCONFIGURATOR
+project output (see tools/generate-pi-binding.pl) and passed to
+oplk_bindProcessImage().
+*/
+typedef struct
+{
+    UINT32                          signature;              ///< Signature (CRC-32) of the sizes, the link table and the data types of the bound objects
+    UINT32                          sizeProcessImageIn;     ///< Size of the input process image
+    UINT32                          sizeProcessImageOut;    ///< Size of the output process image
+    UINT32                          linkCount;              ///< Number of entries in the link table
+    const tOplkApiProcessImageLink* pLinks;                 ///< Pointer to the link table
+} tOplkApiProcessImageBinding;
+
 /**
 \brief  File chunk descriptor
 
@@ -532,6 +651,230 @@ typedef struct
     BOOL            fValidRelTime;                  ///< TRUE if relative time is validated
 } tOplkApiSocTimeInfo;
 
+/**
+\brief  Synchronization statistics structure
+
+This structure provides the statistics of the application synchronization
+(see \ref oplk_getSyncStatistics()).
+*/
+typedef struct
+{
+    UINT32          syncCount;                      ///< Number of processed sync events
+    UINT32          overrunCount;                   ///< Number of sync events where the application exceeded the synchronization period
+    UINT32          syncPeriod;                     ///< Current synchronization period [us]
+    UINT32          lastAppTime;                    ///< Last application processing time [us]
+    UINT32          avgAppTime;                     ///< Average application processing time [us]
+    UINT32          maxAppTime;                     ///< Maximum application processing time [us]
+} tOplkApiSyncStatistics;
+
+/**
+\brief  Frame pool statistics structure
+
+This structure provides the occupancy statistics of a preallocated Tx frame
+pool (see \ref oplk_getSdoFramePoolStatistics()).
+*/
+typedef struct
+{
+    UINT            frameCount;                     ///< Number of frames in the pool
+    UINT            usedCount;                      ///< Number of frames currently in use
+    UINT            maxUsedCount;                   ///< Maximum number of frames in use at the same time
+    UINT32          allocCount;                     ///< Number of successful frame allocations
+    UINT32          allocFailCount;                 ///< Number of frame allocations failed due to an empty pool
+} tOplkApiFramePoolStatistics;
+
+/**
+\brief DLL queue statistics structure
+
+This structure provides the occupancy statistics of an asynchronous Tx queue of
+the data link layer (see \ref oplk_getDllQueueStatistics()). The statistics are
+accumulated since the initialization of the stack.
+*/
+typedef struct
+{
+    UINT32          queueSize;                      ///< Size of the queue in bytes
+    UINT32          usedSize;                       ///< Currently used size of the queue in bytes
+    UINT32          maxUsedSize;                    ///< Maximum used size of the queue in bytes (high-water mark)
+    UINT32          frameCount;                     ///< Number of frames currently in the queue
+    UINT32          maxFrameCount;                  ///< Maximum number of frames in the queue
+    UINT32          rejectCount;                    ///< Number of frames rejected because the queue was full
+    UINT32          discardCount;                   ///< Number of old frames discarded to make space for new ones
+} tOplkApiDllQueueStatistics;
+
+/**
+\brief RPDO worker statistics structure
+
+This structure provides the statistics of the received frames dispatched to an
+RPDO worker thread (see \ref oplk_getRxPdoWorkerStatistics()). The statistics
+are accumulated since the initialization of the stack.
+*/
+typedef struct
+{
+    UINT32          queuedCount;                    ///< Number of frames queued for the worker
+    UINT32          fullDropCount;                  ///< Number of frames dropped because the queue of the worker was full
+    UINT32          pauseDropCount;                 ///< Number of frames dropped while the PDO channels were changed
+    UINT32          maxUsedCount;                   ///< Maximum number of frames in the queue (high-water mark)
+} tOplkApiRxPdoWorkerStatistics;
+
+/**
+\brief High-resolution timer statistics structure
+
+This structure provides the achieved accuracy of the high-resolution timer
+(see \ref oplk_getHresTimerStatistics()). The latency is the time between the
+programmed expiry time and the call of the timer callback function. All times
+are given in [ns] and are accumulated since the initialization of the stack.
+*/
+typedef struct
+{
+    UINT64          expireCount;                    ///< Number of expired timers
+    UINT64          latencySum;                     ///< Sum of all callback latencies
+    UINT32          latencyMin;                     ///< Minimum callback latency
+    UINT32          latencyMax;                     ///< Maximum callback latency
+    UINT32          wakeupMargin;                   ///< Current wakeup margin before the expiry time
+    UINT32          overshootMax;                   ///< Maximum observed overshoot of the sleep
+    UINT32          lateWakeupCount;                ///< Number of wakeups after the expiry time
+    UINT32          missedPeriodCount;              ///< Number of skipped periods of continuous timers
+} tOplkApiHresTimerStatistics;
+
+/**
+\brief  Frame capture direction
+
+This enumeration lists the directions of a captured frame.
+*/
+typedef enum
+{
+    kOplkApiCaptureRx               = 0x00,         ///< Frame was received by the DLL
+    kOplkApiCaptureTx               = 0x01,         ///< Frame was sent by the cyclic Ethernet driver
+} eOplkApiCaptureDirection;
+
+/**
+\brief  Frame capture direction data type
+
+Data type for the enumerator \ref eOplkApiCaptureDirection.
+*/
+typedef UINT8 tOplkApiCaptureDirection;
+
+/**
+\brief  Frame capture record structure
+
+This structure is the header of a record read from the frame capture ring of
+the DLL (see \ref oplk_serviceReadCaptureRecord()). The captured frame bytes
+follow the header directly.
+*/
+typedef struct
+{
+    UINT64                      timestamp;          ///< Capture time in ns
+    UINT32                      cycleCount;         ///< Number of SoC frames captured before this frame
+    UINT32                      dropCount;          ///< Number of records of the same direction dropped before this record because the ring was full
+    UINT16                      frameSize;          ///< Original size of the frame
+    UINT16                      captureSize;        ///< Number of captured frame bytes following the header
+    tOplkApiCaptureDirection    direction;          ///< Direction of the frame
+    UINT8                       padding1[3];        ///< Padding to 64 bit boundary
+} tOplkApiCaptureRecord;
+
+/**
+\brief  Schedule planning node structure
+
+This structure describes the timing requirements of one CN for the isochronous
+schedule planner of the MN (see \ref oplk_planIsochronousSchedule()). The
+output members are filled by the planner.
+*/
+typedef struct
+{
+    UINT            nodeId;                         ///< Node ID of the CN
+    UINT16          preqPayloadSize;                ///< PReq payload size of the CN (0x1F8B)
+    UINT16          presPayloadSize;                ///< PRes payload size of the CN (0x1F8D)
+    UINT32          responseTimeNs;                 ///< Time from the end of the PReq (or of the PResMN for PRes chaining nodes) to the start of the PRes [ns]
+    UINT            updateRate;                     ///< Required update rate in cycles, the node has to be served at least every updateRate cycles (0 and 1 = every cycle)
+    BOOL            fPresChaining;                  ///< The node is operated in PRes chaining mode and is therefore always served in every cycle
+    UINT            assignedCycle;                  ///< Output: Assigned cycle (0 = continuous, 1..multiplexedCycleCount = multiplexed cycle, see 0x1F9B)
+    UINT32          slotTimeNs;                     ///< Output: Predicted duration of the isochronous slot of the node [ns]
+} tOplkApiSchedNode;
+
+/**
+\brief  Schedule planning parameter structure
+
+This structure contains the cycle parameters for the isochronous schedule
+planner (see \ref oplk_planIsochronousSchedule()).
+*/
+typedef struct
+{
+    UINT            maxMultiplexedCycles;           ///< Maximum number of multiplexed cycles the planner may use (0x1F98.7 range, 0 = no multiplexing)
+    UINT16          asyncMtu;                       ///< Asynchronous MTU reserved in every cycle (0x1F98.8)
+    UINT16          presMnPayloadSize;              ///< Payload size of the PResMN, only taken into account if PRes chaining nodes are scheduled
+} tOplkApiSchedPlanParam;
+
+/**
+\brief  Schedule plan structure
+
+This structure describes the isochronous schedule which was computed by
+\ref oplk_planIsochronousSchedule() and the predicted cycle budget.
+*/
+typedef struct
+{
+    UINT            nodeCount;                      ///< Number of planned nodes
+    UINT            continuousNodeCount;            ///< Number of nodes served in every cycle
+    UINT            multiplexedNodeCount;           ///< Number of nodes assigned to multiplexed cycles
+    UINT            multiplexedCycleCount;          ///< Number of multiplexed cycles (0x1F98.7, 0 = no multiplexing)
+    UINT32          frameOverheadTimeNs;            ///< Predicted time of the SoC and SoA frames [ns]
+    UINT32          continuousTimeNs;               ///< Predicted time of the continuous slots [ns]
+    UINT32          multiplexedTimeNs;              ///< Predicted time of the largest multiplexed cycle [ns]
+    UINT32          presChainingTimeNs;             ///< Predicted time of the PResMN and the PRes chaining slots [ns]
+    UINT32          asyncTimeNs;                    ///< Predicted time of the asynchronous phase [ns]
+    UINT32          cycleTimeNs;                    ///< Predicted minimum cycle time [ns]
+} tOplkApiSchedPlan;
+
+/**
+\brief  SDO batch request structure
+
+This structure describes one object access of an SDO batch which is submitted
+with \ref oplk_submitSdoBatch().
+*/
+typedef struct
+{
+    UINT            nodeId;                         ///< Node ID of the remote node
+    UINT            index;                          ///< Index of the object
+    UINT            subIndex;                       ///< Sub-index of the object
+    tSdoAccessType  accessType;                     ///< Access type (kSdoAccessTypeRead or kSdoAccessTypeWrite)
+    tSdoType        sdoType;                        ///< Type of the SDO transfer (ASnd or UDP)
+    void*           pData_le;                       ///< Read: storage destination, write: source data (little endian)
+    size_t          dataSize;                       ///< Read: size of the buffer, write: size of the data
+    void*           pUserArg;                       ///< User defined argument which is returned in the completion
+} tOplkApiSdoBatchRequest;
+
+/**
+\brief  SDO batch completion structure
+
+This structure describes the result of one object access of an SDO batch. It
+is returned by \ref oplk_pollSdoBatch().
+*/
+typedef struct
+{
+    UINT            nodeId;                         ///< Node ID of the remote node
+    UINT            index;                          ///< Index of the object
+    UINT            subIndex;                       ///< Sub-index of the object
+    tSdoAccessType  accessType;                     ///< Access type (kSdoAccessTypeRead or kSdoAccessTypeWrite)
+    tOplkError      error;                          ///< Error of the local stack, kErrorOk if the transfer was performed
+    tSdoComConState sdoComConState;                 ///< Final state of the transfer (kSdoComTransferFinished on success)
+    UINT32          abortCode;                      ///< SDO abort code of the object access
+    size_t          transferredBytes;               ///< Number of transferred bytes
+    void*           pUserArg;                       ///< User defined argument of the request
+} tOplkApiSdoBatchCompletion;
+
+/**
+\brief  Object view entry structure
+
+This structure describes one object of an object view which is registered with
+\ref oplk_registerObjectView(). The location of the value in the view is
+filled in by the stack.
+*/
+typedef struct
+{
+    UINT            index;                          ///< Index of the object
+    UINT            subIndex;                       ///< Sub-index of the object
+    size_t          offset;                         ///< Offset of the value in the view (filled in by the stack)
+    size_t          size;                           ///< Size of the value (filled in by the stack)
+} tOplkApiObjectViewEntry;
+
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
@@ -592,6 +935,12 @@ OPLKDLLEXPORT tOplkError oplk_enableUserObdAccess(BOOL fEnable_p);
 OPLKDLLEXPORT tOplkError oplk_freeSdoChannel(tSdoComConHdl sdoComConHdl_p);
 OPLKDLLEXPORT tOplkError oplk_abortSdo(tSdoComConHdl sdoComConHdl_p,
                                        UINT32 abortCode_p);
+OPLKDLLEXPORT tOplkError oplk_submitSdoBatch(const tOplkApiSdoBatchRequest* paRequest_p,
+                                             UINT requestCount_p);
+OPLKDLLEXPORT tOplkError oplk_pollSdoBatch(tOplkApiSdoBatchCompletion* paCompletion_p,
+                                           UINT maxCount_p,
+                                           UINT* pCompletionCount_p);
+OPLKDLLEXPORT tOplkError oplk_cancelSdoBatch(void);
 OPLKDLLEXPORT tOplkError oplk_readLocalObject(UINT index_p,
                                               UINT subindex_p,
                                               void* pDstData_p,
@@ -600,6 +949,15 @@ OPLKDLLEXPORT tOplkError oplk_writeLocalObject(UINT index_p,
                                                UINT subindex_p,
                                                const void* pSrcData_p,
                                                size_t size_p);
+OPLKDLLEXPORT tOplkError oplk_registerObjectView(tOplkApiObjectViewEntry* paEntry_p,
+                                                 UINT entryCount_p,
+                                                 UINT* pViewId_p,
+                                                 size_t* pViewSize_p);
+OPLKDLLEXPORT tOplkError oplk_unregisterObjectView(UINT viewId_p);
+OPLKDLLEXPORT tOplkError oplk_readObjectView(UINT viewId_p,
+                                             void* pBuffer_p,
+                                             size_t bufferSize_p);
+OPLKDLLEXPORT tOplkError oplk_refreshObjectView(UINT viewId_p);
 OPLKDLLEXPORT tOplkError oplk_sendAsndFrame(UINT8 dstNodeId_p,
                                             const tAsndFrame* pAsndFrame_p,
                                             size_t asndSize_p);
@@ -618,6 +976,10 @@ OPLKDLLEXPORT tOplkError oplk_setOdArchivePath(const char* pBackupPath_p);
 OPLKDLLEXPORT tOplkError oplk_process(void);
 OPLKDLLEXPORT tOplkError oplk_getIdentResponse(UINT nodeId_p,
                                                const tIdentResponse** ppIdentResponse_p);
+OPLKDLLEXPORT tOplkError oplk_readIdentResponse(UINT nodeId_p,
+                                                tIdentResponse* pIdentResponse_p);
+OPLKDLLEXPORT tOplkError oplk_readStatusResponse(UINT nodeId_p,
+                                                 tStatusResponse* pStatusResponse_p);
 OPLKDLLEXPORT tOplkError oplk_getEthMacAddr(UINT8* pMacAddr_p);
 OPLKDLLEXPORT BOOL oplk_checkKernelStack(void);
 OPLKDLLEXPORT tOplkError oplk_waitSyncEvent(ULONG timeout_p);
@@ -626,6 +988,19 @@ OPLKDLLEXPORT const char* oplk_getVersionString(void);
 OPLKDLLEXPORT UINT32 oplk_getStackConfiguration(void);
 OPLKDLLEXPORT tOplkError oplk_getStackInfo(tOplkApiStackInfo* pStackInfo_p);
 OPLKDLLEXPORT tOplkError oplk_getSocTime(tOplkApiSocTimeInfo* pTimeInfo_p);
+OPLKDLLEXPORT tOplkError oplk_getSyncStatistics(tOplkApiSyncStatistics* pStatistics_p);
+OPLKDLLEXPORT tOplkError oplk_getSdoFramePoolStatistics(tOplkApiFramePoolStatistics* pStatistics_p);
+OPLKDLLEXPORT tOplkError oplk_getDllQueueStatistics(tOplkApiDllQueue queue_p,
+                                                    tOplkApiDllQueueStatistics* pStatistics_p);
+OPLKDLLEXPORT tOplkError oplk_planIsochronousSchedule(const tOplkApiSchedPlanParam* pParam_p,
+                                                      tOplkApiSchedNode* aNodes_p,
+                                                      UINT nodeCount_p,
+                                                      tOplkApiSchedPlan* pPlan_p);
+OPLKDLLEXPORT tOplkError oplk_getIsochronousSchedule(tOplkApiSchedPlan* pPlan_p,
+                                                     tOplkApiSchedNode* aNodes_p,
+                                                     UINT* pNodeCount_p);
+OPLKDLLEXPORT tOplkError oplk_getIsochronousScheduleNodeTiming(UINT nodeId_p,
+                                                               tOplkApiSchedNode* pNode_p);
 OPLKDLLEXPORT tOplkError oplk_exchangeAppPdoIn(void);
 OPLKDLLEXPORT tOplkError oplk_exchangeAppPdoOut(void);
 
@@ -639,6 +1014,7 @@ OPLKDLLEXPORT tOplkError oplk_linkProcessImageObject(UINT objIndex_p,
                                                      BOOL fOutputPI_p,
                                                      tObdSize entrySize_p,
                                                      UINT* pVarEntries_p);
+OPLKDLLEXPORT tOplkError oplk_bindProcessImage(const tOplkApiProcessImageBinding* pBinding_p);
 OPLKDLLEXPORT tOplkError oplk_exchangeProcessImageIn(void);
 OPLKDLLEXPORT tOplkError oplk_exchangeProcessImageOut(void);
 OPLKDLLEXPORT void* oplk_getProcessImageIn(void);
@@ -650,6 +1026,14 @@ OPLKDLLEXPORT OPLK_DEPRECATED tOplkError oplk_setupProcessImage(void);
 // Request forwarding of Pres frame from DLL -> API
 OPLKDLLEXPORT tOplkError oplk_triggerPresForward(UINT nodeId_p);
 
+// Assign the RPDOs of a node to an RPDO worker thread
+OPLKDLLEXPORT tOplkError oplk_setRxPdoWorker(UINT nodeId_p, UINT worker_p);
+OPLKDLLEXPORT tOplkError oplk_getRxPdoWorkerStatistics(UINT worker_p,
+                                                       tOplkApiRxPdoWorkerStatistics* pStatistics_p);
+
+// Get the accuracy of the high-resolution timer
+OPLKDLLEXPORT tOplkError oplk_getHresTimerStatistics(tOplkApiHresTimerStatistics* pStatistics_p);
+
 // SDO Test API functions
 OPLKDLLEXPORT void oplk_testSdoSetVal(const tOplkApiInitParam* pInitParam_p);
 OPLKDLLEXPORT tOplkError oplk_testSdoComInit(void);
@@ -672,6 +1056,9 @@ OPLKDLLEXPORT tOplkError oplk_serviceWriteFileChunk(const tOplkApiFileChunkDesc*
                                                     const void* pChunkData_p);
 OPLKDLLEXPORT size_t oplk_serviceGetFileChunkSize(void);
 OPLKDLLEXPORT tOplkError oplk_serviceExecFirmwareReconfig(BOOL fFactory_p);
+OPLKDLLEXPORT tOplkError oplk_serviceReadCaptureRecord(void* pBuffer_p,
+                                                       size_t bufferSize_p,
+                                                       size_t* pRecordSize_p);
 
 #ifdef __cplusplus
 }
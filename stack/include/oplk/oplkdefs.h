@@ -158,6 +158,16 @@ These constants determine the different queue implementations.
 #define CIRCBUF_QUEUE                                   5                   ///< Use circular buffer library for queue
 /// \}
 
+//------------------------------------------------------------------------------
+/// \name Overflow policies of the DLL CAL Tx queues
+/** \{
+These constants determine how a full asynchronous Tx queue of the DLL CAL is
+handled.
+*/
+#define DLLCAL_TX_OVERFLOW_REJECT                       0                   ///< Reject the new frame
+#define DLLCAL_TX_OVERFLOW_DISCARD_OLDEST               1                   ///< Discard the oldest frames of the generic and virtual Ethernet queues
+/// \}
+
 //------------------------------------------------------------------------------
 // definitions for usage of circular buffer library
 
@@ -175,6 +185,7 @@ These constants determine the different queue implementations.
 #define CIRCBUF_DLLCAL_CN_REQ_IDENT                     9                   ///< Ident request queue for MN asynchronous scheduler
 #define CIRCBUF_DLLCAL_CN_REQ_STATUS                    10                  ///< Status request queue for MN asynchronous scheduler
 #define CIRCBUF_DLLCAL_TXVETH                           11                  ///< Queue for sending virtual Ethernet frames in the DLLCAL
+#define CIRCBUF_DLLCAL_CAPTURE                          12                  ///< Frame capture ring of the DLL
 /// \}
 
 //------------------------------------------------------------------------------
@@ -39,6 +39,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // includes
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
+#include <common/dllcal.h>
 #include <oplk/dll.h>
 #include <oplk/event.h>
 
@@ -96,6 +97,8 @@ tOplkError dllucal_regAsndService(tDllAsndServiceId ServiceId_p,
                                   tDllAsndFilter Filter_p);
 tOplkError dllucal_sendAsyncFrame(const tFrameInfo* pFrameInfo,
                                   tDllAsyncReqPriority priority_p);
+tOplkError dllucal_getQueueStatistics(tDllCalQueue queue_p,
+                                      tDllCalQueueStatistics* pStatistics_p);
 tOplkError dllucal_process(const tEvent* pEvent_p);
 
 #if (NMT_MAX_NODE_ID > 0)
@@ -112,6 +115,12 @@ tOplkError dllucal_issueSyncRequest(const tDllSyncRequest* pSyncRequest_p,
                                     size_t size_p);
 #endif
 
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+tOplkError dllucal_readCaptureRecord(void* pBuffer_p,
+                                     size_t bufferSize_p,
+                                     size_t* pRecordSize_p);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
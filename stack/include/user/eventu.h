@@ -80,6 +80,9 @@ tOplkError eventu_postError(tEventSource eventSource_p,
                             tOplkError error_p,
                             UINT argSize_p,
                             const void* pArg_p);
+tOplkError eventu_registerEventHandler(tEventSink eventSink_p,
+                                       tEventType eventType_p,
+                                       tProcessEventCb pfnProcess_p);
 
 #ifdef __cplusplus
 }
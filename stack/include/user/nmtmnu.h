@@ -105,6 +105,9 @@ tOplkError nmtmnu_getDiagnosticInfo(UINT* pMandatorySlaveCount_p,
                                     UINT* pSignalSlaveCount_p,
                                     UINT16* pflags_p);
 tOplkError nmtmnu_configPrc(const tNmtMnuConfigParam* pConfigParam_p);
+tOplkError nmtmnu_getPResTiming(UINT nodeId_p,
+                                BOOL* pfPresChaining_p,
+                                UINT32* pPResTimeFirstNs_p);
 #endif
 
 #ifdef __cplusplus
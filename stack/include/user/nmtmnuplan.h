@@ -0,0 +1,78 @@
+/**
+********************************************************************************
+\file   user/nmtmnuplan.h
+
+\brief  Definitions for the isochronous schedule planner of the MN
+
+This file contains the definitions for the nmtmnuplan module.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_user_nmtmnuplan_H_
+#define _INC_user_nmtmnuplan_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <oplk/oplk.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if defined(CONFIG_INCLUDE_NMT_MN)
+tOplkError nmtmnuplan_calcSchedule(const tOplkApiSchedPlanParam* pParam_p,
+                                   tOplkApiSchedNode* aNodes_p,
+                                   UINT nodeCount_p,
+                                   tOplkApiSchedPlan* pPlan_p);
+tOplkError nmtmnuplan_getSchedule(tOplkApiSchedPlan* pPlan_p,
+                                  tOplkApiSchedNode* aNodes_p,
+                                  UINT* pNodeCount_p);
+tOplkError nmtmnuplan_getNodeTiming(UINT nodeId_p,
+                                    tOplkApiSchedNode* pNode_p);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_user_nmtmnuplan_H_ */
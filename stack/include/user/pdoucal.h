@@ -87,6 +87,10 @@ tOplkError pdoucal_setTxPdo(UINT8 channelId_p,
 tOplkError pdoucal_getRxPdo(void** ppPdo_p,
                             UINT8 channelId_p,
                             size_t pdoSize_p);
+UINT8      pdoucal_getChannelConfigCount(BOOL fTx_p,
+                                         UINT8 channelId_p);
+tOplkError pdoucal_acquireRxPdoImage(void);
+tOplkError pdoucal_publishTxPdoImage(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,84 @@
+/**
+********************************************************************************
+\file   user/respstoreu.h
+
+\brief  Definitions for the response store module
+
+This file contains the definitions for the response store module which stores
+the latest IdentResponse and StatusResponse of every node.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+#ifndef _INC_user_respstoreu_H_
+#define _INC_user_respstoreu_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <oplk/frame.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+tOplkError respstoreu_init(void);
+void       respstoreu_exit(void);
+void       respstoreu_resetIdentResponses(void);
+void       respstoreu_resetStatusResponses(void);
+tOplkError respstoreu_storeIdentResponse(UINT nodeId_p,
+                                         const tIdentResponse* pIdentResponse_p,
+                                         const tIdentResponse** ppStoredResponse_p);
+tOplkError respstoreu_storeStatusResponse(UINT nodeId_p,
+                                          const tStatusResponse* pStatusResponse_p,
+                                          size_t size_p);
+tOplkError respstoreu_getIdentResponse(UINT nodeId_p,
+                                       const tIdentResponse** ppIdentResponse_p);
+tOplkError respstoreu_readIdentResponse(UINT nodeId_p,
+                                        tIdentResponse* pIdentResponse_p);
+tOplkError respstoreu_readStatusResponse(UINT nodeId_p,
+                                         tStatusResponse* pStatusResponse_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_user_respstoreu_H_ */
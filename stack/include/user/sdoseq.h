@@ -44,6 +44,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <oplk/sdo.h>
 #include <oplk/frame.h>
 #include <oplk/event.h>
+#include <common/framepool.h>
 
 //------------------------------------------------------------------------------
 // const defines
@@ -113,6 +114,9 @@ tOplkError sdoseq_initCon(tSdoSeqConHdl* pSdoSeqConHdl_p,
 tOplkError sdoseq_sendData(tSdoSeqConHdl sdoSeqConHdl_p,
                            size_t dataSize_p,
                            tPlkFrame* pData_p);
+tPlkFrame* sdoseq_allocTxFrame(void);
+void       sdoseq_freeTxFrame(tPlkFrame* pFrame_p);
+tOplkError sdoseq_getTxFramePoolStatistics(tFramePoolStatistics* pStatistics_p);
 tOplkError sdoseq_processEvent(const tEvent* pEvent_p);
 tOplkError sdoseq_deleteCon(tSdoSeqConHdl sdoSeqConHdl_p);
 tOplkError sdoseq_setTimeout(UINT32 timeout_p);
@@ -62,6 +62,11 @@ tOplkError timesyncu_init(tSyncCb pfnSyncCb_p);
 void       timesyncu_exit(void);
 tOplkError timesyncu_getSocTime(tOplkApiSocTimeInfo* pSocTime_p);
 tOplkError timesyncu_waitSyncEvent(ULONG timeout_p);
+tOplkError timesyncu_setCycleTime(UINT32 cycleLen_p,
+                                  UINT32 minSyncTime_p,
+                                  UINT32 maxSyncTime_p);
+void       timesyncu_finishSyncProcessing(void);
+tOplkError timesyncu_getStatistics(tOplkApiSyncStatistics* pStatistics_p);
 
 #ifdef __cplusplus
 }
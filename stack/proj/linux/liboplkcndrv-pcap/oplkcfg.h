@@ -81,6 +81,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // switch this define to TRUE to include Edrv diagnostic functions
 #define CONFIG_EDRV_USE_DIAGNOSTICS                 FALSE
 
+// switch this define to TRUE if Edrv supports the busy-poll receive mode
+#define CONFIG_EDRV_BUSY_POLL                       TRUE
+
 //==============================================================================
 // Data Link Layer (DLL) specific defines
 //==============================================================================
@@ -450,8 +450,11 @@ The function returns the current timestamp in nanoseconds.
 //------------------------------------------------------------------------------
 ULONGLONG target_getCurrentTimestamp(void)
 {
-    // Not implemented for this target
-    return 0ULL;
+    struct timespec curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+
+    return ((ULONGLONG)curTime.tv_sec * 1000000000ULL) + (ULONGLONG)curTime.tv_nsec;
 }
 
 //------------------------------------------------------------------------------
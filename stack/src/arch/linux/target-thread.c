@@ -0,0 +1,492 @@
+/**
+********************************************************************************
+\file   linux/target-thread.c
+
+\brief  Thread placement for Linux user space
+
+This file contains the placement of the stack threads on Linux user space
+platforms. The threads created by the stack register themselves with their
+default SCHED_FIFO priority. The scheduling priority and the CPU affinity of
+every registered thread can be overridden by the placement table of the
+initialization parameters (see \ref tOplkApiInitParam). The resulting placement
+is reported when it is applied.
+
+\ingroup module_target
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/targetthread.h>
+
+#include <sched.h>
+#include <stdio.h>
+#include <unistd.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TARGET_THREAD_MAX_CPU           64      // Number of CPUs which can be selected by the CPU mask
+#define TARGET_THREAD_ISOLATED_CPUS     "/sys/devices/system/cpu/isolated"
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Registered thread
+
+The structure describes a thread which was registered by a stack module.
+*/
+typedef struct
+{
+    BOOL                fUsed;                  ///< Entry is used by a registered thread
+    pthread_t           thread;                 ///< Thread handle
+    tOplkApiThread      threadType;             ///< Stack thread type which selects the placement
+    const char*         pName;                  ///< Name of the thread
+    UINT8               defaultPriority;        ///< Default SCHED_FIFO priority (0 = default scheduling policy)
+} tTargetThreadEntry;
+
+/**
+\brief Thread placement instance
+
+The structure contains the configured placement and the registered threads.
+*/
+typedef struct
+{
+    tOplkApiThreadPlacement aPlacement[kOplkApiThreadCount];        ///< Configured placement per stack thread type
+    tTargetThreadEntry      aThread[TARGET_THREAD_MAX_COUNT];       ///< Registered threads
+    BOOL                    fIsolatedCpusRead;                      ///< Isolated CPUs were read from sysfs
+    UINT64                  isolatedCpuMask;                        ///< Bit mask of the isolated CPUs
+} tTargetThreadInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tTargetThreadInstance    instance_l;
+static pthread_mutex_t          mutex_l = PTHREAD_MUTEX_INITIALIZER;    ///< Mutex protecting the instance
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError applyPlacement(const tTargetThreadEntry* pEntry_p);
+static void       reportPlacement(const tTargetThreadEntry* pEntry_p);
+static UINT64     getIsolatedCpuMask(void);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set the thread placement
+
+The function stores the placement of the stack threads and applies it to all
+threads which are already registered.
+
+\param[in]      aPlacement_p        Placement table indexed by \ref eOplkApiThread.
+\param[in]      placementCount_p    Number of entries in the placement table.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void target_setThreadPlacement(const tOplkApiThreadPlacement* aPlacement_p,
+                               UINT placementCount_p)
+{
+    UINT    i;
+
+    ASSERT(aPlacement_p != NULL);
+
+    pthread_mutex_lock(&mutex_l);
+
+    OPLK_MEMSET(instance_l.aPlacement, 0, sizeof(instance_l.aPlacement));
+    OPLK_MEMCPY(instance_l.aPlacement,
+                aPlacement_p,
+                sizeof(tOplkApiThreadPlacement) * min(placementCount_p, (UINT)kOplkApiThreadCount));
+
+    for (i = 0; i < TARGET_THREAD_MAX_COUNT; i++)
+    {
+        if (instance_l.aThread[i].fUsed)
+            applyPlacement(&instance_l.aThread[i]);
+    }
+
+    pthread_mutex_unlock(&mutex_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clear the thread placement
+
+The function clears the placement of the stack threads when the stack is shut
+down, so that the placement of a previous initialization isn't applied to the
+threads of the next one.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void target_clearThreadPlacement(void)
+{
+    pthread_mutex_lock(&mutex_l);
+    OPLK_MEMSET(instance_l.aPlacement, 0, sizeof(instance_l.aPlacement));
+    pthread_mutex_unlock(&mutex_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Register a stack thread
+
+The function registers a thread created by the stack. It names the thread and
+applies its current placement. If no priority is configured for the thread
+type, the thread is scheduled with SCHED_FIFO and the given default priority.
+
+\param[in]      thread_p            Handle of the thread.
+\param[in]      threadType_p        Stack thread type of the thread.
+\param[in]      pName_p             Name of the thread.
+\param[in]      defaultPriority_p   Default SCHED_FIFO priority of the thread.
+                                    0 keeps the default scheduling policy.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The placement was applied.
+\retval kErrorNoResource            The placement couldn't be applied.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+tOplkError target_registerThread(pthread_t thread_p,
+                                 tOplkApiThread threadType_p,
+                                 const char* pName_p,
+                                 UINT8 defaultPriority_p)
+{
+    tOplkError          ret;
+    tTargetThreadEntry  entry;
+    UINT                i;
+
+    ASSERT(threadType_p < kOplkApiThreadCount);
+
+    entry.fUsed = TRUE;
+    entry.thread = thread_p;
+    entry.threadType = threadType_p;
+    entry.pName = pName_p;
+    entry.defaultPriority = defaultPriority_p;
+
+#if (defined(__GLIBC__) && __GLIBC__ >= 2 && __GLIBC_MINOR__ >= 12)
+    pthread_setname_np(thread_p, pName_p);
+#endif
+
+    pthread_mutex_lock(&mutex_l);
+
+    for (i = 0; i < TARGET_THREAD_MAX_COUNT; i++)
+    {
+        if (!instance_l.aThread[i].fUsed)
+        {
+            instance_l.aThread[i] = entry;
+            break;
+        }
+    }
+
+    if (i == TARGET_THREAD_MAX_COUNT)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Thread %s can't be registered, placement is applied once\n",
+                              __func__,
+                              pName_p);
+    }
+
+    ret = applyPlacement(&entry);
+
+    pthread_mutex_unlock(&mutex_l);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Unregister a stack thread
+
+The function unregisters a thread before it is terminated.
+
+\param[in]      thread_p            Handle of the thread.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+void target_unregisterThread(pthread_t thread_p)
+{
+    UINT    i;
+
+    pthread_mutex_lock(&mutex_l);
+
+    for (i = 0; i < TARGET_THREAD_MAX_COUNT; i++)
+    {
+        if (instance_l.aThread[i].fUsed &&
+            pthread_equal(instance_l.aThread[i].thread, thread_p))
+        {
+            instance_l.aThread[i].fUsed = FALSE;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&mutex_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if a stack thread shall busy-poll
+
+The function returns the busy-poll flag of the configured placement of a stack
+thread type.
+
+\param[in]      threadType_p        Stack thread type.
+
+\return The function returns TRUE if the thread shall busy-poll, otherwise FALSE.
+
+\ingroup module_target
+*/
+//------------------------------------------------------------------------------
+BOOL target_isThreadBusyPoll(tOplkApiThread threadType_p)
+{
+    BOOL    fBusyPoll;
+
+    ASSERT(threadType_p < kOplkApiThreadCount);
+
+    pthread_mutex_lock(&mutex_l);
+    fBusyPoll = (instance_l.aPlacement[threadType_p].fBusyPoll != FALSE);
+    pthread_mutex_unlock(&mutex_l);
+
+    return fBusyPoll;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Apply the placement of a thread
+
+The function sets the scheduling priority and the CPU affinity of a registered
+thread and reports the resulting placement. A CPU mask of 0 resets the affinity
+to all CPUs, so that a placement which is changed back to the default doesn't
+keep the previous mask.
+
+\param[in]      pEntry_p            Registered thread.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The placement was applied.
+\retval kErrorNoResource            The priority or the CPU affinity couldn't be set.
+*/
+//------------------------------------------------------------------------------
+static tOplkError applyPlacement(const tTargetThreadEntry* pEntry_p)
+{
+    tOplkError                      ret = kErrorOk;
+    const tOplkApiThreadPlacement*  pPlacement = &instance_l.aPlacement[pEntry_p->threadType];
+    struct sched_param              schedParam;
+    cpu_set_t                       cpuSet;
+    UINT                            cpu;
+    long                            cpuCount;
+    int                             result;
+
+    schedParam.sched_priority = (pPlacement->priority != 0) ? pPlacement->priority
+                                                            : pEntry_p->defaultPriority;
+    if (schedParam.sched_priority != 0)
+    {
+        result = pthread_setschedparam(pEntry_p->thread, SCHED_FIFO, &schedParam);
+        if (result != 0)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s(): couldn't set priority %d of thread %s! %d\n",
+                                  __func__,
+                                  schedParam.sched_priority,
+                                  pEntry_p->pName,
+                                  result);
+            ret = kErrorNoResource;
+        }
+    }
+
+    CPU_ZERO(&cpuSet);
+    if (pPlacement->cpuMask != 0)
+    {
+        for (cpu = 0; cpu < TARGET_THREAD_MAX_CPU; cpu++)
+        {
+            if ((pPlacement->cpuMask & ((UINT64)1 << cpu)) != 0)
+                CPU_SET(cpu, &cpuSet);
+        }
+    }
+    else
+    {
+        cpuCount = sysconf(_SC_NPROCESSORS_CONF);
+        for (cpu = 0; (cpu < (UINT)cpuCount) && (cpu < CPU_SETSIZE); cpu++)
+            CPU_SET(cpu, &cpuSet);
+    }
+
+    result = pthread_setaffinity_np(pEntry_p->thread, sizeof(cpu_set_t), &cpuSet);
+    if (result != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s(): couldn't set CPU mask 0x%llX of thread %s! %d\n",
+                              __func__,
+                              (unsigned long long)pPlacement->cpuMask,
+                              pEntry_p->pName,
+                              result);
+        ret = kErrorNoResource;
+    }
+
+    reportPlacement(pEntry_p);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Report the placement of a thread
+
+The function reads back the scheduling parameters and the CPU affinity of a
+registered thread and prints them. Threads which are configured to run on
+isolated CPUs only are marked. A warning is printed if a CPU mask was configured
+for a cycle-critical thread which includes CPUs that are not isolated, although
+isolated CPUs are available.
+
+\param[in]      pEntry_p            Registered thread.
+*/
+//------------------------------------------------------------------------------
+static void reportPlacement(const tTargetThreadEntry* pEntry_p)
+{
+    struct sched_param  schedParam;
+    int                 policy;
+    cpu_set_t           cpuSet;
+    UINT64              cpuMask = 0;
+    UINT64              isolatedCpuMask;
+    UINT                cpu;
+    BOOL                fIsolated;
+
+    if ((pthread_getschedparam(pEntry_p->thread, &policy, &schedParam) != 0) ||
+        (pthread_getaffinity_np(pEntry_p->thread, sizeof(cpu_set_t), &cpuSet) != 0))
+        return;
+
+    for (cpu = 0; cpu < TARGET_THREAD_MAX_CPU; cpu++)
+    {
+        if (CPU_ISSET(cpu, &cpuSet))
+            cpuMask |= ((UINT64)1 << cpu);
+    }
+
+    isolatedCpuMask = getIsolatedCpuMask();
+    fIsolated = (isolatedCpuMask != 0) && ((cpuMask & ~isolatedCpuMask) == 0);
+
+    DEBUG_LVL_CTRL_TRACE("Thread %-18s %s priority %2d CPU mask 0x%llX%s\n",
+                         pEntry_p->pName,
+                         (policy == SCHED_FIFO) ? "SCHED_FIFO " : "SCHED_OTHER",
+                         schedParam.sched_priority,
+                         (unsigned long long)cpuMask,
+                         fIsolated ? " (isolated)" : "");
+
+    if ((instance_l.aPlacement[pEntry_p->threadType].cpuMask != 0) &&
+        (isolatedCpuMask != 0) &&
+        !fIsolated &&
+        ((pEntry_p->threadType == kOplkApiThreadEdrv) ||
+         (pEntry_p->threadType == kOplkApiThreadHresTimer) ||
+         (pEntry_p->threadType == kOplkApiThreadEventk)))
+    {
+        DEBUG_LVL_ERROR_TRACE("Cycle-critical thread %s shares CPUs with the system, isolated CPUs are 0x%llX\n",
+                              pEntry_p->pName,
+                              (unsigned long long)isolatedCpuMask);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the isolated CPUs
+
+The function reads the list of isolated CPUs (isolcpus kernel parameter) from
+sysfs. The list is read once and cached.
+
+\return The function returns the bit mask of the isolated CPUs.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getIsolatedCpuMask(void)
+{
+    FILE*   pFile;
+    UINT    first;
+    UINT    last;
+    UINT    cpu;
+    int     delimiter;
+
+    if (instance_l.fIsolatedCpusRead)
+        return instance_l.isolatedCpuMask;
+
+    instance_l.fIsolatedCpusRead = TRUE;
+
+    pFile = fopen(TARGET_THREAD_ISOLATED_CPUS, "r");
+    if (pFile == NULL)
+        return 0;
+
+    // The list has the format "0-1,4,6-7"
+    while (fscanf(pFile, "%u", &first) == 1)
+    {
+        last = first;
+        delimiter = fgetc(pFile);
+        if (delimiter == '-')
+        {
+            if (fscanf(pFile, "%u", &last) != 1)
+                break;
+            delimiter = fgetc(pFile);
+        }
+
+        for (cpu = first; (cpu <= last) && (cpu < TARGET_THREAD_MAX_CPU); cpu++)
+            instance_l.isolatedCpuMask |= ((UINT64)1 << cpu);
+
+        if (delimiter != ',')
+            break;
+    }
+
+    fclose(pFile);
+
+    return instance_l.isolatedCpuMask;
+}
+
+/// \}
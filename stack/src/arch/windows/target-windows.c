@@ -216,8 +216,14 @@ The function returns the current timestamp in nanoseconds.
 //------------------------------------------------------------------------------
 ULONGLONG target_getCurrentTimestamp(void)
 {
-    // Not implemented for this target
-    return 0ULL;
+    LARGE_INTEGER   frequency;
+    LARGE_INTEGER   counter;
+
+    if (!QueryPerformanceFrequency(&frequency) || !QueryPerformanceCounter(&counter))
+        return 0ULL;
+
+    return ((ULONGLONG)(counter.QuadPart / frequency.QuadPart) * 1000000000ULL) +
+           (((ULONGLONG)(counter.QuadPart % frequency.QuadPart) * 1000000000ULL) / frequency.QuadPart);
 }
 
 //------------------------------------------------------------------------------
@@ -90,6 +90,7 @@ const BOOL afCircBufUseDualprocshm[NR_OF_CIRC_BUFFERS] =
         FALSE,  ///< Ident request queue for MN asynchronous scheduler
         FALSE,  ///< Status request queue for MN asynchronous scheduler
         TRUE,   ///< Queue for sending virtual Ethernet frames in the DLLCAL
+        FALSE,  ///< Frame capture ring of the DLL
 };
 
 //------------------------------------------------------------------------------
@@ -94,6 +94,7 @@ const tHostifInstanceId hostifInstance[NR_OF_CIRC_BUFFERS] =
         kHostifInstIdInvalid,       ///< Ident request queue for MN asynchronous scheduler
         kHostifInstIdInvalid,       ///< Status request queue for MN asynchronous scheduler
         kHostifInstIdTxVethQueue,   ///< Queue for sending virtual Ethernet frames in the DLLCAL
+        kHostifInstIdInvalid,       ///< Frame capture ring of the DLL
 };
 
 #if (CONFIG_HOSTIF_PCP != FALSE)
@@ -104,6 +104,7 @@ the main instance can clean up and free the buffer by calling circbuf_free().
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static void updateStatistics(tCircBufHeader* pHeader_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -156,9 +157,10 @@ tCircBufError circbuf_alloc(UINT8 id_p, size_t size_p, tCircBufInstance** ppInst
     pInstance->pCircBufHeader->readOffset = 0;
     pInstance->pCircBufHeader->writeOffset = 0;
     pInstance->pCircBufHeader->dataCount = 0;
-#ifdef DEBUG_CIRCBUF_SIZE_CHECK
-    pInstance->pCircBufHeader->maxSize = 0;
-#endif
+    pInstance->pCircBufHeader->maxUsedSize = 0;
+    pInstance->pCircBufHeader->maxDataCount = 0;
+    pInstance->pCircBufHeader->fullCount = 0;
+    pInstance->pCircBufHeader->discardCount = 0;
     pInstance->pfnSigCb = NULL;
 
     OPLK_DCACHE_FLUSH(pInstance->pCircBufHeader, sizeof(tCircBufHeader));
@@ -328,6 +330,8 @@ tCircBufError circbuf_writeData(tCircBufInstance* pInstance_p,
     OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
     if (fullBlockSize > pHeader->freeSize)
     {
+        pHeader->fullCount++;
+        OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
         circbuf_unlock(pInstance_p);
         return kCircBufBufferFull;
     }
@@ -362,10 +366,7 @@ tCircBufError circbuf_writeData(tCircBufInstance* pInstance_p,
     pHeader->freeSize -= fullBlockSize;
     pHeader->dataCount++;
 
-#ifdef DEBUG_CIRCBUF_SIZE_CHECK
-    if (pHeader->bufferSize - pHeader->freeSize > pHeader->maxSize)
-        pHeader->maxSize = pHeader->bufferSize - pHeader->freeSize;
-#endif
+    updateStatistics(pHeader);
     OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
 
     circbuf_unlock(pInstance_p);
@@ -426,6 +427,8 @@ tCircBufError circbuf_writeMultipleData(tCircBufInstance* pInstance_p,
     OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
     if (fullBlockSize > pHeader->freeSize)
     {
+        pHeader->fullCount++;
+        OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
         circbuf_unlock(pInstance_p);
         return kCircBufBufferFull;
     }
@@ -480,10 +483,7 @@ tCircBufError circbuf_writeMultipleData(tCircBufInstance* pInstance_p,
     pHeader->freeSize -= fullBlockSize;
     pHeader->dataCount++;
 
-#ifdef DEBUG_CIRCBUF_SIZE_CHECK
-    if (pHeader->bufferSize - pHeader->freeSize > pHeader->maxSize)
-        pHeader->maxSize = pHeader->bufferSize - pHeader->freeSize;
-#endif
+    updateStatistics(pHeader);
     OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
 
     circbuf_unlock(pInstance_p);
@@ -586,6 +586,76 @@ tCircBufError circbuf_readData(tCircBufInstance* pInstance_p, void* pData_p,
     return kCircBufOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Discard the oldest data block of a circular buffer
+
+The function removes the oldest data block from a circular buffer without
+copying it. A producer can use it to make space for a new data block if the
+buffer is full. The discarded block is counted in the buffer statistics.
+
+\param[in]      pInstance_p         Pointer to circular buffer instance.
+
+\return The function returns a tCircBufError error code.
+\retval kCircBufOk                  The oldest data block was discarded.
+\retval kCircBufNoReadableData      The buffer is empty.
+
+\ingroup module_lib_circbuf
+*/
+//------------------------------------------------------------------------------
+tCircBufError circbuf_discardData(tCircBufInstance* pInstance_p)
+{
+    UINT32              dataSize;
+    UINT32              blockSize;
+    UINT32              fullBlockSize;
+    UINT32              chunkSize;
+    tCircBufHeader*     pHeader;
+    UINT8*              pCircBuf;
+
+    // Check parameter validity
+    ASSERT(pInstance_p != NULL);
+
+    pHeader = pInstance_p->pCircBufHeader;
+    pCircBuf = (UINT8*)pInstance_p->pCircBuf;
+
+    circbuf_lock(pInstance_p);
+
+    OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
+    if (pHeader->freeSize == pHeader->bufferSize)
+    {
+        circbuf_unlock(pInstance_p);
+        return kCircBufNoReadableData;
+    }
+
+    OPLK_DCACHE_INVALIDATE((pCircBuf + pHeader->readOffset), sizeof(UINT32));
+
+    dataSize = *(const UINT32*)(pCircBuf + pHeader->readOffset);
+    blockSize = (dataSize + (CIRCBUF_BLOCK_ALIGNMENT - 1)) & ~(CIRCBUF_BLOCK_ALIGNMENT - 1);
+    fullBlockSize = blockSize + (UINT32)sizeof(UINT32);
+
+    if (pHeader->readOffset + fullBlockSize <= pHeader->bufferSize)
+    {
+        if (pHeader->readOffset + fullBlockSize == pHeader->bufferSize)
+            pHeader->readOffset = 0;
+        else
+            pHeader->readOffset += fullBlockSize;
+    }
+    else
+    {
+        chunkSize = pHeader->bufferSize - pHeader->readOffset - (UINT32)sizeof(UINT32);
+        pHeader->readOffset = blockSize - chunkSize;
+    }
+    pHeader->freeSize += fullBlockSize;
+    pHeader->dataCount--;
+    pHeader->discardCount++;
+
+    OPLK_DCACHE_FLUSH(pHeader, sizeof(tCircBufHeader));
+
+    circbuf_unlock(pInstance_p);
+
+    return kCircBufOk;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get the available data count
@@ -612,28 +682,38 @@ UINT32 circbuf_getDataCount(const tCircBufInstance* pInstance_p)
     return pHeader->dataCount;
 }
 
-#ifdef DEBUG_CIRCBUF_SIZE_CHECK
 //------------------------------------------------------------------------------
 /**
-\brief  Get maximum used size of circular buffer
+\brief  Get the statistics of a circular buffer
 
-The function returns the maximum used size of the circular buffer.
+The function copies the occupancy statistics of a circular buffer.
 
 \param[in]      pInstance_p         Pointer to circular buffer instance.
-
-\return The function returns the maximum used data size of the buffer.
+\param[out]     pStatistics_p       Pointer to store the statistics.
 
 \ingroup module_lib_circbuf
 */
 //------------------------------------------------------------------------------
-UINT32 circbuf_getMaxSize(const tCircBufInstance* pInstance_p)
+void circbuf_getStatistics(const tCircBufInstance* pInstance_p,
+                           tCircBufStatistics* pStatistics_p)
 {
+    const tCircBufHeader*   pHeader;
+
     // Check parameter validity
     ASSERT(pInstance_p != NULL);
+    ASSERT(pStatistics_p != NULL);
 
-    return pInstance_p->pCircBufHeader->maxSize;
+    pHeader = pInstance_p->pCircBufHeader;
+    OPLK_DCACHE_INVALIDATE(pHeader, sizeof(tCircBufHeader));
+
+    pStatistics_p->bufferSize = pHeader->bufferSize;
+    pStatistics_p->usedSize = pHeader->bufferSize - pHeader->freeSize;
+    pStatistics_p->maxUsedSize = pHeader->maxUsedSize;
+    pStatistics_p->dataCount = pHeader->dataCount;
+    pStatistics_p->maxDataCount = pHeader->maxDataCount;
+    pStatistics_p->fullCount = pHeader->fullCount;
+    pStatistics_p->discardCount = pHeader->discardCount;
 }
-#endif
 
 //------------------------------------------------------------------------------
 /**
@@ -664,4 +744,25 @@ tCircBufError circBuf_setSignaling(tCircBufInstance* pInstance_p, VOIDFUNCPTR pf
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief  Update the high-water marks of a circular buffer
+
+The function updates the maximum used size and entry count after a data block
+was written. It must be called with the buffer locked.
+
+\param[in,out]  pHeader_p           Pointer to the circular buffer header.
+*/
+//------------------------------------------------------------------------------
+static void updateStatistics(tCircBufHeader* pHeader_p)
+{
+    UINT32  usedSize = pHeader_p->bufferSize - pHeader_p->freeSize;
+
+    if (usedSize > pHeader_p->maxUsedSize)
+        pHeader_p->maxUsedSize = usedSize;
+
+    if (pHeader_p->dataCount > pHeader_p->maxDataCount)
+        pHeader_p->maxDataCount = pHeader_p->dataCount;
+}
+
 /// \}
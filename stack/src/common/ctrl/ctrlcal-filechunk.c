@@ -0,0 +1,549 @@
+/**
+********************************************************************************
+\file   ctrlcal-filechunk.c
+
+\brief  File chunk ring of the control buffer
+
+The file contains the implementation of the file chunk ring which is located
+in the control buffer (tCtrlBuf). It is used by the user and the kernel parts
+of all control CAL modules and drivers which share the memory layout of the
+control buffer. The memory access is done by the functions passed to
+ctrlcal_initFileChunkRing().
+
+\ingroup module_ctrlcal
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stddef.h>
+
+#include <common/oplkinc.h>
+#include <common/ctrlcal-mem.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+// OPLK_MEMBAR() is empty on some targets, therefore GCC uses a full barrier
+#if defined(__GNUC__)
+#define CTRL_FILE_CHUNK_BARRIER()       __sync_synchronize()
+#else
+#define CTRL_FILE_CHUNK_BARRIER()       OPLK_MEMBAR()
+#endif
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError readCounts(const tCtrlFileChunkRingAccess* pAccess_p,
+                             UINT16* pWriteCount_p,
+                             UINT16* pAckCount_p);
+static tOplkError waitForAck(const tCtrlFileChunkRingAccess* pAccess_p,
+                             UINT16 maxPending_p,
+                             UINT16* pWriteCount_p);
+static size_t     getSlotOffset(UINT16 count_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the file chunk ring access
+
+The function initializes the access to the file chunk ring of the control
+buffer. The shared memory is not changed.
+
+\param[out]     pAccess_p           Pointer to the file chunk ring access.
+\param[in]      pfnReadData_p       Function for reading from the control buffer.
+\param[in]      pfnWriteData_p      Function for writing to the control buffer.
+\param[in]      pfnSleep_p          Function for sleeping while waiting for
+                                    acknowledgements. It is only used by the
+                                    user layer and can be NULL in the kernel
+                                    layer.
+
+\ingroup module_ctrlcal
+*/
+//------------------------------------------------------------------------------
+void ctrlcal_initFileChunkRing(tCtrlFileChunkRingAccess* pAccess_p,
+                               tCtrlCalReadDataCb pfnReadData_p,
+                               tCtrlCalWriteDataCb pfnWriteData_p,
+                               tCtrlCalSleepCb pfnSleep_p)
+{
+    // Check parameter validity
+    ASSERT(pAccess_p != NULL);
+    ASSERT(pfnReadData_p != NULL);
+    ASSERT(pfnWriteData_p != NULL);
+
+    OPLK_MEMSET(pAccess_p, 0, sizeof(tCtrlFileChunkRingAccess));
+    pAccess_p->pfnReadData = pfnReadData_p;
+    pAccess_p->pfnWriteData = pfnWriteData_p;
+    pAccess_p->pfnSleep = pfnSleep_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Reset the file chunk ring
+
+The function resets the counters and the return value of the file chunk ring.
+It is called by the kernel layer before the user layer accesses the control
+buffer.
+
+\param[in]      pAccess_p           Pointer to the file chunk ring access.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_ctrlcal
+*/
+//------------------------------------------------------------------------------
+tOplkError ctrlcal_resetFileChunkRing(const tCtrlFileChunkRingAccess* pAccess_p)
+{
+    UINT8   aRingHeader[offsetof(tCtrlFileChunkRing, aSlot)];
+
+    // Check parameter validity
+    ASSERT(pAccess_p != NULL);
+
+    OPLK_MEMSET(aRingHeader, 0, sizeof(aRingHeader));
+
+    return pAccess_p->pfnWriteData(offsetof(tCtrlBuf, fileChunkRing),
+                                   aRingHeader,
+                                   sizeof(aRingHeader));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write a file chunk
+
+The function writes the given file chunk to the next free slot of the file
+chunk ring. It only waits if all slots are occupied by chunks which are not yet
+acknowledged by the kernel layer. The first chunk of a file waits until all
+chunks of the previous file are acknowledged and resets the return value of
+the ring. The chunk is passed to the kernel layer by
+ctrlcal_commitFileChunk().
+
+\param[in,out]  pAccess_p           Pointer to the file chunk ring access.
+\param[in]      pDesc_p             Descriptor of the file chunk.
+\param[in]      pBuffer_p           Buffer holding the file chunk.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_ctrlcal
+*/
+//------------------------------------------------------------------------------
+tOplkError ctrlcal_writeFileChunk(tCtrlFileChunkRingAccess* pAccess_p,
+                                  const tOplkApiFileChunkDesc* pDesc_p,
+                                  const void* pBuffer_p)
+{
+    tOplkError  ret;
+    UINT16      writeCount;
+    UINT16      retVal;
+    size_t      slotOffset;
+
+    // Check parameter validity
+    ASSERT(pAccess_p != NULL);
+    ASSERT(pDesc_p != NULL);
+    ASSERT(pBuffer_p != NULL);
+
+    if (pDesc_p->length > CTRL_FILE_CHUNK_SLOT_SIZE)
+    {
+        DEBUG_LVL_ERROR_TRACE("File chunk size exceeds limit!\n");
+        return kErrorNoResource;
+    }
+
+    if (pDesc_p->fFirst)
+    {
+        ret = waitForAck(pAccess_p, 0, &writeCount);
+        if (ret != kErrorOk)
+            return ret;
+
+        retVal = (UINT16)kErrorOk;
+        ret = pAccess_p->pfnWriteData(offsetof(tCtrlBuf, fileChunkRing.retVal),
+                                      &retVal,
+                                      sizeof(UINT16));
+        if (ret != kErrorOk)
+            return ret;
+    }
+    else
+    {
+        ret = waitForAck(pAccess_p, CTRL_FILE_CHUNK_RING_COUNT - 1, &writeCount);
+        if (ret != kErrorOk)
+            return ret;
+    }
+
+    // The kernel layer has finished reading the slot before it was acknowledged
+    CTRL_FILE_CHUNK_BARRIER();
+
+    slotOffset = getSlotOffset(writeCount);
+    ret = pAccess_p->pfnWriteData(slotOffset + offsetof(tCtrlFileChunkSlot, desc),
+                                  pDesc_p,
+                                  sizeof(tOplkApiFileChunkDesc));
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = pAccess_p->pfnWriteData(slotOffset + offsetof(tCtrlFileChunkSlot, aBuffer),
+                                  pBuffer_p,
+                                  pDesc_p->length);
+    if (ret != kErrorOk)
+        return ret;
+
+    pAccess_p->fChunkStored = TRUE;
+    pAccess_p->fLastChunk = (pDesc_p->fLast != FALSE);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Commit a file chunk
+
+The function passes the file chunk stored with ctrlcal_writeFileChunk() to the
+kernel layer by incrementing the write counter of the file chunk ring. For the
+last chunk of a file the function waits until all chunks are acknowledged.
+
+\param[in,out]  pAccess_p           Pointer to the file chunk ring access.
+\param[out]     pRetVal_p           Return value of the first failed chunk of
+                                    the file which was acknowledged so far.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_ctrlcal
+*/
+//------------------------------------------------------------------------------
+tOplkError ctrlcal_commitFileChunk(tCtrlFileChunkRingAccess* pAccess_p,
+                                   UINT16* pRetVal_p)
+{
+    tOplkError  ret;
+    UINT16      writeCount;
+
+    // Check parameter validity
+    ASSERT(pAccess_p != NULL);
+    ASSERT(pRetVal_p != NULL);
+
+    if (!pAccess_p->fChunkStored)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() No file chunk stored!\n", __func__);
+        return kErrorGeneralError;
+    }
+
+    ret = pAccess_p->pfnReadData(&writeCount,
+                                 offsetof(tCtrlBuf, fileChunkRing.writeCount),
+                                 sizeof(UINT16));
+    if (ret != kErrorOk)
+        return ret;
+
+    // The chunk has to be stored before the write counter is incremented
+    CTRL_FILE_CHUNK_BARRIER();
+
+    writeCount++;
+    ret = pAccess_p->pfnWriteData(offsetof(tCtrlBuf, fileChunkRing.writeCount),
+                                  &writeCount,
+                                  sizeof(UINT16));
+    if (ret != kErrorOk)
+        return ret;
+
+    pAccess_p->fChunkStored = FALSE;
+
+    if (pAccess_p->fLastChunk)
+    {
+        ret = waitForAck(pAccess_p, 0, &writeCount);
+        if (ret != kErrorOk)
+            return ret;
+    }
+
+    // The return value is stored before the acknowledge counter is incremented
+    CTRL_FILE_CHUNK_BARRIER();
+
+    return pAccess_p->pfnReadData(pRetVal_p,
+                                  offsetof(tCtrlBuf, fileChunkRing.retVal),
+                                  sizeof(UINT16));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read a file chunk
+
+The function reads the file chunk descriptor and data of the oldest pending
+file chunk from the file chunk ring. The chunk stays pending until it is
+acknowledged with ctrlcal_ackFileChunk().
+
+\param[in]      pAccess_p           Pointer to the file chunk ring access.
+\param[out]     pDesc_p             Pointer to buffer for storing the chunk descriptor.
+\param[in]      bufferSize_p        Size of buffer for storing the chunk data.
+\param[out]     pBuffer_p           Pointer to buffer for storing the chunk data.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The file chunk was read.
+\retval kErrorNoResource            No file chunk is pending.
+\retval kErrorGeneralError          The file chunk does not fit into the buffer.
+
+\ingroup module_ctrlcal
+*/
+//------------------------------------------------------------------------------
+tOplkError ctrlcal_readFileChunk(const tCtrlFileChunkRingAccess* pAccess_p,
+                                 tOplkApiFileChunkDesc* pDesc_p,
+                                 size_t bufferSize_p,
+                                 void* pBuffer_p)
+{
+    tOplkError  ret;
+    UINT16      writeCount;
+    UINT16      ackCount;
+    size_t      slotOffset;
+
+    // Check parameter validity
+    ASSERT(pAccess_p != NULL);
+    ASSERT(pDesc_p != NULL);
+    ASSERT(pBuffer_p != NULL);
+
+    ret = readCounts(pAccess_p, &writeCount, &ackCount);
+    if (ret != kErrorOk)
+        return ret;
+
+    if (writeCount == ackCount)
+        return kErrorNoResource;
+
+    // The slot is read after the incremented write counter was observed
+    CTRL_FILE_CHUNK_BARRIER();
+
+    slotOffset = getSlotOffset(ackCount);
+    ret = pAccess_p->pfnReadData(pDesc_p,
+                                 slotOffset + offsetof(tCtrlFileChunkSlot, desc),
+                                 sizeof(tOplkApiFileChunkDesc));
+    if (ret != kErrorOk)
+        return ret;
+
+    if ((pDesc_p->length > bufferSize_p) ||
+        (pDesc_p->length > CTRL_FILE_CHUNK_SLOT_SIZE))
+    {
+        DEBUG_LVL_ERROR_TRACE("File chunk size exceeds limit!\n");
+        return kErrorGeneralError;
+    }
+
+    return pAccess_p->pfnReadData(pBuffer_p,
+                                  slotOffset + offsetof(tCtrlFileChunkSlot, aBuffer),
+                                  pDesc_p->length);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check for a pending file chunk
+
+The function checks if the file chunk ring contains a file chunk which is not
+yet acknowledged.
+
+\param[in]      pAccess_p           Pointer to the file chunk ring access.
+
+\return The function returns TRUE if a file chunk is pending, otherwise FALSE.
+
+\ingroup module_ctrlcal
+*/
+//------------------------------------------------------------------------------
+BOOL ctrlcal_isFileChunkPending(const tCtrlFileChunkRingAccess* pAccess_p)
+{
+    UINT16  writeCount;
+    UINT16  ackCount;
+
+    // Check parameter validity
+    ASSERT(pAccess_p != NULL);
+
+    if (readCounts(pAccess_p, &writeCount, &ackCount) != kErrorOk)
+        return FALSE;
+
+    return (writeCount != ackCount);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Acknowledge a file chunk
+
+The function acknowledges the oldest pending file chunk of the file chunk ring.
+The return value of the first failed chunk is kept for the user layer.
+
+\param[in]      pAccess_p           Pointer to the file chunk ring access.
+\param[in]      retVal_p            Return value of the processed file chunk.
+
+\ingroup module_ctrlcal
+*/
+//------------------------------------------------------------------------------
+void ctrlcal_ackFileChunk(const tCtrlFileChunkRingAccess* pAccess_p,
+                          UINT16 retVal_p)
+{
+    UINT16  writeCount;
+    UINT16  ackCount;
+    UINT16  retVal;
+
+    // Check parameter validity
+    ASSERT(pAccess_p != NULL);
+
+    if ((readCounts(pAccess_p, &writeCount, &ackCount) != kErrorOk) ||
+        (writeCount == ackCount))
+        return;
+
+    if ((tOplkError)retVal_p != kErrorOk)
+    {
+        if ((pAccess_p->pfnReadData(&retVal,
+                                    offsetof(tCtrlBuf, fileChunkRing.retVal),
+                                    sizeof(UINT16)) == kErrorOk) &&
+            ((tOplkError)retVal == kErrorOk))
+        {
+            pAccess_p->pfnWriteData(offsetof(tCtrlBuf, fileChunkRing.retVal),
+                                    &retVal_p,
+                                    sizeof(UINT16));
+        }
+    }
+
+    // The slot is read and the return value is stored before the chunk is
+    // acknowledged
+    CTRL_FILE_CHUNK_BARRIER();
+
+    ackCount++;
+    pAccess_p->pfnWriteData(offsetof(tCtrlBuf, fileChunkRing.ackCount),
+                            &ackCount,
+                            sizeof(UINT16));
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read the counters of the file chunk ring
+
+\param[in]      pAccess_p           Pointer to the file chunk ring access.
+\param[out]     pWriteCount_p       Pointer to store the write counter.
+\param[out]     pAckCount_p         Pointer to store the acknowledge counter.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError readCounts(const tCtrlFileChunkRingAccess* pAccess_p,
+                             UINT16* pWriteCount_p,
+                             UINT16* pAckCount_p)
+{
+    tOplkError  ret;
+
+    ret = pAccess_p->pfnReadData(pWriteCount_p,
+                                 offsetof(tCtrlBuf, fileChunkRing.writeCount),
+                                 sizeof(UINT16));
+    if (ret != kErrorOk)
+        return ret;
+
+    return pAccess_p->pfnReadData(pAckCount_p,
+                                  offsetof(tCtrlBuf, fileChunkRing.ackCount),
+                                  sizeof(UINT16));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for file chunk acknowledgements
+
+The function waits until the number of file chunks which are not yet
+acknowledged by the kernel layer does not exceed the given number.
+
+\param[in]      pAccess_p           Pointer to the file chunk ring access.
+\param[in]      maxPending_p        Maximum number of pending file chunks.
+\param[out]     pWriteCount_p       Pointer to store the write counter of the
+                                    file chunk ring.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError waitForAck(const tCtrlFileChunkRingAccess* pAccess_p,
+                             UINT16 maxPending_p,
+                             UINT16* pWriteCount_p)
+{
+    tOplkError  ret;
+    UINT16      ackCount;
+    UINT        timeout;
+
+    if (pAccess_p->pfnSleep == NULL)
+        return kErrorInvalidOperation;
+
+    for (timeout = 0; timeout < CTRL_FILE_CHUNK_TIMEOUT_CNT; timeout++)
+    {
+        ret = readCounts(pAccess_p, pWriteCount_p, &ackCount);
+        if (ret != kErrorOk)
+            return ret;
+
+        if ((UINT16)(*pWriteCount_p - ackCount) <= maxPending_p)
+            return kErrorOk;
+
+        pAccess_p->pfnSleep(1);
+    }
+
+    DEBUG_LVL_ERROR_TRACE("%s() Timeout waiting for file chunk acknowledge!\n", __func__);
+    return kErrorGeneralError;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the offset of a file chunk slot
+
+\param[in]      count_p             Write or acknowledge counter of the slot.
+
+\return The function returns the offset of the slot in the control buffer.
+*/
+//------------------------------------------------------------------------------
+static size_t getSlotOffset(UINT16 count_p)
+{
+    return offsetof(tCtrlBuf, fileChunkRing.aSlot) +
+           ((count_p % CTRL_FILE_CHUNK_RING_COUNT) * sizeof(tCtrlFileChunkSlot));
+}
+
+/// \}
@@ -469,6 +469,8 @@ static const tRetValInfo retValInfo_l[] =
     { kErrorObdStoreDataLimitExceeded, "Data count is less than the expected size"},
     { kErrorObdStoreDataObsolete,      "Data stored in the archive is obsolete"},
 
+    { kErrorTimesyncOverrun,           "Application sync processing exceeded the synchronization period"},
+
     { kErrorApiTaskDeferred,          "openPOWERLINK performs a task in the background and informs the application (or vice-versa) when it is finished"},
     { kErrorApiInvalidParam,          "Invalid parameters were passed to a function (e.g. invalid node id)"},
     { kErrorApiNoObdInitRam,          "No function pointer for ObdInitRam supplied"},
@@ -483,6 +485,7 @@ static const tRetValInfo retValInfo_l[] =
     { kErrorApiPIInvalidPIPointer,    "Process image: pointer to application's process image is invalid"},
     { kErrorApiPINonBlockingNotSupp,  "Process image: non-blocking copy jobs are not supported on this target"},
     { kErrorApiNotInitialized,        "API called but stack is not initialized/running"},
+    { kErrorApiPIBindingInvalid,      "Process image: the binding does not match its signature or the process image"},
 };
 
 static const tEmergErrCodeInfo emergErrCodeInfo_l[] =
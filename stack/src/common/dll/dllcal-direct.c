@@ -96,7 +96,7 @@ static tDllCalDirectInstance* pDllCalQueueHead_l = NULL; ///< pointer to the hea
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
-static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p, tDllCalQueue DllCalQueue_p);
+static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p, tDllCalQueue DllCalQueue_p, size_t queueSize_p);
 static tOplkError delInstance(tDllCalQueueInstance pDllCalQueue_p);
 static tOplkError insertDataBlock(tDllCalQueueInstance pDllCalQueue_p, const void* pData_p, size_t dataSize_p);
 static tOplkError getDataBlock(tDllCalQueueInstance pDllCalQueue_p, void* pData_p, size_t* pDataSize_p);
@@ -111,7 +111,8 @@ static tDllCalFuncIntf funcintf_l =
     insertDataBlock,
     getDataBlock,
     getDataBlockCount,
-    resetDataBlockQueue
+    resetDataBlockQueue,
+    NULL
 };
 
 //============================================================================//
@@ -149,6 +150,8 @@ Add a direct call instance for TX packet forwarding in DLL CAL
 
 \param[out]     ppDllCalQueue_p     Double-pointer to DllCal queue instance
 \param[in]      dllCalQueue_p       Parameter that determines the queue
+\param[in]      queueSize_p         Size of the queue. It is not used because the
+                                    direct call instance buffers a single frame.
 
 \return The function returns a tOplkError error code.
 \retval kErrorOk                    Function executes correctly
@@ -156,13 +159,16 @@ Add a direct call instance for TX packet forwarding in DLL CAL
 */
 //------------------------------------------------------------------------------
 static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p,
-                              tDllCalQueue dllCalQueue_p)
+                              tDllCalQueue dllCalQueue_p,
+                              size_t queueSize_p)
 {
     tOplkError              ret = kErrorOk;
     tDllCalDirectInstance*  pSearch;
     tDllCalDirectInstance*  pDllCalDirectInstance;
     BOOL                    fInstanceFound;
 
+    UNUSED_PARAMETER(queueSize_p);
+
     //go through linked list and search for already available instance
     pSearch = pDllCalQueueHead_l;
     fInstanceFound = FALSE;
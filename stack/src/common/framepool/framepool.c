@@ -0,0 +1,330 @@
+/**
+********************************************************************************
+\file   framepool.c
+
+\brief  Frame pool library
+
+This file contains the implementation of a frame pool library. The interface
+of the frame pool library is defined in framepool.h.
+
+\ingroup module_lib_framepool
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+/**
+********************************************************************************
+
+\defgroup   module_lib_framepool    Frame Pool Library
+\ingroup    libraries
+
+The frame pool library provides preallocated frames for the transmit paths.
+All frames of a pool are allocated in one memory block by framepool_create(),
+so that no memory is allocated while frames are sent.
+
+A layer obtains a frame with framepool_getFrame(), fills it in place and passes
+the ownership of the frame to the layer which finally releases it with
+framepool_releaseFrame(). The free frames are managed by the buffer allocation
+library, therefore getting and releasing a frame is an O(1) operation.
+
+The library does not lock the pool. The user has to serialize the accesses to a
+pool if it is used in different contexts.
+
+*******************************************************************************/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/framepool.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define FRAMEPOOL_ALIGNMENT     sizeof(UINT64)      // Alignment of the frames in the memory block
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Create a frame pool
+
+The function creates a frame pool and allocates the memory of all frames.
+
+\param[in]      frameCount_p        Number of frames in the pool.
+\param[in]      frameSize_p         Size of one frame in bytes.
+
+\return The function returns a pointer to the frame pool instance.
+\retval NULL                        Frame pool creation failed.
+\retval other                       Frame pool successfully created.
+
+\ingroup module_lib_framepool
+*/
+//------------------------------------------------------------------------------
+tFramePool* framepool_create(UINT frameCount_p, size_t frameSize_p)
+{
+    tFramePool* pFramePool;
+    tBufData    bufData;
+    UINT        i;
+
+    if ((frameCount_p == 0) || (frameSize_p == 0))
+        return NULL;
+
+    pFramePool = (tFramePool*)OPLK_MALLOC(sizeof(tFramePool));
+    if (pFramePool == NULL)
+        return NULL;
+
+    OPLK_MEMSET(pFramePool, 0, sizeof(tFramePool));
+    pFramePool->frameSize = (frameSize_p + FRAMEPOOL_ALIGNMENT - 1) & ~(FRAMEPOOL_ALIGNMENT - 1);
+    pFramePool->statistics.frameCount = frameCount_p;
+
+    pFramePool->pMemBase = (UINT8*)OPLK_MALLOC(pFramePool->frameSize * frameCount_p);
+    if (pFramePool->pMemBase == NULL)
+        goto Exit;
+
+    pFramePool->pBufAlloc = bufalloc_init(frameCount_p);
+    if (pFramePool->pBufAlloc == NULL)
+        goto Exit;
+
+    // add the frames in reverse order, so that the first frame is used first
+    for (i = frameCount_p; i > 0; i--)
+    {
+        bufData.bufferNumber = i - 1;
+        bufData.pBuffer = pFramePool->pMemBase + (bufData.bufferNumber * pFramePool->frameSize);
+        if (bufalloc_addBuffer(pFramePool->pBufAlloc, &bufData) != kErrorOk)
+            goto Exit;
+    }
+
+    return pFramePool;
+
+Exit:
+    framepool_destroy(pFramePool);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Destroy a frame pool
+
+The function frees the frame pool and the memory of all frames. Frames which
+are still in use become invalid.
+
+\param[in]      pFramePool_p        Pointer to the frame pool instance.
+
+\ingroup module_lib_framepool
+*/
+//------------------------------------------------------------------------------
+void framepool_destroy(tFramePool* pFramePool_p)
+{
+    if (pFramePool_p == NULL)
+        return;
+
+    if (pFramePool_p->statistics.usedCount != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() %u frames are still in use\n",
+                              __func__,
+                              pFramePool_p->statistics.usedCount);
+    }
+
+    if (pFramePool_p->pBufAlloc != NULL)
+        bufalloc_exit(pFramePool_p->pBufAlloc);
+
+    if (pFramePool_p->pMemBase != NULL)
+        OPLK_FREE(pFramePool_p->pMemBase);
+
+    OPLK_FREE(pFramePool_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get a frame from the pool
+
+The function takes a free frame from the pool. The content of the frame is
+undefined.
+
+\param[in,out]  pFramePool_p        Pointer to the frame pool instance.
+
+\return The function returns a pointer to the frame.
+\retval NULL                        No free frame is available.
+\retval other                       Pointer to the frame.
+
+\ingroup module_lib_framepool
+*/
+//------------------------------------------------------------------------------
+tPlkFrame* framepool_getFrame(tFramePool* pFramePool_p)
+{
+    tBufData    bufData;
+
+    ASSERT(pFramePool_p != NULL);
+
+    if (bufalloc_getBuffer(pFramePool_p->pBufAlloc, &bufData) != kErrorOk)
+    {
+        pFramePool_p->statistics.allocFailCount++;
+        return NULL;
+    }
+
+    pFramePool_p->statistics.allocCount++;
+    pFramePool_p->statistics.usedCount++;
+    if (pFramePool_p->statistics.usedCount > pFramePool_p->statistics.maxUsedCount)
+        pFramePool_p->statistics.maxUsedCount = pFramePool_p->statistics.usedCount;
+
+    return (tPlkFrame*)bufData.pBuffer;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release a frame to the pool
+
+The function gives a frame which was obtained by framepool_getFrame() back to
+the pool.
+
+\param[in,out]  pFramePool_p        Pointer to the frame pool instance.
+\param[in]      pFrame_p            Pointer to the frame.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The frame was released.
+\retval kErrorInvalidOperation      The frame does not belong to the pool.
+\retval kErrorGeneralError          All frames of the pool are already released.
+
+\ingroup module_lib_framepool
+*/
+//------------------------------------------------------------------------------
+tOplkError framepool_releaseFrame(tFramePool* pFramePool_p, tPlkFrame* pFrame_p)
+{
+    tOplkError  ret;
+    tBufData    bufData;
+
+    ASSERT(pFramePool_p != NULL);
+
+    if (!framepool_isPoolFrame(pFramePool_p, pFrame_p))
+        return kErrorInvalidOperation;
+
+    bufData.pBuffer = pFrame_p;
+    bufData.bufferNumber = (UINT)(((UINT8*)pFrame_p - pFramePool_p->pMemBase) /
+                                  pFramePool_p->frameSize);
+
+    ret = bufalloc_releaseBuffer(pFramePool_p->pBufAlloc, &bufData);
+    if (ret == kErrorOk)
+        pFramePool_p->statistics.usedCount--;
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if a frame belongs to the pool
+
+The function checks if the given pointer refers to the start of a frame of the
+pool.
+
+\param[in]      pFramePool_p        Pointer to the frame pool instance.
+\param[in]      pFrame_p            Pointer to check.
+
+\return The function returns TRUE if the frame belongs to the pool, otherwise
+        FALSE.
+
+\ingroup module_lib_framepool
+*/
+//------------------------------------------------------------------------------
+BOOL framepool_isPoolFrame(const tFramePool* pFramePool_p, const tPlkFrame* pFrame_p)
+{
+    const UINT8*    pFrame = (const UINT8*)pFrame_p;
+    size_t          offset;
+
+    if ((pFramePool_p == NULL) || (pFrame < pFramePool_p->pMemBase))
+        return FALSE;
+
+    offset = (size_t)(pFrame - pFramePool_p->pMemBase);
+    if (offset >= (pFramePool_p->frameSize * pFramePool_p->statistics.frameCount))
+        return FALSE;
+
+    return ((offset % pFramePool_p->frameSize) == 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the frame pool statistics
+
+The function copies the occupancy statistics of the frame pool.
+
+\param[in]      pFramePool_p        Pointer to the frame pool instance.
+\param[out]     pStatistics_p       Pointer to store the statistics.
+
+\ingroup module_lib_framepool
+*/
+//------------------------------------------------------------------------------
+void framepool_getStatistics(const tFramePool* pFramePool_p,
+                             tFramePoolStatistics* pStatistics_p)
+{
+    ASSERT(pFramePool_p != NULL);
+    ASSERT(pStatistics_p != NULL);
+
+    *pStatistics_p = pFramePool_p->statistics;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+/// \}
@@ -127,6 +127,10 @@ static tCtrlkInstance   instance_l;
 static tOplkError initStack(void);
 static tOplkError shutdownStack(void);
 static void setupKernelFeatures(void);
+static void processFileChunks(void);
+#if defined(CONFIG_INCLUDE_PDO)
+static tOplkError cbSync(void);
+#endif
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -225,6 +229,8 @@ BOOL ctrlk_process(void)
         }
     }
 
+    processFileChunks();
+
     eventkcal_process();
 
 #if defined(CONFIG_INCLUDE_LEDK)
@@ -498,10 +504,14 @@ static tOplkError initStack(void)
     if (ret != kErrorOk)
         return ret;
 
+#if defined(CONFIG_INCLUDE_PDO)
+    dllk_regSyncHandler(cbSync);
+#else
     dllk_regSyncHandler(timesynck_sendSyncEvent);
+#endif
 
     // initialize dllkcal module
-    ret = dllkcal_init();
+    ret = dllkcal_init(&instance_l.initParam.dllCalQueueSizes);
     if (ret != kErrorOk)
         return ret;
 
@@ -632,4 +642,60 @@ static void setupKernelFeatures(void)
 #endif
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Process pending file chunks
+
+The function passes the file chunks pending in the file chunk ring of the
+control CAL to the command execution callback and acknowledges them. At most
+CONFIG_CTRL_FILE_CHUNK_RING_COUNT chunks are processed per call.
+*/
+//------------------------------------------------------------------------------
+static void processFileChunks(void)
+{
+    UINT16              retVal;
+    UINT16              status;
+    BOOL                fExit;
+    UINT                chunkCount;
+
+    for (chunkCount = 0; chunkCount < CONFIG_CTRL_FILE_CHUNK_RING_COUNT; chunkCount++)
+    {
+        if (!ctrlkcal_isFileChunkPending())
+            break;
+
+        if ((instance_l.pfnExecuteCmdCb == NULL) ||
+            !instance_l.pfnExecuteCmdCb(kCtrlWriteFileChunk, &retVal, &status, &fExit))
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() File chunk not handled!\n", __func__);
+            retVal = (UINT16)kErrorApiNotSupported;
+        }
+
+        ctrlkcal_ackFileChunk(retVal);
+    }
+}
+
+#if defined(CONFIG_INCLUDE_PDO)
+//------------------------------------------------------------------------------
+/**
+\brief  Sync callback function
+
+The function is called by the DLL at the end of every cycle. It applies pending
+PDO channel updates and publishes the PDO images of the cycle before the sync
+event is sent to the user layer.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError cbSync(void)
+{
+    tOplkError  ret;
+
+    ret = pdok_processSync();
+    if (ret != kErrorOk)
+        return ret;
+
+    return timesynck_sendSyncEvent();
+}
+#endif
+
 /// \}
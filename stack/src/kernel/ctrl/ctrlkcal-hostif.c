@@ -382,6 +382,40 @@ size_t ctrlkcal_getMaxFileChunkSize(void)
     return 0;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Check for a pending file chunk
+
+The function checks if the file chunk ring contains a file chunk which is not
+yet acknowledged.
+
+\return The function returns TRUE if a file chunk is pending, otherwise FALSE.
+
+\ingroup module_ctrlk
+*/
+//------------------------------------------------------------------------------
+BOOL ctrlkcal_isFileChunkPending(void)
+{
+    // This CAL is not supporting a file chunk ring -> no chunk is pending.
+    return FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Acknowledge a file chunk
+
+The function acknowledges the oldest pending file chunk of the file chunk ring.
+
+\param[in]      retVal_p            Return value of the processed file chunk.
+
+\ingroup module_ctrlk
+*/
+//------------------------------------------------------------------------------
+void ctrlkcal_ackFileChunk(UINT16 retVal_p)
+{
+    UNUSED_PARAMETER(retVal_p);
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -74,14 +74,27 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
+/**
+\brief Kernel control CAL instance
+
+The structure contains the access to the file chunk ring of the control buffer.
+*/
+typedef struct
+{
+    tCtrlFileChunkRingAccess    fileChunkRing;  ///< File chunk ring access
+} tCtrlkCalInstance;
 
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
+static tCtrlkCalInstance    instance_l;
 
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static tOplkError writeData(size_t offset_p,
+                            const void* pSrc_p,
+                            size_t length_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -105,6 +118,11 @@ tOplkError ctrlkcal_init(void)
     tCtrlBuf    ctrl;
     tOplkError  ret;
 
+    ctrlcal_initFileChunkRing(&instance_l.fileChunkRing,
+                              ctrlcal_readData,
+                              writeData,
+                              NULL);
+
     ret = ctrlcal_init(sizeof(tCtrlBuf));
     if (ret != kErrorOk)
         return kErrorNoResource;
@@ -304,14 +322,18 @@ tOplkError ctrlkcal_readInitParam(tCtrlInitParam* pInitParam_p)
 /**
 \brief  Read file chunk
 
-The function reads the file chunk descriptor and data from the file transfer
-buffer.
+The function reads the file chunk descriptor and data of the oldest pending
+file chunk from the file chunk ring. The chunk stays pending until it is
+acknowledged with ctrlkcal_ackFileChunk().
 
 \param[out]     pDesc_p             Pointer to buffer for storing the chunk descriptor
 \param[in]      bufferSize_p        Size of buffer for storing the chunk data
 \param[out]     pBuffer_p           Pointer to buffer for storing the chunk data
 
 \return The function returns a tOplkError code.
+\retval kErrorOk                    The file chunk was read.
+\retval kErrorNoResource            No file chunk is pending.
+\retval kErrorGeneralError          The file chunk does not fit into the buffer.
 
 \ingroup module_ctrlk
 */
@@ -320,12 +342,10 @@ tOplkError ctrlkcal_readFileChunk(tOplkApiFileChunkDesc* pDesc_p,
                                   size_t bufferSize_p,
                                   void* pBuffer_p)
 {
-    UNUSED_PARAMETER(pDesc_p);
-    UNUSED_PARAMETER(bufferSize_p);
-    UNUSED_PARAMETER(pBuffer_p);
-
-    // This CAL is not supporting that feature -> return no resource available.
-    return kErrorNoResource;
+    return ctrlcal_readFileChunk(&instance_l.fileChunkRing,
+                                 pDesc_p,
+                                 bufferSize_p,
+                                 pBuffer_p);
 }
 
 //------------------------------------------------------------------------------
@@ -342,8 +362,41 @@ implementation.
 //------------------------------------------------------------------------------
 size_t ctrlkcal_getMaxFileChunkSize(void)
 {
-    // This CAL is not supporting that feature -> return zero size.
-    return 0;
+    return CTRL_FILE_CHUNK_SLOT_SIZE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check for a pending file chunk
+
+The function checks if the file chunk ring contains a file chunk which is not
+yet acknowledged.
+
+\return The function returns TRUE if a file chunk is pending, otherwise FALSE.
+
+\ingroup module_ctrlk
+*/
+//------------------------------------------------------------------------------
+BOOL ctrlkcal_isFileChunkPending(void)
+{
+    return ctrlcal_isFileChunkPending(&instance_l.fileChunkRing);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Acknowledge a file chunk
+
+The function acknowledges the oldest pending file chunk of the file chunk ring.
+The return value of the first failed chunk is kept for the user layer.
+
+\param[in]      retVal_p            Return value of the processed file chunk.
+
+\ingroup module_ctrlk
+*/
+//------------------------------------------------------------------------------
+void ctrlkcal_ackFileChunk(UINT16 retVal_p)
+{
+    ctrlcal_ackFileChunk(&instance_l.fileChunkRing, retVal_p);
 }
 
 //============================================================================//
@@ -352,4 +405,27 @@ size_t ctrlkcal_getMaxFileChunkSize(void)
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief  Write data to the control buffer
+
+The function writes data to the control buffer. It is used by the file chunk
+ring.
+
+\param[in]      offset_p            Offset in the control buffer.
+\param[in]      pSrc_p              Pointer to the data to be written.
+\param[in]      length_p            Length of the data to be written.
+
+\return The function returns kErrorOk.
+*/
+//------------------------------------------------------------------------------
+static tOplkError writeData(size_t offset_p,
+                            const void* pSrc_p,
+                            size_t length_p)
+{
+    ctrlcal_writeData(offset_p, pSrc_p, length_p);
+
+    return kErrorOk;
+}
+
 /// \}
@@ -86,7 +86,8 @@ control CAL module during runtime
 */
 typedef struct
 {
-    tDualprocDrvInstance    dualProcDrvInst;    ///< Dual processor driver instance
+    tDualprocDrvInstance        dualProcDrvInst;    ///< Dual processor driver instance
+    tCtrlFileChunkRingAccess    fileChunkRing;      ///< File chunk ring access
 } tCtrlkCalInstance;
 
 //------------------------------------------------------------------------------
@@ -97,6 +98,12 @@ static tCtrlkCalInstance    instance_l;
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static tOplkError readData(void* pDest_p,
+                           size_t offset_p,
+                           size_t length_p);
+static tOplkError writeData(size_t offset_p,
+                            const void* pSrc_p,
+                            size_t length_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -124,6 +131,7 @@ tOplkError ctrlkcal_init(void)
 
     // Reset the instance
     OPLK_MEMSET(&instance_l, 0, sizeof(instance_l));
+    ctrlcal_initFileChunkRing(&instance_l.fileChunkRing, readData, writeData, NULL);
 
     OPLK_MEMSET(&dualProcConfig, 0, sizeof(tDualprocConfig));
 
@@ -160,6 +168,13 @@ tOplkError ctrlkcal_init(void)
         goto Exit;
     }
 
+    if (ctrlcal_resetFileChunkRing(&instance_l.fileChunkRing) != kErrorOk)
+    {
+        DEBUG_LVL_ERROR_TRACE(" {%s} Could not reset file chunk ring\n", __func__);
+        ret = kErrorNoResource;
+        goto Exit;
+    }
+
     magic = CTRL_MAGIC;
     dualRet = dualprocshm_writeDataCommon(instance_l.dualProcDrvInst,
                                           offsetof(tCtrlBuf, magic),
@@ -402,14 +417,18 @@ tOplkError ctrlkcal_readInitParam(tCtrlInitParam* pInitParam_p)
 /**
 \brief  Read file chunk
 
-The function reads the file chunk descriptor and data from the file transfer
-buffer.
+The function reads the file chunk descriptor and data of the oldest pending
+file chunk from the file chunk ring. The chunk stays pending until it is
+acknowledged with ctrlkcal_ackFileChunk().
 
 \param[out]     pDesc_p             Pointer to buffer for storing the chunk descriptor
 \param[in]      bufferSize_p        Size of buffer for storing the chunk data
 \param[out]     pBuffer_p           Pointer to buffer for storing the chunk data
 
 \return The function returns a tOplkError code.
+\retval kErrorOk                    The file chunk was read.
+\retval kErrorNoResource            No file chunk is pending.
+\retval kErrorGeneralError          The file chunk could not be read.
 
 \ingroup module_ctrlk
 */
@@ -418,44 +437,10 @@ tOplkError ctrlkcal_readFileChunk(tOplkApiFileChunkDesc* pDesc_p,
                                   size_t bufferSize_p,
                                   void* pBuffer_p)
 {
-    tDualprocReturn dualret;
-
-    // Check parameter validity
-    ASSERT(pDesc_p != NULL);
-    ASSERT(pBuffer_p != NULL);
-
-    // Check if caller provides sufficiently large buffer
-    if (bufferSize_p < CONFIG_CTRL_FILE_CHUNK_SIZE)
-        return kErrorNoResource;
-
-    dualret = dualprocshm_readDataCommon(instance_l.dualProcDrvInst,
-                                         offsetof(tCtrlBuf, fileChunkDesc),
-                                         sizeof(tOplkApiFileChunkDesc),
-                                         pDesc_p);
-    if (dualret != kDualprocSuccessful)
-    {
-        DEBUG_LVL_ERROR_TRACE("Cannot read file chunk descriptor (0x%X)\n", dualret);
-        return kErrorGeneralError;
-    }
-
-    // Check the chunk size in descriptor
-    if (pDesc_p->length > bufferSize_p)
-    {
-        DEBUG_LVL_ERROR_TRACE("File chunk size exceeds limit!\n");
-        return kErrorGeneralError;
-    }
-
-    dualret = dualprocshm_readDataCommon(instance_l.dualProcDrvInst,
-                                         offsetof(tCtrlBuf, aFileChunkBuffer),
-                                         bufferSize_p,
-                                         pBuffer_p);
-    if (dualret != kDualprocSuccessful)
-    {
-        DEBUG_LVL_ERROR_TRACE("Cannot read file chunk data (0x%X)\n", dualret);
-        return kErrorGeneralError;
-    }
-
-    return kErrorOk;
+    return ctrlcal_readFileChunk(&instance_l.fileChunkRing,
+                                 pDesc_p,
+                                 bufferSize_p,
+                                 pBuffer_p);
 }
 
 //------------------------------------------------------------------------------
@@ -472,7 +457,41 @@ implementation.
 //------------------------------------------------------------------------------
 size_t ctrlkcal_getMaxFileChunkSize(void)
 {
-    return CONFIG_CTRL_FILE_CHUNK_SIZE;
+    return CTRL_FILE_CHUNK_SLOT_SIZE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check for a pending file chunk
+
+The function checks if the file chunk ring contains a file chunk which is not
+yet acknowledged.
+
+\return The function returns TRUE if a file chunk is pending, otherwise FALSE.
+
+\ingroup module_ctrlk
+*/
+//------------------------------------------------------------------------------
+BOOL ctrlkcal_isFileChunkPending(void)
+{
+    return ctrlcal_isFileChunkPending(&instance_l.fileChunkRing);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Acknowledge a file chunk
+
+The function acknowledges the oldest pending file chunk of the file chunk ring.
+The return value of the first failed chunk is kept for the user layer.
+
+\param[in]      retVal_p            Return value of the processed file chunk.
+
+\ingroup module_ctrlk
+*/
+//------------------------------------------------------------------------------
+void ctrlkcal_ackFileChunk(UINT16 retVal_p)
+{
+    ctrlcal_ackFileChunk(&instance_l.fileChunkRing, retVal_p);
 }
 
 //============================================================================//
@@ -481,4 +500,70 @@ size_t ctrlkcal_getMaxFileChunkSize(void)
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief  Read data from the control buffer
+
+The function reads data from the control buffer in the common memory. It is
+used by the file chunk ring.
+
+\param[out]     pDest_p             Pointer to store the read data.
+\param[in]      offset_p            Offset in the control buffer.
+\param[in]      length_p            Length of the data to be read.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError readData(void* pDest_p,
+                           size_t offset_p,
+                           size_t length_p)
+{
+    tDualprocReturn dualRet;
+
+    dualRet = dualprocshm_readDataCommon(instance_l.dualProcDrvInst,
+                                         (UINT32)offset_p,
+                                         length_p,
+                                         pDest_p);
+    if (dualRet != kDualprocSuccessful)
+    {
+        DEBUG_LVL_ERROR_TRACE("Cannot read control buffer (0x%X)\n", dualRet);
+        return kErrorGeneralError;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write data to the control buffer
+
+The function writes data to the control buffer in the common memory. It is
+used by the file chunk ring.
+
+\param[in]      offset_p            Offset in the control buffer.
+\param[in]      pSrc_p              Pointer to the data to be written.
+\param[in]      length_p            Length of the data to be written.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError writeData(size_t offset_p,
+                            const void* pSrc_p,
+                            size_t length_p)
+{
+    tDualprocReturn dualRet;
+
+    dualRet = dualprocshm_writeDataCommon(instance_l.dualProcDrvInst,
+                                          (UINT32)offset_p,
+                                          length_p,
+                                          pSrc_p);
+    if (dualRet != kDualprocSuccessful)
+    {
+        DEBUG_LVL_ERROR_TRACE("Cannot write control buffer (0x%X)\n", dualRet);
+        return kErrorGeneralError;
+    }
+
+    return kErrorOk;
+}
+
 /// \}
@@ -70,6 +70,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #error "PRes Chaining CN support requires CONFIG_DLL_PROCESS_SYNC == DLL_PROCESS_SYNC_ON_TIMER."
 #endif
 
+#if ((CONFIG_DLL_PRES_LATE_DATA != FALSE) && (CONFIG_EDRV_AUTO_RESPONSE != FALSE))
+#error "PRes late data support requires CONFIG_EDRV_AUTO_RESPONSE == FALSE."
+#endif
+
+#if ((CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES != 0) && (CONFIG_EDRV_AUTO_RESPONSE != FALSE))
+#error "PRes response time measurement requires CONFIG_EDRV_AUTO_RESPONSE == FALSE."
+#endif
+
 #if (defined(CONFIG_INCLUDE_NMT_RMN) && CONFIG_TIMER_USE_HIGHRES == FALSE)
 #error "RMN support needs CONFIG_TIMER_USE_HIGHRES != FALSE"
 #endif
@@ -126,6 +134,26 @@ void target_signalTracePoint(UINT8 tracePointNumber_p);
 #define DLLK_UPDATE_STATUS          1       // StatusRes needs update
 #define DLLK_UPDATE_BOTH            2       // IdentRes and StatusRes need update
 
+#if (CONFIG_DLL_PRES_LATE_DATA != FALSE)
+// defines for tDllkInstance.presState
+#define DLLK_PRES_STATE_BUFFER      0x01    // offset of the Tx buffer of the prepared PRes
+#define DLLK_PRES_STATE_SENT        0x02    // prepared PRes has been claimed by the receive path
+
+// The prepared PRes is claimed by the receive path and exchanged by the event
+// handler, which may run in different threads. The critical section of the DLL
+// is empty on most targets, therefore both sides access the state word with
+// atomic operations.
+#if defined(__GNUC__)
+#define DLLK_PRES_STATE_CLAIM(pState)               __sync_fetch_and_or((pState), DLLK_PRES_STATE_SENT)
+#define DLLK_PRES_STATE_EXCHANGE(pState, old, new)  __sync_bool_compare_and_swap((pState), (old), (new))
+#define DLLK_PRES_STATE_SET(pState, new)            do { __sync_synchronize(); *(pState) = (new); } while (0)
+#else
+#define DLLK_PRES_STATE_CLAIM(pState)               dllk_claimPresState(pState)
+#define DLLK_PRES_STATE_EXCHANGE(pState, old, new)  dllk_exchangePresState((pState), (old), (new))
+#define DLLK_PRES_STATE_SET(pState, new)            do { OPLK_MEMBAR(); *(pState) = (new); } while (0)
+#endif
+#endif
+
 // defines for tDllkNodeInfo.presFilterFlags
 #define DLLK_FILTER_FLAG_PDO        0x01    // PRes needed for RPDO
 #define DLLK_FILTER_FLAG_HB         0x02    // PRes needed for Heartbeat Consumer
@@ -244,6 +272,16 @@ typedef struct
     UINT32                  prcPResFallBackTimeout;                 ///< Timeout to fall back to PReq/PRes mode on the first communication path
 #endif
 
+#if (CONFIG_DLL_PRES_LATE_DATA != FALSE)
+    volatile UINT8          presState;                              ///< Tx buffer and sent flag of the prepared PRes (DLLK_PRES_STATE_xxx)
+    UINT32                  presLateDataCount;                      ///< Number of PRes frames rebuilt with late data
+    UINT32                  presLateMissCount;                      ///< Number of late data updates which missed the PRes of the current cycle
+#endif
+#if (CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES != 0)
+    tDllEventPresResponseTime presResponseTime;                     ///< PRes response time statistics of the current report interval
+    UINT32                  presResponseTimeSum;                    ///< Sum of the PRes response times of the current report interval [ns]
+#endif
+
 #if (defined(CONFIG_INCLUDE_NMT_MN) && defined(CONFIG_INCLUDE_PRES_FORWARD))
     tDllkPresFw             aPresForward[NMT_MAX_NODE_ID];
 #endif
@@ -275,11 +313,17 @@ extern "C"
 //------------------------------------------------------------------------------
 /* Helper functions */
 tOplkError dllk_postEvent(tEventType eventType_p);
+tOplkError dllk_regEventHandlers(void);
 
 #if defined(CONFIG_INCLUDE_NMT_RMN)
 tOplkError dllk_cbTimerSwitchOver(const tTimerEventArg* pEventArg_p);
 #endif
 
+#if ((CONFIG_DLL_PRES_LATE_DATA != FALSE) && !defined(__GNUC__))
+UINT8      dllk_claimPresState(volatile UINT8* pState_p);
+BOOL       dllk_exchangePresState(volatile UINT8* pState_p, UINT8 old_p, UINT8 new_p);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -63,6 +63,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/hrestimer.h>
 #endif
 
+#if (CONFIG_EDRV_BUSY_POLL != FALSE)
+#include <kernel/edrvbusypoll.h>
+#endif
+
+#if ((CONFIG_DLL_PRES_LATE_DATA != FALSE) && !defined(__GNUC__))
+#include <common/target.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -178,6 +186,8 @@ tOplkError dllk_init(void)
         dllkInstance_g.pTxBuffer[index].pBuffer = NULL;
     }
 
+    ret = dllk_regEventHandlers();
+
     return ret;
 }
 
@@ -280,6 +290,10 @@ tOplkError dllk_config(const tDllConfigParam* pDllConfigParam_p)
         dllkInstance_g.frameTimeout = 0LL;
     }
 
+#if (CONFIG_EDRV_BUSY_POLL != FALSE)
+    edrvbusypoll_setCycleTime(dllkInstance_g.dllConfigParam.cycleLen);
+#endif
+
     if (dllkInstance_g.dllConfigParam.fAsyncOnly != FALSE)
     {   // it is configured as async-only CN
         // disable multiplexed cycle, so that cycleCount will not be incremented spuriously on SoC
@@ -987,6 +1001,61 @@ Exit:
 }
 #endif
 
+#if ((CONFIG_DLL_PRES_LATE_DATA != FALSE) && !defined(__GNUC__))
+//------------------------------------------------------------------------------
+/**
+\brief  Claim the prepared PRes
+
+The function sets the sent flag of the PRes state word atomically on targets
+without atomic builtins by locking the interrupts.
+
+\param[in,out]  pState_p            Pointer to the PRes state word.
+
+\return The function returns the previous PRes state.
+*/
+//------------------------------------------------------------------------------
+UINT8 dllk_claimPresState(volatile UINT8* pState_p)
+{
+    UINT8   state;
+
+    target_enableGlobalInterrupt(FALSE);
+    state = *pState_p;
+    *pState_p = state | DLLK_PRES_STATE_SENT;
+    target_enableGlobalInterrupt(TRUE);
+
+    return state;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Exchange the prepared PRes
+
+The function replaces the PRes state word atomically if it contains the
+expected state on targets without atomic builtins by locking the interrupts.
+
+\param[in,out]  pState_p            Pointer to the PRes state word.
+\param[in]      old_p               Expected PRes state.
+\param[in]      new_p               New PRes state.
+
+\return The function returns TRUE if the PRes state was replaced.
+*/
+//------------------------------------------------------------------------------
+BOOL dllk_exchangePresState(volatile UINT8* pState_p, UINT8 old_p, UINT8 new_p)
+{
+    BOOL    fExchanged = FALSE;
+
+    target_enableGlobalInterrupt(FALSE);
+    if (*pState_p == old_p)
+    {
+        *pState_p = new_p;
+        fExchanged = TRUE;
+    }
+    target_enableGlobalInterrupt(TRUE);
+
+    return fExchanged;
+}
+#endif
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -91,12 +91,13 @@ typedef struct
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
-static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p, tDllCalQueue DllCalQueue_p);
+static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p, tDllCalQueue DllCalQueue_p, size_t queueSize_p);
 static tOplkError delInstance(tDllCalQueueInstance pDllCalQueue_p);
 static tOplkError insertDataBlock(tDllCalQueueInstance pDllCalQueue_p, const void* pData_p, size_t dataSize_p);
 static tOplkError getDataBlock(tDllCalQueueInstance pDllCalQueue_p, void* pData_p, size_t* pDataSize_p);
 static tOplkError getDataBlockCount(tDllCalQueueInstance pDllCalQueue_p, UINT* pDataBlockCount_p);
 static tOplkError resetDataBlockQueue(tDllCalQueueInstance pDllCalQueue_p);
+static tOplkError getStatistics(tDllCalQueueInstance pDllCalQueue_p, tDllCalQueueStatistics* pStatistics_p);
 
 /* define external function interface */
 static tDllCalFuncIntf funcintf_l =
@@ -106,7 +107,8 @@ static tDllCalFuncIntf funcintf_l =
     insertDataBlock,
     getDataBlock,
     getDataBlockCount,
-    resetDataBlockQueue
+    resetDataBlockQueue,
+    getStatistics
 };
 
 //============================================================================//
@@ -145,6 +147,8 @@ Add an instance for TX packet forwarding in DLL CAL.
 
 \param[out]     ppDllCalQueue_p     Double-pointer to DllCal Queue instance
 \param[in]      dllCalQueue_p       Parameter that determines the queue
+\param[in]      queueSize_p         Size of the queue in bytes. If it is 0, the
+                                    configured default size of the queue is used.
 
 \return The function returns a tOplkError error code.
 \retval kErrorOk                    Function executes correctly
@@ -152,7 +156,8 @@ Add an instance for TX packet forwarding in DLL CAL.
 */
 //------------------------------------------------------------------------------
 static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p,
-                              tDllCalQueue dllCalQueue_p)
+                              tDllCalQueue dllCalQueue_p,
+                              size_t queueSize_p)
 {
     tOplkError              ret = kErrorOk;
     tCircBufError           error = kCircBufOk;
@@ -173,24 +178,25 @@ static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p,
     {
         case kDllCalQueueTxGen:
             error = circbuf_alloc(CIRCBUF_DLLCAL_TXGEN,
-                                  CONFIG_DLLCAL_BUFFER_SIZE_TX_GEN,
+                                  (queueSize_p != 0) ? queueSize_p : CONFIG_DLLCAL_BUFFER_SIZE_TX_GEN,
                                   &pDllCalCircBufInstance->pCircBufInstance);
             break;
 
         case kDllCalQueueTxNmt:
             error = circbuf_alloc(CIRCBUF_DLLCAL_TXNMT,
-                                  CONFIG_DLLCAL_BUFFER_SIZE_TX_NMT,
+                                  (queueSize_p != 0) ? queueSize_p : CONFIG_DLLCAL_BUFFER_SIZE_TX_NMT,
                                   &pDllCalCircBufInstance->pCircBufInstance);
             break;
 
         case kDllCalQueueTxSync:
-            error = circbuf_alloc(CIRCBUF_DLLCAL_TXSYNC, CONFIG_DLLCAL_BUFFER_SIZE_TX_SYNC,
+            error = circbuf_alloc(CIRCBUF_DLLCAL_TXSYNC,
+                                  (queueSize_p != 0) ? queueSize_p : CONFIG_DLLCAL_BUFFER_SIZE_TX_SYNC,
                                   &pDllCalCircBufInstance->pCircBufInstance);
             break;
 
         case kDllCalQueueTxVeth:
             error = circbuf_alloc(CIRCBUF_DLLCAL_TXVETH,
-                                  CONFIG_DLLCAL_BUFFER_SIZE_TX_VETH,
+                                  (queueSize_p != 0) ? queueSize_p : CONFIG_DLLCAL_BUFFER_SIZE_TX_VETH,
                                   &pDllCalCircBufInstance->pCircBufInstance);
             break;
 
@@ -272,6 +278,19 @@ static tOplkError insertDataBlock(tDllCalQueueInstance pDllCalQueue_p,
     }
 
     error = circbuf_writeData(pDllCalCircBufInstance->pCircBufInstance, pData_p, dataSize_p);
+#if (CONFIG_DLLCAL_TX_OVERFLOW_POLICY == DLLCAL_TX_OVERFLOW_DISCARD_OLDEST)
+    // NMT and SyncRequest frames are never discarded, the caller has to retry
+    if ((pDllCalCircBufInstance->dllCalQueue == kDllCalQueueTxGen) ||
+        (pDllCalCircBufInstance->dllCalQueue == kDllCalQueueTxVeth))
+    {
+        while ((error == kCircBufBufferFull) &&
+               (circbuf_discardData(pDllCalCircBufInstance->pCircBufInstance) == kCircBufOk))
+        {
+            error = circbuf_writeData(pDllCalCircBufInstance->pCircBufInstance, pData_p, dataSize_p);
+        }
+    }
+#endif
+
     switch (error)
     {
         case kCircBufOk:
@@ -397,4 +416,41 @@ static tOplkError resetDataBlockQueue(tDllCalQueueInstance pDllCalQueue_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get queue statistics
+
+Returns the occupancy statistics of the DLL CAL queue.
+
+\param[in]      pDllCalQueue_p      Pointer to DllCal Queue instance.
+\param[out]     pStatistics_p       Pointer to store the statistics.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    Function executes correctly
+\retval other                       Error
+*/
+//------------------------------------------------------------------------------
+static tOplkError getStatistics(tDllCalQueueInstance pDllCalQueue_p,
+                                tDllCalQueueStatistics* pStatistics_p)
+{
+    const tDllCalCircBufInstance*   pDllCalCircBufInstance =
+                                        (const tDllCalCircBufInstance*)pDllCalQueue_p;
+    tCircBufStatistics              statistics;
+
+    if (pDllCalCircBufInstance == NULL)
+        return kErrorInvalidInstanceParam;
+
+    circbuf_getStatistics(pDllCalCircBufInstance->pCircBufInstance, &statistics);
+
+    pStatistics_p->queueSize = statistics.bufferSize;
+    pStatistics_p->usedSize = statistics.usedSize;
+    pStatistics_p->maxUsedSize = statistics.maxUsedSize;
+    pStatistics_p->frameCount = statistics.dataCount;
+    pStatistics_p->maxFrameCount = statistics.maxDataCount;
+    pStatistics_p->rejectCount = statistics.fullCount;
+    pStatistics_p->discardCount = statistics.discardCount;
+
+    return kErrorOk;
+}
+
 /// \}
@@ -49,10 +49,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <kernel/eventk.h>
 
-#ifdef CONFIG_INCLUDE_NMT_MN
+#if (defined(CONFIG_INCLUDE_NMT_MN) || (CONFIG_DLL_FRAME_CAPTURE != FALSE))
 #include <common/circbuffer.h>
 #endif
 
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+#include <common/target.h>
+#endif
+
 #if (defined(CONFIG_INCLUDE_NMT_MN) && (CONFIG_DLLCAL_QUEUE == DIRECT_QUEUE))
 #error "DLLCal module does not support direct calls with PRC MN"
 #endif
@@ -168,6 +172,13 @@ typedef struct
 #endif
 
     tDllkNodeInstance       nodeInstance;           ///< Initialize the node instance
+
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+    tCircBufInstance*       pQueueCapture;                                  ///< Shared memory of the frame capture rings
+    tDllCalCaptureRing*     pCaptureRing;                                   ///< Frame capture rings, one per direction
+    volatile UINT32         aCaptureCycleCount[DLLCAL_CAPTURE_RING_COUNT];  ///< Number of captured SoC frames per direction
+    UINT32                  aCaptureDropCount[DLLCAL_CAPTURE_RING_COUNT];   ///< Number of records dropped since the last written record per direction
+#endif
 } tDllkCalInstance;
 //------------------------------------------------------------------------------
 // local vars
@@ -204,18 +215,23 @@ static void       initNodeInstance(UINT nodeId_p);
 
 This function initializes the kernel DLL CAL module.
 
+\param[in]      pQueueSizes_p       Sizes of the asynchronous Tx queues.
+
 \return The function returns a tOplkError error code.
 
 \ingroup module_dllkcal
 */
 //------------------------------------------------------------------------------
-tOplkError dllkcal_init(void)
+tOplkError dllkcal_init(const tDllCalQueueSizes* pQueueSizes_p)
 {
     tOplkError      ret = kErrorOk;
 #if defined(CONFIG_INCLUDE_NMT_MN)
     tCircBufError   circErr;
 #endif
 
+    // Check parameter validity
+    ASSERT(pQueueSizes_p != NULL);
+
     // reset instance structure
     OPLK_MEMSET(&instance_l, 0, sizeof(instance_l));
 
@@ -229,7 +245,8 @@ tOplkError dllkcal_init(void)
 #endif
 
     ret = instance_l.pTxNmtFuncs->pfnAddInstance(&instance_l.dllCalQueueTxNmt,
-                                                 kDllCalQueueTxNmt);
+                                                 kDllCalQueueTxNmt,
+                                                 pQueueSizes_p->txNmtSize);
     if (ret != kErrorOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s() TxNmt failed\n", __func__);
@@ -237,7 +254,8 @@ tOplkError dllkcal_init(void)
     }
 
     ret = instance_l.pTxGenFuncs->pfnAddInstance(&instance_l.dllCalQueueTxGen,
-                                                 kDllCalQueueTxGen);
+                                                 kDllCalQueueTxGen,
+                                                 pQueueSizes_p->txGenSize);
     if (ret != kErrorOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s() TxGen failed\n", __func__);
@@ -246,7 +264,8 @@ tOplkError dllkcal_init(void)
 
 #if defined(CONFIG_INCLUDE_NMT_MN)
     ret = instance_l.pTxSyncFuncs->pfnAddInstance(&instance_l.dllCalQueueTxSync,
-                                                  kDllCalQueueTxSync);
+                                                  kDllCalQueueTxSync,
+                                                  pQueueSizes_p->txSyncSize);
     if (ret != kErrorOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s() TxSync failed\n", __func__);
@@ -291,13 +310,31 @@ tOplkError dllkcal_init(void)
 
 #if defined(CONFIG_INCLUDE_VETH)
     ret = instance_l.pTxVethFuncs->pfnAddInstance(&instance_l.dllCalQueueTxVeth,
-                                                  kDllCalQueueTxVeth);
+                                                  kDllCalQueueTxVeth,
+                                                  pQueueSizes_p->txVethSize);
     if (ret != kErrorOk)
     {
         goto Exit;
     }
 #endif
 
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+    // The circular buffer only provides the shared memory, the capture rings
+    // are accessed without its lock.
+    if (circbuf_alloc(CIRCBUF_DLLCAL_CAPTURE,
+                      sizeof(tDllCalCaptureRing) * DLLCAL_CAPTURE_RING_COUNT,
+                      &instance_l.pQueueCapture) != kCircBufOk)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Allocate CIRCBUF_DLLCAL_CAPTURE failed\n", __func__);
+        ret = kErrorNoResource;
+        goto Exit;
+    }
+
+    instance_l.pCaptureRing = (tDllCalCaptureRing*)instance_l.pQueueCapture->pCircBuf;
+    OPLK_MEMSET(instance_l.pCaptureRing, 0, sizeof(tDllCalCaptureRing) * DLLCAL_CAPTURE_RING_COUNT);
+    OPLK_DCACHE_FLUSH(instance_l.pCaptureRing, sizeof(tDllCalCaptureRing) * DLLCAL_CAPTURE_RING_COUNT);
+#endif
+
     instance_l.currentTxQueueSelect = kDllkCalTxQueueSelectGen;
 
 Exit:
@@ -333,6 +370,12 @@ tOplkError dllkcal_exit(void)
         circbuf_free(instance_l.pQueueStatusReq);
 #endif
 
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+    instance_l.pCaptureRing = NULL;
+    if (instance_l.pQueueCapture != NULL)
+        circbuf_free(instance_l.pQueueCapture);
+#endif
+
     if (instance_l.pTxNmtFuncs != NULL)
         instance_l.pTxNmtFuncs->pfnDelInstance(instance_l.dllCalQueueTxNmt);
 
@@ -1130,6 +1173,92 @@ tOplkError dllkcal_ackAsyncRequest(UINT nodeId_p, tDllReqServiceId reqServiceId_
 }
 #endif
 
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief Capture a frame
+
+The function writes the header and the first \ref CONFIG_DLL_FRAME_CAPTURE_SNAPLEN
+bytes of a frame into the capture ring of its direction. Received frames are
+captured in the receive context and sent frames in the transmit context. Each
+context only writes its own ring and counters, so the function neither locks
+nor waits for the reader. If the ring is full, the record is dropped and
+counted in the drop count of the next record of the same direction. Captured
+SoC frames increment the cycle count, which is the sum of the counts of both
+directions.
+
+\param[in]      pFrame_p            Pointer to the frame.
+\param[in]      frameSize_p         Size of the frame.
+\param[in]      direction_p         Direction of the frame.
+
+\ingroup module_dllkcal
+*/
+//------------------------------------------------------------------------------
+void dllkcal_captureFrame(const tPlkFrame* pFrame_p,
+                          size_t frameSize_p,
+                          tOplkApiCaptureDirection direction_p)
+{
+    tDllCalCaptureRing*     pRing;
+    tDllCalCaptureRecord*   pSlot;
+    tOplkApiCaptureRecord   header;
+    UINT                    ringIndex;
+    UINT32                  writeIndex;
+    UINT32                  nextIndex;
+    size_t                  captureSize;
+
+    if ((instance_l.pCaptureRing == NULL) || (pFrame_p == NULL))
+        return;
+
+    ringIndex = (direction_p == kOplkApiCaptureTx) ? 1 : 0;
+    pRing = &instance_l.pCaptureRing[ringIndex];
+
+    if ((frameSize_p > offsetof(tPlkFrame, messageType)) &&
+        (ami_getUint16Be(&pFrame_p->etherType) == C_DLL_ETHERTYPE_EPL) &&
+        (ami_getUint8Le(&pFrame_p->messageType) == kMsgTypeSoc))
+    {
+        instance_l.aCaptureCycleCount[ringIndex]++;
+    }
+
+    writeIndex = pRing->writeIndex;
+    nextIndex = writeIndex + 1;
+    if (nextIndex == DLLCAL_CAPTURE_RING_SLOTS)
+        nextIndex = 0;
+
+    OPLK_DCACHE_INVALIDATE(&pRing->readIndex, sizeof(pRing->readIndex));
+    if (nextIndex == pRing->readIndex)
+    {
+        instance_l.aCaptureDropCount[ringIndex]++;
+        return;
+    }
+
+    // Don't overwrite the slot before the reader has released it
+    DLLCAL_CAPTURE_BARRIER();
+
+    captureSize = (frameSize_p > CONFIG_DLL_FRAME_CAPTURE_SNAPLEN) ?
+                  CONFIG_DLL_FRAME_CAPTURE_SNAPLEN : frameSize_p;
+
+    header.timestamp = target_getCurrentTimestamp();
+    header.cycleCount = instance_l.aCaptureCycleCount[0] + instance_l.aCaptureCycleCount[1];
+    header.dropCount = instance_l.aCaptureDropCount[ringIndex];
+    header.frameSize = (UINT16)frameSize_p;
+    header.captureSize = (UINT16)captureSize;
+    header.direction = direction_p;
+    OPLK_MEMSET(header.padding1, 0, sizeof(header.padding1));
+
+    pSlot = &pRing->aSlot[writeIndex];
+    OPLK_MEMCPY(&pSlot->header, &header, sizeof(header));
+    OPLK_MEMCPY(pSlot->aData, pFrame_p, captureSize);
+    OPLK_DCACHE_FLUSH(pSlot, sizeof(header) + captureSize);
+
+    // Publish the record after its contents
+    DLLCAL_CAPTURE_BARRIER();
+    pRing->writeIndex = nextIndex;
+    OPLK_DCACHE_FLUSH(&pRing->writeIndex, sizeof(pRing->writeIndex));
+
+    instance_l.aCaptureDropCount[ringIndex] = 0;
+}
+#endif
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
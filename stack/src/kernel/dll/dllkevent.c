@@ -111,11 +111,20 @@ static tOplkError processNmtEvent(const tEvent* pEvent_p);
 static tOplkError processCycleFinish(tNmtState nmtState_p) SECTION_DLLK_PROCESS_CYCFIN;
 static tOplkError processSync(tNmtState nmtState_p) SECTION_DLLK_PROCESS_SYNC;
 static tOplkError processSyncCn(tNmtState nmtState_p, BOOL fReadyFlag_p) SECTION_DLLK_PROCESS_SYNC;
+#if (CONFIG_DLL_PRES_LATE_DATA != FALSE)
+static tOplkError processPresReady(tNmtState nmtState_p);
+#endif
+#if (CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES != 0)
+static tOplkError reportPresResponseTime(void);
+#endif
 #if defined(CONFIG_INCLUDE_NMT_MN)
 static tOplkError processSyncMn(tNmtState nmtState_p, BOOL fReadyFlag_p) SECTION_DLLK_PROCESS_SYNC;
 static tOplkError processStartReducedCycle(void);
 #endif
 static tOplkError processFillTx(tDllAsyncReqPriority asyncReqPriority_p, tNmtState nmtState_p);
+static tOplkError processFillTxEvent(const tEvent* pEvent_p);
+static tOplkError processCycleFinishEvent(const tEvent* pEvent_p) SECTION_DLLK_PROCESS_CYCFIN;
+static tOplkError processSyncEvent(const tEvent* pEvent_p) SECTION_DLLK_PROCESS_SYNC;
 
 #if (defined(CONFIG_INCLUDE_NMT_MN) && defined(CONFIG_INCLUDE_PRES_FORWARD))
 // Request forwarding of Pres frames (for conformance test)
@@ -183,6 +192,12 @@ tOplkError dllk_process(const tEvent* pEvent_p)
             ret = processSync(dllkInstance_g.nmtState);
             break;
 
+#if (CONFIG_DLL_PRES_LATE_DATA != FALSE)
+        case kEventTypeDllkPresReady:
+            ret = processPresReady(dllkInstance_g.nmtState);
+            break;
+#endif
+
 #if defined(CONFIG_INCLUDE_NMT_MN)
         case kEventTypeDllkStartReducedCycle:
             ret = processStartReducedCycle();
@@ -210,6 +225,44 @@ tOplkError dllk_process(const tEvent* pEvent_p)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Register the event type handlers of the DLL
+
+The function registers the handlers of the frequent DLL events in the kernel
+event module, so that they are dispatched without the event type switch of
+\ref dllk_process. The per-cycle events are registered for the fast lane.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+tOplkError dllk_regEventHandlers(void)
+{
+    tOplkError  ret;
+
+    ret = eventk_registerEventHandler(kEventSinkDllk,
+                                      kEventTypeDllkCycleFinish,
+                                      processCycleFinishEvent,
+                                      TRUE);
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = eventk_registerEventHandler(kEventSinkDllk,
+                                      kEventTypeSync,
+                                      processSyncEvent,
+                                      TRUE);
+    if (ret != kErrorOk)
+        return ret;
+
+    // Fill Tx events are processed in the background
+    ret = eventk_registerEventHandler(kEventSinkDllk,
+                                      kEventTypeDllkFillTx,
+                                      processFillTxEvent,
+                                      FALSE);
+
+    return ret;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -880,6 +933,59 @@ Exit:
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Process fill Tx event
+
+The function is the event type handler of the fill Tx event.
+
+\param[in]      pEvent_p            Pointer to the fill Tx event.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError processFillTxEvent(const tEvent* pEvent_p)
+{
+    return processFillTx(*((const tDllAsyncReqPriority*)pEvent_p->eventArg.pEventArg),
+                         dllkInstance_g.nmtState);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process cycle finish event type
+
+The function is the event type handler of the cycle finish event.
+
+\param[in]      pEvent_p            Pointer to the cycle finish event.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError processCycleFinishEvent(const tEvent* pEvent_p)
+{
+    UNUSED_PARAMETER(pEvent_p);
+
+    return processCycleFinish(dllkInstance_g.nmtState);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process sync event type
+
+The function is the event type handler of the sync event.
+
+\param[in]      pEvent_p            Pointer to the sync event.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError processSyncEvent(const tEvent* pEvent_p)
+{
+    UNUSED_PARAMETER(pEvent_p);
+
+    return processSync(dllkInstance_g.nmtState);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Process cycle finish event
@@ -1003,11 +1109,132 @@ static tOplkError processSyncCn(tNmtState nmtState_p, BOOL fReadyFlag_p)
 
         // switch to next cycle
         dllkInstance_g.curTxBufferOffsetCycle = (UINT8)nextTxBufferOffset;
+#if (CONFIG_DLL_PRES_LATE_DATA != FALSE)
+        // publish the new PRes to the receive path and clear the sent flag
+        DLLK_PRES_STATE_SET(&dllkInstance_g.presState, (UINT8)nextTxBufferOffset);
+#endif
     }
 
+#if (CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES != 0)
+    // report early if the sum could overflow within the next cycles
+    if ((dllkInstance_g.presResponseTime.sampleCount >= CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES) ||
+        (dllkInstance_g.presResponseTimeSum >= 0x80000000UL))
+        ret = reportPresResponseTime();
+#endif
+
     return ret;
 }
 
+#if (CONFIG_DLL_PRES_LATE_DATA != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Process PRes ready event on CN
+
+The function processes the PRes ready event which is posted by the user PDO
+module after the application has published new TPDO data. It rebuilds the
+PRes frame in the currently unused Tx buffer with the new TPDO data. If the
+PRes of the current cycle has not been claimed by the receive path yet, the
+rebuilt frame replaces the prepared one, so the next PReq is answered with the
+latest data without assembling the frame in the receive path. The test of the
+sent flag and the exchange are one atomic operation on the PRes state word.
+
+\param[in]      nmtState_p          NMT state of the node.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError processPresReady(tNmtState nmtState_p)
+{
+    tOplkError      ret = kErrorOk;
+    tPlkFrame*      pTxFrame;
+    tEdrvTxBuffer*  pTxBuffer;
+    tFrameInfo      frameInfo;
+    BOOL            fReadyFlag;
+    UINT8           presState = dllkInstance_g.presState;
+    UINT            nextTxBufferOffset = (presState & DLLK_PRES_STATE_BUFFER) ^ 1;
+
+    if ((nmtState_p != kNmtCsReadyToOperate) && (nmtState_p != kNmtCsOperational))
+        return kErrorOk;
+
+    if ((presState & DLLK_PRES_STATE_SENT) != 0)
+    {   // too late for this cycle, the next sync prepares a new PRes anyway
+        dllkInstance_g.presLateMissCount++;
+        return kErrorOk;
+    }
+
+    pTxBuffer = &dllkInstance_g.pTxBuffer[DLLK_TXFRAME_PRES + nextTxBufferOffset];
+    if (pTxBuffer->pBuffer == NULL)
+        return kErrorOk;
+
+    // keep the ready flag of the prepared PRes, it is only changed on sync
+    pTxFrame = (tPlkFrame*)dllkInstance_g.pTxBuffer[DLLK_TXFRAME_PRES + (presState & DLLK_PRES_STATE_BUFFER)].pBuffer;
+    fReadyFlag = ((ami_getUint8Le(&pTxFrame->data.pres.flag1) & PLK_FRAME_FLAG1_RD) != 0);
+
+    frameInfo.frame.pBuffer = (tPlkFrame*)pTxBuffer->pBuffer;
+    frameInfo.frameSize = (UINT)pTxBuffer->txFrameSize;
+    ret = dllkframe_processTpdo(&frameInfo, fReadyFlag);
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = dllkframe_updateFramePres(pTxBuffer, nmtState_p);
+    if (ret != kErrorOk)
+        return ret;
+
+    // exchange the PRes only if it is still pending, the receive path may
+    // have claimed it meanwhile
+    if (DLLK_PRES_STATE_EXCHANGE(&dllkInstance_g.presState, presState, (UINT8)nextTxBufferOffset))
+    {
+        dllkInstance_g.curTxBufferOffsetCycle = (UINT8)nextTxBufferOffset;
+        dllkInstance_g.presLateDataCount++;
+    }
+    else
+    {   // too late for this cycle, the next sync prepares a new PRes anyway
+        dllkInstance_g.presLateMissCount++;
+    }
+
+    return ret;
+}
+#endif
+
+#if (CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES != 0)
+//------------------------------------------------------------------------------
+/**
+\brief  Report PRes response time
+
+The function posts the PRes response time statistics of the current report
+interval to the API layer and starts a new report interval.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError reportPresResponseTime(void)
+{
+    tOplkError                  ret;
+    tDllEventPresResponseTime*  pStat = &dllkInstance_g.presResponseTime;
+    tEvent                      event;
+
+    pStat->meanResponseTime = dllkInstance_g.presResponseTimeSum / pStat->sampleCount;
+#if (CONFIG_DLL_PRES_LATE_DATA != FALSE)
+    pStat->lateDataCount = dllkInstance_g.presLateDataCount;
+    pStat->lateMissCount = dllkInstance_g.presLateMissCount;
+#endif
+
+    event.eventSink = kEventSinkApi;
+    event.eventType = kEventTypePresResponseTime;
+    event.eventArg.pEventArg = pStat;
+    event.eventArgSize = sizeof(*pStat);
+    ret = eventk_postEvent(&event);
+
+    // start new report interval, the peak value is kept
+    pStat->sampleCount = 0;
+    pStat->minResponseTime = 0;
+    pStat->maxResponseTime = 0;
+    dllkInstance_g.presResponseTimeSum = 0;
+
+    return ret;
+}
+#endif
+
 #if defined(CONFIG_INCLUDE_NMT_MN)
 //------------------------------------------------------------------------------
 /**
@@ -1156,6 +1383,9 @@ static tOplkError processStartReducedCycle(void)
 
     dllkInstance_g.curLastSoaReq = 0;
     dllkInstance_g.curTxBufferOffsetCycle = 0;
+#if (CONFIG_DLL_PRES_LATE_DATA != FALSE)
+    dllkInstance_g.presState = 0;
+#endif
 
 Exit:
     return ret;
@@ -64,6 +64,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/timesynck.h>
 
 #include <common/ami.h>
+#include <common/target.h>
 #include <oplk/benchmark.h>
 
 #include "dllk-internal.h"
@@ -72,6 +73,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/timestamp.h>
 #endif
 
+#if (CONFIG_EDRV_BUSY_POLL != FALSE)
+#include <kernel/edrvbusypoll.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -150,6 +155,9 @@ static void       handleErrorSignaling(const tPlkFrame* pFrame_p, UINT nodeId_p)
 #if (CONFIG_TIMER_USE_HIGHRES != FALSE)
 static tOplkError cbCnTimer(const tTimerEventArg* pEventArg_p);
 #endif
+#if (CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES != 0)
+static void       addPresResponseTime(UINT32 responseTime_p);
+#endif
 
 #if (CONFIG_EDRV_AUTO_RESPONSE != FALSE)
 static tOplkError enableRxFilter(UINT filterEntry_p, BOOL fEnable_p);
@@ -203,6 +211,10 @@ tEdrvReleaseRxBuffer dllkframe_processFrameReceived(tEdrvRxBuffer* pRxBuffer_p)
     frameInfo.frame.pBuffer = pFrame;
     frameInfo.frameSize = (UINT)pRxBuffer_p->rxFrameSize;
 
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+    dllkcal_captureFrame(pFrame, pRxBuffer_p->rxFrameSize, kOplkApiCaptureRx);
+#endif
+
     if (ami_getUint16Be(&pFrame->etherType) != C_DLL_ETHERTYPE_EPL)
     {   // non-POWERLINK frame
         DEBUG_LVL_DLL_TRACE("%s(): pfnCbAsync=0x%p SrcMAC=0x%llx\n",
@@ -1737,15 +1749,32 @@ static tOplkError processReceivedPreq(tFrameInfo* pFrameInfo_p,
 
 #if (CONFIG_EDRV_AUTO_RESPONSE == FALSE)
         tEdrvTxBuffer*  pTxBuffer = NULL;
+#if (CONFIG_DLL_PRES_LATE_DATA != FALSE)
+        UINT8           presState;
+#endif
+#if (CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES != 0)
+        ULONGLONG       preqTimeStamp = target_getCurrentTimestamp();
+#endif
 
         // Auto-response is disabled
         // Does PRes exist?
+#if (CONFIG_DLL_PRES_LATE_DATA != FALSE)
+        // claim the prepared PRes before sending it, so that it is not
+        // exchanged by processPresReady() anymore in this cycle
+        presState = DLLK_PRES_STATE_CLAIM(&dllkInstance_g.presState);
+        pTxBuffer = &dllkInstance_g.pTxBuffer[DLLK_TXFRAME_PRES + (presState & DLLK_PRES_STATE_BUFFER)];
+#else
         pTxBuffer = &dllkInstance_g.pTxBuffer[DLLK_TXFRAME_PRES + dllkInstance_g.curTxBufferOffsetCycle];
+#endif
         if (pTxBuffer->pBuffer != NULL)
         {   // PRes does exist -> send PRes frame
             ret = edrv_sendTxBuffer(pTxBuffer);
             if (ret != kErrorOk)
                 goto Exit;
+
+#if (CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES != 0)
+            addPresResponseTime((UINT32)(target_getCurrentTimestamp() - preqTimeStamp));
+#endif
         }
 #endif
 
@@ -2077,6 +2106,10 @@ static tOplkError processReceivedSoc(const tEdrvRxBuffer* pRxBuffer_p,
         return ret;
     }
 
+#if (CONFIG_EDRV_BUSY_POLL != FALSE)
+    edrvbusypoll_signalSoc();
+#endif
+
     pFrame = (const tPlkFrame*)pRxBuffer_p->pBuffer;
 
     if (nmtState_p >= kNmtCsStopped)
@@ -2259,6 +2292,10 @@ static tOplkError processReceivedSoa(const tEdrvRxBuffer* pRxBuffer_p,
         goto Exit;
     }
 
+#if (CONFIG_EDRV_BUSY_POLL != FALSE)
+    edrvbusypoll_signalSoa();
+#endif
+
     // check TargetNodeId
     nodeId = ami_getUint8Le(&pFrame->data.soa.reqServiceTarget);
     if (nodeId == dllkInstance_g.dllConfigParam.nodeId)
@@ -3119,6 +3156,37 @@ Exit:
 }
 #endif
 
+#if (CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES != 0)
+//------------------------------------------------------------------------------
+/**
+\brief  Add PRes response time sample
+
+The function adds the response time of a sent PRes frame to the statistics of
+the current report interval. The statistics are reported on the next sync
+event after CONFIG_DLL_PRES_RESPONSE_TIME_CYCLES samples.
+
+\param[in]      responseTime_p      Time from processing the PReq to sending the
+                                    PRes in ns.
+*/
+//------------------------------------------------------------------------------
+static void addPresResponseTime(UINT32 responseTime_p)
+{
+    tDllEventPresResponseTime*  pStat = &dllkInstance_g.presResponseTime;
+
+    if ((pStat->sampleCount == 0) || (responseTime_p < pStat->minResponseTime))
+        pStat->minResponseTime = responseTime_p;
+
+    if (responseTime_p > pStat->maxResponseTime)
+        pStat->maxResponseTime = responseTime_p;
+
+    if (responseTime_p > pStat->peakResponseTime)
+        pStat->peakResponseTime = responseTime_p;
+
+    dllkInstance_g.presResponseTimeSum += responseTime_p;
+    pStat->sampleCount++;
+}
+#endif
+
 #if (CONFIG_EDRV_AUTO_RESPONSE != FALSE)
 //------------------------------------------------------------------------------
 /**
@@ -108,6 +108,9 @@ static tOplkError setupLocalNodeCn(void);
 #if defined(CONFIG_INCLUDE_NMT_MN)
 static tOplkError setupLocalNodeMn(void);
 static tOplkError cbMnSyncHandler(void) SECTION_DLLK_MN_SYNC_CB;
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+static void       cbMnTxHandler(const tEdrvTxBuffer* pTxBuffer_p);
+#endif
 #endif
 
 //------------------------------------------------------------------------------
@@ -180,6 +183,12 @@ tOplkError dllknode_cleanupLocalNode(tNmtState oldNmtState_p)
     ret = edrvcyclic_regSyncHandler(NULL);
     if (ret != kErrorOk)
         return ret;
+
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+    ret = edrvcyclic_regTxHandler(NULL);
+    if (ret != kErrorOk)
+        return ret;
+#endif
 #endif
 
 #if (CONFIG_DLL_PROCESS_SYNC == DLL_PROCESS_SYNC_ON_TIMER)
@@ -1278,6 +1287,12 @@ static tOplkError setupLocalNodeMn(void)
     if (ret != kErrorOk)
         return ret;
 
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+    ret = edrvcyclic_regTxHandler(cbMnTxHandler);
+    if (ret != kErrorOk)
+        return ret;
+#endif
+
     dllkfilter_setupPresFilter(&dllkInstance_g.aFilter[DLLK_FILTER_PRES], TRUE);
 
     return ret;
@@ -1343,6 +1358,25 @@ Exit:
     return ret;
 }
 
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  MN Tx callback function
+
+This function is called by the cyclic Ethernet driver for every sent frame of
+the cycle. It writes the frame into the capture ring.
+
+\param[in]      pTxBuffer_p         Pointer to the sent Tx buffer.
+*/
+//------------------------------------------------------------------------------
+static void cbMnTxHandler(const tEdrvTxBuffer* pTxBuffer_p)
+{
+    dllkcal_captureFrame((const tPlkFrame*)pTxBuffer_p->pBuffer,
+                         pTxBuffer_p->txFrameSize,
+                         kOplkApiCaptureTx);
+}
+#endif
+
 #endif
 
 /// \}
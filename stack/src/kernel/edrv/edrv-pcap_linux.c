@@ -43,6 +43,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/oplkinc.h>
 #include <common/ftracedebug.h>
 #include <kernel/edrv.h>
+#include <kernel/edrvbusypoll.h>
+#include <kernel/edrvsockfilter.h>
+#include <common/targetthread.h>
 
 #include <unistd.h>
 #include <pcap.h>
@@ -80,6 +83,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // const defines
 //------------------------------------------------------------------------------
 #define EDRV_MAX_FRAME_SIZE     0x0600
+#ifndef SO_BUSY_POLL
+#define SO_BUSY_POLL            46
+#endif
 
 //------------------------------------------------------------------------------
 // local types
@@ -99,6 +105,8 @@ typedef struct
     pcap_t*             pPcap;                              ///< Pointer to the pcap interface instance
     pcap_t*             pPcapThread;                        ///< Handle of the pcap packet handler thread
     pthread_t           hThread;                            ///< Handle of the worker thread
+    tEdrvSockFilter     sockFilter;                         ///< Socket filter built from the Rx filters
+    tEdrvBusyPoll       busyPoll;                           ///< Busy-poll state and receive statistics
 } tEdrvInstance;
 
 //------------------------------------------------------------------------------
@@ -111,6 +119,7 @@ static tEdrvInstance edrvInstance_l;
 //------------------------------------------------------------------------------
 static void     packetHandler(u_char* pParam_p, const struct pcap_pkthdr* pHeader_p, const u_char* pPktData_p);
 static void*    workerThread(void* pArgument_p);
+static int      receiveBusyPoll(tEdrvInstance* pInstance_p);
 static void     getMacAdrs(const char* pIfName_p, UINT8* pMacAddr_p);
 static pcap_t*  startPcap(void);
 static BOOL     getLinkStatus(const char* pIfName_p);
@@ -134,7 +143,6 @@ This function initializes the Ethernet driver.
 //------------------------------------------------------------------------------
 tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
 {
-    struct sched_param  schedParam;
 
     // Check parameter validity
     ASSERT(pEdrvInitParam_p != NULL);
@@ -187,6 +195,8 @@ tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
         return kErrorEdrvInit;
     }
 
+    edrvbusypoll_init(&edrvInstance_l.busyPoll, target_isThreadBusyPoll(kOplkApiThreadEdrv));
+
     if (pthread_create(&edrvInstance_l.hThread, NULL,
                        workerThread,  &edrvInstance_l) != 0)
     {
@@ -194,19 +204,18 @@ tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
         return kErrorEdrvInit;
     }
 
-    schedParam.sched_priority = CONFIG_THREAD_PRIORITY_MEDIUM;
-    if (pthread_setschedparam(edrvInstance_l.hThread, SCHED_FIFO, &schedParam) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n", __func__);
-    }
-
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(edrvInstance_l.hThread, "oplk-edrvpcap");
-#endif
+    target_registerThread(edrvInstance_l.hThread,
+                          kOplkApiThreadEdrv,
+                          "oplk-edrvpcap",
+                          CONFIG_THREAD_PRIORITY_MEDIUM);
 
     /* wait until thread is started */
     sem_wait(&edrvInstance_l.syncSem);
 
+    // The Rx filters are attached to the capture handle of the worker thread
+    edrvsockfilter_init(&edrvInstance_l.sockFilter,
+                        pcap_get_selectable_fd(edrvInstance_l.pPcapThread));
+
     return kErrorOk;
 }
 
@@ -223,11 +232,16 @@ This function shuts down the Ethernet driver.
 //------------------------------------------------------------------------------
 tOplkError edrv_exit(void)
 {
+    edrvsockfilter_exit(&edrvInstance_l.sockFilter);
+
     // End the pcap loop and wait for the worker thread to terminate
     pcap_breakloop(edrvInstance_l.pPcapThread);
+    target_unregisterThread(edrvInstance_l.hThread);
     pthread_cancel(edrvInstance_l.hThread);
     pthread_join(edrvInstance_l.hThread, NULL);
 
+    edrvbusypoll_printStatistics(&edrvInstance_l.busyPoll, "edrv-pcap");
+
     // Close pcap instance
     pcap_close(edrvInstance_l.pPcap);
 
@@ -388,7 +402,9 @@ selects the Rx filter entry that shall be changed and \p changeFlags_p determine
 the property.
 If \p entryChanged_p is equal or larger count_p all Rx filters shall be changed.
 
-\note Rx filters are not supported by this driver!
+The Rx filters are compiled into a socket filter, so that frames which aren't
+needed by the DLL are dropped in the kernel. Auto-response is not supported by
+this driver.
 
 \param[in,out]  pFilter_p           Base pointer of Rx filter array
 \param[in]      count_p             Number of Rx filter array entries
@@ -405,12 +421,13 @@ tOplkError edrv_changeRxFilter(tEdrvFilter* pFilter_p,
                                UINT entryChanged_p,
                                UINT changeFlags_p)
 {
-    UNUSED_PARAMETER(pFilter_p);
-    UNUSED_PARAMETER(count_p);
     UNUSED_PARAMETER(entryChanged_p);
     UNUSED_PARAMETER(changeFlags_p);
 
-    return kErrorOk;
+    return edrvsockfilter_update(&edrvInstance_l.sockFilter,
+                                 pFilter_p,
+                                 count_p,
+                                 edrvInstance_l.initParam.aMacAddr);
 }
 
 //------------------------------------------------------------------------------
@@ -457,6 +474,28 @@ tOplkError edrv_setRxMulticastMacAddr(const UINT8* pMacAddr_p)
     return kErrorOk;
 }
 
+#if (CONFIG_EDRV_USE_DIAGNOSTICS != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Get Edrv module diagnostics
+
+This function returns the receive latency and busy-poll statistics of the Edrv
+to a provided buffer.
+
+\param[out]     pBuffer_p           Pointer to buffer filled with diagnostics.
+\param[in]      size_p              Size of buffer
+
+\return The function returns the size of the diagnostics information.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+int edrv_getDiagnostics(char* pBuffer_p, size_t size_p)
+{
+    return edrvbusypoll_getDiagnostics(&edrvInstance_l.busyPoll, pBuffer_p, size_p);
+}
+#endif
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -480,6 +519,11 @@ static void packetHandler(u_char* pParam_p,
 {
     tEdrvInstance*  pInstance = (tEdrvInstance*)pParam_p;
     tEdrvRxBuffer   rxBuffer;
+    struct timespec rxTimeStamp;
+
+    rxTimeStamp.tv_sec = pHeader_p->ts.tv_sec;
+    rxTimeStamp.tv_nsec = pHeader_p->ts.tv_usec * 1000;
+    edrvbusypoll_processFrame(&pInstance->busyPoll, &rxTimeStamp);
 
     if (OPLK_MEMCMP(pPktData_p + 6, pInstance->initParam.aMacAddr, 6) != 0)
     {   // filter out self generated traffic
@@ -588,7 +632,10 @@ static void* workerThread(void* pArgument_p)
    // signal that thread is successfully started
    sem_post(&pInstance->syncSem);
 
-   pcapRet = pcap_loop(pInstance->pPcapThread, -1, packetHandler, (u_char*)pInstance);
+   if (pInstance->busyPoll.fEnabled)
+       pcapRet = receiveBusyPoll(pInstance);
+   else
+       pcapRet = pcap_loop(pInstance->pPcapThread, -1, packetHandler, (u_char*)pInstance);
 
    switch (pcapRet)
    {
@@ -612,6 +659,51 @@ static void* workerThread(void* pArgument_p)
    return NULL;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Receive frames in busy-poll mode
+
+The function switches the pcap handle of the worker thread to non-blocking mode
+and dispatches the received frames until the loop is broken. Between the
+isochronous phases it waits for frames in the kernel.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+
+\return The function returns the pcap_dispatch() error code which ended the
+        loop.
+*/
+//------------------------------------------------------------------------------
+static int receiveBusyPoll(tEdrvInstance* pInstance_p)
+{
+    char    errorMessage[PCAP_ERRBUF_SIZE];
+    int     sockBusyPoll = CONFIG_EDRV_BUSY_POLL_GUARD_US;
+    int     fd;
+    int     pcapRet;
+
+    fd = pcap_get_selectable_fd(pInstance_p->pPcapThread);
+    if ((fd < 0) || (pcap_setnonblock(pInstance_p->pPcapThread, 1, errorMessage) < 0))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't switch to non-blocking mode, busy-poll disabled\n", __func__);
+        pInstance_p->busyPoll.fEnabled = FALSE;
+        return pcap_loop(pInstance_p->pPcapThread, -1, packetHandler, (u_char*)pInstance_p);
+    }
+
+    // Let the network driver poll the device queue for the non-blocking reads
+    if (setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &sockBusyPoll, sizeof(sockBusyPoll)) != 0)
+    {
+        DEBUG_LVL_EDRV_TRACE("%s() Couldn't set SO_BUSY_POLL socket option\n", __func__);
+    }
+    DEBUG_LVL_EDRV_TRACE("Busy-poll receive mode is enabled\n");
+
+    do
+    {
+        edrvbusypoll_waitForFrame(&pInstance_p->busyPoll, fd);
+        pcapRet = pcap_dispatch(pInstance_p->pPcapThread, -1, packetHandler, (u_char*)pInstance_p);
+    } while (pcapRet >= 0);
+
+    return pcapRet;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Start pcap live capture handle
@@ -43,6 +43,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/oplkinc.h>
 #include <common/ftracedebug.h>
 #include <kernel/edrv.h>
+#include <kernel/edrvbusypoll.h>
+#include <kernel/edrvsockfilter.h>
+#include <common/targetthread.h>
 
 #include <unistd.h>
 #include <string.h>
@@ -59,6 +62,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <arpa/inet.h>
 #include <ifaddrs.h>
 #include <linux/if_packet.h>
+#include <stddef.h>
 #include <sys/types.h>
 
 //============================================================================//
@@ -89,6 +93,19 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef PACKET_QDISC_BYPASS
 #define PACKET_QDISC_BYPASS     20
 #endif
+#ifndef SO_BUSY_POLL
+#define SO_BUSY_POLL            46
+#endif
+
+#if ((CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE) || (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_ASYNC != FALSE))
+#define EDRV_DEFERRED_RX_RELEASE    TRUE
+#else
+#define EDRV_DEFERRED_RX_RELEASE    FALSE
+#endif
+
+#ifndef EDRV_MAX_RX_BUFFERS
+#define EDRV_MAX_RX_BUFFERS     256     // max no. of Rx buffers which can be held by the stack
+#endif
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
@@ -106,8 +123,16 @@ typedef struct
     sem_t               syncSem;                         ///< Semaphore for signaling the start of the worker thread
     int                 sock;                            ///< Raw socket handle
     pthread_t           hThread;                         ///< Handle of the worker thread
-    BOOL                fStartCommunication;             ///< Flag to indicate, that communication is started. Set to false on exit
-    BOOL                fThreadIsExited;                 ///< Set by thread if already exited
+    volatile BOOL       fStartCommunication;             ///< Flag to indicate, that communication is started. Set to false on exit
+    volatile BOOL       fThreadIsExited;                 ///< Set by thread if already exited
+    tEdrvSockFilter     sockFilter;                      ///< Socket filter built from the Rx filters
+    tEdrvBusyPoll       busyPoll;                        ///< Busy-poll state and receive statistics
+#if (EDRV_DEFERRED_RX_RELEASE != FALSE)
+    UINT                rxBufferIndex;                   ///< Index of the next Rx buffer to be checked
+    UINT32              rxBufferOverrunCount;            ///< Number of frames dropped because all Rx buffers were held
+    volatile BOOL       afRxBufferUsed[EDRV_MAX_RX_BUFFERS]; ///< Flags determine if an Rx buffer is held by the stack
+    u_char              aRxBuffer[EDRV_MAX_RX_BUFFERS][EDRV_MAX_FRAME_SIZE]; ///< Rx buffers
+#endif
 } tEdrvInstance;
 
 //------------------------------------------------------------------------------
@@ -118,10 +143,14 @@ static tEdrvInstance edrvInstance_l;
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
-static void     packetHandler(void* pParam_p,
-                              const int frameSize_p,
-                              void* pPktData_p);
+static tEdrvReleaseRxBuffer packetHandler(void* pParam_p,
+                                          const int frameSize_p,
+                                          void* pPktData_p);
 static void*    workerThread(void* pArgument_p);
+#if (EDRV_DEFERRED_RX_RELEASE != FALSE)
+static u_char*  getRxBuffer(tEdrvInstance* pInstance_p, UINT* pIndex_p);
+#endif
+static const struct timespec* getRxTimeStamp(struct msghdr* pMsg_p);
 static void     getMacAdrs(const char* pIfName_p, UINT8* pMacAddr_p);
 static BOOL     getLinkStatus(const char* pIfName_p);
 
@@ -144,9 +173,10 @@ This function initializes the Ethernet driver.
 //------------------------------------------------------------------------------
 tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
 {
-    struct sched_param  schedParam;
     int                 result = 0;
     int                 sock_qdisc_bypass = 1;
+    int                 sockTimestamp = 1;
+    int                 sockBusyPoll = CONFIG_EDRV_BUSY_POLL_GUARD_US;
     struct sockaddr_ll  sock_addr;
     struct ifreq        ifr;
     int                 blockingMode = 0;
@@ -207,6 +237,23 @@ tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
         DEBUG_LVL_EDRV_TRACE("Kernel qdisc bypass is enabled\n");
     }
 
+    // Request the kernel receive time stamps for the receive latency statistics
+    if (setsockopt(edrvInstance_l.sock, SOL_SOCKET, SO_TIMESTAMPNS, &sockTimestamp, sizeof(sockTimestamp)) != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't set SO_TIMESTAMPNS socket option. Error = %s\n", __func__, strerror(errno));
+    }
+
+    edrvbusypoll_init(&edrvInstance_l.busyPoll, target_isThreadBusyPoll(kOplkApiThreadEdrv));
+    if (edrvInstance_l.busyPoll.fEnabled)
+    {
+        // Let the network driver poll the device queue for the non-blocking reads
+        if (setsockopt(edrvInstance_l.sock, SOL_SOCKET, SO_BUSY_POLL, &sockBusyPoll, sizeof(sockBusyPoll)) != 0)
+        {
+            DEBUG_LVL_EDRV_TRACE("%s() Couldn't set SO_BUSY_POLL socket option. Error = %s\n", __func__, strerror(errno));
+        }
+        DEBUG_LVL_EDRV_TRACE("Busy-poll receive mode is enabled\n");
+    }
+
     OPLK_MEMSET(&ifr, 0, sizeof(struct ifreq));
     strncpy(ifr.ifr_name, edrvInstance_l.initParam.pDevName, IFNAMSIZ - 1);
 
@@ -245,6 +292,8 @@ tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
         return kErrorEdrvInit;
     }
 
+    edrvsockfilter_init(&edrvInstance_l.sockFilter, edrvInstance_l.sock);
+
     if (sem_init(&edrvInstance_l.syncSem, 0, 0) != 0)
     {
         DEBUG_LVL_ERROR_TRACE("%s() couldn't init semaphore\n", __func__);
@@ -258,15 +307,10 @@ tOplkError edrv_init(const tEdrvInitParam* pEdrvInitParam_p)
         return kErrorEdrvInit;
     }
 
-    schedParam.sched_priority = CONFIG_THREAD_PRIORITY_MEDIUM;
-    if (pthread_setschedparam(edrvInstance_l.hThread, SCHED_FIFO, &schedParam) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n", __func__);
-    }
-
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(edrvInstance_l.hThread, "oplk-edrvrawsock");
-#endif
+    target_registerThread(edrvInstance_l.hThread,
+                          kOplkApiThreadEdrv,
+                          "oplk-edrvrawsock",
+                          CONFIG_THREAD_PRIORITY_MEDIUM);
 
     // wait until thread is started
     sem_wait(&edrvInstance_l.syncSem);
@@ -287,7 +331,9 @@ This function shuts down the Ethernet driver.
 //------------------------------------------------------------------------------
 tOplkError edrv_exit(void)
 {
-    edrvInstance_l.fStartCommunication = FALSE;
+    // the worker thread reads the flag in every iteration of its busy-poll loop
+    __sync_lock_release(&edrvInstance_l.fStartCommunication);
+    target_unregisterThread(edrvInstance_l.hThread);
 
     // Wait to terminate thread safely
     usleep(100000);
@@ -295,9 +341,20 @@ tOplkError edrv_exit(void)
     if (edrvInstance_l.fThreadIsExited)
         pthread_cancel(edrvInstance_l.hThread);
 
+    edrvbusypoll_printStatistics(&edrvInstance_l.busyPoll, "edrv-rawsock");
+#if (EDRV_DEFERRED_RX_RELEASE != FALSE)
+    if (edrvInstance_l.rxBufferOverrunCount != 0)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() %u frames were dropped because all Rx buffers were held\n",
+                              __func__,
+                              edrvInstance_l.rxBufferOverrunCount);
+    }
+#endif
+
     pthread_mutex_destroy(&edrvInstance_l.mutex);
 
     // Close the socket
+    edrvsockfilter_exit(&edrvInstance_l.sockFilter);
     close(edrvInstance_l.sock);
 
     // Clear instance structure
@@ -456,7 +513,9 @@ selects the Rx filter entry that shall be changed and \p changeFlags_p determine
 the property.
 If \p entryChanged_p is equal or larger count_p all Rx filters shall be changed.
 
-\note Rx filters are not supported by this driver!
+The Rx filters are compiled into a socket filter, so that frames which aren't
+needed by the DLL are dropped in the kernel. Auto-response is not supported by
+this driver.
 
 \param[in,out]  pFilter_p           Base pointer of Rx filter array
 \param[in]      count_p             Number of Rx filter array entries
@@ -473,12 +532,13 @@ tOplkError edrv_changeRxFilter(tEdrvFilter* pFilter_p,
                                UINT entryChanged_p,
                                UINT changeFlags_p)
 {
-    UNUSED_PARAMETER(pFilter_p);
-    UNUSED_PARAMETER(count_p);
     UNUSED_PARAMETER(entryChanged_p);
     UNUSED_PARAMETER(changeFlags_p);
 
-    return kErrorOk;
+    return edrvsockfilter_update(&edrvInstance_l.sockFilter,
+                                 pFilter_p,
+                                 count_p,
+                                 edrvInstance_l.initParam.aMacAddr);
 }
 
 //------------------------------------------------------------------------------
@@ -525,6 +585,62 @@ tOplkError edrv_setRxMulticastMacAddr(const UINT8* pMacAddr_p)
     return kErrorOk;
 }
 
+#if (EDRV_DEFERRED_RX_RELEASE != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Release Rx buffer
+
+This function releases an Rx buffer which was held by the stack. It can be
+called from any thread.
+
+\param[in,out]  pRxBuffer_p         Rx buffer to be released
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrv_releaseRxBuffer(tEdrvRxBuffer* pRxBuffer_p)
+{
+    ptrdiff_t   offset;
+    UINT        index;
+
+    // Check parameter validity
+    ASSERT(pRxBuffer_p != NULL);
+
+    offset = (u_char*)pRxBuffer_p->pBuffer - &edrvInstance_l.aRxBuffer[0][0];
+    if ((offset < 0) || ((size_t)offset >= sizeof(edrvInstance_l.aRxBuffer)))
+        return kErrorEdrvInvalidRxBuf;
+
+    index = (UINT)(offset / EDRV_MAX_FRAME_SIZE);
+    __sync_lock_release(&edrvInstance_l.afRxBufferUsed[index]);
+
+    return kErrorOk;
+}
+#endif
+
+#if (CONFIG_EDRV_USE_DIAGNOSTICS != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Get Edrv module diagnostics
+
+This function returns the receive latency and busy-poll statistics of the Edrv
+to a provided buffer.
+
+\param[out]     pBuffer_p           Pointer to buffer filled with diagnostics.
+\param[in]      size_p              Size of buffer
+
+\return The function returns the size of the diagnostics information.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+int edrv_getDiagnostics(char* pBuffer_p, size_t size_p)
+{
+    return edrvbusypoll_getDiagnostics(&edrvInstance_l.busyPoll, pBuffer_p, size_p);
+}
+#endif
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -540,14 +656,17 @@ This function is the packet handler forwarding the frames to the dllk.
 \param[in,out]  pParam_p            User specific pointer pointing to the instance structure
 \param[in]      frameSize_p         Framesize information
 \param[in]      pPktData_p          Packet buffer
+
+\return The function returns if the packet buffer is held by the stack.
 */
 //------------------------------------------------------------------------------
-static void packetHandler(void* pParam_p,
-                          const int frameSize_p,
-                          void* pPktData_p)
+static tEdrvReleaseRxBuffer packetHandler(void* pParam_p,
+                                          const int frameSize_p,
+                                          void* pPktData_p)
 {
-    tEdrvInstance*  pInstance = (tEdrvInstance*)pParam_p;
-    tEdrvRxBuffer   rxBuffer;
+    tEdrvInstance*          pInstance = (tEdrvInstance*)pParam_p;
+    tEdrvRxBuffer           rxBuffer;
+    tEdrvReleaseRxBuffer    releaseRxBuffer = kEdrvReleaseRxBufferImmediately;
 
     if (OPLK_MEMCMP((UINT8*)pPktData_p + 6, pInstance->initParam.aMacAddr, 6) != 0)
     {   // filter out self generated traffic
@@ -556,7 +675,7 @@ static void packetHandler(void* pParam_p,
         rxBuffer.pBuffer = pPktData_p;
 
         FTRACE_MARKER("%s RX", __func__);
-        pInstance->initParam.pfnRxHandler(&rxBuffer);
+        releaseRxBuffer = pInstance->initParam.pfnRxHandler(&rxBuffer);
     }
     else
     {   // self generated traffic
@@ -617,6 +736,8 @@ static void packetHandler(void* pParam_p,
                   ((UINT8*)pPktData_p)[5]);
         }
     }
+
+    return releaseRxBuffer;
 }
 
 //------------------------------------------------------------------------------
@@ -634,22 +755,125 @@ static void* workerThread(void* pArgument_p)
 {
     tEdrvInstance*  pInstance = (tEdrvInstance*)pArgument_p;
     int             rawSockRet;
+    int             recvFlags = 0;
     u_char          aBuffer[EDRV_MAX_FRAME_SIZE];
+#if (EDRV_DEFERRED_RX_RELEASE != FALSE)
+    u_char*         pRxBuffer;
+    UINT            rxBufferIndex = 0;
+#endif
+    UINT8           aControl[CMSG_SPACE(sizeof(struct timespec))];
+    struct iovec    iov;
+    struct msghdr   msg;
 
     DEBUG_LVL_EDRV_TRACE("%s(): ThreadId:%ld\n", __func__, syscall(SYS_gettid));
 
     // signal that thread is successfully started
     sem_post(&pInstance->syncSem);
 
+    iov.iov_base = aBuffer;
+    iov.iov_len = EDRV_MAX_FRAME_SIZE;
+    OPLK_MEMSET(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = aControl;
+
+    if (pInstance->busyPoll.fEnabled)
+        recvFlags = MSG_DONTWAIT;
+
     while (edrvInstance_l.fStartCommunication)
     {
-        rawSockRet = recvfrom(edrvInstance_l.sock, aBuffer, EDRV_MAX_FRAME_SIZE, 0, 0, 0);
+        if (pInstance->busyPoll.fEnabled)
+            edrvbusypoll_waitForFrame(&pInstance->busyPoll, pInstance->sock);
+
+#if (EDRV_DEFERRED_RX_RELEASE != FALSE)
+        // if all Rx buffers are held by the stack, the frame is received into
+        // the local buffer and dropped like by a NIC without free descriptors
+        pRxBuffer = getRxBuffer(pInstance, &rxBufferIndex);
+        iov.iov_base = (pRxBuffer != NULL) ? pRxBuffer : aBuffer;
+#endif
+        msg.msg_controllen = sizeof(aControl);
+        rawSockRet = recvmsg(edrvInstance_l.sock, &msg, recvFlags);
         if (rawSockRet > 0)
         {
+            edrvbusypoll_processFrame(&pInstance->busyPoll, getRxTimeStamp(&msg));
+#if (EDRV_DEFERRED_RX_RELEASE != FALSE)
+            if (pRxBuffer == NULL)
+            {
+                pInstance->rxBufferOverrunCount++;
+                continue;
+            }
+
+            // the buffer is marked as held before it is passed to the stack,
+            // because it may be released before the handler returns
+            __sync_lock_test_and_set(&pInstance->afRxBufferUsed[rxBufferIndex], TRUE);
+            if (packetHandler(pInstance, rawSockRet, pRxBuffer) == kEdrvReleaseRxBufferLater)
+                pInstance->rxBufferIndex = (rxBufferIndex + 1) % EDRV_MAX_RX_BUFFERS;
+            else
+                __sync_lock_release(&pInstance->afRxBufferUsed[rxBufferIndex]);
+#else
             packetHandler(pInstance, rawSockRet, aBuffer);
+#endif
+        }
+    }
+    __sync_lock_test_and_set(&edrvInstance_l.fThreadIsExited, TRUE);
+
+    return NULL;
+}
+
+#if (EDRV_DEFERRED_RX_RELEASE != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Get a free Rx buffer
+
+The function searches for an Rx buffer which is not held by the stack. It is
+only called by the worker thread.
+
+\param[in,out]  pInstance_p         Pointer to the instance structure
+\param[out]     pIndex_p            Index of the found Rx buffer
+
+\return The function returns a pointer to the Rx buffer or NULL if all Rx
+        buffers are held by the stack.
+*/
+//------------------------------------------------------------------------------
+static u_char* getRxBuffer(tEdrvInstance* pInstance_p, UINT* pIndex_p)
+{
+    UINT    i;
+    UINT    index;
+
+    for (i = 0; i < EDRV_MAX_RX_BUFFERS; i++)
+    {
+        index = (pInstance_p->rxBufferIndex + i) % EDRV_MAX_RX_BUFFERS;
+        if (!pInstance_p->afRxBufferUsed[index])
+        {
+            pInstance_p->rxBufferIndex = index;
+            *pIndex_p = index;
+            return pInstance_p->aRxBuffer[index];
         }
     }
-    edrvInstance_l.fThreadIsExited = TRUE;
+
+    return NULL;
+}
+#endif
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the receive time stamp of a frame
+
+\param[in]      pMsg_p              Message header of the received frame.
+
+\return The function returns a pointer to the kernel receive time stamp or NULL
+        if the frame has no time stamp.
+*/
+//------------------------------------------------------------------------------
+static const struct timespec* getRxTimeStamp(struct msghdr* pMsg_p)
+{
+    struct cmsghdr* pCmsg;
+
+    for (pCmsg = CMSG_FIRSTHDR(pMsg_p); pCmsg != NULL; pCmsg = CMSG_NXTHDR(pMsg_p, pCmsg))
+    {
+        if ((pCmsg->cmsg_level == SOL_SOCKET) && (pCmsg->cmsg_type == SCM_TIMESTAMPNS))
+            return (const struct timespec*)CMSG_DATA(pCmsg);
+    }
 
     return NULL;
 }
@@ -0,0 +1,472 @@
+/**
+********************************************************************************
+\file   edrvbusypoll-linux.c
+
+\brief  Busy-poll module of the Linux user space Ethernet drivers
+
+This file contains the busy-poll receive mode of the Linux user space Ethernet
+drivers (pcap and raw socket). Instead of sleeping in the kernel until a frame
+arrives, the receive thread polls the socket during the isochronous phase and
+shortly before the next expected SoC. The cycle timing is reported by the DLL
+and the cyclic Edrv, because an MN using the raw socket driver does not receive
+its own SoC and SoA frames. In addition, the module measures
+the latency from the kernel receive time stamp until the Rx handler is called.
+
+Busy-polling is enabled with the fBusyPoll flag of the \ref kOplkApiThreadEdrv
+entry in the thread placement table. It should only be used if the Edrv thread
+is placed on an isolated CPU.
+
+\ingroup module_edrv
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <kernel/edrvbusypoll.h>
+
+#include <stdio.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define EDRV_BUSYPOLL_GUARD_TIME        ((UINT64)CONFIG_EDRV_BUSY_POLL_GUARD_US * 1000)
+#define EDRV_BUSYPOLL_IDLE_TIMEOUT      ((UINT64)CONFIG_EDRV_BUSY_POLL_IDLE_TIMEOUT_US * 1000)
+#define EDRV_BUSYPOLL_LATENCY_MAX       0xFFFFFFFFUL
+
+#define EDRV_BUSYPOLL_BARRIER()         __sync_synchronize()
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Cycle timing
+
+The structure contains the cycle timing reported by the DLL. It is shared by
+all receive threads, which read it in every iteration of the busy-poll loop
+without a lock.
+
+The SoC and the SoA are signalled by one context, the cycle timer thread (MN)
+or the receive thread (CN). The phase is published with a sequence count,
+which is odd while the phase is changed. A reader repeats the read if the
+count was odd or has changed. The cycle time is a single word written under
+the mutex, which only serializes the configuration changes.
+*/
+typedef struct
+{
+    pthread_mutex_t         mutex;          ///< Mutex serializing the configuration changes
+    volatile UINT32         cycleTimeUs;    ///< Configured cycle time [us], 0 = unknown
+    volatile UINT32         sequence;       ///< Sequence count of the phase, odd while it is changed
+    volatile BOOL           fIsochronous;   ///< The isochronous phase is running
+    volatile UINT32         socCount;       ///< Number of started cycles
+    volatile UINT64         lastSocTime;    ///< Monotonic time of the last SoC [ns]
+} tEdrvBusyPollTiming;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tEdrvBusyPollTiming  busyPollTiming_l =
+{
+    PTHREAD_MUTEX_INITIALIZER, 0, 0, FALSE, 0, 0
+};
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static INT64  getWaitTime(tEdrvBusyPoll* pBusyPoll_p, UINT64 now_p);
+static UINT64 getMonotonicTime(void);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize a busy-poll instance
+
+\param[out]     pBusyPoll_p         Pointer to the busy-poll instance.
+\param[in]      fEnable_p           Enable busy-polling. If FALSE, the instance
+                                    only collects the receive statistics.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+void edrvbusypoll_init(tEdrvBusyPoll* pBusyPoll_p, BOOL fEnable_p)
+{
+    ASSERT(pBusyPoll_p != NULL);
+
+    OPLK_MEMSET(pBusyPoll_p, 0, sizeof(tEdrvBusyPoll));
+    pBusyPoll_p->fEnabled = fEnable_p;
+    pBusyPoll_p->statistics.latencyMin = EDRV_BUSYPOLL_LATENCY_MAX;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for the next frame
+
+The function is called by a busy-polling receive thread before it reads the
+next frame from the non-blocking socket. If the thread shall busy-poll, the
+function returns immediately. Otherwise it waits in the kernel until a frame
+is received or the busy-poll phase before the next expected SoC starts.
+
+\param[in,out]  pBusyPoll_p         Pointer to the busy-poll instance.
+\param[in]      fd_p                File descriptor of the receive socket.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+void edrvbusypoll_waitForFrame(tEdrvBusyPoll* pBusyPoll_p, int fd_p)
+{
+    struct pollfd   pollFd;
+    struct timespec timeout;
+    INT64           waitTime;
+
+    waitTime = getWaitTime(pBusyPoll_p, getMonotonicTime());
+    pBusyPoll_p->fSpinning = (waitTime == 0);
+    if (pBusyPoll_p->fSpinning)
+        return;
+
+    pollFd.fd = fd_p;
+    pollFd.events = POLLIN;
+    pollFd.revents = 0;
+
+    if (waitTime < 0)
+    {
+        while ((ppoll(&pollFd, 1, NULL, NULL) < 0) && (errno == EINTR))
+            ;
+    }
+    else
+    {
+        timeout.tv_sec = (time_t)(waitTime / 1000000000LL);
+        timeout.tv_nsec = (long)(waitTime % 1000000000LL);
+        ppoll(&pollFd, 1, &timeout, NULL);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process a received frame
+
+The function is called for each received frame before it is passed to the Rx
+handler. It updates the receive latency statistics and the idle time of the
+busy-poll phase.
+
+\param[in,out]  pBusyPoll_p         Pointer to the busy-poll instance.
+\param[in]      pRxTimeStamp_p      Kernel receive time stamp (CLOCK_REALTIME)
+                                    of the frame. NULL if not available.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+void edrvbusypoll_processFrame(tEdrvBusyPoll* pBusyPoll_p,
+                               const struct timespec* pRxTimeStamp_p)
+{
+    struct timespec     curTime;
+    INT64               latency;
+
+    if ((pRxTimeStamp_p != NULL) && (pRxTimeStamp_p->tv_sec != 0))
+    {
+        clock_gettime(CLOCK_REALTIME, &curTime);
+        latency = ((INT64)(curTime.tv_sec - pRxTimeStamp_p->tv_sec) * 1000000000LL) +
+                  (curTime.tv_nsec - pRxTimeStamp_p->tv_nsec);
+        if ((latency >= 0) && (latency <= (INT64)EDRV_BUSYPOLL_LATENCY_MAX))
+        {
+            pBusyPoll_p->statistics.frameCount++;
+            pBusyPoll_p->statistics.latencySum += (UINT64)latency;
+            if ((UINT32)latency < pBusyPoll_p->statistics.latencyMin)
+                pBusyPoll_p->statistics.latencyMin = (UINT32)latency;
+            if ((UINT32)latency > pBusyPoll_p->statistics.latencyMax)
+                pBusyPoll_p->statistics.latencyMax = (UINT32)latency;
+        }
+    }
+
+    if (!pBusyPoll_p->fEnabled)
+        return;
+
+    if (pBusyPoll_p->fSpinning)
+        pBusyPoll_p->statistics.polledFrameCount++;
+
+    pBusyPoll_p->lastFrameTime = getMonotonicTime();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set the cycle time
+
+The function is called by the DLL when the POWERLINK cycle length is
+configured. The busy-polling receive threads use it to predict the next SoC.
+
+\param[in]      cycleTimeUs_p       Cycle time [us], 0 = unknown
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+void edrvbusypoll_setCycleTime(UINT32 cycleTimeUs_p)
+{
+    pthread_mutex_lock(&busyPollTiming_l.mutex);
+    busyPollTiming_l.cycleTimeUs = cycleTimeUs_p;
+    EDRV_BUSYPOLL_BARRIER();
+    pthread_mutex_unlock(&busyPollTiming_l.mutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Signal the start of a cycle
+
+The function is called by the DLL at the SoC. On an MN it is called by the
+cyclic Edrv when it starts to send the cycle, on a CN when the SoC is received.
+It starts the isochronous busy-poll phase of all receive threads.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+void edrvbusypoll_signalSoc(void)
+{
+    UINT64  now = getMonotonicTime();
+
+    busyPollTiming_l.sequence++;
+    EDRV_BUSYPOLL_BARRIER();
+    busyPollTiming_l.lastSocTime = now;
+    busyPollTiming_l.socCount++;
+    busyPollTiming_l.fIsochronous = TRUE;
+    EDRV_BUSYPOLL_BARRIER();
+    busyPollTiming_l.sequence++;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Signal the end of the isochronous phase
+
+The function is called by the DLL at the SoA. On an MN it is called by the
+cyclic Edrv when the SoA was sent, on a CN when the SoA is received. It ends
+the isochronous busy-poll phase of all receive threads.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+void edrvbusypoll_signalSoa(void)
+{
+    busyPollTiming_l.sequence++;
+    EDRV_BUSYPOLL_BARRIER();
+    busyPollTiming_l.fIsochronous = FALSE;
+    EDRV_BUSYPOLL_BARRIER();
+    busyPollTiming_l.sequence++;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print the receive statistics
+
+\param[in]      pBusyPoll_p         Pointer to the busy-poll instance.
+\param[in]      pName_p             Name of the Ethernet driver.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+void edrvbusypoll_printStatistics(const tEdrvBusyPoll* pBusyPoll_p, const char* pName_p)
+{
+    const tEdrvBusyPollStatistics*  pStatistics = &pBusyPoll_p->statistics;
+
+    UNUSED_PARAMETER(pName_p);
+
+    if (pStatistics->frameCount == 0)
+        return;
+
+    DEBUG_LVL_ALWAYS_TRACE("%s: busy-poll %s, Rx latency min/avg/max %u/%u/%u ns (%u frames), "
+                           "%u polled frames, %u spin timeouts\n",
+                           pName_p,
+                           pBusyPoll_p->fEnabled ? "on" : "off",
+                           pStatistics->latencyMin,
+                           (UINT32)(pStatistics->latencySum / pStatistics->frameCount),
+                           pStatistics->latencyMax,
+                           pStatistics->frameCount,
+                           pStatistics->polledFrameCount,
+                           pStatistics->spinTimeoutCount);
+}
+
+#if (CONFIG_EDRV_USE_DIAGNOSTICS != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Get the receive statistics as diagnostics text
+
+\param[in]      pBusyPoll_p         Pointer to the busy-poll instance.
+\param[out]     pBuffer_p           Pointer to buffer filled with diagnostics.
+\param[in]      size_p              Size of buffer
+
+\return The function returns the size of the diagnostics information.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+int edrvbusypoll_getDiagnostics(const tEdrvBusyPoll* pBusyPoll_p,
+                                char* pBuffer_p,
+                                size_t size_p)
+{
+    const tEdrvBusyPollStatistics*  pStatistics = &pBusyPoll_p->statistics;
+    size_t                          usedSize = 0;
+
+    ASSERT(pBuffer_p != NULL);
+
+    usedSize += snprintf(pBuffer_p + usedSize, size_p - usedSize,
+                         "\nEdrv Diagnostic Information\n");
+    usedSize += snprintf(pBuffer_p + usedSize, size_p - usedSize,
+                         "Busy-poll:          %s\n",
+                         pBusyPoll_p->fEnabled ? "on" : "off");
+    usedSize += snprintf(pBuffer_p + usedSize, size_p - usedSize,
+                         "Rx frames:          %u (polled %u)\n",
+                         pStatistics->frameCount,
+                         pStatistics->polledFrameCount);
+    usedSize += snprintf(pBuffer_p + usedSize, size_p - usedSize,
+                         "Rx latency [ns]:    min %u avg %u max %u\n",
+                         (pStatistics->frameCount != 0) ? pStatistics->latencyMin : 0,
+                         (pStatistics->frameCount != 0) ?
+                             (UINT32)(pStatistics->latencySum / pStatistics->frameCount) : 0,
+                         pStatistics->latencyMax);
+    usedSize += snprintf(pBuffer_p + usedSize, size_p - usedSize,
+                         "Spin timeouts:      %u\n",
+                         pStatistics->spinTimeoutCount);
+
+    return (int)usedSize;
+}
+#endif
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the time to wait for the next frame
+
+The function determines how long the receive thread may wait in the kernel.
+During the isochronous phase it returns 0 until no frame was received for
+CONFIG_EDRV_BUSY_POLL_IDLE_TIMEOUT_US. After the SoA it returns the time until
+CONFIG_EDRV_BUSY_POLL_GUARD_US before the expected SoC. If the cycle time is
+unknown or the SoC is overdue, the thread waits without timeout.
+
+\param[in,out]  pBusyPoll_p         Pointer to the busy-poll instance.
+\param[in]      now_p               Current monotonic time [ns].
+
+\return The function returns the time to wait [ns], 0 to busy-poll or -1 to
+        wait without timeout.
+*/
+//------------------------------------------------------------------------------
+static INT64 getWaitTime(tEdrvBusyPoll* pBusyPoll_p, UINT64 now_p)
+{
+    UINT32  sequence;
+    BOOL    fIsochronous;
+    UINT32  socCount;
+    UINT64  lastSocTime;
+    UINT64  cycleTime;
+    UINT64  idleStartTime;
+    UINT64  nextSocTime;
+
+    if (!pBusyPoll_p->fEnabled)
+        return -1;
+
+    do
+    {
+        sequence = busyPollTiming_l.sequence;
+        EDRV_BUSYPOLL_BARRIER();
+        fIsochronous = busyPollTiming_l.fIsochronous;
+        socCount = busyPollTiming_l.socCount;
+        lastSocTime = busyPollTiming_l.lastSocTime;
+        EDRV_BUSYPOLL_BARRIER();
+    } while (((sequence & 1) != 0) || (sequence != busyPollTiming_l.sequence));
+
+    cycleTime = (UINT64)busyPollTiming_l.cycleTimeUs * 1000;
+
+    if (fIsochronous && (pBusyPoll_p->idleSocCount != socCount))
+    {
+        idleStartTime = (pBusyPoll_p->lastFrameTime > lastSocTime) ?
+                            pBusyPoll_p->lastFrameTime : lastSocTime;
+        if ((now_p - idleStartTime) < EDRV_BUSYPOLL_IDLE_TIMEOUT)
+            return 0;
+
+        // SoA missed or no more frames in this cycle
+        pBusyPoll_p->idleSocCount = socCount;
+        pBusyPoll_p->statistics.spinTimeoutCount++;
+    }
+
+    if ((cycleTime == 0) || (lastSocTime == 0))
+        return -1;
+
+    nextSocTime = lastSocTime + cycleTime;
+    if (now_p > (nextSocTime + EDRV_BUSYPOLL_IDLE_TIMEOUT))
+        return -1;          // Prediction is outdated
+
+    if ((now_p + EDRV_BUSYPOLL_GUARD_TIME) >= nextSocTime)
+        return 0;
+
+    return (INT64)(nextSocTime - EDRV_BUSYPOLL_GUARD_TIME - now_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get monotonic time
+
+\return The function returns the CLOCK_MONOTONIC time in nanoseconds.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getMonotonicTime(void)
+{
+    struct timespec curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + (UINT64)curTime.tv_nsec;
+}
+
+/// \}
@@ -117,6 +117,7 @@ typedef struct
     tTimerHdl           timerHdlCycle;          ///< Handle of the cycle timer
     tEdrvCyclicCbSync   pfnSyncCb;              ///< Function pointer to the sync callback function
     tEdrvCyclicCbError  pfnErrorCb;             ///< Function pointer to the error callback function
+    tEdrvCyclicCbTx     pfnTxCb;                ///< Function pointer to the Tx callback function
     tTimestamp          nextCycleTime;          ///< Timestamp of the start of the next cycle
     tTimestamp          lastIsrEntryTime;       ///< Timestamp when the ISR was entered previously
     tTimestamp          lastIsrExitTime;        ///< Timestamp when the ISR was exit previously
@@ -413,6 +414,27 @@ tOplkError edrvcyclic_regErrorHandler(tEdrvCyclicCbError pfnCbError_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Register Tx callback
+
+This function registers the Tx callback. It is called for every Tx buffer of
+the cycle which was passed to the Ethernet driver.
+
+\param[in]      pfnCbTx_p           Function pointer called after a Tx buffer was sent
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrvcyclic_regTxHandler(tEdrvCyclicCbTx pfnCbTx_p)
+{
+    instance_l.pfnTxCb = pfnCbTx_p;
+
+    return kErrorOk;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -558,6 +580,9 @@ static tOplkError processTxBufferList(void)
             goto Exit;
         }
 
+        if (instance_l.pfnTxCb != NULL)
+            instance_l.pfnTxCb(pTxBuffer);
+
         // set fLaunchTimeValid flag to FALSE
         // -> If the Tx buffer is reused as manual Tx, edrv_sendTxBuffer will send it normally!
         pTxBuffer->fLaunchTimeValid = FALSE;
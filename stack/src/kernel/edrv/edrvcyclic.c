@@ -50,6 +50,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/target.h>
 #endif
 
+#if (CONFIG_EDRV_BUSY_POLL != FALSE)
+#include <kernel/edrvbusypoll.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -110,6 +114,7 @@ typedef struct
     tTimerHdl               timerHdlSlot;                   ///< Handle of the slot timer
     tEdrvCyclicCbSync       pfnSyncCb;                      ///< Function pointer to the sync callback function
     tEdrvCyclicCbError      pfnErrorCb;                     ///< Function pointer to the error callback function
+    tEdrvCyclicCbTx         pfnTxCb;                        ///< Function pointer to the Tx callback function
 #if (EDRV_USE_TTTX != FALSE)
     ULONGLONG               nextCycleTime;                  ///< Timestamp of the start of the next cycle
     BOOL                    fNextCycleValid;                ///< Flag indicating whether the value in nextCycleTime is valid
@@ -439,6 +444,27 @@ tOplkError edrvcyclic_regErrorHandler(tEdrvCyclicCbError pfnCbError_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Register Tx callback
+
+This function registers the Tx callback. It is called for every Tx buffer of
+the cycle which was passed to the Ethernet driver.
+
+\param[in]      pfnCbTx_p           Function pointer called after a Tx buffer was sent
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrvcyclic_regTxHandler(tEdrvCyclicCbTx pfnCbTx_p)
+{
+    edrvcyclicInstance_l.pfnTxCb = pfnCbTx_p;
+
+    return kErrorOk;
+}
+
 
 #if (CONFIG_EDRV_CYCLIC_USE_DIAGNOSTICS != FALSE)
 //------------------------------------------------------------------------------
@@ -521,6 +547,11 @@ static tOplkError timerHdlCycleCb(const tTimerEventArg* pEventArg_p)
         goto Exit;
     }
 
+#if (CONFIG_EDRV_BUSY_POLL != FALSE)
+    // the raw socket Edrv does not receive the own SoC
+    edrvbusypoll_signalSoc();
+#endif
+
     ret = processTxBufferList(TRUE);
     if (ret != kErrorOk)
     {
@@ -655,6 +686,9 @@ static tOplkError timerHdlSlotCb(const tTimerEventArg* pEventArg_p)
         goto Exit;
     }
 
+    if (edrvcyclicInstance_l.pfnTxCb != NULL)
+        edrvcyclicInstance_l.pfnTxCb(pTxBuffer);
+
     edrvcyclicInstance_l.curTxBufferEntry++;
 
     ret = processTxBufferList(FALSE);
@@ -746,6 +780,9 @@ static tOplkError processTxBufferList(BOOL fCallSyncCb_p)
         if (ret != kErrorOk)
             goto Exit;
 
+        if (edrvcyclicInstance_l.pfnTxCb != NULL)
+            edrvcyclicInstance_l.pfnTxCb(pTxBuffer);
+
         pTxBuffer->launchTime.nanoseconds = 0;
         pTxBuffer->fLaunchTimeValid = FALSE;
 
@@ -772,6 +809,9 @@ static tOplkError processTxBufferList(BOOL fCallSyncCb_p)
             {
                 goto Exit;
             }
+
+            if (edrvcyclicInstance_l.pfnTxCb != NULL)
+                edrvcyclicInstance_l.pfnTxCb(pTxBuffer);
         }
         else
         {
@@ -795,6 +835,13 @@ static tOplkError processTxBufferList(BOOL fCallSyncCb_p)
             fCallSyncCb_p = FALSE;
         }
     }
+
+#if (CONFIG_EDRV_BUSY_POLL != FALSE)
+    if (pTxBuffer == NULL)
+    {   // SoA has been sent
+        edrvbusypoll_signalSoa();
+    }
+#endif
 #endif /* (EDRV_USE_TTTX != FALSE) */
 
 Exit:
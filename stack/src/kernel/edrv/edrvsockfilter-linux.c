@@ -0,0 +1,377 @@
+/**
+********************************************************************************
+\file   edrvsockfilter-linux.c
+
+\brief  Socket filter module of the Linux user space Ethernet drivers
+
+This file contains the socket filter module of the Linux user space Ethernet
+drivers (pcap and raw socket). The module compiles the Rx filters of the DLL
+into a classic BPF program and attaches it to the receive socket. Frames which
+don't match any filter are dropped in the kernel instead of being copied to the
+receive thread.
+
+A frame is accepted if it matches an enabled filter or a filter with an
+auto-response Tx buffer. The drivers don't support auto-response, so the
+frames of these filters are answered by the DLL and must always be received.
+Frames sent by the node itself are always accepted, because the drivers detect
+the end of a transmission by receiving their own frames.
+
+\ingroup module_edrv
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <kernel/edrvsockfilter.h>
+
+#include <string.h>
+#include <errno.h>
+#include <sys/socket.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define EDRV_SOCKFILTER_FILTER_SIZE     22          // Size of the value and mask of an Edrv filter
+#define EDRV_SOCKFILTER_MAX_CHECKS      6           // Maximum number of load/compare steps per filter
+#define EDRV_SOCKFILTER_ACCEPT          0xFFFFFFFF  // Return value to accept the whole frame
+#define EDRV_SOCKFILTER_DROP            0           // Return value to drop the frame
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static UINT       compileFilter(const UINT8* pValue_p,
+                                const UINT8* pMask_p,
+                                struct sock_filter* pInstruction_p);
+static UINT       compileCheck(UINT offset_p,
+                               UINT size_p,
+                               const UINT8* pValue_p,
+                               const UINT8* pMask_p,
+                               struct sock_filter* pInstruction_p);
+static tOplkError attachProgram(tEdrvSockFilter* pSockFilter_p,
+                                const struct sock_filter* pProgram_p,
+                                UINT instructionCount_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize a socket filter instance
+
+\param[out]     pSockFilter_p       Pointer to the socket filter instance.
+\param[in]      fd_p                Receive socket of the Ethernet driver.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+void edrvsockfilter_init(tEdrvSockFilter* pSockFilter_p, int fd_p)
+{
+    ASSERT(pSockFilter_p != NULL);
+
+    pSockFilter_p->fd = fd_p;
+    pSockFilter_p->instructionCount = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down a socket filter instance
+
+The function detaches the socket filter program from the receive socket.
+
+\param[in,out]  pSockFilter_p       Pointer to the socket filter instance.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+void edrvsockfilter_exit(tEdrvSockFilter* pSockFilter_p)
+{
+    ASSERT(pSockFilter_p != NULL);
+
+    attachProgram(pSockFilter_p, NULL, 0);
+    pSockFilter_p->fd = -1;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Update the socket filter
+
+The function compiles the given Rx filters into a socket filter program and
+attaches it to the receive socket. The socket is only updated if the program
+has changed. If no filters are given or the program gets too long, the socket
+filter is removed and all frames are received.
+
+\param[in,out]  pSockFilter_p       Pointer to the socket filter instance.
+\param[in]      pFilter_p           Base pointer of Rx filter array.
+\param[in]      count_p             Number of Rx filter array entries.
+\param[in]      pMacAddr_p          MAC address of the node.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_edrv
+*/
+//------------------------------------------------------------------------------
+tOplkError edrvsockfilter_update(tEdrvSockFilter* pSockFilter_p,
+                                 const tEdrvFilter* pFilter_p,
+                                 UINT count_p,
+                                 const UINT8* pMacAddr_p)
+{
+    struct sock_filter  aProgram[EDRV_SOCKFILTER_MAX_INSTRUCTIONS];
+    UINT8               aOwnValue[EDRV_SOCKFILTER_FILTER_SIZE];
+    UINT8               aOwnMask[EDRV_SOCKFILTER_FILTER_SIZE];
+    UINT                instructionCount;
+    UINT                i;
+
+    ASSERT(pSockFilter_p != NULL);
+    ASSERT(pMacAddr_p != NULL);
+
+    if (pSockFilter_p->fd < 0)
+        return kErrorOk;
+
+    if ((pFilter_p == NULL) || (count_p == 0))
+        return attachProgram(pSockFilter_p, NULL, 0);
+
+    // Accept the own frames, they complete the transmission of the Tx buffers
+    OPLK_MEMSET(aOwnValue, 0, sizeof(aOwnValue));
+    OPLK_MEMSET(aOwnMask, 0, sizeof(aOwnMask));
+    OPLK_MEMCPY(&aOwnValue[6], pMacAddr_p, 6);
+    OPLK_MEMSET(&aOwnMask[6], 0xFF, 6);
+    instructionCount = compileFilter(aOwnValue, aOwnMask, aProgram);
+
+    for (i = 0; i < count_p; i++)
+    {
+        if (!pFilter_p[i].fEnable && (pFilter_p[i].pTxBuffer == NULL))
+            continue;
+
+        if ((instructionCount + (EDRV_SOCKFILTER_MAX_CHECKS * 3) + 2) > EDRV_SOCKFILTER_MAX_INSTRUCTIONS)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() Too many Rx filters, socket filter is removed\n", __func__);
+            return attachProgram(pSockFilter_p, NULL, 0);
+        }
+
+        instructionCount += compileFilter(pFilter_p[i].aFilterValue,
+                                          pFilter_p[i].aFilterMask,
+                                          &aProgram[instructionCount]);
+    }
+
+    aProgram[instructionCount++] = (struct sock_filter)BPF_STMT(BPF_RET | BPF_K, EDRV_SOCKFILTER_DROP);
+
+    if ((instructionCount == pSockFilter_p->instructionCount) &&
+        (OPLK_MEMCMP(aProgram, pSockFilter_p->aInstruction, instructionCount * sizeof(struct sock_filter)) == 0))
+        return kErrorOk;
+
+    return attachProgram(pSockFilter_p, aProgram, instructionCount);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compile one Rx filter
+
+The function compiles an Rx filter into a block of instructions which returns
+EDRV_SOCKFILTER_ACCEPT if the frame matches. Otherwise the block continues
+with the next instruction after it. The frame is compared in 32 bit words,
+words with an empty mask are skipped.
+
+\param[in]      pValue_p            Filter value.
+\param[in]      pMask_p             Filter mask.
+\param[out]     pInstruction_p      Pointer to store the instructions.
+
+\return The function returns the number of instructions.
+*/
+//------------------------------------------------------------------------------
+static UINT compileFilter(const UINT8* pValue_p,
+                          const UINT8* pMask_p,
+                          struct sock_filter* pInstruction_p)
+{
+    UINT    aJumpIndex[EDRV_SOCKFILTER_MAX_CHECKS];
+    UINT    jumpCount = 0;
+    UINT    instructionCount = 0;
+    UINT    checkCount;
+    UINT    offset;
+    UINT    size;
+    UINT    i;
+
+    for (offset = 0; offset < EDRV_SOCKFILTER_FILTER_SIZE; offset += size)
+    {
+        size = min(4U, (UINT)(EDRV_SOCKFILTER_FILTER_SIZE - offset));
+        checkCount = compileCheck(offset,
+                                  size,
+                                  &pValue_p[offset],
+                                  &pMask_p[offset],
+                                  &pInstruction_p[instructionCount]);
+        if (checkCount > 0)
+        {
+            instructionCount += checkCount;
+            aJumpIndex[jumpCount++] = instructionCount - 1;
+        }
+    }
+
+    pInstruction_p[instructionCount++] = (struct sock_filter)BPF_STMT(BPF_RET | BPF_K, EDRV_SOCKFILTER_ACCEPT);
+
+    // On a mismatch continue after the return instruction
+    for (i = 0; i < jumpCount; i++)
+        pInstruction_p[aJumpIndex[i]].jf = (UINT8)(instructionCount - aJumpIndex[i] - 1);
+
+    return instructionCount;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compile the comparison of one frame word
+
+The function compiles the comparison of up to four frame bytes with the filter
+value. The jump offset for a mismatch is set by the caller.
+
+\param[in]      offset_p            Offset of the bytes in the frame.
+\param[in]      size_p              Number of bytes (2 or 4).
+\param[in]      pValue_p            Filter value of the bytes.
+\param[in]      pMask_p             Filter mask of the bytes.
+\param[out]     pInstruction_p      Pointer to store the instructions.
+
+\return The function returns the number of instructions, 0 if the mask of the
+        bytes is empty.
+*/
+//------------------------------------------------------------------------------
+static UINT compileCheck(UINT offset_p,
+                         UINT size_p,
+                         const UINT8* pValue_p,
+                         const UINT8* pMask_p,
+                         struct sock_filter* pInstruction_p)
+{
+    UINT32  value = 0;
+    UINT32  mask = 0;
+    UINT32  fullMask;
+    UINT    instructionCount = 0;
+    UINT    i;
+
+    for (i = 0; i < size_p; i++)
+    {
+        value = (value << 8) | pValue_p[i];
+        mask = (mask << 8) | pMask_p[i];
+    }
+
+    if (mask == 0)
+        return 0;
+
+    fullMask = (size_p == 4) ? 0xFFFFFFFFUL : 0xFFFFUL;
+
+    pInstruction_p[instructionCount++] = (struct sock_filter)BPF_STMT(BPF_LD | ((size_p == 4) ? BPF_W : BPF_H) | BPF_ABS,
+                                                                      offset_p);
+    if (mask != fullMask)
+        pInstruction_p[instructionCount++] = (struct sock_filter)BPF_STMT(BPF_ALU | BPF_AND | BPF_K, mask);
+
+    pInstruction_p[instructionCount++] = (struct sock_filter)BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, value & mask, 0, 0);
+
+    return instructionCount;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Attach a program to the receive socket
+
+\param[in,out]  pSockFilter_p       Pointer to the socket filter instance.
+\param[in]      pProgram_p          Program to attach. NULL removes the socket
+                                    filter.
+\param[in]      instructionCount_p  Number of instructions of the program.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError attachProgram(tEdrvSockFilter* pSockFilter_p,
+                                const struct sock_filter* pProgram_p,
+                                UINT instructionCount_p)
+{
+    struct sock_fprog   program;
+    int                 dummy = 0;
+
+    if (pSockFilter_p->fd < 0)
+        return kErrorOk;
+
+    if (pProgram_p == NULL)
+    {
+        if (pSockFilter_p->instructionCount != 0)
+        {
+            setsockopt(pSockFilter_p->fd, SOL_SOCKET, SO_DETACH_FILTER, &dummy, sizeof(dummy));
+            pSockFilter_p->instructionCount = 0;
+        }
+        return kErrorOk;
+    }
+
+    program.len = (unsigned short)instructionCount_p;
+    program.filter = (struct sock_filter*)pProgram_p;
+    if (setsockopt(pSockFilter_p->fd, SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof(program)) != 0)
+    {
+        // Not fatal, the DLL filters the frames in software
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't attach socket filter. Error = %s\n", __func__, strerror(errno));
+        return attachProgram(pSockFilter_p, NULL, 0);
+    }
+
+    OPLK_MEMCPY(pSockFilter_p->aInstruction, pProgram_p, instructionCount_p * sizeof(struct sock_filter));
+    pSockFilter_p->instructionCount = instructionCount_p;
+
+    return kErrorOk;
+}
+
+/// \}
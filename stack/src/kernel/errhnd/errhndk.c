@@ -97,6 +97,14 @@ typedef struct
     UINT32              dllErrorEvents;                                 ///< Variable stores detected error events
     UINT8               aMnCnLossPresEvent[NUM_DLL_MNCN_LOSSPRES_OBJS]; ///< Variable stores detected error events from CNs
     tErrHndObjects      errorObjects;                                   ///< Error objects (counters and thresholds)
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    UINT32              aMnCnLossPresThresholdCnt[NUM_DLL_MNCN_LOSSPRES_OBJS];  ///< Local copy of the CN Loss of PRes threshold counters
+    UINT32              aMnCnLossPresDecrement[NUM_DLL_MNCN_LOSSPRES_OBJS];     ///< Threshold counters to be decremented at the end of the cycle (0 or 1)
+    UINT32              aMnCnLossPresChanged[NUM_DLL_MNCN_LOSSPRES_OBJS];       ///< Threshold counters not yet written to the error handler objects (0 or 1)
+    UINT32              aMnCnLossPresObjectCnt[NUM_DLL_MNCN_LOSSPRES_OBJS];     ///< Threshold counters as last read from or written to the error handler objects
+    BOOL                fMnCnLossPresChanged;                                   ///< At least one threshold counter has not been written yet
+    UINT                mirrorCycleCnt;                                         ///< Cycles since the threshold counters have been written
+#endif
 } tErrHndkInstance;
 
 //------------------------------------------------------------------------------
@@ -116,6 +124,11 @@ static tOplkError handleDllErrors(const tEvent* pEvent_p);
 
 #if defined(CONFIG_INCLUDE_NMT_MN)
 static tOplkError decrementMnCounters(void);
+static void       mirrorMnCnLossPresThresholdCnt(void);
+static void       reloadMnCnLossPresThresholdCnt(UINT nodeIdx_p);
+static void       setMnCnLossPresCounters(UINT nodeIdx_p,
+                                          UINT32 cumulativeCnt_p,
+                                          UINT32 thresholdCnt_p);
 static tOplkError postHeartbeatEvent(UINT nodeId_p, tNmtState state_p, UINT16 errorCode_p);
 static tOplkError generateHistoryEntryWithError(UINT16 errorCode_p, tNetTime netTime_p, UINT16 oplkError_p);
 #endif
@@ -138,9 +151,26 @@ The function initializes the kernel error handler module.
 tOplkError errhndk_init(void)
 {
     tOplkError  ret;
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    UINT        nodeIdx;
+#endif
 
     instance_l.dllErrorEvents = 0L;
     ret = errhndkcal_init();
+    if (ret != kErrorOk)
+        return ret;
+
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    // the threshold counters are decremented in a local copy, which is
+    // written to the error handler objects periodically
+    for (nodeIdx = 0; nodeIdx < NUM_DLL_MNCN_LOSSPRES_OBJS; nodeIdx++)
+    {
+        reloadMnCnLossPresThresholdCnt(nodeIdx);
+        instance_l.aMnCnLossPresDecrement[nodeIdx] = 0;
+    }
+    instance_l.fMnCnLossPresChanged = FALSE;
+    instance_l.mirrorCycleCnt = 0;
+#endif
 
     return ret;
 }
@@ -158,6 +188,11 @@ The function shuts down the kernel error handler module.
 //------------------------------------------------------------------------------
 tOplkError errhndk_exit()
 {
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    // write the pending threshold counters
+    mirrorMnCnLossPresThresholdCnt();
+#endif
+
     errhndkcal_exit();
 
     return kErrorOk;
@@ -290,7 +325,10 @@ tOplkError errhndk_postError(const tEventDllError* pErrEvent_p)
 /**
 \brief    Reset error flag for specified CN
 
-The function resets the error flag for the specified CN.
+The function resets the error flag for the specified CN. It is called if the
+CN is added to the isochronous phase, e.g. after the error handler objects
+have been reset by an NMT reset command. Therefore the local copy of the
+threshold counter is reloaded from the error handler objects.
 
 \param[in]      nodeId_p            Node ID of CN for which error flag will be reset.
 
@@ -307,6 +345,7 @@ tOplkError errhndk_resetCnError(UINT nodeId_p)
         return kErrorInvalidNodeId;
 
     instance_l.aMnCnLossPresEvent[nodeIdx] = ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE;
+    reloadMnCnLossPresThresholdCnt(nodeIdx);
 
     return kErrorOk;
 }
@@ -325,6 +364,12 @@ tOplkError errhndk_resetCnError(UINT nodeId_p)
 
 The function decrements the error counters used by a MN node.
 
+The CN Loss of PRes threshold counters are decremented in the local copy. The
+nodes of the current cycle are marked first, then all counters are decremented
+branch-free in one pass over the dense arrays, which can be vectorized by the
+compiler. Changed counters are written to the error handler objects every
+\ref CONFIG_ERRHNDK_THRESHOLD_CNT_MIRROR_CYCLES cycles.
+
 \return Returns kErrorOk or error code
 */
 //------------------------------------------------------------------------------
@@ -332,39 +377,51 @@ static tOplkError decrementMnCounters(void)
 {
     UINT8*  pCnNodeId;
     UINT    nodeIdx;
+    UINT    nodeCount = 0;
     UINT32  thresholdCnt;
+    UINT32  decrement;
+    UINT32  changed = 0;
 
     dllk_getCurrentCnNodeIdList(&pCnNodeId);
 
-    // iterate through node info structure list
+    // mark the nodes of the current cycle without Loss of PRes error
     while (*pCnNodeId != C_ADR_INVALID)
     {
         nodeIdx = *pCnNodeId - 1;
         if (nodeIdx < NUM_DLL_MNCN_LOSSPRES_OBJS)
         {
-            if (instance_l.aMnCnLossPresEvent[nodeIdx] ==
-                ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE)
-            {
-                errhndkcal_getMnCnLossPresThresholdCnt(nodeIdx, &thresholdCnt);
-                if (thresholdCnt > 0)
-                {
-                    thresholdCnt--;
-                    errhndkcal_setMnCnLossPresThresholdCnt(nodeIdx, thresholdCnt);
-                }
-            }
-            else
-            {
-                if (instance_l.aMnCnLossPresEvent[nodeIdx] ==
-                    ERRORHANDLERK_CN_LOSS_PRES_EVENT_OCC)
-                {
-                    instance_l.aMnCnLossPresEvent[nodeIdx] =
-                                          ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE;
-                }
-            }
+            instance_l.aMnCnLossPresDecrement[nodeIdx] =
+                (instance_l.aMnCnLossPresEvent[nodeIdx] == ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE);
+
+            if (instance_l.aMnCnLossPresEvent[nodeIdx] == ERRORHANDLERK_CN_LOSS_PRES_EVENT_OCC)
+                instance_l.aMnCnLossPresEvent[nodeIdx] = ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE;
+
+            nodeCount = max(nodeCount, nodeIdx + 1);
         }
         pCnNodeId++;
     }
 
+    // saturating decrement of the marked threshold counters
+    for (nodeIdx = 0; nodeIdx < nodeCount; nodeIdx++)
+    {
+        decrement = instance_l.aMnCnLossPresDecrement[nodeIdx] &
+                    (UINT32)(instance_l.aMnCnLossPresThresholdCnt[nodeIdx] != 0);
+        instance_l.aMnCnLossPresThresholdCnt[nodeIdx] -= decrement;
+        instance_l.aMnCnLossPresChanged[nodeIdx] |= decrement;
+        instance_l.aMnCnLossPresDecrement[nodeIdx] = 0;
+        changed |= decrement;
+    }
+
+    if (changed != 0)
+        instance_l.fMnCnLossPresChanged = TRUE;
+
+    instance_l.mirrorCycleCnt++;
+    if (instance_l.mirrorCycleCnt >= CONFIG_ERRHNDK_THRESHOLD_CNT_MIRROR_CYCLES)
+    {
+        mirrorMnCnLossPresThresholdCnt();
+        instance_l.mirrorCycleCnt = 0;
+    }
+
     if ((instance_l.dllErrorEvents & DLL_ERR_MN_CRC) == 0)
     {   // decrement CRC threshold counter, because it didn't occur last cycle
         errhndkcal_getMnCrcThresholdCnt(&thresholdCnt);
@@ -811,6 +868,11 @@ static tOplkError handleMnCnLossPres(const tEvent* pEvent_p)
                                     &thresholdCnt,
                                     &threshold);
 
+    // the local copy is only valid as long as the threshold counter in the
+    // error handler objects was not written by others (e.g. the OD)
+    if (thresholdCnt == instance_l.aMnCnLossPresObjectCnt[nodeIdx])
+        thresholdCnt = instance_l.aMnCnLossPresThresholdCnt[nodeIdx];
+
     if (instance_l.aMnCnLossPresEvent[nodeIdx] !=
                                   ERRORHANDLERK_CN_LOSS_PRES_EVENT_NONE)
         return kErrorOk;
@@ -832,9 +894,7 @@ static tOplkError handleMnCnLossPres(const tEvent* pEvent_p)
                                              pErrorHandlerEvent->nodeId);
             if (ret != kErrorOk)
             {
-                errhndkcal_setMnCnLossPresCounters(nodeIdx,
-                                                   cumulativeCnt,
-                                                   thresholdCnt);
+                setMnCnLossPresCounters(nodeIdx, cumulativeCnt, thresholdCnt);
                 return ret;
             }
 
@@ -863,11 +923,94 @@ static tOplkError handleMnCnLossPres(const tEvent* pEvent_p)
                             ERRORHANDLERK_CN_LOSS_PRES_EVENT_OCC;
         }
     }
-    errhndkcal_setMnCnLossPresCounters(nodeIdx, cumulativeCnt, thresholdCnt);
+    setMnCnLossPresCounters(nodeIdx, cumulativeCnt, thresholdCnt);
 
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief    Set the Loss of PRes error counters of a CN
+
+The function stores the Loss of PRes error counters of a CN in the local copy
+and writes them to the error handler objects.
+
+\param[in]      nodeIdx_p           Index of the CN.
+\param[in]      cumulativeCnt_p     Cumulative counter.
+\param[in]      thresholdCnt_p      Threshold counter.
+*/
+//------------------------------------------------------------------------------
+static void setMnCnLossPresCounters(UINT nodeIdx_p,
+                                    UINT32 cumulativeCnt_p,
+                                    UINT32 thresholdCnt_p)
+{
+    instance_l.aMnCnLossPresThresholdCnt[nodeIdx_p] = thresholdCnt_p;
+    instance_l.aMnCnLossPresObjectCnt[nodeIdx_p] = thresholdCnt_p;
+    instance_l.aMnCnLossPresChanged[nodeIdx_p] = 0;
+
+    errhndkcal_setMnCnLossPresCounters(nodeIdx_p, cumulativeCnt_p, thresholdCnt_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Write changed Loss of PRes threshold counters
+
+The function writes the CN Loss of PRes threshold counters which were changed
+in the local copy to the error handler objects. If a threshold counter in the
+error handler objects was written by others since it was last written by the
+error handler, e.g. by an NMT reset command or by the application through the
+OD, the written value is taken over into the local copy instead.
+*/
+//------------------------------------------------------------------------------
+static void mirrorMnCnLossPresThresholdCnt(void)
+{
+    UINT    nodeIdx;
+    UINT32  objectCnt;
+
+    if (!instance_l.fMnCnLossPresChanged)
+        return;
+
+    for (nodeIdx = 0; nodeIdx < NUM_DLL_MNCN_LOSSPRES_OBJS; nodeIdx++)
+    {
+        if (instance_l.aMnCnLossPresChanged[nodeIdx] != 0)
+        {
+            errhndkcal_getMnCnLossPresThresholdCnt(nodeIdx, &objectCnt);
+            if (objectCnt == instance_l.aMnCnLossPresObjectCnt[nodeIdx])
+            {
+                errhndkcal_setMnCnLossPresThresholdCnt(nodeIdx,
+                                                       instance_l.aMnCnLossPresThresholdCnt[nodeIdx]);
+                instance_l.aMnCnLossPresObjectCnt[nodeIdx] = instance_l.aMnCnLossPresThresholdCnt[nodeIdx];
+            }
+            else
+            {
+                instance_l.aMnCnLossPresThresholdCnt[nodeIdx] = objectCnt;
+                instance_l.aMnCnLossPresObjectCnt[nodeIdx] = objectCnt;
+            }
+            instance_l.aMnCnLossPresChanged[nodeIdx] = 0;
+        }
+    }
+
+    instance_l.fMnCnLossPresChanged = FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Reload the Loss of PRes threshold counter of a CN
+
+The function reloads the local copy of the CN Loss of PRes threshold counter
+from the error handler objects and discards a pending change.
+
+\param[in]      nodeIdx_p           Index of the CN.
+*/
+//------------------------------------------------------------------------------
+static void reloadMnCnLossPresThresholdCnt(UINT nodeIdx_p)
+{
+    errhndkcal_getMnCnLossPresThresholdCnt(nodeIdx_p,
+                                           &instance_l.aMnCnLossPresThresholdCnt[nodeIdx_p]);
+    instance_l.aMnCnLossPresObjectCnt[nodeIdx_p] = instance_l.aMnCnLossPresThresholdCnt[nodeIdx_p];
+    instance_l.aMnCnLossPresChanged[nodeIdx_p] = 0;
+}
+
 #endif
 
 //------------------------------------------------------------------------------
@@ -80,19 +80,107 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define EVENTK_SINK_TABLE_SIZE      (kEventSinkTimesynck + 1)   // Size of the dispatch table, indexed by the event sink
+#define EVENTK_TYPE_TABLE_SIZE      0x40                        // Number of event types covered by the type dispatch table
+#define EVENTK_TYPE_HANDLER_COUNT   8                           // Maximum number of registered event type handlers
 
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
+/**
+\brief Event sink layers
+
+The enumeration lists the layers an event sink can be located in.
+*/
+typedef enum
+{
+    kEventkSinkLayerKernel = 0,                 ///< Events are posted to the kernel layer
+    kEventkSinkLayerUser                        ///< Events are posted to the user layer
+} eEventkSinkLayer;
+
+/**
+\brief Event sink layer data type
+
+Data type for the enumerator \ref eEventkSinkLayer.
+*/
+typedef UINT8 tEventkSinkLayer;
+
+/**
+\brief Event sink registration
+
+The structure describes an event sink known to the kernel event module. It
+defines the queue the events of the sink are posted to and, for sinks processed
+by eventk_process(), the process function of the sink module.
+*/
+typedef struct
+{
+    tEventSink          eventSink;              ///< Event sink
+    tEventkSinkLayer    sinkLayer;              ///< Layer the event sink is located in
+    tOplkError          (*pfnProcess)(const tEvent* pEvent_p);  ///< Process function of the sink module (NULL if not processed by eventk_process())
+    tEventSource        eventSource;            ///< Event source used for error events of the sink module
+} tEventkSinkEntry;
+
+/**
+\brief Event type handler
+
+The structure describes a handler which is registered by a kernel module for a
+single event type of one of its sinks.
+*/
+typedef struct
+{
+    tEventkProcessCb    pfnProcess;             ///< Process function of the event type
+    BOOL                fFastLane;              ///< Flag determines if the event is posted to the fast lane
+} tEventkTypeEntry;
+
+/**
+\brief Kernel event instance type
+
+The kernel event instance holds the dispatch table which is built from the sink
+registrations when the module is initialized and the event type handlers which
+are registered by the modules.
+*/
+typedef struct
+{
+    const tEventkSinkEntry* apSinkEntry[EVENTK_SINK_TABLE_SIZE];   ///< Dispatch table indexed by the event sink
+    tEventkTypeEntry        aTypeEntry[EVENTK_TYPE_HANDLER_COUNT];  ///< Registered event type handlers
+    UINT                    typeEntryCount;                         ///< Number of registered event type handlers
+    UINT8                   aTypeIndex[EVENTK_SINK_TABLE_SIZE][EVENTK_TYPE_TABLE_SIZE];    ///< Index + 1 of the event type handler (0 = processed by the sink)
+} tEventkInstance;
 
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static tOplkError processNmtkEvent(const tEvent* pEvent_p);
 static tOplkError handleNmtEventInDll(const tEvent* pEvent_p);
+static const tEventkTypeEntry* getTypeEntry(const tEvent* pEvent_p);
 
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
+static const tEventkSinkEntry   aSinkRegistration_l[] =
+{
+    // Event sink           Sink layer              Process function    Event source
+    {kEventSinkDllk,        kEventkSinkLayerKernel, dllk_process,       kEventSourceDllk},
+#if defined(CONFIG_INCLUDE_PDO)
+    {kEventSinkPdokCal,     kEventkSinkLayerKernel, pdokcal_process,    kEventSourcePdok},
+#else
+    {kEventSinkPdokCal,     kEventkSinkLayerKernel, NULL,               kEventSourcePdok},
+#endif
+    {kEventSinkDllkCal,     kEventkSinkLayerKernel, dllkcal_process,    kEventSourceDllk},
+    {kEventSinkNmtk,        kEventkSinkLayerKernel, processNmtkEvent,   kEventSourceDllk},
+    {kEventSinkErrk,        kEventkSinkLayerKernel, errhndk_process,    kEventSourceErrk},
+    {kEventSinkTimesynck,   kEventkSinkLayerKernel, timesynck_process,  kEventSourceTimesynck},
+    {kEventSinkSync,        kEventkSinkLayerKernel, NULL,               kEventSourceInvalid},
+    {kEventSinkPdok,        kEventkSinkLayerKernel, NULL,               kEventSourceInvalid},
+    {kEventSinkNmtMnu,      kEventkSinkLayerUser,   NULL,               kEventSourceInvalid},
+    {kEventSinkNmtu,        kEventkSinkLayerUser,   NULL,               kEventSourceInvalid},
+    {kEventSinkSdoAsySeq,   kEventkSinkLayerUser,   NULL,               kEventSourceInvalid},
+    {kEventSinkApi,         kEventkSinkLayerUser,   NULL,               kEventSourceInvalid},
+    {kEventSinkDlluCal,     kEventkSinkLayerUser,   NULL,               kEventSourceInvalid},
+    {kEventSinkErru,        kEventkSinkLayerUser,   NULL,               kEventSourceInvalid},
+};
+
+static tEventkInstance          instance_l;
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -115,6 +203,15 @@ the init function of its CAL module.
 tOplkError eventk_init(void)
 {
     tOplkError  ret;
+    UINT        i;
+
+    OPLK_MEMSET(&instance_l, 0, sizeof(tEventkInstance));
+
+    for (i = 0; i < tabentries(aSinkRegistration_l); i++)
+    {
+        ASSERT(aSinkRegistration_l[i].eventSink < EVENTK_SINK_TABLE_SIZE);
+        instance_l.apSinkEntry[aSinkRegistration_l[i].eventSink] = &aSinkRegistration_l[i];
+    }
 
     ret = eventkcal_init();
 
@@ -147,9 +244,10 @@ tOplkError eventk_exit(void)
 /**
 \brief    Kernel event handler
 
-This function processes events posted to the kernel layer. It examines the
-sink and forwards the events by calling the event process function of the
-specific module.
+This function processes events posted to the kernel layer. It looks up the
+sink in the dispatch table and forwards the events by calling the event process
+function of the specific module. If the module has registered a handler for
+the event type, the handler is called instead.
 
 \param[in]      pEvent_p            Received event.
 
@@ -162,75 +260,40 @@ specific module.
 //------------------------------------------------------------------------------
 tOplkError eventk_process(const tEvent* pEvent_p)
 {
-    tOplkError      ret = kErrorOk;
-    tEventSource    eventSource;
+    tOplkError              ret;
+    const tEventkSinkEntry* pSinkEntry = NULL;
+    const tEventkTypeEntry* pTypeEntry;
 
     // Check parameter validity
     ASSERT(pEvent_p != NULL);
 
-    switch (pEvent_p->eventSink)
-    {
-        // Note: case statements are sorted for best performance!
-        case kEventSinkDllk:
-            ret = dllk_process(pEvent_p);
-            eventSource = kEventSourceDllk;
-            break;
+    if (pEvent_p->eventSink < EVENTK_SINK_TABLE_SIZE)
+        pSinkEntry = instance_l.apSinkEntry[pEvent_p->eventSink];
 
-#if defined(CONFIG_INCLUDE_PDO)
-        case kEventSinkPdokCal:
-            ret = pdokcal_process(pEvent_p);
-            eventSource = kEventSourcePdok;
-            break;
-#endif
-        case kEventSinkDllkCal:
-            ret = dllkcal_process(pEvent_p);
-            eventSource = kEventSourceDllk;
-            break;
-
-        case kEventSinkNmtk:
-            ret = nmtk_process(pEvent_p);
-            eventSource = kEventSourceNmtk;
-            if ((ret != kErrorOk) && (ret != kErrorShutdown))
-            {
-                // forward error event to API layer
-                eventk_postError(kEventSourceEventk,
-                                 ret,
-                                 sizeof(eventSource),
-                                 &eventSource);
-            }
-            ret = handleNmtEventInDll(pEvent_p);
-            eventSource = kEventSourceDllk;
-            break;
-
-        case kEventSinkErrk:
-            ret = errhndk_process(pEvent_p);
-            eventSource = kEventSourceErrk;
-            break;
-
-        case kEventSinkTimesynck:
-            ret = timesynck_process(pEvent_p);
-            eventSource = kEventSourceTimesynck;
-            break;
-
-        default:
-            // Unknown sink, provide error event to API layer
-            ret = kErrorEventUnknownSink;
-            eventk_postError(kEventSourceEventk,
-                             ret,
-                             sizeof(pEvent_p->eventSink),
-                             &pEvent_p->eventSink);
-            break;
+    if ((pSinkEntry == NULL) || (pSinkEntry->pfnProcess == NULL))
+    {
+        // Unknown sink, provide error event to API layer
+        ret = kErrorEventUnknownSink;
+        eventk_postError(kEventSourceEventk,
+                         ret,
+                         sizeof(pEvent_p->eventSink),
+                         &pEvent_p->eventSink);
+        return ret;
     }
 
-    if ((ret != kErrorOk) &&
-        (ret != kErrorShutdown) &&
-        (ret != kErrorEventUnknownSink))
+    // Event types with a registered handler skip the event type switch of the sink module
+    pTypeEntry = getTypeEntry(pEvent_p);
+    if (pTypeEntry != NULL)
+        ret = pTypeEntry->pfnProcess(pEvent_p);
+    else
+        ret = pSinkEntry->pfnProcess(pEvent_p);
+    if ((ret != kErrorOk) && (ret != kErrorShutdown))
     {
         // forward error event to API layer
         eventk_postError(kEventSourceEventk,
                          ret,
-                         sizeof(eventSource),
-                         &eventSource);
+                         sizeof(pSinkEntry->eventSource),
+                         &pSinkEntry->eventSource);
     }
 
     return ret;
@@ -254,39 +317,21 @@ CAL module which distributes the event to the suitable event queue.
 //------------------------------------------------------------------------------
 tOplkError eventk_postEvent(const tEvent* pEvent_p)
 {
-    tOplkError ret = kErrorOk;
+    const tEventkSinkEntry* pSinkEntry = NULL;
 
     // Check parameter validity
     ASSERT(pEvent_p != NULL);
 
-    switch (pEvent_p->eventSink)
-    {
-        case kEventSinkNmtMnu:
-        case kEventSinkNmtu:
-        case kEventSinkSdoAsySeq:
-        case kEventSinkApi:
-        case kEventSinkDlluCal:
-        case kEventSinkErru:
-            ret = eventkcal_postUserEvent(pEvent_p);
-            break;
-
-        case kEventSinkSync:
-        case kEventSinkNmtk:
-        case kEventSinkDllk:
-        case kEventSinkDllkCal:
-        case kEventSinkPdok:
-        case kEventSinkPdokCal:
-        case kEventSinkErrk:
-        case kEventSinkTimesynck:
-            ret = eventkcal_postKernelEvent(pEvent_p);
-            break;
-
-        default:
-            ret = kErrorEventUnknownSink;
-            break;
-    }
+    if (pEvent_p->eventSink < EVENTK_SINK_TABLE_SIZE)
+        pSinkEntry = instance_l.apSinkEntry[pEvent_p->eventSink];
 
-    return ret;
+    if (pSinkEntry == NULL)
+        return kErrorEventUnknownSink;
+
+    if (pSinkEntry->sinkLayer == kEventkSinkLayerUser)
+        return eventkcal_postUserEvent(pEvent_p);
+
+    return eventkcal_postKernelEvent(pEvent_p);
 }
 
 //------------------------------------------------------------------------------
@@ -337,12 +382,144 @@ tOplkError eventk_postError(tEventSource eventSource_p,
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief    Register an event type handler
+
+This function registers a handler for a single event type of a kernel event
+sink. Events of this type are passed to the handler instead of the process
+function of the sink module. Modules register the handlers of their frequent
+events in their init functions, after the kernel event module is initialized.
+
+Events registered for the fast lane are time-critical per-cycle events. The
+event CAL may process them before the events of its queues, if it provides a
+fast lane (see \ref eventk_isFastLaneEvent). Thus, a fast lane event can
+overtake any earlier event which is not in the fast lane. Only event types
+whose handlers do not depend on the effect of other queued events may be
+registered for the fast lane (cycle finish, sync and received PDO events).
+Events which change the configuration or the state of a module (e.g. NMT
+events) must not be registered for the fast lane.
+
+\param[in]      eventSink_p         Event sink of the event type.
+\param[in]      eventType_p         Event type to register.
+\param[in]      pfnProcess_p        Process function of the event type.
+\param[in]      fFastLane_p         Flag determines if the events of this type
+                                    are posted to the fast lane.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The handler was registered.
+\retval kErrorEventUnknownSink      The sink is not processed in the kernel layer.
+\retval kErrorInvalidEvent          The event type is out of range.
+\retval kErrorNoResource            No free handler entry is available.
+
+\ingroup module_eventk
+*/
+//------------------------------------------------------------------------------
+tOplkError eventk_registerEventHandler(tEventSink eventSink_p,
+                                       tEventType eventType_p,
+                                       tEventkProcessCb pfnProcess_p,
+                                       BOOL fFastLane_p)
+{
+    const tEventkSinkEntry* pSinkEntry = NULL;
+    tEventkTypeEntry*       pTypeEntry;
+    UINT8*                  pTypeIndex;
+
+    // Check parameter validity
+    ASSERT(pfnProcess_p != NULL);
+
+    if (eventSink_p < EVENTK_SINK_TABLE_SIZE)
+        pSinkEntry = instance_l.apSinkEntry[eventSink_p];
+
+    if ((pSinkEntry == NULL) || (pSinkEntry->pfnProcess == NULL))
+        return kErrorEventUnknownSink;
+
+    if (eventType_p >= EVENTK_TYPE_TABLE_SIZE)
+        return kErrorInvalidEvent;
+
+    pTypeIndex = &instance_l.aTypeIndex[eventSink_p][eventType_p];
+    if (*pTypeIndex != 0)
+    {   // Replace the existing handler
+        pTypeEntry = &instance_l.aTypeEntry[*pTypeIndex - 1];
+    }
+    else
+    {
+        if (instance_l.typeEntryCount >= EVENTK_TYPE_HANDLER_COUNT)
+            return kErrorNoResource;
+
+        pTypeEntry = &instance_l.aTypeEntry[instance_l.typeEntryCount];
+        instance_l.typeEntryCount++;
+    }
+
+    pTypeEntry->pfnProcess = pfnProcess_p;
+    pTypeEntry->fFastLane = fFastLane_p;
+    *pTypeIndex = (UINT8)((pTypeEntry - instance_l.aTypeEntry) + 1);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Check if an event is posted to the fast lane
+
+This function checks if an event type was registered for the fast lane. It is
+used by event CAL modules which provide a fast lane for time-critical kernel
+events.
+
+\param[in]      pEvent_p            Event to check.
+
+\return The function returns TRUE if the event is posted to the fast lane,
+        otherwise FALSE.
+
+\ingroup module_eventk
+*/
+//------------------------------------------------------------------------------
+BOOL eventk_isFastLaneEvent(const tEvent* pEvent_p)
+{
+    const tEventkTypeEntry* pTypeEntry;
+
+    pTypeEntry = getTypeEntry(pEvent_p);
+
+    return ((pTypeEntry != NULL) && pTypeEntry->fFastLane);
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief  Process NMT kernel event
+
+This function forwards an event to the NMT kernel module. Afterwards the NMT
+events which need to be handled by the DLL are dispatched to the DLLk module.
+
+\param[in]      pEvent_p            Event to process.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    Function executes correctly
+\retval other error codes           An error occurred
+*/
+//------------------------------------------------------------------------------
+static tOplkError processNmtkEvent(const tEvent* pEvent_p)
+{
+    tOplkError      ret;
+    tEventSource    eventSource = kEventSourceNmtk;
+
+    ret = nmtk_process(pEvent_p);
+    if ((ret != kErrorOk) && (ret != kErrorShutdown))
+    {
+        // forward error event to API layer
+        eventk_postError(kEventSourceEventk,
+                         ret,
+                         sizeof(eventSource),
+                         &eventSource);
+    }
+
+    return handleNmtEventInDll(pEvent_p);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Handle NMT event in DLL
@@ -377,4 +554,32 @@ static tOplkError handleNmtEventInDll(const tEvent* pEvent_p)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get the registered handler of an event type
+
+This function looks up the handler registered for the sink and type of an
+event.
+
+\param[in]      pEvent_p            Event to look up.
+
+\return The function returns a pointer to the event type handler or NULL if
+        no handler is registered.
+*/
+//------------------------------------------------------------------------------
+static const tEventkTypeEntry* getTypeEntry(const tEvent* pEvent_p)
+{
+    UINT8   typeIndex;
+
+    if ((pEvent_p->eventSink >= EVENTK_SINK_TABLE_SIZE) ||
+        (pEvent_p->eventType >= EVENTK_TYPE_TABLE_SIZE))
+        return NULL;
+
+    typeIndex = instance_l.aTypeIndex[pEvent_p->eventSink][pEvent_p->eventType];
+    if (typeIndex == 0)
+        return NULL;
+
+    return &instance_l.aTypeEntry[typeIndex - 1];
+}
+
 /// \}
@@ -43,9 +43,11 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // includes
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
+#include <kernel/eventk.h>
 #include <kernel/eventkcal.h>
 #include <kernel/eventkcalintf.h>
 #include <common/target.h>
+#include <common/targetthread.h>
 
 #include <time.h>
 #include <fcntl.h>
@@ -77,11 +79,23 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define EVENTKCAL_FAST_LANE_SIZE            32      // Number of events which can be stored in the fast lane
 
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
 
+/**
+\brief Fast lane event
+
+The structure contains an event of the fast lane and a copy of its argument.
+*/
+typedef struct
+{
+    tEvent                  event;                              ///< Event
+    UINT8                   aArg[MAX_EVENT_ARG_SIZE];           ///< Copy of the event argument
+} tEventkCalFastLaneEvent;
+
 /**
 \brief Kernel event CAL instance type
 
@@ -95,6 +109,10 @@ typedef struct
     sem_t*                  semUserData;
     sem_t*                  semKernelData;
     BOOL                    fInitialized;
+    pthread_mutex_t         fastLaneMutex;                      ///< Mutex protecting the fast lane indices
+    UINT                    fastLaneReadIndex;                  ///< Number of processed fast lane events
+    UINT                    fastLaneWriteIndex;                 ///< Number of posted fast lane events
+    tEventkCalFastLaneEvent aFastLane[EVENTKCAL_FAST_LANE_SIZE];   ///< Fast lane for time-critical kernel events
 } tEventkCalInstance;
 
 //------------------------------------------------------------------------------
@@ -108,6 +126,8 @@ static tEventkCalInstance   instance_l;             ///< Instance variable of ke
 static void* eventThread(void* arg);
 static void  signalKernelEvent(void);
 static void  signalUserEvent(void);
+static tOplkError postFastLaneEvent(const tEvent* pEvent_p);
+static BOOL  processFastLaneEvent(void);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -128,10 +148,11 @@ The function initializes the kernel event CAL module on Linux.
 //------------------------------------------------------------------------------
 tOplkError eventkcal_init(void)
 {
-    struct sched_param  schedParam;
 
     OPLK_MEMSET(&instance_l, 0, sizeof(tEventkCalInstance));
 
+    pthread_mutex_init(&instance_l.fastLaneMutex, NULL);
+
     sem_unlink("/semUserEvent");
     sem_unlink("/semKernelEvent");
 
@@ -158,17 +179,10 @@ tOplkError eventkcal_init(void)
     if (pthread_create(&instance_l.threadId, NULL, eventThread, (void*)&instance_l) != 0)
         goto Exit;
 
-    schedParam.sched_priority = KERNEL_EVENT_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.threadId, SCHED_FIFO, &schedParam) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
-                              __func__,
-                              schedParam.sched_priority);
-    }
-
-#if (defined(__GLIBC__) && __GLIBC__ >= 2 && __GLIBC_MINOR__ >= 12)
-    pthread_setname_np(instance_l.threadId, "oplk-eventk");
-#endif
+    target_registerThread(instance_l.threadId,
+                          kOplkApiThreadEventk,
+                          "oplk-eventk",
+                          KERNEL_EVENT_THREAD_PRIORITY);
 
     instance_l.fInitialized = TRUE;
     return kErrorOk;
@@ -184,6 +198,8 @@ Exit:
     eventkcal_exitQueueCircbuf(kEventQueueU2K);
     eventkcal_exitQueueCircbuf(kEventQueueKInt);
 
+    pthread_mutex_destroy(&instance_l.fastLaneMutex);
+
     return kErrorNoResource;
 }
 
@@ -208,6 +224,7 @@ tOplkError eventkcal_exit(void)
 
     if (instance_l.fInitialized != FALSE)
     {
+        target_unregisterThread(instance_l.threadId);
         instance_l.fStopThread = TRUE;
         while (instance_l.fStopThread != FALSE)
         {
@@ -229,6 +246,7 @@ tOplkError eventkcal_exit(void)
         sem_unlink("/semUserEvent");
         sem_unlink("/semKernelEvent");
 
+        pthread_mutex_destroy(&instance_l.fastLaneMutex);
     }
     instance_l.fInitialized = FALSE;
 
@@ -239,7 +257,13 @@ tOplkError eventkcal_exit(void)
 /**
 \brief    Post kernel event
 
-This function posts a event to the kernel queue.
+This function posts a event to the kernel queue. Time-critical events which
+are registered for the fast lane are posted to the fast lane instead of the
+kernel-internal circular buffer. The event thread processes the fast lane
+first, so these events may overtake earlier events of the kernel-internal and
+the user-to-kernel queue. Fast lane events are processed in posting order.
+See \ref eventk_registerEventHandler for the event types which can be
+reordered safely.
 
 \param[in]      pEvent_p            Event to be posted.
 
@@ -254,7 +278,10 @@ tOplkError eventkcal_postKernelEvent(const tEvent* pEvent_p)
 {
     tOplkError  ret;
 
-    ret = eventkcal_postEventCircbuf(kEventQueueKInt, pEvent_p);
+    if (eventk_isFastLaneEvent(pEvent_p))
+        ret = postFastLaneEvent(pEvent_p);
+    else
+        ret = eventkcal_postEventCircbuf(kEventQueueKInt, pEvent_p);
 
     return ret;
 }
@@ -328,7 +355,11 @@ static void* eventThread(void* arg)
 
         if (sem_timedwait(pInstance->semKernelData, &timeout) == 0)
         {
-            /* first handle kernel internal events --> higher priority! */
+            /* first handle the time-critical fast lane events */
+            if (processFastLaneEvent())
+                continue;
+
+            /* then handle kernel internal events --> higher priority! */
             if (eventkcal_getEventCountCircbuf(kEventQueueKInt) > 0)
             {
                 eventkcal_processEventCircbuf(kEventQueueKInt);
@@ -373,4 +404,85 @@ static void signalKernelEvent(void)
     sem_post(instance_l.semKernelData);
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Post a fast lane event
+
+This function copies an event into the fast lane and signals the event thread.
+The fast lane bypasses the circular buffer of the kernel-internal queue.
+
+\param[in]      pEvent_p            Event to be posted.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError postFastLaneEvent(const tEvent* pEvent_p)
+{
+    tEventkCalFastLaneEvent*    pFastLaneEvent;
+
+    if (pEvent_p->eventArgSize > MAX_EVENT_ARG_SIZE)
+        return kErrorEventPostError;
+
+    pthread_mutex_lock(&instance_l.fastLaneMutex);
+
+    if ((instance_l.fastLaneWriteIndex - instance_l.fastLaneReadIndex) >= EVENTKCAL_FAST_LANE_SIZE)
+    {
+        pthread_mutex_unlock(&instance_l.fastLaneMutex);
+        DEBUG_LVL_ERROR_TRACE("%s() Fast lane is full!\n", __func__);
+        return kErrorEventPostError;
+    }
+
+    pFastLaneEvent = &instance_l.aFastLane[instance_l.fastLaneWriteIndex % EVENTKCAL_FAST_LANE_SIZE];
+    pFastLaneEvent->event = *pEvent_p;
+    if (pEvent_p->eventArgSize > 0)
+        OPLK_MEMCPY(pFastLaneEvent->aArg, pEvent_p->eventArg.pEventArg, pEvent_p->eventArgSize);
+    instance_l.fastLaneWriteIndex++;
+
+    pthread_mutex_unlock(&instance_l.fastLaneMutex);
+
+    signalKernelEvent();
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process a fast lane event
+
+This function processes the oldest event of the fast lane. It is called by the
+event thread.
+
+\return The function returns TRUE if an event was processed, FALSE if the
+        fast lane is empty.
+*/
+//------------------------------------------------------------------------------
+static BOOL processFastLaneEvent(void)
+{
+    tEventkCalFastLaneEvent*    pFastLaneEvent;
+
+    pthread_mutex_lock(&instance_l.fastLaneMutex);
+    if (instance_l.fastLaneReadIndex == instance_l.fastLaneWriteIndex)
+    {
+        pthread_mutex_unlock(&instance_l.fastLaneMutex);
+        return FALSE;
+    }
+
+    // the event is not overwritten before the read index is incremented
+    pFastLaneEvent = &instance_l.aFastLane[instance_l.fastLaneReadIndex % EVENTKCAL_FAST_LANE_SIZE];
+    pthread_mutex_unlock(&instance_l.fastLaneMutex);
+
+    if (pFastLaneEvent->event.eventArgSize > 0)
+        pFastLaneEvent->event.eventArg.pEventArg = pFastLaneEvent->aArg;
+    else
+        pFastLaneEvent->event.eventArg.pEventArg = NULL;
+
+    eventk_process(&pFastLaneEvent->event);
+
+    pthread_mutex_lock(&instance_l.fastLaneMutex);
+    instance_l.fastLaneReadIndex++;
+    pthread_mutex_unlock(&instance_l.fastLaneMutex);
+
+    return TRUE;
+}
+
 /// \}
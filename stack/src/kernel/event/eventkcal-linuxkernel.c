@@ -5,7 +5,10 @@
 \brief  Kernel event CAL module for Linux kernelspace
 
 This file implements the kernel event handler CAL module for the Linux
-kernelspace platform. It uses the circular buffer interface for all event queues.
+kernelspace platform. It uses the circular buffer interface for the kernel
+event queues. Events for the user layer are written into the event ring of the
+event shared memory (tEventShm), which is mapped into the user layer and read
+there without a system call per event.
 
 \see eventkcalintf-circbuf.c
 
@@ -46,6 +49,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/oplkinc.h>
 #include <kernel/eventkcal.h>
 #include <kernel/eventkcalintf.h>
+#include <common/driver.h>
 #include <oplk/debugstr.h>
 
 #include <linux/kthread.h>
@@ -56,6 +60,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <linux/sched.h>
 #include <linux/cpumask.h>
 #include <linux/uaccess.h>
+#include <linux/spinlock.h>
 #if (LINUX_VERSION_CODE >= KERNEL_VERSION(4, 15, 0))
 /* Included types.h header to link sched_param structure */
 #include <linux/sched/types.h>
@@ -103,12 +108,11 @@ typedef struct
     struct task_struct*     threadId;
     wait_queue_head_t       kernelWaitQueue;
     wait_queue_head_t       userWaitQueue;
-    atomic_t                userEventCount;
     atomic_t                kernelEventCount;
     BOOL                    fThreadIsRunning;
     BOOL                    fInitialized;
-    BYTE                    aUintRxBuffer[sizeof(tEvent) + MAX_EVENT_ARG_SIZE];
-    BYTE                    aK2URxBuffer[sizeof(tEvent) + MAX_EVENT_ARG_SIZE];
+    tEventShm*              pEventShm;          ///< Event shared memory mapped into the user layer
+    spinlock_t              eventShmLock;       ///< Lock for writing into the event ring
 } tEventkCalInstance;
 
 //------------------------------------------------------------------------------
@@ -120,9 +124,9 @@ static tEventkCalInstance   instance_l;             ///< Instance variable of ke
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
-static int  eventThread(void* arg);
-static void signalUserEvent(void);
-static void signalKernelEvent(void);
+static int          eventThread(void* arg);
+static void         signalKernelEvent(void);
+static tOplkError   postEventShm(const tEvent* pEvent_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -150,26 +154,22 @@ tOplkError eventkcal_init(void)
     init_waitqueue_head(&instance_l.kernelWaitQueue);
     init_waitqueue_head(&instance_l.userWaitQueue);
     atomic_set(&instance_l.kernelEventCount, 0);
-    atomic_set(&instance_l.userEventCount, 0);
+    spin_lock_init(&instance_l.eventShmLock);
 
-    if (eventkcal_initQueueCircbuf(kEventQueueK2U) != kErrorOk)
+    instance_l.pEventShm = (tEventShm*)__get_free_pages(GFP_KERNEL, get_order(sizeof(tEventShm)));
+    if (instance_l.pEventShm == NULL)
         goto Exit;
 
+    OPLK_MEMSET(instance_l.pEventShm, 0, sizeof(tEventShm));
+
     if (eventkcal_initQueueCircbuf(kEventQueueU2K) != kErrorOk)
         goto Exit;
 
     if (eventkcal_initQueueCircbuf(kEventQueueKInt) != kErrorOk)
         goto Exit;
 
-    if (eventkcal_initQueueCircbuf(kEventQueueUInt) != kErrorOk)
-        goto Exit;
-
-    eventkcal_setSignalingCircbuf(kEventQueueK2U, signalUserEvent);
-
     eventkcal_setSignalingCircbuf(kEventQueueU2K, signalKernelEvent);
 
-    eventkcal_setSignalingCircbuf(kEventQueueUInt, signalUserEvent);
-
     eventkcal_setSignalingCircbuf(kEventQueueKInt, signalKernelEvent);
 
     instance_l.threadId = kthread_run(eventThread, NULL, "EventkThread");
@@ -188,10 +188,14 @@ tOplkError eventkcal_init(void)
 
 Exit:
     DEBUG_LVL_ERROR_TRACE("%s() Initialization error!\n", __func__);
-    eventkcal_exitQueueCircbuf(kEventQueueK2U);
     eventkcal_exitQueueCircbuf(kEventQueueU2K);
     eventkcal_exitQueueCircbuf(kEventQueueKInt);
-    eventkcal_exitQueueCircbuf(kEventQueueUInt);
+
+    if (instance_l.pEventShm != NULL)
+    {
+        free_pages((ULONG)instance_l.pEventShm, get_order(sizeof(tEventShm)));
+        instance_l.pEventShm = NULL;
+    }
 
     return kErrorNoResource;
 }
@@ -216,6 +220,9 @@ tOplkError eventkcal_exit(void)
 
     instance_l.fInitialized = FALSE;
 
+    // Release a user thread which waits for events
+    wake_up_interruptible(&instance_l.userWaitQueue);
+
     if (instance_l.threadId)
         kthread_stop(instance_l.threadId);
 
@@ -231,11 +238,15 @@ tOplkError eventkcal_exit(void)
         }
     }
 
-    eventkcal_exitQueueCircbuf(kEventQueueK2U);
     eventkcal_exitQueueCircbuf(kEventQueueU2K);
-    eventkcal_exitQueueCircbuf(kEventQueueUInt);
     eventkcal_exitQueueCircbuf(kEventQueueKInt);
 
+    if (instance_l.pEventShm != NULL)
+    {
+        free_pages((ULONG)instance_l.pEventShm, get_order(sizeof(tEventShm)));
+        instance_l.pEventShm = NULL;
+    }
+
     return kErrorOk;
 }
 
@@ -268,7 +279,7 @@ tOplkError eventkcal_postUserEvent(const tEvent* pEvent_p)
                            pEvent_p->eventArgSize);
 
     if (instance_l.fInitialized)
-        ret = eventkcal_postEventCircbuf(kEventQueueK2U, pEvent_p);
+        ret = postEventShm(pEvent_p);
     else
         ret = kErrorIllegalInstance;
 
@@ -399,7 +410,7 @@ int eventkcal_postEventFromUser(ULONG arg)
                                    debugstr_getEventSinkStr(event.eventSink),
                                    event.eventSink,
                                    event.eventArgSize);
-            ret = eventkcal_postEventCircbuf(kEventQueueUInt, &event);
+            ret = postEventShm(&event);
             break;
 
         default:
@@ -415,29 +426,31 @@ int eventkcal_postEventFromUser(ULONG arg)
 
 //------------------------------------------------------------------------------
 /**
-\brief    Get an event for the user layer
+\brief    Wait for events for the user layer
 
-This function waits for events to the user.
+This function waits until the event ring of the event shared memory contains
+events which have not been read by the user layer. The events are read by
+the user layer directly from the shared memory.
 
-\param[in]      arg                 Ioctl argument. Contains the received event.
+\param[in]      arg                 Ioctl argument. Contains the current read
+                                    offset of the user layer.
 
 \return The function returns Linux error code.
 
 \ingroup module_eventkcal
 */
 //------------------------------------------------------------------------------
-int eventkcal_getEventForUser(ULONG arg)
+int eventkcal_waitEventForUser(ULONG arg)
 {
-    tOplkError  error;
-    int         ret;
-    size_t      readSize;
-    int         timeout = 500 * HZ / 1000;
+    int ret;
+    int timeout = 500 * HZ / 1000;
 
     if (!instance_l.fInitialized)
         return -EIO;
 
     ret = wait_event_interruptible_timeout(instance_l.userWaitQueue,
-                                           (atomic_read(&instance_l.userEventCount) > 0),
+                                           (!instance_l.fInitialized ||
+                                            (instance_l.pEventShm->writeOffset != (UINT32)arg)),
                                            timeout);
     if (ret == 0)
     {
@@ -454,46 +467,34 @@ int eventkcal_getEventForUser(ULONG arg)
     if (!instance_l.fInitialized)
         return -EIO;
 
-    if (eventkcal_getEventCountCircbuf(kEventQueueK2U) > 0)
-    {
-        atomic_dec(&instance_l.userEventCount);
+    return 0;
+}
 
-        error = eventkcal_getEventCircbuf(kEventQueueK2U, instance_l.aK2URxBuffer, &readSize);
-        if (error != kErrorOk)
-        {
-            DEBUG_LVL_ERROR_TRACE("%s() Error reading K2U events %d!\n", __func__, error);
-            return -EIO;
-        }
+//------------------------------------------------------------------------------
+/**
+\brief    Get event shared memory
 
-        DEBUG_LVL_EVENTK_TRACE("%s() copy kernel event to user: %d Bytes\n", __func__, readSize);
-        if (copy_to_user((void __user *)arg, instance_l.aK2URxBuffer, readSize))
-            return -EFAULT;
+The function returns the event shared memory which is mapped into the user
+layer.
 
-        return 0;
-    }
-    else
-    {
+\param[out]     ppEventMem_p        Pointer to store the address of the event memory.
+\param[out]     pEventMemSize_p     Pointer to store the size of the event memory.
 
-        if (eventkcal_getEventCountCircbuf(kEventQueueUInt) > 0)
-        {
-            atomic_dec(&instance_l.userEventCount);
+\return The function returns a tOplkError error code.
 
-            error = eventkcal_getEventCircbuf(kEventQueueUInt, instance_l.aUintRxBuffer, &readSize);
-            if (error != kErrorOk)
-            {
-                DEBUG_LVL_ERROR_TRACE("%s() Error reading UINT events %d!\n", __func__, error);
-                return -EIO;
-            }
+\ingroup module_eventkcal
+*/
+//------------------------------------------------------------------------------
+tOplkError eventkcal_getEventMem(void** ppEventMem_p, size_t* pEventMemSize_p)
+{
+    if ((ppEventMem_p == NULL) || (instance_l.pEventShm == NULL))
+        return kErrorInvalidOperation;
 
-            DEBUG_LVL_EVENTK_TRACE("%s() copy user event to user: %d Bytes\n", __func__, readSize);
-            if (copy_to_user((void __user *)arg, instance_l.aUintRxBuffer, readSize))
-                return -EFAULT;
+    *ppEventMem_p = instance_l.pEventShm;
+    if (pEventMemSize_p != NULL)
+        *pEventMemSize_p = sizeof(tEventShm);
 
-            return 0;
-        }
-    }
-
-    return -ERESTARTSYS;
+    return kErrorOk;
 }
 
 //============================================================================//
@@ -562,30 +563,90 @@ static int eventThread(void* arg)
 
 //------------------------------------------------------------------------------
 /**
-\brief  Signal a user event
+\brief  Signal a kernel event
 
-This function signals that a user event was posted. It will be registered in
+This function signals that a kernel event was posted. It will be registered in
 the circular buffer library as signal callback function
 */
 //------------------------------------------------------------------------------
-static void signalUserEvent(void)
+static void signalKernelEvent(void)
 {
-    atomic_inc(&instance_l.userEventCount);
-    wake_up_interruptible(&instance_l.userWaitQueue);
+    atomic_inc(&instance_l.kernelEventCount);
+    wake_up_interruptible(&instance_l.kernelWaitQueue);
 }
 
 //------------------------------------------------------------------------------
 /**
-\brief  Signal a kernel event
+\brief  Post an event into the event shared memory
 
-This function signals that a kernel event was posted. It will be registered in
-the circular buffer library as signal callback function
+This function writes an event for the user layer into the event ring of the
+event shared memory and wakes up a user thread which waits for events. If the
+entry does not fit between the current write position and the end of the ring,
+a padding entry is inserted and the event is written at the ring start.
+
+\param[in]      pEvent_p            Event to be posted.
+
+\return The function returns a tOplkError error code.
 */
 //------------------------------------------------------------------------------
-static void signalKernelEvent(void)
+static tOplkError postEventShm(const tEvent* pEvent_p)
 {
-    atomic_inc(&instance_l.kernelEventCount);
-    wake_up_interruptible(&instance_l.kernelWaitQueue);
+    tEventShm*      pEventShm = instance_l.pEventShm;
+    tEventShmEntry* pEntry;
+    ULONG           flags;
+    UINT32          eventSize;
+    UINT32          entrySize;
+    UINT32          padSize;
+    UINT32          writeOffset;
+    UINT32          ringOffset;
+
+    eventSize = sizeof(tEvent) + pEvent_p->eventArgSize;
+    entrySize = ALIGN(sizeof(tEventShmEntry) + eventSize, PLK_EVENT_SHM_ALIGN);
+
+    spin_lock_irqsave(&instance_l.eventShmLock, flags);
+
+    writeOffset = pEventShm->writeOffset;
+    ringOffset = writeOffset & (PLK_EVENT_SHM_RING_SIZE - 1);
+    padSize = PLK_EVENT_SHM_RING_SIZE - ringOffset;
+    if (padSize >= entrySize)
+        padSize = 0;
+
+    if ((writeOffset - pEventShm->readOffset) + padSize + entrySize > PLK_EVENT_SHM_RING_SIZE)
+    {
+        spin_unlock_irqrestore(&instance_l.eventShmLock, flags);
+        DEBUG_LVL_ERROR_TRACE("%s() Event ring full!\n", __func__);
+        return kErrorEventPostError;
+    }
+
+    if (padSize != 0)
+    {
+        pEntry = (tEventShmEntry*)&pEventShm->aRing[ringOffset];
+        pEntry->entrySize = padSize;
+        pEntry->eventSize = 0;
+        writeOffset += padSize;
+        ringOffset = 0;
+    }
+
+    pEntry = (tEventShmEntry*)&pEventShm->aRing[ringOffset];
+    pEntry->entrySize = entrySize;
+    pEntry->eventSize = eventSize;
+    OPLK_MEMCPY(pEntry + 1, pEvent_p, sizeof(tEvent));
+    if (pEvent_p->eventArgSize != 0)
+    {
+        OPLK_MEMCPY((UINT8*)(pEntry + 1) + sizeof(tEvent),
+                    pEvent_p->eventArg.pEventArg,
+                    pEvent_p->eventArgSize);
+    }
+
+    // The entry must be visible before the new write offset
+    smp_wmb();
+    pEventShm->writeOffset = writeOffset + entrySize;
+
+    spin_unlock_irqrestore(&instance_l.eventShmLock, flags);
+
+    wake_up_interruptible(&instance_l.userWaitQueue);
+
+    return kErrorOk;
 }
 
 /// \}
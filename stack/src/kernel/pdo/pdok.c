@@ -44,10 +44,17 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/pdok.h>
 #include <kernel/pdokcal.h>
 #include <kernel/pdoklut.h>
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+#include <kernel/pdokrxworker.h>
+#endif
 #include <kernel/dllk.h>
 #include <common/ami.h>
 #include <oplk/debugstr.h>
 
+#if !defined(__GNUC__)
+#include <common/target.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -73,10 +80,51 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // const defines
 //------------------------------------------------------------------------------
 
+// The channel updates are staged by the event handler and applied by the sync
+// callback of the DLL, which may run in a different thread. The lock flag is
+// accessed by both contexts, therefore an atomic test-and-set is required.
+// OPLK_ATOMIC_EXCHANGE() is only usable for the shared PDO memory.
+#if defined(__GNUC__)
+#define PDOK_TEST_AND_SET(pFlag)        __sync_lock_test_and_set((pFlag), TRUE)
+#define PDOK_RELEASE(pFlag)             __sync_lock_release(pFlag)
+#else
+#define PDOK_TEST_AND_SET(pFlag)        testAndSet(pFlag)
+#define PDOK_RELEASE(pFlag)             do { OPLK_MEMBAR(); *(pFlag) = FALSE; } while (0)
+#endif
+
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
 
+/**
+\brief Report time of a PDO channel configuration
+
+The enumeration defines when the configuration counter of an applied channel
+update is reported to the user layer. The user layer switches its mapping
+when the counter is reported.
+*/
+typedef enum
+{
+    kPdokReportBeforeApply = 0,     ///< Report at the cycle boundary before the update is applied
+    kPdokReportOnApply,             ///< Report at the cycle boundary the update is applied
+    kPdokReportAfterApply,          ///< Report at the cycle boundary after the update is applied
+} tPdokReportTime;
+
+/**
+\brief PDO channel update
+
+The following structure holds a channel configuration which is applied to a
+running PDO channel at the next cycle boundary.
+*/
+typedef struct
+{
+    tPdoChannel             pdoChannel;                             ///< New configuration of the PDO channel
+    UINT8                   configCount;                            ///< Configuration counter of the user layer
+    BOOL                    fPending;                               ///< Flag determines if the update waits to be applied
+    BOOL                    fReported;                              ///< Flag determines if the pending update has already been reported
+    BOOL                    fReportPending;                         ///< Flag determines if the applied update is reported at the next cycle boundary
+} tPdokChannelUpdate;
+
 /**
 \brief Kernel PDO module instance
 
@@ -89,6 +137,12 @@ typedef struct
     BOOL                    fRunning;                               ///< Flag determines if PDO engine is running
     tPdoklutEntry           aTxPdoLut[D_PDO_TPDOChannels_U16];      ///< TX PDO lookup table used for fast search of PDO channels
     tPdoklutEntry           aRxPdoLut[D_PDO_RPDOChannels_U16];      ///< RX PDO lookup table used for fast search of PDO channels
+    UINT16                  aTxChannelSize[D_PDO_TPDOChannels_U16]; ///< Size of the TPDO channel buffers in the PDO memory
+    UINT16                  aRxChannelSize[D_PDO_RPDOChannels_U16]; ///< Size of the RPDO channel buffers in the PDO memory
+    tPdokChannelUpdate      aTxUpdate[D_PDO_TPDOChannels_U16];      ///< TPDO channel updates applied at the next cycle boundary
+    tPdokChannelUpdate      aRxUpdate[D_PDO_RPDOChannels_U16];      ///< RPDO channel updates applied at the next cycle boundary
+    BOOL                    fUpdatePending;                         ///< Flag determines if channel updates are pending
+    volatile UINT8          fUpdateLocked;                          ///< Flag determines if the channel updates are locked by the event handler
 } tPdokInstance;
 
 //------------------------------------------------------------------------------
@@ -102,6 +156,21 @@ static tPdokInstance  pdokInstance_g;
 static tOplkError cbProcessTpdo(tFrameInfo* pFrameInfo_p, BOOL fReadyFlag_p) SECTION_PDOK_PROCESS_TPDO_CB;
 static tOplkError copyTxPdo(tPlkFrame* pFrame_p, UINT frameSize_p, BOOL fReadyFlag_p);
 static void       disablePdoChannels(tPdoChannel* pPdoChannel, UINT channelCnt);
+static void       applyChannelConfig(tPdoChannel* pDestPdoChannel_p,
+                                     tPdoklutEntry* pLut_p,
+                                     const tPdoChannel* pPdoChannel_p,
+                                     UINT8 channelId_p);
+static void       applyChannelUpdates(tPdoChannel* pPdoChannel_p,
+                                      tPdoklutEntry* pLut_p,
+                                      tPdokChannelUpdate* pUpdate_p,
+                                      UINT channelCnt_p,
+                                      BOOL fTx_p,
+                                      tPdokReportTime reportTime_p);
+static void       lockChannelUpdates(void);
+static void       unlockChannelUpdates(void);
+#if !defined(__GNUC__)
+static UINT8      testAndSet(volatile UINT8* pFlag_p);
+#endif
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -185,6 +254,10 @@ tOplkError pdok_deAllocChannelMem(void)
     }
 #endif // NMT_MAX_NODE_ID > 0
 
+    // the sync callback shall not apply channel updates to the freed channels
+    lockChannelUpdates();
+    pdokInstance_g.fUpdatePending = FALSE;
+
     // de-allocate mem for RX PDO channels
     if (pdokInstance_g.pdoChannels.allocation.rxPdoChannelCount != 0)
     {
@@ -207,6 +280,8 @@ tOplkError pdok_deAllocChannelMem(void)
         }
     }
 
+    unlockChannelUpdates();
+
     return ret;
 }
 
@@ -234,6 +309,15 @@ tOplkError pdok_allocChannelMem(const tPdoAllocationParam* pAllocationParam_p)
     // Check parameter validity
     ASSERT(pAllocationParam_p != NULL);
 
+    // the PDO memory layout is rebuilt, therefore stop the PDO engine and
+    // discard all channel updates which have not been applied yet. The updates
+    // stay locked until the channels are reallocated.
+    lockChannelUpdates();
+    pdokInstance_g.fRunning = FALSE;
+    pdokInstance_g.fUpdatePending = FALSE;
+    OPLK_MEMSET(pdokInstance_g.aTxUpdate, 0, sizeof(pdokInstance_g.aTxUpdate));
+    OPLK_MEMSET(pdokInstance_g.aRxUpdate, 0, sizeof(pdokInstance_g.aRxUpdate));
+
 #if (NMT_MAX_NODE_ID > 0)
     nodeOpParam.opNodeType = kDllNodeOpTypeFilterPdo;
     nodeOpParam.nodeId = C_ADR_BROADCAST;
@@ -301,6 +385,7 @@ tOplkError pdok_allocChannelMem(const tPdoAllocationParam* pAllocationParam_p)
                        pdokInstance_g.pdoChannels.allocation.txPdoChannelCount);
 
 Exit:
+    unlockChannelUpdates();
     return ret;
 }
 
@@ -308,6 +393,15 @@ Exit:
 /**
 \brief  Configures the specified PDO channel
 
+If the PDO engine is running and the new channel configuration fits into the
+buffer of the channel in the PDO memory, only this channel is updated. The
+update is applied at the next cycle boundary by pdok_processSync() and the
+other channels keep running. Otherwise the PDO engine is stopped until the
+PDO buffers are set up again.
+
+The configuration counter of the channel is reported to the user layer in the
+PDO memory when the configuration is applied (see applyChannelUpdates()).
+
 \param[in]      pChannelConf_p      PDO channel configuration
 
 \return The function returns a tOplkError error code.
@@ -317,8 +411,11 @@ Exit:
 //------------------------------------------------------------------------------
 tOplkError pdok_configureChannel(const tPdoChannelConf* pChannelConf_p)
 {
-    tOplkError      ret = kErrorOk;
-    tPdoChannel*    pDestPdoChannel;
+    tOplkError          ret = kErrorOk;
+    tPdoChannel*        pDestPdoChannel;
+    tPdoklutEntry*      pLut;
+    tPdokChannelUpdate* pUpdate;
+    UINT16              channelSize;
 
     // Check parameter validity
     ASSERT(pChannelConf_p != NULL);
@@ -337,24 +434,21 @@ tOplkError pdok_configureChannel(const tPdoChannelConf* pChannelConf_p)
         }
 
         pDestPdoChannel = &pdokInstance_g.pdoChannels.pRxPdoChannel[pChannelConf_p->channelId];
-
-        // copy channel configuration to local structure
-        OPLK_MEMCPY(pDestPdoChannel, &pChannelConf_p->pdoChannel, sizeof(pChannelConf_p->pdoChannel));
-
-        // Store channel ID for fast access
-        pdoklut_addChannel(pdokInstance_g.aRxPdoLut, pDestPdoChannel, pChannelConf_p->channelId);
+        pLut = pdokInstance_g.aRxPdoLut;
+        pUpdate = &pdokInstance_g.aRxUpdate[pChannelConf_p->channelId];
+        channelSize = pdokInstance_g.aRxChannelSize[pChannelConf_p->channelId];
 
 #if (NMT_MAX_NODE_ID > 0)
-        if ((pDestPdoChannel->nodeId != PDO_INVALID_NODE_ID) &&
-            (pDestPdoChannel->nodeId != PDO_PREQ_NODE_ID))
+        if ((pChannelConf_p->pdoChannel.nodeId != PDO_INVALID_NODE_ID) &&
+            (pChannelConf_p->pdoChannel.nodeId != PDO_PREQ_NODE_ID))
         {   // disable old PRes filter in DLL
-            nodeOpParam.nodeId = pDestPdoChannel->nodeId;
+            nodeOpParam.nodeId = pChannelConf_p->pdoChannel.nodeId;
             ret = dllk_deleteNode(&nodeOpParam);
             if (ret != kErrorOk)
                 goto Exit;
 
             // enable new PRes filter in DLL
-            nodeOpParam.nodeId = pDestPdoChannel->nodeId;
+            nodeOpParam.nodeId = pChannelConf_p->pdoChannel.nodeId;
             ret = dllk_addNode(&nodeOpParam);
             if (ret != kErrorOk)
                 goto Exit;
@@ -370,15 +464,40 @@ tOplkError pdok_configureChannel(const tPdoChannelConf* pChannelConf_p)
         }
 
         pDestPdoChannel = &pdokInstance_g.pdoChannels.pTxPdoChannel[pChannelConf_p->channelId];
+        pLut = pdokInstance_g.aTxPdoLut;
+        pUpdate = &pdokInstance_g.aTxUpdate[pChannelConf_p->channelId];
+        channelSize = pdokInstance_g.aTxChannelSize[pChannelConf_p->channelId];
+    }
 
-        // copy channel to local structure
-        OPLK_MEMCPY(pDestPdoChannel, &pChannelConf_p->pdoChannel, sizeof(pChannelConf_p->pdoChannel));
+    lockChannelUpdates();
 
-        // Store channel ID for fast access
-        pdoklut_addChannel(pdokInstance_g.aTxPdoLut, pDestPdoChannel, pChannelConf_p->channelId);
+    if (pdokInstance_g.fRunning)
+    {
+        if ((pChannelConf_p->pdoChannel.nextChannelOffset - pChannelConf_p->pdoChannel.offset) <= channelSize)
+        {   // channel fits into its buffer, swap it at the next cycle boundary
+            pUpdate->pdoChannel = pChannelConf_p->pdoChannel;
+            pUpdate->configCount = pChannelConf_p->configCount;
+            pUpdate->fPending = TRUE;
+            pUpdate->fReported = FALSE;
+            pdokInstance_g.fUpdatePending = TRUE;
+            unlockChannelUpdates();
+            goto Exit;
+        }
+
+        // PDO memory layout has to be rebuilt, stop the PDO engine until the
+        // PDO buffers are set up again
+        DEBUG_LVL_PDO_TRACE("%s() channel %d (TX:%d) exceeds its buffer, PDO engine stopped\n",
+                            __func__,
+                            pChannelConf_p->channelId,
+                            pChannelConf_p->fTx);
+        pdokInstance_g.fRunning = FALSE;
+        pUpdate->fPending = FALSE;
+        pUpdate->fReportPending = FALSE;
     }
 
-    pdokInstance_g.fRunning = FALSE;
+    applyChannelConfig(pDestPdoChannel, pLut, &pChannelConf_p->pdoChannel, pChannelConf_p->channelId);
+    pdokcal_setChannelConfigCount(pChannelConf_p->fTx, pChannelConf_p->channelId, pChannelConf_p->configCount);
+    unlockChannelUpdates();
 
 Exit:
     return ret;
@@ -501,7 +620,9 @@ The function sets up the memory used to store PDO frames.
 //------------------------------------------------------------------------------
 tOplkError pdok_setupPdoBuffers(size_t rxPdoMemSize_p, size_t txPdoMemSize_p)
 {
-    tOplkError  ret;
+    tOplkError          ret;
+    UINT                channelId;
+    const tPdoChannel*  pPdoChannel;
 
     ret = pdokcal_initPdoMem(&pdokInstance_g.pdoChannels,
                              rxPdoMemSize_p,
@@ -509,11 +630,115 @@ tOplkError pdok_setupPdoBuffers(size_t rxPdoMemSize_p, size_t txPdoMemSize_p)
     if (ret != kErrorOk)
         return ret;
 
+    // store the buffer sizes for the update of single channels
+    for (channelId = 0; channelId < pdokInstance_g.pdoChannels.allocation.rxPdoChannelCount; channelId++)
+    {
+        pPdoChannel = &pdokInstance_g.pdoChannels.pRxPdoChannel[channelId];
+        pdokInstance_g.aRxChannelSize[channelId] = pPdoChannel->nextChannelOffset - pPdoChannel->offset;
+    }
+
+    for (channelId = 0; channelId < pdokInstance_g.pdoChannels.allocation.txPdoChannelCount; channelId++)
+    {
+        pPdoChannel = &pdokInstance_g.pdoChannels.pTxPdoChannel[channelId];
+        pdokInstance_g.aTxChannelSize[channelId] = pPdoChannel->nextChannelOffset - pPdoChannel->offset;
+    }
+
     pdokInstance_g.fRunning = TRUE;
 
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Process sync
+
+The function is called once per cycle by the sync callback of the DLL. At this
+cycle boundary it applies the pending updates of single PDO channels, i.e.
+their channel configuration and lookup table entries. If the event handler is
+just modifying the channel updates, they are applied at the next cycle
+boundary. If the PDO memory is operated in the cycle-coherent mode, the PDO
+images are exchanged afterwards. If the RPDOs are processed by RPDO workers,
+the function waits until the workers have copied all received RPDOs. The
+workers are paused while the channel updates are applied.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_pdok
+*/
+//------------------------------------------------------------------------------
+tOplkError pdok_processSync(void)
+{
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+    BOOL    fPaused = pdokInstance_g.fUpdatePending;
+
+    // all RPDOs of the cycle shall be copied before the sync event is raised
+    // and the channel updates are applied
+    if (fPaused)
+        pdokrxworker_pause();
+    else
+        pdokrxworker_waitIdle();
+#endif
+
+    if (pdokInstance_g.fUpdatePending &&
+        !PDOK_TEST_AND_SET(&pdokInstance_g.fUpdateLocked))
+    {
+        pdokInstance_g.fUpdatePending = FALSE;
+
+        applyChannelUpdates(pdokInstance_g.pdoChannels.pRxPdoChannel,
+                            pdokInstance_g.aRxPdoLut,
+                            pdokInstance_g.aRxUpdate,
+                            pdokInstance_g.pdoChannels.allocation.rxPdoChannelCount,
+                            FALSE,
+                            kPdokReportAfterApply);
+        applyChannelUpdates(pdokInstance_g.pdoChannels.pTxPdoChannel,
+                            pdokInstance_g.aTxPdoLut,
+                            pdokInstance_g.aTxUpdate,
+                            pdokInstance_g.pdoChannels.allocation.txPdoChannelCount,
+                            TRUE,
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+                            kPdokReportBeforeApply);
+#else
+                            kPdokReportOnApply);
+#endif
+
+        PDOK_RELEASE(&pdokInstance_g.fUpdateLocked);
+    }
+
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+    if (fPaused)
+        pdokrxworker_resume();
+#endif
+
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+    return pdok_exchangePdoImage();
+#else
+    return kErrorOk;
+#endif
+}
+
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Exchange PDO images
+
+The function publishes the RPDOs received in the current cycle and takes over
+the TPDOs for the next cycle. It is called once per cycle before the sync
+event is forwarded to the user layer.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_pdok
+*/
+//------------------------------------------------------------------------------
+tOplkError pdok_exchangePdoImage(void)
+{
+    if (!pdokInstance_g.fRunning)
+        return kErrorOk;
+
+    return pdokcal_exchangePdoImage();
+}
+#endif
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -565,6 +790,154 @@ static void disablePdoChannels(tPdoChannel* pPdoChannel_p, UINT channelCnt_p)
     }
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Apply PDO channel configuration
+
+The function copies a new configuration to a PDO channel and moves the channel
+to the lookup table entry of its new node.
+
+\param[in,out]  pDestPdoChannel_p   Pointer to the PDO channel to be configured
+\param[in,out]  pLut_p              Pointer to the PDO lookup table
+\param[in]      pPdoChannel_p       Pointer to the new channel configuration
+\param[in]      channelId_p         Channel ID of the PDO channel
+*/
+//------------------------------------------------------------------------------
+static void applyChannelConfig(tPdoChannel* pDestPdoChannel_p,
+                               tPdoklutEntry* pLut_p,
+                               const tPdoChannel* pPdoChannel_p,
+                               UINT8 channelId_p)
+{
+    // remove channel ID of the old configuration
+    pdoklut_removeChannel(pLut_p, (UINT8)pDestPdoChannel_p->nodeId, channelId_p);
+
+    // copy channel configuration to local structure
+    OPLK_MEMCPY(pDestPdoChannel_p, pPdoChannel_p, sizeof(*pDestPdoChannel_p));
+
+    // Store channel ID for fast access
+    pdoklut_addChannel(pLut_p, pDestPdoChannel_p, channelId_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Apply pending PDO channel updates
+
+The function applies the pending updates of the PDO channels of a given
+direction (RX/TX) and reports their configuration counters to the user layer.
+The report is aligned to the PDO data exchanged with the user layer:
+
+- RPDO updates are reported at the boundary after they are applied, when the
+  first RPDOs received with the new configuration are passed to the user layer.
+- TPDO updates are reported when they are applied, as the TPDOs written by the
+  user layer after this boundary are sent with the new configuration.
+- In the cycle-coherent mode, TPDO updates are reported one boundary before
+  they are applied, as the TPDO image written after a boundary is taken over
+  at the following one.
+
+The function must be called with locked channel updates.
+
+\param[in,out]  pPdoChannel_p       Pointer to first PDO channel
+\param[in,out]  pLut_p              Pointer to the PDO lookup table
+\param[in,out]  pUpdate_p           Pointer to the first channel update
+\param[in]      channelCnt_p        Number of PDO channels
+\param[in]      fTx_p               TRUE for TPDO channels, FALSE for RPDO channels
+\param[in]      reportTime_p        Report time of the configuration counters
+*/
+//------------------------------------------------------------------------------
+static void applyChannelUpdates(tPdoChannel* pPdoChannel_p,
+                                tPdoklutEntry* pLut_p,
+                                tPdokChannelUpdate* pUpdate_p,
+                                UINT channelCnt_p,
+                                BOOL fTx_p,
+                                tPdokReportTime reportTime_p)
+{
+    UINT                index;
+    tPdokChannelUpdate* pUpdate;
+
+    for (index = 0, pUpdate = pUpdate_p; index < channelCnt_p; index++, pUpdate++)
+    {
+        if (pUpdate->fReportPending)
+        {
+            pdokcal_setChannelConfigCount(fTx_p, (UINT8)index, pUpdate->configCount);
+            pUpdate->fReportPending = FALSE;
+        }
+
+        if (!pUpdate->fPending)
+            continue;
+
+        if ((reportTime_p == kPdokReportBeforeApply) && !pUpdate->fReported)
+        {
+            pdokcal_setChannelConfigCount(fTx_p, (UINT8)index, pUpdate->configCount);
+            pUpdate->fReported = TRUE;
+            pdokInstance_g.fUpdatePending = TRUE;
+            continue;
+        }
+
+        applyChannelConfig(&pPdoChannel_p[index], pLut_p, &pUpdate->pdoChannel, (UINT8)index);
+        pUpdate->fPending = FALSE;
+
+        if (reportTime_p == kPdokReportOnApply)
+        {
+            pdokcal_setChannelConfigCount(fTx_p, (UINT8)index, pUpdate->configCount);
+        }
+        else if (reportTime_p == kPdokReportAfterApply)
+        {
+            pUpdate->fReportPending = TRUE;
+            pdokInstance_g.fUpdatePending = TRUE;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Lock the PDO channel updates
+
+The function locks the PDO channel updates against the sync callback. It waits
+until the sync callback has finished applying the updates.
+*/
+//------------------------------------------------------------------------------
+static void lockChannelUpdates(void)
+{
+    while (PDOK_TEST_AND_SET(&pdokInstance_g.fUpdateLocked))
+        ;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Unlock the PDO channel updates
+*/
+//------------------------------------------------------------------------------
+static void unlockChannelUpdates(void)
+{
+    PDOK_RELEASE(&pdokInstance_g.fUpdateLocked);
+}
+
+#if !defined(__GNUC__)
+//------------------------------------------------------------------------------
+/**
+\brief  Test and set a flag
+
+The function sets a flag and returns its previous value. It is used on targets
+without GCC builtins and accesses the flag with disabled interrupts.
+
+\param[in,out]  pFlag_p             Pointer to the flag.
+
+\return The function returns the previous value of the flag.
+*/
+//------------------------------------------------------------------------------
+static UINT8 testAndSet(volatile UINT8* pFlag_p)
+{
+    UINT8   flag;
+
+    target_enableGlobalInterrupt(FALSE);
+    flag = *pFlag_p;
+    *pFlag_p = TRUE;
+    target_enableGlobalInterrupt(TRUE);
+
+    return flag;
+}
+#endif
+
 //------------------------------------------------------------------------------
 /**
 \brief  Copy TX PDO
@@ -15,6 +15,14 @@ in the pdokcalmem-XX.c modules.
 A critical part is when switching the buffers. To implement safe operation
 without locking, the buffer switching has to be performed in an atomic operation.
 
+If CONFIG_PDO_CYCLE_COHERENT is enabled, the buffers are not switched per
+channel. The RPDOs of a cycle are written into the RPDO image of the write
+buffer and the whole image is published with a single buffer switch by
+pdokcal_exchangePdoImage() at the end of the cycle. At the same time the latest
+TPDO image published by the user layer is taken over for the next cycle.
+Channels which did not receive data in a cycle are tracked in a bitmap and
+their previous data is carried forward into the published image.
+
 \ingroup module_pdokcal
 *******************************************************************************/
 
@@ -76,6 +84,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define PDOKCAL_FRESH_MAP_SIZE      ((D_PDO_RPDOChannels_U16 + 31) / 32)
 
 //------------------------------------------------------------------------------
 // local types
@@ -88,11 +97,21 @@ static tPdoMemRegion*       pPdoMem_l;
 static size_t               pdoMemRegionSize_l;
 static void*                pTripleBuf_l[3];
 
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+static UINT8*               pRxImage_l;                                 // RPDO image in the current write buffer
+static const UINT8*         pRxPublishedImage_l;                        // RPDO image published last
+static const UINT8*         pTxImage_l;                                 // TPDO image in the current read buffer
+static UINT32               aRxFreshMap_l[PDOKCAL_FRESH_MAP_SIZE];      // RPDO channels written in the current cycle
+#endif
+
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
 static void setupPdoMemInfo(const tPdoChannelSetup* pPdoChannels_p,
                             tPdoMemRegion* pPdoMemRegion_p);
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+static void copyStaleRxChannels(UINT8* pDstImage_p, const UINT8* pSrcImage_p);
+#endif
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -180,6 +199,16 @@ tOplkError pdokcal_initPdoMem(const tPdoChannelSetup* pPdoChannels,
 
     OPLK_ATOMIC_INIT(pPdoMem_l);
 
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+    pRxImage_l = (UINT8*)pTripleBuf_l[pPdoMem_l->rxImageInfo.writeBuf] +
+                 pPdoMem_l->rxImageInfo.sectionOffset;
+    pRxPublishedImage_l = (const UINT8*)pTripleBuf_l[pPdoMem_l->rxImageInfo.cleanBuf] +
+                          pPdoMem_l->rxImageInfo.sectionOffset;
+    pTxImage_l = (const UINT8*)pTripleBuf_l[pPdoMem_l->txImageInfo.readBuf] +
+                 pPdoMem_l->txImageInfo.sectionOffset;
+    OPLK_MEMSET(aRxFreshMap_l, 0, sizeof(aRxFreshMap_l));
+#endif
+
     return kErrorOk;
 }
 
@@ -204,6 +233,12 @@ void pdokcal_cleanupPdoMem(void)
     pTripleBuf_l[0] = NULL;
     pTripleBuf_l[1] = NULL;
     pTripleBuf_l[2] = NULL;
+
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+    pRxImage_l = NULL;
+    pRxPublishedImage_l = NULL;
+    pTxImage_l = NULL;
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -224,11 +259,20 @@ The function writes a received RXPDO into the PDO memory range.
 tOplkError pdokcal_writeRxPdo(UINT8 channelId_p, const void* pPayload_p, UINT16 pdoSize_p)
 {
     void*           pPdo;
+#if (CONFIG_PDO_CYCLE_COHERENT == FALSE)
     OPLK_ATOMIC_T   temp;
+#endif
 
     // Check parameter validity
     ASSERT(pPayload_p != NULL);
 
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+    // The image is flushed and published in pdokcal_exchangePdoImage()
+    pPdo = pRxImage_l + pPdoMem_l->rxChannelInfo[channelId_p].channelOffset -
+           pPdoMem_l->rxImageInfo.sectionOffset;
+    OPLK_MEMCPY(pPdo, pPayload_p, pdoSize_p);
+    aRxFreshMap_l[channelId_p >> 5] |= (UINT32)1 << (channelId_p & 31);
+#else
     // Invalidate data cache for addressed rxChannelInfo
     OPLK_DCACHE_INVALIDATE(&(pPdoMem_l->rxChannelInfo[channelId_p]), sizeof(tPdoBufferInfo));
 
@@ -255,6 +299,7 @@ tOplkError pdokcal_writeRxPdo(UINT8 channelId_p, const void* pPayload_p, UINT16
     // Flush data cache for variables changed in this function
     OPLK_DCACHE_FLUSH(&(pPdoMem_l->rxChannelInfo[channelId_p]),
                       sizeof(tPdoBufferInfo));
+#endif
 
     //TRACE("%s() chan:%d new wi:%d\n", __func__, channelId_p, pPdoMem_l->rxChannelInfo[channelId_p].writeBuf);
     //TRACE("%s() *pPayload_p:%02x\n", __func__, *pPayload_p);
@@ -278,12 +323,19 @@ The function reads a TXPDO to be sent from the PDO memory range.
 //------------------------------------------------------------------------------
 tOplkError pdokcal_readTxPdo(UINT8 channelId_p, void* pPayload_p, UINT16 pdoSize_p)
 {
-    void*           pPdo;
+    const void*     pPdo;
+#if (CONFIG_PDO_CYCLE_COHERENT == FALSE)
     OPLK_ATOMIC_T   readBuf;
+#endif
 
     // Check parameter validity
     ASSERT(pPayload_p != NULL);
 
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+    // The image has been taken over and invalidated in pdokcal_exchangePdoImage()
+    pPdo = pTxImage_l + pPdoMem_l->txChannelInfo[channelId_p].channelOffset -
+           pPdoMem_l->txImageInfo.sectionOffset;
+#else
     // Invalidate data cache for addressed txChannelInfo
     OPLK_DCACHE_INVALIDATE(&(pPdoMem_l->txChannelInfo[channelId_p]), sizeof(tPdoBufferInfo));
 
@@ -309,12 +361,104 @@ tOplkError pdokcal_readTxPdo(UINT8 channelId_p, void* pPayload_p, UINT16 pdoSize
                         pPdoMem_l->txChannelInfo[channelId_p].readBuf);
 
     OPLK_DCACHE_INVALIDATE(pPdo, pdoSize_p);
+#endif
 
     OPLK_MEMCPY(pPayload_p, pPdo, pdoSize_p);
 
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set the configuration counter of a PDO channel
+
+The function reports the configuration counter of the channel configuration
+which is applied by the kernel layer to the user layer. The user layer switches
+the mapping of the channel when it reads the counter of its configuration.
+
+\param[in]      fTx_p               TRUE for a TPDO channel, FALSE for an RPDO channel.
+\param[in]      channelId_p         Channel ID of the PDO channel.
+\param[in]      configCount_p       Configuration counter of the applied configuration.
+
+\ingroup module_pdokcal
+*/
+//------------------------------------------------------------------------------
+void pdokcal_setChannelConfigCount(BOOL fTx_p, UINT8 channelId_p, UINT8 configCount_p)
+{
+    tPdoBufferInfo* pBufferInfo;
+
+    if (pPdoMem_l == NULL)
+        return;
+
+    if (fTx_p)
+        pBufferInfo = &pPdoMem_l->txChannelInfo[channelId_p];
+    else
+        pBufferInfo = &pPdoMem_l->rxChannelInfo[channelId_p];
+
+    OPLK_DCACHE_INVALIDATE(pBufferInfo, sizeof(tPdoBufferInfo));
+    pBufferInfo->configCount = configCount_p;
+    OPLK_DCACHE_FLUSH(pBufferInfo, sizeof(tPdoBufferInfo));
+}
+
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Exchange PDO images
+
+The function finishes the PDO exchange of a cycle. It publishes the RPDO image
+which has been written by pdokcal_writeRxPdo() to the user layer and takes over
+the latest TPDO image of the user layer for the following reads by
+pdokcal_readTxPdo(). It must be called once per cycle before the sync event is
+forwarded to the user layer.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_pdokcal
+*/
+//------------------------------------------------------------------------------
+tOplkError pdokcal_exchangePdoImage(void)
+{
+    tPdoImageInfo*  pImageInfo;
+    OPLK_ATOMIC_T   buf;
+
+    if (pPdoMem_l == NULL)
+        return kErrorInvalidOperation;
+
+    // Publish the RPDO image
+    pImageInfo = &pPdoMem_l->rxImageInfo;
+    OPLK_DCACHE_INVALIDATE(pImageInfo, sizeof(tPdoImageInfo));
+
+    // Channels without new data keep the data of the last published image
+    copyStaleRxChannels(pRxImage_l, pRxPublishedImage_l);
+    OPLK_MEMSET(aRxFreshMap_l, 0, sizeof(aRxFreshMap_l));
+    OPLK_DCACHE_FLUSH(pRxImage_l, pImageInfo->sectionSize);
+
+    buf = pImageInfo->writeBuf;
+    OPLK_ATOMIC_EXCHANGE(&pImageInfo->cleanBuf, buf, pImageInfo->writeBuf);
+    pImageInfo->newData = 1;
+    OPLK_DCACHE_FLUSH(pImageInfo, sizeof(tPdoImageInfo));
+
+    pRxPublishedImage_l = pRxImage_l;
+    pRxImage_l = (UINT8*)pTripleBuf_l[pImageInfo->writeBuf] + pImageInfo->sectionOffset;
+
+    // Take over the latest TPDO image
+    pImageInfo = &pPdoMem_l->txImageInfo;
+    OPLK_DCACHE_INVALIDATE(pImageInfo, sizeof(tPdoImageInfo));
+    if (pImageInfo->newData)
+    {
+        buf = pImageInfo->readBuf;
+        OPLK_ATOMIC_EXCHANGE(&pImageInfo->cleanBuf, buf, pImageInfo->readBuf);
+        pImageInfo->newData = 0;
+        OPLK_DCACHE_FLUSH(pImageInfo, sizeof(tPdoImageInfo));
+
+        pTxImage_l = (const UINT8*)pTripleBuf_l[pImageInfo->readBuf] + pImageInfo->sectionOffset;
+        OPLK_DCACHE_INVALIDATE(pTxImage_l, pImageInfo->sectionSize);
+    }
+
+    return kErrorOk;
+}
+#endif
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -350,8 +494,12 @@ static void setupPdoMemInfo(const tPdoChannelSetup* pPdoChannels_p,
         pPdoMemRegion_p->rxChannelInfo[channelId].writeBuf = 1;
         pPdoMemRegion_p->rxChannelInfo[channelId].cleanBuf = 2;
         pPdoMemRegion_p->rxChannelInfo[channelId].newData = 0;
+        pPdoMemRegion_p->rxChannelInfo[channelId].configCount = 0;
         offset += pPdoChannel->nextChannelOffset - pPdoChannel->offset;
     }
+    pPdoMemRegion_p->rxImageInfo.sectionOffset = 0;
+    pPdoMemRegion_p->rxImageInfo.sectionSize = offset;
+    pPdoMemRegion_p->rxImageInfo.channelCount = pPdoChannels_p->allocation.rxPdoChannelCount;
 
     for (channelId = 0, pPdoChannel = pPdoChannels_p->pTxPdoChannel;
          channelId < pPdoChannels_p->allocation.txPdoChannelCount;
@@ -363,11 +511,69 @@ static void setupPdoMemInfo(const tPdoChannelSetup* pPdoChannels_p,
         pPdoMemRegion_p->txChannelInfo[channelId].writeBuf = 1;
         pPdoMemRegion_p->txChannelInfo[channelId].cleanBuf = 2;
         pPdoMemRegion_p->txChannelInfo[channelId].newData = 0;
+        pPdoMemRegion_p->txChannelInfo[channelId].configCount = 0;
         offset += pPdoChannel->nextChannelOffset - pPdoChannel->offset;
     }
+    pPdoMemRegion_p->txImageInfo.sectionOffset = pPdoMemRegion_p->rxImageInfo.sectionSize;
+    pPdoMemRegion_p->txImageInfo.sectionSize = offset - pPdoMemRegion_p->rxImageInfo.sectionSize;
+    pPdoMemRegion_p->txImageInfo.channelCount = pPdoChannels_p->allocation.txPdoChannelCount;
     pPdoMemRegion_p->pdoMemSize = offset;
 
+    pPdoMemRegion_p->rxImageInfo.readBuf = 0;
+    pPdoMemRegion_p->rxImageInfo.writeBuf = 1;
+    pPdoMemRegion_p->rxImageInfo.cleanBuf = 2;
+    pPdoMemRegion_p->rxImageInfo.newData = 0;
+    pPdoMemRegion_p->txImageInfo.readBuf = 0;
+    pPdoMemRegion_p->txImageInfo.writeBuf = 1;
+    pPdoMemRegion_p->txImageInfo.cleanBuf = 2;
+    pPdoMemRegion_p->txImageInfo.newData = 0;
+    pPdoMemRegion_p->fCycleCoherent = (CONFIG_PDO_CYCLE_COHERENT != FALSE);
+
     OPLK_DCACHE_FLUSH(pPdoMemRegion_p, sizeof(tPdoMemRegion));
 }
 
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Copy stale RPDO channels
+
+The function copies all RPDO channels which have not been written in the
+current cycle from the last published image into the image to be published.
+
+\param[out]     pDstImage_p         Pointer to the RPDO image to be published.
+\param[in]      pSrcImage_p         Pointer to the last published RPDO image.
+*/
+//------------------------------------------------------------------------------
+static void copyStaleRxChannels(UINT8* pDstImage_p, const UINT8* pSrcImage_p)
+{
+    const tPdoImageInfo*    pImageInfo = &pPdoMem_l->rxImageInfo;
+    UINT                    channelId;
+    UINT                    mapIndex;
+    UINT32                  staleMap;
+    UINT32                  offset;
+    UINT32                  nextOffset;
+
+    for (mapIndex = 0; (mapIndex * 32) < pImageInfo->channelCount; mapIndex++)
+    {
+        // Skip the channels which have been written in this cycle
+        for (channelId = mapIndex * 32, staleMap = ~aRxFreshMap_l[mapIndex];
+             (staleMap != 0) && (channelId < pImageInfo->channelCount);
+             channelId++, staleMap >>= 1)
+        {
+            if ((staleMap & 1) == 0)
+                continue;
+
+            offset = pPdoMem_l->rxChannelInfo[channelId].channelOffset - pImageInfo->sectionOffset;
+            if (channelId + 1 < pImageInfo->channelCount)
+                nextOffset = pPdoMem_l->rxChannelInfo[channelId + 1].channelOffset - pImageInfo->sectionOffset;
+            else
+                nextOffset = pImageInfo->sectionSize;
+
+            OPLK_DCACHE_INVALIDATE(pSrcImage_p + offset, nextOffset - offset);
+            OPLK_MEMCPY(pDstImage_p + offset, pSrcImage_p + offset, nextOffset - offset);
+        }
+    }
+}
+#endif
+
 /// \}
@@ -47,6 +47,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/eventk.h>
 #include <common/ami.h>
 
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+#include <kernel/pdokrxworker.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -83,6 +87,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // local function prototypes
 //------------------------------------------------------------------------------
 static tOplkError cbProcessRpdo(const tFrameInfo* pFrameInfo_p) SECTION_PDOK_PROCESS_RPDO;
+static tOplkError processRxPdoEvent(const tEvent* pEvent_p);
 
 
 //============================================================================//
@@ -108,8 +113,24 @@ tOplkError pdokcal_init(void)
     if (ret != kErrorOk)
         return ret;
 
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+    ret = pdokrxworker_init();
+    if (ret != kErrorOk)
+    {
+        pdokcal_closeMem();
+        return ret;
+    }
+#endif
+
     dllk_regRpdoHandler(cbProcessRpdo);
 
+#if (CONFIG_PDOK_RX_WORKER_COUNT == 0)
+    ret = eventk_registerEventHandler(kEventSinkPdokCal,
+                                      kEventTypePdoRx,
+                                      processRxPdoEvent,
+                                      TRUE);
+#endif
+
     return ret;
 }
 
@@ -126,6 +147,10 @@ The function de-initializes the PDO kernel CAL module.
 //------------------------------------------------------------------------------
 tOplkError pdokcal_exit(void)
 {
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+    pdokrxworker_exit();
+#endif
+
     pdokcal_closeMem();
 
     return kErrorOk;
@@ -146,6 +171,17 @@ tOplkError pdokcal_process(const tEvent* pEvent_p)
 {
     tOplkError  ret;
 
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+    BOOL        fPaused;
+
+    // the PDO channels must not be changed while the workers process RPDOs
+    fPaused = ((pEvent_p->eventType == kEventTypePdokAlloc) ||
+               (pEvent_p->eventType == kEventTypePdokConfig) ||
+               (pEvent_p->eventType == kEventTypePdokSetupPdoBuf));
+    if (fPaused)
+        pdokrxworker_pause();
+#endif
+
     switch (pEvent_p->eventType)
     {
         case kEventTypePdokAlloc:
@@ -177,26 +213,31 @@ tOplkError pdokcal_process(const tEvent* pEvent_p)
             break;
 
         case kEventTypePdoRx:
-            {
-#if (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE)
-                const tFrameInfo* pFrameInfo;
+            ret = processRxPdoEvent(pEvent_p);
+            break;
 
-                pFrameInfo = (const tFrameInfo*)pEvent_p->eventArg.pEventArg;
-                ret = pdok_processRxPdo(pFrameInfo->frame.pBuffer, pFrameInfo->frameSize);
-#else
-                const tPlkFrame* pFrame;
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+        case kEventTypePdokRxWorker:
+            {
+                const tPdoRxWorkerParam* pRxWorkerParam;
 
-                pFrame = (const tPlkFrame*)pEvent_p->eventArg.pEventArg;
-                ret = pdok_processRxPdo(pFrame, pEvent_p->eventArgSize);
-#endif
+                pRxWorkerParam = (const tPdoRxWorkerParam*)pEvent_p->eventArg.pEventArg;
+                ret = pdokrxworker_setNodeWorker(pRxWorkerParam->nodeId,
+                                                 pRxWorkerParam->worker);
             }
             break;
+#endif
 
         default:
             ret = kErrorInvalidEvent;
             break;
     }
 
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+    if (fPaused)
+        pdokrxworker_resume();
+#endif
+
     return ret;
 }
 
@@ -222,6 +263,10 @@ valid.
 //------------------------------------------------------------------------------
 static tOplkError cbProcessRpdo(const tFrameInfo* pFrameInfo_p)
 {
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+    // the RPDOs are processed by the RPDO worker of the source node
+    return pdokrxworker_dispatch(pFrameInfo_p);
+#else
     tOplkError  ret;
     tEvent      event;
 
@@ -243,6 +288,34 @@ static tOplkError cbProcessRpdo(const tFrameInfo* pFrameInfo_p)
 #endif
 
     return ret;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process received PDO event
+
+This function is the event type handler of the received PDO event. It copies
+the RPDOs of the received frame into the PDO memory.
+
+\param[in]      pEvent_p            Pointer to the received PDO event.
+
+\return The function returns a tOplkError error code.
+**/
+//------------------------------------------------------------------------------
+static tOplkError processRxPdoEvent(const tEvent* pEvent_p)
+{
+#if (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE)
+    const tFrameInfo* pFrameInfo;
+
+    pFrameInfo = (const tFrameInfo*)pEvent_p->eventArg.pEventArg;
+    return pdok_processRxPdo(pFrameInfo->frame.pBuffer, pFrameInfo->frameSize);
+#else
+    const tPlkFrame* pFrame;
+
+    pFrame = (const tPlkFrame*)pEvent_p->eventArg.pEventArg;
+    return pdok_processRxPdo(pFrame, pEvent_p->eventArgSize);
+#endif
 }
 
 /// \}
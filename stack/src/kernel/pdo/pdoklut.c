@@ -160,6 +160,57 @@ tOplkError pdoklut_addChannel(tPdoklutEntry* pLut_p,
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Remove a PDO channel from the lookup table
+
+This function removes a PDO channel from the lookup table entry of the node
+\p nodeId_p. The following channels of the node are moved up, so that the
+entry stays contiguous for pdoklut_getChannel().
+
+\param[in,out]  pLut_p              Pointer to the PDO lookup table
+\param[in]      nodeId_p            Node ID the PDO channel was added for.
+\param[in]      channelId_p         Channel ID of the PDO channel to be removed.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_pdoklut
+**/
+//------------------------------------------------------------------------------
+tOplkError pdoklut_removeChannel(tPdoklutEntry* pLut_p,
+                                 UINT8 nodeId_p,
+                                 UINT8 channelId_p)
+{
+    tOplkError      ret = kErrorIllegalInstance;
+    int             i;
+
+    // Check parameter validity
+    ASSERT(pLut_p != NULL);
+
+    if (nodeId_p == PDO_INVALID_NODE_ID)
+        return ret;
+
+    for (i = 0; i < PDOKLUT_MAX_CHANNELS_PER_NODE; ++i)
+    {
+        if (pLut_p[nodeId_p].channelId[i] == PDOKLUT_INVALID_CHANNEL)
+            break;
+
+        if (ret == kErrorOk)
+        {   // move following channels up
+            pLut_p[nodeId_p].channelId[i - 1] = pLut_p[nodeId_p].channelId[i];
+            pLut_p[nodeId_p].channelId[i] = PDOKLUT_INVALID_CHANNEL;
+        }
+        else if (pLut_p[nodeId_p].channelId[i] == channelId_p)
+        {
+            DEBUG_LVL_PDO_TRACE ("Removing PDO Lut channel:%d node:%d index:%d\n", channelId_p, nodeId_p, i);
+            pLut_p[nodeId_p].channelId[i] = PDOKLUT_INVALID_CHANNEL;
+            ret = kErrorOk;
+        }
+    }
+
+    return ret;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get PDO channel from lookup table
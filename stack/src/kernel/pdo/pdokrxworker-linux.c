@@ -0,0 +1,641 @@
+/**
+********************************************************************************
+\file   pdokrxworker-linux.c
+
+\brief  Kernel RPDO worker module for Linux userspace
+
+This file implements a pool of worker threads which copy received RPDOs into
+the PDO memory. Every worker owns a single-producer single-consumer ring of
+received frames, which is filled by the receive context without locking. The
+frames of a node are always dispatched to the same worker, so that the RPDO
+channels of a node are only written by one thread. The DLL bookkeeping of the
+received frames stays in the receive context.
+
+\ingroup module_pdokrxworker
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <kernel/pdokrxworker.h>
+#include <kernel/pdok.h>
+#include <common/ami.h>
+#include <common/targetthread.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <time.h>
+
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+
+//------------------------------------------------------------------------------
+// check for correct compilation options
+//------------------------------------------------------------------------------
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+#error "RPDO workers require CONFIG_PDO_CYCLE_COHERENT == FALSE"
+#endif
+
+// Threads of the stack which are registered besides the RPDO workers: edrv,
+// 2 hrtimer, eventk, 2 eventu, timeru, sdoudp and veth
+#define PDOKRXWORKER_STACK_THREAD_COUNT     9
+
+#if (CONFIG_PDOK_RX_WORKER_COUNT > (TARGET_THREAD_MAX_COUNT - PDOKRXWORKER_STACK_THREAD_COUNT))
+#error "CONFIG_PDOK_RX_WORKER_COUNT exceeds the number of threads which can be registered"
+#endif
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define PDOKRXWORKER_NODE_COUNT         256     // node IDs 0 (PReq) to 255
+#define PDOKRXWORKER_DISPATCH_POLL_NS   1000    // poll interval while a frame is dispatched concurrently to a pause request
+#define PDOKRXWORKER_NO_FENCE           0xFF    // the frame need not wait for another worker
+
+#define PDOKRXWORKER_BARRIER()          __sync_synchronize()
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Queued frame
+
+If the Rx buffers are released deferred, the structure refers to the received
+frame, which is released by pdok_processRxPdo(). Otherwise it contains a copy
+of the frame up to the end of its PDO payload.
+
+The first frame of a node after the node was assigned to another worker carries
+a fence. It is processed after the previous worker of the node has processed
+the frames up to the fence index, so that the RPDOs of the node stay in order.
+*/
+typedef struct
+{
+    UINT8               fenceWorker;                                    ///< Previous worker of the node or PDOKRXWORKER_NO_FENCE
+    UINT                fenceIndex;                                     ///< Write index of the previous worker when the frame was queued
+#if (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE)
+    tFrameInfo          frameInfo;                                      ///< Received frame
+#else
+    UINT                frameSize;                                      ///< Size of the copied frame
+    UINT8               aFrame[C_DLL_MAX_ETH_FRAME];                    ///< Copy of the frame
+#endif
+} tPdokRxWorkerSlot;
+
+/**
+\brief RPDO worker
+
+The structure describes a worker thread and its frame ring. The read and write
+indices are free-running. The write index and the statistics are only written
+by the receive context, the read index is only written by the worker thread.
+The mutex and the condition are only used by threads which wait until the
+worker is idle, never by the receive context.
+*/
+typedef struct
+{
+    pthread_t               thread;                                     ///< Handle of the worker thread
+    sem_t                   semWork;                                    ///< Posted for every queued frame and if the worker shall stop
+    pthread_mutex_t         mutex;                                      ///< Mutex for waiting on condIdle
+    pthread_cond_t          condIdle;                                   ///< Signaled if a frame was processed and a thread waits for it
+    volatile UINT           writeIndex;                                 ///< Number of queued frames
+    volatile UINT           readIndex;                                  ///< Number of processed frames
+    volatile UINT           idleWaiterCount;                            ///< Number of threads waiting on condIdle
+    volatile BOOL           fStop;                                      ///< Flag determines if the worker shall stop
+    BOOL                    fStarted;                                   ///< Flag determines if the worker thread was started
+    tPdokRxWorkerStatistics statistics;                                 ///< Statistics of the dispatched frames
+    char                    aName[16];                                  ///< Name of the worker thread
+    tPdokRxWorkerSlot       aSlot[CONFIG_PDOK_RX_WORKER_QUEUE_SIZE];    ///< Frame ring
+} tPdokRxWorker;
+
+/**
+\brief RPDO worker instance
+
+The structure contains the workers and the assignment of the nodes to the
+workers. The assignment is written by pdokrxworker_setNodeWorker() and applied
+by the receive context, which keeps track of the worker the last frame of each
+node was queued to.
+*/
+typedef struct
+{
+    tPdokRxWorker           aWorker[CONFIG_PDOK_RX_WORKER_COUNT];       ///< RPDO workers
+    volatile UINT8          aNodeWorker[PDOKRXWORKER_NODE_COUNT];       ///< Assigned worker of each node
+    UINT8                   aDispatchWorker[PDOKRXWORKER_NODE_COUNT];   ///< Worker of the last queued frame of each node
+    volatile UINT           pauseCount;                                 ///< Number of pending pause requests, received frames are dropped if unequal to 0
+    volatile BOOL           fDispatching;                               ///< Flag determines if the receive context accesses a ring
+} tPdokRxWorkerInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tPdokRxWorkerInstance    instance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void* workerThread(void* pArg_p);
+static void  waitWorker(tPdokRxWorker* pWorker_p, UINT writeIndex_p);
+static void  stopWorker(tPdokRxWorker* pWorker_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the RPDO worker module
+
+The function starts the RPDO worker threads. The nodes are assigned to the
+workers in a round-robin manner by their node ID.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_pdokrxworker
+*/
+//------------------------------------------------------------------------------
+tOplkError pdokrxworker_init(void)
+{
+    UINT            i;
+    tPdokRxWorker*  pWorker;
+
+    OPLK_MEMSET(&instance_l, 0, sizeof(instance_l));
+
+    for (i = 0; i < PDOKRXWORKER_NODE_COUNT; i++)
+    {
+        instance_l.aNodeWorker[i] = (UINT8)(i % CONFIG_PDOK_RX_WORKER_COUNT);
+        instance_l.aDispatchWorker[i] = instance_l.aNodeWorker[i];
+    }
+
+    for (i = 0; i < CONFIG_PDOK_RX_WORKER_COUNT; i++)
+    {
+        pWorker = &instance_l.aWorker[i];
+
+        sem_init(&pWorker->semWork, 0, 0);
+        pthread_mutex_init(&pWorker->mutex, NULL);
+        pthread_cond_init(&pWorker->condIdle, NULL);
+        snprintf(pWorker->aName, sizeof(pWorker->aName), "oplk-pdorx%u", i);
+    }
+
+    for (i = 0; i < CONFIG_PDOK_RX_WORKER_COUNT; i++)
+    {
+        pWorker = &instance_l.aWorker[i];
+
+        if (pthread_create(&pWorker->thread, NULL, workerThread, pWorker) != 0)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() Couldn't create RPDO worker %u!\n", __func__, i);
+            pdokrxworker_exit();
+            return kErrorNoResource;
+        }
+
+        pWorker->fStarted = TRUE;
+        target_registerThread(pWorker->thread,
+                              kOplkApiThreadPdoRx,
+                              pWorker->aName,
+                              PDOKRXWORKER_THREAD_PRIORITY);
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up the RPDO worker module
+
+The function stops the RPDO worker threads. The workers are paused before, so
+that all queued frames are processed and released.
+
+\ingroup module_pdokrxworker
+*/
+//------------------------------------------------------------------------------
+void pdokrxworker_exit(void)
+{
+    UINT            i;
+    tPdokRxWorker*  pWorker;
+
+    // the workers are not resumed, frames received until the DLL is shut down
+    // are dropped
+    pdokrxworker_pause();
+
+    for (i = 0; i < CONFIG_PDOK_RX_WORKER_COUNT; i++)
+    {
+        pWorker = &instance_l.aWorker[i];
+
+        if (pWorker->fStarted)
+        {
+            target_unregisterThread(pWorker->thread);
+            stopWorker(pWorker);
+            pWorker->fStarted = FALSE;
+        }
+
+        pthread_cond_destroy(&pWorker->condIdle);
+        pthread_mutex_destroy(&pWorker->mutex);
+        sem_destroy(&pWorker->semWork);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Dispatch a received frame to its RPDO worker
+
+The function queues the received PRes or PReq frame in the ring of the worker
+assigned to the source node. It is called in the receive context of the DLL
+and never waits. If the Rx buffers are released deferred, the frame itself is
+queued and released by the worker. Otherwise the frame is copied up to the end
+of its PDO payload.
+
+If the workers are paused or the ring is full, the frame is dropped and counted
+in the statistics of the worker. The RPDOs are not processed in the receive
+context instead, because the RPDOs of a node must be written in order by one
+thread.
+
+\param[in]      pFrameInfo_p        Pointer to frame info structure
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The frame was copied or dropped, the Rx
+                                    buffer can be released.
+\retval kErrorReject                The frame was queued, the Rx buffer is
+                                    released by the worker.
+
+\ingroup module_pdokrxworker
+*/
+//------------------------------------------------------------------------------
+tOplkError pdokrxworker_dispatch(const tFrameInfo* pFrameInfo_p)
+{
+    const tPlkFrame*    pFrame = pFrameInfo_p->frame.pBuffer;
+    tPdokRxWorker*      pWorker;
+    tPdokRxWorkerSlot*  pSlot;
+    UINT                nodeId;
+    UINT8               worker;
+    UINT                writeIndex;
+    UINT                usedCount;
+#if (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC == FALSE)
+    UINT                frameSize;
+#endif
+
+    if ((tMsgType)ami_getUint8Le(&pFrame->messageType) == kMsgTypePreq)
+        nodeId = PDO_PREQ_NODE_ID;
+    else
+        nodeId = ami_getUint8Le(&pFrame->srcNodeId);
+
+    // announce the access to the ring before the pause count is checked,
+    // see pdokrxworker_pause()
+    instance_l.fDispatching = TRUE;
+    PDOKRXWORKER_BARRIER();
+
+    // frames which are received while the PDO channels are changed are dropped
+    if (instance_l.pauseCount != 0)
+    {
+        instance_l.aWorker[instance_l.aDispatchWorker[nodeId]].statistics.pauseDropCount++;
+        instance_l.fDispatching = FALSE;
+        return kErrorOk;
+    }
+
+    worker = instance_l.aNodeWorker[nodeId];
+    pWorker = &instance_l.aWorker[worker];
+    writeIndex = pWorker->writeIndex;
+    usedCount = writeIndex - pWorker->readIndex;
+    if (usedCount >= CONFIG_PDOK_RX_WORKER_QUEUE_SIZE)
+    {
+        // the worker is overloaded
+        pWorker->statistics.fullDropCount++;
+        instance_l.fDispatching = FALSE;
+        return kErrorOk;
+    }
+
+    pSlot = &pWorker->aSlot[writeIndex % CONFIG_PDOK_RX_WORKER_QUEUE_SIZE];
+    if (worker != instance_l.aDispatchWorker[nodeId])
+    {
+        // the node was assigned to another worker, the frames which are still
+        // queued for the previous worker must be processed first
+        pSlot->fenceWorker = instance_l.aDispatchWorker[nodeId];
+        pSlot->fenceIndex = instance_l.aWorker[pSlot->fenceWorker].writeIndex;
+        instance_l.aDispatchWorker[nodeId] = worker;
+    }
+    else
+        pSlot->fenceWorker = PDOKRXWORKER_NO_FENCE;
+
+#if (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE)
+    pSlot->frameInfo = *pFrameInfo_p;
+#else
+    // limit copied data to size of PDO (because from some CNs the frame is larger than necessary)
+    frameSize = ami_getUint16Le(&pFrame->data.pres.sizeLe) + PLK_FRAME_OFFSET_PDO_PAYLOAD;
+    frameSize = min(frameSize, min(pFrameInfo_p->frameSize, (UINT)C_DLL_MAX_ETH_FRAME));
+    OPLK_MEMCPY(pSlot->aFrame, pFrame, frameSize);
+    pSlot->frameSize = frameSize;
+#endif
+
+    // publish the slot before the write index
+    PDOKRXWORKER_BARRIER();
+    pWorker->writeIndex = writeIndex + 1;
+    sem_post(&pWorker->semWork);
+
+    pWorker->statistics.queuedCount++;
+    if (usedCount >= pWorker->statistics.maxUsedCount)
+        pWorker->statistics.maxUsedCount = usedCount + 1;
+
+    PDOKRXWORKER_BARRIER();
+    instance_l.fDispatching = FALSE;
+
+#if (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE)
+    return kErrorReject;    // the Rx buffer is released by the worker
+#else
+    return kErrorOk;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait until all queued frames are processed
+
+The function blocks until every worker has processed all frames which were
+queued before the call. It is the barrier which ensures that all RPDOs of a
+cycle are in the PDO memory before the sync event. Frames which are queued
+during the call are not waited for, therefore the function must not be used
+to protect the PDO channels against the workers (see pdokrxworker_pause()).
+
+\ingroup module_pdokrxworker
+*/
+//------------------------------------------------------------------------------
+void pdokrxworker_waitIdle(void)
+{
+    UINT            i;
+    tPdokRxWorker*  pWorker;
+
+    for (i = 0; i < CONFIG_PDOK_RX_WORKER_COUNT; i++)
+    {
+        pWorker = &instance_l.aWorker[i];
+        if (pWorker->fStarted)
+            waitWorker(pWorker, pWorker->writeIndex);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Pause the RPDO workers
+
+The function pauses the RPDO workers for changing the PDO channels. It waits until the workers have processed all queued
+frames. Until the workers are resumed by pdokrxworker_resume(), received frames
+are dropped, so that the workers do not access the PDO channels. The calls can
+be nested and may be issued by several threads.
+
+\ingroup module_pdokrxworker
+*/
+//------------------------------------------------------------------------------
+void pdokrxworker_pause(void)
+{
+    UINT                i;
+    tPdokRxWorker*      pWorker;
+    struct timespec     pollTime;
+
+    // full barrier, pairs with the barrier in pdokrxworker_dispatch(): either
+    // the receive context sees the pause count or the pause request sees the
+    // dispatch flag and waits until the frame is in the ring
+    __sync_fetch_and_add(&instance_l.pauseCount, 1);
+
+    pollTime.tv_sec = 0;
+    pollTime.tv_nsec = PDOKRXWORKER_DISPATCH_POLL_NS;
+    while (instance_l.fDispatching)
+        nanosleep(&pollTime, NULL);
+
+    for (i = 0; i < CONFIG_PDOK_RX_WORKER_COUNT; i++)
+    {
+        pWorker = &instance_l.aWorker[i];
+        if (pWorker->fStarted)
+            waitWorker(pWorker, pWorker->writeIndex);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Resume the RPDO workers
+
+The function resumes the RPDO workers which have been paused by
+pdokrxworker_pause().
+
+\ingroup module_pdokrxworker
+*/
+//------------------------------------------------------------------------------
+void pdokrxworker_resume(void)
+{
+    __sync_fetch_and_sub(&instance_l.pauseCount, 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Assign a node to an RPDO worker
+
+The function assigns the RPDOs received from a node to an RPDO worker. The
+assignment takes effect with the next frame of the node. The new worker
+processes this frame after the previous worker has processed the frames of the
+node which were queued before, therefore the workers need not be paused and no
+frames are dropped.
+
+\param[in]      nodeId_p            Node ID of the RPDO source (0 = PReq).
+\param[in]      worker_p            Index of the RPDO worker.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_pdokrxworker
+*/
+//------------------------------------------------------------------------------
+tOplkError pdokrxworker_setNodeWorker(UINT nodeId_p, UINT worker_p)
+{
+    if (nodeId_p >= PDOKRXWORKER_NODE_COUNT)
+        return kErrorInvalidNodeId;
+
+    if (worker_p >= CONFIG_PDOK_RX_WORKER_COUNT)
+        return kErrorInvalidInstanceParam;
+
+    instance_l.aNodeWorker[nodeId_p] = (UINT8)worker_p;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the statistics of an RPDO worker
+
+The function obtains the number of frames which were queued for an RPDO worker
+and the number of frames which were dropped. The counters are written by the
+receive context only and are read without locking.
+
+\param[in]      worker_p            Index of the RPDO worker.
+\param[out]     pStatistics_p       Pointer to memory where the statistics are
+                                    stored.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_pdokrxworker
+*/
+//------------------------------------------------------------------------------
+tOplkError pdokrxworker_getStatistics(UINT worker_p, tPdokRxWorkerStatistics* pStatistics_p)
+{
+    if (worker_p >= CONFIG_PDOK_RX_WORKER_COUNT)
+        return kErrorInvalidInstanceParam;
+
+    *pStatistics_p = instance_l.aWorker[worker_p].statistics;
+
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  RPDO worker thread function
+
+This function contains the main function of an RPDO worker thread. It processes
+the queued frames in the order of their reception.
+
+\param[in,out]  pArg_p              Pointer to the RPDO worker.
+
+\return The function returns the thread exit code.
+*/
+//------------------------------------------------------------------------------
+static void* workerThread(void* pArg_p)
+{
+    tPdokRxWorker*      pWorker = (tPdokRxWorker*)pArg_p;
+    tPdokRxWorkerSlot*  pSlot;
+    UINT                readIndex;
+
+    for (;;)
+    {
+        // the semaphore is posted after the write index is incremented
+        if (sem_wait(&pWorker->semWork) != 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (pWorker->fStop)
+            break;
+
+        readIndex = pWorker->readIndex;
+        pSlot = &pWorker->aSlot[readIndex % CONFIG_PDOK_RX_WORKER_QUEUE_SIZE];
+
+        // a fence refers to frames which were queued earlier, therefore the
+        // workers can't wait for each other in a cycle
+        if (pSlot->fenceWorker != PDOKRXWORKER_NO_FENCE)
+            waitWorker(&instance_l.aWorker[pSlot->fenceWorker], pSlot->fenceIndex);
+
+#if (CONFIG_DLL_DEFERRED_RXFRAME_RELEASE_SYNC != FALSE)
+        pdok_processRxPdo(pSlot->frameInfo.frame.pBuffer, pSlot->frameInfo.frameSize);
+#else
+        pdok_processRxPdo((const tPlkFrame*)pSlot->aFrame, pSlot->frameSize);
+#endif
+
+        // the slot may be overwritten after the read index is incremented;
+        // the second barrier pairs with the increment of the waiter count in
+        // waitWorker()
+        PDOKRXWORKER_BARRIER();
+        pWorker->readIndex = readIndex + 1;
+        PDOKRXWORKER_BARRIER();
+
+        if (pWorker->idleWaiterCount != 0)
+        {
+            pthread_mutex_lock(&pWorker->mutex);
+            pthread_cond_broadcast(&pWorker->condIdle);
+            pthread_mutex_unlock(&pWorker->mutex);
+        }
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for an RPDO worker
+
+The function blocks until the worker has processed the frames up to the given
+write index. It is called by threads which wait for the workers and by the
+workers themselves for processing a fence.
+
+\param[in,out]  pWorker_p           Pointer to the RPDO worker.
+\param[in]      writeIndex_p        Write index to wait for.
+*/
+//------------------------------------------------------------------------------
+static void waitWorker(tPdokRxWorker* pWorker_p, UINT writeIndex_p)
+{
+    __sync_fetch_and_add(&pWorker_p->idleWaiterCount, 1);
+
+    pthread_mutex_lock(&pWorker_p->mutex);
+    while (((INT)(writeIndex_p - pWorker_p->readIndex) > 0) && !pWorker_p->fStop)
+        pthread_cond_wait(&pWorker_p->condIdle, &pWorker_p->mutex);
+    pthread_mutex_unlock(&pWorker_p->mutex);
+
+    __sync_fetch_and_sub(&pWorker_p->idleWaiterCount, 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Stop an RPDO worker
+
+The function signals a worker thread to stop and waits for its termination.
+
+\param[in,out]  pWorker_p           Pointer to the RPDO worker.
+*/
+//------------------------------------------------------------------------------
+static void stopWorker(tPdokRxWorker* pWorker_p)
+{
+    pthread_mutex_lock(&pWorker_p->mutex);
+    pWorker_p->fStop = TRUE;
+    pthread_cond_broadcast(&pWorker_p->condIdle);
+    pthread_mutex_unlock(&pWorker_p->mutex);
+
+    sem_post(&pWorker_p->semWork);
+    pthread_join(pWorker_p->thread, NULL);
+}
+
+/// \}
+
+#endif /* (CONFIG_PDOK_RX_WORKER_COUNT != 0) */
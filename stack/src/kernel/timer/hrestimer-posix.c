@@ -44,6 +44,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
 #include <kernel/hrestimer.h>
+#include <common/targetthread.h>
 
 #include <time.h>
 #include <unistd.h>
@@ -143,7 +144,6 @@ tOplkError hrestimer_init(void)
 {
     tOplkError          ret = kErrorOk;
     UINT                index;
-    struct sched_param  schedParam;
     tHresTimerInfo*     pTimerInfo;
     struct sigevent     sev;
 
@@ -170,18 +170,17 @@ tOplkError hrestimer_init(void)
         return kErrorNoResource;
     }
 
-    schedParam.sched_priority = CONFIG_THREAD_PRIORITY_HIGH;
-    if (pthread_setschedparam(hresTimerInstance_l.threadId, SCHED_FIFO, &schedParam) != 0)
+    if (target_registerThread(hresTimerInstance_l.threadId,
+                              kOplkApiThreadHresTimer,
+                              "oplk-hrtimer",
+                              CONFIG_THREAD_PRIORITY_HIGH) != kErrorOk)
     {
         DEBUG_LVL_ERROR_TRACE("%s() Couldn't set thread scheduling parameters!\n", __func__);
+        target_unregisterThread(hresTimerInstance_l.threadId);
         pthread_cancel(hresTimerInstance_l.threadId);
         return kErrorNoResource;
     }
 
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(hresTimerInstance_l.threadId, "oplk-hrtimer");
-#endif
-
     return ret;
 }
 
@@ -45,6 +45,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/oplkinc.h>
 #include <common/ftracedebug.h>
 #include <kernel/hrestimer.h>
+#include <common/targetthread.h>
 
 #include <signal.h>
 #include <semaphore.h>
@@ -165,7 +166,6 @@ tOplkError hrestimer_init(void)
 {
     tOplkError          ret = kErrorOk;
     UINT                index;
-    struct sched_param  schedParam;
     tHresTimerInfo*     pTimerInfo;
 
     OPLK_MEMSET(&hresTimerInstance_l, 0, sizeof(hresTimerInstance_l));
@@ -193,18 +193,17 @@ tOplkError hrestimer_init(void)
             return kErrorNoResource;
         }
 
-        schedParam.sched_priority = CONFIG_THREAD_PRIORITY_HIGH;
-        if (pthread_setschedparam(pTimerInfo->timerThreadId, SCHED_FIFO, &schedParam) != 0)
+        if (target_registerThread(pTimerInfo->timerThreadId,
+                                  kOplkApiThreadHresTimer,
+                                  "oplk-hrtimer",
+                                  CONFIG_THREAD_PRIORITY_HIGH) != kErrorOk)
         {
             DEBUG_LVL_ERROR_TRACE("%s() Couldn't set thread scheduling parameters!\n", __func__);
+            target_unregisterThread(pTimerInfo->timerThreadId);
             sem_destroy(&pTimerInfo->syncSem);
             pthread_cancel(pTimerInfo->timerThreadId);
             return kErrorNoResource;
         }
-
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-        pthread_setname_np(pTimerInfo->timerThreadId, "oplk-hrtimer");
-#endif
     }
 
     return ret;
@@ -234,6 +233,7 @@ tOplkError hrestimer_exit(void)
         pTimerInfo->eventArg.timerHdl.handle = 0;
 
         /* send exit signal to thread */
+        target_unregisterThread(pTimerInfo->timerThreadId);
         pTimerInfo->fContinue = 0;
         pTimerInfo->fTerminate = TRUE;
         sem_post(&pTimerInfo->syncSem);
@@ -0,0 +1,822 @@
+/**
+********************************************************************************
+\file   hrestimer-posix_spin.c
+
+\brief  High-resolution timer module for Linux using a single sleep-and-spin thread
+
+This module is the target specific implementation of the high-resolution
+timer module for Linux userspace. All timers are multiplexed onto one thread
+which keeps the active timers in a deadline heap. The thread sleeps until a
+wakeup margin before the earliest expiry time and polls the clock for the
+remaining time. The wakeup margin is learned from the observed overshoot of the
+sleep, so that the wakeup latency of the kernel does not show up as jitter of
+the timer callbacks.
+
+\ingroup module_hrestimer
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <kernel/hrestimer.h>
+#include <common/targetthread.h>
+
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TIMER_COUNT             2           ///< number of high-resolution timers
+#define TIMER_MIN_VAL_SINGLE    20000       ///< minimum timer interval for single timeouts
+#define TIMER_MIN_VAL_CYCLE     100000      ///< minimum timer interval for continuous timeouts
+
+#ifndef CONFIG_HRESTIMER_SPIN_MARGIN_INIT
+#define CONFIG_HRESTIMER_SPIN_MARGIN_INIT   50000   ///< initial wakeup margin in [ns]
+#endif
+
+#ifndef CONFIG_HRESTIMER_SPIN_MARGIN_MIN
+#define CONFIG_HRESTIMER_SPIN_MARGIN_MIN    5000    ///< minimum wakeup margin in [ns]
+#endif
+
+#ifndef CONFIG_HRESTIMER_SPIN_MARGIN_MAX
+#define CONFIG_HRESTIMER_SPIN_MARGIN_MAX    200000  ///< maximum wakeup margin in [ns]
+#endif
+
+/* macros for timer handles */
+#define TIMERHDL_MASK           0x0FFFFFFF
+#define TIMERHDL_SHIFT          28
+#define HDL_TO_IDX(hdl)         ((hdl >> TIMERHDL_SHIFT) - 1)
+#define HDL_INIT(idx)           ((idx + 1) << TIMERHDL_SHIFT)
+#define HDL_INC(hdl)            (((hdl + 1) & TIMERHDL_MASK) | (hdl & ~TIMERHDL_MASK))
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//          P R I V A T E   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define TIMER_HEAP_POS_INVALID      TIMER_COUNT     ///< heap position of a timer which is not queued
+
+// The overshoot statistics are exponentially weighted averages with a weight of 1/2^SHIFT
+#define TIMER_OVERSHOOT_AVG_SHIFT   3
+// Multiple of the overshoot deviation which is added to the mean overshoot
+#define TIMER_OVERSHOOT_DEV_FACTOR  4
+
+#define TIMER_LATENCY_MAX           0xFFFFFFFFUL
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  High-resolution timer information structure
+
+The structure contains all necessary information for a high-resolution timer.
+*/
+typedef struct
+{
+    tTimerEventArg      eventArg;       ///< Event argument
+    tTimerkCallback     pfnCallback;    ///< Pointer to timer callback function
+    ULONGLONG           deadline;       ///< Absolute expiry time in [ns]
+    ULONGLONG           period;         ///< Period of a continuous timer in [ns], 0 for single timeouts
+    UINT                heapPos;        ///< Position of the timer in the deadline heap
+} tHresTimerInfo;
+
+/**
+\brief  High-resolution timer instance
+
+The structure defines a high-resolution timer module instance.
+*/
+typedef struct
+{
+    tHresTimerInfo          aTimerInfo[TIMER_COUNT];    ///< Array with timer information for a set of timers
+    UINT                    aHeap[TIMER_COUNT];         ///< Deadline heap with the indices of the queued timers
+    UINT                    heapCount;                  ///< Number of queued timers
+    pthread_mutex_t         mutex;                      ///< Mutex protecting the timers and the heap
+    pthread_cond_t          cond;                       ///< Condition to wake up the timer thread
+    pthread_t               threadId;                   ///< Timer thread Id
+    BOOL                    fStopThread;                ///< Flag to stop the timer thread
+    ULONGLONG               overshootMean;              ///< Mean overshoot of the sleep in [ns]
+    ULONGLONG               overshootDev;               ///< Mean deviation of the overshoot in [ns]
+    tHresTimerDiagnostics   diagnostics;                ///< Achieved timer accuracy
+} tHresTimerInstance;
+
+//------------------------------------------------------------------------------
+// module local vars
+//------------------------------------------------------------------------------
+static tHresTimerInstance       hresTimerInstance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void*     timerThread(void* pParm_p);
+static ULONGLONG getTime(void);
+static void      heapSwap(UINT pos1_p, UINT pos2_p);
+static void      heapInsert(UINT index_p);
+static void      heapRemove(UINT index_p);
+static void      updateMargin(ULONGLONG overshoot_p);
+static void      updateLatency(ULONGLONG latency_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief    Initialize high-resolution timer module
+
+The function initializes the high-resolution timer module
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_init(void)
+{
+    UINT                index;
+    pthread_condattr_t  condAttr;
+
+    OPLK_MEMSET(&hresTimerInstance_l, 0, sizeof(hresTimerInstance_l));
+
+    for (index = 0; index < TIMER_COUNT; index++)
+        hresTimerInstance_l.aTimerInfo[index].heapPos = TIMER_HEAP_POS_INVALID;
+
+    hresTimerInstance_l.overshootMean = CONFIG_HRESTIMER_SPIN_MARGIN_INIT;
+    hresTimerInstance_l.diagnostics.wakeupMargin = CONFIG_HRESTIMER_SPIN_MARGIN_INIT;
+    hresTimerInstance_l.diagnostics.latencyMin = TIMER_LATENCY_MAX;
+
+    if (pthread_mutex_init(&hresTimerInstance_l.mutex, NULL) != 0)
+        return kErrorNoResource;
+
+    // The timed wait of the thread uses the same clock as the deadlines
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    if (pthread_cond_init(&hresTimerInstance_l.cond, &condAttr) != 0)
+    {
+        pthread_condattr_destroy(&condAttr);
+        pthread_mutex_destroy(&hresTimerInstance_l.mutex);
+        return kErrorNoResource;
+    }
+    pthread_condattr_destroy(&condAttr);
+
+    if (pthread_create(&hresTimerInstance_l.threadId, NULL,
+                       timerThread, NULL) != 0)
+    {
+        pthread_cond_destroy(&hresTimerInstance_l.cond);
+        pthread_mutex_destroy(&hresTimerInstance_l.mutex);
+        return kErrorNoResource;
+    }
+
+    if (target_registerThread(hresTimerInstance_l.threadId,
+                              kOplkApiThreadHresTimer,
+                              "oplk-hrtimer",
+                              CONFIG_THREAD_PRIORITY_HIGH) != kErrorOk)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Couldn't set thread scheduling parameters!\n", __func__);
+        hrestimer_exit();
+        return kErrorNoResource;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Shut down high-resolution timer module
+
+The function shuts down the high-resolution timer module.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_exit(void)
+{
+    tHresTimerDiagnostics*  pDiagnostics = &hresTimerInstance_l.diagnostics;
+    tHresTimerInfo*         pTimerInfo;
+    UINT                    index;
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+    for (index = 0; index < TIMER_COUNT; index++)
+    {
+        pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+        heapRemove(index);
+        pTimerInfo->eventArg.timerHdl.handle = 0;
+        pTimerInfo->pfnCallback = NULL;
+    }
+
+    // send exit request to thread
+    hresTimerInstance_l.fStopThread = TRUE;
+    pthread_cond_signal(&hresTimerInstance_l.cond);
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    // wait until thread terminates
+    DEBUG_LVL_TIMERH_TRACE("%s() Waiting for thread to exit...\n", __func__);
+    pthread_join(hresTimerInstance_l.threadId, NULL);
+    DEBUG_LVL_TIMERH_TRACE("%s() Thread exited!\n", __func__);
+
+    target_unregisterThread(hresTimerInstance_l.threadId);
+    pthread_cond_destroy(&hresTimerInstance_l.cond);
+    pthread_mutex_destroy(&hresTimerInstance_l.mutex);
+
+    if (pDiagnostics->expireCount != 0)
+    {
+        DEBUG_LVL_TIMERH_TRACE("%s() expired:%llu latency min/avg/max:%u/%llu/%u ns margin:%u ns late:%u missed:%u\n",
+                               __func__,
+                               pDiagnostics->expireCount,
+                               pDiagnostics->latencyMin,
+                               pDiagnostics->latencySum / pDiagnostics->expireCount,
+                               pDiagnostics->latencyMax,
+                               pDiagnostics->wakeupMargin,
+                               pDiagnostics->lateWakeupCount,
+                               pDiagnostics->missedPeriodCount);
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Modify a high-resolution timer
+
+The function modifies the timeout of the timer with the specified handle.
+If the handle to which the pointer points to is zero, the timer must be created
+first. If it is not possible to stop the old timer, this function always assures
+that the old timer does not trigger the callback function with the same handle
+as the new timer. That means the callback function must check the passed handle
+with the one returned by this function. If these are unequal, the call can be
+discarded.
+
+\param[in,out]  pTimerHdl_p         Pointer to timer handle.
+\param[in]      time_p              Relative timeout in [ns].
+\param[in]      pfnCallback_p       Callback function, which is called when timer expires.
+                                    (The function is called mutually exclusive with
+                                    the Edrv callback functions (Rx and Tx)).
+\param[in]      argument_p          User-specific argument.
+\param[in]      fContinue_p         If TRUE, the callback function will be called continuously.
+                                    Otherwise, it is a one-shot timer.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_modifyTimer(tTimerHdl* pTimerHdl_p,
+                                 ULONGLONG time_p,
+                                 tTimerkCallback pfnCallback_p,
+                                 ULONG argument_p,
+                                 BOOL fContinue_p)
+{
+    UINT                index;
+    tHresTimerInfo*     pTimerInfo;
+
+    // check pointer to handle
+    if (pTimerHdl_p == NULL)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Invalid timer handle\n", __func__);
+        return kErrorTimerInvalidHandle;
+    }
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+    if (*pTimerHdl_p == 0)
+    {   // no timer created yet -> search free timer info structure
+        pTimerInfo = &hresTimerInstance_l.aTimerInfo[0];
+        for (index = 0; index < TIMER_COUNT; index++, pTimerInfo++)
+        {
+            if (pTimerInfo->eventArg.timerHdl.handle == 0)
+            {   // free structure found
+                break;
+            }
+        }
+        if (index >= TIMER_COUNT)
+        {   // no free structure found
+            pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+            DEBUG_LVL_ERROR_TRACE("%s() Invalid timer index:%d\n", __func__, index);
+            return kErrorTimerNoTimerCreated;
+        }
+        pTimerInfo->eventArg.timerHdl.handle = HDL_INIT(index);
+    }
+    else
+    {
+        index = HDL_TO_IDX(*pTimerHdl_p);
+        if (index >= TIMER_COUNT)
+        {   // invalid handle
+            pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+            DEBUG_LVL_ERROR_TRACE("%s() Invalid timer index:%d\n", __func__, index);
+            return kErrorTimerInvalidHandle;
+        }
+        pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+    }
+
+    // increase too small time values
+    if (fContinue_p != FALSE)
+    {
+        if (time_p < TIMER_MIN_VAL_CYCLE)
+            time_p = TIMER_MIN_VAL_CYCLE;
+    }
+    else
+    {
+        if (time_p < TIMER_MIN_VAL_SINGLE)
+            time_p = TIMER_MIN_VAL_SINGLE;
+    }
+
+    /* increment timer handle
+     * (if the old timer has already been taken by the timer thread, the user
+     * would detect an unknown timer handle and discard it) */
+    pTimerInfo->eventArg.timerHdl.handle = HDL_INC(pTimerInfo->eventArg.timerHdl.handle);
+    *pTimerHdl_p = pTimerInfo->eventArg.timerHdl.handle;
+
+    // initialize timer info
+    pTimerInfo->eventArg.argument.value = argument_p;
+    pTimerInfo->pfnCallback = pfnCallback_p;
+    pTimerInfo->period = (fContinue_p != FALSE) ? time_p : 0;
+
+    heapRemove(index);
+    pTimerInfo->deadline = getTime() + time_p;
+    heapInsert(index);
+
+    // wake up the thread if the timer is the next one to expire
+    if (pTimerInfo->heapPos == 0)
+        pthread_cond_signal(&hresTimerInstance_l.cond);
+
+    DEBUG_LVL_TIMERH_TRACE("%s() timer:%lx timeout=%llu\n", __func__,
+                           pTimerInfo->eventArg.timerHdl.handle, time_p);
+
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Delete a high-resolution timer
+
+The function deletes a created high-resolution timer. The timer is specified
+by its timer handle. After deleting, the handle is reset to zero.
+
+\param[in,out]  pTimerHdl_p         Pointer to timer handle.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_deleteTimer(tTimerHdl* pTimerHdl_p)
+{
+    UINT                index;
+    tHresTimerInfo*     pTimerInfo;
+
+    if (pTimerHdl_p == NULL)
+        return kErrorTimerInvalidHandle;
+
+    DEBUG_LVL_TIMERH_TRACE("%s() Deleting timer:%lx\n", __func__, *pTimerHdl_p);
+
+    if (*pTimerHdl_p == 0)
+    {   // no timer created yet
+        return kErrorOk;
+    }
+
+    index = HDL_TO_IDX(*pTimerHdl_p);
+    if (index >= TIMER_COUNT)
+    {   // invalid handle
+        return kErrorTimerInvalidHandle;
+    }
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+    pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+    if (pTimerInfo->eventArg.timerHdl.handle == *pTimerHdl_p)
+    {
+        heapRemove(index);
+        pTimerInfo->eventArg.timerHdl.handle = 0;
+        pTimerInfo->pfnCallback = NULL;
+        *pTimerHdl_p = 0;
+    }
+
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Control external synchronization interrupt
+
+This function enables/disables the external synchronization interrupt. If the
+external synchronization interrupt is not supported, the call is ignored.
+
+\param[in]      fEnable_p           Flag determines if sync should be enabled or disabled.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+void hrestimer_controlExtSyncIrq(BOOL fEnable_p)
+{
+    UNUSED_PARAMETER(fEnable_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set external synchronization interrupt time
+
+This function sets the time when the external synchronization interrupt shall
+be triggered to synchronize the host processor. If the external synchronization
+interrupt is not supported, the call is ignored.
+
+\param[in]      time_p              Time when the sync shall be triggered
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+void hrestimer_setExtSyncIrqTime(tTimestamp time_p)
+{
+    UNUSED_PARAMETER(time_p);
+}
+
+#if (CONFIG_HRESTIMER_USE_DIAGNOSTICS != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Get timer diagnostics
+
+This function returns a snapshot of the achieved timer accuracy and of the
+current wakeup margin.
+
+\param[out]     pDiagnostics_p      Pointer to store the diagnostics.
+
+\return Returns a tOplkError error code.
+
+\ingroup module_hrestimer
+*/
+//------------------------------------------------------------------------------
+tOplkError hrestimer_getDiagnostics(tHresTimerDiagnostics* pDiagnostics_p)
+{
+    if (pDiagnostics_p == NULL)
+        return kErrorInvalidOperation;
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+    *pDiagnostics_p = hresTimerInstance_l.diagnostics;
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    return kErrorOk;
+}
+#endif
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief    Timer thread function
+
+The function provides the main function of the timer thread. It sleeps until
+the wakeup margin before the earliest expiry time, polls the clock until the
+timer expires and calls the timer callback function. The sleep is interrupted
+if a timer with an earlier expiry time is started.
+
+\param[in,out]  pParm_p             Thread parameter (unused!)
+
+\return Returns a void* as specified by the pthread interface but it is not used!
+*/
+//------------------------------------------------------------------------------
+static void* timerThread(void* pParm_p)
+{
+    tHresTimerInfo*     pTimerInfo;
+    tTimerEventArg      eventArg;
+    tTimerkCallback     pfnCallback;
+    ULONGLONG           deadline;
+    ULONGLONG           wakeupTime;
+    ULONGLONG           now;
+    struct timespec     timeout;
+    UINT                index;
+    UINT32              handle;
+    int                 ret;
+
+    UNUSED_PARAMETER(pParm_p);
+
+    DEBUG_LVL_TIMERH_TRACE("%s(): ThreadId:%ld\n", __func__, syscall(SYS_gettid));
+
+    pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+    while (!hresTimerInstance_l.fStopThread)
+    {
+        if (hresTimerInstance_l.heapCount == 0)
+        {
+            pthread_cond_wait(&hresTimerInstance_l.cond, &hresTimerInstance_l.mutex);
+            continue;
+        }
+
+        index = hresTimerInstance_l.aHeap[0];
+        pTimerInfo = &hresTimerInstance_l.aTimerInfo[index];
+        deadline = pTimerInfo->deadline;
+        handle = pTimerInfo->eventArg.timerHdl.handle;
+        now = getTime();
+
+        if (deadline > now + hresTimerInstance_l.diagnostics.wakeupMargin)
+        {   // sleep until the wakeup margin before the expiry time
+            wakeupTime = deadline - hresTimerInstance_l.diagnostics.wakeupMargin;
+            timeout.tv_sec = (time_t)(wakeupTime / 1000000000ULL);
+            timeout.tv_nsec = (long)(wakeupTime % 1000000000ULL);
+
+            ret = pthread_cond_timedwait(&hresTimerInstance_l.cond,
+                                         &hresTimerInstance_l.mutex,
+                                         &timeout);
+            if (ret != ETIMEDOUT)
+            {   // woken up because the timers have changed
+                continue;
+            }
+
+            now = getTime();
+            if (now >= wakeupTime)
+                updateMargin(now - wakeupTime);
+
+            if ((hresTimerInstance_l.heapCount == 0) ||
+                (hresTimerInstance_l.aHeap[0] != index) ||
+                (pTimerInfo->deadline != deadline))
+            {   // timer has been modified meanwhile
+                continue;
+            }
+
+            if (now > deadline)
+                hresTimerInstance_l.diagnostics.lateWakeupCount++;
+        }
+
+        // poll the clock for the rest of the time without blocking the timer API
+        pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+        while (now < deadline)
+            now = getTime();
+        pthread_mutex_lock(&hresTimerInstance_l.mutex);
+
+        if ((pTimerInfo->heapPos != 0) ||
+            (pTimerInfo->deadline != deadline) ||
+            (pTimerInfo->eventArg.timerHdl.handle != handle))
+        {   // timer has been modified or deleted meanwhile
+            continue;
+        }
+
+        updateLatency(now - deadline);
+
+        heapRemove(index);
+        if (pTimerInfo->period != 0)
+        {
+            pTimerInfo->deadline += pTimerInfo->period;
+            // skip periods which have already passed instead of catching up
+            while (pTimerInfo->deadline <= now)
+            {
+                pTimerInfo->deadline += pTimerInfo->period;
+                hresTimerInstance_l.diagnostics.missedPeriodCount++;
+            }
+            heapInsert(index);
+        }
+
+        pfnCallback = pTimerInfo->pfnCallback;
+        eventArg = pTimerInfo->eventArg;
+
+        // call callback function without holding the lock, it may modify the timers
+        pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+        if (pfnCallback != NULL)
+            pfnCallback(&eventArg);
+        pthread_mutex_lock(&hresTimerInstance_l.mutex);
+    }
+
+    pthread_mutex_unlock(&hresTimerInstance_l.mutex);
+
+    DEBUG_LVL_TIMERH_TRACE("%s() Exiting!\n", __func__);
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Get the current time
+
+\return The function returns the current time of the monotonic clock in [ns].
+*/
+//------------------------------------------------------------------------------
+static ULONGLONG getTime(void)
+{
+    struct timespec     currentTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &currentTime);
+
+    return ((ULONGLONG)currentTime.tv_sec * 1000000000ULL) + (ULONGLONG)currentTime.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Swap two entries of the deadline heap
+
+\param[in]      pos1_p              Position of the first entry.
+\param[in]      pos2_p              Position of the second entry.
+*/
+//------------------------------------------------------------------------------
+static void heapSwap(UINT pos1_p, UINT pos2_p)
+{
+    UINT    index1 = hresTimerInstance_l.aHeap[pos1_p];
+    UINT    index2 = hresTimerInstance_l.aHeap[pos2_p];
+
+    hresTimerInstance_l.aHeap[pos1_p] = index2;
+    hresTimerInstance_l.aHeap[pos2_p] = index1;
+    hresTimerInstance_l.aTimerInfo[index1].heapPos = pos2_p;
+    hresTimerInstance_l.aTimerInfo[index2].heapPos = pos1_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Insert a timer into the deadline heap
+
+The function inserts the timer with its current expiry time into the deadline
+heap. The caller must hold the mutex.
+
+\param[in]      index_p             Index of the timer.
+*/
+//------------------------------------------------------------------------------
+static void heapInsert(UINT index_p)
+{
+    const tHresTimerInfo*   pTimerInfo = hresTimerInstance_l.aTimerInfo;
+    UINT                    pos;
+    UINT                    parentPos;
+
+    pos = hresTimerInstance_l.heapCount++;
+    hresTimerInstance_l.aHeap[pos] = index_p;
+    hresTimerInstance_l.aTimerInfo[index_p].heapPos = pos;
+
+    while (pos > 0)
+    {
+        parentPos = (pos - 1) / 2;
+        if (pTimerInfo[hresTimerInstance_l.aHeap[parentPos]].deadline <=
+            pTimerInfo[hresTimerInstance_l.aHeap[pos]].deadline)
+            break;
+
+        heapSwap(pos, parentPos);
+        pos = parentPos;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Remove a timer from the deadline heap
+
+The function removes the timer from the deadline heap. If the timer is not
+queued, the call is ignored. The caller must hold the mutex.
+
+\param[in]      index_p             Index of the timer.
+*/
+//------------------------------------------------------------------------------
+static void heapRemove(UINT index_p)
+{
+    const tHresTimerInfo*   pTimerInfo = hresTimerInstance_l.aTimerInfo;
+    UINT                    pos = hresTimerInstance_l.aTimerInfo[index_p].heapPos;
+    UINT                    lastPos;
+    UINT                    childPos;
+
+    if (pos == TIMER_HEAP_POS_INVALID)
+        return;
+
+    lastPos = --hresTimerInstance_l.heapCount;
+    if (pos != lastPos)
+        heapSwap(pos, lastPos);
+    hresTimerInstance_l.aTimerInfo[index_p].heapPos = TIMER_HEAP_POS_INVALID;
+
+    if (pos == lastPos)
+        return;
+
+    // restore the heap order for the entry moved to the freed position
+    while ((pos > 0) &&
+           (pTimerInfo[hresTimerInstance_l.aHeap[(pos - 1) / 2]].deadline >
+            pTimerInfo[hresTimerInstance_l.aHeap[pos]].deadline))
+    {
+        heapSwap(pos, (pos - 1) / 2);
+        pos = (pos - 1) / 2;
+    }
+
+    while ((childPos = (2 * pos) + 1) < lastPos)
+    {
+        if ((childPos + 1 < lastPos) &&
+            (pTimerInfo[hresTimerInstance_l.aHeap[childPos + 1]].deadline <
+             pTimerInfo[hresTimerInstance_l.aHeap[childPos]].deadline))
+            childPos++;
+
+        if (pTimerInfo[hresTimerInstance_l.aHeap[pos]].deadline <=
+            pTimerInfo[hresTimerInstance_l.aHeap[childPos]].deadline)
+            break;
+
+        heapSwap(pos, childPos);
+        pos = childPos;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Update the wakeup margin
+
+The function updates the statistics of the sleep overshoot and derives the new
+wakeup margin from it. The margin is the mean overshoot plus a multiple of its
+mean deviation, so that nearly all wakeups happen before the expiry time.
+
+\param[in]      overshoot_p         Observed overshoot of the last sleep in [ns].
+*/
+//------------------------------------------------------------------------------
+static void updateMargin(ULONGLONG overshoot_p)
+{
+    tHresTimerDiagnostics*  pDiagnostics = &hresTimerInstance_l.diagnostics;
+    ULONGLONG               deviation;
+    ULONGLONG               margin;
+
+    if (overshoot_p > pDiagnostics->overshootMax)
+        pDiagnostics->overshootMax = (overshoot_p > TIMER_LATENCY_MAX) ? TIMER_LATENCY_MAX : (UINT32)overshoot_p;
+
+    deviation = (overshoot_p > hresTimerInstance_l.overshootMean) ?
+                (overshoot_p - hresTimerInstance_l.overshootMean) :
+                (hresTimerInstance_l.overshootMean - overshoot_p);
+
+    hresTimerInstance_l.overshootMean = hresTimerInstance_l.overshootMean -
+                                        (hresTimerInstance_l.overshootMean >> TIMER_OVERSHOOT_AVG_SHIFT) +
+                                        (overshoot_p >> TIMER_OVERSHOOT_AVG_SHIFT);
+    hresTimerInstance_l.overshootDev = hresTimerInstance_l.overshootDev -
+                                       (hresTimerInstance_l.overshootDev >> TIMER_OVERSHOOT_AVG_SHIFT) +
+                                       (deviation >> TIMER_OVERSHOOT_AVG_SHIFT);
+
+    margin = hresTimerInstance_l.overshootMean +
+             (TIMER_OVERSHOOT_DEV_FACTOR * hresTimerInstance_l.overshootDev);
+
+    if (margin < CONFIG_HRESTIMER_SPIN_MARGIN_MIN)
+        margin = CONFIG_HRESTIMER_SPIN_MARGIN_MIN;
+    else if (margin > CONFIG_HRESTIMER_SPIN_MARGIN_MAX)
+        margin = CONFIG_HRESTIMER_SPIN_MARGIN_MAX;
+
+    pDiagnostics->wakeupMargin = (UINT32)margin;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief    Update the latency statistics
+
+\param[in]      latency_p           Latency of the expired timer in [ns].
+*/
+//------------------------------------------------------------------------------
+static void updateLatency(ULONGLONG latency_p)
+{
+    tHresTimerDiagnostics*  pDiagnostics = &hresTimerInstance_l.diagnostics;
+    UINT32                  latency;
+
+    latency = (latency_p > TIMER_LATENCY_MAX) ? TIMER_LATENCY_MAX : (UINT32)latency_p;
+
+    pDiagnostics->expireCount++;
+    pDiagnostics->latencySum += latency;
+    if (latency < pDiagnostics->latencyMin)
+        pDiagnostics->latencyMin = latency;
+    if (latency > pDiagnostics->latencyMax)
+        pDiagnostics->latencyMax = latency;
+}
+
+/// \}
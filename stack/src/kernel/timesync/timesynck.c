@@ -246,6 +246,21 @@ tOplkError timesynck_process(const tEvent* pEvent_p)
             ret = timesynckcal_controlSync(*((const BOOL*)pEvent_p->eventArg.pEventArg));
             break;
 
+        case kEventTypeTimesynckSetSyncCycle:
+            if (pEvent_p->eventArgSize != sizeof(UINT32))
+            {
+                ret = kErrorEventWrongSize;
+                break;
+            }
+
+            // Adapted by the user layer within the configured bounds
+            timesynckInstance_l.syncEventCycle = *((const UINT32*)pEvent_p->eventArg.pEventArg);
+            if (timesynckInstance_l.syncEventCycle == 0)
+                timesynckInstance_l.syncEventCycle = 1;
+
+            ret = kErrorOk;
+            break;
+
         default:
             ret = kErrorInvalidEvent;
             break;
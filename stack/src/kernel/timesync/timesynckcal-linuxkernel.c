@@ -47,10 +47,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
 #include <kernel/timesynckcal.h>
+#include <common/driver.h>
 
 #include <linux/slab.h>
 #include <linux/sched.h>
 #include <linux/wait.h>
+#include <linux/ktime.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -91,6 +93,7 @@ typedef struct
     wait_queue_head_t       syncWaitQueue;   ///< Wait queue for time sync event
     BOOL                    fSync;           ///< Flag for wait sync event
     BOOL                    fInitialized;    ///< Flag for timesynckcal module initialization
+    tSyncShm*               pSyncShm;        ///< Sync shared memory
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
     tTimesyncSharedMemory*  pSharedMemory;   ///< Shared timesync structure
     size_t                  memSize;         ///< Size of the timesync shared memory
@@ -105,10 +108,8 @@ static tTimesynckCalInstance instance_l; ///< Instance variable of kernel timesy
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
-#if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
 static tOplkError allocateSocMem(void** ppSocMem_p, size_t memSize_p);
 static tOplkError freeSocMem(void* pMem_p, size_t memSize_p);
-#endif
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -127,13 +128,20 @@ The function initializes the kernel CAL timesync module.
 //------------------------------------------------------------------------------
 tOplkError timesynckcal_init(void)
 {
-#if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
     void*  pMem;
-#endif
+
+    if (instance_l.pSyncShm != NULL)
+        freeSocMem(instance_l.pSyncShm, sizeof(tSyncShm));
 
     OPLK_MEMSET(&instance_l, 0, sizeof(tTimesynckCalInstance));
 
     init_waitqueue_head(&instance_l.syncWaitQueue);
+
+    if (allocateSocMem(&pMem, sizeof(tSyncShm)) != kErrorOk)
+        return kErrorNoResource;
+
+    instance_l.pSyncShm = (tSyncShm*)pMem;
+    OPLK_MEMSET(instance_l.pSyncShm, 0, sizeof(tSyncShm));
     instance_l.fInitialized = TRUE;
 
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
@@ -162,6 +170,13 @@ The function cleans up the CAL timesync module
 void timesynckcal_exit(void)
 {
     instance_l.fInitialized = FALSE;
+
+    if (instance_l.pSyncShm != NULL)
+    {
+        freeSocMem(instance_l.pSyncShm, sizeof(tSyncShm));
+        instance_l.pSyncShm = NULL;
+    }
+
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
     if (instance_l.pSharedMemory != NULL)
        {
@@ -184,8 +199,20 @@ The function sends a sync event.
 //------------------------------------------------------------------------------
 tOplkError timesynckcal_sendSyncEvent(void)
 {
+    tSyncShm*   pSyncShm = instance_l.pSyncShm;
+    UINT64      syncTime;
+
     if (instance_l.fInitialized)
     {
+        // Publish the sync event in the shared memory before waking up the
+        // waiting thread, the user layer may already poll the counter.
+        syncTime = ktime_get_ns();
+        if (pSyncShm->syncTime != 0)
+            pSyncShm->syncPeriod = (UINT32)(syncTime - pSyncShm->syncTime);
+        pSyncShm->syncTime = syncTime;
+        smp_wmb();
+        pSyncShm->syncCount++;
+
         instance_l.fSync = TRUE;
         wake_up_interruptible(&instance_l.syncWaitQueue);
     }
@@ -223,6 +250,70 @@ tOplkError timesynckcal_waitSyncEvent(void)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Wait for a sync event after a given sync count
+
+The function waits until the sync counter in the sync shared memory differs
+from the given value. The user layer passes the counter value of the last sync
+event it has processed, therefore a sync event which has already been detected
+through the shared memory does not release a further wait.
+
+\param[in]      syncCount_p         Sync count of the last processed sync event.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    A new sync event occurred.
+\retval kErrorRetry                 The wait timed out or was interrupted.
+
+\ingroup module_timesynckcal
+*/
+//------------------------------------------------------------------------------
+tOplkError timesynckcal_waitSyncCount(UINT32 syncCount_p)
+{
+    int ret;
+    int timeout = 1000 * HZ / 1000;
+
+    if (!instance_l.fInitialized)
+        return kErrorNoResource;
+
+    ret = wait_event_interruptible_timeout(instance_l.syncWaitQueue,
+                                           (instance_l.pSyncShm->syncCount != syncCount_p),
+                                           timeout);
+    if (ret <= 0)
+        return kErrorRetry;
+
+    instance_l.fSync = FALSE;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get sync shared memory
+
+The function returns the sync shared memory which is mapped into the user
+layer.
+
+\param[out]     ppSyncMem_p         Pointer to store the address of the sync memory.
+\param[out]     pSyncMemSize_p      Pointer to store the size of the sync memory.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_timesynckcal
+*/
+//------------------------------------------------------------------------------
+tOplkError timesynckcal_getSyncMem(void** ppSyncMem_p, size_t* pSyncMemSize_p)
+{
+    if ((ppSyncMem_p == NULL) || (instance_l.pSyncShm == NULL))
+        return kErrorInvalidOperation;
+
+    *ppSyncMem_p = instance_l.pSyncShm;
+    if (pSyncMemSize_p != NULL)
+        *pSyncMemSize_p = sizeof(tSyncShm);
+
+    return kErrorOk;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Enable sync events
@@ -259,6 +350,7 @@ tTimesyncSharedMemory* timesynckcal_getSharedMemory(void)
 {
     return instance_l.pSharedMemory;
 }
+#endif
 
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
@@ -271,7 +363,7 @@ tTimesyncSharedMemory* timesynckcal_getSharedMemory(void)
 \brief  Free timesync shared memory
 
 The function frees shared memory which was allocated in the kernel layer for
-transferring the SoC timestamp.
+transferring the SoC timestamp or the sync state.
 
 \param[in,out]  pMem_p              Pointer to the shared memory base
 \param[in]      memSize_p           Size of timesync shared memory
@@ -296,8 +388,8 @@ static tOplkError freeSocMem(void* pMem_p, size_t memSize_p)
 /**
 \brief  Allocate timesync shared memory
 
-The function allocates shared memory required to transfer the SoC timestamp from
-the kernel layer to the user layer.
+The function allocates shared memory required to transfer the SoC timestamp or
+the sync state from the kernel layer to the user layer.
 
 \param[out]     ppSocMem_p          Pointer to store the timesync shared memory base address.
 \param[in]      memSize_p           Size of timesync shared memory
@@ -316,12 +408,12 @@ static tOplkError allocateSocMem(void** ppSocMem_p, size_t memSize_p)
     *ppSocMem_p = (void*)__get_free_pages(GFP_KERNEL, order);
     if (*ppSocMem_p == NULL)
     {
-        DEBUG_LVL_ERROR_TRACE("%s() Memory for SoC could not be created\n",
+        DEBUG_LVL_ERROR_TRACE("%s() Shared memory could not be created\n",
                               __func__);
         return kErrorNoResource;
     }
 
     return kErrorOk;
 }
-#endif
+
 /// \}
@@ -44,6 +44,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <kernel/veth.h>
 #include <kernel/dllk.h>
 #include <kernel/dllkcal.h>
+#include <common/targetthread.h>
 
 #if defined(CONFIG_INCLUDE_VETH)
 #include <stdio.h>
@@ -174,9 +175,10 @@ tOplkError veth_init(const UINT8 aSrcMac_p[6])
     if (pthread_create(&vethInstance_l.threadHandle, NULL, vethRecvThread, (void*)&vethInstance_l) != 0)
         return kErrorNoFreeInstance;
 
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(vethInstance_l.threadHandle, "oplk-veth");
-#endif
+    target_registerThread(vethInstance_l.threadHandle,
+                          kOplkApiThreadVeth,
+                          "oplk-veth",
+                          0);
 
     // register callback function in DLL
     ret = dllk_regAsyncHandler(receiveFrameCb);
@@ -203,6 +205,7 @@ tOplkError veth_exit(void)
     ret = dllk_deregAsyncHandler(receiveFrameCb);
 
     // stop receive thread by setting its stop flag
+    target_unregisterThread(vethInstance_l.threadHandle);
     vethInstance_l.fStop = TRUE;
     pthread_join(vethInstance_l.threadHandle, NULL);
     close(vethInstance_l.fd);
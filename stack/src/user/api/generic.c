@@ -47,6 +47,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/oplkinc.h>
 #include <common/target.h>
 #include <common/ami.h>
+#include <common/pdo.h>
 #include <user/ctrlu.h>
 #include <user/nmtu.h>
 #include <user/dllucal.h>
@@ -56,6 +57,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <user/timesyncucal.h>
 #include <user/timesyncu.h>
 #include <user/obdal.h>
+#include <user/obdview.h>
 #include <user/pdou.h>
 
 #if defined(CONFIG_INCLUDE_CFM)
@@ -65,16 +67,31 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #if defined(CONFIG_INCLUDE_SDOC)
 #include <user/sdocom.h>
+#include <user/sdobatch.h>
+#endif
+
+#if (defined(CONFIG_INCLUDE_SDO_ASND) || defined(CONFIG_INCLUDE_SDO_UDP))
+#include <user/sdoseq.h>
 #endif
 
 #if defined(CONFIG_INCLUDE_NMT_MN)
 #include <user/nmtmnu.h>
+#include <user/nmtmnuplan.h>
 #include <user/identu.h>
+#include <user/respstoreu.h>
 #endif
 
 #include <common/target.h>
 #include <common/memmap.h>
 
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+#include <kernel/pdokrxworker.h>
+#endif
+
+#if (CONFIG_HRESTIMER_USE_DIAGNOSTICS != FALSE)
+#include <kernel/hrestimer.h>
+#endif
+
 #if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
 #include <user/obdconf.h>
 #endif
@@ -1015,6 +1032,116 @@ tOplkError oplk_abortSdo(tSdoComConHdl sdoComConHdl_p,
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Submit a batch of SDO transfers
+
+The function submits read and write accesses to the object dictionaries of
+remote nodes. The stack processes the requests of several nodes in parallel and
+aggregates consecutive requests to the same node into Read/Write Multiple
+Parameter by Index transfers, if the node supports them. The requests to one
+node are processed in the order of submission.
+
+No SDO events are posted to the event callback function for the requests of a
+batch. The results must be polled with \ref oplk_pollSdoBatch(). The data
+buffers of the requests must remain valid until their completion is polled.
+
+\param[in]      paRequest_p         Pointer to the array of requests.
+\param[in]      requestCount_p      Number of requests. Either all or none of the
+                                    requests are submitted.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The requests were submitted.
+\retval kErrorApiInvalidParam       A request is invalid.
+\retval kErrorNoResource            Not enough free entries for the requests (see
+                                    CONFIG_SDO_BATCH_MAX_REQUESTS).
+\retval kErrorApiNotSupported       No SDO client implemented.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_submitSdoBatch(const tOplkApiSdoBatchRequest* paRequest_p,
+                               UINT requestCount_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+#if defined(CONFIG_INCLUDE_SDOC)
+    return sdobatch_submit(paRequest_p, requestCount_p);
+#else
+    UNUSED_PARAMETER(paRequest_p);
+    UNUSED_PARAMETER(requestCount_p);
+
+    return kErrorApiNotSupported;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Poll the completions of SDO batch transfers
+
+The function returns the results of finished SDO batch requests in the order of
+their completion. A request is released when its completion was polled.
+
+\param[out]     paCompletion_p      Pointer to the array to store the completions.
+\param[in]      maxCount_p          Number of elements of the completion array.
+\param[out]     pCompletionCount_p  Pointer to store the number of returned
+                                    completions.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The completions were returned.
+\retval kErrorApiInvalidParam       Invalid parameters.
+\retval kErrorApiNotSupported       No SDO client implemented.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_pollSdoBatch(tOplkApiSdoBatchCompletion* paCompletion_p,
+                             UINT maxCount_p,
+                             UINT* pCompletionCount_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+#if defined(CONFIG_INCLUDE_SDOC)
+    return sdobatch_poll(paCompletion_p, maxCount_p, pCompletionCount_p);
+#else
+    UNUSED_PARAMETER(paCompletion_p);
+    UNUSED_PARAMETER(maxCount_p);
+    UNUSED_PARAMETER(pCompletionCount_p);
+
+    return kErrorApiNotSupported;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Cancel all SDO batch transfers
+
+The function cancels all submitted SDO batch requests. The requests which have
+not been started are completed with the abort code
+SDO_AC_DATA_NOT_TRANSF_DUE_LOCAL_CONTROL, the running transfers are aborted. The
+completions of all requests must still be polled with \ref oplk_pollSdoBatch().
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The requests were canceled.
+\retval kErrorApiNotSupported       No SDO client implemented.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_cancelSdoBatch(void)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+#if defined(CONFIG_INCLUDE_SDOC)
+    return sdobatch_cancel();
+#else
+    return kErrorApiNotSupported;
+#endif
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Read entry from local object dictionary
@@ -1096,6 +1223,139 @@ tOplkError oplk_writeLocalObject(UINT index_p,
     return obdu_writeEntry(index_p, subindex_p, pSrcData_p, (tObdSize)size_p);
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Register object view
+
+The function registers a view of a set of numerical objects of the local object
+dictionary. The stack keeps a mirror of the object values in one memory block
+which is updated whenever one of the objects is written. The mirror is read
+with oplk_readObjectView() without accessing the object dictionary.
+
+The offset and size of every value in the mirror are stored in the entries.
+Every value is aligned to its size up to 8 bytes.
+
+\param[in,out]  paEntry_p           Pointer to the array of objects. The offset
+                                    and size of the values are filled in.
+\param[in]      entryCount_p        Number of objects in the array.
+\param[out]     pViewId_p           Pointer to store the ID of the view.
+\param[out]     pViewSize_p         Pointer to store the size of the view.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The view was registered.
+\retval kErrorNoResource            No free view or no memory is available.
+\retval kErrorApiInvalidParam       Invalid parameters or an object is not
+                                    numerical.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+\retval Other                       An object does not exist.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_registerObjectView(tOplkApiObjectViewEntry* paEntry_p,
+                                   UINT entryCount_p,
+                                   UINT* pViewId_p,
+                                   size_t* pViewSize_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    if ((paEntry_p == NULL) ||
+        (entryCount_p == 0) ||
+        (pViewId_p == NULL) ||
+        (pViewSize_p == NULL))
+        return kErrorApiInvalidParam;
+
+    return obdview_registerView(paEntry_p, entryCount_p, pViewId_p, pViewSize_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Unregister object view
+
+The function unregisters an object view. The view must not be read by another
+thread at the same time.
+
+\param[in]      viewId_p            ID of the view.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The view was unregistered.
+\retval kErrorApiInvalidParam       The view is not registered.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_unregisterObjectView(UINT viewId_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    return obdview_unregisterView(viewId_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read object view
+
+The function copies the values of an object view. The copy is consistent even
+if an object of the view is written at the same time. The function does not
+access the object dictionary and can be called from any thread.
+
+\param[in]      viewId_p            ID of the view.
+\param[out]     pBuffer_p           Pointer to store the values.
+\param[in]      bufferSize_p        Size of the buffer. It must be at least the
+                                    size of the view.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The values were copied.
+\retval kErrorRetry                 The view is currently updated.
+\retval kErrorApiInvalidParam       Invalid parameters.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_readObjectView(UINT viewId_p,
+                               void* pBuffer_p,
+                               size_t bufferSize_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    if (pBuffer_p == NULL)
+        return kErrorApiInvalidParam;
+
+    return obdview_readView(viewId_p, pBuffer_p, bufferSize_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Refresh object view
+
+The function copies the current values of all objects of a view. Objects are
+copied to the view automatically when they are written. The function is only
+needed for objects which are linked to variables that are modified directly,
+e.g. by the application or by the error handler.
+
+\param[in]      viewId_p            ID of the view.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The view was refreshed.
+\retval kErrorApiInvalidParam       The view is not registered.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_refreshObjectView(UINT viewId_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    return obdview_refreshView(viewId_p);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Send a generic ASnd frame
@@ -1667,6 +1927,292 @@ tOplkError oplk_getSocTime(tOplkApiSocTimeInfo* pTimeInfo_p)
 #endif
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get synchronization statistics
+
+The function obtains the statistics of the application synchronization. The
+application processing time is measured from the return of oplk_waitSyncEvent()
+(or the call of the sync callback) to the call of oplk_exchangeProcessImageIn().
+
+\param[out]     pStatistics_p       Pointer to memory where the statistics should
+                                    be stored.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The statistics were obtained successfully.
+\retval kErrorApiInvalidParam       The pointer is invalid.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_getSyncStatistics(tOplkApiSyncStatistics* pStatistics_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    return timesyncu_getStatistics(pStatistics_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get SDO frame pool statistics
+
+The function obtains the occupancy statistics of the preallocated Tx frame pool
+of the SDO sequence layer. The pool holds the frames of all SDO history buffers.
+
+\param[out]     pStatistics_p       Pointer to memory where the statistics should
+                                    be stored.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The statistics were obtained successfully.
+\retval kErrorApiInvalidParam       The pointer is invalid.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+\retval kErrorApiNotSupported       The SDO sequence layer is not included.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_getSdoFramePoolStatistics(tOplkApiFramePoolStatistics* pStatistics_p)
+{
+#if (defined(CONFIG_INCLUDE_SDO_ASND) || defined(CONFIG_INCLUDE_SDO_UDP))
+    tOplkError              ret;
+    tFramePoolStatistics    statistics;
+
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    if (pStatistics_p == NULL)
+        return kErrorApiInvalidParam;
+
+    ret = sdoseq_getTxFramePoolStatistics(&statistics);
+    if (ret != kErrorOk)
+        return ret;
+
+    pStatistics_p->frameCount = statistics.frameCount;
+    pStatistics_p->usedCount = statistics.usedCount;
+    pStatistics_p->maxUsedCount = statistics.maxUsedCount;
+    pStatistics_p->allocCount = statistics.allocCount;
+    pStatistics_p->allocFailCount = statistics.allocFailCount;
+
+    return kErrorOk;
+#else
+    UNUSED_PARAMETER(pStatistics_p);
+
+    return kErrorApiNotSupported;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get DLL queue statistics
+
+The function obtains the occupancy statistics of an asynchronous Tx queue of the
+data link layer. The statistics contain the high-water marks of the queue and
+the number of frames which were rejected or discarded because the queue was
+full. They can be used to dimension the queues with the initialization
+parameter aDllQueueSize of \ref tOplkApiInitParam.
+
+\param[in]      queue_p             The queue to get the statistics from.
+\param[out]     pStatistics_p       Pointer to memory where the statistics should
+                                    be stored.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The statistics were obtained successfully.
+\retval kErrorApiInvalidParam       The queue or the pointer is invalid.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+\retval kErrorApiNotSupported       The queue is not included or the queue
+                                    implementation provides no statistics.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_getDllQueueStatistics(tOplkApiDllQueue queue_p,
+                                      tOplkApiDllQueueStatistics* pStatistics_p)
+{
+    tOplkError              ret;
+    tDllCalQueue            dllCalQueue;
+    tDllCalQueueStatistics  statistics;
+
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    if (pStatistics_p == NULL)
+        return kErrorApiInvalidParam;
+
+    switch (queue_p)
+    {
+        case kOplkApiDllQueueTxNmt:
+            dllCalQueue = kDllCalQueueTxNmt;
+            break;
+
+        case kOplkApiDllQueueTxGen:
+            dllCalQueue = kDllCalQueueTxGen;
+            break;
+
+        case kOplkApiDllQueueTxSync:
+            dllCalQueue = kDllCalQueueTxSync;
+            break;
+
+        case kOplkApiDllQueueTxVeth:
+            dllCalQueue = kDllCalQueueTxVeth;
+            break;
+
+        default:
+            return kErrorApiInvalidParam;
+    }
+
+    ret = dllucal_getQueueStatistics(dllCalQueue, &statistics);
+    if (ret != kErrorOk)
+        return ret;
+
+    pStatistics_p->queueSize = statistics.queueSize;
+    pStatistics_p->usedSize = statistics.usedSize;
+    pStatistics_p->maxUsedSize = statistics.maxUsedSize;
+    pStatistics_p->frameCount = statistics.frameCount;
+    pStatistics_p->maxFrameCount = statistics.maxFrameCount;
+    pStatistics_p->rejectCount = statistics.rejectCount;
+    pStatistics_p->discardCount = statistics.discardCount;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Plan the isochronous schedule of the MN
+
+The function assigns the passed CNs to continuous or multiplexed slots so that
+the predicted cycle time is minimized. Nodes whose update rate allows it are
+distributed over the multiplexed cycles, PRes chaining nodes are always served
+in every cycle. The input members of the node structures can be initialized
+with oplk_getIsochronousScheduleNodeTiming().
+
+The resulting schedule and the predicted cycle budget are stored in the passed
+structures and published for oplk_getIsochronousSchedule(). The schedule is
+not applied to the object dictionary.
+
+\param[in]      pParam_p            Pointer to the planning parameters.
+\param[in,out]  aNodes_p            Array of the nodes to be planned. The
+                                    assigned cycle and slot time of each node
+                                    are filled by the function.
+\param[in]      nodeCount_p         Number of nodes in the array.
+\param[out]     pPlan_p             Pointer to store the schedule plan.
+
+\note   The function is only used on an MN. On a CN it always returns
+        \ref kErrorApiInvalidParam.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The schedule was planned successfully.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+\retval Other                       Error occurred while planning the schedule.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_planIsochronousSchedule(const tOplkApiSchedPlanParam* pParam_p,
+                                        tOplkApiSchedNode* aNodes_p,
+                                        UINT nodeCount_p,
+                                        tOplkApiSchedPlan* pPlan_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    return nmtmnuplan_calcSchedule(pParam_p, aNodes_p, nodeCount_p, pPlan_p);
+#else
+    UNUSED_PARAMETER(pParam_p);
+    UNUSED_PARAMETER(aNodes_p);
+    UNUSED_PARAMETER(nodeCount_p);
+    UNUSED_PARAMETER(pPlan_p);
+
+    return kErrorApiInvalidParam;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the planned isochronous schedule of the MN
+
+The function returns the schedule and the predicted cycle budget which were
+calculated by the last call of oplk_planIsochronousSchedule().
+
+\param[out]     pPlan_p             Pointer to store the schedule plan.
+\param[out]     aNodes_p            Array to store the planned nodes. May be NULL
+                                    if only the plan is required.
+\param[in,out]  pNodeCount_p        Pointer to the number of elements of the
+                                    node array. It receives the number of planned
+                                    nodes.
+
+\note   The function is only used on an MN. On a CN it always returns
+        \ref kErrorApiInvalidParam.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The schedule was returned successfully.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+\retval kErrorInvalidOperation      No schedule was planned yet.
+\retval Other                       Error occurred while reading the schedule.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_getIsochronousSchedule(tOplkApiSchedPlan* pPlan_p,
+                                       tOplkApiSchedNode* aNodes_p,
+                                       UINT* pNodeCount_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    return nmtmnuplan_getSchedule(pPlan_p, aNodes_p, pNodeCount_p);
+#else
+    UNUSED_PARAMETER(pPlan_p);
+    UNUSED_PARAMETER(aNodes_p);
+    UNUSED_PARAMETER(pNodeCount_p);
+
+    return kErrorApiInvalidParam;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the schedule timing requirements of a node
+
+The function initializes a schedule planning node structure for the specified
+CN from the object dictionary of the MN and the PRes chaining measurement. The
+update rate is derived from the current multiplexed cycle assignment and can be
+changed by the application before the structure is passed to
+oplk_planIsochronousSchedule().
+
+\param[in]      nodeId_p            Node ID of the CN.
+\param[out]     pNode_p             Pointer to store the node timing.
+
+\note   The function is only used on an MN. On a CN it always returns
+        \ref kErrorApiInvalidParam.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The node timing was read successfully.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+\retval Other                       Error occurred while reading the node timing.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_getIsochronousScheduleNodeTiming(UINT nodeId_p,
+                                                 tOplkApiSchedNode* pNode_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    return nmtmnuplan_getNodeTiming(nodeId_p, pNode_p);
+#else
+    UNUSED_PARAMETER(nodeId_p);
+    UNUSED_PARAMETER(pNode_p);
+
+    return kErrorApiInvalidParam;
+#endif
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Exchange input application process data
@@ -1789,6 +2335,97 @@ tOplkError oplk_getIdentResponse(UINT nodeId_p,
 #endif
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Read IdentResponse of node
+
+The function copies the latest IdentResponse which was received from the
+specified node. The copy is consistent even if a new IdentResponse is received
+at the same time. Unlike oplk_getIdentResponse() the function can be called
+from any thread.
+
+\param[in]      nodeId_p            Node ID of which to read the IdentResponse.
+\param[out]     pIdentResponse_p    Pointer to store the IdentResponse.
+
+\note   The function is only used on an MN. On a CN it returns always
+        \ref kErrorApiInvalidParam.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The IdentResponse was copied.
+\retval kErrorInvalidOperation      No IdentResponse was received from the node.
+\retval kErrorRetry                 The IdentResponse is currently updated.
+\retval kErrorApiInvalidParam       Invalid parameters.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_readIdentResponse(UINT nodeId_p,
+                                  tIdentResponse* pIdentResponse_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    if ((nodeId_p == C_ADR_INVALID) ||
+        (nodeId_p > NMT_MAX_NODE_ID) ||
+        (pIdentResponse_p == NULL))
+        return kErrorApiInvalidParam;
+
+    return respstoreu_readIdentResponse(nodeId_p, pIdentResponse_p);
+#else
+    UNUSED_PARAMETER(nodeId_p);
+    UNUSED_PARAMETER(pIdentResponse_p);
+
+    return kErrorApiInvalidParam;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read StatusResponse of node
+
+The function copies the latest StatusResponse which was received from the
+specified node. The copy is consistent even if a new StatusResponse is
+received at the same time. The function can be called from any thread.
+
+\param[in]      nodeId_p            Node ID of which to read the StatusResponse.
+\param[out]     pStatusResponse_p   Pointer to store the StatusResponse.
+
+\note   The function is only used on an MN. On a CN it returns always
+        \ref kErrorApiInvalidParam.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The StatusResponse was copied.
+\retval kErrorInvalidOperation      No StatusResponse was received from the node.
+\retval kErrorRetry                 The StatusResponse is currently updated.
+\retval kErrorApiInvalidParam       Invalid parameters.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_readStatusResponse(UINT nodeId_p,
+                                   tStatusResponse* pStatusResponse_p)
+{
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    if ((nodeId_p == C_ADR_INVALID) ||
+        (nodeId_p > NMT_MAX_NODE_ID) ||
+        (pStatusResponse_p == NULL))
+        return kErrorApiInvalidParam;
+
+    return respstoreu_readStatusResponse(nodeId_p, pStatusResponse_p);
+#else
+    UNUSED_PARAMETER(nodeId_p);
+    UNUSED_PARAMETER(pStatusResponse_p);
+
+    return kErrorApiInvalidParam;
+#endif
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get Ethernet Interface MAC address
@@ -1855,6 +2492,164 @@ tOplkError oplk_triggerPresForward(UINT nodeId_p)
 #endif
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Assign the RPDOs of a node to an RPDO worker thread
+
+The function assigns the RPDOs received from node \p nodeId_p to the RPDO
+worker thread \p worker_p. The RPDOs of a node are always copied by one worker,
+so that they are written in the order of their reception. By default the nodes
+are distributed among the workers by their node ID. The function can be used
+to balance the load of the workers if the PDO sizes of the nodes differ.
+
+\note The RPDO workers are only available if the stack is compiled with
+      CONFIG_PDOK_RX_WORKER_COUNT unequal to 0.
+
+\param[in]      nodeId_p            Node ID of the RPDO source. 0 selects the
+                                    RPDOs received from the PReq.
+\param[in]      worker_p            Index of the RPDO worker thread.
+
+\return The function returns a \ref tOplkError error code.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_setRxPdoWorker(UINT nodeId_p, UINT worker_p)
+{
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+    tEvent              event;
+    tPdoRxWorkerParam   workerParam;
+
+    if ((nodeId_p >= C_ADR_BROADCAST) || (worker_p >= CONFIG_PDOK_RX_WORKER_COUNT))
+        return kErrorApiInvalidParam;
+
+    workerParam.nodeId = (UINT16)nodeId_p;
+    workerParam.worker = (UINT16)worker_p;
+
+    event.eventSink = kEventSinkPdokCal;
+    event.netTime.nsec = 0;
+    event.netTime.sec = 0;
+    event.eventType = kEventTypePdokRxWorker;
+    event.eventArg.pEventArg = &workerParam;
+    event.eventArgSize = sizeof(workerParam);
+
+    return eventu_postEvent(&event);
+#else
+    UNUSED_PARAMETER(nodeId_p);
+    UNUSED_PARAMETER(worker_p);
+
+    return kErrorApiNotSupported;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get RPDO worker statistics
+
+The function obtains the statistics of the received frames which were
+dispatched to an RPDO worker thread. The receive context never waits for a
+worker, therefore frames are dropped if the queue of the worker is full or
+while the PDO channels are changed. The drop counters show if the queue size
+CONFIG_PDOK_RX_WORKER_QUEUE_SIZE or the assignment of the nodes to the workers
+(see \ref oplk_setRxPdoWorker()) must be adapted.
+
+\note The RPDO workers are only available if the stack is compiled with
+      CONFIG_PDOK_RX_WORKER_COUNT unequal to 0. They run in the same process
+      as the application.
+
+\param[in]      worker_p            Index of the RPDO worker thread.
+\param[out]     pStatistics_p       Pointer to memory where the statistics should
+                                    be stored.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The statistics were obtained successfully.
+\retval kErrorApiInvalidParam       The worker or the pointer is invalid.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+\retval kErrorApiNotSupported       The RPDO workers are not included.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_getRxPdoWorkerStatistics(UINT worker_p,
+                                         tOplkApiRxPdoWorkerStatistics* pStatistics_p)
+{
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+    tPdokRxWorkerStatistics statistics;
+
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    if ((pStatistics_p == NULL) ||
+        (pdokrxworker_getStatistics(worker_p, &statistics) != kErrorOk))
+        return kErrorApiInvalidParam;
+
+    pStatistics_p->queuedCount = statistics.queuedCount;
+    pStatistics_p->fullDropCount = statistics.fullDropCount;
+    pStatistics_p->pauseDropCount = statistics.pauseDropCount;
+    pStatistics_p->maxUsedCount = statistics.maxUsedCount;
+
+    return kErrorOk;
+#else
+    UNUSED_PARAMETER(worker_p);
+    UNUSED_PARAMETER(pStatistics_p);
+
+    return kErrorApiNotSupported;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get high-resolution timer statistics
+
+The function obtains the achieved accuracy of the high-resolution timer which
+triggers the cycle. The latency and the late wakeups show if the wakeup margin
+of the timer (CONFIG_HRESTIMER_SPIN_MARGIN_MIN/MAX) must be adapted.
+
+\note The statistics are only available if the stack is compiled with
+      CONFIG_HRESTIMER_USE_DIAGNOSTICS, which is set for the sleep-and-spin
+      timer of the single process Linux libraries.
+
+\param[out]     pStatistics_p       Pointer to memory where the statistics should
+                                    be stored.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The statistics were obtained successfully.
+\retval kErrorApiInvalidParam       The pointer is invalid.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+\retval kErrorApiNotSupported       The timer statistics are not included.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_getHresTimerStatistics(tOplkApiHresTimerStatistics* pStatistics_p)
+{
+#if (CONFIG_HRESTIMER_USE_DIAGNOSTICS != FALSE)
+    tHresTimerDiagnostics   diagnostics;
+
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    if ((pStatistics_p == NULL) ||
+        (hrestimer_getDiagnostics(&diagnostics) != kErrorOk))
+        return kErrorApiInvalidParam;
+
+    pStatistics_p->expireCount = diagnostics.expireCount;
+    pStatistics_p->latencySum = diagnostics.latencySum;
+    pStatistics_p->latencyMin = diagnostics.latencyMin;
+    pStatistics_p->latencyMax = diagnostics.latencyMax;
+    pStatistics_p->wakeupMargin = diagnostics.wakeupMargin;
+    pStatistics_p->overshootMax = diagnostics.overshootMax;
+    pStatistics_p->lateWakeupCount = diagnostics.lateWakeupCount;
+    pStatistics_p->missedPeriodCount = diagnostics.missedPeriodCount;
+
+    return kErrorOk;
+#else
+    UNUSED_PARAMETER(pStatistics_p);
+
+    return kErrorApiNotSupported;
+#endif
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -44,6 +44,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/oplkinc.h>
 #include <user/pdou.h>
 #include <user/ctrlu.h>
+#include <user/timesyncu.h>
+#include <user/obdu.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -69,6 +71,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define PI_BINDING_SIGNATURE_INIT       0xFFFFFFFFUL    // Initial value of the binding signature (CRC-32)
+#define PI_BINDING_SIGNATURE_POLY       0xEDB88320UL    // Reflected CRC-32 polynomial
 
 //------------------------------------------------------------------------------
 // local types
@@ -97,6 +101,9 @@ static tApiProcessImageInstance instance_l =
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static tOplkError calcBindingSignature(const tOplkApiProcessImageBinding* pBinding_p,
+                                       UINT32* pSignature_p);
+static UINT32 updateSignature(UINT32 signature_p, UINT32 value_p, UINT size_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -292,6 +299,130 @@ tOplkError oplk_linkProcessImageObject(UINT objIndex_p,
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Bind process images
+
+The function sets up the process images with a binding which was generated at
+build time from the openCONFIGURATOR project output. Instead of linking the
+whole object ranges of the process image profile, only the objects listed in
+the link table of the binding are linked. The binding is checked against its
+signature before it is used. The signature also covers the data types of the
+bound objects, which are taken from the project by the generator and from the
+object dictionary of the stack by this function. Therefore, a binding of a
+project which does not match the object dictionary is rejected.
+
+If the process images are not allocated yet, they are allocated with the sizes
+of the binding. Otherwise the sizes of the allocated images have to match the
+binding.
+
+\note If the function fails, process images which were allocated by the
+      function are freed again. Process images which were allocated before by
+      \ref oplk_allocProcessImage() are kept and remain owned by the caller.
+      Objects which were already linked refer to the process images, so the
+      stack has to be shut down before freed or kept images are released.
+
+\param[in]      pBinding_p          Pointer to the process image binding.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    Process images are successfully bound.
+\retval kErrorApiInvalidParam       Invalid parameters specified.
+\retval kErrorApiPIBindingInvalid   The binding does not match its signature,
+                                    the allocated process images or the object
+                                    dictionary.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+
+\ingroup module_api
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_bindProcessImage(const tOplkApiProcessImageBinding* pBinding_p)
+{
+    tOplkError                      ret;
+    const tOplkApiProcessImageLink* pLink;
+    const tOplkApiProcessImage*     pImage;
+    UINT32                          i;
+    UINT32                          signature;
+    UINT32                          imageSize;
+    UINT                            varEntries;
+    tObdSize                        entrySize;
+    BOOL                            fAllocated = FALSE;
+
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    if ((pBinding_p == NULL) ||
+        ((pBinding_p->pLinks == NULL) && (pBinding_p->linkCount != 0)))
+        return kErrorApiInvalidParam;
+
+    if ((calcBindingSignature(pBinding_p, &signature) != kErrorOk) ||
+        (signature != pBinding_p->signature))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Signature of process image binding does not match\n", __func__);
+        return kErrorApiPIBindingInvalid;
+    }
+
+    // check all links before the process images are allocated
+    for (i = 0, pLink = pBinding_p->pLinks; i < pBinding_p->linkCount; i++, pLink++)
+    {
+        imageSize = (pLink->fOutputPI != FALSE) ? pBinding_p->sizeProcessImageOut :
+                                                  pBinding_p->sizeProcessImageIn;
+
+        if ((pLink->varEntries == 0) ||
+            ((pLink->offsetPI + ((size_t)pLink->varEntries * pLink->entrySize)) > imageSize))
+            return kErrorApiPIBindingInvalid;
+    }
+
+    if ((instance_l.inputImage.pImage == NULL) && (instance_l.outputImage.pImage == NULL))
+    {
+        ret = oplk_allocProcessImage(pBinding_p->sizeProcessImageIn,
+                                     pBinding_p->sizeProcessImageOut);
+        if (ret != kErrorOk)
+            return ret;
+
+        fAllocated = TRUE;
+    }
+    else if ((instance_l.inputImage.imageSize != pBinding_p->sizeProcessImageIn) ||
+             (instance_l.outputImage.imageSize != pBinding_p->sizeProcessImageOut))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Allocated process images do not match the binding\n", __func__);
+        return kErrorApiPIBindingInvalid;
+    }
+
+    for (i = 0, pLink = pBinding_p->pLinks; i < pBinding_p->linkCount; i++, pLink++)
+    {
+        pImage = (pLink->fOutputPI != FALSE) ? &instance_l.outputImage : &instance_l.inputImage;
+
+        varEntries = pLink->varEntries;
+        entrySize = pLink->entrySize;
+        ret = oplk_linkObject(pLink->objIndex,
+                              (UINT8*)pImage->pImage + pLink->offsetPI,
+                              &varEntries,
+                              &entrySize,
+                              pLink->firstSubindex);
+        if (ret != kErrorOk)
+            goto Exit;
+
+        if (varEntries != pLink->varEntries)
+        {   // object dictionary does not provide the sub-indices of the binding
+            DEBUG_LVL_ERROR_TRACE("%s() Object 0x%04X provides only %u of %u entries\n",
+                                  __func__,
+                                  pLink->objIndex,
+                                  varEntries,
+                                  pLink->varEntries);
+            ret = kErrorApiPIBindingInvalid;
+            goto Exit;
+        }
+    }
+
+    return kErrorOk;
+
+Exit:
+    if (fAllocated)
+        oplk_freeProcessImage();
+
+    return ret;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Exchange input process image
@@ -313,6 +444,9 @@ tOplkError oplk_exchangeProcessImageIn(void)
     if (!ctrlu_stackIsInitialized())
         return kErrorApiNotInitialized;
 
+    // The application has finished the processing of the sync event
+    timesyncu_finishSyncProcessing();
+
     if (instance_l.inputImage.pImage != NULL)
         ret = pdou_copyTxPdoFromPi();
     else
@@ -418,4 +552,93 @@ tOplkError oplk_setupProcessImage(void)
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief  Calculate signature of a process image binding
+
+The function calculates the CRC-32 of the process image sizes, the link table
+and the data types of all bound sub-indices. The data types are read from the
+object dictionary. The values are processed in little endian byte order, like
+it is done by the binding generator.
+
+\param[in]      pBinding_p          Pointer to the process image binding.
+\param[out]     pSignature_p        Pointer to store the signature of the binding.
+
+\return The function returns a tOplkError error code. It fails if a bound
+        sub-index does not exist in the object dictionary.
+*/
+//------------------------------------------------------------------------------
+static tOplkError calcBindingSignature(const tOplkApiProcessImageBinding* pBinding_p,
+                                       UINT32* pSignature_p)
+{
+    tOplkError                      ret;
+    UINT32                          signature = PI_BINDING_SIGNATURE_INIT;
+    const tOplkApiProcessImageLink* pLink;
+    UINT32                          i;
+    UINT                            subindex;
+    tObdType                        type;
+
+    signature = updateSignature(signature, pBinding_p->sizeProcessImageIn, 4);
+    signature = updateSignature(signature, pBinding_p->sizeProcessImageOut, 4);
+    signature = updateSignature(signature, pBinding_p->linkCount, 4);
+
+    for (i = 0, pLink = pBinding_p->pLinks; i < pBinding_p->linkCount; i++, pLink++)
+    {
+        signature = updateSignature(signature, pLink->objIndex, 2);
+        signature = updateSignature(signature, pLink->firstSubindex, 1);
+        signature = updateSignature(signature, pLink->fOutputPI, 1);
+        signature = updateSignature(signature, pLink->entrySize, 2);
+        signature = updateSignature(signature, pLink->varEntries, 2);
+        signature = updateSignature(signature, pLink->offsetPI, 4);
+
+        for (subindex = pLink->firstSubindex;
+             subindex < ((UINT)pLink->firstSubindex + pLink->varEntries);
+             subindex++)
+        {
+            ret = obdu_getType(pLink->objIndex, subindex, &type);
+            if (ret != kErrorOk)
+                return ret;
+
+            signature = updateSignature(signature, (UINT32)type, 2);
+        }
+    }
+
+    *pSignature_p = ~signature;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Update signature
+
+The function adds the lower \p size_p bytes of a value to the signature.
+
+\param[in]      signature_p         Current signature value.
+\param[in]      value_p             Value to add.
+\param[in]      size_p              Number of bytes of the value.
+
+\return The function returns the updated signature.
+*/
+//------------------------------------------------------------------------------
+static UINT32 updateSignature(UINT32 signature_p, UINT32 value_p, UINT size_p)
+{
+    UINT    i;
+    UINT    bit;
+
+    for (i = 0; i < size_p; i++)
+    {
+        signature_p ^= (value_p >> (i * 8)) & 0xFF;
+        for (bit = 0; bit < 8; bit++)
+        {
+            if ((signature_p & 1) != 0)
+                signature_p = (signature_p >> 1) ^ PI_BINDING_SIGNATURE_POLY;
+            else
+                signature_p >>= 1;
+        }
+    }
+
+    return signature_p;
+}
+
 /// \}
@@ -43,6 +43,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <user/ctrlu.h>
 #include <user/ctrlucal.h>
+#include <user/dllucal.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -177,6 +178,56 @@ tOplkError oplk_serviceExecFirmwareReconfig(BOOL fFactory_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Read frame capture record
+
+The function reads the next record from the frame capture ring of the kernel
+DLL. The record starts with a \ref tOplkApiCaptureRecord header which is
+directly followed by the captured frame bytes. A buffer of the size of the
+header plus the configured capture length can hold every record.
+
+The kernel stack never waits for the reader. If the application reads the
+records too slowly, the records are dropped and counted in the drop count of
+the next record.
+
+\param[out]     pBuffer_p           Pointer to the buffer which stores the record.
+\param[in]      bufferSize_p        Size of the buffer.
+\param[out]     pRecordSize_p       Pointer to store the size of the record. It
+                                    is set to 0 if no record is available.
+
+\return The function returns a \ref tOplkError error code.
+\retval kErrorOk                    The record was read or no record is available.
+\retval kErrorApiInvalidParam       A pointer is invalid or the buffer is too small.
+\retval kErrorApiNotInitialized     openPOWERLINK stack is not initialized.
+\retval kErrorApiNotSupported       The frame capture is not included.
+
+\ingroup module_service
+*/
+//------------------------------------------------------------------------------
+tOplkError oplk_serviceReadCaptureRecord(void* pBuffer_p,
+                                         size_t bufferSize_p,
+                                         size_t* pRecordSize_p)
+{
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+    if (!ctrlu_stackIsInitialized())
+        return kErrorApiNotInitialized;
+
+    if ((pBuffer_p == NULL) || (pRecordSize_p == NULL))
+        return kErrorApiInvalidParam;
+
+    return dllucal_readCaptureRecord(pBuffer_p, bufferSize_p, pRecordSize_p);
+#else
+    UNUSED_PARAMETER(pBuffer_p);
+    UNUSED_PARAMETER(bufferSize_p);
+
+    if (pRecordSize_p != NULL)
+        *pRecordSize_p = 0;
+
+    return kErrorApiNotSupported;
+#endif
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
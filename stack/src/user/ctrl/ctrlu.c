@@ -55,9 +55,14 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <user/nmtcnu.h>
 #include <user/obdu.h>
 #include <user/obdal.h>
+#include <user/obdview.h>
 #include <user/timesyncu.h>
 #include <oplk/dll.h>
 
+#if (TARGET_SYSTEM == _LINUX_)
+#include <common/targetthread.h>
+#endif
+
 #if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
 #include <user/obdconf.h>
 #endif
@@ -66,6 +71,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <user/nmtmnu.h>
 #include <user/identu.h>
 #include <user/statusu.h>
+#include <user/respstoreu.h>
 #include <user/syncu.h>
 #endif
 
@@ -78,6 +84,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <user/sdocom.h>
 #endif
 
+#if defined(CONFIG_INCLUDE_SDOC)
+#include <user/sdobatch.h>
+#endif
+
 #if defined(CONFIG_INCLUDE_CFM)
 #include <user/cfmu.h>
 #include <oplk/obdcdc.h>
@@ -365,6 +375,12 @@ tOplkError ctrlu_initStack(const tOplkApiInitParam* pInitParam_p)
         goto Exit;
     }
 
+#if (TARGET_SYSTEM == _LINUX_)
+    // Place the running stack threads and the threads created by the stack initialization
+    target_setThreadPlacement(ctrlInstance_l.initParam.aThreadPlacement,
+                              tabentries(ctrlInstance_l.initParam.aThreadPlacement));
+#endif
+
     ret = initObd(&ctrlInstance_l.initParam);
     if (ret != kErrorOk)
         goto Exit;
@@ -394,6 +410,10 @@ tOplkError ctrlu_initStack(const tOplkApiInitParam* pInitParam_p)
     DEBUG_LVL_CTRL_TRACE("Initializing kernel modules ...\n");
     OPLK_MEMCPY(ctrlParam.aMacAddress, ctrlInstance_l.initParam.aMacAddress, sizeof(ctrlParam.aMacAddress));
     strncpy(ctrlParam.aNetIfName, ctrlInstance_l.initParam.hwParam.pDevName, sizeof(ctrlParam.aNetIfName) - 1);
+    ctrlParam.dllCalQueueSizes.txNmtSize = ctrlInstance_l.initParam.aDllQueueSize[kOplkApiDllQueueTxNmt];
+    ctrlParam.dllCalQueueSizes.txGenSize = ctrlInstance_l.initParam.aDllQueueSize[kOplkApiDllQueueTxGen];
+    ctrlParam.dllCalQueueSizes.txSyncSize = ctrlInstance_l.initParam.aDllQueueSize[kOplkApiDllQueueTxSync];
+    ctrlParam.dllCalQueueSizes.txVethSize = ctrlInstance_l.initParam.aDllQueueSize[kOplkApiDllQueueTxVeth];
     ctrlucal_storeInitParam(&ctrlParam);
 
     ret = ctrlucal_executeCmd(kCtrlInitStack, &retVal);
@@ -464,6 +484,13 @@ tOplkError ctrlu_initStack(const tOplkApiInitParam* pInitParam_p)
         goto Exit;
 #endif
 
+#if defined(CONFIG_INCLUDE_SDOC)
+    DEBUG_LVL_CTRL_TRACE("Initialize sdobatch module...\n");
+    ret = sdobatch_init();
+    if (ret != kErrorOk)
+        goto Exit;
+#endif
+
 #if defined(CONFIG_INCLUDE_CFM)
     DEBUG_LVL_CTRL_TRACE("Initialize cfm module...\n");
     ret = cfmu_init(cbCfmEventCnProgress, cbCfmEventCnResult);
@@ -512,6 +539,14 @@ tOplkError ctrlu_shutdownStack(void)
     }
 #endif
 
+#if defined(CONFIG_INCLUDE_SDOC)
+    ret = sdobatch_exit();
+    if (ret != kErrorOk)
+    {
+        DEBUG_LVL_ERROR_TRACE("sdobatch_exit(): 0x%X\n", ret);
+    }
+#endif
+
 #if (defined(CONFIG_INCLUDE_SDOS) || defined(CONFIG_INCLUDE_SDOC))
     ret = sdocom_exit();
     if (ret != kErrorOk)
@@ -539,6 +574,8 @@ tOplkError ctrlu_shutdownStack(void)
         DEBUG_LVL_ERROR_TRACE("statusu_exit(): 0x%X\n", ret);
     }
 
+    respstoreu_exit();
+
     ret = syncu_exit();
     if (ret != kErrorOk)
     {
@@ -619,12 +656,18 @@ tOplkError ctrlu_shutdownStack(void)
     obdcdc_exit();
 #endif
 
+    obdview_exit();
+
     ret = obdu_exit();
     if (ret != kErrorOk)
     {
         DEBUG_LVL_ERROR_TRACE("obdu_exit():    0x%X\n", ret);
     }
 
+#if (TARGET_SYSTEM == _LINUX_)
+    target_clearThreadPlacement();
+#endif
+
     return ret;
 }
 
@@ -827,6 +870,11 @@ UINT32 ctrlu_getFeatureFlags(void)
 
 This function writes the given file chunk to the kernel stack.
 
+If the control CAL provides a file chunk ring, the function returns as soon as
+the chunk is stored in the ring. An error of the kernel stack is then reported
+by the following call, at the latest by the call for the last chunk of the file
+which waits until all chunks are processed.
+
 \param[in]      pDesc_p             Descriptor for the file chunk.
 \param[in]      pBuffer_p           Buffer holding the file chunk.
 
@@ -925,6 +973,12 @@ static tOplkError initNmtu(const tOplkApiInitParam* pInitParam_p)
     if (ret != kErrorOk)
         goto Exit;
 
+    // initialize respstoreu module
+    DEBUG_LVL_CTRL_TRACE("Initialize respstoreu module...\n");
+    ret = respstoreu_init();
+    if (ret != kErrorOk)
+        goto Exit;
+
     // initialize identu module
     DEBUG_LVL_CTRL_TRACE("Initialize identu module...\n");
     ret = identu_init();
@@ -969,6 +1023,11 @@ static tOplkError initObd(const tOplkApiInitParam* pInitParam_p)
     if (ret != kErrorOk)
         return ret;
 
+    DEBUG_LVL_CTRL_TRACE("Initialize obdview module...\n");
+    ret = obdview_init();
+    if (ret != kErrorOk)
+        return ret;
+
 #if defined(CONFIG_INCLUDE_CFM)
     ret = obdcdc_init();
 #endif
@@ -1253,6 +1312,18 @@ static tOplkError processUserEvent(const tEvent* pEvent_p)
             break;
 #endif
 
+        // PRes response time statistics of the CN
+        case kEventTypePresResponseTime:
+            if (pEvent_p->eventArgSize != sizeof(tDllEventPresResponseTime))
+            {
+                ret = kErrorEventWrongSize;
+                break;
+            }
+
+            eventType = kOplkApiEventPresResponseTime;
+            ret = ctrlu_callUserEventCallback(eventType, (const tOplkApiEventArg*)pEvent_p->eventArg.pEventArg);
+            break;
+
         // at present, there are no other events for this module
         default:
             ret = kErrorInvalidEvent;
@@ -1435,6 +1506,12 @@ static tOplkError updateDllConfig(const tOplkApiInitParam* pInitParam_p,
     if (ret != kErrorOk)
         return ret;
 
+    ret = timesyncu_setCycleTime(dllConfigParam.cycleLen,
+                                 pInitParam_p->minSyncTime,
+                                 pInitParam_p->maxSyncTime);
+    if (ret != kErrorOk)
+        return ret;
+
     if (fUpdateIdentity_p != FALSE)
     {
         // configure Identity
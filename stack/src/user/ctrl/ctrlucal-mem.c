@@ -77,15 +77,28 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
+/**
+\brief User control CAL instance
+
+The structure contains the access to the file chunk ring of the control buffer.
+*/
+typedef struct
+{
+    tCtrlFileChunkRingAccess    fileChunkRing;  ///< File chunk ring access
+} tCtrluCalInstance;
 
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
+static tCtrluCalInstance    instance_l;
 
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
-static UINT16 getMagic(void);
+static UINT16       getMagic(void);
+static tOplkError   writeData(size_t offset_p,
+                              const void* pSrc_p,
+                              size_t length_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -104,6 +117,11 @@ The function initializes the user control CAL module.
 //------------------------------------------------------------------------------
 tOplkError ctrlucal_init(void)
 {
+    ctrlcal_initFileChunkRing(&instance_l.fileChunkRing,
+                              ctrlcal_readData,
+                              writeData,
+                              target_msleep);
+
     return ctrlcal_init(sizeof(tCtrlBuf));
 }
 
@@ -143,6 +161,12 @@ tOplkError ctrlucal_process(void)
 
 The function executes a control command in the kernel stack.
 
+The command kCtrlWriteFileChunk commits the file chunk stored with
+ctrlucal_writeFileBuffer() to the file chunk ring. It returns without waiting
+for the kernel stack, except for the last chunk of a file. The returned value
+is the return value of the first failed chunk of the file which was
+acknowledged so far.
+
 \param[in]      cmd_p               Command to execute.
 \param[out]     pRetVal_p           Return value from the control command.
 
@@ -160,6 +184,9 @@ tOplkError ctrlucal_executeCmd(tCtrlCmdType cmd_p,
     // Check parameter validity
     ASSERT(pRetVal_p != NULL);
 
+    if (cmd_p == kCtrlWriteFileChunk)
+        return ctrlcal_commitFileChunk(&instance_l.fileChunkRing, pRetVal_p);
+
     /* write command into shared buffer */
     ctrlCmd.cmd = cmd_p;
     ctrlCmd.retVal = 0;
@@ -343,7 +370,10 @@ tOplkError ctrlucal_readInitParam(tCtrlInitParam* pInitParam_p)
 /**
 \brief  Write file chunk
 
-This function writes the given file chunk to the file transfer buffer
+This function writes the given file chunk to the next free slot of the file
+chunk ring. It only waits if all slots are occupied by chunks which are not yet
+acknowledged by the kernel stack. The chunk is passed to the kernel stack by
+executing the command kCtrlWriteFileChunk.
 
 \param[in]      pDesc_p             Descriptor for the file chunk.
 \param[in]      pBuffer_p           Buffer holding the file chunk.
@@ -356,11 +386,7 @@ This function writes the given file chunk to the file transfer buffer
 tOplkError ctrlucal_writeFileBuffer(const tOplkApiFileChunkDesc* pDesc_p,
                                     const void* pBuffer_p)
 {
-    UNUSED_PARAMETER(pDesc_p);
-    UNUSED_PARAMETER(pBuffer_p);
-
-    // This CAL is not supporting that feature -> return no resource available.
-    return kErrorNoResource;
+    return ctrlcal_writeFileChunk(&instance_l.fileChunkRing, pDesc_p, pBuffer_p);
 }
 
 //------------------------------------------------------------------------------
@@ -377,8 +403,7 @@ CAL implementation.
 //------------------------------------------------------------------------------
 size_t ctrlucal_getFileBufferSize(void)
 {
-    // This CAL is not supporting that feature -> return zero size.
-    return 0;
+    return CTRL_FILE_CHUNK_SLOT_SIZE;
 }
 
 //------------------------------------------------------------------------------
@@ -457,4 +482,27 @@ static UINT16 getMagic(void)
     return 0;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Write data to the control buffer
+
+The function writes data to the control buffer. It is used by the file chunk
+ring.
+
+\param[in]      offset_p            Offset in the control buffer.
+\param[in]      pSrc_p              Pointer to the data to be written.
+\param[in]      length_p            Length of the data to be written.
+
+\return The function returns kErrorOk.
+*/
+//------------------------------------------------------------------------------
+static tOplkError writeData(size_t offset_p,
+                            const void* pSrc_p,
+                            size_t length_p)
+{
+    ctrlcal_writeData(offset_p, pSrc_p, length_p);
+
+    return kErrorOk;
+}
+
 /// \}
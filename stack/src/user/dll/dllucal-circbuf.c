@@ -96,7 +96,8 @@ typedef struct
 // local function prototypes
 //------------------------------------------------------------------------------
 static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p,
-                              tDllCalQueue DllCalQueue_p);
+                              tDllCalQueue DllCalQueue_p,
+                              size_t queueSize_p);
 static tOplkError delInstance(tDllCalQueueInstance pDllCalQueue_p);
 static tOplkError insertDataBlock(tDllCalQueueInstance pDllCalQueue_p,
                                   const void* pData_p,
@@ -107,6 +108,8 @@ static tOplkError getDataBlock(tDllCalQueueInstance pDllCalQueue_p,
 static tOplkError getDataBlockCount(tDllCalQueueInstance pDllCalQueue_p,
                                     UINT* pDataBlockCount_p);
 static tOplkError resetDataBlockQueue(tDllCalQueueInstance pDllCalQueue_p);
+static tOplkError getStatistics(tDllCalQueueInstance pDllCalQueue_p,
+                                tDllCalQueueStatistics* pStatistics_p);
 
 /* define external function interface */
 static tDllCalFuncIntf funcintf_l =
@@ -116,7 +119,8 @@ static tDllCalFuncIntf funcintf_l =
     insertDataBlock,
     getDataBlock,
     getDataBlockCount,
-    resetDataBlockQueue
+    resetDataBlockQueue,
+    getStatistics
 };
 
 //============================================================================//
@@ -154,6 +158,8 @@ Add an instance for TX packet forwarding in DLL CAL.
 
 \param[out]     ppDllCalQueue_p     Double-pointer to DllCal Queue instance
 \param[in]      dllCalQueue_p       Parameter that determines the queue
+\param[in]      queueSize_p         Size of the queue. It is not used because the
+                                    queue is created by the kernel layer.
 
 \return The function returns a tOplkError error code.
 \retval kErrorOk                    Function executes correctly
@@ -161,12 +167,15 @@ Add an instance for TX packet forwarding in DLL CAL.
 */
 //------------------------------------------------------------------------------
 static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p,
-                              tDllCalQueue dllCalQueue_p)
+                              tDllCalQueue dllCalQueue_p,
+                              size_t queueSize_p)
 {
     tOplkError              ret = kErrorOk;
     tCircBufError           error = kCircBufOk;
     tDllCalCircBufInstance* pDllCalCircBufInstance;
 
+    UNUSED_PARAMETER(queueSize_p);
+
     // Check parameter validity
     ASSERT(ppDllCalQueue_p != NULL);
 
@@ -279,6 +288,21 @@ static tOplkError insertDataBlock(tDllCalQueueInstance pDllCalQueue_p,
     error = circbuf_writeData(pDllCalCircBufInstance->pCircBufInstance,
                               pData_p,
                               dataSize_p);
+#if (CONFIG_DLLCAL_TX_OVERFLOW_POLICY == DLLCAL_TX_OVERFLOW_DISCARD_OLDEST)
+    // NMT and SyncRequest frames are never discarded, the caller has to retry
+    if ((pDllCalCircBufInstance->dllCalQueue == kDllCalQueueTxGen) ||
+        (pDllCalCircBufInstance->dllCalQueue == kDllCalQueueTxVeth))
+    {
+        while ((error == kCircBufBufferFull) &&
+               (circbuf_discardData(pDllCalCircBufInstance->pCircBufInstance) == kCircBufOk))
+        {
+            error = circbuf_writeData(pDllCalCircBufInstance->pCircBufInstance,
+                                      pData_p,
+                                      dataSize_p);
+        }
+    }
+#endif
+
     switch (error)
     {
         case kCircBufOk:
@@ -410,4 +434,45 @@ static tOplkError resetDataBlockQueue(tDllCalQueueInstance pDllCalQueue_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get queue statistics
+
+Returns the occupancy statistics of the DLL CAL queue. The statistics are kept
+in the shared buffer header and include the accesses of the kernel layer.
+
+\param[in]      pDllCalQueue_p      Pointer to DllCal Queue instance
+\param[out]     pStatistics_p       Pointer to store the statistics
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    Function executes correctly
+\retval other                       Error
+*/
+//------------------------------------------------------------------------------
+static tOplkError getStatistics(tDllCalQueueInstance pDllCalQueue_p,
+                                tDllCalQueueStatistics* pStatistics_p)
+{
+    const tDllCalCircBufInstance*   pDllCalCircBufInstance =
+                                        (const tDllCalCircBufInstance*)pDllCalQueue_p;
+    tCircBufStatistics              statistics;
+
+    // Check parameter validity
+    ASSERT(pStatistics_p != NULL);
+
+    if (pDllCalCircBufInstance == NULL)
+        return kErrorInvalidInstanceParam;
+
+    circbuf_getStatistics(pDllCalCircBufInstance->pCircBufInstance, &statistics);
+
+    pStatistics_p->queueSize = statistics.bufferSize;
+    pStatistics_p->usedSize = statistics.usedSize;
+    pStatistics_p->maxUsedSize = statistics.maxUsedSize;
+    pStatistics_p->frameCount = statistics.dataCount;
+    pStatistics_p->maxFrameCount = statistics.maxDataCount;
+    pStatistics_p->rejectCount = statistics.fullCount;
+    pStatistics_p->discardCount = statistics.discardCount;
+
+    return kErrorOk;
+}
+
 /// \}
@@ -100,7 +100,8 @@ typedef struct
 // local function prototypes
 //------------------------------------------------------------------------------
 static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p,
-                              tDllCalQueue DllCalQueue_p);
+                              tDllCalQueue DllCalQueue_p,
+                              size_t queueSize_p);
 static tOplkError delInstance(tDllCalQueueInstance pDllCalQueue_p);
 static tOplkError insertDataBlock(tDllCalQueueInstance pDllCalQueue_p,
                                   const void* pData_p,
@@ -114,6 +115,7 @@ static tDllCalFuncIntf funcintf_l =
     insertDataBlock,
     NULL,
     NULL,
+    NULL,
     NULL
 };
 
@@ -152,6 +154,8 @@ Add an instance for TX packet forwarding in DLL CAL.
 
 \param[out]     ppDllCalQueue_p     Double-pointer to DllCal Queue instance
 \param[in]      dllCalQueue_p       Parameter that determines the queue
+\param[in]      queueSize_p         Size of the queue. It is not used because the
+                                    queue is created by the kernel driver
 
 \return The function returns a tOplkError error code.
 \retval kErrorOk                    Function executes correctly
@@ -159,11 +163,14 @@ Add an instance for TX packet forwarding in DLL CAL.
 */
 //------------------------------------------------------------------------------
 static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p,
-                              tDllCalQueue dllCalQueue_p)
+                              tDllCalQueue dllCalQueue_p,
+                              size_t queueSize_p)
 {
     tOplkError              ret = kErrorOk;
     tDllCalIoctlInstance*   pInstance;
 
+    UNUSED_PARAMETER(queueSize_p);
+
     // Check parameter validity
     ASSERT(ppDllCalQueue_p != NULL);
 
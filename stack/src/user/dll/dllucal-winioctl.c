@@ -97,7 +97,8 @@ typedef struct
 // local function prototypes
 //------------------------------------------------------------------------------
 static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p,
-                              tDllCalQueue dllCalQueue_p);
+                              tDllCalQueue dllCalQueue_p,
+                              size_t queueSize_p);
 static tOplkError delInstance(tDllCalQueueInstance pDllCalQueue_p);
 static tOplkError insertDataBlock(tDllCalQueueInstance pDllCalQueue_p,
                                   const void* pData_p,
@@ -111,6 +112,7 @@ static tDllCalFuncIntf    funcIntf_l =
     insertDataBlock,
     NULL,
     NULL,
+    NULL,
     NULL
 };
 
@@ -149,6 +151,8 @@ Add an instance for TX packet forwarding in DLL CAL.
 
 \param[out]     ppDllCalQueue_p     Double-pointer to DllCal Queue instance.
 \param[in]      dllCalQueue_p       Parameter that determines the queue.
+\param[in]      queueSize_p         Size of the queue. It is not used because the
+                                    queue is created by the kernel driver.
 
 \return The function returns a tOplkError error code.
 \retval kErrorOk                    Function executes correctly
@@ -156,10 +160,13 @@ Add an instance for TX packet forwarding in DLL CAL.
 */
 //------------------------------------------------------------------------------
 static tOplkError addInstance(tDllCalQueueInstance* ppDllCalQueue_p,
-                              tDllCalQueue dllCalQueue_p)
+                              tDllCalQueue dllCalQueue_p,
+                              size_t queueSize_p)
 {
     tDllCalIoctlInstance*   pInstance;
 
+    UNUSED_PARAMETER(queueSize_p);
+
     // Check parameter validity
     ASSERT(ppDllCalQueue_p != NULL);
 
@@ -46,6 +46,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/dllcal.h>
 #include <common/ami.h>
 
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+#include <common/circbuffer.h>
+#endif
+
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
 //============================================================================//
@@ -57,6 +61,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #error "DLLCal module does not support direct calls with PRC MN"
 #endif
 
+#if ((CONFIG_DLL_FRAME_CAPTURE != FALSE) && (CONFIG_DLLCAL_QUEUE == IOCTL_QUEUE))
+#error "DLLCal module does not support the frame capture with IOCTL queues"
+#endif
+
 //------------------------------------------------------------------------------
 // module global vars
 //------------------------------------------------------------------------------
@@ -104,6 +112,11 @@ typedef struct
     tDllCalQueueInstance     dllCalQueueTxSync;         ///< DLL CAL queue instance for SyncRequest frames
     tDllCalFuncIntf*         pTxSyncFuncs;              ///< Function pointer to the TX functions for SyncRequest frames
 #endif
+
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+    tCircBufInstance*        pQueueCapture;             ///< Shared memory of the frame capture rings
+    tDllCalCaptureRing*      pCaptureRing;              ///< Frame capture rings, one per direction
+#endif
 } tDlluCalInstance;
 
 //------------------------------------------------------------------------------
@@ -119,6 +132,7 @@ static tDlluCalInstance     instance_l;
 
 static tOplkError setAsndServiceIdFilter(tDllAsndServiceId ServiceId_p,
                                          tDllAsndFilter Filter_p);
+static tOplkError processAsndRxEvent(const tEvent* pEvent_p);
 static tOplkError handleRxAsyncFrame(const tFrameInfo* pFrameInfo_p);
 static tOplkError handleRxAsndFrame(const tFrameInfo* pFrameInfo_p);
 static tOplkError handleRxAsyncFrameInfo(tFrameInfo* pFrameInfo_p);
@@ -157,29 +171,48 @@ tOplkError dllucal_init(void)
 #endif
 
     ret = instance_l.pTxNmtFuncs->pfnAddInstance(&instance_l.dllCalQueueTxNmt,
-                                                 kDllCalQueueTxNmt);
+                                                 kDllCalQueueTxNmt,
+                                                 0);
     if (ret != kErrorOk)
         goto Exit;
 
     ret = instance_l.pTxGenFuncs->pfnAddInstance(&instance_l.dllCalQueueTxGen,
-                                                 kDllCalQueueTxGen);
+                                                 kDllCalQueueTxGen,
+                                                 0);
     if (ret != kErrorOk)
         goto Exit;
 
 #if defined(CONFIG_INCLUDE_NMT_MN)
     ret = instance_l.pTxSyncFuncs->pfnAddInstance(&instance_l.dllCalQueueTxSync,
-                                                  kDllCalQueueTxSync);
+                                                  kDllCalQueueTxSync,
+                                                  0);
     if (ret != kErrorOk)
         goto Exit;
 #endif
 
 #if defined(CONFIG_INCLUDE_VETH)
     ret = instance_l.pTxVethFuncs->pfnAddInstance(&instance_l.dllCalQueueTxVeth,
-                                                  kDllCalQueueTxVeth);
+                                                  kDllCalQueueTxVeth,
+                                                  0);
     if (ret != kErrorOk)
         goto Exit;
 #endif
 
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+    if (circbuf_connect(CIRCBUF_DLLCAL_CAPTURE, &instance_l.pQueueCapture) != kCircBufOk)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Connect CIRCBUF_DLLCAL_CAPTURE failed\n", __func__);
+        ret = kErrorNoResource;
+        goto Exit;
+    }
+
+    instance_l.pCaptureRing = (tDllCalCaptureRing*)instance_l.pQueueCapture->pCircBuf;
+#endif
+
+    ret = eventu_registerEventHandler(kEventSinkDlluCal,
+                                      kEventTypeAsndRx,
+                                      processAsndRxEvent);
+
 Exit:
     return ret;
 }
@@ -213,6 +246,11 @@ tOplkError dllucal_exit(void)
     if (instance_l.pTxVethFuncs != NULL)
         instance_l.pTxVethFuncs->pfnDelInstance(instance_l.dllCalQueueTxVeth);
     dllucal_regNonPlkHandler(NULL);
+#endif
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+    instance_l.pCaptureRing = NULL;
+    if (instance_l.pQueueCapture != NULL)
+        circbuf_disconnect(instance_l.pQueueCapture);
 #endif
     // reset instance structure
     OPLK_MEMSET(&instance_l, 0, sizeof(instance_l));
@@ -238,7 +276,6 @@ tOplkError dllucal_process(const tEvent* pEvent_p)
     tOplkError              ret;
     tFrameInfo*             pFrameInfo;
     const tDllAsndNotRx*    pAsndNotRx;
-    tFrameInfo              frameInfo;
 
     // Check parameter validity
     ASSERT(pEvent_p != NULL);
@@ -246,11 +283,7 @@ tOplkError dllucal_process(const tEvent* pEvent_p)
     switch (pEvent_p->eventType)
     {
         case kEventTypeAsndRx:
-            // Argument pointer is frame
-            frameInfo.frame.pBuffer = (tPlkFrame*)pEvent_p->eventArg.pEventArg;
-            frameInfo.frameSize = pEvent_p->eventArgSize;
-            pFrameInfo = &frameInfo;
-            ret = handleRxAsyncFrame(pFrameInfo);
+            ret = processAsndRxEvent(pEvent_p);
             break;
 
         case kEventTypeAsndRxInfo:
@@ -456,6 +489,69 @@ Exit:
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get statistics of an asynchronous Tx queue
+
+The function obtains the occupancy statistics of an asynchronous Tx queue. The
+statistics include the frames inserted by the user and the kernel layer.
+
+\param[in]      queue_p             The queue to get the statistics from.
+\param[out]     pStatistics_p       Pointer to store the statistics.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The statistics were obtained successfully.
+\retval kErrorApiNotSupported       The queue is not included or its
+                                    implementation provides no statistics.
+
+\ingroup module_dllucal
+*/
+//------------------------------------------------------------------------------
+tOplkError dllucal_getQueueStatistics(tDllCalQueue queue_p,
+                                      tDllCalQueueStatistics* pStatistics_p)
+{
+    const tDllCalFuncIntf*  pFuncs;
+    tDllCalQueueInstance    queueInstance;
+
+    // Check parameter validity
+    ASSERT(pStatistics_p != NULL);
+
+    switch (queue_p)
+    {
+        case kDllCalQueueTxNmt:
+            pFuncs = instance_l.pTxNmtFuncs;
+            queueInstance = instance_l.dllCalQueueTxNmt;
+            break;
+
+        case kDllCalQueueTxGen:
+            pFuncs = instance_l.pTxGenFuncs;
+            queueInstance = instance_l.dllCalQueueTxGen;
+            break;
+
+#if defined(CONFIG_INCLUDE_NMT_MN)
+        case kDllCalQueueTxSync:
+            pFuncs = instance_l.pTxSyncFuncs;
+            queueInstance = instance_l.dllCalQueueTxSync;
+            break;
+#endif
+
+#if defined(CONFIG_INCLUDE_VETH)
+        case kDllCalQueueTxVeth:
+            pFuncs = instance_l.pTxVethFuncs;
+            queueInstance = instance_l.dllCalQueueTxVeth;
+            break;
+#endif
+
+        default:
+            return kErrorApiNotSupported;
+    }
+
+    if (pFuncs->pfnGetStatistics == NULL)
+        return kErrorApiNotSupported;
+
+    return pFuncs->pfnGetStatistics(queueInstance, pStatistics_p);
+}
+
 #if defined(CONFIG_INCLUDE_NMT_MN)
 //------------------------------------------------------------------------------
 /**
@@ -537,6 +633,102 @@ tOplkError dllucal_issueSyncRequest(const tDllSyncRequest* pSyncRequest_p,
 }
 #endif
 
+#if (CONFIG_DLL_FRAME_CAPTURE != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Read a frame capture record
+
+The function reads the next record from the frame capture rings of the kernel
+DLL. A record consists of a \ref tOplkApiCaptureRecord header which is directly
+followed by the captured frame bytes. If records of both directions are
+available, the record with the older timestamp is read first.
+
+\param[out]     pBuffer_p           Pointer to the buffer which stores the record.
+\param[in]      bufferSize_p        Size of the buffer.
+\param[out]     pRecordSize_p       Pointer to store the size of the record. It
+                                    is set to 0 if the rings are empty.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The record was read or the rings are empty.
+\retval kErrorApiInvalidParam       The buffer is too small for the next record.
+\retval kErrorNoResource            The capture rings are not available.
+
+\ingroup module_dllucal
+*/
+//------------------------------------------------------------------------------
+tOplkError dllucal_readCaptureRecord(void* pBuffer_p,
+                                     size_t bufferSize_p,
+                                     size_t* pRecordSize_p)
+{
+    tDllCalCaptureRing*     pRing;
+    tDllCalCaptureRecord*   pSlot = NULL;
+    tOplkApiCaptureRecord   header;
+    tOplkApiCaptureRecord   oldestHeader;
+    UINT                    oldestRing = DLLCAL_CAPTURE_RING_COUNT;
+    UINT                    ringIndex;
+    UINT32                  readIndex;
+    size_t                  recordSize;
+
+    // Check parameter validity
+    ASSERT(pBuffer_p != NULL);
+    ASSERT(pRecordSize_p != NULL);
+
+    *pRecordSize_p = 0;
+
+    if (instance_l.pCaptureRing == NULL)
+        return kErrorNoResource;
+
+    for (ringIndex = 0; ringIndex < DLLCAL_CAPTURE_RING_COUNT; ringIndex++)
+    {
+        pRing = &instance_l.pCaptureRing[ringIndex];
+
+        OPLK_DCACHE_INVALIDATE(&pRing->writeIndex, sizeof(pRing->writeIndex));
+        readIndex = pRing->readIndex;
+        if (readIndex == pRing->writeIndex)
+            continue;
+
+        // Don't read the slot before the producer has published it
+        DLLCAL_CAPTURE_BARRIER();
+
+        pSlot = &pRing->aSlot[readIndex];
+        OPLK_DCACHE_INVALIDATE(&pSlot->header, sizeof(pSlot->header));
+        OPLK_MEMCPY(&header, &pSlot->header, sizeof(header));
+        if ((oldestRing == DLLCAL_CAPTURE_RING_COUNT) ||
+            (header.timestamp < oldestHeader.timestamp))
+        {
+            oldestRing = ringIndex;
+            oldestHeader = header;
+        }
+    }
+
+    if (oldestRing == DLLCAL_CAPTURE_RING_COUNT)
+        return kErrorOk;
+
+    pRing = &instance_l.pCaptureRing[oldestRing];
+    readIndex = pRing->readIndex;
+    pSlot = &pRing->aSlot[readIndex];
+
+    recordSize = sizeof(oldestHeader) + oldestHeader.captureSize;
+    if (recordSize > bufferSize_p)
+        return kErrorApiInvalidParam;
+
+    OPLK_DCACHE_INVALIDATE(pSlot->aData, oldestHeader.captureSize);
+    OPLK_MEMCPY(pBuffer_p, &oldestHeader, sizeof(oldestHeader));
+    OPLK_MEMCPY((UINT8*)pBuffer_p + sizeof(oldestHeader), pSlot->aData, oldestHeader.captureSize);
+
+    // Release the slot after it has been copied
+    DLLCAL_CAPTURE_BARRIER();
+    readIndex++;
+    if (readIndex == DLLCAL_CAPTURE_RING_SLOTS)
+        readIndex = 0;
+    pRing->readIndex = readIndex;
+    OPLK_DCACHE_FLUSH(&pRing->readIndex, sizeof(pRing->readIndex));
+
+    *pRecordSize_p = recordSize;
+
+    return kErrorOk;
+}
+#endif
 
 #if (NMT_MAX_NODE_ID > 0)
 //------------------------------------------------------------------------------
@@ -675,6 +867,28 @@ static tOplkError setAsndServiceIdFilter(tDllAsndServiceId serviceId_p,
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Process received asynchronous frame event
+
+This function is the event type handler of the received asynchronous frame
+event. The argument of the event is the received frame.
+
+\param[in]      pEvent_p            Pointer to the received frame event
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError processAsndRxEvent(const tEvent* pEvent_p)
+{
+    tFrameInfo  frameInfo;
+
+    frameInfo.frame.pBuffer = (tPlkFrame*)pEvent_p->eventArg.pEventArg;
+    frameInfo.frameSize = pEvent_p->eventArgSize;
+
+    return handleRxAsyncFrame(&frameInfo);
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Forward asynchronous frame to desired user space module
@@ -82,31 +82,103 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define EVENTU_SINK_TABLE_SIZE      (kEventSinkTimesynck + 1)   // Size of the dispatch table, indexed by the event sink
+#define EVENTU_TYPE_TABLE_SIZE      0x40                        // Number of event types covered by the type dispatch table
+#define EVENTU_TYPE_HANDLER_COUNT   8                           // Maximum number of registered event type handlers
 
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
 
+/**
+\brief Event sink layers
+
+The enumeration lists the layers an event sink can be located in.
+*/
+typedef enum
+{
+    kEventuSinkLayerKernel = 0,                 ///< Events are posted to the kernel layer
+    kEventuSinkLayerUser                        ///< Events are posted to the user layer
+} eEventuSinkLayer;
+
+/**
+\brief Event sink layer data type
+
+Data type for the enumerator \ref eEventuSinkLayer.
+*/
+typedef UINT8 tEventuSinkLayer;
+
+/**
+\brief Event sink registration
+
+The structure describes an event sink known to the user event module. It
+defines the queue the events of the sink are posted to and, for sinks processed
+by eventu_process(), the process function of the sink module.
+*/
+typedef struct
+{
+    tEventSink          eventSink;              ///< Event sink
+    tEventuSinkLayer    sinkLayer;              ///< Layer the event sink is located in
+    tProcessEventCb     pfnProcess;             ///< Process function of the sink module (NULL if not processed by eventu_process())
+    tEventSource        eventSource;            ///< Event source used for error events of the sink module
+} tEventuSinkEntry;
+
 /**
 \brief Event user instance type
 
-The user event instance holds the API process callback function pointer.
+The user event instance holds the API process callback function pointer, the
+dispatch table which is built from the sink registrations when the module is
+initialized and the event type handlers which are registered by the modules.
 */
 typedef struct
 {
     tProcessEventCb         pfnApiProcessEventCb;  ///< Callback for generic API events
     BOOL                    fInitialized;          ///< Flag to determine status of eventu module
+    const tEventuSinkEntry* apSinkEntry[EVENTU_SINK_TABLE_SIZE];   ///< Dispatch table indexed by the event sink
+    tProcessEventCb         apfnTypeHandler[EVENTU_TYPE_HANDLER_COUNT];    ///< Registered event type handlers
+    UINT                    typeHandlerCount;                       ///< Number of registered event type handlers
+    UINT8                   aTypeIndex[EVENTU_SINK_TABLE_SIZE][EVENTU_TYPE_TABLE_SIZE];    ///< Index + 1 of the event type handler (0 = processed by the sink)
 } tEventuInstance;
 
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
 static tOplkError callApiEventCb(const tEvent* pEvent_p);
+static tOplkError ignoreEvent(const tEvent* pEvent_p);
+static tProcessEventCb getTypeHandler(const tEvent* pEvent_p);
 
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
-static tEventuInstance      instance_l;
+static const tEventuSinkEntry   aSinkRegistration_l[] =
+{
+    // Event sink           Sink layer              Process function        Event source
+    {kEventSinkDlluCal,     kEventuSinkLayerUser,   dllucal_process,        kEventSourceDllu},
+    {kEventSinkNmtu,        kEventuSinkLayerUser,   nmtu_processEvent,      kEventSourceNmtu},
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    {kEventSinkNmtMnu,      kEventuSinkLayerUser,   nmtmnu_processEvent,    kEventSourceNmtMnu},
+#else
+    {kEventSinkNmtMnu,      kEventuSinkLayerUser,   NULL,                   kEventSourceNmtMnu},
+#endif
+#if (defined(CONFIG_INCLUDE_SDOC) || defined(CONFIG_INCLUDE_SDOS))
+    {kEventSinkSdoAsySeq,   kEventuSinkLayerUser,   sdoseq_processEvent,    kEventSourceSdoAsySeq},
+#else
+    {kEventSinkSdoAsySeq,   kEventuSinkLayerUser,   NULL,                   kEventSourceSdoAsySeq},
+#endif
+    {kEventSinkErru,        kEventuSinkLayerUser,   ignoreEvent,            kEventSourceInvalid},
+    {kEventSinkApi,         kEventuSinkLayerUser,   callApiEventCb,         kEventSourceOplkApi},
+    {kEventSinkSdoTest,     kEventuSinkLayerUser,   sdotestcom_cbEvent,     kEventSourceSdoTest},
+    {kEventSinkSync,        kEventuSinkLayerKernel, NULL,                   kEventSourceInvalid},
+    {kEventSinkNmtk,        kEventuSinkLayerKernel, NULL,                   kEventSourceInvalid},
+    {kEventSinkDllk,        kEventuSinkLayerKernel, NULL,                   kEventSourceInvalid},
+    {kEventSinkDllkCal,     kEventuSinkLayerKernel, NULL,                   kEventSourceInvalid},
+    {kEventSinkPdok,        kEventuSinkLayerKernel, NULL,                   kEventSourceInvalid},
+    {kEventSinkPdokCal,     kEventuSinkLayerKernel, NULL,                   kEventSourceInvalid},
+    {kEventSinkErrk,        kEventuSinkLayerKernel, NULL,                   kEventSourceInvalid},
+    {kEventSinkTimesynck,   kEventuSinkLayerKernel, NULL,                   kEventSourceInvalid},
+};
+
+static tEventuInstance          instance_l;
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -131,11 +203,18 @@ the init function of its CAL module.
 tOplkError eventu_init(tProcessEventCb pfnApiProcessEventCb_p)
 {
     tOplkError  ret;
+    UINT        i;
 
     OPLK_MEMSET(&instance_l, 0, sizeof(tEventuInstance));
 
     instance_l.pfnApiProcessEventCb = pfnApiProcessEventCb_p;
 
+    for (i = 0; i < tabentries(aSinkRegistration_l); i++)
+    {
+        ASSERT(aSinkRegistration_l[i].eventSink < EVENTU_SINK_TABLE_SIZE);
+        instance_l.apSinkEntry[aSinkRegistration_l[i].eventSink] = &aSinkRegistration_l[i];
+    }
+
     ret = eventucal_init();
     if (ret == kErrorOk)
         instance_l.fInitialized = TRUE;
@@ -170,9 +249,10 @@ tOplkError eventu_exit(void)
 /**
 \brief    User event handler
 
-This function processes events posted to the user layer. It examines the
-sink and forwards the events by calling the event process function of the
-specific module
+This function processes events posted to the user layer. It looks up the sink
+in the dispatch table and forwards the events by calling the event process
+function of the specific module. If the module has registered a handler for
+the event type, the handler is called instead.
 
 \param[in]      pEvent_p            Received event.
 
@@ -185,8 +265,9 @@ specific module
 //------------------------------------------------------------------------------
 tOplkError eventu_process(const tEvent* pEvent_p)
 {
-    tOplkError      ret = kErrorOk;
-    tEventSource    eventSource = kEventSourceInvalid;
+    tOplkError              ret;
+    const tEventuSinkEntry* pSinkEntry = NULL;
+    tProcessEventCb         pfnTypeHandler;
 
     // Check parameter validity
     ASSERT(pEvent_p != NULL);
@@ -197,62 +278,33 @@ tOplkError eventu_process(const tEvent* pEvent_p)
         return kErrorNoResource;
     }
 
-    switch (pEvent_p->eventSink)
-    {
-        case kEventSinkDlluCal:
-            ret = dllucal_process(pEvent_p);
-            eventSource = kEventSourceDllu;
-            break;
-
-        case kEventSinkNmtu:
-            ret = nmtu_processEvent(pEvent_p);
-            eventSource = kEventSourceNmtu;
-            break;
-
-#if defined(CONFIG_INCLUDE_NMT_MN)
-        case kEventSinkNmtMnu:
-            ret = nmtmnu_processEvent(pEvent_p);
-            eventSource = kEventSourceNmtMnu;
-            break;
-#endif
+    if (pEvent_p->eventSink < EVENTU_SINK_TABLE_SIZE)
+        pSinkEntry = instance_l.apSinkEntry[pEvent_p->eventSink];
 
-#if (defined(CONFIG_INCLUDE_SDOC) || defined(CONFIG_INCLUDE_SDOS))
-        case kEventSinkSdoAsySeq:
-            ret = sdoseq_processEvent(pEvent_p);
-            eventSource = kEventSourceSdoAsySeq;
-            break;
-#endif
-
-        case kEventSinkErru:
-            break;
-
-        case kEventSinkApi:
-            ret = callApiEventCb(pEvent_p);
-            eventSource = kEventSourceOplkApi;
-            break;
-
-        case kEventSinkSdoTest:
-            ret = sdotestcom_cbEvent(pEvent_p);
-            eventSource = kEventSourceSdoTest;
-            break;
-
-        default:
-            // Unknown sink, provide error event to API layer
-            eventu_postError(kEventSourceEventu,
-                             ret,
-                             sizeof(pEvent_p->eventSink),
-                             &pEvent_p->eventSink);
-            ret = kErrorEventUnknownSink;
-            break;
+    if ((pSinkEntry == NULL) || (pSinkEntry->pfnProcess == NULL))
+    {
+        // Unknown sink, provide error event to API layer
+        ret = kErrorEventUnknownSink;
+        eventu_postError(kEventSourceEventu,
+                         ret,
+                         sizeof(pEvent_p->eventSink),
+                         &pEvent_p->eventSink);
+        return ret;
     }
 
+    // Event types with a registered handler skip the event type switch of the sink module
+    pfnTypeHandler = getTypeHandler(pEvent_p);
+    if (pfnTypeHandler != NULL)
+        ret = pfnTypeHandler(pEvent_p);
+    else
+        ret = pSinkEntry->pfnProcess(pEvent_p);
     if ((ret != kErrorOk) && (ret != kErrorShutdown))
     {
         // forward error event to API layer
         eventu_postError(kEventSourceEventu,
                          ret,
-                         sizeof(eventSource),
-                         &eventSource);
+                         sizeof(pSinkEntry->eventSource),
+                         &pSinkEntry->eventSource);
     }
 
     return ret;
@@ -276,7 +328,8 @@ CAL module which distributes the event to the suitable event queue.
 //------------------------------------------------------------------------------
 tOplkError eventu_postEvent(const tEvent* pEvent_p)
 {
-    tOplkError  ret = kErrorOk;
+    tOplkError              ret;
+    const tEventuSinkEntry* pSinkEntry = NULL;
 
     // Check parameter validity
     ASSERT(pEvent_p != NULL);
@@ -287,55 +340,40 @@ tOplkError eventu_postEvent(const tEvent* pEvent_p)
         return kErrorNoResource;
     }
 
+    if (pEvent_p->eventSink < EVENTU_SINK_TABLE_SIZE)
+        pSinkEntry = instance_l.apSinkEntry[pEvent_p->eventSink];
+
+    if (pSinkEntry == NULL)
+        return kErrorEventUnknownSink;
+
     // Split event post to user internal and user to kernel
-    switch (pEvent_p->eventSink)
+    if (pSinkEntry->sinkLayer == kEventuSinkLayerKernel)
     {
-        // kernel layer modules
-        case kEventSinkSync:
-        case kEventSinkNmtk:
-        case kEventSinkDllk:
-        case kEventSinkDllkCal:
-        case kEventSinkPdok:
-        case kEventSinkPdokCal:
-        case kEventSinkErrk:
-        case kEventSinkTimesynck:
-            DEBUG_LVL_EVENTU_TRACE("U2K type:%s(%d) sink:%s(%d) size:%d!\n",
-                                   debugstr_getEventTypeStr(pEvent_p->eventType),
-                                   pEvent_p->eventType,
-                                   debugstr_getEventSinkStr(pEvent_p->eventSink),
-                                   pEvent_p->eventSink,
-                                   pEvent_p->eventArgSize);
-            ret = eventucal_postKernelEvent(pEvent_p);
-            if (ret != kErrorOk)
-            {
-                DEBUG_LVL_ERROR_TRACE("User to kernel event could not be posted!!\n");
-            }
-            break;
-
-        // user layer modules
-        case kEventSinkNmtMnu:
-        case kEventSinkNmtu:
-        case kEventSinkSdoAsySeq:
-        case kEventSinkApi:
-        case kEventSinkSdoTest:
-        case kEventSinkDlluCal:
-        case kEventSinkErru:
-            DEBUG_LVL_EVENTU_TRACE("UINT  type:%s(%d) sink:%s(%d) size:%d!\n",
-                                   debugstr_getEventTypeStr(pEvent_p->eventType),
-                                   pEvent_p->eventType,
-                                   debugstr_getEventSinkStr(pEvent_p->eventSink),
-                                   pEvent_p->eventSink,
-                                   pEvent_p->eventArgSize);
-            ret = eventucal_postUserEvent(pEvent_p);
-            if (ret != kErrorOk)
-            {
-                DEBUG_LVL_ERROR_TRACE("User internal event could not be posted!!\n");
-            }
-            break;
-
-        default:
-            ret = kErrorEventUnknownSink;
-            break;
+        DEBUG_LVL_EVENTU_TRACE("U2K type:%s(%d) sink:%s(%d) size:%d!\n",
+                               debugstr_getEventTypeStr(pEvent_p->eventType),
+                               pEvent_p->eventType,
+                               debugstr_getEventSinkStr(pEvent_p->eventSink),
+                               pEvent_p->eventSink,
+                               pEvent_p->eventArgSize);
+        ret = eventucal_postKernelEvent(pEvent_p);
+        if (ret != kErrorOk)
+        {
+            DEBUG_LVL_ERROR_TRACE("User to kernel event could not be posted!!\n");
+        }
+    }
+    else
+    {
+        DEBUG_LVL_EVENTU_TRACE("UINT  type:%s(%d) sink:%s(%d) size:%d!\n",
+                               debugstr_getEventTypeStr(pEvent_p->eventType),
+                               pEvent_p->eventType,
+                               debugstr_getEventSinkStr(pEvent_p->eventSink),
+                               pEvent_p->eventSink,
+                               pEvent_p->eventArgSize);
+        ret = eventucal_postUserEvent(pEvent_p);
+        if (ret != kErrorOk)
+        {
+            DEBUG_LVL_ERROR_TRACE("User internal event could not be posted!!\n");
+        }
     }
 
     return ret;
@@ -390,6 +428,62 @@ tOplkError eventu_postError(tEventSource eventSource_p,
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief    Register an event type handler
+
+This function registers a handler for a single event type of a user event
+sink. Events of this type are passed to the handler instead of the process
+function of the sink module. Modules register the handlers of their frequent
+events in their init functions, after the user event module is initialized.
+
+\param[in]      eventSink_p         Event sink of the event type.
+\param[in]      eventType_p         Event type to register.
+\param[in]      pfnProcess_p        Process function of the event type.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The handler was registered.
+\retval kErrorEventUnknownSink      The sink is not processed in the user layer.
+\retval kErrorInvalidEvent          The event type is out of range.
+\retval kErrorNoResource            No free handler entry is available.
+
+\ingroup module_eventu
+*/
+//------------------------------------------------------------------------------
+tOplkError eventu_registerEventHandler(tEventSink eventSink_p,
+                                       tEventType eventType_p,
+                                       tProcessEventCb pfnProcess_p)
+{
+    const tEventuSinkEntry* pSinkEntry = NULL;
+    UINT8*                  pTypeIndex;
+
+    // Check parameter validity
+    ASSERT(pfnProcess_p != NULL);
+
+    if (eventSink_p < EVENTU_SINK_TABLE_SIZE)
+        pSinkEntry = instance_l.apSinkEntry[eventSink_p];
+
+    if ((pSinkEntry == NULL) || (pSinkEntry->pfnProcess == NULL))
+        return kErrorEventUnknownSink;
+
+    if (eventType_p >= EVENTU_TYPE_TABLE_SIZE)
+        return kErrorInvalidEvent;
+
+    pTypeIndex = &instance_l.aTypeIndex[eventSink_p][eventType_p];
+    if (*pTypeIndex == 0)
+    {
+        if (instance_l.typeHandlerCount >= EVENTU_TYPE_HANDLER_COUNT)
+            return kErrorNoResource;
+
+        instance_l.typeHandlerCount++;
+        *pTypeIndex = (UINT8)instance_l.typeHandlerCount;
+    }
+
+    instance_l.apfnTypeHandler[*pTypeIndex - 1] = pfnProcess_p;
+
+    return kErrorOk;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
@@ -416,4 +510,51 @@ static tOplkError callApiEventCb(const tEvent* pEvent_p)
     return kErrorEventPostError;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Ignore event
+
+This function is registered for event sinks whose events are accepted but not
+processed in the user layer.
+
+\param[in]      pEvent_p            Pointer to event.
+
+\return The function returns kErrorOk.
+*/
+//------------------------------------------------------------------------------
+static tOplkError ignoreEvent(const tEvent* pEvent_p)
+{
+    UNUSED_PARAMETER(pEvent_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the registered handler of an event type
+
+This function looks up the handler registered for the sink and type of an
+event.
+
+\param[in]      pEvent_p            Event to look up.
+
+\return The function returns the event type handler or NULL if no handler is
+        registered.
+*/
+//------------------------------------------------------------------------------
+static tProcessEventCb getTypeHandler(const tEvent* pEvent_p)
+{
+    UINT8   typeIndex;
+
+    if ((pEvent_p->eventSink >= EVENTU_SINK_TABLE_SIZE) ||
+        (pEvent_p->eventType >= EVENTU_TYPE_TABLE_SIZE))
+        return NULL;
+
+    typeIndex = instance_l.aTypeIndex[pEvent_p->eventSink][pEvent_p->eventType];
+    if (typeIndex == 0)
+        return NULL;
+
+    return instance_l.apfnTypeHandler[typeIndex - 1];
+}
+
 /// \}
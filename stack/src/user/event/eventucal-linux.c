@@ -46,6 +46,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <user/eventucal.h>
 #include <user/eventucalintf.h>
 #include <common/target.h>
+#include <common/targetthread.h>
 
 #include <time.h>
 #include <fcntl.h>
@@ -128,7 +129,6 @@ CAL module.
 //------------------------------------------------------------------------------
 tOplkError eventucal_init(void)
 {
-    struct sched_param  schedParam;
 
     OPLK_MEMSET(&instance_l, 0, sizeof(tEventuCalInstance));
 
@@ -155,17 +155,10 @@ tOplkError eventucal_init(void)
     if (pthread_create(&instance_l.threadId, NULL, eventThread, (void*)&instance_l) != 0)
         goto Exit;
 
-    schedParam.sched_priority = USER_EVENT_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.threadId, SCHED_FIFO, &schedParam) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
-                              __func__,
-                              schedParam.sched_priority);
-    }
-
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(instance_l.threadId, "oplk-eventu");
-#endif
+    target_registerThread(instance_l.threadId,
+                          kOplkApiThreadEventu,
+                          "oplk-eventu",
+                          USER_EVENT_THREAD_PRIORITY);
 
     instance_l.fInitialized = TRUE;
     return kErrorOk;
@@ -204,6 +197,7 @@ tOplkError eventucal_exit(void)
 
     if (instance_l.fInitialized != FALSE)
     {
+        target_unregisterThread(instance_l.threadId);
         instance_l.fStopThread = TRUE;
         while (instance_l.fStopThread != FALSE)
         {
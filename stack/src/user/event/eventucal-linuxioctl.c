@@ -10,7 +10,9 @@ This user event CAL module implementation uses ioctl calls on Linux.
 
 This file implements the user event handler CAL module for the Linux
 userspace platform. It uses the ioctl() calls to communicate with a kernel
-CAL module running in Linux kernelspace.
+CAL module running in Linux kernelspace. The events of the kernel module are
+read from an event ring in a shared memory (tEventShm) without a system call.
+The event thread only blocks in the kernel module if the ring is empty.
 
 \ingroup module_eventucal
 *******************************************************************************/
@@ -53,9 +55,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/target.h>
 #include <common/driver.h>
 #include <oplk/debugstr.h>
+#include <common/targetthread.h>
 
 #include <pthread.h>
+#include <unistd.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -98,6 +103,7 @@ typedef struct
     OPLK_FILE_HANDLE    fd;
     pthread_t           threadId;
     BOOL                fStopThread;
+    tEventShm*          pEventShm;          ///< Shared memory containing the kernel-to-user event ring
 } tEventuCalInstance;
 
 //------------------------------------------------------------------------------
@@ -110,6 +116,7 @@ static tEventuCalInstance    instance_l;
 //------------------------------------------------------------------------------
 static void*      eventThread(void* arg_p);
 static tOplkError postEvent(const tEvent* pEvent_p);
+static BOOL       readEventShm(tEvent* pEvent_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -133,28 +140,33 @@ implementations and calls the appropriate init functions.
 tOplkError eventucal_init(void)
 {
     tOplkError          ret = kErrorOk;
-    struct sched_param  schedParam;
 
     OPLK_MEMSET(&instance_l, 0, sizeof(tEventuCalInstance));
 
     instance_l.fd = ctrlucal_getFd();
     instance_l.fStopThread = FALSE;
 
+    instance_l.pEventShm = mmap(NULL,
+                                sizeof(tEventShm),
+                                PROT_READ | PROT_WRITE,
+                                MAP_SHARED,
+                                instance_l.fd,
+                                PLK_MMAP_PGOFF_EVENT * sysconf(_SC_PAGE_SIZE));
+    if (instance_l.pEventShm == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s(): mmap of event shared memory failed!\n", __func__);
+        instance_l.pEventShm = NULL;
+        return kErrorNoResource;
+    }
+
     //create thread for signaling new data
     if (pthread_create(&instance_l.threadId, NULL, eventThread, NULL) != 0)
         goto Exit;
 
-    schedParam.sched_priority = USER_EVENT_THREAD_PRIORITY;
-    if (pthread_setschedparam(instance_l.threadId, SCHED_FIFO, &schedParam) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s(): couldn't set thread scheduling parameters! %d\n",
-                              __func__,
-                              schedParam.sched_priority);
-    }
-
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(instance_l.threadId, "oplk-eventu");
-#endif
+    target_registerThread(instance_l.threadId,
+                          kOplkApiThreadEventu,
+                          "oplk-eventu",
+                          USER_EVENT_THREAD_PRIORITY);
 
 Exit:
     return ret;
@@ -180,6 +192,7 @@ tOplkError eventucal_exit(void)
 
     if (instance_l.threadId != 0)
     {
+        target_unregisterThread(instance_l.threadId);
         instance_l.fStopThread = TRUE;
         while (instance_l.fStopThread != FALSE)
         {
@@ -193,6 +206,16 @@ tOplkError eventucal_exit(void)
         }
     }
 
+    if (instance_l.pEventShm != NULL)
+    {
+        if (munmap(instance_l.pEventShm, sizeof(tEventShm)) != 0)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s(): munmap of event shared memory failed!\n", __func__);
+        }
+
+        instance_l.pEventShm = NULL;
+    }
+
     return kErrorOk;
 }
 
@@ -292,11 +315,64 @@ static tOplkError postEvent(const tEvent* pEvent_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief    Read event from the event shared memory
+
+This function reads the next event from the event ring in the shared memory.
+Padding entries at the end of the ring are skipped.
+
+\param[out]     pEvent_p            Buffer which receives the event and its
+                                    argument. It must provide space for
+                                    MAX_EVENT_ARG_SIZE argument bytes.
+
+\return The function returns TRUE if an event was read, otherwise FALSE.
+*/
+//------------------------------------------------------------------------------
+static BOOL readEventShm(tEvent* pEvent_p)
+{
+    tEventShm*              pEventShm = instance_l.pEventShm;
+    const tEventShmEntry*   pEntry;
+    UINT32                  readOffset = pEventShm->readOffset;
+    BOOL                    fEvent = FALSE;
+
+    while (!fEvent && (readOffset != pEventShm->writeOffset))
+    {
+        // The entry must not be read before the write offset
+        __sync_synchronize();
+
+        pEntry = (const tEventShmEntry*)&pEventShm->aRing[readOffset & (PLK_EVENT_SHM_RING_SIZE - 1)];
+        if (pEntry->eventSize != 0)
+        {
+            if (pEntry->eventSize <= (sizeof(tEvent) + MAX_EVENT_ARG_SIZE))
+            {
+                OPLK_MEMCPY(pEvent_p, pEntry + 1, pEntry->eventSize);
+                fEvent = TRUE;
+            }
+            else
+            {
+                DEBUG_LVL_ERROR_TRACE("%s() Event too large (%u)!\n",
+                                      __func__,
+                                      pEntry->eventSize);
+            }
+        }
+
+        readOffset += pEntry->entrySize;
+
+        // The entry must be copied before it is released to the kernel module
+        __sync_synchronize();
+        pEventShm->readOffset = readOffset;
+    }
+
+    return fEvent;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief    Event thread function
 
-This function implements the event thread.
+This function implements the event thread. It processes all events of the
+event ring and waits in the kernel module if the ring is empty.
 
 \param[in,out]  arg_p               Thread argument.
 
@@ -306,7 +382,7 @@ static void* eventThread(void* arg_p)
 {
     tEvent* pEvent;
     int     ret;
-    char    eventBuf[sizeof(tEvent) + MAX_EVENT_ARG_SIZE];
+    UINT64  eventBuf[(sizeof(tEvent) + MAX_EVENT_ARG_SIZE + sizeof(UINT64) - 1) / sizeof(UINT64)];
 
     UNUSED_PARAMETER(arg_p);
 
@@ -314,8 +390,7 @@ static void* eventThread(void* arg_p)
 
     while (!instance_l.fStopThread)
     {
-        ret = ioctl(instance_l.fd, PLK_CMD_GET_EVENT, eventBuf);
-        if (ret == 0)
+        if (readEventShm(pEvent))
         {
             DEBUG_LVL_EVENTU_TRACE("%s() User: got event type:%d(%s) sink:%d(%s)\n",
                                    __func__,
@@ -330,7 +405,13 @@ static void* eventThread(void* arg_p)
         }
         else
         {
-            DEBUG_LVL_EVENTU_TRACE("%s() ret = %d\n", __func__, ret);
+            ret = ioctl(instance_l.fd,
+                        PLK_CMD_WAIT_EVENT,
+                        (ULONG)instance_l.pEventShm->readOffset);
+            if (ret != 0)
+            {
+                DEBUG_LVL_EVENTU_TRACE("%s() ret = %d\n", __func__, ret);
+            }
         }
     }
     instance_l.fStopThread = FALSE;
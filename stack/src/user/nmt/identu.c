@@ -43,6 +43,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/oplkinc.h>
 #include <user/identu.h>
 #include <user/dllucal.h>
+#include <user/respstoreu.h>
 #include <common/ami.h>
 
 //============================================================================//
@@ -75,7 +76,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 typedef struct
 {
-    tIdentResponse*     apIdentResponse[254];    // the IdentResponse are managed dynamically
     tIdentuCbResponse   apfnCbResponse[254];
 } tIdentuInstance;
 
@@ -154,13 +154,8 @@ The function resets an ident module instance
 //------------------------------------------------------------------------------
 tOplkError identu_reset(void)
 {
-    size_t  index;
-
-    for (index = 0; index < tabentries(instance_g.apIdentResponse); index++)
-    {
-        if (instance_g.apIdentResponse[index] != NULL)
-            OPLK_FREE(instance_g.apIdentResponse[index]);
-    }
+    // the IdentResponses are kept in the response store
+    respstoreu_resetIdentResponses();
 
     OPLK_MEMSET(&instance_g, 0, sizeof(tIdentuInstance));
 
@@ -185,30 +180,10 @@ The function gets the IdentResponse for a specified node.
 tOplkError identu_getIdentResponse(UINT nodeId_p,
                                    const tIdentResponse** ppIdentResponse_p)
 {
-    tOplkError      ret = kErrorOk;
-    tIdentResponse* pIdentResponse;
-
     // Check parameter validity
     ASSERT(ppIdentResponse_p != NULL);
 
-    // decrement node ID, because array is zero based
-    nodeId_p--;
-    if (nodeId_p < tabentries(instance_g.apIdentResponse))
-    {
-        pIdentResponse = instance_g.apIdentResponse[nodeId_p];
-        *ppIdentResponse_p = pIdentResponse;
-
-        // Check if ident response is valid, adjust return value otherwise
-        if (pIdentResponse == NULL)
-            ret = kErrorInvalidOperation;
-    }
-    else
-    {   // invalid node ID specified
-        *ppIdentResponse_p = NULL;
-        ret = kErrorInvalidNodeId;
-    }
-
-    return ret;
+    return respstoreu_getIdentResponse(nodeId_p, ppIdentResponse_p);
 }
 
 //------------------------------------------------------------------------------
@@ -278,7 +253,8 @@ tOplkError identu_requestIdentResponse(UINT nodeId_p,
 \brief  Callback function for IdentResponse
 
 The function implements the callback function which will be called when a
-IdentResponse is received.
+IdentResponse is received. Valid IdentResponses are stored in the response
+store.
 
 \param[in]      pFrameInfo_p        Pointer to frame information structure describing
                                     the received IdentResponse frame.
@@ -290,16 +266,23 @@ IdentResponse is received.
 //------------------------------------------------------------------------------
 static tOplkError cbIdentResponse(const tFrameInfo* pFrameInfo_p)
 {
-    tOplkError          ret = kErrorOk;
-    UINT                nodeId;
-    UINT                index;
-    tIdentuCbResponse   pfnCbResponse;
+    tOplkError              ret = kErrorOk;
+    UINT                    nodeId;
+    UINT                    index;
+    tIdentuCbResponse       pfnCbResponse;
+    const tIdentResponse*   pIdentResponse = NULL;
 
     nodeId = ami_getUint8Le(&pFrameInfo_p->frame.pBuffer->srcNodeId);
     index = nodeId - 1;
 
     if (index < tabentries(instance_g.apfnCbResponse))
     {
+        if (pFrameInfo_p->frameSize >= C_DLL_MINSIZE_IDENTRES)
+        {   // IdentResponse received, keep the latest one in the response store
+            pIdentResponse = &pFrameInfo_p->frame.pBuffer->data.asnd.payload.identResponse;
+            respstoreu_storeIdentResponse(nodeId, pIdentResponse, &pIdentResponse);
+        }
+
         // save pointer to callback function
         pfnCbResponse = instance_g.apfnCbResponse[index];
         // reset callback function pointer so that caller may issue next request immediately
@@ -308,29 +291,9 @@ static tOplkError cbIdentResponse(const tFrameInfo* pFrameInfo_p)
         if (pfnCbResponse == NULL)
             goto Exit;
 
-        if (pFrameInfo_p->frameSize < C_DLL_MINSIZE_IDENTRES)
-        {   // IdentResponse not received or it has invalid size
-            ret = pfnCbResponse(nodeId, NULL);
-        }
-        else
-        {   // IdentResponse received
-            if (instance_g.apIdentResponse[index] == NULL)
-            {   // memory for IdentResponse must be allocated
-                instance_g.apIdentResponse[index] = (tIdentResponse*)OPLK_MALLOC(sizeof(tIdentResponse));
-                if (instance_g.apIdentResponse[index] == NULL)
-                {   // malloc failed
-                    ret = pfnCbResponse(nodeId,
-                                        &pFrameInfo_p->frame.pBuffer->data.asnd.payload.identResponse);
-                    goto Exit;
-                }
-            }
-
-            // copy IdentResponse to instance structure
-            OPLK_MEMCPY(instance_g.apIdentResponse[index],
-                        &pFrameInfo_p->frame.pBuffer->data.asnd.payload.identResponse,
-                        sizeof(tIdentResponse));
-            ret = pfnCbResponse(nodeId, instance_g.apIdentResponse[index]);
-        }
+        // pIdentResponse is NULL if the IdentResponse was not received or has
+        // an invalid size
+        ret = pfnCbResponse(nodeId, pIdentResponse);
     }
 
 Exit:
@@ -1566,6 +1566,44 @@ tOplkError nmtmnu_configPrc(const tNmtMnuConfigParam* pConfigParam_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get PRes timing of a node
+
+The function returns whether the node is configured for PRes chaining and the
+PRes response time determined by the PRes chaining measurement. The response
+time is zero as long as the measurement has not been completed for the node.
+
+\param[in]      nodeId_p            Node ID of the CN.
+\param[out]     pfPresChaining_p    Pointer to store whether the node uses PRes
+                                    chaining.
+\param[out]     pPResTimeFirstNs_p  Pointer to store the PRes response time
+                                    in ns.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_nmtmnu
+*/
+//------------------------------------------------------------------------------
+tOplkError nmtmnu_getPResTiming(UINT nodeId_p,
+                                BOOL* pfPresChaining_p,
+                                UINT32* pPResTimeFirstNs_p)
+{
+    const tNmtMnuNodeInfo*  pNodeInfo;
+
+    if ((nodeId_p == C_ADR_INVALID) ||
+        (nodeId_p > NMT_MAX_NODE_ID) ||
+        (pfPresChaining_p == NULL) ||
+        (pPResTimeFirstNs_p == NULL))
+        return kErrorNmtInvalidParam;
+
+    pNodeInfo = NMTMNU_GET_NODEINFO(nodeId_p);
+    *pfPresChaining_p = ((pNodeInfo->nodeCfg & NMT_NODEASSIGN_PRES_CHAINING) != 0);
+    *pPResTimeFirstNs_p = pNodeInfo->pResTimeFirstNs;
+
+    return kErrorOk;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
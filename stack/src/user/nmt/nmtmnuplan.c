@@ -0,0 +1,486 @@
+/**
+********************************************************************************
+\file   nmtmnuplan.c
+
+\brief  Implementation of the isochronous schedule planner of the MN
+
+This file contains the implementation of the isochronous schedule planner of
+the MN. The planner assigns the CNs to continuous or multiplexed slots so that
+the predicted cycle time is minimized.
+
+\ingroup module_nmtmnu
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <user/nmtmnuplan.h>
+#include <user/nmtmnu.h>
+#include <user/obdu.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+#if defined(CONFIG_INCLUDE_NMT_MN)
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define NMTMNUPLAN_MAX_MULTIPLEXED_CYCLES   255     // Range of 0x1F98.7 MultiplCycleCnt_U8
+#define NMTMNUPLAN_ETH_CRC_SIZE             4       // Size of the Ethernet frame check sequence
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Schedule planner instance
+
+The structure holds the published schedule plan.
+*/
+typedef struct
+{
+    BOOL                fValid;                                 ///< A schedule plan has been published
+    tOplkApiSchedPlan   plan;                                   ///< Published schedule plan
+    tOplkApiSchedNode   aNode[NMT_MAX_NODE_ID];                 ///< Nodes of the published schedule plan
+} tNmtMnuPlanInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tNmtMnuPlanInstance  instance_l;
+static UINT8                aNodeOrder_l[NMT_MAX_NODE_ID];                          // Non-PRC nodes sorted by descending slot time
+static UINT32               aCycleLoadNs_l[NMTMNUPLAN_MAX_MULTIPLEXED_CYCLES];      // Load of the multiplexed cycles
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static UINT32 calcFrameTimeNs(UINT frameSize_p);
+static UINT32 calcPdoFrameTimeNs(UINT16 payloadSize_p);
+static UINT32 assignNodes(tOplkApiSchedNode* aNodes_p,
+                          UINT orderCount_p,
+                          UINT multiplexedCycleCount_p,
+                          BOOL fAssign_p,
+                          UINT32* pContinuousTimeNs_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Calculate an isochronous schedule
+
+The function assigns the passed CNs to continuous or multiplexed slots. For
+every possible number of multiplexed cycles the nodes whose update rate allows
+multiplexing are distributed by the longest processing time rule over the
+multiplexed cycles. The number of multiplexed cycles with the smallest
+predicted cycle time is chosen. PRes chaining nodes are always served in every
+cycle after the PResMN.
+
+The resulting schedule is stored in the passed node array and plan structure
+and is published for nmtmnuplan_getSchedule().
+
+\param[in]      pParam_p            Pointer to the planning parameters.
+\param[in,out]  aNodes_p            Array of the nodes to be planned. The output
+                                    members are filled by the function.
+\param[in]      nodeCount_p         Number of nodes in the array.
+\param[out]     pPlan_p             Pointer to store the schedule plan.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_nmtmnu
+*/
+//------------------------------------------------------------------------------
+tOplkError nmtmnuplan_calcSchedule(const tOplkApiSchedPlanParam* pParam_p,
+                                   tOplkApiSchedNode* aNodes_p,
+                                   UINT nodeCount_p,
+                                   tOplkApiSchedPlan* pPlan_p)
+{
+    tOplkApiSchedPlan   plan;
+    tOplkApiSchedNode*  pNode;
+    UINT32              prcMaxTimeNs = 0;
+    UINT32              prcSumTimeNs = 0;
+    UINT32              continuousTimeNs;
+    UINT32              multiplexedTimeNs;
+    UINT32              bestTimeNs;
+    UINT                bestCycleCount;
+    UINT                maxUpdateRate = 1;
+    UINT                orderCount = 0;
+    UINT                multiplexedCycleCount;
+    UINT                i;
+    UINT                j;
+
+    if ((pParam_p == NULL) ||
+        (pPlan_p == NULL) ||
+        ((aNodes_p == NULL) && (nodeCount_p != 0)) ||
+        (nodeCount_p > NMT_MAX_NODE_ID) ||
+        (pParam_p->maxMultiplexedCycles > NMTMNUPLAN_MAX_MULTIPLEXED_CYCLES))
+        return kErrorNmtInvalidParam;
+
+    OPLK_MEMSET(&plan, 0, sizeof(plan));
+    plan.nodeCount = nodeCount_p;
+
+    // calculate the slot times and sort the non-PRC nodes by descending slot time
+    for (i = 0; i < nodeCount_p; i++)
+    {
+        pNode = &aNodes_p[i];
+        if ((pNode->nodeId == C_ADR_INVALID) || (pNode->nodeId > NMT_MAX_NODE_ID))
+            return kErrorNmtInvalidParam;
+
+        pNode->assignedCycle = 0;
+        if (pNode->fPresChaining)
+        {
+            pNode->slotTimeNs = pNode->responseTimeNs + calcPdoFrameTimeNs(pNode->presPayloadSize);
+            prcMaxTimeNs = max(prcMaxTimeNs, pNode->slotTimeNs);
+            prcSumTimeNs += calcPdoFrameTimeNs(pNode->presPayloadSize) + C_DLL_T_IFG;
+            plan.continuousNodeCount++;
+            continue;
+        }
+
+        pNode->slotTimeNs = calcPdoFrameTimeNs(pNode->preqPayloadSize) +
+                            pNode->responseTimeNs +
+                            calcPdoFrameTimeNs(pNode->presPayloadSize) +
+                            C_DLL_T_IFG;
+        maxUpdateRate = max(maxUpdateRate, pNode->updateRate);
+
+        for (j = orderCount; (j > 0) && (aNodes_p[aNodeOrder_l[j - 1]].slotTimeNs < pNode->slotTimeNs); j--)
+            aNodeOrder_l[j] = aNodeOrder_l[j - 1];
+        aNodeOrder_l[j] = (UINT8)i;
+        orderCount++;
+    }
+
+    // find the number of multiplexed cycles with the shortest cycle
+    bestTimeNs = assignNodes(aNodes_p, orderCount, 0, FALSE, &continuousTimeNs) + continuousTimeNs;
+    bestCycleCount = 0;
+    for (multiplexedCycleCount = 2;
+         multiplexedCycleCount <= min(pParam_p->maxMultiplexedCycles, maxUpdateRate);
+         multiplexedCycleCount++)
+    {
+        multiplexedTimeNs = assignNodes(aNodes_p, orderCount, multiplexedCycleCount, FALSE, &continuousTimeNs);
+        if ((continuousTimeNs + multiplexedTimeNs) < bestTimeNs)
+        {
+            bestTimeNs = continuousTimeNs + multiplexedTimeNs;
+            bestCycleCount = multiplexedCycleCount;
+        }
+    }
+
+    plan.multiplexedCycleCount = bestCycleCount;
+    plan.multiplexedTimeNs = assignNodes(aNodes_p, orderCount, bestCycleCount, TRUE, &plan.continuousTimeNs);
+    for (i = 0; i < orderCount; i++)
+    {
+        if (aNodes_p[aNodeOrder_l[i]].assignedCycle == 0)
+            plan.continuousNodeCount++;
+        else
+            plan.multiplexedNodeCount++;
+    }
+
+    // PRes chaining nodes respond one after another to the PResMN
+    if (plan.nodeCount != orderCount)
+    {
+        plan.presChainingTimeNs = calcPdoFrameTimeNs(pParam_p->presMnPayloadSize) +
+                                  max(prcMaxTimeNs, prcSumTimeNs) +
+                                  C_DLL_T_IFG;
+    }
+
+    plan.frameOverheadTimeNs = calcFrameTimeNs(C_DLL_MINSIZE_SOC + NMTMNUPLAN_ETH_CRC_SIZE) + C_DLL_T_IFG +
+                               calcFrameTimeNs(C_DLL_MINSIZE_SOA + NMTMNUPLAN_ETH_CRC_SIZE) + C_DLL_T_IFG;
+    if (pParam_p->asyncMtu != 0)
+        plan.asyncTimeNs = calcFrameTimeNs(pParam_p->asyncMtu + C_DLL_T_ETH2_WRAPPER) + C_DLL_T_IFG;
+
+    plan.cycleTimeNs = plan.frameOverheadTimeNs +
+                       plan.continuousTimeNs +
+                       plan.multiplexedTimeNs +
+                       plan.presChainingTimeNs +
+                       plan.asyncTimeNs;
+
+    // publish the schedule
+    instance_l.plan = plan;
+    if (nodeCount_p != 0)
+        OPLK_MEMCPY(instance_l.aNode, aNodes_p, nodeCount_p * sizeof(tOplkApiSchedNode));
+    instance_l.fValid = TRUE;
+
+    *pPlan_p = plan;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the published isochronous schedule
+
+The function returns the schedule which was calculated by the last call of
+nmtmnuplan_calcSchedule().
+
+\param[out]     pPlan_p             Pointer to store the schedule plan.
+\param[out]     aNodes_p            Array to store the planned nodes. May be NULL
+                                    if only the plan is required.
+\param[in,out]  pNodeCount_p        Pointer to the size of the node array. It
+                                    receives the number of planned nodes. May be
+                                    NULL if aNodes_p is NULL.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The schedule is returned.
+\retval kErrorInvalidOperation      No schedule was calculated yet.
+\retval kErrorNmtInvalidParam       Invalid parameter or the node array is too
+                                    small.
+
+\ingroup module_nmtmnu
+*/
+//------------------------------------------------------------------------------
+tOplkError nmtmnuplan_getSchedule(tOplkApiSchedPlan* pPlan_p,
+                                  tOplkApiSchedNode* aNodes_p,
+                                  UINT* pNodeCount_p)
+{
+    if ((pPlan_p == NULL) ||
+        ((aNodes_p != NULL) && (pNodeCount_p == NULL)))
+        return kErrorNmtInvalidParam;
+
+    if (!instance_l.fValid)
+        return kErrorInvalidOperation;
+
+    if (aNodes_p != NULL)
+    {
+        if (*pNodeCount_p < instance_l.plan.nodeCount)
+            return kErrorNmtInvalidParam;
+
+        if (instance_l.plan.nodeCount != 0)
+        {
+            OPLK_MEMCPY(aNodes_p,
+                        instance_l.aNode,
+                        instance_l.plan.nodeCount * sizeof(tOplkApiSchedNode));
+        }
+    }
+
+    if (pNodeCount_p != NULL)
+        *pNodeCount_p = instance_l.plan.nodeCount;
+
+    *pPlan_p = instance_l.plan;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the timing requirements of a node
+
+The function fills the input members of a schedule planning node structure
+from the object dictionary and the PRes chaining measurement. The response
+time is taken from the PRes timeout (0x1F92), or from the measured PRes
+response time for PRes chaining nodes. The update rate is derived from the
+current multiplexed cycle assignment (0x1F9B and 0x1F98.7). The output members
+are cleared.
+
+\param[in]      nodeId_p            Node ID of the CN.
+\param[out]     pNode_p             Pointer to store the node timing.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_nmtmnu
+*/
+//------------------------------------------------------------------------------
+tOplkError nmtmnuplan_getNodeTiming(UINT nodeId_p,
+                                    tOplkApiSchedNode* pNode_p)
+{
+    tOplkError  ret;
+    tObdSize    obdSize;
+    UINT8       multiplCycleAssign;
+    UINT8       multiplCycleCnt;
+    UINT32      pResTimeFirstNs;
+
+    if (pNode_p == NULL)
+        return kErrorNmtInvalidParam;
+
+    OPLK_MEMSET(pNode_p, 0, sizeof(tOplkApiSchedNode));
+    pNode_p->nodeId = nodeId_p;
+    pNode_p->updateRate = 1;
+
+    ret = nmtmnu_getPResTiming(nodeId_p, &pNode_p->fPresChaining, &pResTimeFirstNs);
+    if (ret != kErrorOk)
+        return ret;
+
+    // read object 0x1F8B NMT_MNPReqPayloadLimitList_AU16
+    obdSize = sizeof(pNode_p->preqPayloadSize);
+    ret = obdu_readEntry(0x1F8B, nodeId_p, &pNode_p->preqPayloadSize, &obdSize);
+    if (ret != kErrorOk)
+        return ret;
+
+    // read object 0x1F8D NMT_PResPayloadLimitList_AU16
+    obdSize = sizeof(pNode_p->presPayloadSize);
+    ret = obdu_readEntry(0x1F8D, nodeId_p, &pNode_p->presPayloadSize, &obdSize);
+    if (ret != kErrorOk)
+        return ret;
+
+    if (pNode_p->fPresChaining && (pResTimeFirstNs != 0))
+        pNode_p->responseTimeNs = pResTimeFirstNs;
+    else
+    {
+        // read object 0x1F92 NMT_MNCNPResTimeout_AU32
+        obdSize = sizeof(pNode_p->responseTimeNs);
+        ret = obdu_readEntry(0x1F92, nodeId_p, &pNode_p->responseTimeNs, &obdSize);
+        if (ret != kErrorOk)
+            return ret;
+    }
+
+    // read object 0x1F9B NMT_MultiplCycleAssign_AU8 and 0x1F98.7 MultiplCycleCnt_U8
+    obdSize = sizeof(multiplCycleAssign);
+    if ((obdu_readEntry(0x1F9B, nodeId_p, &multiplCycleAssign, &obdSize) == kErrorOk) &&
+        (multiplCycleAssign != 0))
+    {
+        obdSize = sizeof(multiplCycleCnt);
+        if ((obdu_readEntry(0x1F98, 7, &multiplCycleCnt, &obdSize) == kErrorOk) &&
+            (multiplCycleCnt != 0))
+            pNode_p->updateRate = multiplCycleCnt;
+    }
+
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Calculate the transmission time of a frame
+
+The function calculates the transmission time of a frame including the
+preamble. Frames are padded to the minimum Ethernet frame size.
+
+\param[in]      frameSize_p         Size of the frame including the Ethernet
+                                    header and checksum.
+
+\return The function returns the transmission time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT32 calcFrameTimeNs(UINT frameSize_p)
+{
+    UINT32  frameTimeNs = 8 * C_DLL_T_BITTIME * frameSize_p;
+
+    return C_DLL_T_PREAMBLE + max(frameTimeNs, C_DLL_T_MIN_FRAME);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Calculate the transmission time of a PReq or PRes frame
+
+\param[in]      payloadSize_p       PDO payload size of the frame.
+
+\return The function returns the transmission time in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT32 calcPdoFrameTimeNs(UINT16 payloadSize_p)
+{
+    return calcFrameTimeNs(payloadSize_p + C_DLL_T_EPL_PDO_HEADER + C_DLL_T_ETH2_WRAPPER);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Assign the nodes to the multiplexed cycles
+
+The function distributes the nodes whose update rate allows the given number
+of multiplexed cycles over the multiplexed cycles. The nodes are processed in
+the order of descending slot time and each node is assigned to the multiplexed
+cycle with the smallest load. All other nodes are served in every cycle.
+
+\param[in,out]  aNodes_p                Array of the nodes.
+\param[in]      orderCount_p            Number of nodes in aNodeOrder_l.
+\param[in]      multiplexedCycleCount_p Number of multiplexed cycles (0 = no
+                                        multiplexing).
+\param[in]      fAssign_p               Store the assigned cycles in the nodes.
+\param[out]     pContinuousTimeNs_p     Pointer to store the time of the
+                                        continuous slots.
+
+\return The function returns the time of the largest multiplexed cycle in ns.
+*/
+//------------------------------------------------------------------------------
+static UINT32 assignNodes(tOplkApiSchedNode* aNodes_p,
+                          UINT orderCount_p,
+                          UINT multiplexedCycleCount_p,
+                          BOOL fAssign_p,
+                          UINT32* pContinuousTimeNs_p)
+{
+    tOplkApiSchedNode*  pNode;
+    UINT32              continuousTimeNs = 0;
+    UINT32              multiplexedTimeNs = 0;
+    UINT                minCycle;
+    UINT                i;
+    UINT                cycle;
+
+    OPLK_MEMSET(aCycleLoadNs_l, 0, multiplexedCycleCount_p * sizeof(aCycleLoadNs_l[0]));
+
+    for (i = 0; i < orderCount_p; i++)
+    {
+        pNode = &aNodes_p[aNodeOrder_l[i]];
+        if ((multiplexedCycleCount_p == 0) || (pNode->updateRate < multiplexedCycleCount_p))
+        {
+            continuousTimeNs += pNode->slotTimeNs;
+            continue;
+        }
+
+        minCycle = 0;
+        for (cycle = 1; cycle < multiplexedCycleCount_p; cycle++)
+        {
+            if (aCycleLoadNs_l[cycle] < aCycleLoadNs_l[minCycle])
+                minCycle = cycle;
+        }
+
+        aCycleLoadNs_l[minCycle] += pNode->slotTimeNs;
+        multiplexedTimeNs = max(multiplexedTimeNs, aCycleLoadNs_l[minCycle]);
+        if (fAssign_p)
+            pNode->assignedCycle = minCycle + 1;
+    }
+
+    *pContinuousTimeNs_p = continuousTimeNs;
+
+    return multiplexedTimeNs;
+}
+
+/// \}
+
+#endif
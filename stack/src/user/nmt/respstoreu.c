@@ -0,0 +1,528 @@
+/**
+********************************************************************************
+\file   respstoreu.c
+
+\brief  Implementation of the response store module
+
+This file contains the implementation of the response store module. It stores
+the latest IdentResponse and StatusResponse of every node in one memory block
+which is allocated at initialization.
+
+\ingroup module_respstoreu
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <user/respstoreu.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define RESPSTOREU_READ_RETRIES     16          // Number of read attempts while a response is written
+
+// The sequence counters are accessed by different threads, therefore a full
+// memory barrier is required. OPLK_MEMBAR() is empty on some targets.
+#if defined(__GNUC__)
+#define RESPSTOREU_BARRIER()        __sync_synchronize()
+#else
+#define RESPSTOREU_BARRIER()        OPLK_MEMBAR()
+#endif
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Stored responses of a node
+
+The structure contains the latest responses of one node. Each response is
+protected by a sequence counter which is odd while the response is written.
+*/
+typedef struct
+{
+    volatile UINT32     identSequence;          ///< Sequence counter of the IdentResponse
+    BOOL                fIdentValid;            ///< The IdentResponse is valid
+    tIdentResponse      identResponse;          ///< Latest IdentResponse
+    volatile UINT32     statusSequence;         ///< Sequence counter of the StatusResponse
+    BOOL                fStatusValid;           ///< The StatusResponse is valid
+    tStatusResponse     statusResponse;         ///< Latest StatusResponse
+} tRespStoreuNode;
+
+/**
+\brief Response store instance
+
+The structure contains the instance variables of the response store module.
+*/
+typedef struct
+{
+    tRespStoreuNode*    paNode;                 ///< Responses of node ID 1 to NMT_MAX_NODE_ID
+} tRespStoreuInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tRespStoreuInstance  instance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tRespStoreuNode* getNode(UINT nodeId_p);
+static void             beginWrite(volatile UINT32* pSequence_p);
+static void             endWrite(volatile UINT32* pSequence_p);
+static tOplkError       readResponse(const volatile UINT32* pSequence_p,
+                                     const BOOL* pfValid_p,
+                                     const void* pResponse_p,
+                                     void* pBuffer_p,
+                                     size_t size_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the response store module
+
+The function allocates the memory for the responses of all nodes in one block.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_respstoreu
+*/
+//------------------------------------------------------------------------------
+tOplkError respstoreu_init(void)
+{
+    size_t  size = NMT_MAX_NODE_ID * sizeof(tRespStoreuNode);
+
+    instance_l.paNode = NULL;
+    if (size == 0)
+        return kErrorOk;
+
+    instance_l.paNode = (tRespStoreuNode*)OPLK_MALLOC(size);
+    if (instance_l.paNode == NULL)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Allocation of the response store failed\n", __func__);
+        return kErrorNoResource;
+    }
+
+    OPLK_MEMSET(instance_l.paNode, 0, size);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down the response store module
+
+The function frees the memory of the stored responses.
+
+\ingroup module_respstoreu
+*/
+//------------------------------------------------------------------------------
+void respstoreu_exit(void)
+{
+    if (instance_l.paNode != NULL)
+    {
+        OPLK_FREE(instance_l.paNode);
+        instance_l.paNode = NULL;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Invalidate all IdentResponses
+
+\ingroup module_respstoreu
+*/
+//------------------------------------------------------------------------------
+void respstoreu_resetIdentResponses(void)
+{
+    tRespStoreuNode*    pNode;
+    UINT                nodeId;
+
+    for (nodeId = 1; nodeId <= NMT_MAX_NODE_ID; nodeId++)
+    {
+        pNode = getNode(nodeId);
+        if (pNode == NULL)
+            break;
+
+        beginWrite(&pNode->identSequence);
+        pNode->fIdentValid = FALSE;
+        endWrite(&pNode->identSequence);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Invalidate all StatusResponses
+
+\ingroup module_respstoreu
+*/
+//------------------------------------------------------------------------------
+void respstoreu_resetStatusResponses(void)
+{
+    tRespStoreuNode*    pNode;
+    UINT                nodeId;
+
+    for (nodeId = 1; nodeId <= NMT_MAX_NODE_ID; nodeId++)
+    {
+        pNode = getNode(nodeId);
+        if (pNode == NULL)
+            break;
+
+        beginWrite(&pNode->statusSequence);
+        pNode->fStatusValid = FALSE;
+        endWrite(&pNode->statusSequence);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store an IdentResponse
+
+The function stores the IdentResponse of a node. It must only be called from
+the context which processes the received responses.
+
+\param[in]      nodeId_p            Node ID of the node.
+\param[in]      pIdentResponse_p    Pointer to the received IdentResponse.
+\param[out]     ppStoredResponse_p  Pointer to store the address of the stored
+                                    IdentResponse. May be NULL.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The IdentResponse was stored.
+\retval kErrorInvalidNodeId         The node ID is outside of the store.
+
+\ingroup module_respstoreu
+*/
+//------------------------------------------------------------------------------
+tOplkError respstoreu_storeIdentResponse(UINT nodeId_p,
+                                         const tIdentResponse* pIdentResponse_p,
+                                         const tIdentResponse** ppStoredResponse_p)
+{
+    tRespStoreuNode*    pNode;
+
+    ASSERT(pIdentResponse_p != NULL);
+
+    pNode = getNode(nodeId_p);
+    if (pNode == NULL)
+        return kErrorInvalidNodeId;
+
+    beginWrite(&pNode->identSequence);
+    OPLK_MEMCPY(&pNode->identResponse, pIdentResponse_p, sizeof(tIdentResponse));
+    pNode->fIdentValid = TRUE;
+    endWrite(&pNode->identSequence);
+
+    if (ppStoredResponse_p != NULL)
+        *ppStoredResponse_p = &pNode->identResponse;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store a StatusResponse
+
+The function stores the StatusResponse of a node. The part of the error
+history which was not received is cleared. The function must only be called
+from the context which processes the received responses.
+
+\param[in]      nodeId_p            Node ID of the node.
+\param[in]      pStatusResponse_p   Pointer to the received StatusResponse.
+\param[in]      size_p              Received size of the StatusResponse.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The StatusResponse was stored.
+\retval kErrorInvalidNodeId         The node ID is outside of the store.
+
+\ingroup module_respstoreu
+*/
+//------------------------------------------------------------------------------
+tOplkError respstoreu_storeStatusResponse(UINT nodeId_p,
+                                          const tStatusResponse* pStatusResponse_p,
+                                          size_t size_p)
+{
+    tRespStoreuNode*    pNode;
+
+    ASSERT(pStatusResponse_p != NULL);
+
+    pNode = getNode(nodeId_p);
+    if (pNode == NULL)
+        return kErrorInvalidNodeId;
+
+    size_p = min(size_p, sizeof(tStatusResponse));
+
+    beginWrite(&pNode->statusSequence);
+    OPLK_MEMCPY(&pNode->statusResponse, pStatusResponse_p, size_p);
+    OPLK_MEMSET((UINT8*)&pNode->statusResponse + size_p, 0, sizeof(tStatusResponse) - size_p);
+    pNode->fStatusValid = TRUE;
+    endWrite(&pNode->statusSequence);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the stored IdentResponse
+
+The function returns the address of the stored IdentResponse of a node. The
+IdentResponse may be overwritten when a new response is received, therefore
+the function must only be used in the context which processes the received
+responses. Other contexts shall use respstoreu_readIdentResponse().
+
+\param[in]      nodeId_p            Node ID of the node.
+\param[out]     ppIdentResponse_p   Pointer to store the address of the
+                                    IdentResponse. NULL, if no IdentResponse is
+                                    available.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The IdentResponse is available.
+\retval kErrorInvalidOperation      No IdentResponse was received.
+\retval kErrorInvalidNodeId         The node ID is outside of the store.
+
+\ingroup module_respstoreu
+*/
+//------------------------------------------------------------------------------
+tOplkError respstoreu_getIdentResponse(UINT nodeId_p,
+                                       const tIdentResponse** ppIdentResponse_p)
+{
+    const tRespStoreuNode*  pNode;
+
+    ASSERT(ppIdentResponse_p != NULL);
+
+    *ppIdentResponse_p = NULL;
+
+    pNode = getNode(nodeId_p);
+    if (pNode == NULL)
+        return kErrorInvalidNodeId;
+
+    if (!pNode->fIdentValid)
+        return kErrorInvalidOperation;
+
+    *ppIdentResponse_p = &pNode->identResponse;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read a consistent copy of the stored IdentResponse
+
+The function copies the stored IdentResponse of a node without locking. It
+can be called from any context.
+
+\param[in]      nodeId_p            Node ID of the node.
+\param[out]     pIdentResponse_p    Pointer to store the IdentResponse.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The IdentResponse was copied.
+\retval kErrorInvalidOperation      No IdentResponse was received.
+\retval kErrorInvalidNodeId         The node ID is outside of the store.
+\retval kErrorRetry                 The IdentResponse is currently updated.
+
+\ingroup module_respstoreu
+*/
+//------------------------------------------------------------------------------
+tOplkError respstoreu_readIdentResponse(UINT nodeId_p,
+                                        tIdentResponse* pIdentResponse_p)
+{
+    const tRespStoreuNode*  pNode;
+
+    ASSERT(pIdentResponse_p != NULL);
+
+    pNode = getNode(nodeId_p);
+    if (pNode == NULL)
+        return kErrorInvalidNodeId;
+
+    return readResponse(&pNode->identSequence,
+                        &pNode->fIdentValid,
+                        &pNode->identResponse,
+                        pIdentResponse_p,
+                        sizeof(tIdentResponse));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read a consistent copy of the stored StatusResponse
+
+The function copies the stored StatusResponse of a node without locking. It
+can be called from any context.
+
+\param[in]      nodeId_p            Node ID of the node.
+\param[out]     pStatusResponse_p   Pointer to store the StatusResponse.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The StatusResponse was copied.
+\retval kErrorInvalidOperation      No StatusResponse was received.
+\retval kErrorInvalidNodeId         The node ID is outside of the store.
+\retval kErrorRetry                 The StatusResponse is currently updated.
+
+\ingroup module_respstoreu
+*/
+//------------------------------------------------------------------------------
+tOplkError respstoreu_readStatusResponse(UINT nodeId_p,
+                                         tStatusResponse* pStatusResponse_p)
+{
+    const tRespStoreuNode*  pNode;
+
+    ASSERT(pStatusResponse_p != NULL);
+
+    pNode = getNode(nodeId_p);
+    if (pNode == NULL)
+        return kErrorInvalidNodeId;
+
+    return readResponse(&pNode->statusSequence,
+                        &pNode->fStatusValid,
+                        &pNode->statusResponse,
+                        pStatusResponse_p,
+                        sizeof(tStatusResponse));
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the stored responses of a node
+
+\param[in]      nodeId_p            Node ID of the node.
+
+\return The function returns a pointer to the stored responses or NULL if the
+        node ID is outside of the store.
+*/
+//------------------------------------------------------------------------------
+static tRespStoreuNode* getNode(UINT nodeId_p)
+{
+    if ((instance_l.paNode == NULL) ||
+        (nodeId_p == C_ADR_INVALID) ||
+        (nodeId_p > NMT_MAX_NODE_ID))
+        return NULL;
+
+    return &instance_l.paNode[nodeId_p - 1];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start writing a response
+
+\param[in,out]  pSequence_p         Pointer to the sequence counter of the
+                                    response.
+*/
+//------------------------------------------------------------------------------
+static void beginWrite(volatile UINT32* pSequence_p)
+{
+    (*pSequence_p)++;
+    RESPSTOREU_BARRIER();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Finish writing a response
+
+\param[in,out]  pSequence_p         Pointer to the sequence counter of the
+                                    response.
+*/
+//------------------------------------------------------------------------------
+static void endWrite(volatile UINT32* pSequence_p)
+{
+    RESPSTOREU_BARRIER();
+    (*pSequence_p)++;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read a consistent copy of a response
+
+The function copies a response and repeats the copy if the response was
+written at the same time.
+
+\param[in]      pSequence_p         Pointer to the sequence counter of the
+                                    response.
+\param[in]      pfValid_p           Pointer to the valid flag of the response.
+\param[in]      pResponse_p         Pointer to the stored response.
+\param[out]     pBuffer_p           Pointer to store the copy.
+\param[in]      size_p              Size of the response.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError readResponse(const volatile UINT32* pSequence_p,
+                               const BOOL* pfValid_p,
+                               const void* pResponse_p,
+                               void* pBuffer_p,
+                               size_t size_p)
+{
+    UINT32  sequence;
+    BOOL    fValid;
+    UINT    retry;
+
+    for (retry = 0; retry < RESPSTOREU_READ_RETRIES; retry++)
+    {
+        sequence = *pSequence_p;
+        if ((sequence & 1) != 0)
+            continue;
+
+        RESPSTOREU_BARRIER();
+        fValid = *pfValid_p;
+        if (fValid)
+            OPLK_MEMCPY(pBuffer_p, pResponse_p, size_p);
+        RESPSTOREU_BARRIER();
+
+        if (*pSequence_p == sequence)
+            return fValid ? kErrorOk : kErrorInvalidOperation;
+    }
+
+    return kErrorRetry;
+}
+
+/// \}
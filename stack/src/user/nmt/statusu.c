@@ -40,9 +40,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // includes
 //------------------------------------------------------------------------------
+#include <stddef.h>
+
 #include <common/oplkinc.h>
 #include <user/statusu.h>
 #include <user/dllucal.h>
+#include <user/respstoreu.h>
 #include <common/ami.h>
 
 //============================================================================//
@@ -151,6 +154,9 @@ The function resets a status module instance
 //------------------------------------------------------------------------------
 tOplkError statusu_reset(void)
 {
+    // the StatusResponses are kept in the response store
+    respstoreu_resetStatusResponses();
+
     // reset instance structure
     OPLK_MEMSET(&instance_g, 0, sizeof(instance_g));
 
@@ -226,7 +232,8 @@ tOplkError statusu_requestStatusResponse(UINT nodeId_p,
 \brief  Callback function for StatusResponse
 
 The function implements the callback function which will be called when a
-StatusResponse is received.
+StatusResponse is received. Valid StatusResponses are stored in the response
+store.
 
 \param[in]      pFrameInfo_p        Pointer to frame information structure describing
                                     the received StatusResponse frame.
@@ -238,33 +245,39 @@ StatusResponse is received.
 //------------------------------------------------------------------------------
 static tOplkError cbStatusResponse(const tFrameInfo* pFrameInfo_p)
 {
-    tOplkError          ret = kErrorOk;
-    UINT                nodeId;
-    UINT                index;
-    tStatusuCbResponse  pfnCbResponse;
+    tOplkError              ret = kErrorOk;
+    UINT                    nodeId;
+    UINT                    index;
+    tStatusuCbResponse      pfnCbResponse;
+    const tStatusResponse*  pStatusResponse = NULL;
 
     nodeId = ami_getUint8Le(&pFrameInfo_p->frame.pBuffer->srcNodeId);
     index = nodeId - 1;
 
     if (index < tabentries(instance_g.apfnCbResponse))
     {
+        if (pFrameInfo_p->frameSize >= C_DLL_MINSIZE_STATUSRES)
+        {   // StatusResponse received, keep the latest one in the response store
+            pStatusResponse = &pFrameInfo_p->frame.pBuffer->data.asnd.payload.statusResponse;
+            respstoreu_storeStatusResponse(nodeId,
+                                           pStatusResponse,
+                                           pFrameInfo_p->frameSize -
+                                               offsetof(tPlkFrame, data.asnd.payload.statusResponse));
+        }
+
         // memorize pointer to callback function
         pfnCbResponse = instance_g.apfnCbResponse[index];
         if (pfnCbResponse == NULL)
         {   // response was not requested
             goto Exit;
         }
+
         // reset callback function pointer so that a caller may issue next request
         instance_g.apfnCbResponse[index] = NULL;
 
-        if (pFrameInfo_p->frameSize < C_DLL_MINSIZE_STATUSRES)
-        {   // StatusResponse not received or it has invalid size
-            ret = pfnCbResponse(nodeId, NULL);
-        }
-        else
-        {   // StatusResponse received
-            ret = pfnCbResponse(nodeId, &pFrameInfo_p->frame.pBuffer->data.asnd.payload.statusResponse);
-        }
+        // pStatusResponse is NULL if the StatusResponse was not received or
+        // has an invalid size
+        ret = pfnCbResponse(nodeId, pStatusResponse);
     }
 
 Exit:
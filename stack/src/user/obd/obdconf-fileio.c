@@ -51,6 +51,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #if (TARGET_SYSTEM == _LINUX_)
 
 #include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #endif
 
@@ -94,6 +98,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define OBD_ARCHIVE_FILENAME_EXTENSION      ".bin"
 #endif
 
+#define OBD_ARCHIVE_HEADER_SIZE             (2 * sizeof(UINT32))    // Target and OD signature
+#define OBD_ARCHIVE_CRC_SIZE                sizeof(UINT16)          // OD data CRC
+#define OBD_ARCHIVE_READ_BUFFER_SIZE        256                     // Buffer size for the CRC check
+
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
@@ -104,6 +112,16 @@ typedef struct
     BOOL        fOpenForWrite;          ///< Flag to indicate whether the archive is opened for a write operation
     UINT16      odDataCrc;              ///< 2 Byte CRC for the last opened archive
     tObdType    curOdPart;              ///< Currently opened OD part archive
+#if (TARGET_SYSTEM == _LINUX_)
+    int         archiveFd;              ///< File descriptor of the mapped OD part archive
+    UINT8*      pArchive;               ///< Mapped OD part archive which is updated in place
+    size_t      archiveSize;            ///< Size of the mapped OD part archive
+    size_t      writeOffset;            ///< Archive offset of the next stored object
+    size_t      changedStart;           ///< Start offset of the changed archive range
+    size_t      changedEnd;             ///< End offset of the changed archive range
+    BOOL        fArchiveModified;       ///< Flag to indicate whether the mapped archive was modified
+    UINT32      odPartSignature;        ///< OD signature of the stored part
+#endif
 } tObdConfInstance;
 
 //------------------------------------------------------------------------------
@@ -118,6 +136,16 @@ static tObdConfInstance aObdConfInstance_l[1];
 static tOplkError getOdPartArchivePath(tObdPart odPart_p,
                                        const char* pBkupPath_p,
                                        char* pFilePathName_p);
+static BOOL       isArchiveOpen(const tObdConfInstance* pInstEntry_p);
+#if (TARGET_SYSTEM == _LINUX_)
+static tOplkError openMappedArchive(const char* pFilePath_p,
+                                    UINT32 odPartSignature_p);
+static tOplkError storeMappedData(const void* pData_p, size_t size_p);
+static tOplkError closeMappedArchive(void);
+static tOplkError resizeMappedArchive(size_t size_p);
+static tOplkError markArchiveModified(void);
+static void       unmapArchive(void);
+#endif
 
 /***************************************************************************/
 /*          C L A S S  <Store/Load>                                        */
@@ -163,6 +191,12 @@ static tOplkError getOdPartArchivePath(tObdPart odPart_p,
           +----------------------+
   0xNNNN  | OD data CRC          | (2 Bytes)
           +----------------------+
+
+  On Linux an existing archive with matching signatures is mapped into memory
+  and only the changed object data is written back. Before the first change the
+  OD signature is marked invalid. It is restored after the data and the CRC are
+  synchronized to the file, so an interrupted store leaves an obsolete archive
+  instead of a mixed one.
 */
 
 //============================================================================//
@@ -190,6 +224,9 @@ tOplkError obdconf_init(void)
     OPLK_MEMSET(pInstEntry, 0, sizeof(tObdConfInstance));
     pInstEntry->pFdBkupArchiveFile = NULL;
     pInstEntry->curOdPart = kObdPartNo;
+#if (TARGET_SYSTEM == _LINUX_)
+    pInstEntry->archiveFd = -1;
+#endif
 
     return ret;
 }
@@ -210,6 +247,10 @@ tOplkError obdconf_exit(void)
     tOplkError        ret = kErrorOk;
     tObdConfInstance* pInstEntry = &aObdConfInstance_l[0];
 
+#if (TARGET_SYSTEM == _LINUX_)
+    unmapArchive();
+#endif
+
     OPLK_MEMSET(pInstEntry, 0, sizeof(tObdConfInstance));
     obdConfSignature_l = (UINT32)~0U;
 
@@ -243,7 +284,7 @@ tOplkError obdconf_createPart(tObdPart odPart_p, UINT32 odPartSignature_p)
         goto Exit;
 
     // Is the file already opened?
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
+    if (isArchiveOpen(pInstEntry))
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
@@ -252,6 +293,25 @@ tOplkError obdconf_createPart(tObdPart odPart_p, UINT32 odPartSignature_p)
     // Open file for writing
     pInstEntry->fOpenForWrite = TRUE;
     pInstEntry->curOdPart = odPart_p;
+
+    // Calculate the CRC for the target signature and the OD signature
+    pInstEntry->odDataCrc = obdconf_calculateCrc16(0,
+                                                   &obdConfSignature_l,
+                                                   sizeof(obdConfSignature_l));
+    pInstEntry->odDataCrc = obdconf_calculateCrc16(pInstEntry->odDataCrc,
+                                                   &odPartSignature_p,
+                                                   sizeof(odPartSignature_p));
+
+#if (TARGET_SYSTEM == _LINUX_)
+    // Update an existing archive of the same OD layout in place
+    if (openMappedArchive(aFilePath, odPartSignature_p) == kErrorOk)
+    {
+        ret = kErrorOk;
+        goto Exit;
+    }
+#endif
+
+    // Rewrite the complete archive
     pInstEntry->pFdBkupArchiveFile = fopen(aFilePath, "wb");
     if (pInstEntry->pFdBkupArchiveFile == NULL)
     {
@@ -260,10 +320,7 @@ tOplkError obdconf_createPart(tObdPart odPart_p, UINT32 odPartSignature_p)
         goto Exit;
     }
 
-    // Write target signature and calculate CRC for it
-    pInstEntry->odDataCrc = obdconf_calculateCrc16(0,
-                                                   &obdConfSignature_l,
-                                                   sizeof(obdConfSignature_l));
+    // Write target signature
     fwrite(&obdConfSignature_l,
            sizeof(obdConfSignature_l),
            1,
@@ -274,10 +331,7 @@ tOplkError obdconf_createPart(tObdPart odPart_p, UINT32 odPartSignature_p)
         goto Exit;
     }
 
-    // Write OD signature and calculate CRC for it
-    pInstEntry->odDataCrc = obdconf_calculateCrc16(pInstEntry->odDataCrc,
-                                                   &odPartSignature_p,
-                                                   sizeof(odPartSignature_p));
+    // Write OD signature
     fwrite(&odPartSignature_p,
            sizeof(odPartSignature_p),
            1,
@@ -320,7 +374,7 @@ tOplkError obdconf_deletePart(tObdPart odPart_p)
         goto Exit;
 
     // Use the local file handle to avoid race condition
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
+    if (isArchiveOpen(pInstEntry))
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
@@ -386,7 +440,7 @@ tOplkError obdconf_openReadPart(tObdPart odPart_p)
         goto Exit;
 
     // Is the file already opened?
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
+    if (isArchiveOpen(pInstEntry))
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
@@ -445,12 +499,21 @@ tOplkError obdconf_closePart(tObdPart odPart_p)
     }
 
     // Is the file not opened?
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
+    if (!isArchiveOpen(pInstEntry))
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
     }
 
+#if (TARGET_SYSTEM == _LINUX_)
+    if (pInstEntry->pArchive != NULL)
+    {
+        ret = closeMappedArchive();
+        pInstEntry->curOdPart = kObdPartNo;
+        goto Exit;
+    }
+#endif
+
     // If file was opened for write we have to add the OD data CRC at the end of the file
     if (pInstEntry->fOpenForWrite != FALSE)
     {
@@ -511,14 +574,24 @@ tOplkError obdconf_storePart(tObdPart odPart_p, const void* pData_p, size_t size
     }
 
     // Is the file not opened?
-    if (pInstEntry->pFdBkupArchiveFile == NULL)
+    if (!isArchiveOpen(pInstEntry))
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
     }
 
-    // Write current OD data to the file and calculate the CRC for it
+    // Calculate the CRC for the current OD data
     pInstEntry->odDataCrc = obdconf_calculateCrc16(pInstEntry->odDataCrc, pData_p, size_p);
+
+#if (TARGET_SYSTEM == _LINUX_)
+    if (pInstEntry->pArchive != NULL)
+    {
+        ret = storeMappedData(pData_p, size_p);
+        goto Exit;
+    }
+#endif
+
+    // Write current OD data to the file
     fwrite(pData_p, size_p, 1, pInstEntry->pFdBkupArchiveFile);
     if (ferror(pInstEntry->pFdBkupArchiveFile))
     {
@@ -692,7 +765,7 @@ tOplkError obdconf_getPartArchiveState(tObdPart odPart_p, UINT32 odPartSignature
     tOplkError          ret = kErrorOk;
     UINT32              readTargetSign;
     UINT32              readOdSign;
-    UINT8               aTempBuffer[8];
+    UINT8               aTempBuffer[OBD_ARCHIVE_READ_BUFFER_SIZE];
     size_t              count;
     UINT16              dataCrc;
     tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
@@ -704,7 +777,7 @@ tOplkError obdconf_getPartArchiveState(tObdPart odPart_p, UINT32 odPartSignature
         goto Exit;
 
     // Use the local file handle to avoid race conditions
-    if (pInstEntry->pFdBkupArchiveFile != NULL)
+    if (isArchiveOpen(pInstEntry))
     {
         ret = kErrorObdStoreInvalidState;
         goto Exit;
@@ -878,6 +951,306 @@ Exit:
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Check if an OD part archive is open
+
+\param[in]      pInstEntry_p        Pointer to the instance entry.
+
+\return The function returns TRUE if an archive is open, otherwise FALSE.
+*/
+//------------------------------------------------------------------------------
+static BOOL isArchiveOpen(const tObdConfInstance* pInstEntry_p)
+{
+#if (TARGET_SYSTEM == _LINUX_)
+    if (pInstEntry_p->pArchive != NULL)
+        return TRUE;
+#endif
+
+    return (pInstEntry_p->pFdBkupArchiveFile != NULL);
+}
+
+#if (TARGET_SYSTEM == _LINUX_)
+//------------------------------------------------------------------------------
+/**
+\brief  Open an existing OD part archive for an in-place store
+
+The function maps an existing OD part archive into memory if its target and OD
+signature match.
+
+\param[in]      pFilePath_p         Path of the OD part archive.
+\param[in]      odPartSignature_p   Signature for the OD part.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The archive is mapped.
+\retval kErrorObdStoreHwError       The archive must be rewritten completely.
+*/
+//------------------------------------------------------------------------------
+static tOplkError openMappedArchive(const char* pFilePath_p,
+                                    UINT32 odPartSignature_p)
+{
+    tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
+    struct stat         fileStat;
+    void*               pArchive;
+    UINT32              signature;
+
+    pInstEntry->archiveFd = open(pFilePath_p, O_RDWR);
+    if (pInstEntry->archiveFd < 0)
+        return kErrorObdStoreHwError;
+
+    if ((fstat(pInstEntry->archiveFd, &fileStat) < 0) ||
+        ((size_t)fileStat.st_size < (OBD_ARCHIVE_HEADER_SIZE + OBD_ARCHIVE_CRC_SIZE)))
+        goto Exit;
+
+    pArchive = mmap(NULL, (size_t)fileStat.st_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED, pInstEntry->archiveFd, 0);
+    if (pArchive == MAP_FAILED)
+        goto Exit;
+
+    pInstEntry->pArchive = (UINT8*)pArchive;
+    pInstEntry->archiveSize = (size_t)fileStat.st_size;
+
+    // Only an archive of the same target and OD layout is updated in place
+    OPLK_MEMCPY(&signature, pInstEntry->pArchive, sizeof(signature));
+    if (signature != obdConfSignature_l)
+        goto Exit;
+
+    OPLK_MEMCPY(&signature, pInstEntry->pArchive + sizeof(obdConfSignature_l), sizeof(signature));
+    if (signature != odPartSignature_p)
+        goto Exit;
+
+    pInstEntry->odPartSignature = odPartSignature_p;
+    pInstEntry->writeOffset = OBD_ARCHIVE_HEADER_SIZE;
+    pInstEntry->changedStart = pInstEntry->archiveSize;
+    pInstEntry->changedEnd = 0;
+    pInstEntry->fArchiveModified = FALSE;
+
+    return kErrorOk;
+
+Exit:
+    unmapArchive();
+    return kErrorObdStoreHwError;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Store object data into the mapped OD part archive
+
+The function compares the object data with the archive content and only
+modifies the archive if the data has changed. The archive is enlarged if the
+data and the CRC don't fit.
+
+\param[in]      pData_p             Pointer to the object data.
+\param[in]      size_p              Size of the object data, in bytes.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError storeMappedData(const void* pData_p, size_t size_p)
+{
+    tOplkError          ret;
+    tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
+    UINT8*              pDst;
+
+    if ((pInstEntry->writeOffset + size_p + OBD_ARCHIVE_CRC_SIZE) > pInstEntry->archiveSize)
+    {
+        ret = resizeMappedArchive(pInstEntry->writeOffset + size_p + OBD_ARCHIVE_CRC_SIZE);
+        if (ret != kErrorOk)
+            return ret;
+    }
+
+    pDst = pInstEntry->pArchive + pInstEntry->writeOffset;
+    if (OPLK_MEMCMP(pDst, pData_p, size_p) != 0)
+    {
+        ret = markArchiveModified();
+        if (ret != kErrorOk)
+            return ret;
+
+        OPLK_MEMCPY(pDst, pData_p, size_p);
+        pInstEntry->changedStart = min(pInstEntry->changedStart, pInstEntry->writeOffset);
+        pInstEntry->changedEnd = max(pInstEntry->changedEnd, pInstEntry->writeOffset + size_p);
+    }
+
+    pInstEntry->writeOffset += size_p;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Close the mapped OD part archive
+
+The function writes the OD data CRC behind the stored data. If the archive was
+modified, the changed range is synchronized to the file, the archive is
+truncated to the stored data and finally marked valid by restoring its OD
+signature. An unmodified archive is not written at all.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError closeMappedArchive(void)
+{
+    tOplkError          ret = kErrorOk;
+    tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
+    UINT8               aCrc[OBD_ARCHIVE_CRC_SIZE];
+    size_t              dataSize;
+    size_t              syncStart;
+
+    // Write CRC16 behind the OD data (in big endian format), the space is
+    // reserved by storeMappedData()
+    aCrc[0] = (UINT8)((pInstEntry->odDataCrc >> 8) & 0xFF);
+    aCrc[1] = (UINT8)((pInstEntry->odDataCrc >> 0) & 0xFF);
+    if (OPLK_MEMCMP(pInstEntry->pArchive + pInstEntry->writeOffset, aCrc, sizeof(aCrc)) != 0)
+    {
+        ret = markArchiveModified();
+        if (ret != kErrorOk)
+            goto Exit;
+
+        OPLK_MEMCPY(pInstEntry->pArchive + pInstEntry->writeOffset, aCrc, sizeof(aCrc));
+        pInstEntry->changedStart = min(pInstEntry->changedStart, pInstEntry->writeOffset);
+        pInstEntry->changedEnd = pInstEntry->writeOffset + sizeof(aCrc);
+    }
+
+    dataSize = pInstEntry->writeOffset + sizeof(aCrc);
+
+    // Remove the data of a previously larger OD part
+    if (pInstEntry->archiveSize > dataSize)
+    {
+        ret = markArchiveModified();
+        if (ret != kErrorOk)
+            goto Exit;
+
+        if ((ftruncate(pInstEntry->archiveFd, (off_t)dataSize) < 0) ||
+            (fsync(pInstEntry->archiveFd) < 0))
+        {
+            ret = kErrorObdStoreHwError;
+            goto Exit;
+        }
+    }
+
+    if (!pInstEntry->fArchiveModified)
+        goto Exit;
+
+    // Synchronize the changed pages
+    if (pInstEntry->changedEnd > pInstEntry->changedStart)
+    {
+        syncStart = pInstEntry->changedStart & ~((size_t)sysconf(_SC_PAGESIZE) - 1);
+        if (msync(pInstEntry->pArchive + syncStart,
+                  pInstEntry->changedEnd - syncStart,
+                  MS_SYNC) < 0)
+        {
+            ret = kErrorObdStoreHwError;
+            goto Exit;
+        }
+    }
+
+    // Mark the archive valid
+    OPLK_MEMCPY(pInstEntry->pArchive + sizeof(obdConfSignature_l),
+                &pInstEntry->odPartSignature,
+                sizeof(pInstEntry->odPartSignature));
+    if (msync(pInstEntry->pArchive, OBD_ARCHIVE_HEADER_SIZE, MS_SYNC) < 0)
+        ret = kErrorObdStoreHwError;
+
+Exit:
+    unmapArchive();
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Resize the mapped OD part archive
+
+\param[in]      size_p              New size of the archive, in bytes.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError resizeMappedArchive(size_t size_p)
+{
+    tOplkError          ret;
+    tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
+    void*               pArchive;
+
+    ret = markArchiveModified();
+    if (ret != kErrorOk)
+        return ret;
+
+    munmap(pInstEntry->pArchive, pInstEntry->archiveSize);
+    pInstEntry->pArchive = NULL;
+
+    if (ftruncate(pInstEntry->archiveFd, (off_t)size_p) < 0)
+        goto Exit;
+
+    pArchive = mmap(NULL, size_p, PROT_READ | PROT_WRITE,
+                    MAP_SHARED, pInstEntry->archiveFd, 0);
+    if (pArchive == MAP_FAILED)
+        goto Exit;
+
+    pInstEntry->pArchive = (UINT8*)pArchive;
+    pInstEntry->archiveSize = size_p;
+
+    return kErrorOk;
+
+Exit:
+    // The archive stays marked invalid
+    unmapArchive();
+    return kErrorObdStoreHwError;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Mark the mapped OD part archive as modified
+
+The function marks the archive invalid before its first modification by
+overwriting the OD signature and synchronizing it to the file.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError markArchiveModified(void)
+{
+    tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
+    UINT32              signature = (UINT32)~0U;
+
+    if (pInstEntry->fArchiveModified)
+        return kErrorOk;
+
+    OPLK_MEMCPY(pInstEntry->pArchive + sizeof(obdConfSignature_l), &signature, sizeof(signature));
+    if (msync(pInstEntry->pArchive, OBD_ARCHIVE_HEADER_SIZE, MS_SYNC) < 0)
+        return kErrorObdStoreHwError;
+
+    pInstEntry->fArchiveModified = TRUE;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Unmap the OD part archive
+
+The function unmaps the OD part archive and closes its file descriptor.
+*/
+//------------------------------------------------------------------------------
+static void unmapArchive(void)
+{
+    tObdConfInstance*   pInstEntry = &aObdConfInstance_l[0];
+
+    if (pInstEntry->pArchive != NULL)
+    {
+        munmap(pInstEntry->pArchive, pInstEntry->archiveSize);
+        pInstEntry->pArchive = NULL;
+    }
+
+    if (pInstEntry->archiveFd >= 0)
+    {
+        close(pInstEntry->archiveFd);
+        pInstEntry->archiveFd = -1;
+    }
+
+    pInstEntry->archiveSize = 0;
+}
+#endif // (TARGET_SYSTEM == _LINUX_)
+
 /// \}
 
 #endif // if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
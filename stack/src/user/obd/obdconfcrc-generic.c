@@ -84,6 +84,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define OBDCONF_CRC_SLICE_COUNT     8       // Number of bytes processed per step
 
 //------------------------------------------------------------------------------
 // local types
@@ -92,6 +93,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
+static UINT16 aaCrc16SliceTable_l[OBDCONF_CRC_SLICE_COUNT - 1][256];
+static BOOL   fCrc16SliceTableValid_l = FALSE;
+
 static const UINT16 aCrc16Table_l[256] =
 {
     0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
@@ -131,6 +135,7 @@ static const UINT16 aCrc16Table_l[256] =
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static void initSliceTables(void);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -143,6 +148,9 @@ static const UINT16 aCrc16Table_l[256] =
 The function calculates CRC16 for the data in the passed buffer.
 This CRC16 version is used in CANopen for SDO CRC calculation.
 
+The data is processed in blocks of eight bytes with the slicing-by-8 method.
+The remaining bytes are processed byte-wise.
+
 \param[in]      crc_p               Initialized value of CRC.
 \param[in]      pData_p             Pointer to the data buffer.
 \param[in]      size_p              Size of data in the buffer, in bytes.
@@ -159,6 +167,28 @@ UINT16 obdconf_calculateCrc16(UINT16 crc_p,
     UINT            idx;
     const UINT8*    pData = (const UINT8*)pData_p;
 
+    if (size_p >= OBDCONF_CRC_SLICE_COUNT)
+    {
+        if (!fCrc16SliceTableValid_l)
+            initSliceTables();
+
+        while (size_p >= OBDCONF_CRC_SLICE_COUNT)
+        {
+            crc_p ^= (UINT16)((pData[0] << 8) | pData[1]);
+            crc_p = aaCrc16SliceTable_l[6][crc_p >> 8] ^
+                    aaCrc16SliceTable_l[5][crc_p & 0xFF] ^
+                    aaCrc16SliceTable_l[4][pData[2]] ^
+                    aaCrc16SliceTable_l[3][pData[3]] ^
+                    aaCrc16SliceTable_l[2][pData[4]] ^
+                    aaCrc16SliceTable_l[1][pData[5]] ^
+                    aaCrc16SliceTable_l[0][pData[6]] ^
+                    aCrc16Table_l[pData[7]];
+
+            pData += OBDCONF_CRC_SLICE_COUNT;
+            size_p -= OBDCONF_CRC_SLICE_COUNT;
+        }
+    }
+
     while (size_p--)
     {
         idx = ((crc_p >> 8) ^ *pData) & 0xFF;
@@ -169,4 +199,39 @@ UINT16 obdconf_calculateCrc16(UINT16 crc_p,
     return crc_p;
 }
 
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize the slicing tables
+
+The function derives the slicing tables from the byte-wise CRC table. Entry i
+of table n holds the CRC of byte i followed by n + 1 zero bytes.
+*/
+//------------------------------------------------------------------------------
+static void initSliceTables(void)
+{
+    UINT    i;
+    UINT    n;
+    UINT16  crc;
+
+    for (i = 0; i < 256; i++)
+    {
+        crc = aCrc16Table_l[i];
+        for (n = 0; n < (OBDCONF_CRC_SLICE_COUNT - 1); n++)
+        {
+            crc = (UINT16)((crc << 8) ^ aCrc16Table_l[crc >> 8]);
+            aaCrc16SliceTable_l[n][i] = crc;
+        }
+    }
+
+    fCrc16SliceTableValid_l = TRUE;
+}
+
+/// \}
+
 #endif // #if (CONFIG_OBD_USE_STORE_RESTORE != FALSE)
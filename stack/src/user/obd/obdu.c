@@ -42,6 +42,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
 #include <user/obdu.h>
+#include <user/obdview.h>
 #include <common/ami.h>
 
 #if (CONFIG_OBD_CALC_OD_SIGNATURE != FALSE)
@@ -501,6 +502,8 @@ tOplkError obdu_accessOdPart(tObdPart obdPart_p, tObdDir direction_p)
     // no access to an OD part was done? illegal OD part was specified!
     if (fPartFound == FALSE)
         ret = kErrorObdIllegalPart;
+    else
+        obdview_refreshAllViews();
 
     return ret;
 }
@@ -1939,6 +1942,9 @@ static tOplkError writeEntryPost(const tObdEntry* pObdEntry_p,
     pCbParam_p->obdEvent = kObdEvPostWrite;
     ret = callObjectCallback(pObdEntry_p, pCbParam_p);
 
+    // update the mirrors of the object views with the final value
+    obdview_updateEntry(pCbParam_p->index, pCbParam_p->subIndex, pDstData_p, obdSize_p);
+
     return ret;
 }
 
@@ -0,0 +1,609 @@
+/**
+********************************************************************************
+\file   obdview.c
+
+\brief  Implementation of object view module
+
+This file contains the implementation of the object view module. It keeps
+packed mirrors of application defined sets of objects which can be read from
+any thread without accessing the object dictionary.
+
+\ingroup module_obdview
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/target.h>
+#include <user/obdview.h>
+#include <user/obdu.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define OBDVIEW_READ_RETRIES        16          // Number of read attempts while a view is written
+
+// The sequence counters are accessed by different threads, therefore a full
+// memory barrier is required. OPLK_MEMBAR() is empty on some targets.
+#if defined(__GNUC__)
+#define OBDVIEW_BARRIER()           __sync_synchronize()
+#else
+#define OBDVIEW_BARRIER()           OPLK_MEMBAR()
+#endif
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief Object view
+
+The structure describes one registered object view.
+*/
+typedef struct
+{
+    volatile UINT32             sequence;       ///< Sequence counter of the mirror
+    volatile BOOL               fUsed;          ///< The view is registered
+    UINT                        entryCount;     ///< Number of objects in the view
+    tOplkApiObjectViewEntry*    paEntry;        ///< Objects of the view
+    UINT8*                      pMirror;        ///< Mirror of the object values
+    size_t                      mirrorSize;     ///< Size of the mirror
+    UINT                        minIndex;       ///< Lowest object index of the view
+    UINT                        maxIndex;       ///< Highest object index of the view
+} tObdView;
+
+/**
+\brief Object view instance
+
+The structure contains the instance variables of the object view module.
+*/
+typedef struct
+{
+    OPLK_MUTEX_T        mutex;                              ///< Mutex serializing the writers
+    BOOL                fInitialized;                       ///< The module is initialized
+    volatile UINT       activeViewCount;                    ///< Number of registered views
+    tObdView            aView[CONFIG_OBD_VIEW_COUNT];       ///< Object views
+} tObdViewInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tObdViewInstance     instance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static size_t   getAlignment(size_t size_p);
+static void     fillView(tObdView* pView_p);
+static void     beginWrite(tObdView* pView_p);
+static void     endWrite(tObdView* pView_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize object view module
+
+The function initializes the object view module.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_obdview
+*/
+//------------------------------------------------------------------------------
+tOplkError obdview_init(void)
+{
+    OPLK_MEMSET(&instance_l, 0, sizeof(tObdViewInstance));
+
+    if (target_createMutex("/obdViewMutex", &instance_l.mutex) != kErrorOk)
+        return kErrorNoResource;
+
+    instance_l.fInitialized = TRUE;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down object view module
+
+The function unregisters all views and frees their memory.
+
+\ingroup module_obdview
+*/
+//------------------------------------------------------------------------------
+void obdview_exit(void)
+{
+    UINT    viewId;
+
+    if (!instance_l.fInitialized)
+        return;
+
+    for (viewId = 0; viewId < CONFIG_OBD_VIEW_COUNT; viewId++)
+    {
+        if (instance_l.aView[viewId].fUsed)
+            obdview_unregisterView(viewId);
+    }
+
+    instance_l.fInitialized = FALSE;
+    target_destroyMutex(instance_l.mutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Register an object view
+
+The function registers a view of the given numerical objects. It determines the
+location of every value in the mirror and stores it in the offset and size
+members of the entries. Every value is aligned to its size up to 8 bytes. The
+mirror is filled with the current object values.
+
+\param[in,out]  paEntry_p           Pointer to the array of objects. The offset
+                                    and size of the values are filled in.
+\param[in]      entryCount_p        Number of objects in the array.
+\param[out]     pViewId_p           Pointer to store the ID of the view.
+\param[out]     pViewSize_p         Pointer to store the size of the mirror.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The view was registered.
+\retval kErrorApiInvalidParam       An object is not numerical.
+\retval kErrorNoResource            No free view or no memory is available.
+\retval Other                       An object does not exist.
+
+\ingroup module_obdview
+*/
+//------------------------------------------------------------------------------
+tOplkError obdview_registerView(tOplkApiObjectViewEntry* paEntry_p,
+                                UINT entryCount_p,
+                                UINT* pViewId_p,
+                                size_t* pViewSize_p)
+{
+    tOplkError                  ret;
+    tObdView*                   pView;
+    tOplkApiObjectViewEntry*    paEntry;
+    UINT8*                      pMirror;
+    BOOL                        fNumerical;
+    size_t                      offset = 0;
+    size_t                      alignment;
+    UINT                        viewId;
+    UINT                        i;
+
+    if (!instance_l.fInitialized)
+        return kErrorNoResource;
+
+    for (i = 0; i < entryCount_p; i++)
+    {
+        ret = obdu_isNumerical(paEntry_p[i].index, paEntry_p[i].subIndex, &fNumerical);
+        if (ret != kErrorOk)
+            return ret;
+
+        if (!fNumerical)
+            return kErrorApiInvalidParam;
+
+        paEntry_p[i].size = obdu_getDataSize(paEntry_p[i].index, paEntry_p[i].subIndex);
+        alignment = getAlignment(paEntry_p[i].size);
+        offset = (offset + alignment - 1) & ~(alignment - 1);
+        paEntry_p[i].offset = offset;
+        offset += paEntry_p[i].size;
+    }
+
+    paEntry = (tOplkApiObjectViewEntry*)OPLK_MALLOC(entryCount_p * sizeof(tOplkApiObjectViewEntry));
+    pMirror = (UINT8*)OPLK_MALLOC(offset);
+    if ((paEntry == NULL) || (pMirror == NULL))
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Allocation of the object view failed\n", __func__);
+        ret = kErrorNoResource;
+        goto Exit;
+    }
+
+    OPLK_MEMCPY(paEntry, paEntry_p, entryCount_p * sizeof(tOplkApiObjectViewEntry));
+    OPLK_MEMSET(pMirror, 0, offset);
+
+    target_lockMutex(instance_l.mutex);
+
+    for (viewId = 0; viewId < CONFIG_OBD_VIEW_COUNT; viewId++)
+    {
+        if (!instance_l.aView[viewId].fUsed)
+            break;
+    }
+
+    if (viewId == CONFIG_OBD_VIEW_COUNT)
+    {
+        target_unlockMutex(instance_l.mutex);
+        ret = kErrorNoResource;
+        goto Exit;
+    }
+
+    pView = &instance_l.aView[viewId];
+    pView->entryCount = entryCount_p;
+    pView->paEntry = paEntry;
+    pView->pMirror = pMirror;
+    pView->mirrorSize = offset;
+    pView->minIndex = paEntry[0].index;
+    pView->maxIndex = paEntry[0].index;
+    for (i = 1; i < entryCount_p; i++)
+    {
+        pView->minIndex = min(pView->minIndex, paEntry[i].index);
+        pView->maxIndex = max(pView->maxIndex, paEntry[i].index);
+    }
+
+    fillView(pView);
+    OBDVIEW_BARRIER();
+    pView->fUsed = TRUE;
+    instance_l.activeViewCount++;
+
+    target_unlockMutex(instance_l.mutex);
+
+    *pViewId_p = viewId;
+    *pViewSize_p = offset;
+
+    return kErrorOk;
+
+Exit:
+    if (paEntry != NULL)
+        OPLK_FREE(paEntry);
+
+    if (pMirror != NULL)
+        OPLK_FREE(pMirror);
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Unregister an object view
+
+The function unregisters an object view and frees its memory. The view must
+not be read at the same time.
+
+\param[in]      viewId_p            ID of the view.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The view was unregistered.
+\retval kErrorApiInvalidParam       The view is not registered.
+
+\ingroup module_obdview
+*/
+//------------------------------------------------------------------------------
+tOplkError obdview_unregisterView(UINT viewId_p)
+{
+    tObdView*   pView;
+
+    if (!instance_l.fInitialized || (viewId_p >= CONFIG_OBD_VIEW_COUNT))
+        return kErrorApiInvalidParam;
+
+    pView = &instance_l.aView[viewId_p];
+
+    target_lockMutex(instance_l.mutex);
+
+    if (!pView->fUsed)
+    {
+        target_unlockMutex(instance_l.mutex);
+        return kErrorApiInvalidParam;
+    }
+
+    pView->fUsed = FALSE;
+    instance_l.activeViewCount--;
+    OBDVIEW_BARRIER();
+
+    OPLK_FREE(pView->paEntry);
+    OPLK_FREE(pView->pMirror);
+    pView->paEntry = NULL;
+    pView->pMirror = NULL;
+    pView->entryCount = 0;
+    pView->mirrorSize = 0;
+
+    target_unlockMutex(instance_l.mutex);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read an object view
+
+The function copies the mirror of an object view. The copy is consistent even
+if an object of the view is written at the same time. The function does not
+access the object dictionary and can be called from any thread.
+
+\param[in]      viewId_p            ID of the view.
+\param[out]     pBuffer_p           Pointer to store the copy.
+\param[in]      bufferSize_p        Size of the buffer.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The view was copied.
+\retval kErrorRetry                 The view is currently updated.
+\retval kErrorApiInvalidParam       The view is not registered or the buffer is
+                                    too small.
+
+\ingroup module_obdview
+*/
+//------------------------------------------------------------------------------
+tOplkError obdview_readView(UINT viewId_p,
+                            void* pBuffer_p,
+                            size_t bufferSize_p)
+{
+    const tObdView* pView;
+    UINT32          sequence;
+    UINT            retry;
+
+    if (viewId_p >= CONFIG_OBD_VIEW_COUNT)
+        return kErrorApiInvalidParam;
+
+    pView = &instance_l.aView[viewId_p];
+    if (!pView->fUsed || (bufferSize_p < pView->mirrorSize))
+        return kErrorApiInvalidParam;
+
+    for (retry = 0; retry < OBDVIEW_READ_RETRIES; retry++)
+    {
+        sequence = pView->sequence;
+        if ((sequence & 1) != 0)
+            continue;
+
+        OBDVIEW_BARRIER();
+        OPLK_MEMCPY(pBuffer_p, pView->pMirror, pView->mirrorSize);
+        OBDVIEW_BARRIER();
+
+        if (pView->sequence == sequence)
+            return kErrorOk;
+    }
+
+    return kErrorRetry;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Refresh an object view
+
+The function copies the current values of all objects of a view to its mirror.
+It is used for objects which are linked to variables which are updated without
+writing the object (e.g. error counters).
+
+\param[in]      viewId_p            ID of the view.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The view was refreshed.
+\retval kErrorApiInvalidParam       The view is not registered.
+
+\ingroup module_obdview
+*/
+//------------------------------------------------------------------------------
+tOplkError obdview_refreshView(UINT viewId_p)
+{
+    tObdView*   pView;
+
+    if (!instance_l.fInitialized || (viewId_p >= CONFIG_OBD_VIEW_COUNT))
+        return kErrorApiInvalidParam;
+
+    pView = &instance_l.aView[viewId_p];
+
+    target_lockMutex(instance_l.mutex);
+
+    if (!pView->fUsed)
+    {
+        target_unlockMutex(instance_l.mutex);
+        return kErrorApiInvalidParam;
+    }
+
+    fillView(pView);
+
+    target_unlockMutex(instance_l.mutex);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Refresh all object views
+
+The function copies the current values of the objects of all views to their
+mirrors. It is called after whole OD parts were initialized or loaded.
+
+\ingroup module_obdview
+*/
+//------------------------------------------------------------------------------
+void obdview_refreshAllViews(void)
+{
+    UINT    viewId;
+
+    if (instance_l.activeViewCount == 0)
+        return;
+
+    target_lockMutex(instance_l.mutex);
+
+    for (viewId = 0; viewId < CONFIG_OBD_VIEW_COUNT; viewId++)
+    {
+        if (instance_l.aView[viewId].fUsed)
+            fillView(&instance_l.aView[viewId]);
+    }
+
+    target_unlockMutex(instance_l.mutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Update an object in the object views
+
+The function is called by the object dictionary after an object was written.
+It copies the new value to all views which contain the object.
+
+\param[in]      index_p             Index of the written object.
+\param[in]      subIndex_p          Sub-index of the written object.
+\param[in]      pData_p             Pointer to the new value.
+\param[in]      size_p              Size of the new value.
+
+\ingroup module_obdview
+*/
+//------------------------------------------------------------------------------
+void obdview_updateEntry(UINT index_p,
+                         UINT subIndex_p,
+                         const void* pData_p,
+                         tObdSize size_p)
+{
+    tObdView*                       pView;
+    const tOplkApiObjectViewEntry*  pEntry;
+    UINT                            viewId;
+    UINT                            i;
+
+    // fast path for the common case without registered views
+    if (instance_l.activeViewCount == 0)
+        return;
+
+    target_lockMutex(instance_l.mutex);
+
+    for (viewId = 0; viewId < CONFIG_OBD_VIEW_COUNT; viewId++)
+    {
+        pView = &instance_l.aView[viewId];
+        if (!pView->fUsed ||
+            (index_p < pView->minIndex) ||
+            (index_p > pView->maxIndex))
+            continue;
+
+        for (i = 0; i < pView->entryCount; i++)
+        {
+            pEntry = &pView->paEntry[i];
+            if ((pEntry->index != index_p) || (pEntry->subIndex != subIndex_p))
+                continue;
+
+            beginWrite(pView);
+            OPLK_MEMCPY(pView->pMirror + pEntry->offset, pData_p, min(pEntry->size, size_p));
+            endWrite(pView);
+        }
+    }
+
+    target_unlockMutex(instance_l.mutex);
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the alignment of a value in the mirror
+
+\param[in]      size_p              Size of the value.
+
+\return The function returns the alignment of the value.
+*/
+//------------------------------------------------------------------------------
+static size_t getAlignment(size_t size_p)
+{
+    if (size_p >= 8)
+        return 8;
+
+    if (size_p >= 4)
+        return 4;
+
+    if (size_p >= 2)
+        return 2;
+
+    return 1;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy the current object values to a view
+
+The function has to be called with locked mutex.
+
+\param[in,out]  pView_p             Pointer to the view.
+*/
+//------------------------------------------------------------------------------
+static void fillView(tObdView* pView_p)
+{
+    const tOplkApiObjectViewEntry*  pEntry;
+    const void*                     pData;
+    UINT                            i;
+
+    beginWrite(pView_p);
+
+    for (i = 0; i < pView_p->entryCount; i++)
+    {
+        pEntry = &pView_p->paEntry[i];
+        pData = obdu_getObjectDataPtr(pEntry->index, pEntry->subIndex);
+        if (pData != NULL)
+            OPLK_MEMCPY(pView_p->pMirror + pEntry->offset, pData, pEntry->size);
+    }
+
+    endWrite(pView_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start writing a view
+
+\param[in,out]  pView_p             Pointer to the view.
+*/
+//------------------------------------------------------------------------------
+static void beginWrite(tObdView* pView_p)
+{
+    pView_p->sequence++;
+    OBDVIEW_BARRIER();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Finish writing a view
+
+\param[in,out]  pView_p             Pointer to the view.
+*/
+//------------------------------------------------------------------------------
+static void endWrite(tObdView* pView_p)
+{
+    OBDVIEW_BARRIER();
+    pView_p->sequence++;
+}
+
+/// \}
@@ -44,6 +44,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <user/pdou.h>
 #include <user/pdoucal.h>
 #include <user/obdu.h>
+#include <user/eventu.h>
 
 #include <common/pdo.h>
 #include <common/target.h>
@@ -134,6 +135,22 @@ typedef struct
     UINT16                  byteSizeOrType;         ///< The size of the data in bytes
 } tPdoMappObject;
 
+/**
+\brief User PDO channel update
+
+The structure stores the configuration of a running PDO channel which has been
+posted to the kernel layer. It is applied when the kernel layer reports the
+configuration counter, i.e. at the same cycle boundary as in the kernel layer.
+The mapping objects of the update are stored in the update object array of the
+instance.
+*/
+typedef struct
+{
+    tPdoChannel             pdoChannel;                 ///< New configuration of the PDO channel
+    UINT8                   configCount;                ///< Configuration counter of the last posted configuration
+    BOOL                    fPending;                   ///< Flag determines if the update waits to be applied
+} tPdouChannelUpdate;
+
 /**
 \brief User PDO module instance
 
@@ -146,6 +163,12 @@ typedef struct
     tPdoChannelSetup        pdoChannels;                ///< PDO channel setup
     tPdoMappObject*         paRxObject;                 ///< Pointer to RX channel objects
     tPdoMappObject*         paTxObject;                 ///< Pointer to TX channel objects
+    tPdoMappObject*         paRxUpdateObject;           ///< Pointer to RX channel objects of the channel updates
+    tPdoMappObject*         paTxUpdateObject;           ///< Pointer to TX channel objects of the channel updates
+    tPdouChannelUpdate      aRxUpdate[D_PDO_RPDOChannels_U16]; ///< RX channel updates waiting for the kernel layer
+    tPdouChannelUpdate      aTxUpdate[D_PDO_TPDOChannels_U16]; ///< TX channel updates waiting for the kernel layer
+    UINT16                  aRxChannelSize[D_PDO_RPDOChannels_U16]; ///< Size of the RX channel buffers in the PDO memory
+    UINT16                  aTxChannelSize[D_PDO_TPDOChannels_U16]; ///< Size of the TX channel buffers in the PDO memory
     BOOL                    fAllocated;                 ///< Flag determines if PDOs are allocated
     BOOL                    fRunning;                   ///< Flag determines if PDO engine is running
     BOOL                    fInitialized;               ///< Flag determines if PDO module is initialized
@@ -200,7 +223,8 @@ static tOplkError setupMappingObjects(tPdoMappObject* pMappObject_p,
                                       UINT16* pOffset_p,
                                       UINT16* pNextChannelOffset_p,
                                       UINT16* pCount_p);
-static tOplkError configurePdoChannel(const tPdoChannelConf* pChannelConf_p);
+static tOplkError configurePdoChannel(tPdoChannelConf* pChannelConf_p);
+static void applyChannelUpdates(BOOL fTx_p);
 static tOplkError getMaxPdoSize(UINT8 nodeId_p,
                                 BOOL fTxPdo_p,
                                 UINT16* pMaxPdoSize_p,
@@ -209,12 +233,16 @@ static tOplkError getPdoChannelId(UINT pdoId_p, BOOL fTxPdo_p, UINT8* pChannelId
 static size_t calcPdoMemSize(const tPdoChannelSetup* pPdoChannels_p,
                              size_t* pRxPdoMemSize_p,
                              size_t* pTxPdoMemSize_p);
+static void storeChannelSizes(const tPdoChannelSetup* pPdoChannels_p);
 static tOplkError copyVarToPdo(void* pPayload_p,
                                const tPdoMappObject* pMappObject_p,
                                UINT16 offsetInFrame_p);
 static tOplkError copyVarFromPdo(const void* pPayload_p,
                                  const tPdoMappObject* pMappObject_p,
                                  UINT16 offsetInFrame_p);
+#if (CONFIG_DLL_PRES_LATE_DATA != FALSE)
+static tOplkError postPresReady(void);
+#endif
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -496,6 +524,15 @@ tOplkError pdou_copyRxPdoToPi(void)
         return kErrorOk;
     }
 
+    ret = pdoucal_acquireRxPdoImage();
+    if (ret != kErrorOk)
+    {
+        target_unlockMutex(pdouInstance_g.lockMutex);
+        return ret;
+    }
+
+    applyChannelUpdates(FALSE);
+
     for (channelId = 0;
          channelId < pdouInstance_g.pdoChannels.allocation.rxPdoChannelCount;
          channelId++)
@@ -569,6 +606,8 @@ tOplkError pdou_copyTxPdoFromPi(void)
         return kErrorOk;
     }
 
+    applyChannelUpdates(TRUE);
+
     for (channelId = 0;
          channelId < pdouInstance_g.pdoChannels.allocation.txPdoChannelCount;
          channelId++)
@@ -606,8 +645,16 @@ tOplkError pdou_copyTxPdoFromPi(void)
                                pPdoChannel->nextChannelOffset - pPdoChannel->offset);
     }
 
+    if (ret == kErrorOk)
+        ret = pdoucal_publishTxPdoImage();
+
     target_unlockMutex(pdouInstance_g.lockMutex);
 
+#if (CONFIG_DLL_PRES_LATE_DATA != FALSE)
+    if (ret == kErrorOk)
+        ret = postPresReady();
+#endif
+
     return ret;
 }
 
@@ -862,6 +909,12 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
             pdouInstance_g.paRxObject = NULL;
         }
 
+        if (pdouInstance_g.paRxUpdateObject != NULL)
+        {
+            OPLK_FREE(pdouInstance_g.paRxUpdateObject);
+            pdouInstance_g.paRxUpdateObject = NULL;
+        }
+
         if (pAllocationParam_p->rxPdoChannelCount > 0)
         {
             pdouInstance_g.pdoChannels.pRxPdoChannel =
@@ -883,6 +936,17 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
                 ret = kErrorPdoInitError;
                 goto Exit;
             }
+
+            pdouInstance_g.paRxUpdateObject =
+                    (tPdoMappObject*)OPLK_MALLOC(sizeof(tPdoMappObject)
+                               * pAllocationParam_p->rxPdoChannelCount
+                               * D_PDO_RPDOChannelObjects_U8);
+
+            if (pdouInstance_g.paRxUpdateObject == NULL)
+            {
+                ret = kErrorPdoInitError;
+                goto Exit;
+            }
         }
     }
 
@@ -890,6 +954,7 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
     for (index = 0; index < pAllocationParam_p->rxPdoChannelCount; index++)
     {
         pdouInstance_g.pdoChannels.pRxPdoChannel[index].nodeId = PDO_INVALID_NODE_ID;
+        pdouInstance_g.aRxUpdate[index].fPending = FALSE;
     }
 
     //--------------------------------------------------------------------------
@@ -908,6 +973,12 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
             pdouInstance_g.paTxObject = NULL;
         }
 
+        if (pdouInstance_g.paTxUpdateObject != NULL)
+        {
+            OPLK_FREE(pdouInstance_g.paTxUpdateObject);
+            pdouInstance_g.paTxUpdateObject = NULL;
+        }
+
         if (pAllocationParam_p->txPdoChannelCount > 0)
         {
             pdouInstance_g.pdoChannels.pTxPdoChannel =
@@ -927,6 +998,16 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
                 ret = kErrorPdoInitError;
                 goto Exit;
             }
+
+            pdouInstance_g.paTxUpdateObject =
+                    (tPdoMappObject*)OPLK_MALLOC(sizeof(tPdoMappObject)
+                               * pAllocationParam_p->txPdoChannelCount
+                               * D_PDO_TPDOChannelObjects_U8);
+            if (pdouInstance_g.paTxUpdateObject == NULL)
+            {
+                ret = kErrorPdoInitError;
+                goto Exit;
+            }
         }
     }
 
@@ -934,6 +1015,7 @@ static tOplkError allocatePdoChannels(const tPdoAllocationParam* pAllocationPara
     for (index = 0; index < pAllocationParam_p->txPdoChannelCount; index++)
     {
         pdouInstance_g.pdoChannels.pTxPdoChannel[index].nodeId = PDO_INVALID_NODE_ID;
+        pdouInstance_g.aTxUpdate[index].fPending = FALSE;
     }
 
 Exit:
@@ -966,6 +1048,12 @@ static tOplkError freePdoChannels(void)
         pdouInstance_g.paRxObject = NULL;
     }
 
+    if (pdouInstance_g.paRxUpdateObject != NULL)
+    {
+        OPLK_FREE(pdouInstance_g.paRxUpdateObject);
+        pdouInstance_g.paRxUpdateObject = NULL;
+    }
+
     if (pdouInstance_g.pdoChannels.pTxPdoChannel != NULL)
     {
         OPLK_FREE(pdouInstance_g.pdoChannels.pTxPdoChannel);
@@ -978,6 +1066,12 @@ static tOplkError freePdoChannels(void)
         pdouInstance_g.paTxObject = NULL;
     }
 
+    if (pdouInstance_g.paTxUpdateObject != NULL)
+    {
+        OPLK_FREE(pdouInstance_g.paTxUpdateObject);
+        pdouInstance_g.paTxUpdateObject = NULL;
+    }
+
     return ret;
 }
 
@@ -1034,6 +1128,7 @@ static tOplkError configureAllPdos(void)
         goto Exit;
 
     calcPdoMemSize(&pdouInstance_g.pdoChannels, &rxPdoMemSize, &txPdoMemSize);
+    storeChannelSizes(&pdouInstance_g.pdoChannels);
     pdoucal_postSetupPdoBuffers(rxPdoMemSize, txPdoMemSize);
 
     // TODO how to be sure that kernel is ready before starting??
@@ -1117,9 +1212,11 @@ static tOplkError checkAndConfigurePdo(UINT16 mappParamIndex_p,
     tPdoChannelConf pdoChannelConf;
     BOOL            fTxPdo;
     tPdoMappObject* pMappObject;
+    tPdouChannelUpdate* pUpdate;
     UINT16          offset;
     UINT16          nextChannelOffset;
     UINT16          count;
+    UINT16          channelSize;
 
     DEBUG_LVL_PDO_TRACE("%s() mappParamIndex:%04x mappObjectCount:%d\n",
                         __func__,
@@ -1168,7 +1265,6 @@ static tOplkError checkAndConfigurePdo(UINT16 mappParamIndex_p,
         pdoChannelConf.pdoChannel.mappObjectCount = 0;
         pdoChannelConf.pdoChannel.offset = 0;
         pdoChannelConf.pdoChannel.nextChannelOffset = 0;
-        pdouInstance_g.fRunning = FALSE;
         ret = configurePdoChannel(&pdoChannelConf);
 
         if ((pdouInstance_g.fAllocated) && (pdouInstance_g.pfnCbEventPdoChange != NULL))
@@ -1211,12 +1307,25 @@ static tOplkError checkAndConfigurePdo(UINT16 mappParamIndex_p,
         goto Exit;
     }
 
+    // The mapping objects are set up in the update objects of the channel and
+    // are taken over by configurePdoChannel(). A pending update of the channel
+    // is discarded, as its objects are overwritten.
     if (fTxPdo)
-        pMappObject = &pdouInstance_g.paTxObject[pdoChannelConf.channelId *
-                                                 D_PDO_TPDOChannelObjects_U8];
+    {
+        pMappObject = &pdouInstance_g.paTxUpdateObject[pdoChannelConf.channelId *
+                                                       D_PDO_TPDOChannelObjects_U8];
+        pUpdate = &pdouInstance_g.aTxUpdate[pdoChannelConf.channelId];
+    }
     else
-        pMappObject = &pdouInstance_g.paRxObject[pdoChannelConf.channelId *
-                                                 D_PDO_RPDOChannelObjects_U8];
+    {
+        pMappObject = &pdouInstance_g.paRxUpdateObject[pdoChannelConf.channelId *
+                                                       D_PDO_RPDOChannelObjects_U8];
+        pUpdate = &pdouInstance_g.aRxUpdate[pdoChannelConf.channelId];
+    }
+
+    target_lockMutex(pdouInstance_g.lockMutex);
+    pUpdate->fPending = FALSE;
+    target_unlockMutex(pdouInstance_g.lockMutex);
 
     ret = setupMappingObjects(pMappObject,
                               mappParamIndex_p,
@@ -1233,6 +1342,19 @@ static tOplkError checkAndConfigurePdo(UINT16 mappParamIndex_p,
     pdoChannelConf.pdoChannel.nextChannelOffset = nextChannelOffset;
     pdoChannelConf.pdoChannel.mappObjectCount = count;
 
+    channelSize = fTxPdo ? pdouInstance_g.aTxChannelSize[pdoChannelConf.channelId]
+                         : pdouInstance_g.aRxChannelSize[pdoChannelConf.channelId];
+    if (pdouInstance_g.fRunning && ((nextChannelOffset - offset) > channelSize))
+    {   // PDO does not fit into its channel buffer, the PDO memory layout has
+        // to be rebuilt by the next NMT reset configuration
+        DEBUG_LVL_PDO_TRACE("%s() PDO %04x exceeds its channel buffer, PDO engine stopped\n",
+                            __func__,
+                            mappParamIndex_p);
+        target_lockMutex(pdouInstance_g.lockMutex);
+        pdouInstance_g.fRunning = FALSE;
+        target_unlockMutex(pdouInstance_g.lockMutex);
+    }
+
     // do not make the call before Alloc has been called
     ret = configurePdoChannel(&pdoChannelConf);
     if (ret != kErrorOk)
@@ -1260,27 +1382,72 @@ Exit:
 /**
 \brief  Configure the specified PDO channel
 
-The function configures the specified PDO channel.
+The function configures the specified PDO channel. The mapping objects of the
+channel must have been set up in the update objects of the channel before.
+
+If the PDO engine is running, the configuration is staged and applied by
+applyChannelUpdates() when the kernel layer reports its configuration counter.
+Thus, the user and the kernel layer switch the channel at the same cycle
+boundary. Otherwise, the configuration is applied immediately.
 
-\param[in]      pChannelConf_p      PDO channel configuration
+\param[in,out]  pChannelConf_p      PDO channel configuration. The configuration
+                                    counter is set by the function.
 
 \return The function returns a tOplkError error code.
 **/
 //------------------------------------------------------------------------------
-static tOplkError configurePdoChannel(const tPdoChannelConf* pChannelConf_p)
+static tOplkError configurePdoChannel(tPdoChannelConf* pChannelConf_p)
 {
-    tOplkError      ret = kErrorOk;
-    tPdoChannel*    pDestPdoChannel;
+    tOplkError              ret = kErrorOk;
+    tPdoChannel*            pDestPdoChannel;
+    tPdoMappObject*         pDestMappObject;
+    const tPdoMappObject*   pMappObject;
+    tPdouChannelUpdate*     pUpdate;
 
     if (pdouInstance_g.fAllocated != FALSE)
     {
         if (pChannelConf_p->fTx)
+        {
             pDestPdoChannel = &pdouInstance_g.pdoChannels.pTxPdoChannel[pChannelConf_p->channelId];
+            pDestMappObject = &pdouInstance_g.paTxObject[pChannelConf_p->channelId *
+                                                         D_PDO_TPDOChannelObjects_U8];
+            pMappObject = &pdouInstance_g.paTxUpdateObject[pChannelConf_p->channelId *
+                                                           D_PDO_TPDOChannelObjects_U8];
+            pUpdate = &pdouInstance_g.aTxUpdate[pChannelConf_p->channelId];
+        }
         else
+        {
             pDestPdoChannel = &pdouInstance_g.pdoChannels.pRxPdoChannel[pChannelConf_p->channelId];
+            pDestMappObject = &pdouInstance_g.paRxObject[pChannelConf_p->channelId *
+                                                         D_PDO_RPDOChannelObjects_U8];
+            pMappObject = &pdouInstance_g.paRxUpdateObject[pChannelConf_p->channelId *
+                                                           D_PDO_RPDOChannelObjects_U8];
+            pUpdate = &pdouInstance_g.aRxUpdate[pChannelConf_p->channelId];
+        }
+
+        // The configuration counter 0 is reserved for a reset PDO memory
+        pUpdate->configCount++;
+        if (pUpdate->configCount == 0)
+            pUpdate->configCount = 1;
+        pChannelConf_p->configCount = pUpdate->configCount;
 
-        // Setup user channel configuration
-        OPLK_MEMCPY(pDestPdoChannel, &pChannelConf_p->pdoChannel, sizeof(tPdoChannel));
+        // Setup user channel configuration, the other channels are not
+        // disturbed by the update
+        target_lockMutex(pdouInstance_g.lockMutex);
+        if (pdouInstance_g.fRunning)
+        {
+            pUpdate->pdoChannel = pChannelConf_p->pdoChannel;
+            pUpdate->fPending = TRUE;
+        }
+        else
+        {
+            OPLK_MEMCPY(pDestPdoChannel, &pChannelConf_p->pdoChannel, sizeof(tPdoChannel));
+            OPLK_MEMCPY(pDestMappObject,
+                        pMappObject,
+                        sizeof(tPdoMappObject) * pChannelConf_p->pdoChannel.mappObjectCount);
+            pUpdate->fPending = FALSE;
+        }
+        target_unlockMutex(pdouInstance_g.lockMutex);
 
         DEBUG_LVL_PDO_TRACE("%s(): pdoucal_postConfigureChannel(): TX:%d channel:%d offset:%d\n",
                             __func__,
@@ -1293,6 +1460,61 @@ static tOplkError configurePdoChannel(const tPdoChannelConf* pChannelConf_p)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Apply pending PDO channel updates
+
+The function applies the pending updates of the PDO channels of a given
+direction (RX/TX) whose configuration counters have been reported by the kernel
+layer. The function must be called with locked mutex.
+
+\param[in]      fTx_p               TRUE for TPDO channels, FALSE for RPDO channels
+**/
+//------------------------------------------------------------------------------
+static void applyChannelUpdates(BOOL fTx_p)
+{
+    UINT8                   channelId;
+    UINT8                   channelCount;
+    tPdouChannelUpdate*     pUpdate;
+    tPdoChannel*            pPdoChannel;
+    tPdoMappObject*         pMappObject;
+    const tPdoMappObject*   pUpdateObject;
+    UINT                    objectCount;
+
+    if (fTx_p)
+    {
+        channelCount = pdouInstance_g.pdoChannels.allocation.txPdoChannelCount;
+        pUpdate = pdouInstance_g.aTxUpdate;
+        pPdoChannel = pdouInstance_g.pdoChannels.pTxPdoChannel;
+        pMappObject = pdouInstance_g.paTxObject;
+        pUpdateObject = pdouInstance_g.paTxUpdateObject;
+        objectCount = D_PDO_TPDOChannelObjects_U8;
+    }
+    else
+    {
+        channelCount = pdouInstance_g.pdoChannels.allocation.rxPdoChannelCount;
+        pUpdate = pdouInstance_g.aRxUpdate;
+        pPdoChannel = pdouInstance_g.pdoChannels.pRxPdoChannel;
+        pMappObject = pdouInstance_g.paRxObject;
+        pUpdateObject = pdouInstance_g.paRxUpdateObject;
+        objectCount = D_PDO_RPDOChannelObjects_U8;
+    }
+
+    for (channelId = 0; channelId < channelCount;
+         channelId++, pUpdate++, pPdoChannel++, pMappObject += objectCount, pUpdateObject += objectCount)
+    {
+        if (!pUpdate->fPending ||
+            (pdoucal_getChannelConfigCount(fTx_p, channelId) != pUpdate->configCount))
+            continue;
+
+        *pPdoChannel = pUpdate->pdoChannel;
+        OPLK_MEMCPY(pMappObject,
+                    pUpdateObject,
+                    sizeof(tPdoMappObject) * pUpdate->pdoChannel.mappObjectCount);
+        pUpdate->fPending = FALSE;
+    }
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  get max PDO size
@@ -1992,4 +2214,61 @@ static size_t calcPdoMemSize(const tPdoChannelSetup* pPdoChannels_p,
     return rxSize + txSize;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Store PDO channel sizes
+
+The function stores the size of each channel buffer in the PDO memory. A PDO
+can be remapped while the PDO engine is running if it still fits into the
+buffer of its channel.
+
+\param[in]      pPdoChannels_p      Pointer to PDO channel setup.
+*/
+//------------------------------------------------------------------------------
+static void storeChannelSizes(const tPdoChannelSetup* pPdoChannels_p)
+{
+    UINT8               channelId;
+    const tPdoChannel*  pPdoChannel;
+
+    for (channelId = 0, pPdoChannel = pPdoChannels_p->pRxPdoChannel;
+         channelId < pPdoChannels_p->allocation.rxPdoChannelCount;
+         channelId++, pPdoChannel++)
+    {
+        pdouInstance_g.aRxChannelSize[channelId] = pPdoChannel->nextChannelOffset - pPdoChannel->offset;
+    }
+
+    for (channelId = 0, pPdoChannel = pPdoChannels_p->pTxPdoChannel;
+         channelId < pPdoChannels_p->allocation.txPdoChannelCount;
+         channelId++, pPdoChannel++)
+    {
+        pdouInstance_g.aTxChannelSize[channelId] = pPdoChannel->nextChannelOffset - pPdoChannel->offset;
+    }
+}
+
+#if (CONFIG_DLL_PRES_LATE_DATA != FALSE)
+//------------------------------------------------------------------------------
+/**
+\brief  Post PRes ready event
+
+The function informs the kernel DLL that new TPDO data has been published, so
+that it can rebuild the prepared PRes frame before the next PReq arrives.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError postPresReady(void)
+{
+    tEvent  event;
+
+    event.eventSink = kEventSinkDllk;
+    event.netTime.nsec = 0;
+    event.netTime.sec = 0;
+    event.eventType = kEventTypeDllkPresReady;
+    event.eventArg.pEventArg = NULL;
+    event.eventArgSize = 0;
+
+    return eventu_postEvent(&event);
+}
+#endif
+
 /// \}
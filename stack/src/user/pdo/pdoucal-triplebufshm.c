@@ -15,6 +15,11 @@ in the pdoucalmem-XX.c modules.
 A critical part is when switching the buffers. To implement safe operation
 without locking, the buffer switching has to be performed in an atomic operation.
 
+If the kernel layer operates the PDO memory in the cycle-coherent mode (see
+tPdoImageInfo), the buffers are switched once per cycle for the whole image.
+The RPDO image is taken over by pdoucal_acquireRxPdoImage() and the TPDO image
+is published by pdoucal_publishTxPdoImage().
+
 \ingroup module_pdoucal
 *******************************************************************************/
 
@@ -76,6 +81,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // const defines
 //------------------------------------------------------------------------------
+#define PDOUCAL_FRESH_MAP_SIZE      ((D_PDO_TPDOChannels_U16 + 31) / 32)
 
 //------------------------------------------------------------------------------
 // local types
@@ -88,9 +94,17 @@ static tPdoMemRegion*   pPdoMem_l;
 static size_t           memSize_l;
 static void*            pTripleBuf_l[3];
 
+// Cycle-coherent mode
+static BOOL             fCycleCoherent_l;
+static const UINT8*     pRxImage_l;                             // RPDO image in the current read buffer
+static UINT8*           pTxImage_l;                             // TPDO image in the current write buffer
+static const UINT8*     pTxPublishedImage_l;                    // TPDO image published last
+static UINT32           aTxFreshMap_l[PDOUCAL_FRESH_MAP_SIZE];  // TPDO channels written in the current cycle
+
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static void copyStaleTxChannels(UINT8* pDstImage_p, const UINT8* pSrcImage_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -153,6 +167,22 @@ tOplkError pdoucal_initPdoMem(const tPdoChannelSetup* pPdoChannels_p,
 
     OPLK_ATOMIC_INIT(pPdoMem_l);
 
+    // The memory region has already been set up by the kernel layer
+    OPLK_DCACHE_INVALIDATE(pPdoMem_l, sizeof(tPdoMemRegion));
+    fCycleCoherent_l = (pPdoMem_l->fCycleCoherent != 0);
+    if (fCycleCoherent_l)
+    {
+        pRxImage_l = (const UINT8*)pTripleBuf_l[pPdoMem_l->rxImageInfo.readBuf] +
+                     pPdoMem_l->rxImageInfo.sectionOffset;
+        pTxImage_l = (UINT8*)pTripleBuf_l[pPdoMem_l->txImageInfo.writeBuf] +
+                     pPdoMem_l->txImageInfo.sectionOffset;
+        pTxPublishedImage_l = (const UINT8*)pTripleBuf_l[pPdoMem_l->txImageInfo.cleanBuf] +
+                              pPdoMem_l->txImageInfo.sectionOffset;
+        OPLK_MEMSET(aTxFreshMap_l, 0, sizeof(aTxFreshMap_l));
+
+        DEBUG_LVL_PDO_TRACE("%s() Cycle-coherent PDO images\n", __func__);
+    }
+
     return kErrorOk;
 }
 
@@ -174,6 +204,11 @@ void pdoucal_cleanupPdoMem(void)
             DEBUG_LVL_ERROR_TRACE("%s() Unmapping shared PDO mem failed\n", __func__);
         }
     }
+
+    fCycleCoherent_l = FALSE;
+    pRxImage_l = NULL;
+    pTxImage_l = NULL;
+    pTxPublishedImage_l = NULL;
 }
 
 //------------------------------------------------------------------------------
@@ -194,6 +229,12 @@ void* pdoucal_getTxPdoAdrs(UINT8 channelId_p)
     OPLK_ATOMIC_T   wi;
     void*           pPdo;
 
+    if (fCycleCoherent_l)
+    {
+        return pTxImage_l + pPdoMem_l->txChannelInfo[channelId_p].channelOffset -
+               pPdoMem_l->txImageInfo.sectionOffset;
+    }
+
     // Invalidate data cache for addressed txChannelInfo
     OPLK_DCACHE_INVALIDATE(&(pPdoMem_l->txChannelInfo[channelId_p]), sizeof(tPdoBufferInfo));
 
@@ -233,6 +274,13 @@ tOplkError pdoucal_setTxPdo(UINT8 channelId_p,
     UNUSED_PARAMETER(pPdo_p);       // Used to avoid compiler warning if OPLK_DCACHE_FLUSH is not set
     UNUSED_PARAMETER(pdoSize_p);    // Used to avoid compiler warning if OPLK_DCACHE_FLUSH is not set
 
+    if (fCycleCoherent_l)
+    {
+        // The image is flushed and published in pdoucal_publishTxPdoImage()
+        aTxFreshMap_l[channelId_p >> 5] |= (UINT32)1 << (channelId_p & 31);
+        return kErrorOk;
+    }
+
     OPLK_DCACHE_FLUSH(pPdo_p, pdoSize_p);
 
     DEBUG_LVL_PDO_TRACE("%s() chan:%d wi:%d\n",
@@ -287,6 +335,14 @@ tOplkError pdoucal_getRxPdo(void** ppPdo_p,
     // Check parameter validity
     ASSERT(ppPdo_p != NULL);
 
+    if (fCycleCoherent_l)
+    {
+        // The image has been taken over and invalidated in pdoucal_acquireRxPdoImage()
+        *ppPdo_p = (UINT8*)pRxImage_l + pPdoMem_l->rxChannelInfo[channelId_p].channelOffset -
+                   pPdoMem_l->rxImageInfo.sectionOffset;
+        return kErrorOk;
+    }
+
     // Invalidate data cache for addressed txChannelInfo
     OPLK_DCACHE_INVALIDATE(&(pPdoMem_l->rxChannelInfo[channelId_p]),
                            sizeof(tPdoBufferInfo));
@@ -312,10 +368,165 @@ tOplkError pdoucal_getRxPdo(void** ppPdo_p,
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get the configuration counter of a PDO channel
+
+The function returns the configuration counter of the channel configuration
+which is currently applied by the kernel layer.
+
+\param[in]      fTx_p               TRUE for a TPDO channel, FALSE for an RPDO channel.
+\param[in]      channelId_p         Channel ID of the PDO channel.
+
+\return The function returns the configuration counter of the channel. If the
+        PDO memory is not initialized, 0 is returned.
+
+\ingroup module_pdoucal
+*/
+//------------------------------------------------------------------------------
+UINT8 pdoucal_getChannelConfigCount(BOOL fTx_p,
+                                    UINT8 channelId_p)
+{
+    tPdoBufferInfo* pBufferInfo;
+
+    if (pPdoMem_l == NULL)
+        return 0;
+
+    if (fTx_p)
+        pBufferInfo = &pPdoMem_l->txChannelInfo[channelId_p];
+    else
+        pBufferInfo = &pPdoMem_l->rxChannelInfo[channelId_p];
+
+    OPLK_DCACHE_INVALIDATE(pBufferInfo, sizeof(tPdoBufferInfo));
+
+    return pBufferInfo->configCount;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Acquire RPDO image
+
+The function takes over the latest RPDO image published by the kernel layer.
+It must be called before the RPDOs of a cycle are read with pdoucal_getRxPdo().
+If the PDO memory is not operated in the cycle-coherent mode, the function
+does nothing.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_pdoucal
+*/
+//------------------------------------------------------------------------------
+tOplkError pdoucal_acquireRxPdoImage(void)
+{
+    tPdoImageInfo*  pImageInfo;
+    OPLK_ATOMIC_T   readBuf;
+
+    if (!fCycleCoherent_l)
+        return kErrorOk;
+
+    pImageInfo = &pPdoMem_l->rxImageInfo;
+    OPLK_DCACHE_INVALIDATE(pImageInfo, sizeof(tPdoImageInfo));
+
+    if (pImageInfo->newData)
+    {
+        readBuf = pImageInfo->readBuf;
+        OPLK_ATOMIC_EXCHANGE(&pImageInfo->cleanBuf, readBuf, pImageInfo->readBuf);
+        pImageInfo->newData = 0;
+        OPLK_DCACHE_FLUSH(pImageInfo, sizeof(tPdoImageInfo));
+
+        pRxImage_l = (const UINT8*)pTripleBuf_l[pImageInfo->readBuf] + pImageInfo->sectionOffset;
+        OPLK_DCACHE_INVALIDATE(pRxImage_l, pImageInfo->sectionSize);
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Publish TPDO image
+
+The function publishes the TPDO image which has been written with
+pdoucal_getTxPdoAdrs() and pdoucal_setTxPdo() to the kernel layer. If the PDO
+memory is not operated in the cycle-coherent mode, the function does nothing.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_pdoucal
+*/
+//------------------------------------------------------------------------------
+tOplkError pdoucal_publishTxPdoImage(void)
+{
+    tPdoImageInfo*  pImageInfo;
+    OPLK_ATOMIC_T   writeBuf;
+
+    if (!fCycleCoherent_l)
+        return kErrorOk;
+
+    pImageInfo = &pPdoMem_l->txImageInfo;
+    OPLK_DCACHE_INVALIDATE(pImageInfo, sizeof(tPdoImageInfo));
+
+    // Channels which have not been written keep the data of the last published image
+    copyStaleTxChannels(pTxImage_l, pTxPublishedImage_l);
+    OPLK_MEMSET(aTxFreshMap_l, 0, sizeof(aTxFreshMap_l));
+    OPLK_DCACHE_FLUSH(pTxImage_l, pImageInfo->sectionSize);
+
+    writeBuf = pImageInfo->writeBuf;
+    OPLK_ATOMIC_EXCHANGE(&pImageInfo->cleanBuf, writeBuf, pImageInfo->writeBuf);
+    pImageInfo->newData = 1;
+    OPLK_DCACHE_FLUSH(pImageInfo, sizeof(tPdoImageInfo));
+
+    pTxPublishedImage_l = pTxImage_l;
+    pTxImage_l = (UINT8*)pTripleBuf_l[pImageInfo->writeBuf] + pImageInfo->sectionOffset;
+
+    return kErrorOk;
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief  Copy stale TPDO channels
+
+The function copies all TPDO channels which have not been written in the
+current cycle from the last published image into the image to be published.
+
+\param[out]     pDstImage_p         Pointer to the TPDO image to be published.
+\param[in]      pSrcImage_p         Pointer to the last published TPDO image.
+*/
+//------------------------------------------------------------------------------
+static void copyStaleTxChannels(UINT8* pDstImage_p, const UINT8* pSrcImage_p)
+{
+    const tPdoImageInfo*    pImageInfo = &pPdoMem_l->txImageInfo;
+    UINT                    channelId;
+    UINT                    mapIndex;
+    UINT32                  staleMap;
+    UINT32                  offset;
+    UINT32                  nextOffset;
+
+    for (mapIndex = 0; (mapIndex * 32) < pImageInfo->channelCount; mapIndex++)
+    {
+        // Skip the channels which have been written in this cycle
+        for (channelId = mapIndex * 32, staleMap = ~aTxFreshMap_l[mapIndex];
+             (staleMap != 0) && (channelId < pImageInfo->channelCount);
+             channelId++, staleMap >>= 1)
+        {
+            if ((staleMap & 1) == 0)
+                continue;
+
+            offset = pPdoMem_l->txChannelInfo[channelId].channelOffset - pImageInfo->sectionOffset;
+            if (channelId + 1 < pImageInfo->channelCount)
+                nextOffset = pPdoMem_l->txChannelInfo[channelId + 1].channelOffset - pImageInfo->sectionOffset;
+            else
+                nextOffset = pImageInfo->sectionSize;
+
+            OPLK_DCACHE_INVALIDATE(pSrcImage_p + offset, nextOffset - offset);
+            OPLK_MEMCPY(pDstImage_p + offset, pSrcImage_p + offset, nextOffset - offset);
+        }
+    }
+}
+
 /// \}
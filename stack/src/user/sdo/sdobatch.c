@@ -0,0 +1,1105 @@
+/**
+********************************************************************************
+\file   sdobatch.c
+
+\brief  Implementation of SDO batch module
+
+This file contains the implementation of the SDO batch module. It executes
+batches of object accesses to many remote nodes over a limited number of SDO
+client connections and reports the results through a completion queue.
+
+\ingroup module_sdobatch
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+/**
+********************************************************************************
+
+\defgroup   module_sdobatch    SDO batch module
+\ingroup    group_libapi
+
+The SDO batch module executes a large number of SDO read and write accesses
+without involving the application in every single transfer.
+
+The submitted requests are queued per node. Up to CONFIG_SDO_BATCH_MAX_CHANNELS
+nodes are served in parallel, each over its own SDO command layer connection.
+Consecutive requests to the same node with the same access type are aggregated
+into a Read/Write Multiple Parameter by Index transfer if the node announces
+this feature in its IdentResponse. The connection of a node is released as soon
+as all of its requests are done.
+
+The result of every request is stored in a completion queue, which is polled by
+the application with sdobatch_poll(). A request occupies its entry until its
+completion has been polled.
+
+*******************************************************************************/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <common/ami.h>
+#include <common/target.h>
+#include <user/sdobatch.h>
+#include <user/sdocomint.h>
+#include <user/obdu.h>
+#include <oplk/sdoabortcodes.h>
+
+#if defined(CONFIG_INCLUDE_NMT_MN)
+#include <user/identu.h>
+#endif
+
+#if defined(CONFIG_INCLUDE_CFM)
+#include <user/cfmu.h>
+#endif
+
+#if defined(CONFIG_INCLUDE_SDOC)
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define SDOBATCH_INVALID_ENTRY      CONFIG_SDO_BATCH_MAX_REQUESTS   // Marks the end of an entry list
+#define SDOBATCH_NODE_COUNT         C_ADR_BROADCAST                 // Size of the node table (node IDs 1 - 254)
+#define SDOBATCH_MULTI_BUFFER_SIZE  SDO_CMD_SEGM_TX_MAX_SIZE        // Size of the frame buffer for multiple object transfers
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+/**
+\brief SDO batch entry
+
+The structure describes a submitted request and its result.
+*/
+typedef struct
+{
+    tOplkApiSdoBatchRequest request;            ///< Request of the application
+    tOplkError              error;              ///< Local error
+    tSdoComConState         sdoComConState;     ///< Final state of the transfer
+    UINT32                  abortCode;          ///< SDO abort code
+    size_t                  transferredBytes;   ///< Number of transferred bytes
+    BOOL                    fSubAborted;        ///< The object access of a multiple transfer was aborted
+    UINT                    next;               ///< Next entry in the list
+} tSdoBatchEntry;
+
+/**
+\brief SDO batch entry list
+
+The structure describes a singly linked list of entries.
+*/
+typedef struct
+{
+    UINT                    first;              ///< First entry of the list
+    UINT                    last;               ///< Last entry of the list
+    UINT                    count;              ///< Number of entries in the list
+} tSdoBatchList;
+
+/**
+\brief SDO batch channel
+
+The structure describes an SDO connection which is used to process the requests
+of one node.
+*/
+typedef struct
+{
+    UINT                    nodeId;             ///< Node served by the channel, 0 if the channel is free
+    tSdoComConHdl           sdoComConHdl;       ///< SDO command layer connection
+    BOOL                    fConDefined;        ///< The SDO connection is defined
+    tSdoType                conSdoType;         ///< SDO type of the defined connection
+    UINT                    transferId;         ///< Counter of prepared transfers
+    UINT                    entryCount;         ///< Number of entries in the current transfer
+    UINT                    aEntry[CONFIG_SDO_BATCH_MAX_MULTI_ACCESS];          ///< Entries of the current transfer
+    tSdoMultiAccEntry       aMultiAcc[CONFIG_SDO_BATCH_MAX_MULTI_ACCESS];       ///< Object accesses of a multiple transfer
+    UINT8                   aMultiBuffer[SDOBATCH_MULTI_BUFFER_SIZE];           ///< Frame buffer of a multiple transfer
+} tSdoBatchChannel;
+
+/**
+\brief SDO batch instance
+
+The structure contains all necessary information of the SDO batch module.
+*/
+typedef struct
+{
+    tSdoBatchEntry          aEntry[CONFIG_SDO_BATCH_MAX_REQUESTS];      ///< Request entries
+    tSdoBatchList           freeList;                                   ///< Free entries
+    tSdoBatchList           aNodeList[SDOBATCH_NODE_COUNT];             ///< Pending entries per node
+    tSdoBatchList           completionList;                             ///< Completed entries
+    tSdoBatchChannel        aChannel[CONFIG_SDO_BATCH_MAX_CHANNELS];    ///< SDO channels
+    UINT                    nextNodeId;                                 ///< Node which is served next
+    OPLK_MUTEX_T            mutex;                                      ///< Mutex protecting the instance
+    BOOL                    fInitialized;                               ///< Module is initialized
+} tSdoBatchInstance;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tSdoBatchInstance    sdoBatchInstance_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static void              listInit(tSdoBatchList* pList_p);
+static void              listAppend(tSdoBatchList* pList_p, UINT entry_p);
+static void              listPrepend(tSdoBatchList* pList_p, UINT entry_p);
+static UINT              listRemoveFirst(tSdoBatchList* pList_p);
+static void              scheduleTransfers(void);
+static tSdoBatchChannel* assignChannel(void);
+static BOOL              isNodeServed(UINT nodeId_p);
+static BOOL              prepareTransfer(tSdoBatchChannel* pChannel_p);
+static void              runChannel(tSdoBatchChannel* pChannel_p);
+static tOplkError        startTransfer(tSdoBatchChannel* pChannel_p);
+static void              releaseChannel(tSdoBatchChannel* pChannel_p);
+static void              completeTransfer(tSdoBatchChannel* pChannel_p,
+                                          const tSdoComFinished* pSdoComFinished_p);
+static void              completeEntries(tSdoBatchChannel* pChannel_p,
+                                         tOplkError error_p);
+static void              requeueEntries(tSdoBatchChannel* pChannel_p,
+                                        UINT firstEntry_p);
+static BOOL              isMultiSupported(UINT nodeId_p);
+static size_t            getMultiEntrySize(const tSdoBatchEntry* pEntry_p);
+static tOplkError        cbSdoFinished(const tSdoComFinished* pSdoComFinished_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize SDO batch module
+
+The function initializes the SDO batch module.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sdobatch
+*/
+//------------------------------------------------------------------------------
+tOplkError sdobatch_init(void)
+{
+    UINT    i;
+
+    OPLK_MEMSET(&sdoBatchInstance_l, 0, sizeof(tSdoBatchInstance));
+
+    listInit(&sdoBatchInstance_l.freeList);
+    listInit(&sdoBatchInstance_l.completionList);
+    for (i = 0; i < SDOBATCH_NODE_COUNT; i++)
+        listInit(&sdoBatchInstance_l.aNodeList[i]);
+
+    for (i = 0; i < CONFIG_SDO_BATCH_MAX_REQUESTS; i++)
+        listAppend(&sdoBatchInstance_l.freeList, i);
+
+    sdoBatchInstance_l.nextNodeId = 1;
+
+    if (target_createMutex("/sdoBatchMutex", &sdoBatchInstance_l.mutex) != kErrorOk)
+        return kErrorNoResource;
+
+    sdoBatchInstance_l.fInitialized = TRUE;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down SDO batch module
+
+The function shuts down the SDO batch module. The SDO connections which are
+still used by the module are released. Pending requests are discarded.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sdobatch
+*/
+//------------------------------------------------------------------------------
+tOplkError sdobatch_exit(void)
+{
+    tSdoBatchChannel*   pChannel;
+    UINT                i;
+
+    if (!sdoBatchInstance_l.fInitialized)
+        return kErrorOk;
+
+    sdoBatchInstance_l.fInitialized = FALSE;
+
+    for (i = 0; i < CONFIG_SDO_BATCH_MAX_CHANNELS; i++)
+    {
+        pChannel = &sdoBatchInstance_l.aChannel[i];
+
+        target_lockMutex(sdoBatchInstance_l.mutex);
+        // ignore the callback of the released connection
+        pChannel->entryCount = 0;
+        target_unlockMutex(sdoBatchInstance_l.mutex);
+
+        releaseChannel(pChannel);
+    }
+
+    target_destroyMutex(sdoBatchInstance_l.mutex);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Submit SDO batch requests
+
+The function queues the given requests and starts the transfers. Either all or
+none of the requests are queued. The requests to one node are processed in the
+order of submission.
+
+\param[in]      paRequest_p         Pointer to the array of requests.
+\param[in]      requestCount_p      Number of requests.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    The requests are queued.
+\retval kErrorApiInvalidParam       A request is invalid.
+\retval kErrorNoResource            Not enough free entries to queue the requests.
+
+\ingroup module_sdobatch
+*/
+//------------------------------------------------------------------------------
+tOplkError sdobatch_submit(const tOplkApiSdoBatchRequest* paRequest_p,
+                           UINT requestCount_p)
+{
+    const tOplkApiSdoBatchRequest*  pRequest;
+    tSdoBatchEntry*                 pEntry;
+    UINT                            entry;
+    UINT                            i;
+
+    if (!sdoBatchInstance_l.fInitialized)
+        return kErrorApiNotInitialized;
+
+    if ((paRequest_p == NULL) || (requestCount_p == 0))
+        return kErrorApiInvalidParam;
+
+    for (i = 0, pRequest = paRequest_p; i < requestCount_p; i++, pRequest++)
+    {
+        if ((pRequest->nodeId == C_ADR_INVALID) ||
+            (pRequest->nodeId >= SDOBATCH_NODE_COUNT) ||
+            (pRequest->nodeId == obdu_getNodeId()) ||
+            (pRequest->index == 0) ||
+            (pRequest->pData_le == NULL) ||
+            (pRequest->dataSize == 0) ||
+            ((pRequest->accessType != kSdoAccessTypeRead) &&
+             (pRequest->accessType != kSdoAccessTypeWrite)))
+            return kErrorApiInvalidParam;
+    }
+
+    target_lockMutex(sdoBatchInstance_l.mutex);
+
+    if (sdoBatchInstance_l.freeList.count < requestCount_p)
+    {
+        target_unlockMutex(sdoBatchInstance_l.mutex);
+        return kErrorNoResource;
+    }
+
+    for (i = 0, pRequest = paRequest_p; i < requestCount_p; i++, pRequest++)
+    {
+        entry = listRemoveFirst(&sdoBatchInstance_l.freeList);
+        pEntry = &sdoBatchInstance_l.aEntry[entry];
+
+        pEntry->request = *pRequest;
+        pEntry->error = kErrorOk;
+        pEntry->sdoComConState = kSdoComTransferNotActive;
+        pEntry->abortCode = 0;
+        pEntry->transferredBytes = 0;
+        pEntry->fSubAborted = FALSE;
+
+        listAppend(&sdoBatchInstance_l.aNodeList[pRequest->nodeId], entry);
+    }
+
+    target_unlockMutex(sdoBatchInstance_l.mutex);
+
+    scheduleTransfers();
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Poll SDO batch completions
+
+The function copies the completions of finished requests in the order of their
+completion and releases the entries of these requests. Requests which could
+not be started before, e.g. because all SDO connections were in use, are
+retried.
+
+\param[out]     paCompletion_p      Pointer to the array to store the completions.
+\param[in]      maxCount_p          Number of elements of the completion array.
+\param[out]     pCompletionCount_p  Pointer to store the number of completions.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sdobatch
+*/
+//------------------------------------------------------------------------------
+tOplkError sdobatch_poll(tOplkApiSdoBatchCompletion* paCompletion_p,
+                         UINT maxCount_p,
+                         UINT* pCompletionCount_p)
+{
+    tOplkApiSdoBatchCompletion* pCompletion = paCompletion_p;
+    const tSdoBatchEntry*       pEntry;
+    UINT                        entry;
+    UINT                        count = 0;
+
+    if (!sdoBatchInstance_l.fInitialized)
+        return kErrorApiNotInitialized;
+
+    if ((paCompletion_p == NULL) || (pCompletionCount_p == NULL))
+        return kErrorApiInvalidParam;
+
+    scheduleTransfers();
+
+    target_lockMutex(sdoBatchInstance_l.mutex);
+
+    while ((count < maxCount_p) && (sdoBatchInstance_l.completionList.count > 0))
+    {
+        entry = listRemoveFirst(&sdoBatchInstance_l.completionList);
+        pEntry = &sdoBatchInstance_l.aEntry[entry];
+
+        pCompletion->nodeId = pEntry->request.nodeId;
+        pCompletion->index = pEntry->request.index;
+        pCompletion->subIndex = pEntry->request.subIndex;
+        pCompletion->accessType = pEntry->request.accessType;
+        pCompletion->error = pEntry->error;
+        pCompletion->sdoComConState = pEntry->sdoComConState;
+        pCompletion->abortCode = pEntry->abortCode;
+        pCompletion->transferredBytes = pEntry->transferredBytes;
+        pCompletion->pUserArg = pEntry->request.pUserArg;
+
+        listAppend(&sdoBatchInstance_l.freeList, entry);
+        pCompletion++;
+        count++;
+    }
+
+    target_unlockMutex(sdoBatchInstance_l.mutex);
+
+    *pCompletionCount_p = count;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Cancel SDO batch requests
+
+The function cancels all submitted requests. Requests which have not been
+started yet are completed with the abort code
+SDO_AC_DATA_NOT_TRANSF_DUE_LOCAL_CONTROL, running transfers are aborted.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sdobatch
+*/
+//------------------------------------------------------------------------------
+tOplkError sdobatch_cancel(void)
+{
+    tSdoComConHdl   aSdoComConHdl[CONFIG_SDO_BATCH_MAX_CHANNELS];
+    tSdoBatchEntry* pEntry;
+    UINT            abortCount = 0;
+    UINT            entry;
+    UINT            i;
+
+    if (!sdoBatchInstance_l.fInitialized)
+        return kErrorApiNotInitialized;
+
+    target_lockMutex(sdoBatchInstance_l.mutex);
+
+    for (i = 0; i < SDOBATCH_NODE_COUNT; i++)
+    {
+        while (sdoBatchInstance_l.aNodeList[i].count > 0)
+        {
+            entry = listRemoveFirst(&sdoBatchInstance_l.aNodeList[i]);
+            pEntry = &sdoBatchInstance_l.aEntry[entry];
+            pEntry->sdoComConState = kSdoComTransferTxAborted;
+            pEntry->abortCode = SDO_AC_DATA_NOT_TRANSF_DUE_LOCAL_CONTROL;
+            listAppend(&sdoBatchInstance_l.completionList, entry);
+        }
+    }
+
+    for (i = 0; i < CONFIG_SDO_BATCH_MAX_CHANNELS; i++)
+    {
+        if (sdoBatchInstance_l.aChannel[i].entryCount > 0)
+            aSdoComConHdl[abortCount++] = sdoBatchInstance_l.aChannel[i].sdoComConHdl;
+    }
+
+    target_unlockMutex(sdoBatchInstance_l.mutex);
+
+    // the aborted transfers are completed by the finished callback
+    for (i = 0; i < abortCount; i++)
+        sdocom_abortTransfer(aSdoComConHdl[i], SDO_AC_DATA_NOT_TRANSF_DUE_LOCAL_CONTROL);
+
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize an entry list
+
+\param[out]     pList_p             Pointer to the list.
+*/
+//------------------------------------------------------------------------------
+static void listInit(tSdoBatchList* pList_p)
+{
+    pList_p->first = SDOBATCH_INVALID_ENTRY;
+    pList_p->last = SDOBATCH_INVALID_ENTRY;
+    pList_p->count = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Append an entry to a list
+
+\param[in,out]  pList_p             Pointer to the list.
+\param[in]      entry_p             Entry to append.
+*/
+//------------------------------------------------------------------------------
+static void listAppend(tSdoBatchList* pList_p, UINT entry_p)
+{
+    sdoBatchInstance_l.aEntry[entry_p].next = SDOBATCH_INVALID_ENTRY;
+
+    if (pList_p->count == 0)
+        pList_p->first = entry_p;
+    else
+        sdoBatchInstance_l.aEntry[pList_p->last].next = entry_p;
+
+    pList_p->last = entry_p;
+    pList_p->count++;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Insert an entry at the beginning of a list
+
+\param[in,out]  pList_p             Pointer to the list.
+\param[in]      entry_p             Entry to insert.
+*/
+//------------------------------------------------------------------------------
+static void listPrepend(tSdoBatchList* pList_p, UINT entry_p)
+{
+    sdoBatchInstance_l.aEntry[entry_p].next = pList_p->first;
+
+    if (pList_p->count == 0)
+        pList_p->last = entry_p;
+
+    pList_p->first = entry_p;
+    pList_p->count++;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Remove the first entry of a list
+
+\param[in,out]  pList_p             Pointer to the list. The list must not be empty.
+
+\return The function returns the removed entry.
+*/
+//------------------------------------------------------------------------------
+static UINT listRemoveFirst(tSdoBatchList* pList_p)
+{
+    UINT    entry = pList_p->first;
+
+    pList_p->first = sdoBatchInstance_l.aEntry[entry].next;
+    pList_p->count--;
+    if (pList_p->count == 0)
+        pList_p->last = SDOBATCH_INVALID_ENTRY;
+
+    return entry;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start transfers on the free channels
+
+The function assigns the free channels to nodes with pending requests and
+starts their transfers. Each node is tried at most once per call.
+*/
+//------------------------------------------------------------------------------
+static void scheduleTransfers(void)
+{
+    tSdoBatchChannel*   pChannel;
+    UINT                attempt;
+
+    for (attempt = 0; attempt < SDOBATCH_NODE_COUNT; attempt++)
+    {
+        target_lockMutex(sdoBatchInstance_l.mutex);
+        pChannel = assignChannel();
+        target_unlockMutex(sdoBatchInstance_l.mutex);
+
+        if (pChannel == NULL)
+            break;
+
+        runChannel(pChannel);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Assign a free channel to a node
+
+The function searches a free channel and the next node with pending requests
+which is not served yet, beginning with the node after the last assigned one.
+The first transfer of the node is prepared. The caller must hold the mutex.
+
+\return The function returns the assigned channel or NULL if no channel could
+        be assigned.
+*/
+//------------------------------------------------------------------------------
+static tSdoBatchChannel* assignChannel(void)
+{
+    tSdoBatchChannel*   pChannel = NULL;
+    UINT                nodeId;
+    UINT                i;
+
+    for (i = 0; i < CONFIG_SDO_BATCH_MAX_CHANNELS; i++)
+    {
+        if (sdoBatchInstance_l.aChannel[i].nodeId == C_ADR_INVALID)
+        {
+            pChannel = &sdoBatchInstance_l.aChannel[i];
+            break;
+        }
+    }
+
+    if (pChannel == NULL)
+        return NULL;
+
+    nodeId = sdoBatchInstance_l.nextNodeId;
+    for (i = 1; i < SDOBATCH_NODE_COUNT; i++)
+    {
+        if ((sdoBatchInstance_l.aNodeList[nodeId].count > 0) && !isNodeServed(nodeId))
+        {
+            sdoBatchInstance_l.nextNodeId = (nodeId % (SDOBATCH_NODE_COUNT - 1)) + 1;
+            pChannel->nodeId = nodeId;
+            prepareTransfer(pChannel);
+            return pChannel;
+        }
+
+        nodeId = (nodeId % (SDOBATCH_NODE_COUNT - 1)) + 1;
+    }
+
+    return NULL;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if the SDO connection to a node is in use
+
+The function checks if a channel is assigned to the node or if the
+configuration manager uses the SDO connection to the node. The caller must hold
+the mutex.
+
+\param[in]      nodeId_p            Node ID to check.
+
+\return The function returns TRUE if the SDO connection to the node is in use.
+*/
+//------------------------------------------------------------------------------
+static BOOL isNodeServed(UINT nodeId_p)
+{
+    UINT    i;
+
+    for (i = 0; i < CONFIG_SDO_BATCH_MAX_CHANNELS; i++)
+    {
+        if (sdoBatchInstance_l.aChannel[i].nodeId == nodeId_p)
+            return TRUE;
+    }
+
+#if defined(CONFIG_INCLUDE_CFM)
+    if (cfmu_isSdoRunning(nodeId_p))
+        return TRUE;
+#endif
+
+    return FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Prepare the next transfer of a channel
+
+The function takes the next requests of the node from its list. Consecutive
+requests with the same access and SDO type are aggregated into one transfer,
+if the node supports Read/Write Multiple Parameter by Index and the objects fit
+into one command layer segment. The caller must hold the mutex.
+
+\param[in,out]  pChannel_p          Pointer to the channel.
+
+\return The function returns TRUE if a transfer was prepared and FALSE if the
+        node has no pending requests.
+*/
+//------------------------------------------------------------------------------
+static BOOL prepareTransfer(tSdoBatchChannel* pChannel_p)
+{
+    tSdoBatchList*          pNodeList = &sdoBatchInstance_l.aNodeList[pChannel_p->nodeId];
+    const tSdoBatchEntry*   pFirst;
+    const tSdoBatchEntry*   pNext;
+    size_t                  multiSize;
+    UINT                    i;
+
+    pChannel_p->entryCount = 0;
+    if (pNodeList->count == 0)
+        return FALSE;
+
+    pChannel_p->transferId++;
+    pChannel_p->aEntry[pChannel_p->entryCount++] = listRemoveFirst(pNodeList);
+
+    if (!isMultiSupported(pChannel_p->nodeId))
+        return TRUE;
+
+    pFirst = &sdoBatchInstance_l.aEntry[pChannel_p->aEntry[0]];
+    multiSize = getMultiEntrySize(pFirst);
+
+    while ((pChannel_p->entryCount < CONFIG_SDO_BATCH_MAX_MULTI_ACCESS) &&
+           (pNodeList->count > 0))
+    {
+        pNext = &sdoBatchInstance_l.aEntry[pNodeList->first];
+        if ((pNext->request.accessType != pFirst->request.accessType) ||
+            (pNext->request.sdoType != pFirst->request.sdoType))
+            break;
+
+        multiSize += getMultiEntrySize(pNext);
+        if (multiSize > SDOBATCH_MULTI_BUFFER_SIZE)
+            break;
+
+        // the responses are assigned by index and sub-index
+        for (i = 0; i < pChannel_p->entryCount; i++)
+        {
+            const tSdoBatchEntry* pEntry = &sdoBatchInstance_l.aEntry[pChannel_p->aEntry[i]];
+
+            if ((pEntry->request.index == pNext->request.index) &&
+                (pEntry->request.subIndex == pNext->request.subIndex))
+                break;
+        }
+        if (i < pChannel_p->entryCount)
+            break;
+
+        pChannel_p->aEntry[pChannel_p->entryCount++] = listRemoveFirst(pNodeList);
+    }
+
+    return TRUE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run the transfers of a channel
+
+The function starts the prepared transfer of a channel. If the transfer can't
+be started, its requests are completed with the error and the next transfer of
+the node is started. If the node has no more pending requests, the channel is
+released.
+
+\param[in,out]  pChannel_p          Pointer to the channel.
+*/
+//------------------------------------------------------------------------------
+static void runChannel(tSdoBatchChannel* pChannel_p)
+{
+    tOplkError  ret;
+    UINT        transferId;
+    BOOL        fNext;
+
+    for (;;)
+    {
+        transferId = pChannel_p->transferId;
+
+        ret = startTransfer(pChannel_p);
+        if (ret == kErrorOk)
+            return;
+
+        target_lockMutex(sdoBatchInstance_l.mutex);
+
+        if ((pChannel_p->transferId != transferId) || (pChannel_p->entryCount == 0))
+        {   // transfer has already been completed by the finished callback
+            target_unlockMutex(sdoBatchInstance_l.mutex);
+            return;
+        }
+
+        if ((ret == kErrorSdoComNoFreeHandle) ||
+            (ret == kErrorSdoComHandleExists) ||
+            (ret == kErrorSdoComHandleBusy))
+        {   // no SDO connection available at the moment -> retry later
+            requeueEntries(pChannel_p, 0);
+            fNext = FALSE;
+        }
+        else
+        {
+            completeEntries(pChannel_p, ret);
+            fNext = prepareTransfer(pChannel_p);
+        }
+
+        target_unlockMutex(sdoBatchInstance_l.mutex);
+
+        if (!fNext)
+        {
+            releaseChannel(pChannel_p);
+            return;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Start the prepared transfer of a channel
+
+The function defines the SDO connection to the node, if necessary, and starts
+the transfer.
+
+\param[in,out]  pChannel_p          Pointer to the channel.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError startTransfer(tSdoBatchChannel* pChannel_p)
+{
+    tOplkError                  ret;
+    tSdoComTransParamByIndex    transParam;
+    tSdoBatchEntry*             pEntry;
+    tSdoType                    sdoType;
+    UINT                        i;
+
+    pEntry = &sdoBatchInstance_l.aEntry[pChannel_p->aEntry[0]];
+    sdoType = pEntry->request.sdoType;
+
+    if (pChannel_p->fConDefined && (pChannel_p->conSdoType != sdoType))
+    {
+        sdocom_undefineConnection(pChannel_p->sdoComConHdl);
+        pChannel_p->fConDefined = FALSE;
+    }
+
+    if (!pChannel_p->fConDefined)
+    {
+        ret = sdocom_defineConnection(&pChannel_p->sdoComConHdl,
+                                      pChannel_p->nodeId,
+                                      sdoType);
+        if (ret != kErrorOk)
+        {   // an existing connection to the node is owned by the application
+            return ret;
+        }
+
+        pChannel_p->fConDefined = TRUE;
+        pChannel_p->conSdoType = sdoType;
+    }
+
+    OPLK_MEMSET(&transParam, 0, sizeof(tSdoComTransParamByIndex));
+    transParam.sdoComConHdl = pChannel_p->sdoComConHdl;
+    transParam.index = (UINT16)pEntry->request.index;
+    transParam.subindex = (UINT8)pEntry->request.subIndex;
+    transParam.pData = pEntry->request.pData_le;
+    transParam.dataSize = pEntry->request.dataSize;
+    transParam.sdoAccessType = pEntry->request.accessType;
+    transParam.pfnSdoFinishedCb = cbSdoFinished;
+    transParam.pUserArg = pChannel_p;
+
+    if (pChannel_p->entryCount > 1)
+    {
+        for (i = 0; i < pChannel_p->entryCount; i++)
+        {
+            pEntry = &sdoBatchInstance_l.aEntry[pChannel_p->aEntry[i]];
+            pChannel_p->aMultiAcc[i].index = pEntry->request.index;
+            pChannel_p->aMultiAcc[i].subIndex = pEntry->request.subIndex;
+            pChannel_p->aMultiAcc[i].pData_le = pEntry->request.pData_le;
+            pChannel_p->aMultiAcc[i].dataSize = pEntry->request.dataSize;
+        }
+
+        transParam.sdoAccessType = (transParam.sdoAccessType == kSdoAccessTypeRead) ?
+                                   kSdoAccessTypeMultiRead : kSdoAccessTypeMultiWrite;
+        transParam.paMultiAcc = pChannel_p->aMultiAcc;
+        transParam.multiAccCnt = pChannel_p->entryCount;
+        transParam.pMultiBuffer = pChannel_p->aMultiBuffer;
+        transParam.multiBufSize = sizeof(pChannel_p->aMultiBuffer);
+    }
+
+    return sdocom_initTransferByIndex(&transParam);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release a channel
+
+The function releases the SDO connection of the channel and frees the channel.
+
+\param[in,out]  pChannel_p          Pointer to the channel.
+*/
+//------------------------------------------------------------------------------
+static void releaseChannel(tSdoBatchChannel* pChannel_p)
+{
+    if (pChannel_p->fConDefined)
+    {
+        pChannel_p->fConDefined = FALSE;
+        sdocom_undefineConnection(pChannel_p->sdoComConHdl);
+    }
+
+    target_lockMutex(sdoBatchInstance_l.mutex);
+    pChannel_p->nodeId = C_ADR_INVALID;
+    target_unlockMutex(sdoBatchInstance_l.mutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Complete the transfer of a channel
+
+The function stores the result of a finished transfer in its requests and moves
+them to the completion queue. Objects of a Write Multiple transfer which did not
+fit into the transfer are queued again. The caller must hold the mutex.
+
+\param[in,out]  pChannel_p          Pointer to the channel.
+\param[in]      pSdoComFinished_p   Result of the transfer.
+*/
+//------------------------------------------------------------------------------
+static void completeTransfer(tSdoBatchChannel* pChannel_p,
+                             const tSdoComFinished* pSdoComFinished_p)
+{
+    tSdoBatchEntry* pEntry;
+    UINT            transferCount = pChannel_p->entryCount;
+    UINT            i;
+
+    if ((pSdoComFinished_p->sdoAccessType == kSdoAccessTypeMultiWrite) &&
+        (pSdoComFinished_p->sdoComConState == kSdoComTransferFinished) &&
+        (pSdoComFinished_p->multiSubAccCnt > 0) &&
+        (pSdoComFinished_p->multiSubAccCnt < transferCount))
+    {
+        transferCount = pSdoComFinished_p->multiSubAccCnt;
+        requeueEntries(pChannel_p, transferCount);
+    }
+
+    for (i = 0; i < transferCount; i++)
+    {
+        pEntry = &sdoBatchInstance_l.aEntry[pChannel_p->aEntry[i]];
+
+        if (pEntry->fSubAborted)
+        {   // sub-abort code has already been stored
+            pEntry->sdoComConState = kSdoComTransferRxAborted;
+        }
+        else
+        {
+            pEntry->sdoComConState = pSdoComFinished_p->sdoComConState;
+            pEntry->abortCode = pSdoComFinished_p->abortCode;
+
+            if (pSdoComFinished_p->sdoComConState != kSdoComTransferFinished)
+                pEntry->transferredBytes = 0;
+            else if (transferCount == 1)
+                pEntry->transferredBytes = pSdoComFinished_p->transferredBytes;
+            else if (pEntry->request.accessType == kSdoAccessTypeRead)
+                pEntry->transferredBytes = pChannel_p->aMultiAcc[i].dataSize;
+            else
+                pEntry->transferredBytes = pEntry->request.dataSize;
+        }
+
+        listAppend(&sdoBatchInstance_l.completionList, pChannel_p->aEntry[i]);
+    }
+
+    pChannel_p->entryCount = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Complete the requests of a channel with a local error
+
+The caller must hold the mutex.
+
+\param[in,out]  pChannel_p          Pointer to the channel.
+\param[in]      error_p             Error which prevented the transfer.
+*/
+//------------------------------------------------------------------------------
+static void completeEntries(tSdoBatchChannel* pChannel_p,
+                            tOplkError error_p)
+{
+    tSdoBatchEntry* pEntry;
+    UINT            i;
+
+    for (i = 0; i < pChannel_p->entryCount; i++)
+    {
+        pEntry = &sdoBatchInstance_l.aEntry[pChannel_p->aEntry[i]];
+        pEntry->error = error_p;
+        pEntry->sdoComConState = kSdoComTransferNotActive;
+        listAppend(&sdoBatchInstance_l.completionList, pChannel_p->aEntry[i]);
+    }
+
+    pChannel_p->entryCount = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Queue the requests of a channel again
+
+The function puts the requests of the current transfer beginning with the
+given one back to the front of the node list, so that the order is preserved.
+The caller must hold the mutex.
+
+\param[in,out]  pChannel_p          Pointer to the channel.
+\param[in]      firstEntry_p        Position of the first request to queue again.
+*/
+//------------------------------------------------------------------------------
+static void requeueEntries(tSdoBatchChannel* pChannel_p,
+                           UINT firstEntry_p)
+{
+    UINT    i;
+
+    for (i = pChannel_p->entryCount; i > firstEntry_p; i--)
+    {
+        sdoBatchInstance_l.aEntry[pChannel_p->aEntry[i - 1]].fSubAborted = FALSE;
+        listPrepend(&sdoBatchInstance_l.aNodeList[pChannel_p->nodeId],
+                    pChannel_p->aEntry[i - 1]);
+    }
+
+    pChannel_p->entryCount = firstEntry_p;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check if a node supports multiple object transfers
+
+The function checks the feature flags of the last IdentResponse of the node.
+
+\param[in]      nodeId_p            Node ID to check.
+
+\return The function returns TRUE if the node supports Read/Write Multiple
+        Parameter by Index.
+*/
+//------------------------------------------------------------------------------
+static BOOL isMultiSupported(UINT nodeId_p)
+{
+#if defined(CONFIG_INCLUDE_NMT_MN)
+    const tIdentResponse*   pIdentResponse = NULL;
+
+    if ((identu_getIdentResponse(nodeId_p, &pIdentResponse) != kErrorOk) ||
+        (pIdentResponse == NULL))
+        return FALSE;
+
+    return ((ami_getUint32Le(&pIdentResponse->featureFlagsLe) & NMT_FEATUREFLAGS_SDO_RW_MULTIPLE) != 0);
+#else
+    UNUSED_PARAMETER(nodeId_p);
+
+    return FALSE;
+#endif
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the size of an object in a multiple object transfer
+
+The function returns the size which is occupied by the object in the command
+layer segment of a Write Multiple request or a Read Multiple response.
+
+\param[in]      pEntry_p            Pointer to the entry.
+
+\return The function returns the size in bytes.
+*/
+//------------------------------------------------------------------------------
+static size_t getMultiEntrySize(const tSdoBatchEntry* pEntry_p)
+{
+    size_t  padBytes = (~pEntry_p->request.dataSize + 1U) & 0x03;
+
+    return SDO_CMDL_HDR_WRITEMULTBYINDEX_SIZE + pEntry_p->request.dataSize + padBytes;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  SDO finished callback
+
+The function is called by the SDO command layer when a transfer of a channel
+has finished. It completes the requests of the transfer and continues with the
+next requests of the node.
+
+\param[in]      pSdoComFinished_p   Pointer to the result of the transfer.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError cbSdoFinished(const tSdoComFinished* pSdoComFinished_p)
+{
+    tSdoBatchChannel*   pChannel = (tSdoBatchChannel*)pSdoComFinished_p->pUserArg;
+    tSdoBatchEntry*     pEntry;
+    BOOL                fNext;
+    UINT                i;
+
+    target_lockMutex(sdoBatchInstance_l.mutex);
+
+    if ((pChannel->nodeId == C_ADR_INVALID) || (pChannel->entryCount == 0))
+    {   // transfer is not owned by the module anymore
+        target_unlockMutex(sdoBatchInstance_l.mutex);
+        return kErrorOk;
+    }
+
+    if (pSdoComFinished_p->sdoComConState == kSdoComTransferRxSubAborted)
+    {   // abort of a single object of a multiple transfer, the transfer continues
+        for (i = 0; i < pChannel->entryCount; i++)
+        {
+            pEntry = &sdoBatchInstance_l.aEntry[pChannel->aEntry[i]];
+            if ((pEntry->request.index == pSdoComFinished_p->targetIndex) &&
+                (pEntry->request.subIndex == pSdoComFinished_p->targetSubIndex))
+            {
+                pEntry->fSubAborted = TRUE;
+                pEntry->abortCode = pSdoComFinished_p->abortCode;
+                break;
+            }
+        }
+
+        target_unlockMutex(sdoBatchInstance_l.mutex);
+        return kErrorOk;
+    }
+
+    completeTransfer(pChannel, pSdoComFinished_p);
+    fNext = prepareTransfer(pChannel);
+
+    target_unlockMutex(sdoBatchInstance_l.mutex);
+
+    if (fNext)
+        runChannel(pChannel);
+    else
+        releaseChannel(pChannel);
+
+    scheduleTransfers();
+
+    return kErrorOk;
+}
+
+/// \}
+
+#endif /* defined(CONFIG_INCLUDE_SDOC) */
@@ -1458,15 +1458,18 @@ The function starts an SDO transfer and sends all further frames.
 static tOplkError sendSdo(tSdoComCon* pSdoComCon_p)
 {
     tOplkError      ret = kErrorOk;
-    UINT8           aFrame[SDO_MAX_TX_FRAME_SIZE];
     tPlkFrame*      pFrame;
     tAsySdoCom*     pCommandFrame;
     size_t          sizeOfCmdFrame;
     size_t          sizeOfCmdData;
     UINT8*          pPayload;
 
-    pFrame = (tPlkFrame*)&aFrame[0];
-    sdocomint_initCmdFrameGeneric(pFrame, sizeof(aFrame), pSdoComCon_p, &pCommandFrame);
+    // the frame is filled in place and passed to the sequence layer
+    pFrame = sdoseq_allocTxFrame();
+    if (pFrame == NULL)
+        return kErrorSdoSeqNoFreeHistory;
+
+    sdocomint_initCmdFrameGeneric(pFrame, SDO_MAX_TX_FRAME_SIZE, pSdoComCon_p, &pCommandFrame);
 
     // check if first frame to send -> command header needed
     if (pSdoComCon_p->transferSize > 0)
@@ -1530,7 +1533,8 @@ static tOplkError sendSdo(tSdoComCon* pSdoComCon_p)
                     {   // segmented transfer -> variable part of header needed
                         // -> not supported!
                         sdocomint_updateHdlTransfSize(pSdoComCon_p, 0, TRUE);
-                        return kErrorSdoComInvalidParam;
+                        ret = kErrorSdoComInvalidParam;
+                        goto Exit;
                     }
                     else
                     {   // expedited transfer
@@ -1545,7 +1549,8 @@ static tOplkError sendSdo(tSdoComCon* pSdoComCon_p)
                 case kSdoServiceNIL:
                 default:
                     // invalid service requested
-                    return kErrorSdoComInvalidServiceType;
+                    ret = kErrorSdoComInvalidServiceType;
+                    goto Exit;
             }
         }
         else
@@ -1579,30 +1584,33 @@ static tOplkError sendSdo(tSdoComCon* pSdoComCon_p)
                         }
                     }
                     else
-                        return ret;
+                        goto Exit;
                     break;
 
                 // for expedited read is nothing to do -> server sends data
                 default:
-                    return ret;
+                    goto Exit;
             }
         }
     }
     else
-        return ret;
+        goto Exit;
 
     // call send function of lower layer
     switch (pSdoComCon_p->sdoProtocolType)
     {
         case kSdoTypeAsnd:
         case kSdoTypeUdp:
-            ret = sdoseq_sendData(pSdoComCon_p->sdoSeqConHdl, sizeOfCmdFrame, pFrame);
-            break;
+            // the sequence layer takes over the frame
+            return sdoseq_sendData(pSdoComCon_p->sdoSeqConHdl, sizeOfCmdFrame, pFrame);
 
         default:
-            return kErrorSdoComUnsupportedProt;
+            ret = kErrorSdoComUnsupportedProt;
+            break;
     }
 
+Exit:
+    sdoseq_freeTxFrame(pFrame);
     return ret;
 }
 
@@ -1681,14 +1689,18 @@ The function sends an abort message on an SDO client.
 static tOplkError sendSdoAbort(tSdoComCon* pSdoComCon_p, UINT32 abortCode_p)
 {
     tOplkError      ret = kErrorOk;
-    UINT8           aFrame[SDO_MAX_TX_FRAME_SIZE];
     tPlkFrame*      pFrame;
     tAsySdoCom*     pCommandFrame;
     size_t          sizeOfCmdFrame;
     size_t          sizeOfCmdData;
 
-    pFrame = (tPlkFrame*)&aFrame[0];
-    sdocomint_initCmdFrameGeneric(pFrame, sizeof(aFrame), pSdoComCon_p, &pCommandFrame);
+    pSdoComCon_p->lastAbortCode = abortCode_p;
+
+    pFrame = sdoseq_allocTxFrame();
+    if (pFrame == NULL)
+        return kErrorSdoSeqNoFreeHistory;
+
+    sdocomint_initCmdFrameGeneric(pFrame, SDO_MAX_TX_FRAME_SIZE, pSdoComCon_p, &pCommandFrame);
 
     sizeOfCmdData = sizeof(UINT32);
     // copy abort code to frame
@@ -1698,7 +1710,6 @@ static tOplkError sendSdoAbort(tSdoComCon* pSdoComCon_p, UINT32 abortCode_p)
 
     sdocomint_updateHdlTransfSize(pSdoComCon_p, sizeOfCmdData, TRUE);
     sizeOfCmdFrame = SDO_CMDL_HDR_FIXED_SIZE + sizeOfCmdData;
-    pSdoComCon_p->lastAbortCode = abortCode_p;
 
     // call send function of lower layer
     switch (pSdoComCon_p->sdoProtocolType)
@@ -1716,6 +1727,7 @@ static tOplkError sendSdoAbort(tSdoComCon* pSdoComCon_p, UINT32 abortCode_p)
             break;
 
         default:
+            sdoseq_freeTxFrame(pFrame);
             ret = kErrorSdoComUnsupportedProt;
             break;
     }
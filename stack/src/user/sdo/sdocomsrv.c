@@ -1354,13 +1354,15 @@ The function creates and sends a command layer acknowledge frame from an
 static tOplkError sendAckResponseFrame(const tSdoComCon* pSdoComCon_p)
 {
     tOplkError      ret = kErrorOk;
-    UINT8           aFrame[SDO_MAX_TX_FRAME_SIZE];
     tPlkFrame*      pFrame;
     tAsySdoCom*     pCommandFrame;
     size_t          sizeOfCmdFrame;
 
-    pFrame = (tPlkFrame*)&aFrame[0];
-    sdocomint_initCmdFrameGeneric(pFrame, sizeof(aFrame), pSdoComCon_p, &pCommandFrame);
+    pFrame = sdoseq_allocTxFrame();
+    if (pFrame == NULL)
+        return kErrorSdoSeqNoFreeHistory;
+
+    sdocomint_initCmdFrameGeneric(pFrame, SDO_MAX_TX_FRAME_SIZE, pSdoComCon_p, &pCommandFrame);
 
     sdocomint_overwriteCmdFrameHdrFlags(pCommandFrame, SDO_CMDL_FLAG_RESPONSE);
     sizeOfCmdFrame = SDO_CMDL_HDR_FIXED_SIZE;
@@ -1392,7 +1394,6 @@ static tOplkError sendResponseFrame(tSdoComCon* pSdoComCon_p,
                                     size_t sdoCmdDataSize_p)
 {
     tOplkError      ret = kErrorOk;
-    UINT8           aFrame[SDO_MAX_TX_FRAME_SIZE];
     tPlkFrame*      pFrame;
     tAsySdoCom*     pCommandFrame;
     size_t          sizeOfCmdFrame = 0;
@@ -1400,8 +1401,11 @@ static tOplkError sendResponseFrame(tSdoComCon* pSdoComCon_p,
     if (pPlkFrame_p == NULL)
     {   // only pointer to frame with little endian command layer data is provided
         // by caller -> this function will do the copy operation, and provide the buffer
-        pFrame = (tPlkFrame*)&aFrame[0];
-        sdocomint_initCmdFrameGeneric(pFrame, sizeof(aFrame), pSdoComCon_p, &pCommandFrame);
+        pFrame = sdoseq_allocTxFrame();
+        if (pFrame == NULL)
+            return kErrorSdoSeqNoFreeHistory;
+
+        sdocomint_initCmdFrameGeneric(pFrame, SDO_MAX_TX_FRAME_SIZE, pSdoComCon_p, &pCommandFrame);
     }
     else
     {   // frame with command layer data is provided by caller
@@ -1470,7 +1474,7 @@ static tOplkError sendResponseFrame(tSdoComCon* pSdoComCon_p,
             // complete
             // block sending empty frames from other transfer types than kSdoServiceWriteByIndex
             if ((pSdoComCon_p->transferSize == 0) && (pSdoComCon_p->sdoServiceType != kSdoServiceWriteByIndex))
-                return ret;
+                goto Exit;
 
             // copy data into frame, if frame not provided by caller
             if (pPlkFrame_p == NULL)
@@ -1485,9 +1489,13 @@ static tOplkError sendResponseFrame(tSdoComCon* pSdoComCon_p,
         }
     }
 
-    ret = sdoseq_sendData(pSdoComCon_p->sdoSeqConHdl, sizeOfCmdFrame, pFrame);
+    // the sequence layer takes over the frame
+    return sdoseq_sendData(pSdoComCon_p->sdoSeqConHdl, sizeOfCmdFrame, pFrame);
 
 Exit:
+    if (pPlkFrame_p == NULL)
+        sdoseq_freeTxFrame(pFrame);
+
     return ret;
 }
 
@@ -1507,14 +1515,19 @@ initial SDO server state.
 static tOplkError abortTransfer(tSdoComCon* pSdoComCon_p, UINT32 abortCode_p)
 {
     tOplkError      ret = kErrorOk;
-    UINT8           aFrame[SDO_MAX_TX_FRAME_SIZE];
     tPlkFrame*      pFrame;
     tAsySdoCom*     pCommandFrame;
     size_t          sizeOfCmdFrame;
     size_t          sizeOfCmdData;
 
-    pFrame = (tPlkFrame*)&aFrame[0];
-    sdocomint_initCmdFrameGeneric(pFrame, sizeof(aFrame), pSdoComCon_p, &pCommandFrame);
+    pFrame = sdoseq_allocTxFrame();
+    if (pFrame == NULL)
+    {
+        ret = kErrorSdoSeqNoFreeHistory;
+        goto Exit;
+    }
+
+    sdocomint_initCmdFrameGeneric(pFrame, SDO_MAX_TX_FRAME_SIZE, pSdoComCon_p, &pCommandFrame);
 
     sizeOfCmdData = sizeof(abortCode_p);
     // copy abort code to frame
@@ -1527,6 +1540,7 @@ static tOplkError abortTransfer(tSdoComCon* pSdoComCon_p, UINT32 abortCode_p)
     ret = sdoseq_sendData(pSdoComCon_p->sdoSeqConHdl, sizeOfCmdFrame, pFrame);
     DEBUG_LVL_SDO_TRACE("ERROR: SDO Aborted!\n");
 
+Exit:
     pSdoComCon_p->sdoComState = kSdoComStateIdle;
     // invalidate connection to OD, so a delayed response from OD recognizes
     // that there is no connection present
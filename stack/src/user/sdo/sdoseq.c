@@ -47,6 +47,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <user/sdoudp.h>
 #include <user/timeru.h>
 #include <common/ami.h>
+#include <common/framepool.h>
+#include <common/target.h>
 
 #if (!defined(CONFIG_INCLUDE_SDO_UDP) && !defined(CONFIG_INCLUDE_SDO_ASND))
 #error "ERROR: sdoseq.c - At least UDP or ASND module needed!"
@@ -73,6 +75,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define SDO_SEQ_TX_HISTORY_FRAME_SIZE   SDO_MAX_TX_FRAME_SIZE   // buffersize for one frame in history
 #define SDO_CON_MASK                    0x03                    // mask to get scon and rcon
 
+// Every connection holds at most SDO_HISTORY_SIZE frames in its history buffer
+// and one frame which is filled by the command layer.
+#define SDO_SEQ_TX_POOL_FRAME_COUNT     (CONFIG_SDO_MAX_CONNECTION_SEQ * (SDO_HISTORY_SIZE + 1))
+
 #define SEQ_NUM_MASK                    0xFC
 
 static const UINT32 SDO_SEQU_MAX_TIMEOUT_MS = 86400000UL;       // [ms], 86400000 ms = 1 day
@@ -126,16 +132,16 @@ This structure defines the SDO sequence layer connection history buffer.
 */
 typedef struct
 {
-    UINT8   freeEntries;    ///< Number of free history entries
-    UINT8   writeIndex;     ///< Index of the next free buffer entry
-    UINT8   ackIndex;       ///< Index of the next message which should become acknowledged
-    UINT8   readIndex;      ///< Index between ackIndex and writeIndex to the next message for retransmission
-    UINT8   aHistoryFrame[SDO_HISTORY_SIZE][SDO_SEQ_TX_HISTORY_FRAME_SIZE];    ///< Array of the history frames
-    size_t  aFrameSize[SDO_HISTORY_SIZE];           ///< Array of sizes of the history frames
-    BOOL    afFrameFirstTxFailed[SDO_HISTORY_SIZE]; ///< Array of flags tagging frame as unsent
-                                                    /**< Array of flags indicating that the first attempt to
-                                                         forward a frame to a lower layer send function failed
-                                                         due to buffer overflow e.g. and should be repeated later */
+    UINT8       freeEntries;                            ///< Number of free history entries
+    UINT8       writeIndex;                             ///< Index of the next free buffer entry
+    UINT8       ackIndex;                               ///< Index of the next message which should become acknowledged
+    UINT8       readIndex;                              ///< Index between ackIndex and writeIndex to the next message for retransmission
+    tPlkFrame*  apHistoryFrame[SDO_HISTORY_SIZE];       ///< Array of the history frames (taken from the Tx frame pool)
+    size_t      aFrameSize[SDO_HISTORY_SIZE];           ///< Array of sizes of the history frames
+    BOOL        afFrameFirstTxFailed[SDO_HISTORY_SIZE]; ///< Array of flags tagging frame as unsent
+                                                        /**< Array of flags indicating that the first attempt to
+                                                             forward a frame to a lower layer send function failed
+                                                             due to buffer overflow e.g. and should be repeated later */
 } tSdoSeqConHistory;
 
 /**
@@ -193,6 +199,9 @@ typedef struct
     tSdoComReceiveCb        pfnSdoComRecvCb;                            ///< Pointer to receive callback function
     tSdoComConCb            pfnSdoComConCb;                             ///< Pointer to connection callback function
     UINT32                  sdoSeqTimeout;                              ///< Configured Sequence layer sub-timeout
+    tFramePool*             pTxFramePool;                               ///< Pool of the Tx history frames
+    OPLK_MUTEX_T            txFramePoolMutex;                           ///< Mutex protecting the Tx frame pool
+    tPlkFrame*              pPendingTxFrame;                            ///< Pool frame passed to sdoseq_sendData() which is not yet stored in a history buffer
 
 #if (defined(WIN32) || defined(_WIN32))
     LPCRITICAL_SECTION      pCriticalSection;
@@ -254,8 +263,9 @@ static tOplkError receiveCb(tSdoConHdl conHdl_p,
                             const tAsySdoSeq* pSdoSeqData_p,
                             size_t dataSize_p);
 static tOplkError initHistory(tSdoSeqCon* pSdoSeqCon_p);
+static void       releaseHistory(tSdoSeqCon* pSdoSeqCon_p);
 static tOplkError addFrameToHistory(tSdoSeqCon* pSdoSeqCon_p,
-                                    const tPlkFrame* pFrame_p,
+                                    tPlkFrame* pFrame_p,
                                     size_t size_p,
                                     BOOL fTxFailed_p);
 static tOplkError sendAllTxHistory(tSdoSeqCon* pSdoSeqCon_p);
@@ -319,6 +329,21 @@ tOplkError sdoseq_init(tSdoComReceiveCb pfnSdoComRecvCb_p,
 
     OPLK_MEMSET(&sdoSeqInstance_l.aSdoSeqCon[0], 0x00, sizeof(sdoSeqInstance_l.aSdoSeqCon));
 
+    // preallocate the frames of all history buffers
+    sdoSeqInstance_l.pTxFramePool = framepool_create(SDO_SEQ_TX_POOL_FRAME_COUNT,
+                                                     SDO_SEQ_TX_HISTORY_FRAME_SIZE);
+    if (sdoSeqInstance_l.pTxFramePool == NULL)
+        return kErrorNoResource;
+    sdoSeqInstance_l.pPendingTxFrame = NULL;
+
+    // the pool is used by the application and by the receive threads of the lower layers
+    if (target_createMutex("/sdoSeqPoolMutex", &sdoSeqInstance_l.txFramePoolMutex) != kErrorOk)
+    {
+        framepool_destroy(sdoSeqInstance_l.pTxFramePool);
+        sdoSeqInstance_l.pTxFramePool = NULL;
+        return kErrorNoResource;
+    }
+
 #if (defined(WIN32) || defined(_WIN32))
     // create critical section for process function
     sdoSeqInstance_l.pCriticalSection = &sdoSeqInstance_l.criticalSection;
@@ -333,16 +358,34 @@ tOplkError sdoseq_init(tSdoComReceiveCb pfnSdoComRecvCb_p,
 #if defined(CONFIG_INCLUDE_SDO_UDP)
     ret = sdoudp_init(receiveCb);
     if (ret != kErrorOk)
-        return ret;
+        goto Exit;
 #endif
 
 #if defined(CONFIG_INCLUDE_SDO_ASND)
     ret = sdoasnd_init(receiveCb);
     if (ret != kErrorOk)
-        return ret;
+    {
+#if defined(CONFIG_INCLUDE_SDO_UDP)
+        sdoudp_exit();
+#endif
+        goto Exit;
+    }
 #endif
 
+    return kErrorOk;
+
+#if (defined(CONFIG_INCLUDE_SDO_UDP) || defined(CONFIG_INCLUDE_SDO_ASND))
+Exit:
+#if (defined(WIN32) || defined(_WIN32))
+    DeleteCriticalSection(sdoSeqInstance_l.pCriticalSectionReceive);
+    DeleteCriticalSection(sdoSeqInstance_l.pCriticalSection);
+#endif
+    target_destroyMutex(sdoSeqInstance_l.txFramePoolMutex);
+    framepool_destroy(sdoSeqInstance_l.pTxFramePool);
+    sdoSeqInstance_l.pTxFramePool = NULL;
+
     return ret;
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -370,10 +413,14 @@ tOplkError sdoseq_exit(void)
         if (pSdoSeqCon->conHandle != 0)
             timeru_deleteTimer(&pSdoSeqCon->timerHandle);
 
+        releaseHistory(pSdoSeqCon);
         count++;
         pSdoSeqCon++;
     }
 
+    framepool_destroy(sdoSeqInstance_l.pTxFramePool);
+    target_destroyMutex(sdoSeqInstance_l.txFramePoolMutex);
+
 #if (defined(WIN32) || defined(_WIN32))
     // delete critical section for process function
     DeleteCriticalSection(sdoSeqInstance_l.pCriticalSection);
@@ -529,6 +576,10 @@ tOplkError sdoseq_initCon(tSdoSeqConHdl* pSdoSeqConHdl_p,
 
 The function sends data via an existing sequence layer connection.
 
+If pData_p was obtained by sdoseq_allocTxFrame(), the sequence layer takes over
+the frame in any case and stores it in the history buffer without copying it.
+Any other frame is copied into a frame of the Tx frame pool.
+
 \param[in]      sdoSeqConHdl_p      Sequence layer connection handle to use for
                                     transfer.
 \param[in]      dataSize_p          Size of sequence layer frame (without higher
@@ -549,26 +600,113 @@ tOplkError sdoseq_sendData(tSdoSeqConHdl sdoSeqConHdl_p,
 
     handle = ((UINT)sdoSeqConHdl_p & ~SDO_SEQ_HANDLE_MASK);
 
+    if (framepool_isPoolFrame(sdoSeqInstance_l.pTxFramePool, pData_p))
+        sdoSeqInstance_l.pPendingTxFrame = pData_p;
+
     // check if connection ready
     if (sdoSeqInstance_l.aSdoSeqCon[handle].sdoSeqState == kSdoSeqStateIdle)
     {
         // no connection with this handle
-        return kErrorSdoSeqInvalidHdl;
+        ret = kErrorSdoSeqInvalidHdl;
     }
-    else
+    else if (sdoSeqInstance_l.aSdoSeqCon[handle].sdoSeqState != kSdoSeqStateConnected)
     {
-        if (sdoSeqInstance_l.aSdoSeqCon[handle].sdoSeqState != kSdoSeqStateConnected)
-            return kErrorSdoSeqConnectionBusy;
+        ret = kErrorSdoSeqConnectionBusy;
     }
+    else
+    {
+        // calling send function from application counts as reset of flow control
+        forceRetransmissionRequest(&sdoSeqInstance_l.aSdoSeqCon[handle], FALSE);
 
-    // calling send function from application counts as reset of flow control
-    forceRetransmissionRequest(&sdoSeqInstance_l.aSdoSeqCon[handle], FALSE);
+        ret = processState(handle, dataSize_p, pData_p, NULL, kSdoSeqEventFrameSend);
+    }
 
-    ret = processState(handle, dataSize_p, pData_p, NULL, kSdoSeqEventFrameSend);
+    // release the pool frame if it was not stored in the history buffer
+    if (sdoSeqInstance_l.pPendingTxFrame != NULL)
+    {
+        sdoseq_freeTxFrame(sdoSeqInstance_l.pPendingTxFrame);
+        sdoSeqInstance_l.pPendingTxFrame = NULL;
+    }
 
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Allocate a Tx frame
+
+The function takes a frame from the Tx frame pool of the sequence layer. The
+command layer fills the frame in place and passes it to sdoseq_sendData() which
+takes over the frame. A frame which is not passed to sdoseq_sendData() must be
+released with sdoseq_freeTxFrame().
+
+The frame provides SDO_MAX_TX_FRAME_SIZE bytes, its content is undefined.
+
+\return The function returns a pointer to the frame or NULL if the pool is
+        exhausted.
+
+\ingroup module_sdo_seq
+*/
+//------------------------------------------------------------------------------
+tPlkFrame* sdoseq_allocTxFrame(void)
+{
+    tPlkFrame*  pFrame;
+
+    target_lockMutex(sdoSeqInstance_l.txFramePoolMutex);
+    pFrame = framepool_getFrame(sdoSeqInstance_l.pTxFramePool);
+    target_unlockMutex(sdoSeqInstance_l.txFramePoolMutex);
+
+    return pFrame;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Free a Tx frame
+
+The function gives a frame obtained by sdoseq_allocTxFrame() which was not
+passed to sdoseq_sendData() back to the Tx frame pool.
+
+\param[in]      pFrame_p            Pointer to the frame.
+
+\ingroup module_sdo_seq
+*/
+//------------------------------------------------------------------------------
+void sdoseq_freeTxFrame(tPlkFrame* pFrame_p)
+{
+    target_lockMutex(sdoSeqInstance_l.txFramePoolMutex);
+    framepool_releaseFrame(sdoSeqInstance_l.pTxFramePool, pFrame_p);
+    target_unlockMutex(sdoSeqInstance_l.txFramePoolMutex);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get the Tx frame pool statistics
+
+The function returns the occupancy statistics of the Tx frame pool which holds
+the frames of all history buffers.
+
+\param[out]     pStatistics_p       Pointer to store the statistics.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_sdo_seq
+*/
+//------------------------------------------------------------------------------
+tOplkError sdoseq_getTxFramePoolStatistics(tFramePoolStatistics* pStatistics_p)
+{
+    if (pStatistics_p == NULL)
+        return kErrorInvalidOperation;
+
+    if (sdoSeqInstance_l.pTxFramePool == NULL)
+        return kErrorNoResource;
+
+    target_lockMutex(sdoSeqInstance_l.txFramePoolMutex);
+    framepool_getStatistics(sdoSeqInstance_l.pTxFramePool, pStatistics_p);
+    target_unlockMutex(sdoSeqInstance_l.txFramePoolMutex);
+
+    return kErrorOk;
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Process an SDO event
@@ -1940,6 +2078,8 @@ The function initializes the history buffer of a SDO connection.
 //------------------------------------------------------------------------------
 static tOplkError initHistory(tSdoSeqCon* pSdoSeqCon_p)
 {
+    releaseHistory(pSdoSeqCon_p);
+
     pSdoSeqCon_p->sdoSeqConHistory.freeEntries = SDO_HISTORY_SIZE;
     pSdoSeqCon_p->sdoSeqConHistory.ackIndex = 0;
     pSdoSeqCon_p->sdoSeqConHistory.writeIndex = 0;
@@ -1947,11 +2087,38 @@ static tOplkError initHistory(tSdoSeqCon* pSdoSeqCon_p)
     return kErrorOk;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Release all frames of the history buffer
+
+The function gives all frames stored in the history buffer of a SDO connection
+back to the Tx frame pool.
+
+\param[in,out]  pSdoSeqCon_p        Pointer to connection control structure.
+*/
+//------------------------------------------------------------------------------
+static void releaseHistory(tSdoSeqCon* pSdoSeqCon_p)
+{
+    tSdoSeqConHistory*  pHistory = &pSdoSeqCon_p->sdoSeqConHistory;
+    UINT                index;
+
+    for (index = 0; index < SDO_HISTORY_SIZE; index++)
+    {
+        if (pHistory->apHistoryFrame[index] != NULL)
+        {
+            sdoseq_freeTxFrame(pHistory->apHistoryFrame[index]);
+            pHistory->apHistoryFrame[index] = NULL;
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 /**
 \brief  Add frame to the history buffer
 
-The function adds a frame to the history buffer.
+The function adds a frame to the history buffer. A pool frame passed to
+sdoseq_sendData() is stored without copying it, any other frame is copied into
+a frame of the Tx frame pool.
 
 \param[in,out]  pSdoSeqCon_p        Pointer to connection control structure.
 \param[in]      pFrame_p            Pointer to frame to be stored in history buffer.
@@ -1963,7 +2130,7 @@ The function adds a frame to the history buffer.
 */
 //------------------------------------------------------------------------------
 static tOplkError addFrameToHistory(tSdoSeqCon* pSdoSeqCon_p,
-                                    const tPlkFrame* pFrame_p,
+                                    tPlkFrame* pFrame_p,
                                     size_t size_p,
                                     BOOL fTxFailed_p)
 {
@@ -1981,11 +2148,23 @@ static tOplkError addFrameToHistory(tSdoSeqCon* pSdoSeqCon_p,
     // check if a free entry is available
     if (pHistory->freeEntries > 0)
     {   // write message in free entry
-        pHistoryFrame = (tPlkFrame*)pHistory->aHistoryFrame[pHistory->writeIndex];
+        if (pFrame_p == sdoSeqInstance_l.pPendingTxFrame)
+        {   // take over the frame filled by the command layer
+            pHistoryFrame = pFrame_p;
+            sdoSeqInstance_l.pPendingTxFrame = NULL;
+        }
+        else
+        {
+            pHistoryFrame = sdoseq_allocTxFrame();
+            if (pHistoryFrame == NULL)
+                return kErrorSdoSeqNoFreeHistory;
+
+            OPLK_MEMCPY(&pHistoryFrame->messageType,
+                        &pFrame_p->messageType,
+                        size_p + ASND_HEADER_SIZE);
+        }
 
-        OPLK_MEMCPY(&pHistoryFrame->messageType,
-                    &pFrame_p->messageType,
-                    size_p + ASND_HEADER_SIZE);
+        pHistory->apHistoryFrame[pHistory->writeIndex] = pHistoryFrame;
         pHistory->aFrameSize[pHistory->writeIndex] = size_p;
         pHistory->afFrameFirstTxFailed[pHistory->writeIndex] = fTxFailed_p;
         pHistory->freeEntries--;
@@ -2077,11 +2256,13 @@ static tOplkError deleteAckedFrameFromHistory(tSdoSeqCon* pSdoSeqCon_p,
         ackIndex = pHistory->ackIndex;
         do
         {
-            pHistoryFrame = (tPlkFrame*)pHistory->aHistoryFrame[ackIndex];
+            pHistoryFrame = pHistory->apHistoryFrame[ackIndex];
 
             currentSeqNum = (pHistoryFrame->data.asnd.payload.sdoSequenceFrame.sendSeqNumCon & SEQ_NUM_MASK);
             if (((recvSeqNumber_p - currentSeqNum) & SEQ_NUM_MASK) < SDO_SEQ_NUM_THRESHOLD)
             {
+                sdoseq_freeTxFrame(pHistoryFrame);
+                pHistory->apHistoryFrame[ackIndex] = NULL;
                 pHistory->aFrameSize[ackIndex] = 0;
                 pHistory->afFrameFirstTxFailed[ackIndex] = FALSE;
                 ackIndex++;
@@ -2163,7 +2344,7 @@ static tOplkError readFromHistory(tSdoSeqCon* pSdoSeqCon_p,
                             pHistory->aFrameSize[pHistory->readIndex]);
 
         // return pointer to stored frame
-        *ppFrame_p = (tPlkFrame*)pHistory->aHistoryFrame[pHistory->readIndex];
+        *ppFrame_p = pHistory->apHistoryFrame[pHistory->readIndex];
         *pSize_p = pHistory->aFrameSize[pHistory->readIndex];   // save size
         pHistory->readIndex++;
         if (pHistory->readIndex == SDO_HISTORY_SIZE)
@@ -2427,6 +2608,7 @@ static tOplkError deleteLowLayerConnection(tSdoSeqCon* pSdoSeqCon_p)
     timeru_deleteTimer(&pSdoSeqCon_p->timerHandle);
 
     // cleanup control structure
+    releaseHistory(pSdoSeqCon_p);
     OPLK_MEMSET(pSdoSeqCon_p, 0x00, sizeof(tSdoSeqCon));
     pSdoSeqCon_p->sdoSeqConHistory.freeEntries = SDO_HISTORY_SIZE;
 
@@ -2455,7 +2637,12 @@ static BOOL checkHistoryAcked(const tSdoSeqCon* pSdoSeqCon_p,
 
     // get pointer to history buffer
     pHistory = &pSdoSeqCon_p->sdoSeqConHistory;
-    pHistoryFrame = (const tPlkFrame*)pHistory->aHistoryFrame[pHistory->ackIndex];
+    pHistoryFrame = pHistory->apHistoryFrame[pHistory->ackIndex];
+    if (pHistoryFrame == NULL)
+    {   // history buffer is empty
+        return FALSE;
+    }
+
     currentSeqNum = (pHistoryFrame->data.asnd.payload.sdoSequenceFrame.sendSeqNumCon & SEQ_NUM_MASK);
     if (((recvSeqNumber_p - currentSeqNum) & SEQ_NUM_MASK) < SDO_SEQ_NUM_THRESHOLD)
     {   // acknowledges at least the oldest history frame
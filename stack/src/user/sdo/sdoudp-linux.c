@@ -42,6 +42,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #include <common/oplkinc.h>
 #include <user/sdoudp.h>
+#include <common/targetthread.h>
 
 #include <unistd.h>
 #include <sys/types.h>
@@ -191,9 +192,10 @@ tOplkError sdoudp_createSocket(tSdoUdpCon* pSdoUdpCon_p)
     if (pthread_create(&instance_l.threadHandle, NULL, sdoUdpThread, &instance_l) != 0)
         return kErrorSdoUdpThreadError;
 
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(instance_l.threadHandle, "oplk-sdoudp");
-#endif
+    target_registerThread(instance_l.threadHandle,
+                          kOplkApiThreadSdoUdp,
+                          "oplk-sdoudp",
+                          0);
 
     return kErrorOk;
 }
@@ -216,6 +218,7 @@ tOplkError sdoudp_closeSocket(void)
     if (instance_l.threadHandle != 0)
     {   // listen thread was started -> close old thread
 
+        target_unregisterThread(instance_l.threadHandle);
         instance_l.fStopThread = TRUE;
         if (pthread_join(instance_l.threadHandle, NULL) != 0)
             return kErrorSdoUdpThreadError;
@@ -44,6 +44,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/oplkinc.h>
 #include <user/timeru.h>
 #include <user/eventu.h>
+#include <common/targetthread.h>
 
 #include <stdio.h>
 #include <unistd.h>
@@ -132,7 +133,6 @@ The function initializes the user timer module.
 //------------------------------------------------------------------------------
 tOplkError timeru_init(void)
 {
-    struct sched_param  schedParam;
     int                 retVal;
 
     // reset instance structure
@@ -159,18 +159,10 @@ tOplkError timeru_init(void)
         return kErrorNoResource;
     }
 
-    schedParam.sched_priority = CONFIG_THREAD_PRIORITY_LOW;
-    if (pthread_setschedparam(timeruInstance_g.processThread,
-                              SCHED_RR,
-                              &schedParam) != 0)
-    {
-        DEBUG_LVL_ERROR_TRACE("%s() couldn't set thread scheduling parameters!\n",
-                              __func__);
-    }
-
-#if (defined(__GLIBC__) && (__GLIBC__ >= 2) && (__GLIBC_MINOR__ >= 12))
-    pthread_setname_np(timeruInstance_g.processThread, "oplk-timeru");
-#endif
+    target_registerThread(timeruInstance_g.processThread,
+                          kOplkApiThreadTimeru,
+                          "oplk-timeru",
+                          CONFIG_THREAD_PRIORITY_LOW);
 
     return kErrorOk;
 }
@@ -194,6 +186,7 @@ tOplkError timeru_exit(void)
     if (timeruInstance_g.processThread != 0)
     {
         /* cancel thread */
+        target_unregisterThread(timeruInstance_g.processThread);
         pthread_cancel(timeruInstance_g.processThread);
         DEBUG_LVL_TIMERU_TRACE("%s() Waiting for thread to exit...\n", __func__);
 
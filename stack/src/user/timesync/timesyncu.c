@@ -6,6 +6,14 @@
 
 This file contains the main implementation of the user timesync module.
 
+If a maximum synchronization period is configured, the module measures the
+processing time of the application between the sync event and
+oplk_exchangeProcessImageIn(). It increases the number of cycles per sync
+event if the load exceeds CONFIG_TIMESYNCU_ADAPTIVE_HIGH_LOAD and decreases it
+again after CONFIG_TIMESYNCU_ADAPTIVE_HOLD_SYNCS sync events below
+CONFIG_TIMESYNCU_ADAPTIVE_LOW_LOAD. Overruns of the synchronization period are
+reported to the application as warning.
+
 \ingroup module_timesyncu
 *******************************************************************************/
 
@@ -44,6 +52,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <common/target.h>
 #include <user/timesyncu.h>
 #include <user/timesyncucal.h>
+#include <user/eventu.h>
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -73,6 +82,26 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local types
 //------------------------------------------------------------------------------
+/**
+\brief Adaptive synchronization
+
+This structure contains the measurement and the bounds of the adaptive
+synchronization.
+*/
+typedef struct
+{
+    UINT32                  cycleLen;           ///< POWERLINK cycle length [us]
+    UINT32                  minSyncCycle;       ///< Minimum number of cycles per sync event
+    UINT32                  maxSyncCycle;       ///< Maximum number of cycles per sync event
+    UINT32                  syncCycle;          ///< Current number of cycles per sync event
+    ULONGLONG               syncTimestamp;      ///< Timestamp of the current sync event [ns]
+    BOOL                    fSyncPending;       ///< Sync event is processed by the application
+    BOOL                    fOverrun;           ///< Last sync event was an overrun
+    UINT32                  lowLoadCount;       ///< Number of consecutive sync events with low load
+    UINT32                  windowMaxAppTime;   ///< Maximum application time within the low load window [us]
+    tOplkApiSyncStatistics  statistics;         ///< Synchronization statistics
+} tTimesyncuAdaptive;
+
 /**
 \brief Memory instance for user timesync module
 
@@ -82,6 +111,7 @@ module.
 typedef struct
 {
     tSyncCb                pfnSyncCb;           ///< Synchronization callback.
+    tTimesyncuAdaptive     adaptive;            ///< Adaptive synchronization
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
     tTimesyncSharedMemory* pSharedMemory;       ///< Pointer to SoC timestamp shared memory.
 #if defined(CONFIG_INCLUDE_NMT_MN)
@@ -105,6 +135,9 @@ static tOplkError setNetTime(void);
 #endif /* defined(CONFIG_INCLUDE_NMT_MN) */
 #endif /* defined(CONFIG_INCLUDE_SOC_TIME_FORWARD) */
 static tOplkError syncCb(void);
+static void       startSyncProcessing(void);
+static void       adaptSyncCycle(UINT32 appTime_p);
+static tOplkError setSyncCycle(UINT32 syncCycle_p);
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -174,6 +207,8 @@ tOplkError timesyncu_waitSyncEvent(ULONG timeout_p)
     if (ret != kErrorOk)
         return ret;
 
+    startSyncProcessing();
+
 #if (defined(CONFIG_INCLUDE_SOC_TIME_FORWARD) && defined(CONFIG_INCLUDE_NMT_MN))
         if (!instance_l.fFirstSyncEventDone)
         {   // Set MN net time at first sync event
@@ -205,6 +240,135 @@ void timesyncu_exit(void)
 #endif
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Set cycle time to timesync module
+
+The function sets the POWERLINK cycle time and the bounds of the synchronization
+period. The number of cycles per sync event starts at the minimum which is also
+used by the kernel timesync module (see timesynck_setCycleTime()).
+
+\param[in]      cycleLen_p          POWERLINK cycle time [us]
+\param[in]      minSyncTime_p       Minimum synchronization period [us]
+\param[in]      maxSyncTime_p       Maximum synchronization period [us]. The
+                                    adaptive synchronization is disabled if it
+                                    is not larger than minSyncTime_p.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_timesyncu
+*/
+//------------------------------------------------------------------------------
+tOplkError timesyncu_setCycleTime(UINT32 cycleLen_p,
+                                  UINT32 minSyncTime_p,
+                                  UINT32 maxSyncTime_p)
+{
+    tTimesyncuAdaptive* pAdaptive = &instance_l.adaptive;
+
+    OPLK_MEMSET(pAdaptive, 0, sizeof(tTimesyncuAdaptive));
+
+    pAdaptive->cycleLen = cycleLen_p;
+    pAdaptive->minSyncCycle = 1;
+    if ((cycleLen_p != 0) && (minSyncTime_p != 0))
+        pAdaptive->minSyncCycle = (minSyncTime_p + cycleLen_p - 1) / cycleLen_p;
+
+    pAdaptive->maxSyncCycle = pAdaptive->minSyncCycle;
+    if ((cycleLen_p != 0) && (maxSyncTime_p > minSyncTime_p))
+        pAdaptive->maxSyncCycle = max(maxSyncTime_p / cycleLen_p, pAdaptive->minSyncCycle);
+
+    pAdaptive->syncCycle = pAdaptive->minSyncCycle;
+    pAdaptive->statistics.syncPeriod = cycleLen_p * pAdaptive->syncCycle;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Finish sync processing of the application
+
+The function is called when the application has finished the processing of a
+sync event (see oplk_exchangeProcessImageIn()). It updates the statistics,
+reports an overrun of the synchronization period and adapts the number of cycles
+per sync event.
+
+\ingroup module_timesyncu
+*/
+//------------------------------------------------------------------------------
+void timesyncu_finishSyncProcessing(void)
+{
+    tTimesyncuAdaptive*     pAdaptive = &instance_l.adaptive;
+    tOplkApiSyncStatistics* pStatistics = &pAdaptive->statistics;
+    UINT32                  appTime;
+
+    if (!pAdaptive->fSyncPending)
+        return;
+
+    pAdaptive->fSyncPending = FALSE;
+
+    appTime = (UINT32)((target_getCurrentTimestamp() - pAdaptive->syncTimestamp) / 1000);
+
+    pStatistics->syncCount++;
+    pStatistics->lastAppTime = appTime;
+    if (appTime > pStatistics->maxAppTime)
+        pStatistics->maxAppTime = appTime;
+
+    // Exponential moving average with a weight of 1/16
+    if (appTime >= pStatistics->avgAppTime)
+        pStatistics->avgAppTime += (appTime - pStatistics->avgAppTime + 15) / 16;
+    else
+        pStatistics->avgAppTime -= (pStatistics->avgAppTime - appTime) / 16;
+
+    if ((pStatistics->syncPeriod != 0) && (appTime > pStatistics->syncPeriod))
+    {
+        pStatistics->overrunCount++;
+
+        // Report only the first overrun of a sequence
+        if (!pAdaptive->fOverrun)
+        {
+            DEBUG_LVL_CTRL_TRACE("%s() Overrun: application time %u us, sync period %u us\n",
+                                 __func__,
+                                 appTime,
+                                 pStatistics->syncPeriod);
+            eventu_postError(kEventSourceTimesyncu,
+                             kErrorTimesyncOverrun,
+                             sizeof(appTime),
+                             &appTime);
+        }
+
+        pAdaptive->fOverrun = TRUE;
+    }
+    else
+    {
+        pAdaptive->fOverrun = FALSE;
+    }
+
+    if (pAdaptive->maxSyncCycle > pAdaptive->minSyncCycle)
+        adaptSyncCycle(appTime);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get synchronization statistics
+
+The function returns the statistics of the application synchronization.
+
+\param[out]     pStatistics_p       Pointer to store the statistics.
+
+\return The function returns a tOplkError error code.
+
+\ingroup module_timesyncu
+*/
+//------------------------------------------------------------------------------
+tOplkError timesyncu_getStatistics(tOplkApiSyncStatistics* pStatistics_p)
+{
+    if (pStatistics_p == NULL)
+        return kErrorApiInvalidParam;
+
+    *pStatistics_p = instance_l.adaptive.statistics;
+
+    return kErrorOk;
+}
+
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
 //------------------------------------------------------------------------------
 /**
@@ -353,6 +517,8 @@ static tOplkError syncCb(void)
 
     if (instance_l.pfnSyncCb != NULL)
     {
+        startSyncProcessing();
+
         ret = instance_l.pfnSyncCb();
         if (ret != kErrorOk)
             return ret;
@@ -377,4 +543,113 @@ static tOplkError syncCb(void)
     return ret;
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Start sync processing of the application
+
+This function stores the timestamp of the sync event for the measurement of the
+application processing time.
+*/
+//------------------------------------------------------------------------------
+static void startSyncProcessing(void)
+{
+    instance_l.adaptive.syncTimestamp = target_getCurrentTimestamp();
+    instance_l.adaptive.fSyncPending = (instance_l.adaptive.syncTimestamp != 0);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Adapt number of cycles per sync event
+
+This function adapts the number of cycles per sync event to the measured
+application processing time. A high load immediately increases the sync period
+so that the load reaches the middle of the configured range. The sync period is
+only decreased by one cycle after a window of sync events with low load and if
+the maximum application time of the window also fits into the shorter period.
+
+\param[in]      appTime_p           Application processing time [us]
+*/
+//------------------------------------------------------------------------------
+static void adaptSyncCycle(UINT32 appTime_p)
+{
+    tTimesyncuAdaptive* pAdaptive = &instance_l.adaptive;
+    UINT64              syncPeriod = (UINT64)pAdaptive->cycleLen * pAdaptive->syncCycle;
+    UINT64              load = ((UINT64)appTime_p * 100) / syncPeriod;
+    UINT64              targetPeriod;
+    UINT32              syncCycle = pAdaptive->syncCycle;
+
+    if (load > CONFIG_TIMESYNCU_ADAPTIVE_HIGH_LOAD)
+    {
+        targetPeriod = ((UINT64)appTime_p * 200) /
+                       (CONFIG_TIMESYNCU_ADAPTIVE_HIGH_LOAD + CONFIG_TIMESYNCU_ADAPTIVE_LOW_LOAD);
+        syncCycle = (UINT32)((targetPeriod + pAdaptive->cycleLen - 1) / pAdaptive->cycleLen);
+        if (syncCycle > pAdaptive->maxSyncCycle)
+            syncCycle = pAdaptive->maxSyncCycle;
+
+        pAdaptive->lowLoadCount = 0;
+        pAdaptive->windowMaxAppTime = 0;
+    }
+    else if (load < CONFIG_TIMESYNCU_ADAPTIVE_LOW_LOAD)
+    {
+        if (appTime_p > pAdaptive->windowMaxAppTime)
+            pAdaptive->windowMaxAppTime = appTime_p;
+
+        if (++pAdaptive->lowLoadCount >= CONFIG_TIMESYNCU_ADAPTIVE_HOLD_SYNCS)
+        {
+            if ((syncCycle > pAdaptive->minSyncCycle) &&
+                (((UINT64)pAdaptive->windowMaxAppTime * 100) <
+                 ((UINT64)pAdaptive->cycleLen * (syncCycle - 1) * CONFIG_TIMESYNCU_ADAPTIVE_HIGH_LOAD)))
+            {
+                syncCycle--;
+            }
+
+            pAdaptive->lowLoadCount = 0;
+            pAdaptive->windowMaxAppTime = 0;
+        }
+    }
+    else
+    {
+        pAdaptive->lowLoadCount = 0;
+        pAdaptive->windowMaxAppTime = 0;
+    }
+
+    if (syncCycle != pAdaptive->syncCycle)
+    {
+        if (setSyncCycle(syncCycle) != kErrorOk)
+            return;
+
+        pAdaptive->syncCycle = syncCycle;
+        pAdaptive->statistics.syncPeriod = pAdaptive->cycleLen * syncCycle;
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set number of cycles per sync event
+
+This function forwards the number of cycles per sync event to the kernel
+timesync module.
+
+\param[in]      syncCycle_p         Number of cycles per sync event
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setSyncCycle(UINT32 syncCycle_p)
+{
+    tEvent  event;
+
+    DEBUG_LVL_CTRL_TRACE("%s() Sync period %u -> %u cycles\n",
+                         __func__,
+                         instance_l.adaptive.syncCycle,
+                         syncCycle_p);
+
+    event.eventSink = kEventSinkTimesynck;
+    event.eventType = kEventTypeTimesynckSetSyncCycle;
+    event.eventArg.pEventArg = &syncCycle_p;
+    event.eventArgSize = sizeof(syncCycle_p);
+
+    return eventu_postEvent(&event);
+}
+
 /// \}
@@ -4,10 +4,14 @@
 
 \brief  Sync implementation for the user CAL timesync module using Linux ioctl
 
-This file contains a sync implementation for the user CAL timesync module. It
-uses a Linux ioctl call for synchronisation. In addition SoC timestamp
-forwarding feature implementation is done by creating a shared memory for the
-user and kernel.
+This file contains a sync implementation for the user CAL timesync module. The
+kernel module counts the sync events in a shared memory (tSyncShm) which is
+mapped into the user layer. A pending sync event is therefore detected without
+a system call, the Linux ioctl call is only used to block until the next sync
+event. Optionally, the module sleeps until shortly before the expected sync
+event and spins on the sync counter (see CONFIG_TIMESYNCU_SYNC_SPIN_TIME_US).
+In addition SoC timestamp forwarding feature implementation is done by creating
+a shared memory for the user and kernel.
 
 \ingroup module_timesyncucal
 *******************************************************************************/
@@ -52,11 +56,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sys/stat.h>
 #include <sys/ioctl.h>
 #include <time.h>
-
-#if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
+#include <errno.h>
 #include <unistd.h>
 #include <sys/mman.h>
-#endif
 
 //============================================================================//
 //            G L O B A L   D E F I N I T I O N S                             //
@@ -94,6 +96,8 @@ CAL module for Linux ioctl design.
 typedef struct
 {
     OPLK_FILE_HANDLE        fd;               ///< File descriptor
+    tSyncShm*               pSyncShm;         ///< Sync shared memory
+    UINT32                  lastSyncCount;    ///< Sync counter of the last processed sync event
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
     tTimesyncSharedMemory*  pSharedMemory;    ///< Shared timesync structure
     size_t                  memSize;          ///< Size of the timesync shared memory
@@ -108,6 +112,12 @@ static tTimesynckcalInstance instance_l;
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static tOplkError getSyncMem(void);
+static void       releaseSyncMem(void);
+#if (CONFIG_TIMESYNCU_SYNC_SPIN_TIME_US > 0)
+static BOOL       spinForSync(void);
+static UINT64     getMonotonicTime(void);
+#endif
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
 static tOplkError getTimeSyncSharedMem(void);
 static tOplkError releaseTimeSyncSharedMem(void);
@@ -135,6 +145,13 @@ tOplkError timesyncucal_init(tSyncCb pfnSyncCb_p)
     UNUSED_PARAMETER(pfnSyncCb_p);
 
     instance_l.fd = ctrlucal_getFd();
+    if (getSyncMem() != kErrorOk)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() Could not get sync shared memory\n",
+                              __func__);
+        return kErrorNoResource;
+    }
+
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
     instance_l.memSize = sizeof(tTimesyncSharedMemory);
     if (getTimeSyncSharedMem() != kErrorOk)
@@ -168,13 +185,16 @@ void timesyncucal_exit(void)
                               __func__);
     }
 #endif
+
+    releaseSyncMem();
 }
 
 //------------------------------------------------------------------------------
 /**
 \brief  Wait for a sync event
 
-The function waits for a sync event.
+The function waits for a sync event. If a sync event occurred since the last
+call, the function returns immediately without a system call.
 
 \param[in]      timeout_p           Specifies a timeout in microseconds. If 0 it waits
                                     forever.
@@ -188,13 +208,29 @@ The function waits for a sync event.
 //------------------------------------------------------------------------------
 tOplkError timesyncucal_waitSyncEvent(ULONG timeout_p)
 {
-    int ret;
+    UINT32  syncCount;
+    int     ret;
+
+    UNUSED_PARAMETER(timeout_p);
 
-    ret = ioctl(instance_l.fd, PLK_CMD_TIMESYNC_SYNC, timeout_p);
-    if (ret == 0)
+    syncCount = instance_l.pSyncShm->syncCount;
+    if (syncCount != instance_l.lastSyncCount)
+    {
+        instance_l.lastSyncCount = syncCount;
         return kErrorOk;
+    }
+
+#if (CONFIG_TIMESYNCU_SYNC_SPIN_TIME_US > 0)
+    if (spinForSync())
+        return kErrorOk;
+#endif
 
-    return kErrorGeneralError;
+    ret = ioctl(instance_l.fd, PLK_CMD_TIMESYNC_SYNC, (ULONG)instance_l.lastSyncCount);
+    if (ret != 0)
+        return kErrorGeneralError;
+
+    instance_l.lastSyncCount = instance_l.pSyncShm->syncCount;
+    return kErrorOk;
 }
 
 #if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
@@ -213,6 +249,7 @@ tTimesyncSharedMemory* timesyncucal_getSharedMemory(void)
 {
     return instance_l.pSharedMemory;
 }
+#endif
 
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
@@ -220,6 +257,127 @@ tTimesyncSharedMemory* timesyncucal_getSharedMemory(void)
 /// \name Private Functions
 /// \{
 
+//------------------------------------------------------------------------------
+/**
+\brief  Get sync shared memory
+
+The function maps the sync shared memory of the kernel module read-only into
+user space memory.
+
+\return The function returns a tOplkError error code.
+\retval kErrorOk                    mmap successful
+\retval kErrorNoResource            mmap failed
+*/
+//------------------------------------------------------------------------------
+static tOplkError getSyncMem(void)
+{
+    instance_l.pSyncShm = mmap(NULL,
+                               sizeof(tSyncShm),
+                               PROT_READ,
+                               MAP_SHARED,
+                               instance_l.fd,
+                               PLK_MMAP_PGOFF_SYNC * sysconf(_SC_PAGE_SIZE));
+    if (instance_l.pSyncShm == MAP_FAILED)
+    {
+        DEBUG_LVL_ERROR_TRACE("%s() mmap failed!\n", __func__);
+        instance_l.pSyncShm = NULL;
+        return kErrorNoResource;
+    }
+
+    instance_l.lastSyncCount = instance_l.pSyncShm->syncCount;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Release sync shared memory
+
+The function releases the mapped sync shared memory.
+*/
+//------------------------------------------------------------------------------
+static void releaseSyncMem(void)
+{
+    if (instance_l.pSyncShm != NULL)
+    {
+        if (munmap(instance_l.pSyncShm, sizeof(tSyncShm)) != 0)
+        {
+            DEBUG_LVL_ERROR_TRACE("%s() munmap failed\n", __func__);
+        }
+
+        instance_l.pSyncShm = NULL;
+    }
+}
+
+#if (CONFIG_TIMESYNCU_SYNC_SPIN_TIME_US > 0)
+//------------------------------------------------------------------------------
+/**
+\brief  Spin for the next sync event
+
+The function predicts the time of the next sync event from the time and period
+of the last one. It sleeps until CONFIG_TIMESYNCU_SYNC_SPIN_TIME_US before the
+expected sync event and then polls the sync counter until the same time after
+it. If the sync event is late, the caller blocks in the kernel module instead.
+
+\return The function returns TRUE if a sync event was detected, otherwise FALSE.
+*/
+//------------------------------------------------------------------------------
+static BOOL spinForSync(void)
+{
+    const UINT64    spinTime = (UINT64)CONFIG_TIMESYNCU_SYNC_SPIN_TIME_US * 1000;
+    UINT64          nextSyncTime;
+    UINT64          now;
+    struct timespec wakeTime;
+    UINT32          syncCount;
+
+    if (instance_l.pSyncShm->syncPeriod == 0)
+        return FALSE;
+
+    nextSyncTime = instance_l.pSyncShm->syncTime + instance_l.pSyncShm->syncPeriod;
+    now = getMonotonicTime();
+    if (now > (nextSyncTime + spinTime))
+        return FALSE;           // Prediction is outdated
+
+    if ((now + spinTime) < nextSyncTime)
+    {
+        wakeTime.tv_sec = (time_t)((nextSyncTime - spinTime) / 1000000000ULL);
+        wakeTime.tv_nsec = (long)((nextSyncTime - spinTime) % 1000000000ULL);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeTime, NULL) == EINTR)
+            ;
+    }
+
+    do
+    {
+        syncCount = instance_l.pSyncShm->syncCount;
+        if (syncCount != instance_l.lastSyncCount)
+        {
+            instance_l.lastSyncCount = syncCount;
+            return TRUE;
+        }
+    } while (getMonotonicTime() < (nextSyncTime + spinTime));
+
+    return FALSE;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get monotonic time
+
+\return The function returns the CLOCK_MONOTONIC time in nanoseconds.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getMonotonicTime(void)
+{
+    struct timespec curTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &curTime);
+
+    return ((UINT64)curTime.tv_sec * 1000000000ULL) + (UINT64)curTime.tv_nsec;
+}
+#endif
+
+#if defined(CONFIG_INCLUDE_SOC_TIME_FORWARD)
+
 //------------------------------------------------------------------------------
 /**
 \brief  Get timesync shared memory
@@ -239,7 +397,7 @@ static tOplkError getTimeSyncSharedMem(void)
                                     PROT_READ | PROT_WRITE,                 // Map as read and write memory
                                     MAP_SHARED,                             // Map as shared memory
                                     instance_l.fd,                          // File descriptor
-                                    sysconf(_SC_PAGE_SIZE));
+                                    PLK_MMAP_PGOFF_SOC_TIME * sysconf(_SC_PAGE_SIZE));
 
     if (instance_l.pSharedMemory == MAP_FAILED)
     {
@@ -0,0 +1,291 @@
+#!/usr/bin/perl
+################################################################################
+#
+# Process image binding generator
+#
+# The script generates the process image binding of an MN application from the
+# output of an openCONFIGURATOR project. The binding contains the sizes of the
+# process images and a link table which assigns the mapped process image
+# objects (CiA 302-4) to their offsets in the process images. It is passed to
+# oplk_bindProcessImage() at runtime.
+#
+# Usage: generate-pi-binding.pl <openCONFIGURATOR output directory> <binding header>
+#
+# The script reads the following files of the output directory:
+#   mnobd.txt   PDO mapping of the MN
+#   xap.xml     Process image channels
+#   xap.h       Process image sizes
+#
+# Copyright (c) 2021, B&R Industrial Automation GmbH
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#     * Redistributions of source code must retain the above copyright
+#       notice, this list of conditions and the following disclaimer.
+#     * Redistributions in binary form must reproduce the above copyright
+#       notice, this list of conditions and the following disclaimer in the
+#       documentation and/or other materials provided with the distribution.
+#     * Neither the name of the copyright holders nor the
+#       names of its contributors may be used to endorse or promote products
+#       derived from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+# ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+# DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+################################################################################
+
+use strict;
+use warnings;
+
+# Number of process variables per object of the process image (see obdpi.c)
+my $PI_SUBINDEX_COUNT = 252;
+
+# Object dictionary data type codes of the process image channel types
+my %typeCode =
+(
+    "Integer8"   => 0x0002,
+    "Integer16"  => 0x0003,
+    "Integer32"  => 0x0004,
+    "Unsigned8"  => 0x0005,
+    "Unsigned16" => 0x0006,
+    "Unsigned32" => 0x0007,
+    "Real32"     => 0x0008,
+    "Integer64"  => 0x0015,
+    "Unsigned64" => 0x001B,
+);
+
+# Object ranges of the process image according to CiA 302-4
+#   start,  end,    image,    data type,    size
+my @piRanges =
+(
+    [ 0xA000, 0xA00F, "input",  "Integer8",   1 ],
+    [ 0xA040, 0xA04F, "input",  "Unsigned8",  1 ],
+    [ 0xA0C0, 0xA0C7, "input",  "Integer16",  2 ],
+    [ 0xA100, 0xA107, "input",  "Unsigned16", 2 ],
+    [ 0xA1C0, 0xA1C3, "input",  "Integer32",  4 ],
+    [ 0xA200, 0xA203, "input",  "Unsigned32", 4 ],
+    [ 0xA240, 0xA247, "input",  "Real32",     4 ],
+    [ 0xA400, 0xA401, "input",  "Integer64",  8 ],
+    [ 0xA440, 0xA441, "input",  "Unsigned64", 8 ],
+    [ 0xA480, 0xA48F, "output", "Integer8",   1 ],
+    [ 0xA4C0, 0xA4CF, "output", "Unsigned8",  1 ],
+    [ 0xA540, 0xA547, "output", "Integer16",  2 ],
+    [ 0xA580, 0xA587, "output", "Unsigned16", 2 ],
+    [ 0xA640, 0xA643, "output", "Integer32",  4 ],
+    [ 0xA680, 0xA683, "output", "Unsigned32", 4 ],
+    [ 0xA6C0, 0xA6C7, "output", "Real32",     4 ],
+    [ 0xA880, 0xA881, "output", "Integer64",  8 ],
+    [ 0xA8C0, 0xA8C1, "output", "Unsigned64", 8 ],
+);
+
+die "Usage: $0 <openCONFIGURATOR output directory> <binding header>\n" if (@ARGV != 2);
+my ($outputDir, $headerFile) = @ARGV;
+
+################################################################################
+# Read process image sizes from xap.h
+my %piSize;
+
+open(my $xapH, '<', "$outputDir/xap.h") or die "Unable to open file $outputDir/xap.h\n";
+while (<$xapH>)
+{
+    $piSize{input} = $1 if (/^\s*#define\s+COMPUTED_PI_IN_SIZE\s+(\d+)/);
+    $piSize{output} = $1 if (/^\s*#define\s+COMPUTED_PI_OUT_SIZE\s+(\d+)/);
+}
+close($xapH);
+
+die "Process image sizes not found in $outputDir/xap.h\n"
+    if (!defined($piSize{input}) || !defined($piSize{output}));
+
+################################################################################
+# Read process image channels from xap.xml
+my %channels;               # image -> data type -> list of [offset, size]
+my $image;
+
+open(my $xapXml, '<', "$outputDir/xap.xml") or die "Unable to open file $outputDir/xap.xml\n";
+while (<$xapXml>)
+{
+    $image = $1 if (/<ProcessImage\s+type="(\w+)"/);
+    if (/<Channel\s.*dataType="(\w+)"\s+dataSize="(\d+)"\s+PIOffset="(0x[0-9A-Fa-f]+)"/)
+    {
+        die "Channel outside of a process image in $outputDir/xap.xml\n" if (!defined($image));
+        push(@{$channels{$image}{$1}}, [ hex($3), $2 / 8 ]);
+    }
+}
+close($xapXml);
+
+foreach my $img (keys %channels)
+{
+    foreach my $type (keys %{$channels{$img}})
+    {
+        @{$channels{$img}{$type}} = sort { $a->[0] <=> $b->[0] } @{$channels{$img}{$type}};
+    }
+}
+
+################################################################################
+# Read the PDO mapping of the MN from mnobd.txt
+my %mapping;                # mapping object -> sub-index -> mapping entry
+my %mappingCount;           # mapping object -> number of mapped objects
+
+open(my $mnobd, '<', "$outputDir/mnobd.txt") or die "Unable to open file $outputDir/mnobd.txt\n";
+while (<$mnobd>)
+{
+    # the configuration of the CNs follows the configuration of the MN
+    last if (/^\/\/\/\/Configuration Data for CN/);
+
+    next if (!/^(1[6A][0-9A-Fa-f]{2})\s+([0-9A-Fa-f]{2})\s+[0-9A-Fa-f]{8}\s+([0-9A-Fa-f]+)\s*$/);
+
+    my ($mapIndex, $subindex, $value) = (hex($1), hex($2), $3);
+    if ($subindex == 0)
+    {
+        $mappingCount{$mapIndex} = hex($value);
+    }
+    else
+    {
+        $mapping{$mapIndex}{$subindex} = $value;
+    }
+}
+close($mnobd);
+
+################################################################################
+# Assign the mapped objects to the process image channels
+my @vars;                   # list of [index, sub-index, output image, size, offset, data type code]
+my %boundCount;
+
+foreach my $mapIndex (sort { $a <=> $b } keys %mappingCount)
+{
+    for (my $subindex = 1; $subindex <= $mappingCount{$mapIndex}; $subindex++)
+    {
+        my $value = $mapping{$mapIndex}{$subindex};
+        die sprintf("Mapping entry 0x%04X/0x%02X is missing\n", $mapIndex, $subindex) if (!defined($value));
+
+        # mapping entry: length (16), offset (16), reserved (8), sub-index (8), index (16)
+        $value = sprintf("%016s", $value);
+        my $objSubindex = hex(substr($value, 10, 2));
+        my $objIndex = hex(substr($value, 12, 4));
+
+        my ($range) = grep { ($objIndex >= $_->[0]) && ($objIndex <= $_->[1]) } @piRanges;
+        next if (!defined($range));     # object is not part of the process image
+
+        my ($start, $end, $img, $type, $size) = @$range;
+        my $varNumber = (($objIndex - $start) * $PI_SUBINDEX_COUNT) + $objSubindex - 1;
+        my $channel = $channels{$img}{$type}[$varNumber];
+
+        die sprintf("No %s channel of type %s found for object 0x%04X/0x%02X\n",
+                    $img, $type, $objIndex, $objSubindex)
+            if (!defined($channel) || ($channel->[1] != $size));
+
+        push(@vars, [ $objIndex, $objSubindex, ($img eq "output") ? 1 : 0, $size, $channel->[0], $typeCode{$type} ]);
+        $boundCount{$img}++;
+    }
+}
+
+foreach my $img (keys %channels)
+{
+    my $channelCount = 0;
+    $channelCount += scalar(@{$channels{$img}{$_}}) foreach (keys %{$channels{$img}});
+    die "Not all $img channels of $outputDir/xap.xml are mapped by the MN\n"
+        if (($boundCount{$img} // 0) != $channelCount);
+}
+
+die "No process image objects are mapped by the MN\n" if (@vars == 0);
+
+################################################################################
+# Combine consecutive sub-indices of an object into links
+my @links;                  # list of [index, first sub-index, output image, size, count, offset, data type code]
+
+foreach my $var (sort { ($a->[0] <=> $b->[0]) || ($a->[1] <=> $b->[1]) } @vars)
+{
+    my ($objIndex, $objSubindex, $fOutput, $size, $offset, $code) = @$var;
+    my $link = $links[-1];
+
+    if (defined($link) && ($link->[0] == $objIndex) &&
+        (($link->[1] + $link->[4]) == $objSubindex) &&
+        (($link->[5] + ($link->[4] * $size)) == $offset))
+    {
+        $link->[4]++;
+    }
+    else
+    {
+        push(@links, [ $objIndex, $objSubindex, $fOutput, $size, 1, $offset, $code ]);
+    }
+}
+
+################################################################################
+# Calculate the signature (see calcBindingSignature() in processimage.c)
+# The signature covers the data types of the process image channels of the
+# project. The stack compares them with the data types of the bound objects in
+# its object dictionary.
+sub updateSignature
+{
+    my ($signature, $value, $size) = @_;
+
+    for (my $i = 0; $i < $size; $i++)
+    {
+        $signature ^= ($value >> ($i * 8)) & 0xFF;
+        for (my $bit = 0; $bit < 8; $bit++)
+        {
+            $signature = ($signature & 1) ? (($signature >> 1) ^ 0xEDB88320) : ($signature >> 1);
+        }
+    }
+
+    return $signature;
+}
+
+my $signature = 0xFFFFFFFF;
+$signature = updateSignature($signature, $piSize{input}, 4);
+$signature = updateSignature($signature, $piSize{output}, 4);
+$signature = updateSignature($signature, scalar(@links), 4);
+foreach my $link (@links)
+{
+    $signature = updateSignature($signature, $link->[0], 2);
+    $signature = updateSignature($signature, $link->[1], 1);
+    $signature = updateSignature($signature, $link->[2], 1);
+    $signature = updateSignature($signature, $link->[3], 2);
+    $signature = updateSignature($signature, $link->[4], 2);
+    $signature = updateSignature($signature, $link->[5], 4);
+    $signature = updateSignature($signature, $link->[6], 2) for (1 .. $link->[4]);
+}
+$signature = ~$signature & 0xFFFFFFFF;
+
+################################################################################
+# Write the binding header
+open(my $header, '>', $headerFile) or die "Unable to open file $headerFile\n";
+
+print $header "/*\n";
+print $header "* This file was generated by generate-pi-binding.pl\n";
+print $header "* Process image binding of the openCONFIGURATOR project output\n";
+print $header "*/\n";
+print $header "#ifndef XAPBIND_h\n";
+print $header "#define XAPBIND_h\n\n";
+
+print $header "static const tOplkApiProcessImageLink aXapBindingLink[] =\n{\n";
+print $header "//    Index   Subindex  OutputPI  EntrySize  VarEntries  OffsetPI\n";
+foreach my $link (@links)
+{
+    printf $header "    { 0x%04X, 0x%02X,     %-9s %-10s %-11s 0x%04X },\n",
+                   $link->[0], $link->[1], ($link->[2] ? "TRUE" : "FALSE") . ",",
+                   $link->[3] . ",", $link->[4] . ",", $link->[5];
+}
+print $header "};\n\n";
+
+print $header "static const tOplkApiProcessImageBinding xapBinding =\n{\n";
+printf $header "    %-20s // signature\n", sprintf("0x%08X,", $signature);
+printf $header "    %-20s // sizeProcessImageIn\n", $piSize{input} . ",";
+printf $header "    %-20s // sizeProcessImageOut\n", $piSize{output} . ",";
+printf $header "    %-20s // linkCount\n", scalar(@links) . ",";
+printf $header "    %-20s // pLinks\n", "aXapBindingLink";
+print $header "};\n\n";
+
+print $header "#endif\n";
+close($header);
+
+exit 0;
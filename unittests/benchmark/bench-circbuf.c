@@ -0,0 +1,173 @@
+/**
+********************************************************************************
+\file   bench-circbuf.c
+
+\brief  Circular buffer benchmark case
+
+This file contains the benchmark case of the circular buffer library which is
+used for the event and asynchronous frame queues. One operation writes one
+block of pdoSize bytes per node into the buffer and reads all of them back.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "oplkbench.h"
+
+#include <common/circbuffer.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define BENCH_CIRCBUF_SIZE          65536
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tCircBufInstance*    pCircBuf_l = NULL;
+static UINT8                aWriteData_l[BENCH_MAX_PDO_SIZE];
+static UINT8                aReadData_l[BENCH_MAX_PDO_SIZE];
+static UINT                 nodeCount_l;
+static UINT                 blockSize_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError setupCircbuf(const tBenchParam* pParam_p);
+static tOplkError runCircbuf(void);
+static void       teardownCircbuf(void);
+
+//------------------------------------------------------------------------------
+// benchmark cases
+//------------------------------------------------------------------------------
+const tBenchCase benchCircbuf_g =
+{
+    "circbuf_write_read", setupCircbuf, runCircbuf, teardownCircbuf
+};
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up circular buffer benchmark case
+
+\param[in]      pParam_p            Parameter set.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setupCircbuf(const tBenchParam* pParam_p)
+{
+    UINT    i;
+
+    if (circbuf_alloc(CIRCBUF_KERNEL_INTERNAL_QUEUE, BENCH_CIRCBUF_SIZE, &pCircBuf_l) != kCircBufOk)
+        return kErrorNoResource;
+
+    for (i = 0; i < sizeof(aWriteData_l); i++)
+        aWriteData_l[i] = (UINT8)i;
+
+    nodeCount_l = pParam_p->nodeCount;
+    blockSize_l = pParam_p->pdoSize;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write and read one block per node
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError runCircbuf(void)
+{
+    UINT    i;
+    size_t  readSize;
+
+    for (i = 0; i < nodeCount_l; i++)
+    {
+        if (circbuf_writeData(pCircBuf_l, aWriteData_l, blockSize_l) != kCircBufOk)
+            return kErrorNoResource;
+    }
+
+    for (i = 0; i < nodeCount_l; i++)
+    {
+        if ((circbuf_readData(pCircBuf_l, aReadData_l, sizeof(aReadData_l), &readSize) != kCircBufOk) ||
+            (readSize != blockSize_l))
+            return kErrorNoResource;
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up circular buffer benchmark case
+*/
+//------------------------------------------------------------------------------
+static void teardownCircbuf(void)
+{
+    if (pCircBuf_l != NULL)
+    {
+        circbuf_free(pCircBuf_l);
+        pCircBuf_l = NULL;
+    }
+}
+
+/// \}
@@ -0,0 +1,159 @@
+/**
+********************************************************************************
+\file   bench-dllk.c
+
+\brief  DLL kernel benchmark case
+
+This file contains the benchmark case of the PRes reception path of the DLL
+kernel module on the MN. One operation passes the PRes frames of all
+configured nodes to dllkframe_processFrameReceived(), which includes the
+isochronous node list handling, the frame format check and the RPDO
+forwarding to the PDO kernel module.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "oplkbench.h"
+
+#include <kernel/dll/dllk-internal.h>
+#include <kernel/dll/dllkframe.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tPlkFrame        aPresFrame_l[BENCH_MAX_NODE_COUNT];
+static tEdrvRxBuffer    aRxBuffer_l[BENCH_MAX_NODE_COUNT];
+static UINT             nodeCount_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError setupDllkPres(const tBenchParam* pParam_p);
+static tOplkError runDllkPres(void);
+
+//------------------------------------------------------------------------------
+// benchmark cases
+//------------------------------------------------------------------------------
+const tBenchCase benchDllkPres_g =
+{
+    "dllkframe_pres", setupDllkPres, runDllkPres, NULL
+};
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up DLL PRes benchmark case
+
+\param[in]      pParam_p            Parameter set.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setupDllkPres(const tBenchParam* pParam_p)
+{
+    tOplkError  ret;
+    UINT        i;
+
+    ret = benchfixture_configurePdo(pParam_p);
+    if (ret != kErrorOk)
+        return ret;
+
+    for (i = 0; i < pParam_p->nodeCount; i++)
+    {
+        OPLK_MEMSET(&aRxBuffer_l[i], 0, sizeof(tEdrvRxBuffer));
+        aRxBuffer_l[i].bufferInFrame = kEdrvBufferLastInFrame;
+        aRxBuffer_l[i].pBuffer = &aPresFrame_l[i];
+        aRxBuffer_l[i].rxFrameSize = benchfixture_buildPres(benchfixture_getNodeId(i),
+                                                            pParam_p->pdoSize,
+                                                            &aPresFrame_l[i]);
+    }
+    nodeCount_l = pParam_p->nodeCount;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Receive the PRes frames of one cycle
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError runDllkPres(void)
+{
+    UINT    i;
+
+    // start of the isochronous phase
+    dllkInstance_g.curNodeIndex = 0;
+    dllkInstance_g.dllState = kDllMsWaitPres;
+
+    for (i = 0; i < nodeCount_l; i++)
+        dllkframe_processFrameReceived(&aRxBuffer_l[i]);
+
+    // all nodes must have been found in the isochronous node list
+    return (dllkInstance_g.curNodeIndex == nodeCount_l) ? kErrorOk : kErrorDllNoNodeInfo;
+}
+
+/// \}
@@ -0,0 +1,145 @@
+/**
+********************************************************************************
+\file   bench-obd.c
+
+\brief  Object dictionary benchmark case
+
+This file contains the benchmark case of the object dictionary read access.
+One operation reads all process image objects which are mapped to the RPDOs
+of the configured nodes with obdu_readEntry(). It therefore measures the
+index/sub-index lookup for pdoSize / 4 objects per node.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "oplkbench.h"
+
+#include <user/obdu.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static UINT     objectCount_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError setupObduRead(const tBenchParam* pParam_p);
+static tOplkError runObduRead(void);
+
+//------------------------------------------------------------------------------
+// benchmark cases
+//------------------------------------------------------------------------------
+const tBenchCase benchObduRead_g =
+{
+    "obdu_readEntry", setupObduRead, runObduRead, NULL
+};
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up object dictionary benchmark case
+
+\param[in]      pParam_p            Parameter set.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setupObduRead(const tBenchParam* pParam_p)
+{
+    objectCount_l = pParam_p->nodeCount * (pParam_p->pdoSize / sizeof(UINT32));
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Read all mapped objects
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError runObduRead(void)
+{
+    tOplkError  ret = kErrorOk;
+    UINT        obj;
+    UINT        index;
+    UINT        subIndex;
+    UINT32      value;
+    tObdSize    obdSize;
+
+    for (obj = 0; obj < objectCount_l; obj++)
+    {
+        index = benchfixture_getPiObject(FALSE, obj, &subIndex);
+        obdSize = sizeof(value);
+        ret = obdu_readEntry(index, subIndex, &value, &obdSize);
+        if (ret != kErrorOk)
+            break;
+    }
+
+    return ret;
+}
+
+/// \}
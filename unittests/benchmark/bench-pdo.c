@@ -0,0 +1,199 @@
+/**
+********************************************************************************
+\file   bench-pdo.c
+
+\brief  PDO benchmark cases
+
+This file contains the benchmark cases of the PDO modules. They measure the
+copy of the RPDOs into the process image (pdou_copyRxPdoToPi()), the copy of
+the TPDOs out of the process image (pdou_copyTxPdoFromPi()) and the kernel
+processing of received PRes frames (pdok_processRxPdo()).
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "oplkbench.h"
+
+#include <user/pdou.h>
+#include <kernel/pdok.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tPlkFrame    aPresFrame_l[BENCH_MAX_NODE_COUNT];
+static UINT         aPresFrameSize_l[BENCH_MAX_NODE_COUNT];
+static UINT         nodeCount_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError setupPdo(const tBenchParam* pParam_p);
+static tOplkError runPdouRx(void);
+static tOplkError runPdouTx(void);
+static tOplkError runPdokRx(void);
+
+//------------------------------------------------------------------------------
+// benchmark cases
+//------------------------------------------------------------------------------
+const tBenchCase benchPdouRx_g =
+{
+    "pdou_copyRxPdoToPi", setupPdo, runPdouRx, NULL
+};
+
+const tBenchCase benchPdouTx_g =
+{
+    "pdou_copyTxPdoFromPi", setupPdo, runPdouTx, NULL
+};
+
+const tBenchCase benchPdokRx_g =
+{
+    "pdok_processRxPdo", setupPdo, runPdokRx, NULL
+};
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up PDO benchmark cases
+
+The function configures the PDOs and prepares one PRes frame per node. The
+frames are processed once so that the RPDO buffers contain valid data.
+
+\param[in]      pParam_p            Parameter set.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setupPdo(const tBenchParam* pParam_p)
+{
+    tOplkError  ret;
+    UINT        i;
+
+    ret = benchfixture_configurePdo(pParam_p);
+    if (ret != kErrorOk)
+        return ret;
+
+    for (i = 0; i < pParam_p->nodeCount; i++)
+    {
+        aPresFrameSize_l[i] = benchfixture_buildPres(benchfixture_getNodeId(i),
+                                                     pParam_p->pdoSize,
+                                                     &aPresFrame_l[i]);
+    }
+    nodeCount_l = pParam_p->nodeCount;
+
+    return runPdokRx();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy all RPDOs into the process image
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError runPdouRx(void)
+{
+    return pdou_copyRxPdoToPi();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Copy all TPDOs from the process image
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError runPdouTx(void)
+{
+    return pdou_copyTxPdoFromPi();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Process the PRes frames of all nodes in the PDO kernel module
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError runPdokRx(void)
+{
+    tOplkError  ret = kErrorOk;
+    UINT        i;
+
+    for (i = 0; i < nodeCount_l; i++)
+    {
+        ret = pdok_processRxPdo(&aPresFrame_l[i], aPresFrameSize_l[i]);
+        if (ret != kErrorOk)
+            return ret;
+    }
+
+#if (CONFIG_PDO_CYCLE_COHERENT != FALSE)
+    // end of cycle
+    ret = pdok_exchangePdoImage();
+#endif
+
+    return ret;
+}
+
+/// \}
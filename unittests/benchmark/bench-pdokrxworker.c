@@ -0,0 +1,385 @@
+/**
+********************************************************************************
+\file   bench-pdokrxworker.c
+
+\brief  RPDO worker benchmark case
+
+This file contains the benchmark case of the kernel RPDO workers. One
+operation dispatches several PRes frames of every configured node to the RPDO
+workers, reassigns one node to another worker, passes the cycle boundary
+(pdok_processSync()) and copies the RPDOs into the process image. The case
+verifies that the frames of a node are copied in the order of their reception
+and that all of them have been copied when pdok_processSync() returns. The
+benchmark thread runs with a higher priority than the workers, so that the
+frames are queued until the benchmark thread waits for the workers.
+
+The case is only available if the benchmark is built with the RPDO workers
+(CFG_BENCH_PDOK_RX_WORKERS).
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+#include "oplkbench.h"
+
+#include <common/ami.h>
+#include <user/eventu.h>
+#include <user/obdu.h>
+#include <user/pdou.h>
+#include <kernel/pdok.h>
+#include <kernel/pdokrxworker.h>
+
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define BENCH_RXWORKER_FRAMES       4                                   // PRes frames of a node per operation
+#define BENCH_THREAD_PRIORITY       (PDOKRXWORKER_THREAD_PRIORITY + 1)  // SCHED_FIFO priority of the benchmark thread, which plays the receive thread
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tPlkFrame    aPresFrame_l[BENCH_MAX_NODE_COUNT][BENCH_RXWORKER_FRAMES];
+static tFrameInfo   aFrameInfo_l[BENCH_MAX_NODE_COUNT][BENCH_RXWORKER_FRAMES];
+static UINT         nodeCount_l;
+static UINT         objectCount_l;
+static UINT32       cycle_l;
+static int          schedPolicy_l;
+static struct sched_param schedParam_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError setupRxWorker(const tBenchParam* pParam_p);
+static tOplkError runRxWorker(void);
+static void       teardownRxWorker(void);
+static tOplkError setNodeWorker(UINT nodeId_p, UINT worker_p);
+static void       setFrameValue(tPlkFrame* pFrame_p, UINT32 value_p);
+static tOplkError checkRxImage(UINT32 value_p);
+static tOplkError checkDropCount(void);
+
+//------------------------------------------------------------------------------
+// benchmark cases
+//------------------------------------------------------------------------------
+const tBenchCase benchPdokRxWorker_g =
+{
+    "pdokrxworker_dispatch", setupRxWorker, runRxWorker, teardownRxWorker
+};
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up the RPDO worker benchmark case
+
+The function configures the PDOs and prepares the PRes frames of all nodes.
+The nodes are assigned to the workers in reverse order of the default
+assignment, like an application does with oplk_setRxPdoWorker(). The
+benchmark thread is raised above the priority of the workers like the receive
+thread of the Ethernet driver. If the benchmark thread is not allowed to
+change its priority, the ordering is only checked as far as the scheduler
+interleaves the threads.
+
+\param[in]      pParam_p            Parameter set.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setupRxWorker(const tBenchParam* pParam_p)
+{
+    tOplkError              ret;
+    UINT                    i;
+    UINT                    frame;
+    UINT8                   nodeId;
+    struct sched_param      schedParam;
+
+    ret = benchfixture_configurePdo(pParam_p);
+    if (ret != kErrorOk)
+        return ret;
+
+    pthread_getschedparam(pthread_self(), &schedPolicy_l, &schedParam_l);
+    OPLK_MEMSET(&schedParam, 0, sizeof(schedParam));
+    schedParam.sched_priority = BENCH_THREAD_PRIORITY;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &schedParam) != 0)
+        fprintf(stderr, "%s() couldn't raise the priority of the benchmark thread\n", __func__);
+
+    // an invalid worker must be rejected
+    if (setNodeWorker(benchfixture_getNodeId(0), CONFIG_PDOK_RX_WORKER_COUNT) !=
+        kErrorInvalidInstanceParam)
+        return kErrorGeneralError;
+
+    for (i = 0; i < pParam_p->nodeCount; i++)
+    {
+        nodeId = benchfixture_getNodeId(i);
+
+        ret = setNodeWorker(nodeId, (CONFIG_PDOK_RX_WORKER_COUNT - 1) - (nodeId % CONFIG_PDOK_RX_WORKER_COUNT));
+        if (ret != kErrorOk)
+            return ret;
+
+        for (frame = 0; frame < BENCH_RXWORKER_FRAMES; frame++)
+        {
+            aFrameInfo_l[i][frame].frameSize = benchfixture_buildPres(nodeId,
+                                                                      pParam_p->pdoSize,
+                                                                      &aPresFrame_l[i][frame]);
+            aFrameInfo_l[i][frame].frame.pBuffer = &aPresFrame_l[i][frame];
+        }
+    }
+
+    nodeCount_l = pParam_p->nodeCount;
+    objectCount_l = pParam_p->pdoSize / sizeof(UINT32);
+    cycle_l = 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Dispatch and copy the PRes frames of one cycle
+
+The function dispatches the frames of all nodes to the RPDO workers. Each frame
+carries a sequence value in all mapped objects. After the cycle boundary the
+process image must contain the value of the last frame of each node. An older
+value shows that the frames of a node have been reordered or that
+pdok_processSync() returned before the workers finished. No frame may be
+dropped, because the frames of a cycle fit into the queues.
+
+In the middle of the cycle one node is reassigned to another worker, while
+its previous frames are still queued.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError runRxWorker(void)
+{
+    tOplkError  ret;
+    UINT        i;
+    UINT        frame;
+    UINT32      value = 0;
+
+    cycle_l++;
+
+    for (frame = 0; frame < BENCH_RXWORKER_FRAMES; frame++)
+    {
+        value = (cycle_l * BENCH_RXWORKER_FRAMES) + frame;
+
+        if (frame == (BENCH_RXWORKER_FRAMES / 2))
+        {
+            ret = setNodeWorker(benchfixture_getNodeId(cycle_l % nodeCount_l),
+                                cycle_l % CONFIG_PDOK_RX_WORKER_COUNT);
+            if (ret != kErrorOk)
+                return ret;
+        }
+
+        for (i = 0; i < nodeCount_l; i++)
+        {
+            setFrameValue(&aPresFrame_l[i][frame], value);
+
+            ret = pdokrxworker_dispatch(&aFrameInfo_l[i][frame]);
+            if (ret != kErrorOk)
+                return ret;
+        }
+    }
+
+    // end of cycle
+    ret = pdok_processSync();
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = checkDropCount();
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = pdou_copyRxPdoToPi();
+    if (ret != kErrorOk)
+        return ret;
+
+    return checkRxImage(value);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up the RPDO worker benchmark case
+
+The function restores the priority of the benchmark thread.
+*/
+//------------------------------------------------------------------------------
+static void teardownRxWorker(void)
+{
+    pthread_setschedparam(pthread_self(), schedPolicy_l, &schedParam_l);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Assign a node to an RPDO worker
+
+The function posts the event to the PDO kernel CAL module, like
+oplk_setRxPdoWorker() does.
+
+\param[in]      nodeId_p            Node ID of the RPDO source.
+\param[in]      worker_p            Index of the RPDO worker.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setNodeWorker(UINT nodeId_p, UINT worker_p)
+{
+    tEvent              event;
+    tPdoRxWorkerParam   workerParam;
+
+    workerParam.nodeId = (UINT16)nodeId_p;
+    workerParam.worker = (UINT16)worker_p;
+
+    event.eventSink = kEventSinkPdokCal;
+    event.eventType = kEventTypePdokRxWorker;
+    event.eventArgSize = sizeof(workerParam);
+    event.eventArg.pEventArg = &workerParam;
+
+    return eventu_postEvent(&event);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set the sequence value of a PRes frame
+
+\param[out]     pFrame_p            Pointer to the frame.
+\param[in]      value_p             Value written into all mapped objects.
+*/
+//------------------------------------------------------------------------------
+static void setFrameValue(tPlkFrame* pFrame_p, UINT32 value_p)
+{
+    UINT    obj;
+
+    for (obj = 0; obj < objectCount_l; obj++)
+        ami_setUint32Le(&pFrame_p->data.pres.aPayload[obj * sizeof(UINT32)], value_p);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check the receive process image
+
+\param[in]      value_p             Value of the last frame of every node.
+
+\return The function returns kErrorOk if all mapped objects contain the value,
+        otherwise kErrorGeneralError.
+*/
+//------------------------------------------------------------------------------
+static tOplkError checkRxImage(UINT32 value_p)
+{
+    tOplkError  ret;
+    UINT        objCount = nodeCount_l * objectCount_l;
+    UINT        obj;
+    UINT        index;
+    UINT        subIndex;
+    UINT32      value;
+    tObdSize    obdSize;
+
+    for (obj = 0; obj < objCount; obj++)
+    {
+        index = benchfixture_getPiObject(FALSE, obj, &subIndex);
+        obdSize = (tObdSize)sizeof(value);
+        ret = obdu_readEntry(index, subIndex, &value, &obdSize);
+        if (ret != kErrorOk)
+            return ret;
+
+        if (value != value_p)
+        {
+            fprintf(stderr, "%s() object 0x%04X/%u contains %u instead of %u\n",
+                    __func__, index, subIndex, value, value_p);
+            return kErrorGeneralError;
+        }
+    }
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Check that no frame was dropped
+
+\return The function returns kErrorOk if no worker dropped a frame, otherwise
+        kErrorGeneralError.
+*/
+//------------------------------------------------------------------------------
+static tOplkError checkDropCount(void)
+{
+    tPdokRxWorkerStatistics statistics;
+    UINT                    worker;
+
+    for (worker = 0; worker < CONFIG_PDOK_RX_WORKER_COUNT; worker++)
+    {
+        pdokrxworker_getStatistics(worker, &statistics);
+        if ((statistics.fullDropCount != 0) || (statistics.pauseDropCount != 0))
+        {
+            fprintf(stderr, "%s() worker %u dropped %u frames of a full queue and %u paused frames\n",
+                    __func__, worker, statistics.fullDropCount, statistics.pauseDropCount);
+            return kErrorGeneralError;
+        }
+    }
+
+    return kErrorOk;
+}
+
+/// \}
+
+#endif /* (CONFIG_PDOK_RX_WORKER_COUNT != 0) */
@@ -0,0 +1,426 @@
+/**
+********************************************************************************
+\file   bench-sdoseq.c
+
+\brief  SDO sequence layer benchmark case
+
+This file contains the benchmark case of the SDO sequence layer. For every
+node a client connection is established over a loopback replacement of the
+SDO over ASnd protocol abstraction layer. The loopback connects each client
+connection to a server connection of the same sequence layer instance. One
+operation sends one segment of pdoSize bytes on every client connection and
+returns the acknowledge of the server.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include "oplkbench.h"
+
+#include <user/sdoseq.h>
+#include <user/sdoasnd.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define BENCH_SDO_QUEUE_SIZE        (2 * BENCH_MAX_NODE_COUNT)
+#define BENCH_SDO_FRAME_SIZE        (BENCH_MAX_PDO_SIZE + 64)
+
+// The client connection to node n uses the lower layer handle 2n, the
+// corresponding server connection the handle 2n + 1.
+#define BENCH_SDO_PEER_HANDLE(hdl)  ((hdl) ^ 0x0001)
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Loopback frame
+
+The structure holds a frame which was sent by the sequence layer and is not
+yet delivered to the peer connection.
+*/
+typedef struct
+{
+    tSdoConHdl          conHdl;                             ///< Lower layer handle of the sender
+    size_t              size;                               ///< Size of the sequence layer frame
+    UINT8               aFrame[BENCH_SDO_FRAME_SIZE];       ///< Frame data
+} tBenchSdoFrame;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static tSequLayerReceiveCb  pfnReceiveCb_l = NULL;
+static tBenchSdoFrame       aQueue_l[BENCH_SDO_QUEUE_SIZE];
+static UINT                 queueReadIndex_l;
+static UINT                 queueWriteIndex_l;
+static tSdoSeqConHdl        aClientHdl_l[BENCH_MAX_NODE_COUNT];
+static tSdoSeqConHdl        aAckHdl_l[BENCH_MAX_NODE_COUNT];
+static UINT                 ackCount_l;
+static UINT                 connectedCount_l;
+static UINT                 receivedCount_l;
+static UINT                 nodeCount_l;
+static UINT                 segmentSize_l;
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError setupSdoSeq(const tBenchParam* pParam_p);
+static tOplkError runSdoSeq(void);
+static void       teardownSdoSeq(void);
+static tOplkError pumpFrames(void);
+static tOplkError cbSdoComReceive(tSdoSeqConHdl sdoSeqConHdl_p,
+                                  const tAsySdoCom* pAsySdoCom_p,
+                                  size_t dataSize_p);
+static tOplkError cbSdoComCon(tSdoSeqConHdl sdoSeqConHdl_p,
+                              tAsySdoConState asySdoConState_p);
+
+//------------------------------------------------------------------------------
+// benchmark cases
+//------------------------------------------------------------------------------
+const tBenchCase benchSdoSeq_g =
+{
+    "sdoseq_segment", setupSdoSeq, runSdoSeq, teardownSdoSeq
+};
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize SDO over ASnd loopback
+
+\param[in]      pfnReceiveCb_p      Receive callback of the sequence layer.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+tOplkError sdoasnd_init(tSequLayerReceiveCb pfnReceiveCb_p)
+{
+    pfnReceiveCb_l = pfnReceiveCb_p;
+    queueReadIndex_l = 0;
+    queueWriteIndex_l = 0;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Shut down SDO over ASnd loopback
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+tOplkError sdoasnd_exit(void)
+{
+    pfnReceiveCb_l = NULL;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize a client connection of the SDO over ASnd loopback
+
+\param[out]     pSdoConHandle_p     Pointer to store the connection handle.
+\param[in]      targetNodeId_p      Node ID of the target.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+tOplkError sdoasnd_initCon(tSdoConHdl* pSdoConHandle_p, UINT targetNodeId_p)
+{
+    *pSdoConHandle_p = SDO_ASND_HANDLE | ((targetNodeId_p - 1) << 1);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Send data via the SDO over ASnd loopback
+
+The frame is queued and delivered to the peer connection by pumpFrames().
+
+\param[in]      sdoConHandle_p      Connection handle of the sender.
+\param[in]      pSrcData_p          Frame to send.
+\param[in]      dataSize_p          Size of the sequence layer frame.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+tOplkError sdoasnd_sendData(tSdoConHdl sdoConHandle_p,
+                            tPlkFrame* pSrcData_p,
+                            size_t dataSize_p)
+{
+    tBenchSdoFrame* pEntry;
+    size_t          offset;
+
+    offset = (size_t)((UINT8*)&pSrcData_p->data.asnd.payload.sdoSequenceFrame - (UINT8*)pSrcData_p);
+    if ((queueWriteIndex_l - queueReadIndex_l) >= BENCH_SDO_QUEUE_SIZE)
+        return kErrorDllAsyncTxBufferFull;
+
+    if ((dataSize_p + offset) > BENCH_SDO_FRAME_SIZE)
+        return kErrorSdoSeqFrameSizeError;
+
+    pEntry = &aQueue_l[queueWriteIndex_l % BENCH_SDO_QUEUE_SIZE];
+    pEntry->conHdl = sdoConHandle_p;
+    pEntry->size = dataSize_p;
+    OPLK_MEMCPY(pEntry->aFrame, pSrcData_p, dataSize_p + offset);
+    queueWriteIndex_l++;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Delete a connection of the SDO over ASnd loopback
+
+\param[in]      sdoConHandle_p      Connection handle.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+tOplkError sdoasnd_deleteCon(tSdoConHdl sdoConHandle_p)
+{
+    UNUSED_PARAMETER(sdoConHandle_p);
+
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Set up SDO sequence layer benchmark case
+
+The function initializes the sequence layer and establishes one client
+connection per node.
+
+\param[in]      pParam_p            Parameter set.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError setupSdoSeq(const tBenchParam* pParam_p)
+{
+    tOplkError  ret;
+    UINT        i;
+
+    connectedCount_l = 0;
+    ackCount_l = 0;
+    nodeCount_l = pParam_p->nodeCount;
+    segmentSize_l = pParam_p->pdoSize;
+
+    ret = sdoseq_init(cbSdoComReceive, cbSdoComCon);
+    if (ret != kErrorOk)
+        return ret;
+
+    for (i = 0; i < nodeCount_l; i++)
+    {
+        ret = sdoseq_initCon(&aClientHdl_l[i], benchfixture_getNodeId(i), kSdoTypeAsnd);
+        if (ret != kErrorOk)
+            return ret;
+
+        ret = pumpFrames();
+        if (ret != kErrorOk)
+            return ret;
+    }
+
+    // client and server side of every connection report the connection
+    if (connectedCount_l != (2 * nodeCount_l))
+        return kErrorSdoSeqConnectionBusy;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Transfer one segment on every connection
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError runSdoSeq(void)
+{
+    tOplkError  ret;
+    tPlkFrame*  pFrame;
+    UINT        i;
+
+    receivedCount_l = 0;
+
+    for (i = 0; i < nodeCount_l; i++)
+    {
+        // the segment is built in place like the command layer does
+        pFrame = sdoseq_allocTxFrame();
+        if (pFrame == NULL)
+            return kErrorSdoSeqNoFreeHistory;
+
+        ret = sdoseq_sendData(aClientHdl_l[i], segmentSize_l, pFrame);
+        if (ret != kErrorOk)
+            return ret;
+    }
+
+    ret = pumpFrames();
+    if (ret != kErrorOk)
+        return ret;
+
+    // acknowledge the received segments from the server side
+    for (i = 0; i < ackCount_l; i++)
+    {
+        ret = sdoseq_sendData(aAckHdl_l[i], 0, NULL);
+        if (ret != kErrorOk)
+            return ret;
+    }
+    ackCount_l = 0;
+
+    ret = pumpFrames();
+    if (ret != kErrorOk)
+        return ret;
+
+    return (receivedCount_l == nodeCount_l) ? kErrorOk : kErrorSdoSeqInvalidFrame;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up SDO sequence layer benchmark case
+*/
+//------------------------------------------------------------------------------
+static void teardownSdoSeq(void)
+{
+    sdoseq_exit();
+    queueReadIndex_l = 0;
+    queueWriteIndex_l = 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Deliver all queued frames to their peer connections
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError pumpFrames(void)
+{
+    tOplkError      ret = kErrorOk;
+    tBenchSdoFrame* pEntry;
+    tPlkFrame*      pFrame;
+
+    while ((queueReadIndex_l != queueWriteIndex_l) && (pfnReceiveCb_l != NULL))
+    {
+        pEntry = &aQueue_l[queueReadIndex_l % BENCH_SDO_QUEUE_SIZE];
+        queueReadIndex_l++;
+
+        pFrame = (tPlkFrame*)pEntry->aFrame;
+        ret = pfnReceiveCb_l(BENCH_SDO_PEER_HANDLE(pEntry->conHdl),
+                             &pFrame->data.asnd.payload.sdoSequenceFrame,
+                             pEntry->size);
+        if (ret != kErrorOk)
+            break;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Command layer receive callback
+
+\param[in]      sdoSeqConHdl_p      Sequence layer connection handle.
+\param[in]      pAsySdoCom_p        Received command layer frame.
+\param[in]      dataSize_p          Size of the command layer frame.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError cbSdoComReceive(tSdoSeqConHdl sdoSeqConHdl_p,
+                                  const tAsySdoCom* pAsySdoCom_p,
+                                  size_t dataSize_p)
+{
+    UNUSED_PARAMETER(pAsySdoCom_p);
+
+    if (dataSize_p != segmentSize_l)
+        return kErrorSdoSeqInvalidFrame;
+
+    if (ackCount_l < BENCH_MAX_NODE_COUNT)
+        aAckHdl_l[ackCount_l++] = sdoSeqConHdl_p;
+
+    receivedCount_l++;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Command layer connection callback
+
+\param[in]      sdoSeqConHdl_p      Sequence layer connection handle.
+\param[in]      asySdoConState_p    New connection state.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError cbSdoComCon(tSdoSeqConHdl sdoSeqConHdl_p,
+                              tAsySdoConState asySdoConState_p)
+{
+    UNUSED_PARAMETER(sdoSeqConHdl_p);
+
+    if (asySdoConState_p == kAsySdoConStateConnected)
+        connectedCount_l++;
+
+    return kErrorOk;
+}
+
+/// \}
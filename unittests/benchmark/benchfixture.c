@@ -0,0 +1,535 @@
+/**
+********************************************************************************
+\file   benchfixture.c
+
+\brief  Stack fixture of the openPOWERLINK cycle benchmark suite
+
+This file sets up the parts of a managing node stack which are exercised by
+the benchmark cases: the object dictionary of the CiA302-4 MN, the PDO user
+and kernel modules and the DLL kernel module. The PDOs are configured through
+the object dictionary the same way an application or the configuration manager
+does it, so the measured code paths are the productive ones.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+
+#include "oplkbench.h"
+
+#include <common/ami.h>
+#include <user/obdu.h>
+#include <user/pdou.h>
+#include <kernel/pdok.h>
+#include <kernel/dll/dllk-internal.h>
+#include <obdcreate/obdcreate.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define BENCH_PI_OBJ_SUBINDEXES     252         // Sub-indices of a process image array object
+#define BENCH_PI_OBJ_INDEXES        4           // Number of UINT32 process image array objects
+#define BENCH_PI_OBJ_COUNT          (BENCH_PI_OBJ_SUBINDEXES * BENCH_PI_OBJ_INDEXES)
+#define BENCH_PI_RX_INDEX           0xA680      // PI_OUT_AU32 (VPRW, mapped by RPDOs)
+#define BENCH_PI_TX_INDEX           0xA200      // PI_IN_AU32 (VPR, mapped by TPDOs)
+
+#define BENCH_RX_COMM_PARAM         0x1400
+#define BENCH_RX_MAPP_PARAM         0x1600
+#define BENCH_TX_COMM_PARAM         0x1800
+#define BENCH_TX_MAPP_PARAM         0x1A00
+#define BENCH_PRES_LIMIT_LIST       0x1F8D
+#define BENCH_PREQ_LIMIT_LIST       0x1F8B
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static UINT32   aRxImage_l[BENCH_PI_OBJ_COUNT];
+static UINT32   aTxImage_l[BENCH_PI_OBJ_COUNT];
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError cbObdAccess(tObdCbParam* pParam_p, BOOL fUserEvent_p);
+static tOplkError linkProcessImage(UINT index_p, UINT32* pImage_p);
+static tOplkError writeEntry(UINT index_p, UINT subIndex_p, UINT64 value_p, tObdSize size_p);
+static tOplkError configureChannel(BOOL fTx_p,
+                                   UINT channel_p,
+                                   UINT8 nodeId_p,
+                                   UINT objectCount_p);
+static tOplkError changeNmtState(tNmtState newNmtState_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Initialize benchmark stack fixture
+
+The function initializes the object dictionary, the DLL kernel module and the
+PDO modules of a managing node.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+tOplkError benchfixture_init(void)
+{
+    tOplkError      ret;
+    tObdInitParam   obdInitParam;
+
+    ret = obdcreate_initObd(&obdInitParam);
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = obdu_init(&obdInitParam, cbObdAccess);
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = obdu_setNodeId(C_ADR_MN_DEF_NODE_ID, kObdNodeIdHardware);
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = linkProcessImage(BENCH_PI_RX_INDEX, aRxImage_l);
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = linkProcessImage(BENCH_PI_TX_INDEX, aTxImage_l);
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = dllk_init();
+    if (ret != kErrorOk)
+        return ret;
+
+    dllkInstance_g.dllConfigParam.nodeId = C_ADR_MN_DEF_NODE_ID;
+    dllkInstance_g.dllConfigParam.isochrRxMaxPayload = C_DLL_ISOCHR_MAX_PAYL;
+    dllkInstance_g.dllConfigParam.isochrTxMaxPayload = C_DLL_ISOCHR_MAX_PAYL;
+
+    ret = pdok_init();
+    if (ret != kErrorOk)
+        return ret;
+
+    return pdou_init();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Clean up benchmark stack fixture
+*/
+//------------------------------------------------------------------------------
+void benchfixture_exit(void)
+{
+    changeNmtState(kNmtGsResetCommunication);
+    pdou_exit();
+    pdok_exit();
+    dllk_exit();
+    obdu_exit();
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Configure PDOs for a parameter set
+
+The function configures one RPDO and one TPDO channel for each node of the
+parameter set. Every channel maps pdoSize / 4 UINT32 process image objects.
+Afterwards the DLL is switched into the cyclic MN state waiting for PRes
+frames of the configured nodes.
+
+\param[in]      pParam_p            Parameter set to configure.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+tOplkError benchfixture_configurePdo(const tBenchParam* pParam_p)
+{
+    tOplkError      ret;
+    UINT            channel;
+    UINT8           nodeId;
+    UINT            objectCount = pParam_p->pdoSize / sizeof(UINT32);
+    tDllNodeInfo    nodeInfo;
+
+    ret = changeNmtState(kNmtGsResetCommunication);
+    if (ret != kErrorOk)
+        return ret;
+
+    for (channel = 0; channel < BENCH_MAX_NODE_COUNT; channel++)
+    {
+        nodeId = (channel < pParam_p->nodeCount) ? benchfixture_getNodeId(channel) : 0;
+
+        ret = configureChannel(FALSE, channel, nodeId, (nodeId != 0) ? objectCount : 0);
+        if (ret != kErrorOk)
+            return ret;
+
+        ret = configureChannel(TRUE, channel, nodeId, (nodeId != 0) ? objectCount : 0);
+        if (ret != kErrorOk)
+            return ret;
+
+        if (nodeId == 0)
+            continue;
+
+        OPLK_MEMSET(&nodeInfo, 0, sizeof(nodeInfo));
+        nodeInfo.nodeId = nodeId;
+        nodeInfo.presPayloadLimit = (UINT16)pParam_p->pdoSize;
+        nodeInfo.preqPayloadLimit = (UINT16)pParam_p->pdoSize;
+        nodeInfo.presTimeoutNs = 100000;
+        ret = dllk_configNode(&nodeInfo);
+        if (ret != kErrorOk)
+            return ret;
+    }
+
+    ret = changeNmtState(kNmtGsResetConfiguration);
+    if (ret != kErrorOk)
+        return ret;
+
+    // Let the DLL wait for the PRes frames of the configured nodes in the
+    // first isochronous slot. The nodes are already operational, therefore
+    // no heartbeat events are generated while processing their frames.
+    for (channel = 0; channel < pParam_p->nodeCount; channel++)
+    {
+        nodeId = benchfixture_getNodeId(channel);
+        dllkInstance_g.aCnNodeIdList[0][channel] = nodeId;
+        dllkInstance_g.aNodeInfo[nodeId - 1].nmtState = kNmtCsOperational;
+    }
+    dllkInstance_g.aCnNodeIdList[0][pParam_p->nodeCount] = C_ADR_INVALID;
+    dllkInstance_g.curTxBufferOffsetCycle = 0;
+    dllkInstance_g.curNodeIndex = 0;
+    dllkInstance_g.dllState = kDllMsWaitPres;
+    dllkInstance_g.nmtState = kNmtMsOperational;
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get node ID of a node index
+
+\param[in]      nodeIndex_p         Index of the node (0 .. nodeCount - 1).
+
+\return The function returns the node ID.
+*/
+//------------------------------------------------------------------------------
+UINT8 benchfixture_getNodeId(UINT nodeIndex_p)
+{
+    return (UINT8)(nodeIndex_p + 1);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get receive process image
+
+\return The function returns a pointer to the process image written by RPDOs.
+*/
+//------------------------------------------------------------------------------
+void* benchfixture_getRxImage(void)
+{
+    return aRxImage_l;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get transmit process image
+
+\return The function returns a pointer to the process image read by TPDOs.
+*/
+//------------------------------------------------------------------------------
+void* benchfixture_getTxImage(void)
+{
+    return aTxImage_l;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get process image object
+
+The function translates a running object number into an object index and
+sub-index of the linked process image. The number is wrapped if it exceeds
+the available objects.
+
+\param[in]      fTx_p               TRUE for the transmit process image.
+\param[in]      objNumber_p         Running object number.
+\param[out]     pSubIndex_p         Pointer to store the sub-index.
+
+\return The function returns the object index.
+*/
+//------------------------------------------------------------------------------
+UINT benchfixture_getPiObject(BOOL fTx_p, UINT objNumber_p, UINT* pSubIndex_p)
+{
+    UINT    baseIndex = fTx_p ? BENCH_PI_TX_INDEX : BENCH_PI_RX_INDEX;
+
+    objNumber_p %= BENCH_PI_OBJ_COUNT;
+    *pSubIndex_p = (objNumber_p % BENCH_PI_OBJ_SUBINDEXES) + 1;
+
+    return baseIndex + (objNumber_p / BENCH_PI_OBJ_SUBINDEXES);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Build PRes frame
+
+The function builds the PRes frame of an operational CN carrying a PDO of the
+given size.
+
+\param[in]      nodeId_p            Node ID of the sending CN.
+\param[in]      pdoSize_p           Size of the PDO payload.
+\param[out]     pFrame_p            Pointer to store the frame.
+
+\return The function returns the size of the frame.
+*/
+//------------------------------------------------------------------------------
+UINT benchfixture_buildPres(UINT8 nodeId_p, UINT pdoSize_p, tPlkFrame* pFrame_p)
+{
+    UINT    i;
+
+    OPLK_MEMSET(pFrame_p, 0, sizeof(tPlkFrame));
+    ami_setUint16Be(&pFrame_p->etherType, C_DLL_ETHERTYPE_EPL);
+    ami_setUint8Le(&pFrame_p->messageType, (UINT8)kMsgTypePres);
+    ami_setUint8Le(&pFrame_p->dstNodeId, C_ADR_BROADCAST);
+    ami_setUint8Le(&pFrame_p->srcNodeId, nodeId_p);
+    ami_setUint8Le(&pFrame_p->data.pres.nmtStatus, (UINT8)kNmtCsOperational);
+    ami_setUint8Le(&pFrame_p->data.pres.flag1, PLK_FRAME_FLAG1_RD);
+    ami_setUint8Le(&pFrame_p->data.pres.pdoVersion, 0);
+    ami_setUint16Le(&pFrame_p->data.pres.sizeLe, (UINT16)pdoSize_p);
+
+    for (i = 0; i < pdoSize_p; i++)
+        pFrame_p->data.pres.aPayload[i] = (UINT8)(nodeId_p + i);
+
+    return pdoSize_p + PLK_FRAME_OFFSET_PDO_PAYLOAD;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Object dictionary access callback
+
+The function forwards accesses of PDO objects to the PDO user module, like
+the ctrlu module does in the productive stack.
+
+\param[in,out]  pParam_p            OBD callback parameter.
+\param[in]      fUserEvent_p        User event flag (unused).
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError cbObdAccess(tObdCbParam* pParam_p, BOOL fUserEvent_p)
+{
+    UNUSED_PARAMETER(fUserEvent_p);
+
+    if (((pParam_p->index >= 0x1400) && (pParam_p->index <= 0x14FF)) ||
+        ((pParam_p->index >= 0x1600) && (pParam_p->index <= 0x16FF)) ||
+        ((pParam_p->index >= 0x1800) && (pParam_p->index <= 0x18FF)) ||
+        ((pParam_p->index >= 0x1A00) && (pParam_p->index <= 0x1AFF)))
+        return pdou_cbObdAccess(pParam_p);
+
+    return kErrorOk;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Link process image to object dictionary
+
+\param[in]      index_p             Index of the process image array object.
+\param[in]      pImage_p            Process image memory of
+                                    BENCH_PI_OBJ_SUBINDEXES * BENCH_PI_OBJ_INDEXES
+                                    UINT32 values.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError linkProcessImage(UINT index_p, UINT32* pImage_p)
+{
+    tOplkError  ret = kErrorOk;
+    tVarParam   varParam;
+    UINT        obj;
+
+    varParam.validFlag = kVarValidAll;
+    varParam.size = sizeof(UINT32);
+
+    for (obj = 0; obj < BENCH_PI_OBJ_COUNT; obj++)
+    {
+        varParam.index = index_p + (obj / BENCH_PI_OBJ_SUBINDEXES);
+        varParam.subindex = (obj % BENCH_PI_OBJ_SUBINDEXES) + 1;
+        varParam.pData = &pImage_p[obj];
+        ret = obdu_defineVar(&varParam);
+        if (ret != kErrorOk)
+            break;
+    }
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write numeric object dictionary entry
+
+\param[in]      index_p             Object index.
+\param[in]      subIndex_p          Object sub-index.
+\param[in]      value_p             Value to write.
+\param[in]      size_p              Size of the object (1, 2 or 8 bytes).
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError writeEntry(UINT index_p, UINT subIndex_p, UINT64 value_p, tObdSize size_p)
+{
+    UINT8   value8 = (UINT8)value_p;
+    UINT16  value16 = (UINT16)value_p;
+
+    switch (size_p)
+    {
+        case sizeof(UINT8):
+            return obdu_writeEntry(index_p, subIndex_p, &value8, size_p);
+
+        case sizeof(UINT16):
+            return obdu_writeEntry(index_p, subIndex_p, &value16, size_p);
+
+        default:
+            return obdu_writeEntry(index_p, subIndex_p, &value_p, size_p);
+    }
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Configure a PDO channel in the object dictionary
+
+The function writes the communication and mapping parameters of a PDO. If
+the node ID is 0, the PDO is disabled.
+
+\param[in]      fTx_p               TRUE for TPDO, FALSE for RPDO.
+\param[in]      channel_p           PDO number (offset to the parameter objects).
+\param[in]      nodeId_p            Node ID of the PDO.
+\param[in]      objectCount_p       Number of UINT32 objects to map.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError configureChannel(BOOL fTx_p,
+                                   UINT channel_p,
+                                   UINT8 nodeId_p,
+                                   UINT objectCount_p)
+{
+    tOplkError  ret;
+    UINT        commIndex = (fTx_p ? BENCH_TX_COMM_PARAM : BENCH_RX_COMM_PARAM) + channel_p;
+    UINT        mappIndex = (fTx_p ? BENCH_TX_MAPP_PARAM : BENCH_RX_MAPP_PARAM) + channel_p;
+    UINT        obj;
+    UINT        index;
+    UINT        subIndex;
+    UINT64      mapping;
+
+    ret = writeEntry(mappIndex, 0, 0, sizeof(UINT8));
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = writeEntry(commIndex, 1, nodeId_p, sizeof(UINT8));
+    if ((ret != kErrorOk) || (nodeId_p == 0))
+        return ret;
+
+    ret = writeEntry(commIndex, 2, 0, sizeof(UINT8));
+    if (ret != kErrorOk)
+        return ret;
+
+    ret = writeEntry(fTx_p ? BENCH_PREQ_LIMIT_LIST : BENCH_PRES_LIMIT_LIST,
+                     nodeId_p,
+                     objectCount_p * sizeof(UINT32),
+                     sizeof(UINT16));
+    if (ret != kErrorOk)
+        return ret;
+
+    for (obj = 0; obj < objectCount_p; obj++)
+    {
+        index = benchfixture_getPiObject(fTx_p, (channel_p * objectCount_p) + obj, &subIndex);
+        mapping = (UINT64)index |
+                  ((UINT64)subIndex << 16) |
+                  ((UINT64)(obj * 32) << 32) |
+                  ((UINT64)32 << 48);
+
+        ret = writeEntry(mappIndex, obj + 1, mapping, sizeof(UINT64));
+        if (ret != kErrorOk)
+            return ret;
+    }
+
+    return writeEntry(mappIndex, 0, objectCount_p, sizeof(UINT8));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Forward NMT state change to the modules
+
+\param[in]      newNmtState_p       New NMT state.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError changeNmtState(tNmtState newNmtState_p)
+{
+    tEventNmtStateChange    nmtStateChange;
+
+    dllkInstance_g.nmtState = newNmtState_p;
+    dllkInstance_g.dllState = kDllGsInit;
+
+    OPLK_MEMSET(&nmtStateChange, 0, sizeof(nmtStateChange));
+    nmtStateChange.oldNmtState = kNmtMsOperational;
+    nmtStateChange.newNmtState = newNmtState_p;
+    nmtStateChange.nmtEvent = kNmtEventNoEvent;
+
+    return pdou_cbNmtStateChange(nmtStateChange);
+}
+
+/// \}
@@ -0,0 +1,667 @@
+/**
+********************************************************************************
+\file   oplkbench.c
+
+\brief  Driver of the openPOWERLINK cycle benchmark suite
+
+This file contains the driver of the benchmark suite. It executes every
+benchmark case for each combination of the configured node counts and PDO
+sizes, reports the time per operation and its percentiles and stores the
+results in a JSON file. If a baseline JSON file is given, the results are
+compared against it and regressions of the median are reported.
+
+Usage: oplkbench [-i iterations] [-w warmup] [-n nodes] [-s sizes]
+                 [-f filter] [-o output.json] [-b baseline.json] [-t percent]
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "oplkbench.h"
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define BENCH_DEFAULT_ITERATIONS        2000
+#define BENCH_DEFAULT_WARMUP            200
+#define BENCH_DEFAULT_THRESHOLD         10      // [%] allowed increase of the median
+#define BENCH_DEFAULT_OUTPUT            "oplkbench.json"
+#define BENCH_MAX_PARAM_VALUES          8
+#define BENCH_MAX_NAME_LEN              64
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+/**
+\brief  Benchmark result
+
+The structure holds the statistics of one benchmark case executed with one
+parameter set.
+*/
+typedef struct
+{
+    const char*         pName;              ///< Name of the benchmark case
+    tBenchParam         param;              ///< Parameter set
+    double              meanNs;             ///< Mean time per operation
+    UINT64              p50Ns;              ///< Median time per operation
+    UINT64              p90Ns;              ///< 90th percentile
+    UINT64              p99Ns;              ///< 99th percentile
+    UINT64              maxNs;              ///< Worst case time per operation
+} tBenchResult;
+
+/**
+\brief  Benchmark options
+
+The structure holds the options given on the command line.
+*/
+typedef struct
+{
+    UINT                iterations;                             ///< Timed operations per parameter set
+    UINT                warmup;                                 ///< Untimed operations per parameter set
+    UINT                aNodeCount[BENCH_MAX_PARAM_VALUES];     ///< Node counts to run
+    UINT                nodeCountNum;                           ///< Number of valid entries in aNodeCount
+    UINT                aPdoSize[BENCH_MAX_PARAM_VALUES];       ///< PDO sizes to run
+    UINT                pdoSizeNum;                             ///< Number of valid entries in aPdoSize
+    const char*         pFilter;                                ///< Only run cases containing this string
+    const char*         pOutputFile;                            ///< JSON result file
+    const char*         pBaselineFile;                          ///< JSON baseline to compare against
+    UINT                threshold;                              ///< Regression threshold in percent
+} tBenchOptions;
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static const tBenchCase* const  apBenchCases_l[] =
+{
+    &benchPdouRx_g,
+    &benchPdouTx_g,
+    &benchPdokRx_g,
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+    &benchPdokRxWorker_g,
+#endif
+    &benchDllkPres_g,
+    &benchCircbuf_g,
+    &benchObduRead_g,
+    &benchSdoSeq_g,
+};
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static int        parseOptions(int argc, char** argv, tBenchOptions* pOptions_p);
+static UINT       parseList(const char* pString_p, UINT* pList_p, UINT maxEntries_p);
+static void       printUsage(const char* pProgName_p);
+static UINT64     getTimeNs(void);
+static int        compareUint64(const void* pA_p, const void* pB_p);
+static UINT64     getPercentile(const UINT64* pSorted_p, UINT count_p, UINT percentile_p);
+static tOplkError runCase(const tBenchCase* pCase_p,
+                          const tBenchParam* pParam_p,
+                          const tBenchOptions* pOptions_p,
+                          UINT64* pSamples_p,
+                          tBenchResult* pResult_p);
+static int        writeJson(const char* pFileName_p,
+                            const tBenchOptions* pOptions_p,
+                            const tBenchResult* pResults_p,
+                            UINT resultCount_p);
+static int        compareBaseline(const char* pFileName_p,
+                                  UINT threshold_p,
+                                  const tBenchResult* pResults_p,
+                                  UINT resultCount_p);
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+/**
+\brief  Main function of the benchmark suite
+
+\param[in]      argc                Number of command line arguments.
+\param[in]      argv                Pointer to the command line arguments.
+
+\return The function returns 0 on success, 1 if a regression against the
+        baseline was detected and 2 on any other error.
+*/
+//------------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+    tBenchOptions   options;
+    tBenchResult*   pResults;
+    UINT64*         pSamples;
+    UINT            resultCount = 0;
+    UINT            caseIndex;
+    UINT            nodeIndex;
+    UINT            sizeIndex;
+    tBenchParam     param;
+    int             exitCode = 0;
+    tOplkError      ret;
+
+    if (parseOptions(argc, argv, &options) != 0)
+        return 2;
+
+    pResults = (tBenchResult*)calloc(tabentries(apBenchCases_l) * options.nodeCountNum * options.pdoSizeNum,
+                                     sizeof(tBenchResult));
+    pSamples = (UINT64*)malloc(options.iterations * sizeof(UINT64));
+    if ((pResults == NULL) || (pSamples == NULL))
+    {
+        fprintf(stderr, "Unable to allocate result memory\n");
+        return 2;
+    }
+
+    ret = benchfixture_init();
+    if (ret != kErrorOk)
+    {
+        fprintf(stderr, "Unable to initialize the stack fixture (0x%04X)\n", ret);
+        return 2;
+    }
+
+    printf("%-24s %5s %7s %12s %10s %10s %10s %10s\n",
+           "benchmark", "nodes", "pdosize", "mean[ns/op]", "p50", "p90", "p99", "max");
+
+    for (caseIndex = 0; caseIndex < tabentries(apBenchCases_l); caseIndex++)
+    {
+        const tBenchCase* pCase = apBenchCases_l[caseIndex];
+
+        if ((options.pFilter != NULL) && (strstr(pCase->pName, options.pFilter) == NULL))
+            continue;
+
+        for (nodeIndex = 0; nodeIndex < options.nodeCountNum; nodeIndex++)
+        {
+            for (sizeIndex = 0; sizeIndex < options.pdoSizeNum; sizeIndex++)
+            {
+                tBenchResult* pResult = &pResults[resultCount];
+
+                param.nodeCount = options.aNodeCount[nodeIndex];
+                param.pdoSize = options.aPdoSize[sizeIndex];
+
+                ret = runCase(pCase, &param, &options, pSamples, pResult);
+                if (ret != kErrorOk)
+                {
+                    fprintf(stderr, "%s nodes=%u pdosize=%u failed (0x%04X)\n",
+                            pCase->pName, param.nodeCount, param.pdoSize, ret);
+                    exitCode = 2;
+                    continue;
+                }
+
+                printf("%-24s %5u %7u %12.1f %10llu %10llu %10llu %10llu\n",
+                       pResult->pName,
+                       pResult->param.nodeCount,
+                       pResult->param.pdoSize,
+                       pResult->meanNs,
+                       (unsigned long long)pResult->p50Ns,
+                       (unsigned long long)pResult->p90Ns,
+                       (unsigned long long)pResult->p99Ns,
+                       (unsigned long long)pResult->maxNs);
+                resultCount++;
+            }
+        }
+    }
+
+    benchfixture_exit();
+
+    if (writeJson(options.pOutputFile, &options, pResults, resultCount) != 0)
+        exitCode = 2;
+
+    if ((exitCode == 0) && (options.pBaselineFile != NULL))
+        exitCode = compareBaseline(options.pBaselineFile, options.threshold, pResults, resultCount);
+
+    free(pSamples);
+    free(pResults);
+
+    return exitCode;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Parse command line options
+
+\param[in]      argc                Number of command line arguments.
+\param[in]      argv                Pointer to the command line arguments.
+\param[out]     pOptions_p          Pointer to store the options.
+
+\return The function returns 0 on success, otherwise -1.
+*/
+//------------------------------------------------------------------------------
+static int parseOptions(int argc, char** argv, tBenchOptions* pOptions_p)
+{
+    int     opt;
+
+    memset(pOptions_p, 0, sizeof(tBenchOptions));
+    pOptions_p->iterations = BENCH_DEFAULT_ITERATIONS;
+    pOptions_p->warmup = BENCH_DEFAULT_WARMUP;
+    pOptions_p->threshold = BENCH_DEFAULT_THRESHOLD;
+    pOptions_p->pOutputFile = BENCH_DEFAULT_OUTPUT;
+    pOptions_p->nodeCountNum = parseList("1,10,40", pOptions_p->aNodeCount, BENCH_MAX_PARAM_VALUES);
+    pOptions_p->pdoSizeNum = parseList("16,64,256", pOptions_p->aPdoSize, BENCH_MAX_PARAM_VALUES);
+
+    while ((opt = getopt(argc, argv, "i:w:n:s:f:o:b:t:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'i':
+                pOptions_p->iterations = (UINT)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'w':
+                pOptions_p->warmup = (UINT)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'n':
+                pOptions_p->nodeCountNum = parseList(optarg, pOptions_p->aNodeCount, BENCH_MAX_PARAM_VALUES);
+                break;
+
+            case 's':
+                pOptions_p->pdoSizeNum = parseList(optarg, pOptions_p->aPdoSize, BENCH_MAX_PARAM_VALUES);
+                break;
+
+            case 'f':
+                pOptions_p->pFilter = optarg;
+                break;
+
+            case 'o':
+                pOptions_p->pOutputFile = optarg;
+                break;
+
+            case 'b':
+                pOptions_p->pBaselineFile = optarg;
+                break;
+
+            case 't':
+                pOptions_p->threshold = (UINT)strtoul(optarg, NULL, 0);
+                break;
+
+            case 'h':
+            default:
+                printUsage(argv[0]);
+                return -1;
+        }
+    }
+
+    if ((pOptions_p->iterations == 0) ||
+        (pOptions_p->nodeCountNum == 0) ||
+        (pOptions_p->pdoSizeNum == 0))
+    {
+        printUsage(argv[0]);
+        return -1;
+    }
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Parse a comma separated list of numbers
+
+Values of zero are ignored, node counts and PDO sizes are limited to the
+maximum supported by the fixture.
+
+\param[in]      pString_p           String to parse.
+\param[out]     pList_p             Array to store the values.
+\param[in]      maxEntries_p        Size of the array.
+
+\return The function returns the number of parsed values.
+*/
+//------------------------------------------------------------------------------
+static UINT parseList(const char* pString_p, UINT* pList_p, UINT maxEntries_p)
+{
+    UINT    count = 0;
+    char*   pEnd;
+    ULONG   value;
+
+    while ((*pString_p != '\0') && (count < maxEntries_p))
+    {
+        value = strtoul(pString_p, &pEnd, 0);
+        if (pEnd == pString_p)
+            break;
+
+        if (value != 0)
+            pList_p[count++] = (UINT)value;
+
+        pString_p = (*pEnd == ',') ? pEnd + 1 : pEnd;
+    }
+
+    return count;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Print usage information
+
+\param[in]      pProgName_p         Name of the executable.
+*/
+//------------------------------------------------------------------------------
+static void printUsage(const char* pProgName_p)
+{
+    printf("Usage: %s [options]\n", pProgName_p);
+    printf("  -i <n>       timed operations per parameter set (default %u)\n", BENCH_DEFAULT_ITERATIONS);
+    printf("  -w <n>       warmup operations per parameter set (default %u)\n", BENCH_DEFAULT_WARMUP);
+    printf("  -n <list>    node counts, max. %u (default 1,10,40)\n", BENCH_MAX_NODE_COUNT);
+    printf("  -s <list>    PDO sizes in bytes, max. %u (default 16,64,256)\n", BENCH_MAX_PDO_SIZE);
+    printf("  -f <name>    only run benchmarks whose name contains <name>\n");
+    printf("  -o <file>    JSON result file (default %s)\n", BENCH_DEFAULT_OUTPUT);
+    printf("  -b <file>    compare against a JSON baseline\n");
+    printf("  -t <pct>     allowed median regression in percent (default %u)\n", BENCH_DEFAULT_THRESHOLD);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get monotonic time stamp
+
+\return The function returns the current monotonic time in nanoseconds.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getTimeNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((UINT64)ts.tv_sec * 1000000000ULL) + (UINT64)ts.tv_nsec;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare function for sorting the samples
+
+\param[in]      pA_p                Pointer to first sample.
+\param[in]      pB_p                Pointer to second sample.
+
+\return The function returns the result of the comparison as required by qsort().
+*/
+//------------------------------------------------------------------------------
+static int compareUint64(const void* pA_p, const void* pB_p)
+{
+    UINT64  a = *(const UINT64*)pA_p;
+    UINT64  b = *(const UINT64*)pB_p;
+
+    return (a > b) - (a < b);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Get percentile of sorted samples
+
+The function uses the nearest-rank method.
+
+\param[in]      pSorted_p           Pointer to the sorted samples.
+\param[in]      count_p             Number of samples.
+\param[in]      percentile_p        Percentile to get (0 - 100).
+
+\return The function returns the sample at the requested percentile.
+*/
+//------------------------------------------------------------------------------
+static UINT64 getPercentile(const UINT64* pSorted_p, UINT count_p, UINT percentile_p)
+{
+    UINT    rank;
+
+    rank = (UINT)(((UINT64)percentile_p * count_p + 99) / 100);
+    if (rank == 0)
+        rank = 1;
+
+    return pSorted_p[rank - 1];
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Run a benchmark case with one parameter set
+
+\param[in]      pCase_p             Benchmark case to run.
+\param[in]      pParam_p            Parameter set.
+\param[in]      pOptions_p          Benchmark options.
+\param[out]     pSamples_p          Sample memory (options.iterations entries).
+\param[out]     pResult_p           Pointer to store the result.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError runCase(const tBenchCase* pCase_p,
+                          const tBenchParam* pParam_p,
+                          const tBenchOptions* pOptions_p,
+                          UINT64* pSamples_p,
+                          tBenchResult* pResult_p)
+{
+    tOplkError  ret;
+    UINT        i;
+    UINT64      start;
+    UINT64      sum = 0;
+
+    if ((pParam_p->nodeCount > BENCH_MAX_NODE_COUNT) ||
+        (pParam_p->pdoSize > BENCH_MAX_PDO_SIZE))
+        return kErrorInvalidInstanceParam;
+
+    ret = pCase_p->pfnSetup(pParam_p);
+    if (ret != kErrorOk)
+        goto Exit;
+
+    for (i = 0; i < pOptions_p->warmup; i++)
+    {
+        ret = pCase_p->pfnRun();
+        if (ret != kErrorOk)
+            goto Exit;
+    }
+
+    for (i = 0; i < pOptions_p->iterations; i++)
+    {
+        start = getTimeNs();
+        ret = pCase_p->pfnRun();
+        pSamples_p[i] = getTimeNs() - start;
+        if (ret != kErrorOk)
+            goto Exit;
+
+        sum += pSamples_p[i];
+    }
+
+    qsort(pSamples_p, pOptions_p->iterations, sizeof(UINT64), compareUint64);
+
+    pResult_p->pName = pCase_p->pName;
+    pResult_p->param = *pParam_p;
+    pResult_p->meanNs = (double)sum / pOptions_p->iterations;
+    pResult_p->p50Ns = getPercentile(pSamples_p, pOptions_p->iterations, 50);
+    pResult_p->p90Ns = getPercentile(pSamples_p, pOptions_p->iterations, 90);
+    pResult_p->p99Ns = getPercentile(pSamples_p, pOptions_p->iterations, 99);
+    pResult_p->maxNs = pSamples_p[pOptions_p->iterations - 1];
+
+Exit:
+    if (pCase_p->pfnTeardown != NULL)
+        pCase_p->pfnTeardown();
+
+    return ret;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Write results to JSON file
+
+Every result is written on a single line so that the file can be read back
+by compareBaseline() without a full JSON parser.
+
+\param[in]      pFileName_p         Name of the JSON file.
+\param[in]      pOptions_p          Benchmark options.
+\param[in]      pResults_p          Pointer to the results.
+\param[in]      resultCount_p       Number of results.
+
+\return The function returns 0 on success, otherwise -1.
+*/
+//------------------------------------------------------------------------------
+static int writeJson(const char* pFileName_p,
+                     const tBenchOptions* pOptions_p,
+                     const tBenchResult* pResults_p,
+                     UINT resultCount_p)
+{
+    FILE*   pFile;
+    UINT    i;
+
+    pFile = fopen(pFileName_p, "w");
+    if (pFile == NULL)
+    {
+        fprintf(stderr, "Unable to open %s for writing\n", pFileName_p);
+        return -1;
+    }
+
+    fprintf(pFile, "{\n");
+    fprintf(pFile, "  \"suite\": \"oplkbench\",\n");
+    fprintf(pFile, "  \"format\": 1,\n");
+    fprintf(pFile, "  \"iterations\": %u,\n", pOptions_p->iterations);
+    fprintf(pFile, "  \"warmup\": %u,\n", pOptions_p->warmup);
+    fprintf(pFile, "  \"results\": [\n");
+
+    for (i = 0; i < resultCount_p; i++)
+    {
+        fprintf(pFile,
+                "    {\"name\": \"%s\", \"nodes\": %u, \"pdoSize\": %u, \"meanNs\": %.1f, "
+                "\"p50Ns\": %llu, \"p90Ns\": %llu, \"p99Ns\": %llu, \"maxNs\": %llu}%s\n",
+                pResults_p[i].pName,
+                pResults_p[i].param.nodeCount,
+                pResults_p[i].param.pdoSize,
+                pResults_p[i].meanNs,
+                (unsigned long long)pResults_p[i].p50Ns,
+                (unsigned long long)pResults_p[i].p90Ns,
+                (unsigned long long)pResults_p[i].p99Ns,
+                (unsigned long long)pResults_p[i].maxNs,
+                (i + 1 < resultCount_p) ? "," : "");
+    }
+
+    fprintf(pFile, "  ]\n");
+    fprintf(pFile, "}\n");
+    fclose(pFile);
+
+    printf("\nResults written to %s\n", pFileName_p);
+
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Compare results against a baseline
+
+The function reads a JSON file previously written by writeJson() and compares
+the median of every matching result. A result is reported as regression if
+its median exceeds the baseline median by more than the threshold.
+
+\param[in]      pFileName_p         Name of the baseline file.
+\param[in]      threshold_p         Regression threshold in percent.
+\param[in]      pResults_p          Pointer to the results.
+\param[in]      resultCount_p       Number of results.
+
+\return The function returns 0 if no regression was found, 1 if a regression
+        was found and 2 if the baseline could not be read.
+*/
+//------------------------------------------------------------------------------
+static int compareBaseline(const char* pFileName_p,
+                           UINT threshold_p,
+                           const tBenchResult* pResults_p,
+                           UINT resultCount_p)
+{
+    FILE*               pFile;
+    char                aLine[512];
+    char                aName[BENCH_MAX_NAME_LEN];
+    UINT                nodes;
+    UINT                pdoSize;
+    double              meanNs;
+    unsigned long long  p50Ns;
+    UINT                i;
+    double              delta;
+    int                 exitCode = 0;
+
+    pFile = fopen(pFileName_p, "r");
+    if (pFile == NULL)
+    {
+        fprintf(stderr, "Unable to open baseline %s\n", pFileName_p);
+        return 2;
+    }
+
+    printf("\nComparison against baseline %s (threshold %u%%):\n", pFileName_p, threshold_p);
+
+    while (fgets(aLine, sizeof(aLine), pFile) != NULL)
+    {
+        if (sscanf(aLine,
+                   " {\"name\": \"%63[^\"]\", \"nodes\": %u, \"pdoSize\": %u, \"meanNs\": %lf, \"p50Ns\": %llu",
+                   aName, &nodes, &pdoSize, &meanNs, &p50Ns) != 5)
+            continue;
+
+        for (i = 0; i < resultCount_p; i++)
+        {
+            if ((strcmp(pResults_p[i].pName, aName) != 0) ||
+                (pResults_p[i].param.nodeCount != nodes) ||
+                (pResults_p[i].param.pdoSize != pdoSize) ||
+                (p50Ns == 0))
+                continue;
+
+            delta = (((double)pResults_p[i].p50Ns - (double)p50Ns) * 100.0) / (double)p50Ns;
+            printf("%-24s %5u %7u %10llu -> %10llu %+7.1f%%%s\n",
+                   aName, nodes, pdoSize,
+                   p50Ns, (unsigned long long)pResults_p[i].p50Ns, delta,
+                   (delta > (double)threshold_p) ? "  REGRESSION" : "");
+
+            if (delta > (double)threshold_p)
+                exitCode = 1;
+        }
+    }
+
+    fclose(pFile);
+
+    return exitCode;
+}
+
+/// \}
@@ -0,0 +1,124 @@
+/**
+********************************************************************************
+\file   oplkbench.h
+
+\brief  Definitions for the openPOWERLINK cycle benchmark suite
+
+The file contains the definitions shared between the benchmark driver and the
+individual benchmark cases of the openPOWERLINK hot path benchmark suite.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+#ifndef _INC_oplkbench_H_
+#define _INC_oplkbench_H_
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <oplk/frame.h>
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+#define BENCH_MAX_NODE_COUNT        40      ///< Limited by the RPDO/TPDO channels of the CiA302-4 MN OD
+#define BENCH_MAX_PDO_SIZE          256     ///< Limited by the PRes payload of tPlkFrame
+
+//------------------------------------------------------------------------------
+// typedef
+//------------------------------------------------------------------------------
+
+/**
+\brief  Benchmark parameter set
+
+The structure describes one point of the parameter matrix a benchmark case is
+executed with. One operation of a benchmark case always represents the work of
+one POWERLINK cycle for the given number of nodes.
+*/
+typedef struct
+{
+    UINT                nodeCount;          ///< Number of CNs handled per operation
+    UINT                pdoSize;            ///< Size of a PDO (or payload block) per node in bytes
+} tBenchParam;
+
+typedef tOplkError (*tBenchSetupFunc)(const tBenchParam* pParam_p);
+typedef tOplkError (*tBenchRunFunc)(void);
+typedef void (*tBenchTeardownFunc)(void);
+
+/**
+\brief  Benchmark case descriptor
+
+The structure describes a single benchmark case. The setup function is called
+once per parameter set, the run function is timed once per operation.
+*/
+typedef struct
+{
+    const char*         pName;              ///< Name of the benchmark case (used in reports and baselines)
+    tBenchSetupFunc     pfnSetup;           ///< Prepares the case for a parameter set
+    tBenchRunFunc       pfnRun;             ///< Executes one operation
+    tBenchTeardownFunc  pfnTeardown;        ///< Cleans up after a parameter set (can be NULL)
+} tBenchCase;
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Stack fixture (benchfixture.c)
+tOplkError benchfixture_init(void);
+void       benchfixture_exit(void);
+tOplkError benchfixture_configurePdo(const tBenchParam* pParam_p);
+UINT8      benchfixture_getNodeId(UINT nodeIndex_p);
+void*      benchfixture_getRxImage(void);
+void*      benchfixture_getTxImage(void);
+UINT       benchfixture_getPiObject(BOOL fTx_p, UINT objNumber_p, UINT* pSubIndex_p);
+UINT       benchfixture_buildPres(UINT8 nodeId_p, UINT pdoSize_p, tPlkFrame* pFrame_p);
+
+// Benchmark cases
+extern const tBenchCase benchPdouRx_g;
+extern const tBenchCase benchPdouTx_g;
+extern const tBenchCase benchPdokRx_g;
+#if (CONFIG_PDOK_RX_WORKER_COUNT != 0)
+extern const tBenchCase benchPdokRxWorker_g;
+#endif
+extern const tBenchCase benchDllkPres_g;
+extern const tBenchCase benchCircbuf_g;
+extern const tBenchCase benchObduRead_g;
+extern const tBenchCase benchSdoSeq_g;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _INC_oplkbench_H_ */
@@ -0,0 +1,459 @@
+/**
+********************************************************************************
+\file   stubs.c
+
+\brief  Stubs for the openPOWERLINK cycle benchmark suite
+
+This file contains all stubs needed to run the benchmarked stack modules
+without Ethernet driver, timers and event queues. Events for the PDO kernel
+CAL module are processed synchronously, all other events are discarded.
+
+*******************************************************************************/
+
+/*------------------------------------------------------------------------------
+Copyright (c) 2021, B&R Industrial Automation GmbH
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in the
+      documentation and/or other materials provided with the distribution.
+    * Neither the name of the copyright holders nor the
+      names of its contributors may be used to endorse or promote products
+      derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL COPYRIGHT HOLDERS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+------------------------------------------------------------------------------*/
+
+//------------------------------------------------------------------------------
+// includes
+//------------------------------------------------------------------------------
+#include <common/oplkinc.h>
+#include <kernel/dllkcal.h>
+#include <kernel/edrv.h>
+#include <kernel/edrvbusypoll.h>
+#include <kernel/edrvcyclic.h>
+#include <kernel/errhndk.h>
+#include <kernel/eventk.h>
+#include <kernel/hrestimer.h>
+#include <kernel/pdokcal.h>
+#include <kernel/timesynck.h>
+#include <user/eventu.h>
+#include <user/sdoudp.h>
+#include <user/timeru.h>
+
+//============================================================================//
+//            G L O B A L   D E F I N I T I O N S                             //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// module global vars
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// global function prototypes
+//------------------------------------------------------------------------------
+
+//============================================================================//
+//            P R I V A T E   D E F I N I T I O N S                           //
+//============================================================================//
+
+//------------------------------------------------------------------------------
+// const defines
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local types
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// local function prototypes
+//------------------------------------------------------------------------------
+static tOplkError dispatchEvent(const tEvent* pEvent_p);
+
+//------------------------------------------------------------------------------
+// local vars
+//------------------------------------------------------------------------------
+static const UINT8  aMacAddr_l[6] = {0x00, 0x12, 0x34, 0x56, 0x78, 0xF0};
+
+//============================================================================//
+//            P U B L I C   F U N C T I O N S                                 //
+//============================================================================//
+
+// Event handling --------------------------------------------------------------
+
+tOplkError eventk_postEvent(const tEvent* pEvent_p)
+{
+    return dispatchEvent(pEvent_p);
+}
+
+tOplkError eventk_postError(tEventSource eventSource_p,
+                            tOplkError oplkError_p,
+                            UINT argSize_p,
+                            const void* pArg_p)
+{
+    UNUSED_PARAMETER(eventSource_p);
+    UNUSED_PARAMETER(oplkError_p);
+    UNUSED_PARAMETER(argSize_p);
+    UNUSED_PARAMETER(pArg_p);
+    return kErrorOk;
+}
+
+tOplkError eventk_registerEventHandler(tEventSink eventSink_p,
+                                       tEventType eventType_p,
+                                       tEventkProcessCb pfnProcess_p,
+                                       BOOL fFastLane_p)
+{
+    UNUSED_PARAMETER(eventSink_p);
+    UNUSED_PARAMETER(eventType_p);
+    UNUSED_PARAMETER(pfnProcess_p);
+    UNUSED_PARAMETER(fFastLane_p);
+    return kErrorOk;
+}
+
+tOplkError eventu_postEvent(const tEvent* pEvent_p)
+{
+    return dispatchEvent(pEvent_p);
+}
+
+// DLL kernel CAL --------------------------------------------------------------
+
+tOplkError dllkcal_ackAsyncRequest(UINT nodeId_p,
+                                   tDllReqServiceId reqServiceId_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+    UNUSED_PARAMETER(reqServiceId_p);
+    return kErrorOk;
+}
+
+tOplkError dllkcal_asyncFrameReceived(tFrameInfo* pFrameInfo_p)
+{
+    UNUSED_PARAMETER(pFrameInfo_p);
+    return kErrorOk;
+}
+
+tOplkError dllkcal_nmtCmdReceived(const tNmtCommandService* pNmtCommand_p)
+{
+    UNUSED_PARAMETER(pNmtCommand_p);
+    return kErrorOk;
+}
+
+tOplkError dllkcal_clearAsyncBuffer(void)
+{
+    return kErrorOk;
+}
+
+tOplkError dllkcal_clearAsyncQueues(void)
+{
+    return kErrorOk;
+}
+
+tOplkError dllkcal_getAsyncTxCount(tDllAsyncReqPriority* pPriority_p,
+                                   UINT* pCount_p)
+{
+    *pPriority_p = kDllAsyncReqPrioGeneric;
+    *pCount_p = 0;
+    return kErrorOk;
+}
+
+tOplkError dllkcal_getAsyncTxFrame(void* pFrame_p,
+                                   size_t* pFrameSize_p,
+                                   tDllAsyncReqPriority priority_p)
+{
+    UNUSED_PARAMETER(pFrame_p);
+    UNUSED_PARAMETER(priority_p);
+    *pFrameSize_p = 0;
+    return kErrorDllAsyncTxBufferEmpty;
+}
+
+tOplkError dllkcal_getSoaRequest(tDllReqServiceId* pReqServiceId_p,
+                                 UINT* pNodeId_p,
+                                 tSoaPayload* pSoaPayload_p)
+{
+    UNUSED_PARAMETER(pSoaPayload_p);
+    *pReqServiceId_p = kDllReqServiceNo;
+    *pNodeId_p = C_ADR_INVALID;
+    return kErrorOk;
+}
+
+tOplkError dllkcal_setAsyncPendingRequests(UINT nodeId_p,
+                                           tDllAsyncReqPriority asyncReqPrio_p,
+                                           UINT count_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+    UNUSED_PARAMETER(asyncReqPrio_p);
+    UNUSED_PARAMETER(count_p);
+    return kErrorOk;
+}
+
+// Ethernet driver -------------------------------------------------------------
+
+tOplkError edrv_allocTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    UNUSED_PARAMETER(pBuffer_p);
+    return kErrorEdrvNoFreeBufEntry;
+}
+
+tOplkError edrv_freeTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    UNUSED_PARAMETER(pBuffer_p);
+    return kErrorOk;
+}
+
+tOplkError edrv_changeRxFilter(tEdrvFilter* pFilter_p,
+                               UINT count_p,
+                               UINT entryChanged_p,
+                               UINT changeFlags_p)
+{
+    UNUSED_PARAMETER(pFilter_p);
+    UNUSED_PARAMETER(count_p);
+    UNUSED_PARAMETER(entryChanged_p);
+    UNUSED_PARAMETER(changeFlags_p);
+    return kErrorOk;
+}
+
+tOplkError edrv_setRxMulticastMacAddr(const UINT8* pMacAddr_p)
+{
+    UNUSED_PARAMETER(pMacAddr_p);
+    return kErrorOk;
+}
+
+tOplkError edrv_clearRxMulticastMacAddr(const UINT8* pMacAddr_p)
+{
+    UNUSED_PARAMETER(pMacAddr_p);
+    return kErrorOk;
+}
+
+const UINT8* edrv_getMacAddr(void)
+{
+    return aMacAddr_l;
+}
+
+tOplkError edrv_sendTxBuffer(tEdrvTxBuffer* pBuffer_p)
+{
+    UNUSED_PARAMETER(pBuffer_p);
+    return kErrorOk;
+}
+
+tOplkError edrvcyclic_regSyncHandler(tEdrvCyclicCbSync pfnEdrvCyclicCbSync_p)
+{
+    UNUSED_PARAMETER(pfnEdrvCyclicCbSync_p);
+    return kErrorOk;
+}
+
+tOplkError edrvcyclic_setCycleTime(UINT32 cycleTimeUs_p, UINT32 minSyncTime_p)
+{
+    UNUSED_PARAMETER(cycleTimeUs_p);
+    UNUSED_PARAMETER(minSyncTime_p);
+    return kErrorOk;
+}
+
+tOplkError edrvcyclic_setMaxTxBufferListSize(UINT maxListSize_p)
+{
+    UNUSED_PARAMETER(maxListSize_p);
+    return kErrorOk;
+}
+
+tOplkError edrvcyclic_setNextTxBufferList(tEdrvTxBuffer* const* ppTxBuffer_p,
+                                          UINT txBufferCount_p)
+{
+    UNUSED_PARAMETER(ppTxBuffer_p);
+    UNUSED_PARAMETER(txBufferCount_p);
+    return kErrorOk;
+}
+
+tOplkError edrvcyclic_startCycle(BOOL fContinuousMode_p)
+{
+    UNUSED_PARAMETER(fContinuousMode_p);
+    return kErrorOk;
+}
+
+tOplkError edrvcyclic_stopCycle(BOOL fKeepCycle_p)
+{
+    UNUSED_PARAMETER(fKeepCycle_p);
+    return kErrorOk;
+}
+
+void edrvbusypoll_setCycleTime(UINT32 cycleTimeUs_p)
+{
+    UNUSED_PARAMETER(cycleTimeUs_p);
+}
+
+void edrvbusypoll_signalSoc(void)
+{
+}
+
+void edrvbusypoll_signalSoa(void)
+{
+}
+
+// Error handler ---------------------------------------------------------------
+
+tOplkError errhndk_postError(const tEventDllError* pDllEvent_p)
+{
+    UNUSED_PARAMETER(pDllEvent_p);
+    return kErrorOk;
+}
+
+tOplkError errhndk_decrementCounters(BOOL fMN_p)
+{
+    UNUSED_PARAMETER(fMN_p);
+    return kErrorOk;
+}
+
+tOplkError errhndk_resetCnError(UINT nodeId_p)
+{
+    UNUSED_PARAMETER(nodeId_p);
+    return kErrorOk;
+}
+
+// Timers ----------------------------------------------------------------------
+
+tOplkError hrestimer_modifyTimer(tTimerHdl* pTimerHdl_p,
+                                 ULONGLONG time_p,
+                                 tTimerkCallback pfnCallback_p,
+                                 ULONG argument_p,
+                                 BOOL fContinue_p)
+{
+    UNUSED_PARAMETER(time_p);
+    UNUSED_PARAMETER(pfnCallback_p);
+    UNUSED_PARAMETER(argument_p);
+    UNUSED_PARAMETER(fContinue_p);
+    *pTimerHdl_p = 1;
+    return kErrorOk;
+}
+
+tOplkError hrestimer_deleteTimer(tTimerHdl* pTimerHdl_p)
+{
+    *pTimerHdl_p = 0;
+    return kErrorOk;
+}
+
+void hrestimer_controlExtSyncIrq(BOOL fEnable_p)
+{
+    UNUSED_PARAMETER(fEnable_p);
+}
+
+tOplkError timeru_setTimer(tTimerHdl* pTimerHdl_p,
+                           ULONG timeInMs_p,
+                           const tTimerArg* pArgument_p)
+{
+    UNUSED_PARAMETER(timeInMs_p);
+    UNUSED_PARAMETER(pArgument_p);
+    *pTimerHdl_p = 1;
+    return kErrorOk;
+}
+
+tOplkError timeru_modifyTimer(tTimerHdl* pTimerHdl_p,
+                              ULONG timeInMs_p,
+                              const tTimerArg* pArgument_p)
+{
+    return timeru_setTimer(pTimerHdl_p, timeInMs_p, pArgument_p);
+}
+
+tOplkError timeru_deleteTimer(tTimerHdl* pTimerHdl_p)
+{
+    *pTimerHdl_p = 0;
+    return kErrorOk;
+}
+
+tOplkError timesynck_setCycleTime(UINT32 cycleLen_p, UINT32 minSyncTime_p)
+{
+    UNUSED_PARAMETER(cycleLen_p);
+    UNUSED_PARAMETER(minSyncTime_p);
+    return kErrorOk;
+}
+
+tOplkError timesynck_setSocTime(const tTimesyncSocTime* pSocTime_p)
+{
+    UNUSED_PARAMETER(pSocTime_p);
+    return kErrorOk;
+}
+
+tOplkError timesynck_getNetTime(tNetTime* pNetTime_p, BOOL* pNewData_p)
+{
+    OPLK_MEMSET(pNetTime_p, 0, sizeof(tNetTime));
+    *pNewData_p = FALSE;
+    return kErrorOk;
+}
+
+// SDO over UDP ----------------------------------------------------------------
+
+tOplkError sdoudp_init(tSequLayerReceiveCb pfnReceiveCb_p)
+{
+    UNUSED_PARAMETER(pfnReceiveCb_p);
+    return kErrorOk;
+}
+
+tOplkError sdoudp_exit(void)
+{
+    return kErrorOk;
+}
+
+tOplkError sdoudp_initCon(tSdoConHdl* pSdoConHandle_p,
+                          UINT targetNodeId_p)
+{
+    UNUSED_PARAMETER(pSdoConHandle_p);
+    UNUSED_PARAMETER(targetNodeId_p);
+    return kErrorSdoSeqUnsupportedProt;
+}
+
+tOplkError sdoudp_sendData(tSdoConHdl sdoConHandle_p,
+                           tPlkFrame* pSrcData_p,
+                           size_t dataSize_p)
+{
+    UNUSED_PARAMETER(sdoConHandle_p);
+    UNUSED_PARAMETER(pSrcData_p);
+    UNUSED_PARAMETER(dataSize_p);
+    return kErrorSdoSeqUnsupportedProt;
+}
+
+tOplkError sdoudp_delConnection(tSdoConHdl sdoConHandle_p)
+{
+    UNUSED_PARAMETER(sdoConHandle_p);
+    return kErrorOk;
+}
+
+//============================================================================//
+//            P R I V A T E   F U N C T I O N S                               //
+//============================================================================//
+/// \name Private Functions
+/// \{
+
+//------------------------------------------------------------------------------
+/**
+\brief  Dispatch an event
+
+The function processes events for the PDO kernel CAL module synchronously.
+All other events are not relevant for the benchmarks and are discarded.
+
+\param[in]      pEvent_p            Event to dispatch.
+
+\return The function returns a tOplkError error code.
+*/
+//------------------------------------------------------------------------------
+static tOplkError dispatchEvent(const tEvent* pEvent_p)
+{
+    if (pEvent_p->eventSink == kEventSinkPdokCal)
+        return pdokcal_process(pEvent_p);
+
+    return kErrorOk;
+}
+
+/// \}
@@ -40,6 +40,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 #include <stddef.h>
 #include <CUnit/CUnit.h>
+#include <kernel/eventk.h>
 #include "test-event.h"
 
 //============================================================================//
@@ -83,6 +84,9 @@ static int eventTestsCleanup(void);
 
 static CU_TestInfo eventTests[] = {
     { "Test eventk_process()",                                          test_eventk_process },
+    { "Test eventk_registerEventHandler()",                             test_eventk_registerEventHandler },
+    { "Test eventk_isFastLaneEvent()",                                  test_eventk_isFastLaneEvent },
+    { "Test eventk_process() with event type handlers",                 test_eventk_processTypeHandler },
     CU_TEST_INFO_NULL,
 };
 
@@ -125,6 +129,9 @@ The function does all initializations needed for the tests in this testsuite.
 //------------------------------------------------------------------------------
 static int eventTestsInit(void)
 {
+    if (eventk_init() != kErrorOk)
+        return 1;
+
     return 0;
 }
 
@@ -139,6 +146,8 @@ The function does all cleanups needed for the tests in this testsuite.
 //------------------------------------------------------------------------------
 static int eventTestsCleanup(void)
 {
+    eventk_exit();
+
     return 0;
 }
 
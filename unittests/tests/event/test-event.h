@@ -62,6 +62,9 @@ void test_getHandlerForSink_FirstExist(void);
 void test_getHandlerForSink_FurtherExist(void);
 void test_getHandlerForSink_NotExist(void);
 void test_eventk_process(void);
+void test_eventk_registerEventHandler(void);
+void test_eventk_isFastLaneEvent(void);
+void test_eventk_processTypeHandler(void);
 
 
 #ifdef __cplusplus
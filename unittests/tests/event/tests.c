@@ -74,10 +74,12 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 // local function prototypes
 //------------------------------------------------------------------------------
+static tOplkError processTypeEvent(const tEvent* pEvent_p);
 
 //------------------------------------------------------------------------------
 // local vars
 //------------------------------------------------------------------------------
+static UINT typeEventCount_l = 0;
 
 //============================================================================//
 //            P U B L I C   F U N C T I O N S                                 //
@@ -112,7 +114,154 @@ void test_eventk_process(void)
 
 }
 
+//------------------------------------------------------------------------------
+/**
+\brief  Test eventk_registerEventHandler()
+*/
+//------------------------------------------------------------------------------
+void test_eventk_registerEventHandler(void)
+{
+    CU_ASSERT_EQUAL(eventk_init(), kErrorOk);
+
+    CU_ASSERT_EQUAL(eventk_registerEventHandler(kEventSinkPdok,
+                                                kEventTypeDllkCycleFinish,
+                                                processTypeEvent,
+                                                TRUE),
+                    kErrorEventUnknownSink);
+
+    CU_ASSERT_EQUAL(eventk_registerEventHandler(kEventSinkDllk,
+                                                (tEventType)0x40,
+                                                processTypeEvent,
+                                                TRUE),
+                    kErrorInvalidEvent);
+
+    CU_ASSERT_EQUAL(eventk_registerEventHandler(kEventSinkDllk,
+                                                kEventTypeDllkCycleFinish,
+                                                processTypeEvent,
+                                                TRUE),
+                    kErrorOk);
+
+    CU_ASSERT_EQUAL(eventk_registerEventHandler(kEventSinkDllk,
+                                                kEventTypeDllkFillTx,
+                                                processTypeEvent,
+                                                FALSE),
+                    kErrorOk);
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test eventk_isFastLaneEvent()
+*/
+//------------------------------------------------------------------------------
+void test_eventk_isFastLaneEvent(void)
+{
+    tEvent          event;
+
+    CU_ASSERT_EQUAL(eventk_init(), kErrorOk);
+    CU_ASSERT_EQUAL(eventk_registerEventHandler(kEventSinkDllk,
+                                                kEventTypeDllkCycleFinish,
+                                                processTypeEvent,
+                                                TRUE),
+                    kErrorOk);
+    CU_ASSERT_EQUAL(eventk_registerEventHandler(kEventSinkDllk,
+                                                kEventTypeDllkFillTx,
+                                                processTypeEvent,
+                                                FALSE),
+                    kErrorOk);
+
+    // Only the event type registered for the fast lane may overtake other events
+    event.eventSink = kEventSinkDllk;
+    event.eventType = kEventTypeDllkCycleFinish;
+    CU_ASSERT_TRUE(eventk_isFastLaneEvent(&event));
+
+    event.eventType = kEventTypeDllkFillTx;
+    CU_ASSERT_FALSE(eventk_isFastLaneEvent(&event));
+
+    event.eventType = kEventTypeNmtEvent;
+    CU_ASSERT_FALSE(eventk_isFastLaneEvent(&event));
+
+    event.eventSink = kEventSinkNmtk;
+    event.eventType = kEventTypeDllkCycleFinish;
+    CU_ASSERT_FALSE(eventk_isFastLaneEvent(&event));
+
+    event.eventSink = kEventSinkPdok;
+    CU_ASSERT_FALSE(eventk_isFastLaneEvent(&event));
+
+    // Registering the handler again replaces the fast lane flag
+    CU_ASSERT_EQUAL(eventk_registerEventHandler(kEventSinkDllk,
+                                                kEventTypeDllkCycleFinish,
+                                                processTypeEvent,
+                                                FALSE),
+                    kErrorOk);
+    event.eventSink = kEventSinkDllk;
+    CU_ASSERT_FALSE(eventk_isFastLaneEvent(&event));
+
+    // Re-initialization removes all registered handlers
+    CU_ASSERT_EQUAL(eventk_registerEventHandler(kEventSinkDllk,
+                                                kEventTypeDllkCycleFinish,
+                                                processTypeEvent,
+                                                TRUE),
+                    kErrorOk);
+    CU_ASSERT_TRUE(eventk_isFastLaneEvent(&event));
+    CU_ASSERT_EQUAL(eventk_init(), kErrorOk);
+    CU_ASSERT_FALSE(eventk_isFastLaneEvent(&event));
+}
+
+//------------------------------------------------------------------------------
+/**
+\brief  Test eventk_process() with registered event type handlers
+*/
+//------------------------------------------------------------------------------
+void test_eventk_processTypeHandler(void)
+{
+    tEvent          event;
+
+    CU_ASSERT_EQUAL(eventk_init(), kErrorOk);
+    CU_ASSERT_EQUAL(eventk_registerEventHandler(kEventSinkDllk,
+                                                kEventTypeDllkCycleFinish,
+                                                processTypeEvent,
+                                                TRUE),
+                    kErrorOk);
+
+    typeEventCount_l = 0;
+
+    // Registered event types are passed to the type handler
+    event.eventSink = kEventSinkDllk;
+    event.eventType = kEventTypeDllkCycleFinish;
+    CU_ASSERT_EQUAL(eventk_process(&event), kErrorOk);
+    CU_ASSERT_EQUAL(typeEventCount_l, 1);
+
+    // Other event types of the sink are passed to the sink process function
+    event.eventType = kEventTypeNmtEvent;
+    CU_ASSERT_EQUAL(eventk_process(&event), kErrorOk);
+    CU_ASSERT_EQUAL(typeEventCount_l, 1);
+
+    // The type handler is bound to its sink
+    event.eventSink = kEventSinkNmtk;
+    event.eventType = kEventTypeDllkCycleFinish;
+    CU_ASSERT_EQUAL(eventk_process(&event), kErrorOk);
+    CU_ASSERT_EQUAL(typeEventCount_l, 1);
+}
+
 //============================================================================//
 //            P R I V A T E   F U N C T I O N S                               //
 //============================================================================//
 
+//------------------------------------------------------------------------------
+/**
+\brief  Process function of the registered event type
+
+\param[in]      pEvent_p            Event to process.
+
+\return Always returns kErrorOk
+*/
+//------------------------------------------------------------------------------
+static tOplkError processTypeEvent(const tEvent* pEvent_p)
+{
+    UNUSED_PARAMETER(pEvent_p);
+
+    typeEventCount_l++;
+
+    return kErrorOk;
+}
+